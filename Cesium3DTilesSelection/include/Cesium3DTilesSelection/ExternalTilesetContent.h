@@ -5,6 +5,9 @@
 #include "TileContentLoadResult.h"
 #include "TileContentLoader.h"
 #include "TileRefine.h"
+#include "TilesetOptions.h"
+
+#include <CesiumAsync/HttpHeaders.h>
 
 #include <gsl/span>
 #include <spdlog/fwd.h>
@@ -41,7 +44,9 @@ private:
    * warnings.
    * @param tileRefine The {@link TileRefine}
    * @param url The source URL
+   * @param responseHeaders The headers of the response with the data
    * @param data The raw input data
+   * @param contentOptions The options for loading the external tileset
    * @return The {@link TileContentLoadResult}
    */
   static std::unique_ptr<TileContentLoadResult> load(
@@ -49,7 +54,9 @@ private:
       const glm::dmat4& tileTransform,
       TileRefine tileRefine,
       const std::string& url,
-      const gsl::span<const std::byte>& data);
+      const CesiumAsync::HttpHeaders& responseHeaders,
+      const gsl::span<const std::byte>& data,
+      const TilesetContentOptions& contentOptions);
 };
 
 } // namespace Cesium3DTilesSelection
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "Library.h"
+
+#include <CesiumGeospatial/BoundingRegion.h>
+#include <CesiumGeospatial/GlobeRectangle.h>
+
+#include <glm/mat4x4.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace CesiumGltf {
+struct Model;
+}
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief An index of the features of a glTF, for finding features by their
+ * location or by the values of their `EXT_feature_metadata` properties.
+ *
+ * A feature is identified by the name of its feature table and its feature ID.
+ * Its bounding region is computed from the positions of the vertices that have
+ * its ID in a feature ID attribute, such as the `_BATCHID` of a batched 3D
+ * model. Numeric and string properties are indexed by sorting the features by
+ * their values, and boolean properties by a bitmap of the features whose
+ * values are true, so queries visit only the features that match.
+ *
+ * When {@link TilesetContentOptions::createFeatureIndex} is set, an index is
+ * created for each tile in the load thread and stored in
+ * {@link TileContentLoadResult::featureIndex}. The indices of the loaded tiles
+ * can be queried with {@link Tileset::forEachLoadedFeatureIndex}.
+ */
+class CESIUM3DTILESSELECTION_API FeatureIndex final {
+public:
+  /**
+   * @brief A function that receives each feature found by a query.
+   */
+  using Callback =
+      std::function<void(const std::string& featureTable, int64_t featureId)>;
+
+  /**
+   * @brief Constructs an empty index.
+   */
+  FeatureIndex() = default;
+
+  /**
+   * @brief Creates an index of the features of a glTF.
+   *
+   * Metadata that is converted lazily, as with
+   * {@link TilesetContentOptions::convertBatchTablesLazily}, is converted by
+   * this function.
+   *
+   * @param model The glTF.
+   * @param transform The transformation from the glTF's coordinates to
+   * ECEF coordinates, such as the tile transform. The `RTC_CENTER` and
+   * `gltfUpAxis` of the glTF are applied to it, as by
+   * {@link GltfContent::computeBoundingRegion}.
+   * @param indexedProperties The names of the properties to index. Properties
+   * that are not numeric, boolean, or string properties of a feature table are
+   * not indexed.
+   * @return The index.
+   */
+  static FeatureIndex create(
+      const CesiumGltf::Model& model,
+      const glm::dmat4& transform,
+      const std::vector<std::string>& indexedProperties);
+
+  /**
+   * @brief Gets the bounding region of a feature.
+   *
+   * @param featureTable The name of the feature's feature table.
+   * @param featureId The ID of the feature.
+   * @return The bounding region, or `std::nullopt` if no vertices have the
+   * feature's ID.
+   */
+  std::optional<CesiumGeospatial::BoundingRegion> getFeatureBoundingRegion(
+      const std::string& featureTable,
+      int64_t featureId) const;
+
+  /**
+   * @brief Finds the features whose bounding regions intersect a rectangle.
+   *
+   * @param rectangle The rectangle.
+   * @param callback The function that receives each feature.
+   */
+  void findFeaturesInRectangle(
+      const CesiumGeospatial::GlobeRectangle& rectangle,
+      const Callback& callback) const;
+
+  /**
+   * @brief Finds the features whose values of a numeric property are within a
+   * range.
+   *
+   * Values are compared as doubles, after they are normalized if their class
+   * property is `normalized`. Features are found in ascending order of value.
+   *
+   * @param propertyName The name of an indexed numeric property.
+   * @param minimum The smallest value to find.
+   * @param maximum The largest value to find.
+   * @param callback The function that receives each feature.
+   */
+  void findFeaturesInRange(
+      const std::string& propertyName,
+      double minimum,
+      double maximum,
+      const Callback& callback) const;
+
+  /**
+   * @brief Finds the features that have the given value of a boolean property.
+   *
+   * @param propertyName The name of an indexed boolean property.
+   * @param value The value to find.
+   * @param callback The function that receives each feature.
+   */
+  void findFeaturesWithBoolean(
+      const std::string& propertyName,
+      bool value,
+      const Callback& callback) const;
+
+  /**
+   * @brief Finds the features that have the given value of a string property.
+   *
+   * @param propertyName The name of an indexed string property.
+   * @param value The value to find.
+   * @param callback The function that receives each feature.
+   */
+  void findFeaturesWithString(
+      const std::string& propertyName,
+      const std::string& value,
+      const Callback& callback) const;
+
+private:
+  struct FeatureBounds {
+    CesiumGeospatial::GlobeRectangle rectangle =
+        CesiumGeospatial::GlobeRectangle(0.0, 0.0, 0.0, 0.0);
+    double minimumHeight = 0.0;
+    double maximumHeight = -1.0;
+  };
+
+  struct PropertyIndex {
+    std::vector<int64_t> sortedFeatureIds;
+    std::vector<double> sortedNumbers;
+    std::vector<std::string> sortedStrings;
+    std::vector<bool> booleans;
+  };
+
+  struct FeatureTableIndex {
+    std::vector<FeatureBounds> features;
+    std::map<std::string, PropertyIndex> properties;
+  };
+
+  std::map<std::string, FeatureTableIndex> _featureTables;
+};
+
+} // namespace Cesium3DTilesSelection
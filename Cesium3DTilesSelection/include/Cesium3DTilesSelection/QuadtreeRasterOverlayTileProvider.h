@@ -152,7 +152,8 @@ private:
   static LoadedRasterOverlayImage combineImages(
       const CesiumGeometry::Rectangle& targetRectangle,
       const CesiumGeospatial::Projection& projection,
-      std::vector<LoadedQuadtreeImage>&& images);
+      std::vector<LoadedQuadtreeImage>&& images,
+      CesiumGltf::ImageBufferPool* pImageBufferPool);
 
   uint32_t _minimumLevel;
   uint32_t _maximumLevel;
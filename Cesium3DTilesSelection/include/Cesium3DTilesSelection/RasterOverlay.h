@@ -3,6 +3,7 @@
 #include "Library.h"
 
 #include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumGltf/ImageBufferPool.h>
 
 #include <spdlog/fwd.h>
 
@@ -63,6 +64,19 @@ struct CESIUM3DTILESSELECTION_API RasterOverlayOptions {
    * the raster overlay maps to approximately 2x2 pixels on the screen.
    */
   double maximumScreenSpaceError = 2.0;
+
+  /**
+   * @brief The pool from which to allocate the pixel data of this overlay's
+   * images, and to which that pixel data is returned when the images are
+   * unloaded.
+   *
+   * By default this is `nullptr`, and pixel data is allocated directly. The
+   * options are copied into each overlay along with this pointer, so a pool
+   * set here is shared by every overlay created from these options. Its
+   * {@link CesiumGltf::ImageBufferPoolOptions::maximumPooledBytes} limits the
+   * idle memory held for all of them together.
+   */
+  std::shared_ptr<CesiumGltf::ImageBufferPool> pImageBufferPool = nullptr;
 };
 
 /**
@@ -6,6 +6,7 @@
 
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumGeospatial/CartographicPolygon.h>
+#include <CesiumGeospatial/CartographicPolygonIndex.h>
 #include <CesiumGeospatial/Ellipsoid.h>
 #include <CesiumGeospatial/Projection.h>
 
@@ -44,8 +45,19 @@ public:
     return this->_polygons;
   }
 
+  /**
+   * @brief Gets the spatial index over the triangles of the polygons.
+   */
+  const CesiumGeospatial::CartographicPolygonIndex&
+  getPolygonIndex() const noexcept {
+    return *this->_pPolygonIndex;
+  }
+
 private:
   std::vector<CesiumGeospatial::CartographicPolygon> _polygons;
+  // Shared with tile providers, whose rasterization tasks may outlive them.
+  std::shared_ptr<const CesiumGeospatial::CartographicPolygonIndex>
+      _pPolygonIndex;
   CesiumGeospatial::Ellipsoid _ellipsoid;
   CesiumGeospatial::Projection _projection;
 };
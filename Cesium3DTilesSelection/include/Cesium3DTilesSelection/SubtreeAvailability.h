@@ -0,0 +1,175 @@
+#pragma once
+
+#include "Library.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief How each tile of a 3D Tiles implicit tileset is divided into its
+ * children.
+ */
+enum class ImplicitTilingSubdivisionScheme {
+  /**
+   * @brief Each tile is divided into four children along its x and y axes.
+   */
+  Quadtree,
+
+  /**
+   * @brief Each tile is divided into eight children along its x, y, and z
+   * axes.
+   */
+  Octree
+};
+
+/**
+ * @brief The availability of the tiles, tile content, and child subtrees of a
+ * single subtree of a 3D Tiles implicit tileset.
+ *
+ * Each of these is either constant or given by a bitstream with one bit per
+ * item, in the order described by the implicit tiling specification: level by
+ * level, and within each level by the Morton index of the items' coordinates.
+ * This makes each lookup a constant-time bit test.
+ */
+class CESIUM3DTILESSELECTION_API SubtreeAvailability final {
+public:
+  /**
+   * @brief The availability of one kind of item in a subtree.
+   */
+  struct AvailabilityView {
+    /**
+     * @brief Whether every item is available, if there is no bitstream.
+     */
+    bool constant = false;
+
+    /**
+     * @brief The offset of the bitstream in the subtree's buffer.
+     */
+    size_t byteOffset = 0;
+
+    /**
+     * @brief The length of the bitstream in bytes, or 0 if the availability
+     * is constant.
+     */
+    size_t byteLength = 0;
+  };
+
+  /**
+   * @brief Creates a subtree in which nothing is available.
+   *
+   * @param subdivisionScheme How the subtree's tiles are divided.
+   * @param subtreeLevels The number of levels in the subtree.
+   */
+  SubtreeAvailability(
+      ImplicitTilingSubdivisionScheme subdivisionScheme,
+      uint32_t subtreeLevels) noexcept;
+
+  /**
+   * @brief Creates a new instance.
+   *
+   * @param subdivisionScheme How the subtree's tiles are divided.
+   * @param subtreeLevels The number of levels in the subtree.
+   * @param buffer The buffer that holds the availability bitstreams.
+   * @param tileAvailability The availability of the subtree's tiles.
+   * @param contentAvailability The availability of each of the contents of
+   * the subtree's tiles.
+   * @param subtreeAvailability The availability of the child subtrees.
+   */
+  SubtreeAvailability(
+      ImplicitTilingSubdivisionScheme subdivisionScheme,
+      uint32_t subtreeLevels,
+      std::vector<std::byte>&& buffer,
+      const AvailabilityView& tileAvailability,
+      std::vector<AvailabilityView>&& contentAvailability,
+      const AvailabilityView& subtreeAvailability) noexcept;
+
+  /**
+   * @brief Gets how the subtree's tiles are divided.
+   */
+  ImplicitTilingSubdivisionScheme getSubdivisionScheme() const noexcept {
+    return this->_subdivisionScheme;
+  }
+
+  /**
+   * @brief Gets the number of levels in the subtree.
+   */
+  uint32_t getSubtreeLevels() const noexcept { return this->_subtreeLevels; }
+
+  /**
+   * @brief Determines if a tile of the subtree is available.
+   *
+   * @param relativeLevel The level of the tile, relative to the subtree's
+   * root.
+   * @param mortonIndex The Morton index of the tile's coordinates, relative to
+   * the subtree's root.
+   * @return Whether the tile is available.
+   */
+  bool isTileAvailable(uint32_t relativeLevel, uint64_t mortonIndex)
+      const noexcept;
+
+  /**
+   * @brief Determines if a tile of the subtree has content.
+   *
+   * @param relativeLevel The level of the tile, relative to the subtree's
+   * root.
+   * @param mortonIndex The Morton index of the tile's coordinates, relative to
+   * the subtree's root.
+   * @param contentIndex The index of the content, for tiles with multiple
+   * contents.
+   * @return Whether the content is available.
+   */
+  bool isContentAvailable(
+      uint32_t relativeLevel,
+      uint64_t mortonIndex,
+      size_t contentIndex = 0) const noexcept;
+
+  /**
+   * @brief Determines if a child subtree of this subtree is available.
+   *
+   * @param mortonIndex The Morton index of the child subtree's root tile
+   * coordinates, relative to the level below this subtree.
+   * @return Whether the child subtree is available.
+   */
+  bool isSubtreeAvailable(uint64_t mortonIndex) const noexcept;
+
+  /**
+   * @brief Computes the Morton index of a quadtree tile's coordinates, by
+   * interleaving their bits.
+   *
+   * @param x The x-coordinate.
+   * @param y The y-coordinate.
+   * @return The Morton index.
+   */
+  static uint64_t computeMortonIndex(uint32_t x, uint32_t y) noexcept;
+
+  /**
+   * @brief Computes the Morton index of an octree tile's coordinates, by
+   * interleaving their bits.
+   *
+   * Only the low 21 bits of each coordinate are used.
+   *
+   * @param x The x-coordinate.
+   * @param y The y-coordinate.
+   * @param z The z-coordinate.
+   * @return The Morton index.
+   */
+  static uint64_t
+  computeMortonIndex(uint32_t x, uint32_t y, uint32_t z) noexcept;
+
+private:
+  bool isAvailable(const AvailabilityView& view, uint64_t index)
+      const noexcept;
+  uint64_t getLevelOffset(uint32_t relativeLevel) const noexcept;
+
+  ImplicitTilingSubdivisionScheme _subdivisionScheme;
+  uint32_t _subtreeLevels;
+  std::vector<std::byte> _buffer;
+  AvailabilityView _tileAvailability;
+  std::vector<AvailabilityView> _contentAvailability;
+  AvailabilityView _subtreeAvailability;
+};
+
+} // namespace Cesium3DTilesSelection
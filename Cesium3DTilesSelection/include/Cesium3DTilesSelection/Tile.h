@@ -18,6 +18,7 @@
 #include <gsl/span>
 
 #include <atomic>
+#include <cstdint>
 #include <limits>
 #include <memory>
 #include <optional>
@@ -28,6 +29,7 @@ namespace Cesium3DTilesSelection {
 class Tileset;
 class TileContent;
 struct TileContentLoadResult;
+struct UpsampledChildModels;
 
 /**
  * @brief A tile in a {@link Tileset}.
@@ -225,6 +227,16 @@ public:
    */
   void createChildTiles(std::vector<Tile>&& children);
 
+  /**
+   * @brief Destroys the child tiles of this tile.
+   *
+   * This function is not supposed to be called by clients. It is used to
+   * return children that were created from {@link TileContext::packedTiles}
+   * to their packed form, and requires that none of the children or their
+   * descendants are loaded or in use.
+   */
+  void destroyChildTiles() noexcept;
+
   /**
    * @brief Returns the {@link BoundingVolume} of this tile.
    *
@@ -399,6 +411,31 @@ public:
    */
   void setTileID(const TileID& id) noexcept;
 
+  /**
+   * @brief Returns the offset of this tile's record in the
+   * {@link TileContext::packedTiles} of its context, if its children are
+   * created from that record.
+   *
+   * This function is not supposed to be called by clients.
+   *
+   * @return The offset of the record.
+   */
+  const std::optional<uint64_t>& getPackedTileRecord() const noexcept {
+    return this->_packedTileRecord;
+  }
+
+  /**
+   * @brief Set the offset of this tile's record in the
+   * {@link TileContext::packedTiles} of its context.
+   *
+   * This function is not supposed to be called by clients.
+   *
+   * @param value The offset of the record.
+   */
+  void setPackedTileRecord(const std::optional<uint64_t>& value) noexcept {
+    this->_packedTileRecord = value;
+  }
+
   /**
    * @brief Returns the {@link BoundingVolume} of the renderable content of this
    * tile.
@@ -573,6 +610,9 @@ public:
   /**
    * @brief Determines the number of bytes in this tile's geometry and texture
    * data.
+   *
+   * This includes the models upsampled for this tile's children that those
+   * children have not taken yet.
    */
   int64_t computeByteSize() const noexcept;
 
@@ -606,11 +646,20 @@ private:
   TileID _id;
   std::optional<BoundingVolume> _contentBoundingVolume;
 
+  // The record from which this tile's children are created, if they are
+  // created lazily.
+  std::optional<uint64_t> _packedTileRecord;
+
   // Load state and data.
   std::atomic<LoadState> _state;
   std::unique_ptr<TileContentLoadResult> _pContent;
   void* _pRendererResources;
 
+  // The models of this tile's upsampled children, which are created together
+  // in one pass when the first of them loads, and count towards this tile's
+  // data bytes until the children take them.
+  std::shared_ptr<UpsampledChildModels> _pUpsampledChildren;
+
   // Selection state
   TileSelectionState _lastSelectionState;
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "FeatureIndex.h"
 #include "Tile.h"
 #include "TileContext.h"
 
@@ -120,6 +121,16 @@ struct TileContentLoadResult {
    * If this tile does not have any overlays, this field will be std::nullopt.
    */
   std::optional<TileContentDetailsForOverlays> overlayDetails;
+
+  /**
+   * @brief An index of the features of the {@link model}, for finding them by
+   * location or by property value.
+   *
+   * This is only created when
+   * {@link TilesetContentOptions::createFeatureIndex} is set and the content
+   * has a model, otherwise it is std::nullopt.
+   */
+  std::optional<FeatureIndex> featureIndex;
 };
 
 } // namespace Cesium3DTilesSelection
@@ -1,10 +1,17 @@
 #pragma once
 
+#include "SubtreeAvailability.h"
+
+#include <CesiumGeometry/OctreeTileID.h>
 #include <CesiumGeometry/QuadtreeTileAvailability.h>
 #include <CesiumGeometry/QuadtreeTilingScheme.h>
 #include <CesiumGeospatial/Projection.h>
 
+#include <cstddef>
+#include <cstdint>
+#include <optional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace Cesium3DTilesSelection {
@@ -51,6 +58,67 @@ public:
   CesiumGeometry::QuadtreeTileAvailability availability;
 };
 
+/**
+ * @brief A tiling context that was created for a tile that uses 3D Tiles
+ * implicit tiling.
+ *
+ * The tile is the root of the implicit tileset. It, and each of its
+ * descendants, has a {@link CesiumGeometry::QuadtreeTileID} or a
+ * {@link CesiumGeometry::OctreeTileID}, depending on the subdivision scheme.
+ * A tile's children are created when they are needed, from the availability
+ * in the subtree that contains them, and their bounding volumes are the
+ * corresponding parts of the tile's bounding volume.
+ */
+class SubtreeTilingContext final {
+public:
+  /**
+   * @brief How each tile is divided into its children.
+   */
+  ImplicitTilingSubdivisionScheme subdivisionScheme =
+      ImplicitTilingSubdivisionScheme::Quadtree;
+
+  /**
+   * @brief The number of levels in each subtree.
+   */
+  uint32_t subtreeLevels = 0;
+
+  /**
+   * @brief The number of levels that have any available tiles.
+   */
+  uint32_t availableLevels = 0;
+
+  /**
+   * @brief The template for the relative URLs of subtrees.
+   *
+   * The template elements of this URL may be `level`, `x`, `y`, or `z`, and
+   * will be substituted with the corresponding information from the ID of the
+   * subtree's root tile.
+   */
+  std::string subtreeTemplateUrl;
+
+  /**
+   * @brief The template for the relative URLs of the content of tiles, if
+   * they have content.
+   *
+   * The template elements are the same as those of the
+   * {@link subtreeTemplateUrl}.
+   */
+  std::optional<std::string> contentTemplateUrl;
+
+  /**
+   * @brief The subtrees that have been requested, by the ID of their root
+   * tile.
+   *
+   * Quadtree IDs are stored with a z-coordinate of 0. A subtree that is still
+   * loading has no value, and a subtree that failed to load is one in which
+   * nothing is available.
+   */
+  std::unordered_map<
+      CesiumGeometry::OctreeTileID,
+      std::optional<SubtreeAvailability>>
+      subtrees;
+};
+
 /**
  * @brief The action to take for a failed tile.
  */
@@ -115,7 +183,8 @@ typedef std::function<ContextInitializerSignature> ContextInitializerCallback;
  * contexts of the tileset with {@link Tileset::addContext}.
  *
  * Tilesets that contain terrain tiles may additionally create
- * an {@link ImplicitTilingContext}.
+ * an {@link ImplicitTilingContext}, and tilesets with a tile that uses 3D
+ * Tiles implicit tiling create a {@link SubtreeTilingContext}.
  */
 class TileContext final {
 public:
@@ -148,6 +217,14 @@ public:
    */
   std::optional<ImplicitTilingContext> implicitContext;
 
+  /**
+   * @brief A {@link SubtreeTilingContext} that may have been created for the
+   * tile of this context that uses 3D Tiles implicit tiling.
+   *
+   * Only one tile in each tileset.json may use implicit tiling.
+   */
+  std::optional<SubtreeTilingContext> subtreeContext;
+
   /**
    * @brief An optional {@link FailedTileCallback}.
    *
@@ -166,6 +243,16 @@ public:
    * properties of its parent context.
    */
   ContextInitializerCallback contextInitializerCallback;
+
+  /**
+   * @brief The tiles of this context that are created lazily, in a packed
+   * form.
+   *
+   * This is only used when {@link TilesetContentOptions::createChildTilesLazily}
+   * is enabled. A tile whose children are created from this data refers to its
+   * record here with {@link Tile::getPackedTileRecord}.
+   */
+  std::vector<std::byte> packedTiles;
 };
 
 } // namespace Cesium3DTilesSelection
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "FeatureIndex.h"
 #include "Library.h"
 #include "RasterOverlayCollection.h"
 #include "Tile.h"
@@ -184,6 +185,12 @@ public:
    */
   void notifyTileUnloading(Tile* pTile) noexcept;
 
+  /**
+   * @brief Notifies the tileset that the data of a loaded tile has grown or
+   * shrunk by the given number of bytes.
+   */
+  void notifyTileDataBytesChanged(int64_t bytes) noexcept;
+
   /**
    * @brief Loads a tile tree from a tileset.json file.
    *
@@ -234,6 +241,20 @@ public:
    */
   void forEachLoadedTile(const std::function<void(Tile& tile)>& callback);
 
+  /**
+   * @brief Invokes a function for the {@link FeatureIndex} of each tile that is
+   * currently loaded and has one.
+   *
+   * Tiles only have feature indices when
+   * {@link TilesetContentOptions::createFeatureIndex} is set. Each index
+   * identifies features by their feature table and feature ID within the tile.
+   *
+   * @param callback The function to invoke.
+   */
+  void forEachLoadedFeatureIndex(
+      const std::function<void(const Tile& tile, const FeatureIndex& index)>&
+          callback) const;
+
   /**
    * @brief Gets the total number of bytes of tile and raster overlay data that
    * are currently loaded.
@@ -346,13 +367,14 @@ private:
    * return value will be `nullptr`.
    *
    * @param pRequest The request for which the response was received.
+   * @param contentOptions The options for loading the tileset's content.
    * @return The LoadResult structure
    */
   static LoadResult _handleTilesetResponse(
       std::shared_ptr<CesiumAsync::IAssetRequest>&& pRequest,
       std::unique_ptr<TileContext>&& pContext,
       const std::shared_ptr<spdlog::logger>& pLogger,
-      bool useWaterMask);
+      const TilesetContentOptions& contentOptions);
 
   CesiumAsync::Future<void> _loadTilesetJson(
       const std::string& url,
@@ -507,6 +529,8 @@ private:
 
   void _processLoadQueue();
   void _unloadCachedTiles() noexcept;
+  void _destroyUnusedPackedChildTiles(Tile* pTile) noexcept;
+  bool _isTileUnused(const Tile& tile) const noexcept;
   void _markTileVisited(Tile& tile) noexcept;
 
   std::string getResolvedContentUrl(const Tile& tile) const;
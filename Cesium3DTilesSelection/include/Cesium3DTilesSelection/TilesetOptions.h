@@ -7,6 +7,10 @@
 #include <string>
 #include <vector>
 
+namespace CesiumAsync {
+class ICacheDatabase;
+}
+
 namespace Cesium3DTilesSelection {
 
 class ITileExcluder;
@@ -35,6 +39,60 @@ struct CESIUM3DTILESSELECTION_API TilesetContentOptions {
    * normals.
    */
   bool generateMissingNormalsSmooth = false;
+
+  /**
+   * @brief Whether to create the tiles of a tileset.json only when they are
+   * first traversed.
+   *
+   * When enabled, the tiles below the root of each tileset.json are kept in a
+   * compact packed form, and a tile's children are created from it when the
+   * tile is first updated. Children are destroyed again once they have all been
+   * unloaded from the cache and are no longer visited. This reduces the time to
+   * load and the memory used by tilesets with a great many tiles.
+   */
+  bool createChildTilesLazily = false;
+
+  /**
+   * @brief Whether to convert the batch tables of batched 3D models to
+   * `EXT_feature_metadata` only when their metadata is first accessed.
+   *
+   * When enabled, the batch table JSON and binary are kept with the model in
+   * {@link CesiumGltf::Model::pLazyFeatureMetadata}, and are converted when a
+   * {@link CesiumGltf::MetadataFeatureTableView} is first created for the
+   * model. This saves the time to convert metadata that is never used.
+   */
+  bool convertBatchTablesLazily = false;
+
+  /**
+   * @brief Whether to create a {@link FeatureIndex} for each loaded tile.
+   *
+   * The index is created in the load thread and stored in
+   * {@link TileContentLoadResult::featureIndex}, so that features can be found
+   * by location or by property value without scanning every vertex and
+   * feature of the tile. Creating the index converts any lazily converted
+   * batch tables.
+   */
+  bool createFeatureIndex = false;
+
+  /**
+   * @brief The names of the feature properties to index when
+   * {@link createFeatureIndex} is set.
+   *
+   * Only the bounding regions of features are indexed when this is empty.
+   */
+  std::vector<std::string> indexedFeatureProperties;
+
+  /**
+   * @brief An optional database in which to keep the tiles of each
+   * tileset.json in a compact binary form, so they can be created again
+   * without parsing the JSON.
+   *
+   * Entries are keyed by the URL and the `ETag` of the tileset.json response,
+   * so a tileset.json that has changed is parsed again. Responses without an
+   * `ETag` are not cached. This may be the same database that caches the
+   * responses themselves.
+   */
+  std::shared_ptr<CesiumAsync::ICacheDatabase> pTilesetJsonCache;
 };
 
 /**
@@ -193,8 +193,11 @@ Batched3DModelContent::load(const TileContentLoadInput& input) {
       .thenInWorkerThread([header = std::move(header),
                            headerLength,
                            pLogger,
-                           pRequest](std::unique_ptr<TileContentLoadResult>&&
-                                         pResult) {
+                           pRequest,
+                           convertBatchTablesLazily =
+                               input.contentOptions.convertBatchTablesLazily](
+                              std::unique_ptr<TileContentLoadResult>&&
+                                  pResult) {
         if (pResult->model && header.featureTableJsonByteLength > 0) {
           CesiumGltf::Model& gltf = pResult->model.value();
 
@@ -220,6 +223,16 @@ Batched3DModelContent::load(const TileContentLoadInput& input) {
                         batchTableStart + header.batchTableJsonByteLength),
                     header.batchTableBinaryByteLength);
 
+            if (convertBatchTablesLazily) {
+              deferBatchTableUpgradeToFeatureMetadata(
+                  pLogger,
+                  gltf,
+                  featureTable,
+                  batchTableJsonData,
+                  batchTableBinaryData);
+              return std::move(pResult);
+            }
+
             rapidjson::Document batchTableJson;
             batchTableJson.Parse(
                 reinterpret_cast<const char*>(batchTableJsonData.data()),
@@ -190,8 +190,12 @@ CompositeContent::load(const TileContentLoadInput& input) {
 
     pos += pInner->byteLength;
 
-    innerTiles.push_back(
-        TileContentFactory::createContent(derive(input, innerData)));
+    // Decode each inner tile in its own worker task so that they are decoded
+    // concurrently, even when this load is itself running in a worker.
+    innerTiles.push_back(input.asyncSystem.startInWorkerThread(
+        [innerInput = derive(input, innerData)]() {
+          return TileContentFactory::createContent(innerInput);
+        }));
   }
 
   return input.asyncSystem.all(std::move(innerTiles))
@@ -208,23 +212,24 @@ CompositeContent::load(const TileContentLoadInput& input) {
               }
               return std::unique_ptr<TileContentLoadResult>(nullptr);
             }
-            if (innerTilesResult.size() == 1) {
-              return std::move(innerTilesResult[0]);
-            }
-
-            std::unique_ptr<TileContentLoadResult> pResult =
-                std::move(innerTilesResult[0]);
+            // Merge the inner models, in order, into the first one that
+            // loaded. Merging moves the buffers rather than copying them.
+            std::unique_ptr<TileContentLoadResult> pResult;
+            for (std::unique_ptr<TileContentLoadResult>& pInner :
+                 innerTilesResult) {
+              if (!pResult) {
+                pResult = std::move(pInner);
+                continue;
+              }
 
-            for (size_t i = 1; i < innerTilesResult.size(); ++i) {
-              if (!innerTilesResult[i] || !innerTilesResult[i]->model) {
+              if (!pInner || !pInner->model) {
                 continue;
               }
 
               if (pResult->model) {
-                pResult->model.value().merge(
-                    std::move(innerTilesResult[i]->model.value()));
+                pResult->model.value().merge(std::move(pInner->model.value()));
               } else {
-                pResult->model = std::move(innerTilesResult[i]->model);
+                pResult->model = std::move(pInner->model);
               }
             }
 
@@ -1,13 +1,12 @@
 #include "Cesium3DTilesSelection/ExternalTilesetContent.h"
 
 #include "Cesium3DTilesSelection/Tile.h"
-#include "Cesium3DTilesSelection/Tileset.h"
 #include "Cesium3DTilesSelection/spdlog-cesium.h"
+#include "readTilesetJson.h"
 
 #include <CesiumAsync/IAssetResponse.h>
 #include <CesiumUtility/Uri.h>
-
-#include <rapidjson/document.h>
+#include <CesiumUtility/joinToString.h>
 
 #include <cstddef>
 
@@ -20,7 +19,9 @@ ExternalTilesetContent::load(const TileContentLoadInput& input) {
       input.tileTransform,
       input.tileRefine,
       input.pRequest->url(),
-      input.pRequest->response()->data()));
+      input.pRequest->response()->headers(),
+      input.pRequest->response()->data(),
+      input.contentOptions));
 }
 
 /*static*/ std::unique_ptr<TileContentLoadResult> ExternalTilesetContent::load(
@@ -28,22 +29,12 @@ ExternalTilesetContent::load(const TileContentLoadInput& input) {
     const glm::dmat4& tileTransform,
     TileRefine tileRefine,
     const std::string& url,
-    const gsl::span<const std::byte>& data) {
+    const CesiumAsync::HttpHeaders& responseHeaders,
+    const gsl::span<const std::byte>& data,
+    const TilesetContentOptions& contentOptions) {
   std::unique_ptr<TileContentLoadResult> pResult =
       std::make_unique<TileContentLoadResult>();
 
-  rapidjson::Document tilesetJson;
-  tilesetJson.Parse(reinterpret_cast<const char*>(data.data()), data.size());
-
-  if (tilesetJson.HasParseError()) {
-    SPDLOG_LOGGER_ERROR(
-        pLogger,
-        "Error when parsing tileset JSON, error code {} at byte offset {}",
-        tilesetJson.GetParseError(),
-        tilesetJson.GetErrorOffset());
-    return pResult;
-  }
-
   pResult->childTiles.emplace(1);
 
   pResult->pNewTileContext = std::make_unique<TileContext>();
@@ -60,13 +51,27 @@ ExternalTilesetContent::load(const TileContentLoadInput& input) {
 
   pResult->childTiles.value()[0].setContext(pContext);
 
-  Tileset::loadTilesFromJson(
-      pResult->childTiles.value()[0],
-      tilesetJson,
-      tileTransform,
-      tileRefine,
-      *pContext,
-      pLogger);
+  CesiumJsonReader::ReadJsonResult<TilesetJson> tilesetResult =
+      readTilesetJsonWithCache(
+          url,
+          responseHeaders,
+          data,
+          pResult->childTiles.value()[0],
+          tileTransform,
+          tileRefine,
+          *pContext,
+          pLogger,
+          contentOptions.createChildTilesLazily,
+          contentOptions.pTilesetJsonCache.get());
+
+  if (!tilesetResult.value) {
+    SPDLOG_LOGGER_ERROR(
+        pLogger,
+        "Error when parsing tileset JSON: {}",
+        CesiumUtility::joinToString(tilesetResult.errors, "\n- "));
+    pResult->childTiles.reset();
+    pResult->pNewTileContext.reset();
+  }
 
   return pResult;
 }
@@ -0,0 +1,468 @@
+#include "Cesium3DTilesSelection/FeatureIndex.h"
+
+#include "Cesium3DTilesSelection/GltfContent.h"
+
+#include <CesiumGeospatial/Cartographic.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumGltf/AccessorView.h>
+#include <CesiumGltf/DequantizedAccessorView.h>
+#include <CesiumGltf/ExtensionMeshPrimitiveExtFeatureMetadata.h>
+#include <CesiumGltf/ExtensionModelExtFeatureMetadata.h>
+#include <CesiumGltf/MetadataFeatureTableView.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumUtility/Math.h>
+#include <CesiumUtility/Tracing.h>
+
+#include <gsl/span>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <string_view>
+
+using namespace CesiumGeospatial;
+using namespace CesiumGltf;
+using namespace CesiumUtility;
+
+namespace Cesium3DTilesSelection {
+
+namespace {
+
+/**
+ * @brief The extent of the vertices of a feature found so far, with longitudes
+ * unwrapped relative to the first vertex so that features crossing the
+ * anti-meridian have the expected extent.
+ */
+struct FeatureExtent {
+  double west = std::numeric_limits<double>::max();
+  double south = std::numeric_limits<double>::max();
+  double east = std::numeric_limits<double>::lowest();
+  double north = std::numeric_limits<double>::lowest();
+  double minimumHeight = std::numeric_limits<double>::max();
+  double maximumHeight = std::numeric_limits<double>::lowest();
+  bool haveFirst = false;
+
+  void expand(const Cartographic& cartographic) noexcept {
+    double longitude = cartographic.longitude;
+    if (this->haveFirst) {
+      const double difference = longitude - this->west;
+      if (difference > Math::ONE_PI) {
+        longitude -= Math::TWO_PI;
+      } else if (difference < -Math::ONE_PI) {
+        longitude += Math::TWO_PI;
+      }
+    } else {
+      this->haveFirst = true;
+    }
+
+    // The computation of longitude is very unstable at the poles, so don't let
+    // extreme latitudes affect the longitude extent.
+    if (glm::abs(glm::abs(cartographic.latitude) - Math::PI_OVER_TWO) >
+        Math::EPSILON6) {
+      this->west = glm::min(this->west, longitude);
+      this->east = glm::max(this->east, longitude);
+    }
+    this->south = glm::min(this->south, cartographic.latitude);
+    this->north = glm::max(this->north, cartographic.latitude);
+    this->minimumHeight = glm::min(this->minimumHeight, cartographic.height);
+    this->maximumHeight = glm::max(this->maximumHeight, cartographic.height);
+  }
+};
+
+template <typename T, typename Callback>
+void forEachVertexFeatureIdOfType(
+    const Model& model,
+    int32_t accessorIndex,
+    int64_t vertexCount,
+    Callback& callback) {
+  const AccessorView<T> featureIds(model, accessorIndex);
+  if (featureIds.status() != AccessorViewStatus::Valid) {
+    return;
+  }
+
+  const int64_t count = glm::min(featureIds.size(), vertexCount);
+  for (int64_t i = 0; i < count; ++i) {
+    callback(i, static_cast<double>(featureIds[i]));
+  }
+}
+
+/**
+ * @brief Calls a function with the index and feature ID of each vertex of a
+ * primitive, for a feature ID attribute of `EXT_feature_metadata`.
+ *
+ * Feature IDs are passed as doubles, because feature ID accessors may have
+ * floating-point components, and must be checked by the callback.
+ */
+template <typename Callback>
+void forEachVertexFeatureId(
+    const Model& model,
+    const MeshPrimitive& primitive,
+    const FeatureIDs& featureIds,
+    int64_t vertexCount,
+    Callback&& callback) {
+  if (!featureIds.attribute) {
+    // Implicit feature IDs.
+    for (int64_t i = 0; i < vertexCount; ++i) {
+      const int64_t featureId =
+          featureIds.constant +
+          (featureIds.divisor > 0 ? i / featureIds.divisor : 0);
+      callback(i, static_cast<double>(featureId));
+    }
+    return;
+  }
+
+  const auto attributeIt = primitive.attributes.find(*featureIds.attribute);
+  if (attributeIt == primitive.attributes.end()) {
+    return;
+  }
+
+  const int32_t accessorIndex = attributeIt->second;
+  const Accessor* pAccessor = Model::getSafe(&model.accessors, accessorIndex);
+  if (!pAccessor) {
+    return;
+  }
+
+  switch (pAccessor->componentType) {
+  case Accessor::ComponentType::UNSIGNED_BYTE:
+    forEachVertexFeatureIdOfType<uint8_t>(
+        model,
+        accessorIndex,
+        vertexCount,
+        callback);
+    break;
+  case Accessor::ComponentType::UNSIGNED_SHORT:
+    forEachVertexFeatureIdOfType<uint16_t>(
+        model,
+        accessorIndex,
+        vertexCount,
+        callback);
+    break;
+  case Accessor::ComponentType::UNSIGNED_INT:
+    forEachVertexFeatureIdOfType<uint32_t>(
+        model,
+        accessorIndex,
+        vertexCount,
+        callback);
+    break;
+  case Accessor::ComponentType::FLOAT:
+    forEachVertexFeatureIdOfType<float>(
+        model,
+        accessorIndex,
+        vertexCount,
+        callback);
+    break;
+  default:
+    break;
+  }
+}
+
+template <typename T, typename Less>
+std::vector<int64_t>
+sortFeatureIds(const std::vector<T>& values, Less&& less) {
+  std::vector<int64_t> featureIds(values.size());
+  std::iota(featureIds.begin(), featureIds.end(), int64_t(0));
+  std::stable_sort(
+      featureIds.begin(),
+      featureIds.end(),
+      [&values, &less](int64_t a, int64_t b) {
+        return less(
+            values[static_cast<size_t>(a)],
+            values[static_cast<size_t>(b)]);
+      });
+  return featureIds;
+}
+
+} // namespace
+
+/*static*/ FeatureIndex FeatureIndex::create(
+    const Model& model,
+    const glm::dmat4& transform,
+    const std::vector<std::string>& indexedProperties) {
+  CESIUM_TRACE("Cesium3DTilesSelection::FeatureIndex::create");
+
+  FeatureIndex index;
+
+  const Model& metadataModel = model.getFeatureMetadataModel();
+  const ExtensionModelExtFeatureMetadata* pMetadata =
+      metadataModel.getExtension<ExtensionModelExtFeatureMetadata>();
+  if (!pMetadata) {
+    return index;
+  }
+
+  // Find the extent of the vertices of each feature.
+  std::map<std::string, std::vector<FeatureExtent>> extents;
+  for (const auto& [name, featureTable] : pMetadata->featureTables) {
+    extents[name].resize(
+        static_cast<size_t>(glm::max(featureTable.count, int64_t(0))));
+  }
+
+  glm::dmat4 rootTransform = transform;
+  rootTransform = GltfContent::applyRtcCenter(model, rootTransform);
+  rootTransform = GltfContent::applyGltfUpAxisTransform(model, rootTransform);
+
+  std::vector<std::optional<Cartographic>> positions;
+  model.forEachPrimitiveInScene(
+      -1,
+      [&rootTransform, &extents, &positions](
+          const Model& gltf,
+          const Node& /*node*/,
+          const Mesh& /*mesh*/,
+          const MeshPrimitive& primitive,
+          const glm::dmat4& nodeTransform) {
+        const ExtensionMeshPrimitiveExtFeatureMetadata* pPrimitiveMetadata =
+            primitive.getExtension<ExtensionMeshPrimitiveExtFeatureMetadata>();
+        if (!pPrimitiveMetadata ||
+            pPrimitiveMetadata->featureIdAttributes.empty()) {
+          return;
+        }
+
+        const auto positionIt = primitive.attributes.find("POSITION");
+        if (positionIt == primitive.attributes.end()) {
+          return;
+        }
+
+        const DequantizedAccessorView<glm::vec3> positionView(
+            gltf,
+            positionIt->second);
+        if (positionView.status() != AccessorViewStatus::Valid) {
+          return;
+        }
+
+        // Convert each position once, however many feature ID attributes
+        // refer to it.
+        const glm::dmat4 fullTransform = rootTransform * nodeTransform;
+        positions.resize(static_cast<size_t>(positionView.size()));
+        for (int64_t i = 0; i < positionView.size(); ++i) {
+          const glm::dvec3 positionEcef = glm::dvec3(
+              fullTransform * glm::dvec4(glm::dvec3(positionView[i]), 1.0));
+          positions[static_cast<size_t>(i)] =
+              Ellipsoid::WGS84.cartesianToCartographic(positionEcef);
+        }
+
+        for (const FeatureIDAttribute& attribute :
+             pPrimitiveMetadata->featureIdAttributes) {
+          const auto extentsIt = extents.find(attribute.featureTable);
+          if (extentsIt == extents.end()) {
+            continue;
+          }
+
+          std::vector<FeatureExtent>& featureExtents = extentsIt->second;
+          const double featureCount =
+              static_cast<double>(featureExtents.size());
+          forEachVertexFeatureId(
+              gltf,
+              primitive,
+              attribute.featureIds,
+              positionView.size(),
+              [&featureExtents, &positions, featureCount](
+                  int64_t vertex,
+                  double featureId) {
+                const std::optional<Cartographic>& position =
+                    positions[static_cast<size_t>(vertex)];
+                if (!(featureId >= 0.0 && featureId < featureCount) ||
+                    !position) {
+                  return;
+                }
+
+                featureExtents[static_cast<size_t>(featureId)].expand(
+                    *position);
+              });
+        }
+      });
+
+  for (const auto& [name, featureTable] : pMetadata->featureTables) {
+    FeatureTableIndex& tableIndex = index._featureTables[name];
+
+    const std::vector<FeatureExtent>& featureExtents = extents[name];
+    tableIndex.features.resize(featureExtents.size());
+    for (size_t i = 0; i < featureExtents.size(); ++i) {
+      const FeatureExtent& extent = featureExtents[i];
+      if (!extent.haveFirst) {
+        continue;
+      }
+
+      // Put longitudes back in the -PI to PI range, which may make east < west
+      // but that's ok.
+      FeatureBounds& bounds = tableIndex.features[i];
+      bounds.rectangle = GlobeRectangle(
+          Math::negativePiToPi(extent.west),
+          extent.south,
+          Math::negativePiToPi(extent.east),
+          extent.north);
+      bounds.minimumHeight = extent.minimumHeight;
+      bounds.maximumHeight = extent.maximumHeight;
+    }
+
+    // Index the chosen properties.
+    const MetadataFeatureTableView view(&metadataModel, &featureTable);
+    const size_t featureCount = featureExtents.size();
+    for (const std::string& propertyName : indexedProperties) {
+      const ClassProperty* pClassProperty =
+          view.getClassProperty(propertyName);
+      if (!pClassProperty) {
+        continue;
+      }
+
+      if (pClassProperty->type == ClassProperty::Type::BOOLEAN) {
+        const MetadataPropertyView<bool> property =
+            view.getPropertyView<bool>(propertyName);
+        if (property.status() != MetadataPropertyViewStatus::Valid) {
+          continue;
+        }
+
+        std::vector<uint8_t> values(featureCount);
+        property.copyValues(0, gsl::span<uint8_t>(values));
+        PropertyIndex& propertyIndex = tableIndex.properties[propertyName];
+        propertyIndex.booleans.assign(values.begin(), values.end());
+      } else if (pClassProperty->type == ClassProperty::Type::STRING) {
+        const MetadataPropertyView<std::string_view> property =
+            view.getPropertyView<std::string_view>(propertyName);
+        if (property.status() != MetadataPropertyViewStatus::Valid) {
+          continue;
+        }
+
+        std::vector<std::string_view> values(featureCount);
+        property.copyValues(0, gsl::span<std::string_view>(values));
+        PropertyIndex& propertyIndex = tableIndex.properties[propertyName];
+        propertyIndex.sortedFeatureIds =
+            sortFeatureIds(values, std::less<std::string_view>());
+        propertyIndex.sortedStrings.reserve(featureCount);
+        for (int64_t featureId : propertyIndex.sortedFeatureIds) {
+          propertyIndex.sortedStrings.emplace_back(
+              values[static_cast<size_t>(featureId)]);
+        }
+      } else {
+        std::vector<double> values(featureCount);
+        if (view.copyPropertyValues(
+                propertyName,
+                0,
+                gsl::span<double>(values)) !=
+            MetadataPropertyViewStatus::Valid) {
+          continue;
+        }
+
+        // NaN values can't be found by a range, so they are left out, which
+        // also keeps the sort well-defined.
+        PropertyIndex& propertyIndex = tableIndex.properties[propertyName];
+        propertyIndex.sortedFeatureIds =
+            sortFeatureIds(values, [](double a, double b) {
+              return a < b || (!std::isnan(a) && std::isnan(b));
+            });
+        propertyIndex.sortedNumbers.reserve(featureCount);
+        for (int64_t featureId : propertyIndex.sortedFeatureIds) {
+          const double value = values[static_cast<size_t>(featureId)];
+          if (std::isnan(value)) {
+            break;
+          }
+          propertyIndex.sortedNumbers.emplace_back(value);
+        }
+        propertyIndex.sortedFeatureIds.resize(
+            propertyIndex.sortedNumbers.size());
+      }
+    }
+  }
+
+  return index;
+}
+
+std::optional<BoundingRegion> FeatureIndex::getFeatureBoundingRegion(
+    const std::string& featureTable,
+    int64_t featureId) const {
+  const auto tableIt = this->_featureTables.find(featureTable);
+  if (tableIt == this->_featureTables.end() || featureId < 0 ||
+      static_cast<size_t>(featureId) >= tableIt->second.features.size()) {
+    return std::nullopt;
+  }
+
+  const FeatureBounds& bounds =
+      tableIt->second.features[static_cast<size_t>(featureId)];
+  if (bounds.minimumHeight > bounds.maximumHeight) {
+    return std::nullopt;
+  }
+
+  return BoundingRegion(
+      bounds.rectangle,
+      bounds.minimumHeight,
+      bounds.maximumHeight);
+}
+
+void FeatureIndex::findFeaturesInRectangle(
+    const GlobeRectangle& rectangle,
+    const Callback& callback) const {
+  for (const auto& [name, tableIndex] : this->_featureTables) {
+    for (size_t i = 0; i < tableIndex.features.size(); ++i) {
+      const FeatureBounds& bounds = tableIndex.features[i];
+      if (bounds.minimumHeight <= bounds.maximumHeight &&
+          rectangle.computeIntersection(bounds.rectangle)) {
+        callback(name, static_cast<int64_t>(i));
+      }
+    }
+  }
+}
+
+void FeatureIndex::findFeaturesInRange(
+    const std::string& propertyName,
+    double minimum,
+    double maximum,
+    const Callback& callback) const {
+  for (const auto& [name, tableIndex] : this->_featureTables) {
+    const auto propertyIt = tableIndex.properties.find(propertyName);
+    if (propertyIt == tableIndex.properties.end()) {
+      continue;
+    }
+
+    const std::vector<double>& values = propertyIt->second.sortedNumbers;
+    const auto first = std::lower_bound(values.begin(), values.end(), minimum);
+    const auto last = std::upper_bound(first, values.end(), maximum);
+    for (auto it = first; it < last; ++it) {
+      callback(
+          name,
+          propertyIt->second.sortedFeatureIds[static_cast<size_t>(
+              it - values.begin())]);
+    }
+  }
+}
+
+void FeatureIndex::findFeaturesWithBoolean(
+    const std::string& propertyName,
+    bool value,
+    const Callback& callback) const {
+  for (const auto& [name, tableIndex] : this->_featureTables) {
+    const auto propertyIt = tableIndex.properties.find(propertyName);
+    if (propertyIt == tableIndex.properties.end()) {
+      continue;
+    }
+
+    const std::vector<bool>& booleans = propertyIt->second.booleans;
+    for (size_t i = 0; i < booleans.size(); ++i) {
+      if (booleans[i] == value) {
+        callback(name, static_cast<int64_t>(i));
+      }
+    }
+  }
+}
+
+void FeatureIndex::findFeaturesWithString(
+    const std::string& propertyName,
+    const std::string& value,
+    const Callback& callback) const {
+  for (const auto& [name, tableIndex] : this->_featureTables) {
+    const auto propertyIt = tableIndex.properties.find(propertyName);
+    if (propertyIt == tableIndex.properties.end()) {
+      continue;
+    }
+
+    const std::vector<std::string>& strings = propertyIt->second.sortedStrings;
+    const auto [first, last] =
+        std::equal_range(strings.begin(), strings.end(), value);
+    for (auto it = first; it < last; ++it) {
+      callback(
+          name,
+          propertyIt->second.sortedFeatureIds[static_cast<size_t>(
+              it - strings.begin())]);
+    }
+  }
+}
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,135 @@
+#include "FeatureTableUtilities.h"
+
+#include "Cesium3DTilesSelection/spdlog-cesium.h"
+
+#include <rapidjson/document.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Cesium3DTilesSelection {
+namespace Impl {
+
+namespace {
+
+/**
+ * @brief Decodes oct-encoded unit vectors whose components have the given
+ * maximum value.
+ *
+ * This folds the octahedron without branches so that large numbers of vectors
+ * can be decoded with SIMD instructions.
+ */
+template <typename T>
+void octDecode(
+    const std::vector<T>& encoded,
+    float rangeMax,
+    std::vector<float>& normals) {
+  for (size_t i = 0, j = 0; i + 1 < encoded.size(); i += 2, j += 3) {
+    float x = float(encoded[i]) / rangeMax * 2.0f - 1.0f;
+    float y = float(encoded[i + 1]) / rangeMax * 2.0f - 1.0f;
+    const float z = 1.0f - (std::abs(x) + std::abs(y));
+    const float fold = std::max(-z, 0.0f);
+    x += x >= 0.0f ? -fold : fold;
+    y += y >= 0.0f ? -fold : fold;
+    const float inverseLength = 1.0f / std::sqrt(x * x + y * y + z * z);
+    normals[j] = x * inverseLength;
+    normals[j + 1] = y * inverseLength;
+    normals[j + 2] = z * inverseLength;
+  }
+}
+
+} // namespace
+
+std::optional<gsl::span<const std::byte>> getFeatureTableBinaryProperty(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& url,
+    const rapidjson::Value& featureTable,
+    const gsl::span<const std::byte>& featureTableBinary,
+    const char* name,
+    size_t byteLength) {
+  const auto it = featureTable.FindMember(name);
+  if (it == featureTable.MemberEnd()) {
+    return std::nullopt;
+  }
+
+  const auto byteOffsetIt = it->value.IsObject()
+                                ? it->value.FindMember("byteOffset")
+                                : it->value.MemberEnd();
+  if (!it->value.IsObject() || byteOffsetIt == it->value.MemberEnd() ||
+      !byteOffsetIt->value.IsUint64()) {
+    SPDLOG_LOGGER_WARN(
+        pLogger,
+        "Ignoring the {} property of the feature table of {} because it does "
+        "not have a byteOffset.",
+        name,
+        url);
+    return std::nullopt;
+  }
+
+  const uint64_t byteOffset = byteOffsetIt->value.GetUint64();
+  if (byteOffset > featureTableBinary.size() ||
+      byteLength > featureTableBinary.size() - byteOffset) {
+    SPDLOG_LOGGER_WARN(
+        pLogger,
+        "Ignoring the {} property of the feature table of {} because it "
+        "extends past the end of the feature table.",
+        name,
+        url);
+    return std::nullopt;
+  }
+
+  return featureTableBinary.subspan(
+      static_cast<size_t>(byteOffset),
+      byteLength);
+}
+
+std::optional<glm::dvec3> getFeatureTableVec3(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& url,
+    const rapidjson::Value& featureTable,
+    const gsl::span<const std::byte>& featureTableBinary,
+    const char* name) {
+  const auto it = featureTable.FindMember(name);
+  if (it == featureTable.MemberEnd()) {
+    return std::nullopt;
+  }
+
+  const rapidjson::Value& value = it->value;
+  if (value.IsArray() && value.Size() == 3 && value[0].IsNumber() &&
+      value[1].IsNumber() && value[2].IsNumber()) {
+    return glm::dvec3(
+        value[0].GetDouble(),
+        value[1].GetDouble(),
+        value[2].GetDouble());
+  }
+
+  const std::optional<gsl::span<const std::byte>> data =
+      getFeatureTableBinaryProperty(
+          pLogger,
+          url,
+          featureTable,
+          featureTableBinary,
+          name,
+          3 * sizeof(float));
+  if (!data) {
+    return std::nullopt;
+  }
+
+  const std::vector<float> components = readFeatureTableArray<float>(*data);
+  return glm::dvec3(components[0], components[1], components[2]);
+}
+
+void octDecode(
+    const std::vector<uint8_t>& encoded,
+    std::vector<float>& normals) {
+  octDecode(encoded, 255.0f, normals);
+}
+
+void octDecode(
+    const std::vector<uint16_t>& encoded,
+    std::vector<float>& normals) {
+  octDecode(encoded, 65535.0f, normals);
+}
+
+} // namespace Impl
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <glm/vec3.hpp>
+#include <gsl/span>
+#include <rapidjson/fwd.h>
+#include <spdlog/fwd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+namespace Impl {
+
+/**
+ * @brief Copies the binary data of a feature table property into an array.
+ *
+ * The feature table binary is only required to be aligned within the tile,
+ * not in memory, so the data is copied rather than cast.
+ *
+ * @tparam T The type of each element.
+ * @param data The binary data.
+ * @return The elements.
+ */
+template <typename T>
+std::vector<T> readFeatureTableArray(const gsl::span<const std::byte>& data) {
+  std::vector<T> result(data.size() / sizeof(T));
+  std::memcpy(result.data(), data.data(), result.size() * sizeof(T));
+  return result;
+}
+
+/**
+ * @brief Finds the binary data of a feature table property that has
+ * `byteLength` bytes.
+ *
+ * @param pLogger The logger for warnings.
+ * @param url The URL of the tile, used in warnings.
+ * @param featureTable The feature table JSON.
+ * @param featureTableBinary The feature table binary body.
+ * @param name The name of the property.
+ * @param byteLength The number of bytes of the property.
+ * @return The data, or `std::nullopt` if the property does not exist or its
+ * data is not within the binary body, in which case a warning is logged.
+ */
+std::optional<gsl::span<const std::byte>> getFeatureTableBinaryProperty(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& url,
+    const rapidjson::Value& featureTable,
+    const gsl::span<const std::byte>& featureTableBinary,
+    const char* name,
+    size_t byteLength);
+
+/**
+ * @brief Gets a feature table property that applies to the whole tile and has
+ * three components, either from the JSON or from the binary body.
+ *
+ * @param pLogger The logger for warnings.
+ * @param url The URL of the tile, used in warnings.
+ * @param featureTable The feature table JSON.
+ * @param featureTableBinary The feature table binary body.
+ * @param name The name of the property.
+ * @return The value, or `std::nullopt` if there is no valid value.
+ */
+std::optional<glm::dvec3> getFeatureTableVec3(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& url,
+    const rapidjson::Value& featureTable,
+    const gsl::span<const std::byte>& featureTableBinary,
+    const char* name);
+
+/**
+ * @brief Decodes unit vectors that were oct-encoded in two 8-bit components,
+ * as for `NORMAL_OCT16P`.
+ *
+ * @param encoded The two components of each encoded vector.
+ * @param normals The x, y, and z of each decoded vector. Must be large enough
+ * for all of the vectors.
+ */
+void octDecode(
+    const std::vector<uint8_t>& encoded,
+    std::vector<float>& normals);
+
+/**
+ * @brief Decodes unit vectors that were oct-encoded in two 16-bit components,
+ * as for `NORMAL_UP_OCT32P`.
+ *
+ * @param encoded The two components of each encoded vector.
+ * @param normals The x, y, and z of each decoded vector. Must be large enough
+ * for all of the vectors.
+ */
+void octDecode(
+    const std::vector<uint16_t>& encoded,
+    std::vector<float>& normals);
+
+} // namespace Impl
+} // namespace Cesium3DTilesSelection
@@ -7,6 +7,7 @@
 #include <CesiumGeometry/AxisTransforms.h>
 #include <CesiumGltf/AccessorView.h>
 #include <CesiumGltf/AccessorWriter.h>
+#include <CesiumGltf/DequantizedAccessorView.h>
 #include <CesiumGltf/Model.h>
 #include <CesiumUtility/Math.h>
 #include <CesiumUtility/Tracing.h>
@@ -241,7 +242,7 @@ GltfContent::createRasterOverlayTextureCoordinates(
         bufferViews.reserve(bufferViews.size() + projections.size());
         accessors.reserve(accessors.size() + projections.size());
 
-        const CesiumGltf::AccessorView<glm::vec3> positionView(
+        const CesiumGltf::DequantizedAccessorView<glm::vec3> positionView(
             gltf,
             positionAccessorIndex);
         if (positionView.status() != CesiumGltf::AccessorViewStatus::Valid) {
@@ -438,7 +439,7 @@ GltfContent::createRasterOverlayTextureCoordinates(
 
         const glm::dmat4 fullTransform = rootTransform * nodeTransform;
 
-        const CesiumGltf::AccessorView<glm::vec3> positionView(
+        const CesiumGltf::DequantizedAccessorView<glm::vec3> positionView(
             gltf_,
             positionAccessorIndex);
         if (positionView.status() != CesiumGltf::AccessorViewStatus::Valid) {
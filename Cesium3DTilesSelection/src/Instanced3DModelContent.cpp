@@ -0,0 +1,926 @@
+#include "Instanced3DModelContent.h"
+
+#include "Cesium3DTilesSelection/GltfContent.h"
+#include "Cesium3DTilesSelection/spdlog-cesium.h"
+#include "FeatureTableUtilities.h"
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumAsync/IAssetResponse.h>
+#include <CesiumGeospatial/Transforms.h>
+#include <CesiumGltf/ExtensionExtMeshGpuInstancing.h>
+#include <CesiumUtility/Tracing.h>
+#include <CesiumUtility/Uri.h>
+
+#include <glm/gtc/quaternion.hpp>
+#include <rapidjson/document.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+
+using namespace CesiumAsync;
+using namespace Cesium3DTilesSelection::Impl;
+
+namespace {
+
+struct I3dmHeader {
+  unsigned char magic[4];
+  uint32_t version;
+  uint32_t byteLength;
+  uint32_t featureTableJsonByteLength;
+  uint32_t featureTableBinaryByteLength;
+  uint32_t batchTableJsonByteLength;
+  uint32_t batchTableBinaryByteLength;
+  uint32_t gltfFormat;
+};
+
+static_assert(sizeof(I3dmHeader) == 32);
+
+/**
+ * @brief The instances of an I3DM in the coordinate system of the tile, with
+ * each attribute tightly packed in an array of its own.
+ */
+struct DecodedInstances {
+  size_t count = 0;
+
+  /**
+   * @brief The center that the translations are relative to.
+   */
+  glm::dvec3 center = glm::dvec3(0.0);
+
+  /**
+   * @brief The x, y, and z of each translation.
+   */
+  std::vector<float> translations;
+
+  /**
+   * @brief The x, y, z, and w of each rotation quaternion, or empty if none of
+   * the instances are rotated.
+   */
+  std::vector<float> rotations;
+
+  /**
+   * @brief The x, y, and z of each scale, or empty if none of the instances
+   * are scaled.
+   */
+  std::vector<float> scales;
+
+  /**
+   * @brief The batch ID of each instance, or empty if there are none.
+   */
+  std::vector<std::byte> featureIds;
+  int32_t featureIdComponentType =
+      CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT;
+};
+
+void dequantizePositions(
+    const std::vector<uint16_t>& quantized,
+    const glm::dvec3& offset,
+    const glm::dvec3& scale,
+    std::vector<double>& positions) {
+  const double scaleX = scale.x / 65535.0;
+  const double scaleY = scale.y / 65535.0;
+  const double scaleZ = scale.z / 65535.0;
+  for (size_t i = 0; i < positions.size(); i += 3) {
+    positions[i] = offset.x + double(quantized[i]) * scaleX;
+    positions[i + 1] = offset.y + double(quantized[i + 1]) * scaleY;
+    positions[i + 2] = offset.z + double(quantized[i + 2]) * scaleZ;
+  }
+}
+
+std::optional<std::vector<float>> getNormals(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& url,
+    const rapidjson::Value& featureTable,
+    const gsl::span<const std::byte>& featureTableBinary,
+    const char* name,
+    const char* octName,
+    size_t count) {
+  const std::optional<gsl::span<const std::byte>> data =
+      getFeatureTableBinaryProperty(
+          pLogger,
+          url,
+          featureTable,
+          featureTableBinary,
+          name,
+          count * 3 * sizeof(float));
+  if (data) {
+    return readFeatureTableArray<float>(*data);
+  }
+
+  const std::optional<gsl::span<const std::byte>> octData =
+      getFeatureTableBinaryProperty(
+          pLogger,
+          url,
+          featureTable,
+          featureTableBinary,
+          octName,
+          count * 2 * sizeof(uint16_t));
+  if (octData) {
+    std::vector<float> normals(count * 3);
+    octDecode(readFeatureTableArray<uint16_t>(*octData), normals);
+    return normals;
+  }
+
+  return std::nullopt;
+}
+
+void storeRotation(const glm::dquat& rotation, float* pRotation) {
+  pRotation[0] = static_cast<float>(rotation.x);
+  pRotation[1] = static_cast<float>(rotation.y);
+  pRotation[2] = static_cast<float>(rotation.z);
+  pRotation[3] = static_cast<float>(rotation.w);
+}
+
+std::optional<DecodedInstances> decodeInstances(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& url,
+    const gsl::span<const std::byte>& featureTableJson,
+    const gsl::span<const std::byte>& featureTableBinary) {
+  rapidjson::Document featureTable;
+  featureTable.Parse(
+      reinterpret_cast<const char*>(featureTableJson.data()),
+      featureTableJson.size());
+  if (featureTable.HasParseError()) {
+    SPDLOG_LOGGER_WARN(
+        pLogger,
+        "Error when parsing the feature table JSON of the I3DM {}, error code "
+        "{} at byte offset {}.",
+        url,
+        featureTable.GetParseError(),
+        featureTable.GetErrorOffset());
+    return std::nullopt;
+  }
+
+  if (!featureTable.IsObject()) {
+    SPDLOG_LOGGER_WARN(
+        pLogger,
+        "The feature table of the I3DM {} is not a JSON object.",
+        url);
+    return std::nullopt;
+  }
+
+  const auto countIt = featureTable.FindMember("INSTANCES_LENGTH");
+  if (countIt == featureTable.MemberEnd() || !countIt->value.IsUint() ||
+      countIt->value.GetUint() == 0) {
+    SPDLOG_LOGGER_WARN(
+        pLogger,
+        "The I3DM {} does not have a valid INSTANCES_LENGTH.",
+        url);
+    return std::nullopt;
+  }
+
+  // Every instance has a position of at least three quantized components, so
+  // a count that the binary body cannot hold is rejected before anything is
+  // allocated for it.
+  const size_t count = countIt->value.GetUint();
+  if (count > featureTableBinary.size() / (3 * sizeof(uint16_t))) {
+    SPDLOG_LOGGER_WARN(
+        pLogger,
+        "The INSTANCES_LENGTH of the I3DM {} is larger than its feature table "
+        "binary can hold.",
+        url);
+    return std::nullopt;
+  }
+
+  DecodedInstances result;
+  result.count = count;
+
+  // Positions are decoded in double precision because, without an
+  // RTC_CENTER, they are usually ECEF coordinates.
+  std::vector<double> positions(count * 3);
+  const std::optional<gsl::span<const std::byte>> positionData =
+      getFeatureTableBinaryProperty(
+          pLogger,
+          url,
+          featureTable,
+          featureTableBinary,
+          "POSITION",
+          count * 3 * sizeof(float));
+  if (positionData) {
+    const std::vector<float> floats =
+        readFeatureTableArray<float>(*positionData);
+    std::copy(floats.begin(), floats.end(), positions.begin());
+  } else {
+    const std::optional<gsl::span<const std::byte>> quantizedData =
+        getFeatureTableBinaryProperty(
+            pLogger,
+            url,
+            featureTable,
+            featureTableBinary,
+            "POSITION_QUANTIZED",
+            count * 3 * sizeof(uint16_t));
+    const std::optional<glm::dvec3> offset = getFeatureTableVec3(
+        pLogger,
+        url,
+        featureTable,
+        featureTableBinary,
+        "QUANTIZED_VOLUME_OFFSET");
+    const std::optional<glm::dvec3> scale = getFeatureTableVec3(
+        pLogger,
+        url,
+        featureTable,
+        featureTableBinary,
+        "QUANTIZED_VOLUME_SCALE");
+    if (!quantizedData || !offset || !scale) {
+      SPDLOG_LOGGER_WARN(
+          pLogger,
+          "The I3DM {} does not have valid instance positions.",
+          url);
+      return std::nullopt;
+    }
+
+    dequantizePositions(
+        readFeatureTableArray<uint16_t>(*quantizedData),
+        *offset,
+        *scale,
+        positions);
+  }
+
+  // Store the translations in single precision relative to the RTC_CENTER,
+  // or, if there is none, to the center of the instances.
+  const std::optional<glm::dvec3> rtcCenter = getFeatureTableVec3(
+      pLogger,
+      url,
+      featureTable,
+      featureTableBinary,
+      "RTC_CENTER");
+  glm::dvec3 localCenter(0.0);
+  if (rtcCenter) {
+    result.center = *rtcCenter;
+  } else {
+    glm::dvec3 minimum(std::numeric_limits<double>::max());
+    glm::dvec3 maximum(std::numeric_limits<double>::lowest());
+    for (size_t i = 0; i < positions.size(); i += 3) {
+      const glm::dvec3 position(
+          positions[i],
+          positions[i + 1],
+          positions[i + 2]);
+      minimum = glm::min(minimum, position);
+      maximum = glm::max(maximum, position);
+    }
+    localCenter = (minimum + maximum) * 0.5;
+    result.center = localCenter;
+  }
+
+  result.translations.resize(count * 3);
+  for (size_t i = 0; i < positions.size(); i += 3) {
+    result.translations[i] = static_cast<float>(positions[i] - localCenter.x);
+    result.translations[i + 1] =
+        static_cast<float>(positions[i + 1] - localCenter.y);
+    result.translations[i + 2] =
+        static_cast<float>(positions[i + 2] - localCenter.z);
+  }
+
+  const std::optional<std::vector<float>> up = getNormals(
+      pLogger,
+      url,
+      featureTable,
+      featureTableBinary,
+      "NORMAL_UP",
+      "NORMAL_UP_OCT32P",
+      count);
+  const std::optional<std::vector<float>> right = getNormals(
+      pLogger,
+      url,
+      featureTable,
+      featureTableBinary,
+      "NORMAL_RIGHT",
+      "NORMAL_RIGHT_OCT32P",
+      count);
+  const auto eastNorthUpIt = featureTable.FindMember("EAST_NORTH_UP");
+  const bool eastNorthUp = eastNorthUpIt != featureTable.MemberEnd() &&
+                           eastNorthUpIt->value.IsBool() &&
+                           eastNorthUpIt->value.GetBool();
+
+  if (up && right) {
+    // The rotation maps x to the right normal, y to the up normal, and z to
+    // their cross product.
+    result.rotations.resize(count * 4);
+    for (size_t i = 0; i < count; ++i) {
+      const glm::dvec3 rightAxis(
+          (*right)[3 * i],
+          (*right)[3 * i + 1],
+          (*right)[3 * i + 2]);
+      const glm::dvec3 upAxis((*up)[3 * i], (*up)[3 * i + 1], (*up)[3 * i + 2]);
+      const glm::dmat3 rotation(
+          rightAxis,
+          upAxis,
+          glm::cross(rightAxis, upAxis));
+      storeRotation(glm::quat_cast(rotation), &result.rotations[4 * i]);
+    }
+  } else if (eastNorthUp) {
+    result.rotations.resize(count * 4);
+    for (size_t i = 0; i < count; ++i) {
+      const glm::dvec3 position = result.center - localCenter +
+                                  glm::dvec3(
+                                      positions[3 * i],
+                                      positions[3 * i + 1],
+                                      positions[3 * i + 2]);
+      const glm::dmat4 enu =
+          CesiumGeospatial::Transforms::eastNorthUpToFixedFrame(position);
+      storeRotation(glm::quat_cast(glm::dmat3(enu)), &result.rotations[4 * i]);
+    }
+  }
+
+  const std::optional<gsl::span<const std::byte>> scaleData =
+      getFeatureTableBinaryProperty(
+          pLogger,
+          url,
+          featureTable,
+          featureTableBinary,
+          "SCALE",
+          count * sizeof(float));
+  const std::optional<gsl::span<const std::byte>> nonUniformScaleData =
+      getFeatureTableBinaryProperty(
+          pLogger,
+          url,
+          featureTable,
+          featureTableBinary,
+          "SCALE_NON_UNIFORM",
+          count * 3 * sizeof(float));
+  if (scaleData || nonUniformScaleData) {
+    result.scales.assign(count * 3, 1.0f);
+    if (scaleData) {
+      const std::vector<float> scales =
+          readFeatureTableArray<float>(*scaleData);
+      for (size_t i = 0; i < count; ++i) {
+        result.scales[3 * i] = scales[i];
+        result.scales[3 * i + 1] = scales[i];
+        result.scales[3 * i + 2] = scales[i];
+      }
+    }
+    if (nonUniformScaleData) {
+      const std::vector<float> scales =
+          readFeatureTableArray<float>(*nonUniformScaleData);
+      for (size_t i = 0; i < scales.size(); ++i) {
+        result.scales[i] *= scales[i];
+      }
+    }
+  }
+
+  const auto batchIdIt = featureTable.FindMember("BATCH_ID");
+  if (batchIdIt != featureTable.MemberEnd()) {
+    std::string componentType = "UNSIGNED_SHORT";
+    if (batchIdIt->value.IsObject()) {
+      const auto componentTypeIt =
+          batchIdIt->value.FindMember("componentType");
+      if (componentTypeIt != batchIdIt->value.MemberEnd() &&
+          componentTypeIt->value.IsString()) {
+        componentType = componentTypeIt->value.GetString();
+      }
+    }
+
+    size_t componentSize = 0;
+    if (componentType == "UNSIGNED_BYTE") {
+      componentSize = sizeof(uint8_t);
+      result.featureIdComponentType =
+          CesiumGltf::Accessor::ComponentType::UNSIGNED_BYTE;
+    } else if (componentType == "UNSIGNED_SHORT") {
+      componentSize = sizeof(uint16_t);
+      result.featureIdComponentType =
+          CesiumGltf::Accessor::ComponentType::UNSIGNED_SHORT;
+    } else if (componentType == "UNSIGNED_INT") {
+      componentSize = sizeof(uint32_t);
+      result.featureIdComponentType =
+          CesiumGltf::Accessor::ComponentType::FLOAT;
+    } else {
+      SPDLOG_LOGGER_WARN(
+          pLogger,
+          "Ignoring the BATCH_ID of the I3DM {} because it has the unknown "
+          "componentType {}.",
+          url,
+          componentType);
+    }
+
+    const std::optional<gsl::span<const std::byte>> batchIdData =
+        componentSize > 0 ? getFeatureTableBinaryProperty(
+                                pLogger,
+                                url,
+                                featureTable,
+                                featureTableBinary,
+                                "BATCH_ID",
+                                count * componentSize)
+                          : std::nullopt;
+    if (batchIdData && componentSize == sizeof(uint32_t)) {
+      // Vertex attributes cannot be 32-bit integers, but floats represent
+      // every batch ID below 2^24 exactly.
+      const std::vector<uint32_t> batchIds =
+          readFeatureTableArray<uint32_t>(*batchIdData);
+      std::vector<float> featureIds(batchIds.begin(), batchIds.end());
+      result.featureIds.resize(featureIds.size() * sizeof(float));
+      std::memcpy(
+          result.featureIds.data(),
+          featureIds.data(),
+          result.featureIds.size());
+    } else if (batchIdData) {
+      result.featureIds.assign(batchIdData->begin(), batchIdData->end());
+    }
+  }
+
+  return result;
+}
+
+/**
+ * @brief Adds an accessor to the model for a tightly-packed array in a buffer
+ * view of its own.
+ */
+int32_t addInstanceAccessor(
+    CesiumGltf::Model& gltf,
+    int32_t buffer,
+    std::vector<std::byte>& bufferData,
+    const gsl::span<const std::byte>& values,
+    size_t count,
+    int32_t componentType,
+    const std::string& type) {
+  // Keep every buffer view aligned for its components.
+  const size_t byteOffset = (bufferData.size() + 3) & ~size_t(3);
+  bufferData.resize(byteOffset + values.size());
+  std::memcpy(bufferData.data() + byteOffset, values.data(), values.size());
+
+  CesiumGltf::BufferView& bufferView = gltf.bufferViews.emplace_back();
+  bufferView.buffer = buffer;
+  bufferView.byteOffset = int64_t(byteOffset);
+  bufferView.byteLength = int64_t(values.size());
+
+  CesiumGltf::Accessor& accessor = gltf.accessors.emplace_back();
+  accessor.bufferView = int32_t(gltf.bufferViews.size() - 1);
+  accessor.componentType = componentType;
+  accessor.count = int64_t(count);
+  accessor.type = type;
+
+  return int32_t(gltf.accessors.size() - 1);
+}
+
+template <typename T>
+int32_t addInstanceAccessor(
+    CesiumGltf::Model& gltf,
+    int32_t buffer,
+    std::vector<std::byte>& bufferData,
+    const std::vector<T>& values,
+    size_t count,
+    int32_t componentType,
+    const std::string& type) {
+  return addInstanceAccessor(
+      gltf,
+      buffer,
+      bufferData,
+      gsl::span<const std::byte>(
+          reinterpret_cast<const std::byte*>(values.data()),
+          values.size() * sizeof(T)),
+      count,
+      componentType,
+      type);
+}
+
+/**
+ * @brief Computes the instance transforms in the coordinate system of a node
+ * with a mesh.
+ *
+ * The instances are transforms in the coordinate system of the tile, but an
+ * `EXT_mesh_gpu_instancing` instance transform is applied before the node's
+ * own transform. So the instance transform `I` becomes `inverse(C) * I * C`,
+ * where `C` is the transform from the node to the tile, which is the product
+ * of the glTF up-axis transform and the node's global transform. This is exact
+ * when `C` is a rotation, translation, and uniform scale, which covers the
+ * usual Y-up glTF. For a non-uniform instance scale under a rotation that
+ * does not just exchange axes, the scale is approximated by one along the
+ * node's axes.
+ */
+void transformInstances(
+    const DecodedInstances& instances,
+    const glm::dmat4& nodeToTile,
+    std::vector<float>& translations,
+    std::vector<float>& rotations,
+    std::vector<float>& scales) {
+  const glm::dvec3 nodeTranslation(nodeToTile[3]);
+  const glm::dmat3 linear(nodeToTile);
+  const double nodeScale =
+      (glm::length(linear[0]) + glm::length(linear[1]) +
+       glm::length(linear[2])) /
+      3.0;
+  const glm::dquat nodeRotation = glm::quat_cast(linear / nodeScale);
+  const glm::dquat inverseNodeRotation = glm::conjugate(nodeRotation);
+  const glm::dmat3 inverseRotationMatrix = glm::mat3_cast(inverseNodeRotation);
+
+  const bool hasRotations = !instances.rotations.empty();
+  const bool hasScales = !instances.scales.empty();
+
+  translations.resize(instances.count * 3);
+  rotations.resize(instances.count * 4);
+  scales.resize(hasScales ? instances.count * 3 : 0);
+
+  for (size_t i = 0; i < instances.count; ++i) {
+    const glm::dvec3 translation(
+        instances.translations[3 * i],
+        instances.translations[3 * i + 1],
+        instances.translations[3 * i + 2]);
+    const glm::dquat rotation =
+        hasRotations ? glm::dquat(
+                           instances.rotations[4 * i + 3],
+                           instances.rotations[4 * i],
+                           instances.rotations[4 * i + 1],
+                           instances.rotations[4 * i + 2])
+                     : glm::dquat(1.0, 0.0, 0.0, 0.0);
+    const glm::dvec3 scale =
+        hasScales ? glm::dvec3(
+                        instances.scales[3 * i],
+                        instances.scales[3 * i + 1],
+                        instances.scales[3 * i + 2])
+                  : glm::dvec3(1.0);
+
+    const glm::dvec3 nodeTranslationInstanced =
+        rotation * (scale * nodeTranslation) + translation - nodeTranslation;
+    const glm::dvec3 newTranslation =
+        inverseNodeRotation * nodeTranslationInstanced / nodeScale;
+    translations[3 * i] = static_cast<float>(newTranslation.x);
+    translations[3 * i + 1] = static_cast<float>(newTranslation.y);
+    translations[3 * i + 2] = static_cast<float>(newTranslation.z);
+
+    storeRotation(
+        inverseNodeRotation * rotation * nodeRotation,
+        &rotations[4 * i]);
+
+    if (hasScales) {
+      for (glm::length_t row = 0; row < 3; ++row) {
+        double newScale = 0.0;
+        for (glm::length_t column = 0; column < 3; ++column) {
+          const double weight = inverseRotationMatrix[column][row];
+          newScale += weight * weight * scale[column];
+        }
+        scales[3 * i + row] = static_cast<float>(newScale);
+      }
+    }
+  }
+}
+
+bool isIdentityRotation(const std::vector<float>& rotations) {
+  for (size_t i = 0; i < rotations.size(); i += 4) {
+    if (rotations[i] != 0.0f || rotations[i + 1] != 0.0f ||
+        rotations[i + 2] != 0.0f) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void addExtensionName(
+    std::vector<std::string>& names,
+    const std::string& name) {
+  if (std::find(names.begin(), names.end(), name) == names.end()) {
+    names.emplace_back(name);
+  }
+}
+
+void addInstances(CesiumGltf::Model& gltf, const DecodedInstances& instances) {
+  using namespace CesiumGltf;
+
+  if (instances.center != glm::dvec3(0.0)) {
+    gltf.extras["RTC_CENTER"] = {
+        instances.center.x,
+        instances.center.y,
+        instances.center.z};
+  }
+
+  // Find the nodes with meshes, and the transform of each to the tile.
+  const glm::dmat4 upAxisTransform =
+      GltfContent::applyGltfUpAxisTransform(gltf, glm::dmat4(1.0));
+  std::vector<std::pair<int32_t, glm::dmat4>> meshNodes;
+  gltf.forEachPrimitiveInScene(
+      -1,
+      [&meshNodes, &upAxisTransform](
+          Model& model,
+          Node& node,
+          Mesh& /*mesh*/,
+          MeshPrimitive& /*primitive*/,
+          const glm::dmat4& transform) {
+        const auto nodeIt = std::find_if(
+            model.nodes.begin(),
+            model.nodes.end(),
+            [&node](const Node& candidate) { return &candidate == &node; });
+        if (nodeIt == model.nodes.end()) {
+          return;
+        }
+        const int32_t nodeIndex = int32_t(nodeIt - model.nodes.begin());
+        if (std::any_of(
+                meshNodes.begin(),
+                meshNodes.end(),
+                [nodeIndex](const std::pair<int32_t, glm::dmat4>& meshNode) {
+                  return meshNode.first == nodeIndex;
+                })) {
+          return;
+        }
+        meshNodes.emplace_back(nodeIndex, upAxisTransform * transform);
+      });
+
+  if (meshNodes.empty()) {
+    return;
+  }
+
+  const int32_t buffer = int32_t(gltf.buffers.size());
+  std::vector<std::byte> bufferData;
+
+  const int32_t featureIdAccessor =
+      instances.featureIds.empty()
+          ? -1
+          : addInstanceAccessor(
+                gltf,
+                buffer,
+                bufferData,
+                instances.featureIds,
+                instances.count,
+                instances.featureIdComponentType,
+                Accessor::Type::SCALAR);
+
+  // Nodes with the same transform share the same instance accessors.
+  std::vector<std::pair<glm::dmat4, ExtensionExtMeshGpuInstancing>>
+      instancingByTransform;
+  std::vector<float> translations;
+  std::vector<float> rotations;
+  std::vector<float> scales;
+
+  for (const auto& [nodeIndex, nodeToTile] : meshNodes) {
+    auto instancingIt = std::find_if(
+        instancingByTransform.begin(),
+        instancingByTransform.end(),
+        [&transform = nodeToTile](
+            const std::pair<glm::dmat4, ExtensionExtMeshGpuInstancing>&
+                candidate) { return candidate.first == transform; });
+
+    if (instancingIt == instancingByTransform.end()) {
+      transformInstances(
+          instances,
+          nodeToTile,
+          translations,
+          rotations,
+          scales);
+
+      ExtensionExtMeshGpuInstancing instancing;
+      instancing.attributes["TRANSLATION"] = addInstanceAccessor(
+          gltf,
+          buffer,
+          bufferData,
+          translations,
+          instances.count,
+          Accessor::ComponentType::FLOAT,
+          Accessor::Type::VEC3);
+      if (!isIdentityRotation(rotations)) {
+        instancing.attributes["ROTATION"] = addInstanceAccessor(
+            gltf,
+            buffer,
+            bufferData,
+            rotations,
+            instances.count,
+            Accessor::ComponentType::FLOAT,
+            Accessor::Type::VEC4);
+      }
+      if (!scales.empty()) {
+        instancing.attributes["SCALE"] = addInstanceAccessor(
+            gltf,
+            buffer,
+            bufferData,
+            scales,
+            instances.count,
+            Accessor::ComponentType::FLOAT,
+            Accessor::Type::VEC3);
+      }
+      if (featureIdAccessor >= 0) {
+        instancing.attributes["_FEATURE_ID_0"] = featureIdAccessor;
+      }
+
+      instancingIt = instancingByTransform.emplace(
+          instancingByTransform.end(),
+          nodeToTile,
+          std::move(instancing));
+    }
+
+    Node& node = gltf.nodes[size_t(nodeIndex)];
+    node.addExtension<ExtensionExtMeshGpuInstancing>() = instancingIt->second;
+  }
+
+  Buffer& instanceBuffer = gltf.buffers.emplace_back();
+  instanceBuffer.byteLength = int64_t(bufferData.size());
+  instanceBuffer.cesium.data = std::move(bufferData);
+
+  addExtensionName(
+      gltf.extensionsUsed,
+      ExtensionExtMeshGpuInstancing::ExtensionName);
+  addExtensionName(
+      gltf.extensionsRequired,
+      ExtensionExtMeshGpuInstancing::ExtensionName);
+}
+
+/**
+ * @brief Gets the URL of a glTF that an I3DM refers to rather than embeds.
+ */
+std::string
+getGltfUrl(const std::string& url, const gsl::span<const std::byte>& gltfData) {
+  // The URI may be padded with spaces or zeros.
+  std::string gltfUri(
+      reinterpret_cast<const char*>(gltfData.data()),
+      gltfData.size());
+  gltfUri.erase(gltfUri.find_last_not_of(std::string(" \0", 2)) + 1);
+  return CesiumUtility::Uri::resolve(url, gltfUri);
+}
+
+Future<std::unique_ptr<TileContentLoadResult>> loadReferencedGltf(
+    const TileContentLoadInput& input,
+    Future<std::shared_ptr<IAssetRequest>>&& futureRequest) {
+  return std::move(futureRequest)
+      .thenInWorkerThread(
+          [asyncSystem = input.asyncSystem,
+           pLogger = input.pLogger,
+           pAssetAccessor = input.pAssetAccessor,
+           url = input.pRequest->url()](
+              const std::shared_ptr<IAssetRequest>& pGltfRequest) {
+            const IAssetResponse* pResponse =
+                pGltfRequest ? pGltfRequest->response() : nullptr;
+            if (!pResponse || pResponse->statusCode() < 200 ||
+                pResponse->statusCode() >= 300) {
+              SPDLOG_LOGGER_WARN(
+                  pLogger,
+                  "Failed to request the glTF of the I3DM {}.",
+                  url);
+              return asyncSystem.createResolvedFuture(
+                  std::unique_ptr<TileContentLoadResult>(nullptr));
+            }
+
+            return GltfContent::load(
+                asyncSystem,
+                pLogger,
+                pGltfRequest->url(),
+                pGltfRequest->headers(),
+                pAssetAccessor,
+                pResponse->data());
+          });
+}
+
+} // namespace
+
+Future<std::unique_ptr<TileContentLoadResult>>
+Instanced3DModelContent::load(const TileContentLoadInput& input) {
+  CESIUM_TRACE("Cesium3DTilesSelection::Instanced3DModelContent::load");
+  const AsyncSystem& asyncSystem = input.asyncSystem;
+  const std::shared_ptr<spdlog::logger>& pLogger = input.pLogger;
+  const std::shared_ptr<IAssetRequest>& pRequest = input.pRequest;
+  const std::string& url = pRequest->url();
+  const gsl::span<const std::byte> data = pRequest->response()->data();
+
+  if (data.size() < sizeof(I3dmHeader)) {
+    SPDLOG_LOGGER_WARN(
+        pLogger,
+        "The I3DM {} is invalid because it is too small to include an I3DM "
+        "header.",
+        url);
+    return asyncSystem.createResolvedFuture(
+        std::unique_ptr<TileContentLoadResult>(nullptr));
+  }
+
+  I3dmHeader header;
+  std::memcpy(&header, data.data(), sizeof(I3dmHeader));
+
+  if (header.byteLength > data.size()) {
+    SPDLOG_LOGGER_WARN(
+        pLogger,
+        "The I3DM {} is invalid because the total data available is less than "
+        "the size specified in its header.",
+        url);
+    return asyncSystem.createResolvedFuture(
+        std::unique_ptr<TileContentLoadResult>(nullptr));
+  }
+
+  const uint64_t gltfStart = uint64_t(sizeof(I3dmHeader)) +
+                             header.featureTableJsonByteLength +
+                             header.featureTableBinaryByteLength +
+                             header.batchTableJsonByteLength +
+                             header.batchTableBinaryByteLength;
+  if (gltfStart >= header.byteLength) {
+    SPDLOG_LOGGER_WARN(
+        pLogger,
+        "The I3DM {} is invalid because the start of the glTF is after the "
+        "end of the entire I3DM.",
+        url);
+    return asyncSystem.createResolvedFuture(
+        std::unique_ptr<TileContentLoadResult>(nullptr));
+  }
+
+  if (header.gltfFormat > 1) {
+    SPDLOG_LOGGER_WARN(
+        pLogger,
+        "The I3DM {} has the unknown glTF format {}.",
+        url,
+        header.gltfFormat);
+    return asyncSystem.createResolvedFuture(
+        std::unique_ptr<TileContentLoadResult>(nullptr));
+  }
+
+  std::optional<DecodedInstances> instances = decodeInstances(
+      pLogger,
+      url,
+      data.subspan(sizeof(I3dmHeader), header.featureTableJsonByteLength),
+      data.subspan(
+          sizeof(I3dmHeader) + header.featureTableJsonByteLength,
+          header.featureTableBinaryByteLength));
+  if (!instances) {
+    return asyncSystem.createResolvedFuture(
+        std::unique_ptr<TileContentLoadResult>(nullptr));
+  }
+
+  const gsl::span<const std::byte> gltfData = data.subspan(
+      static_cast<size_t>(gltfStart),
+      static_cast<size_t>(header.byteLength - gltfStart));
+
+  Future<std::unique_ptr<TileContentLoadResult>> futureGltf =
+      header.gltfFormat == 1
+          ? GltfContent::load(
+                asyncSystem,
+                pLogger,
+                url,
+                pRequest->headers(),
+                input.pAssetAccessor,
+                gltfData)
+          : loadReferencedGltf(
+                input,
+                this->requestGltf(input, getGltfUrl(url, gltfData)));
+
+  return std::move(futureGltf)
+      .thenInWorkerThread(
+          [instances = std::move(*instances)](
+              std::unique_ptr<TileContentLoadResult>&& pResult) {
+            if (pResult && pResult->model) {
+              addInstances(*pResult->model, instances);
+            }
+            return std::move(pResult);
+          });
+}
+
+size_t Instanced3DModelContent::CacheKeyHash::operator()(
+    const CacheKey& key) const noexcept {
+  // The tiles of a tileset usually have the same headers, so the headers are
+  // only compared, not hashed.
+  return std::hash<std::string>()(key.url) ^
+         (std::hash<const IAssetAccessor*>()(key.pAssetAccessor) << 1);
+}
+
+CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+Instanced3DModelContent::requestGltf(
+    const TileContentLoadInput& input,
+    const std::string& url) {
+  const HttpHeaders& headers = input.pRequest->headers();
+  CacheKey key{
+      input.pAssetAccessor.get(),
+      url,
+      std::vector<IAssetAccessor::THeader>(headers.begin(), headers.end())};
+
+  SharedFuture<std::shared_ptr<IAssetRequest>> future = [&]() {
+    std::lock_guard<std::mutex> lock(this->_pGltfRequests->mutex);
+    auto it = this->_pGltfRequests->entries.find(key);
+    if (it == this->_pGltfRequests->entries.end()) {
+      SharedFuture<std::shared_ptr<IAssetRequest>> request =
+          input.pAssetAccessor
+              ->requestAsset(input.asyncSystem, url, key.headers)
+              .share();
+      it = this->_pGltfRequests->entries
+               .emplace(key, CacheEntry{std::move(request), 0})
+               .first;
+    }
+
+    ++it->second.waiters;
+    return it->second.future;
+  }();
+
+  // The lock is released before continuing, because the continuation runs
+  // right away if the request has already completed. The entry is removed
+  // once every waiting tile has the response, and a failed request is
+  // removed the same way, so the next tile that needs it requests it again.
+  return future
+      .catchImmediately([](std::exception&&) {
+        return std::shared_ptr<IAssetRequest>();
+      })
+      .thenImmediately(
+          [pGltfRequests = this->_pGltfRequests,
+           // Keeps the address in the key from being reused until the entry
+           // is removed.
+           pAssetAccessor = input.pAssetAccessor,
+           key = std::move(key)](std::shared_ptr<IAssetRequest>&& pRequest) {
+            std::lock_guard<std::mutex> lock(pGltfRequests->mutex);
+            auto it = pGltfRequests->entries.find(key);
+            if (it != pGltfRequests->entries.end() &&
+                --it->second.waiters == 0) {
+              pGltfRequests->entries.erase(it);
+            }
+            return std::move(pRequest);
+          });
+}
+
+} // namespace Cesium3DTilesSelection
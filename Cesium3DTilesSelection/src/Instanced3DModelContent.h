@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Cesium3DTilesSelection/Library.h"
+#include "Cesium3DTilesSelection/TileContentLoadResult.h"
+#include "Cesium3DTilesSelection/TileContentLoader.h"
+
+#include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumAsync/IAssetRequest.h>
+#include <CesiumAsync/Future.h>
+#include <CesiumAsync/SharedFuture.h>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief Creates a {@link TileContentLoadResult} from I3DM data.
+ *
+ * The instances are decoded from the feature table into one tightly-packed
+ * array per attribute and added to the glTF with the `EXT_mesh_gpu_instancing`
+ * extension, on every node that has a mesh. The instance translations are
+ * relative to the `RTC_CENTER` of the feature table, or to the center of the
+ * instances if there is none, and that center is stored in the `RTC_CENTER`
+ * of the glTF's `extras`, as for B3DM.
+ *
+ * When the glTF is referenced by URL rather than embedded, tiles that are
+ * loading at the same time share one request for each distinct URL. A request
+ * is only shared by tiles that are loaded with the same asset accessor and
+ * request headers, and it is forgotten as soon as every tile waiting for it
+ * has received the response, so nothing is kept once the tiles are loaded.
+ */
+class CESIUM3DTILESSELECTION_API Instanced3DModelContent final
+    : public TileContentLoader {
+public:
+  /**
+   * @copydoc TileContentLoader::load
+   *
+   * The result will only contain the `model`. Other fields will be
+   * empty or have default values.
+   */
+  CesiumAsync::Future<std::unique_ptr<TileContentLoadResult>>
+  load(const TileContentLoadInput& input) override;
+
+private:
+  CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  requestGltf(const TileContentLoadInput& input, const std::string& url);
+
+  // A request can only be shared by tiles that would make the same request,
+  // so it is identified by the accessor and headers as well as the URL. Every
+  // tile waiting for a request holds its accessor, so the address of the
+  // accessor is not reused by another one while the request is pending.
+  struct CacheKey {
+    const CesiumAsync::IAssetAccessor* pAssetAccessor;
+    std::string url;
+    std::vector<CesiumAsync::IAssetAccessor::THeader> headers;
+
+    bool operator==(const CacheKey& rhs) const noexcept {
+      return this->pAssetAccessor == rhs.pAssetAccessor &&
+             this->url == rhs.url && this->headers == rhs.headers;
+    }
+  };
+
+  struct CacheKeyHash {
+    size_t operator()(const CacheKey& key) const noexcept;
+  };
+
+  struct CacheEntry {
+    CesiumAsync::SharedFuture<std::shared_ptr<CesiumAsync::IAssetRequest>>
+        future;
+
+    // The number of tiles that have not yet received the response.
+    size_t waiters;
+  };
+
+  // The pending requests. The continuations of the requests hold this, so
+  // that a request that completes after the loader is destroyed can still
+  // remove itself.
+  struct GltfRequests {
+    std::mutex mutex;
+    std::unordered_map<CacheKey, CacheEntry, CacheKeyHash> entries;
+  };
+
+  std::shared_ptr<GltfRequests> _pGltfRequests =
+      std::make_shared<GltfRequests>();
+};
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,892 @@
+#include "PointCloudContent.h"
+
+#include "Cesium3DTilesSelection/spdlog-cesium.h"
+#include "FeatureTableUtilities.h"
+#include "upgradeBatchTableToFeatureMetadata.h"
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/IAssetResponse.h>
+#include <CesiumGltf/ExtensionMeshPrimitiveExtFeatureMetadata.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumUtility/Tracing.h>
+
+#include <glm/vec4.hpp>
+#include <rapidjson/document.h>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable : 4127 4018 4804)
+#endif
+
+#include <draco/compression/decode.h>
+#include <draco/core/decoder_buffer.h>
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <optional>
+
+namespace Cesium3DTilesSelection {
+
+using namespace CesiumAsync;
+using namespace CesiumGltf;
+using namespace Cesium3DTilesSelection::Impl;
+
+namespace {
+
+struct PntsHeader {
+  unsigned char magic[4];
+  uint32_t version;
+  uint32_t byteLength;
+  uint32_t featureTableJsonByteLength;
+  uint32_t featureTableBinaryByteLength;
+  uint32_t batchTableJsonByteLength;
+  uint32_t batchTableBinaryByteLength;
+};
+
+static_assert(sizeof(PntsHeader) == 28);
+
+/**
+ * @brief The points of a PNTS, with each attribute tightly packed in an array
+ * of its own.
+ */
+struct DecodedPoints {
+  size_t count = 0;
+
+  /**
+   * @brief The center that the positions are relative to.
+   */
+  glm::dvec3 center = glm::dvec3(0.0);
+
+  /**
+   * @brief The x, y, and z of each position.
+   */
+  std::vector<float> positions;
+
+  /**
+   * @brief The normalized color of each point, with `colorComponents`
+   * components, or empty if the points have no color of their own.
+   */
+  std::vector<uint8_t> colors;
+  size_t colorComponents = 0;
+
+  /**
+   * @brief The color of all points, from `CONSTANT_RGBA`.
+   */
+  std::optional<glm::dvec4> constantColor;
+
+  /**
+   * @brief The x, y, and z of each normal, or empty if there are none.
+   */
+  std::vector<float> normals;
+
+  /**
+   * @brief The batch ID of each point, or empty if there are none.
+   */
+  std::vector<std::byte> batchIds;
+  int32_t batchIdComponentType = Accessor::ComponentType::UNSIGNED_SHORT;
+};
+
+template <typename T>
+std::vector<std::byte> toBytes(const std::vector<T>& values) {
+  std::vector<std::byte> result(values.size() * sizeof(T));
+  std::memcpy(result.data(), values.data(), result.size());
+  return result;
+}
+
+/**
+ * @brief Dequantizes positions relative to the center of the quantized volume.
+ *
+ * This is a plain loop over contiguous arrays so that the compiler can
+ * vectorize it, since point clouds often have millions of points.
+ */
+void dequantizePositions(
+    const std::vector<uint16_t>& quantized,
+    const glm::dvec3& scale,
+    std::vector<float>& positions) {
+  const float scaleX = static_cast<float>(scale.x / 65535.0);
+  const float scaleY = static_cast<float>(scale.y / 65535.0);
+  const float scaleZ = static_cast<float>(scale.z / 65535.0);
+  const float halfX = static_cast<float>(scale.x * 0.5);
+  const float halfY = static_cast<float>(scale.y * 0.5);
+  const float halfZ = static_cast<float>(scale.z * 0.5);
+  for (size_t i = 0; i + 2 < quantized.size(); i += 3) {
+    positions[i] = float(quantized[i]) * scaleX - halfX;
+    positions[i + 1] = float(quantized[i + 1]) * scaleY - halfY;
+    positions[i + 2] = float(quantized[i + 2]) * scaleZ - halfZ;
+  }
+}
+
+/**
+ * @brief Expands `RGB565` colors to three normalized bytes each.
+ *
+ * The 5- and 6-bit components are scaled to 8 bits with integer arithmetic
+ * that rounds to nearest, so the loop vectorizes.
+ */
+void decodeRgb565(
+    const std::vector<uint16_t>& rgb565,
+    std::vector<uint8_t>& colors) {
+  for (size_t i = 0, j = 0; i < rgb565.size(); ++i, j += 3) {
+    const uint32_t color = rgb565[i];
+    const uint32_t red = (color >> 11) & 0x1f;
+    const uint32_t green = (color >> 5) & 0x3f;
+    const uint32_t blue = color & 0x1f;
+    colors[j] = static_cast<uint8_t>((red * 527 + 23) >> 6);
+    colors[j + 1] = static_cast<uint8_t>((green * 259 + 33) >> 6);
+    colors[j + 2] = static_cast<uint8_t>((blue * 527 + 23) >> 6);
+  }
+}
+
+template <typename T>
+std::vector<T> readDracoAttribute(
+    const draco::PointCloud& pointCloud,
+    const draco::PointAttribute& attribute,
+    int8_t numberOfComponents) {
+  std::vector<T> result(
+      size_t(pointCloud.num_points()) * size_t(numberOfComponents));
+  T* pOut = result.data();
+  for (draco::PointIndex i(0); i < pointCloud.num_points(); ++i) {
+    attribute.ConvertValue(attribute.mapped_index(i), numberOfComponents, pOut);
+    pOut += numberOfComponents;
+  }
+  return result;
+}
+
+/**
+ * @brief Decodes the attributes that are compressed with
+ * `3DTILES_draco_point_compression`, if any.
+ *
+ * @return `false` if the points are compressed but cannot be decoded.
+ */
+bool decodeDracoPoints(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& url,
+    const rapidjson::Value& featureTable,
+    const gsl::span<const std::byte>& featureTableBinary,
+    DecodedPoints& points) {
+  const auto extensionsIt = featureTable.FindMember("extensions");
+  if (extensionsIt == featureTable.MemberEnd() ||
+      !extensionsIt->value.IsObject()) {
+    return true;
+  }
+
+  const auto dracoIt =
+      extensionsIt->value.FindMember("3DTILES_draco_point_compression");
+  if (dracoIt == extensionsIt->value.MemberEnd()) {
+    return true;
+  }
+
+  CESIUM_TRACE("Cesium3DTilesSelection::PointCloudContent::decodeDraco");
+
+  const rapidjson::Value& draco = dracoIt->value;
+  const auto propertiesIt = draco.IsObject() ? draco.FindMember("properties")
+                                             : draco.MemberEnd();
+  const auto byteOffsetIt = draco.IsObject() ? draco.FindMember("byteOffset")
+                                             : draco.MemberEnd();
+  const auto byteLengthIt = draco.IsObject() ? draco.FindMember("byteLength")
+                                             : draco.MemberEnd();
+  if (!draco.IsObject() || propertiesIt == draco.MemberEnd() ||
+      !propertiesIt->value.IsObject() || byteOffsetIt == draco.MemberEnd() ||
+      !byteOffsetIt->value.IsUint64() || byteLengthIt == draco.MemberEnd() ||
+      !byteLengthIt->value.IsUint64()) {
+    SPDLOG_LOGGER_WARN(
+        pLogger,
+        "The 3DTILES_draco_point_compression extension of the PNTS {} is "
+        "invalid.",
+        url);
+    return false;
+  }
+
+  const uint64_t byteOffset = byteOffsetIt->value.GetUint64();
+  const uint64_t byteLength = byteLengthIt->value.GetUint64();
+  if (byteOffset > featureTableBinary.size() ||
+      byteLength > featureTableBinary.size() - byteOffset) {
+    SPDLOG_LOGGER_WARN(
+        pLogger,
+        "The Draco data of the PNTS {} extends past the end of the feature "
+        "table.",
+        url);
+    return false;
+  }
+
+  draco::DecoderBuffer decodeBuffer;
+  decodeBuffer.Init(
+      reinterpret_cast<const char*>(featureTableBinary.data() + byteOffset),
+      static_cast<size_t>(byteLength));
+
+  draco::Decoder decoder;
+  draco::StatusOr<std::unique_ptr<draco::PointCloud>> result =
+      decoder.DecodePointCloudFromBuffer(&decodeBuffer);
+  if (!result.ok()) {
+    SPDLOG_LOGGER_WARN(
+        pLogger,
+        "Draco decoding of the PNTS {} failed: {}",
+        url,
+        result.status().error_msg_string());
+    return false;
+  }
+
+  const std::unique_ptr<draco::PointCloud> pPointCloud =
+      std::move(result).value();
+  if (size_t(pPointCloud->num_points()) != points.count) {
+    SPDLOG_LOGGER_WARN(
+        pLogger,
+        "The Draco data of the PNTS {} has {} points, but POINTS_LENGTH is {}.",
+        url,
+        pPointCloud->num_points(),
+        points.count);
+    return false;
+  }
+
+  const rapidjson::Value& properties = propertiesIt->value;
+  for (auto it = properties.MemberBegin(); it != properties.MemberEnd(); ++it) {
+    const std::string name = it->name.GetString();
+    const draco::PointAttribute* pAttribute =
+        it->value.IsUint()
+            ? pPointCloud->GetAttributeByUniqueId(it->value.GetUint())
+            : nullptr;
+    if (!pAttribute) {
+      SPDLOG_LOGGER_WARN(
+          pLogger,
+          "Ignoring the Draco-compressed {} property of the PNTS {} because "
+          "its attribute does not exist.",
+          name,
+          url);
+      continue;
+    }
+
+    if (name == "POSITION") {
+      points.positions =
+          readDracoAttribute<float>(*pPointCloud, *pAttribute, 3);
+    } else if (name == "RGBA" || name == "RGB") {
+      points.colorComponents = name == "RGBA" ? 4 : 3;
+      points.colors = readDracoAttribute<uint8_t>(
+          *pPointCloud,
+          *pAttribute,
+          static_cast<int8_t>(points.colorComponents));
+    } else if (name == "NORMAL") {
+      points.normals = readDracoAttribute<float>(*pPointCloud, *pAttribute, 3);
+    } else if (name == "BATCH_ID") {
+      if (pAttribute->data_type() == draco::DT_UINT8) {
+        points.batchIdComponentType = Accessor::ComponentType::UNSIGNED_BYTE;
+        points.batchIds = toBytes(
+            readDracoAttribute<uint8_t>(*pPointCloud, *pAttribute, 1));
+      } else if (pAttribute->data_type() == draco::DT_UINT16) {
+        points.batchIdComponentType = Accessor::ComponentType::UNSIGNED_SHORT;
+        points.batchIds = toBytes(
+            readDracoAttribute<uint16_t>(*pPointCloud, *pAttribute, 1));
+      } else {
+        points.batchIdComponentType = Accessor::ComponentType::FLOAT;
+        points.batchIds =
+            toBytes(readDracoAttribute<float>(*pPointCloud, *pAttribute, 1));
+      }
+    } else {
+      SPDLOG_LOGGER_WARN(
+          pLogger,
+          "Ignoring the Draco-compressed {} property of the PNTS {} because it "
+          "is not supported.",
+          name,
+          url);
+    }
+  }
+
+  return true;
+}
+
+/**
+ * @brief Decodes the positions from the feature table, unless they were
+ * compressed with Draco.
+ *
+ * @return `false` if there are no valid positions.
+ */
+bool decodePositions(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& url,
+    const rapidjson::Value& featureTable,
+    const gsl::span<const std::byte>& featureTableBinary,
+    DecodedPoints& points) {
+  const std::optional<glm::dvec3> rtcCenter = getFeatureTableVec3(
+      pLogger,
+      url,
+      featureTable,
+      featureTableBinary,
+      "RTC_CENTER");
+  if (rtcCenter) {
+    points.center = *rtcCenter;
+  }
+
+  if (!points.positions.empty()) {
+    return true;
+  }
+
+  const size_t count = points.count;
+  const std::optional<gsl::span<const std::byte>> positionData =
+      getFeatureTableBinaryProperty(
+          pLogger,
+          url,
+          featureTable,
+          featureTableBinary,
+          "POSITION",
+          count * 3 * sizeof(float));
+  if (positionData) {
+    points.positions = readFeatureTableArray<float>(*positionData);
+    return true;
+  }
+
+  const std::optional<gsl::span<const std::byte>> quantizedData =
+      getFeatureTableBinaryProperty(
+          pLogger,
+          url,
+          featureTable,
+          featureTableBinary,
+          "POSITION_QUANTIZED",
+          count * 3 * sizeof(uint16_t));
+  const std::optional<glm::dvec3> offset = getFeatureTableVec3(
+      pLogger,
+      url,
+      featureTable,
+      featureTableBinary,
+      "QUANTIZED_VOLUME_OFFSET");
+  const std::optional<glm::dvec3> scale = getFeatureTableVec3(
+      pLogger,
+      url,
+      featureTable,
+      featureTableBinary,
+      "QUANTIZED_VOLUME_SCALE");
+  if (!quantizedData || !offset || !scale) {
+    SPDLOG_LOGGER_WARN(
+        pLogger,
+        "The PNTS {} does not have valid point positions.",
+        url);
+    return false;
+  }
+
+  // The quantized volume is often far from the RTC_CENTER, if there is one,
+  // so keep single-precision positions relative to the middle of the volume.
+  points.center += *offset + *scale * 0.5;
+  points.positions.resize(count * 3);
+  dequantizePositions(
+      readFeatureTableArray<uint16_t>(*quantizedData),
+      *scale,
+      points.positions);
+  return true;
+}
+
+void decodeColors(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& url,
+    const rapidjson::Value& featureTable,
+    const gsl::span<const std::byte>& featureTableBinary,
+    DecodedPoints& points) {
+  const auto constantIt = featureTable.FindMember("CONSTANT_RGBA");
+  if (constantIt != featureTable.MemberEnd()) {
+    const rapidjson::Value& value = constantIt->value;
+    if (value.IsArray() && value.Size() == 4 && value[0].IsNumber() &&
+        value[1].IsNumber() && value[2].IsNumber() && value[3].IsNumber()) {
+      points.constantColor = glm::dvec4(
+          value[0].GetDouble() / 255.0,
+          value[1].GetDouble() / 255.0,
+          value[2].GetDouble() / 255.0,
+          value[3].GetDouble() / 255.0);
+    } else {
+      SPDLOG_LOGGER_WARN(
+          pLogger,
+          "The PNTS {} has a CONSTANT_RGBA that is not an array of four "
+          "numbers, so it is ignored.",
+          url);
+    }
+  }
+
+  if (!points.colors.empty()) {
+    return;
+  }
+
+  const size_t count = points.count;
+  const std::optional<gsl::span<const std::byte>> rgbaData =
+      getFeatureTableBinaryProperty(
+          pLogger,
+          url,
+          featureTable,
+          featureTableBinary,
+          "RGBA",
+          count * 4);
+  if (rgbaData) {
+    points.colorComponents = 4;
+    points.colors = readFeatureTableArray<uint8_t>(*rgbaData);
+    return;
+  }
+
+  const std::optional<gsl::span<const std::byte>> rgbData =
+      getFeatureTableBinaryProperty(
+          pLogger,
+          url,
+          featureTable,
+          featureTableBinary,
+          "RGB",
+          count * 3);
+  if (rgbData) {
+    points.colorComponents = 3;
+    points.colors = readFeatureTableArray<uint8_t>(*rgbData);
+    return;
+  }
+
+  const std::optional<gsl::span<const std::byte>> rgb565Data =
+      getFeatureTableBinaryProperty(
+          pLogger,
+          url,
+          featureTable,
+          featureTableBinary,
+          "RGB565",
+          count * sizeof(uint16_t));
+  if (rgb565Data) {
+    points.colorComponents = 3;
+    points.colors.resize(count * 3);
+    decodeRgb565(readFeatureTableArray<uint16_t>(*rgb565Data), points.colors);
+  }
+}
+
+void decodeNormals(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& url,
+    const rapidjson::Value& featureTable,
+    const gsl::span<const std::byte>& featureTableBinary,
+    DecodedPoints& points) {
+  if (!points.normals.empty()) {
+    return;
+  }
+
+  const size_t count = points.count;
+  const std::optional<gsl::span<const std::byte>> normalData =
+      getFeatureTableBinaryProperty(
+          pLogger,
+          url,
+          featureTable,
+          featureTableBinary,
+          "NORMAL",
+          count * 3 * sizeof(float));
+  if (normalData) {
+    points.normals = readFeatureTableArray<float>(*normalData);
+    return;
+  }
+
+  const std::optional<gsl::span<const std::byte>> octData =
+      getFeatureTableBinaryProperty(
+          pLogger,
+          url,
+          featureTable,
+          featureTableBinary,
+          "NORMAL_OCT16P",
+          count * 2);
+  if (octData) {
+    points.normals.resize(count * 3);
+    octDecode(readFeatureTableArray<uint8_t>(*octData), points.normals);
+  }
+}
+
+void decodeBatchIds(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& url,
+    const rapidjson::Value& featureTable,
+    const gsl::span<const std::byte>& featureTableBinary,
+    DecodedPoints& points) {
+  const auto batchIdIt = featureTable.FindMember("BATCH_ID");
+  if (!points.batchIds.empty() || batchIdIt == featureTable.MemberEnd()) {
+    return;
+  }
+
+  std::string componentType = "UNSIGNED_SHORT";
+  if (batchIdIt->value.IsObject()) {
+    const auto componentTypeIt = batchIdIt->value.FindMember("componentType");
+    if (componentTypeIt != batchIdIt->value.MemberEnd() &&
+        componentTypeIt->value.IsString()) {
+      componentType = componentTypeIt->value.GetString();
+    }
+  }
+
+  size_t componentSize = 0;
+  if (componentType == "UNSIGNED_BYTE") {
+    componentSize = sizeof(uint8_t);
+    points.batchIdComponentType = Accessor::ComponentType::UNSIGNED_BYTE;
+  } else if (componentType == "UNSIGNED_SHORT") {
+    componentSize = sizeof(uint16_t);
+    points.batchIdComponentType = Accessor::ComponentType::UNSIGNED_SHORT;
+  } else if (componentType == "UNSIGNED_INT") {
+    componentSize = sizeof(uint32_t);
+    points.batchIdComponentType = Accessor::ComponentType::FLOAT;
+  } else {
+    SPDLOG_LOGGER_WARN(
+        pLogger,
+        "Ignoring the BATCH_ID of the PNTS {} because it has the unknown "
+        "componentType {}.",
+        url,
+        componentType);
+    return;
+  }
+
+  const std::optional<gsl::span<const std::byte>> batchIdData =
+      getFeatureTableBinaryProperty(
+          pLogger,
+          url,
+          featureTable,
+          featureTableBinary,
+          "BATCH_ID",
+          points.count * componentSize);
+  if (!batchIdData) {
+    return;
+  }
+
+  if (componentSize == sizeof(uint32_t)) {
+    // Vertex attributes cannot be 32-bit integers, but floats represent
+    // every batch ID below 2^24 exactly.
+    const std::vector<uint32_t> batchIds =
+        readFeatureTableArray<uint32_t>(*batchIdData);
+    points.batchIds =
+        toBytes(std::vector<float>(batchIds.begin(), batchIds.end()));
+  } else {
+    points.batchIds.assign(batchIdData->begin(), batchIdData->end());
+  }
+}
+
+/**
+ * @brief Adds an accessor to the model for a tightly-packed vertex attribute
+ * in a buffer view of its own.
+ */
+int32_t addVertexAttribute(
+    Model& gltf,
+    std::vector<std::byte>& bufferData,
+    const gsl::span<const std::byte>& values,
+    size_t count,
+    int32_t componentType,
+    const std::string& type,
+    bool normalized) {
+  // Keep every buffer view aligned for its components.
+  const size_t byteOffset = (bufferData.size() + 3) & ~size_t(3);
+  bufferData.resize(byteOffset + values.size());
+  std::memcpy(bufferData.data() + byteOffset, values.data(), values.size());
+
+  BufferView& bufferView = gltf.bufferViews.emplace_back();
+  bufferView.buffer = 0;
+  bufferView.byteOffset = int64_t(byteOffset);
+  bufferView.byteLength = int64_t(values.size());
+  bufferView.target = BufferView::Target::ARRAY_BUFFER;
+
+  Accessor& accessor = gltf.accessors.emplace_back();
+  accessor.bufferView = int32_t(gltf.bufferViews.size() - 1);
+  accessor.componentType = componentType;
+  accessor.normalized = normalized;
+  accessor.count = int64_t(count);
+  accessor.type = type;
+
+  return int32_t(gltf.accessors.size() - 1);
+}
+
+template <typename T>
+gsl::span<const std::byte> asBytes(const std::vector<T>& values) {
+  return gsl::span<const std::byte>(
+      reinterpret_cast<const std::byte*>(values.data()),
+      values.size() * sizeof(T));
+}
+
+Model createGltf(const DecodedPoints& points) {
+  Model gltf;
+  std::vector<std::byte> bufferData;
+
+  Material& material = gltf.materials.emplace_back();
+  MaterialPBRMetallicRoughness& pbr = material.pbrMetallicRoughness.emplace();
+  pbr.metallicFactor = 0.0;
+  pbr.roughnessFactor = 1.0;
+  if (points.constantColor) {
+    const glm::dvec4& color = *points.constantColor;
+    pbr.baseColorFactor = {color.x, color.y, color.z, color.w};
+  }
+  if (points.colorComponents == 4 ||
+      (points.constantColor && points.constantColor->w < 1.0)) {
+    material.alphaMode = Material::AlphaMode::BLEND;
+  }
+
+  MeshPrimitive& primitive =
+      gltf.meshes.emplace_back().primitives.emplace_back();
+  primitive.mode = MeshPrimitive::Mode::POINTS;
+  primitive.material = 0;
+
+  const int32_t positionAccessorId = addVertexAttribute(
+      gltf,
+      bufferData,
+      asBytes(points.positions),
+      points.count,
+      Accessor::ComponentType::FLOAT,
+      Accessor::Type::VEC3,
+      false);
+  primitive.attributes.emplace("POSITION", positionAccessorId);
+
+  glm::vec3 minimum(std::numeric_limits<float>::max());
+  glm::vec3 maximum(std::numeric_limits<float>::lowest());
+  for (size_t i = 0; i < points.positions.size(); i += 3) {
+    const glm::vec3 position(
+        points.positions[i],
+        points.positions[i + 1],
+        points.positions[i + 2]);
+    minimum = glm::min(minimum, position);
+    maximum = glm::max(maximum, position);
+  }
+  Accessor& positionAccessor = gltf.accessors[size_t(positionAccessorId)];
+  positionAccessor.min = {minimum.x, minimum.y, minimum.z};
+  positionAccessor.max = {maximum.x, maximum.y, maximum.z};
+
+  if (!points.colors.empty()) {
+    primitive.attributes.emplace(
+        "COLOR_0",
+        addVertexAttribute(
+            gltf,
+            bufferData,
+            asBytes(points.colors),
+            points.count,
+            Accessor::ComponentType::UNSIGNED_BYTE,
+            points.colorComponents == 4 ? Accessor::Type::VEC4
+                                        : Accessor::Type::VEC3,
+            true));
+  }
+
+  if (!points.normals.empty()) {
+    primitive.attributes.emplace(
+        "NORMAL",
+        addVertexAttribute(
+            gltf,
+            bufferData,
+            asBytes(points.normals),
+            points.count,
+            Accessor::ComponentType::FLOAT,
+            Accessor::Type::VEC3,
+            false));
+  }
+
+  if (!points.batchIds.empty()) {
+    primitive.attributes.emplace(
+        "_BATCHID",
+        addVertexAttribute(
+            gltf,
+            bufferData,
+            points.batchIds,
+            points.count,
+            points.batchIdComponentType,
+            Accessor::Type::SCALAR,
+            false));
+  }
+
+  Buffer& buffer = gltf.buffers.emplace_back();
+  buffer.byteLength = int64_t(bufferData.size());
+  buffer.cesium.data = std::move(bufferData);
+
+  // The points are Z-up, relative to the center, so transform them to the
+  // Y-up frame of glTF.
+  Node& node = gltf.nodes.emplace_back();
+  node.mesh = 0;
+  node.matrix = {
+      1.0,
+      0.0,
+      0.0,
+      0.0,
+      0.0,
+      0.0,
+      -1.0,
+      0.0,
+      0.0,
+      1.0,
+      0.0,
+      0.0,
+      points.center.x,
+      points.center.z,
+      -points.center.y,
+      1.0};
+
+  return gltf;
+}
+
+void upgradeBatchTable(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& url,
+    Model& gltf,
+    const rapidjson::Document& featureTable,
+    size_t pointsLength,
+    const gsl::span<const std::byte>& batchTableJsonData,
+    const gsl::span<const std::byte>& batchTableBinaryData) {
+  rapidjson::Document batchTableJson;
+  batchTableJson.Parse(
+      reinterpret_cast<const char*>(batchTableJsonData.data()),
+      batchTableJsonData.size());
+  if (batchTableJson.HasParseError()) {
+    SPDLOG_LOGGER_WARN(
+        pLogger,
+        "Error when parsing the batch table JSON of the PNTS {}, error code {} "
+        "at byte offset {}. Skip parsing metadata",
+        url,
+        batchTableJson.GetParseError(),
+        batchTableJson.GetErrorOffset());
+    return;
+  }
+
+  MeshPrimitive& primitive = gltf.meshes[0].primitives[0];
+  if (primitive.attributes.find("_BATCHID") != primitive.attributes.end()) {
+    upgradeBatchTableToFeatureMetadata(
+        pLogger,
+        gltf,
+        featureTable,
+        batchTableJson,
+        batchTableBinaryData);
+    return;
+  }
+
+  // Without batch IDs, the batch table has a feature for each point, which
+  // is the point's index.
+  rapidjson::Document perPointFeatureTable;
+  perPointFeatureTable.SetObject();
+  perPointFeatureTable.AddMember(
+      "BATCH_LENGTH",
+      rapidjson::Value(uint64_t(pointsLength)),
+      perPointFeatureTable.GetAllocator());
+  upgradeBatchTableToFeatureMetadata(
+      pLogger,
+      gltf,
+      perPointFeatureTable,
+      batchTableJson,
+      batchTableBinaryData);
+
+  FeatureIDAttribute& attribute =
+      primitive.addExtension<ExtensionMeshPrimitiveExtFeatureMetadata>()
+          .featureIdAttributes.emplace_back();
+  attribute.featureTable = "default";
+  attribute.featureIds.constant = 0;
+  attribute.featureIds.divisor = 1;
+}
+
+} // namespace
+
+Future<std::unique_ptr<TileContentLoadResult>>
+PointCloudContent::load(const TileContentLoadInput& input) {
+  return input.asyncSystem.createResolvedFuture(load(
+      input.pLogger,
+      input.pRequest->url(),
+      input.pRequest->response()->data()));
+}
+
+/*static*/ std::unique_ptr<TileContentLoadResult> PointCloudContent::load(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const std::string& url,
+    const gsl::span<const std::byte>& data) {
+  CESIUM_TRACE("Cesium3DTilesSelection::PointCloudContent::load");
+
+  if (data.size() < sizeof(PntsHeader)) {
+    SPDLOG_LOGGER_WARN(
+        pLogger,
+        "The PNTS {} is invalid because it is too small to include a PNTS "
+        "header.",
+        url);
+    return nullptr;
+  }
+
+  PntsHeader header;
+  std::memcpy(&header, data.data(), sizeof(PntsHeader));
+
+  const uint64_t batchTableEnd = uint64_t(sizeof(PntsHeader)) +
+                                 header.featureTableJsonByteLength +
+                                 header.featureTableBinaryByteLength +
+                                 header.batchTableJsonByteLength +
+                                 header.batchTableBinaryByteLength;
+  if (header.byteLength > data.size() || batchTableEnd > header.byteLength) {
+    SPDLOG_LOGGER_WARN(
+        pLogger,
+        "The PNTS {} is invalid because the total data available is less than "
+        "the size specified in its header.",
+        url);
+    return nullptr;
+  }
+
+  const gsl::span<const std::byte> featureTableJsonData =
+      data.subspan(sizeof(PntsHeader), header.featureTableJsonByteLength);
+  const gsl::span<const std::byte> featureTableBinaryData = data.subspan(
+      sizeof(PntsHeader) + header.featureTableJsonByteLength,
+      header.featureTableBinaryByteLength);
+
+  rapidjson::Document featureTable;
+  featureTable.Parse(
+      reinterpret_cast<const char*>(featureTableJsonData.data()),
+      featureTableJsonData.size());
+  if (featureTable.HasParseError()) {
+    SPDLOG_LOGGER_WARN(
+        pLogger,
+        "Error when parsing the feature table JSON of the PNTS {}, error code "
+        "{} at byte offset {}.",
+        url,
+        featureTable.GetParseError(),
+        featureTable.GetErrorOffset());
+    return nullptr;
+  }
+
+  if (!featureTable.IsObject()) {
+    SPDLOG_LOGGER_WARN(
+        pLogger,
+        "The feature table of the PNTS {} is not a JSON object.",
+        url);
+    return nullptr;
+  }
+
+  const auto pointsLengthIt = featureTable.FindMember("POINTS_LENGTH");
+  if (pointsLengthIt == featureTable.MemberEnd() ||
+      !pointsLengthIt->value.IsUint() || pointsLengthIt->value.GetUint() == 0) {
+    SPDLOG_LOGGER_WARN(
+        pLogger,
+        "The PNTS {} does not have a valid POINTS_LENGTH.",
+        url);
+    return nullptr;
+  }
+
+  DecodedPoints points;
+  points.count = pointsLengthIt->value.GetUint();
+
+  if (!decodeDracoPoints(
+          pLogger,
+          url,
+          featureTable,
+          featureTableBinaryData,
+          points) ||
+      !decodePositions(
+          pLogger,
+          url,
+          featureTable,
+          featureTableBinaryData,
+          points)) {
+    return nullptr;
+  }
+
+  decodeColors(pLogger, url, featureTable, featureTableBinaryData, points);
+  decodeNormals(pLogger, url, featureTable, featureTableBinaryData, points);
+  decodeBatchIds(pLogger, url, featureTable, featureTableBinaryData, points);
+
+  std::unique_ptr<TileContentLoadResult> pResult =
+      std::make_unique<TileContentLoadResult>();
+  pResult->model = createGltf(points);
+
+  if (header.batchTableJsonByteLength > 0) {
+    const size_t batchTableStart = sizeof(PntsHeader) +
+                                   header.featureTableJsonByteLength +
+                                   header.featureTableBinaryByteLength;
+    upgradeBatchTable(
+        pLogger,
+        url,
+        *pResult->model,
+        featureTable,
+        points.count,
+        data.subspan(batchTableStart, header.batchTableJsonByteLength),
+        data.subspan(
+            batchTableStart + header.batchTableJsonByteLength,
+            header.batchTableBinaryByteLength));
+  }
+
+  return pResult;
+}
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Cesium3DTilesSelection/Library.h"
+#include "Cesium3DTilesSelection/TileContentLoadResult.h"
+#include "Cesium3DTilesSelection/TileContentLoader.h"
+
+#include <gsl/span>
+#include <spdlog/fwd.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief Creates a {@link TileContentLoadResult} from PNTS data.
+ *
+ * The points become a single glTF primitive with the `POINTS` mode. Quantized
+ * positions and oct-encoded normals are decoded to floats, while colors stay
+ * normalized unsigned bytes, with `RGB565` colors expanded only to three
+ * bytes. Points compressed with `3DTILES_draco_point_compression` are decoded
+ * with Draco.
+ */
+class CESIUM3DTILESSELECTION_API PointCloudContent final
+    : public TileContentLoader {
+public:
+  /**
+   * @copydoc TileContentLoader::load
+   *
+   * The result will only contain the `model`. Other fields will be
+   * empty or have default values.
+   */
+  CesiumAsync::Future<std::unique_ptr<TileContentLoadResult>>
+  load(const TileContentLoadInput& input) override;
+
+  /**
+   * @brief Create a {@link TileContentLoadResult} from the given data.
+   *
+   * (Only public for tests)
+   *
+   * @param pLogger Only used for logging
+   * @param url The URL, only used for logging
+   * @param data The actual input data
+   * @return The {@link TileContentLoadResult}, or `nullptr` if the data is not
+   * a valid point cloud.
+   */
+  static std::unique_ptr<TileContentLoadResult> load(
+      const std::shared_ptr<spdlog::logger>& pLogger,
+      const std::string& url,
+      const gsl::span<const std::byte>& data);
+};
+
+} // namespace Cesium3DTilesSelection
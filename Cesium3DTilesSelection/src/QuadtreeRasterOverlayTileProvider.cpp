@@ -436,6 +436,41 @@ void blitImage(
   ImageManipulation::blitImage(target, targetPixels, source, sourcePixels);
 }
 
+// Determines whether blitting the source into a target image of the given
+// size would copy every source pixel unscaled into every target pixel, i.e.
+// whether the target image would be identical to the source image.
+bool isExactCopy(
+    const Rectangle& targetRectangle,
+    int32_t targetWidth,
+    int32_t targetHeight,
+    const ImageCesium& source,
+    const Rectangle& sourceRectangle,
+    const std::optional<Rectangle>& sourceSubset) {
+  if (source.width != targetWidth || source.height != targetHeight) {
+    return false;
+  }
+
+  const Rectangle sourceToCopy = sourceSubset.value_or(sourceRectangle);
+  std::optional<Rectangle> overlap =
+      targetRectangle.computeIntersection(sourceToCopy);
+  if (!overlap) {
+    return false;
+  }
+
+  // The source and target have the same dimensions, so the source can stand
+  // in for the target when computing pixel rectangles.
+  const PixelRectangle targetPixels =
+      computePixelRectangle(source, targetRectangle, *overlap);
+  const PixelRectangle sourcePixels =
+      computePixelRectangle(source, sourceRectangle, *overlap);
+
+  return targetPixels.x == 0 && targetPixels.y == 0 &&
+         targetPixels.width == targetWidth &&
+         targetPixels.height == targetHeight && sourcePixels.x == 0 &&
+         sourcePixels.y == 0 && sourcePixels.width == source.width &&
+         sourcePixels.height == source.height;
+}
+
 } // namespace
 
 CesiumAsync::Future<LoadedRasterOverlayImage>
@@ -451,7 +486,9 @@ QuadtreeRasterOverlayTileProvider::loadTileImage(
   return this->getAsyncSystem()
       .all(std::move(tiles))
       .thenInWorkerThread([projection = this->getProjection(),
-                           rectangle = overlayTile.getRectangle()](
+                           rectangle = overlayTile.getRectangle(),
+                           pImageBufferPool =
+                               this->getOwner().getOptions().pImageBufferPool](
                               std::vector<LoadedQuadtreeImage>&& images) {
         // This set of images is only "useful" if at least one actually has
         // image data, and that image data is _not_ from an ancestor. We can
@@ -481,7 +518,8 @@ QuadtreeRasterOverlayTileProvider::loadTileImage(
         return QuadtreeRasterOverlayTileProvider::combineImages(
             rectangle,
             projection,
-            std::move(images));
+            std::move(images),
+            pImageBufferPool.get());
       });
 }
 
@@ -518,6 +556,12 @@ void QuadtreeRasterOverlayTileProvider::unloadCachedTiles() {
       if (pImage->image) {
         this->_cachedBytes -= int64_t(pImage->image->pixelData.size());
         assert(this->_cachedBytes >= 0);
+
+        const std::shared_ptr<ImageBufferPool>& pImageBufferPool =
+            this->getOwner().getOptions().pImageBufferPool;
+        if (pImageBufferPool) {
+          pImageBufferPool->release(std::move(pImage->image->pixelData));
+        }
       }
     }
   }
@@ -642,7 +686,8 @@ QuadtreeRasterOverlayTileProvider::measureCombinedImage(
 QuadtreeRasterOverlayTileProvider::combineImages(
     const Rectangle& targetRectangle,
     const Projection& /* projection */,
-    std::vector<LoadedQuadtreeImage>&& images) {
+    std::vector<LoadedQuadtreeImage>&& images,
+    ImageBufferPool* pImageBufferPool) {
 
   const CombinedImageMeasurements measurements =
       QuadtreeRasterOverlayTileProvider::measureCombinedImage(
@@ -668,14 +713,8 @@ QuadtreeRasterOverlayTileProvider::combineImages(
   result.rectangle = measurements.rectangle;
   result.moreDetailAvailable = false;
 
-  ImageCesium& target = result.image.emplace();
-  target.bytesPerChannel = measurements.bytesPerChannel;
-  target.channels = measurements.channels;
-  target.width = measurements.widthPixels;
-  target.height = measurements.heightPixels;
-  target.pixelData.resize(size_t(
-      target.width * target.height * target.channels * target.bytesPerChannel));
-
+  auto onlyImageIt = images.end();
+  size_t imageCount = 0;
   for (auto it = images.begin(); it != images.end(); ++it) {
     const LoadedRasterOverlayImage& loaded = *it->pLoaded;
     if (!loaded.image) {
@@ -683,13 +722,66 @@ QuadtreeRasterOverlayTileProvider::combineImages(
     }
 
     result.moreDetailAvailable |= loaded.moreDetailAvailable;
+    onlyImageIt = it;
+    ++imageCount;
+  }
+
+  if (imageCount == 1 &&
+      isExactCopy(
+          measurements.rectangle,
+          measurements.widthPixels,
+          measurements.heightPixels,
+          *onlyImageIt->pLoaded->image,
+          onlyImageIt->pLoaded->rectangle,
+          onlyImageIt->subset)) {
+    // A single source image covers the target exactly, so there is nothing to
+    // combine. Take its pixels if no one else, such as the tile cache, is
+    // still referencing them, or copy them otherwise.
+    if (onlyImageIt->pLoaded.use_count() == 1) {
+      result.image = std::move(onlyImageIt->pLoaded->image);
+    } else if (pImageBufferPool) {
+      const ImageCesium& source = *onlyImageIt->pLoaded->image;
+      ImageCesium& target = result.image.emplace();
+      target.bytesPerChannel = source.bytesPerChannel;
+      target.channels = source.channels;
+      target.width = source.width;
+      target.height = source.height;
+      target.pixelData = pImageBufferPool->allocate(source.pixelData.size());
+      std::copy(
+          source.pixelData.begin(),
+          source.pixelData.end(),
+          target.pixelData.begin());
+    } else {
+      result.image = onlyImageIt->pLoaded->image;
+    }
+  } else {
+    ImageCesium& target = result.image.emplace();
+    target.bytesPerChannel = measurements.bytesPerChannel;
+    target.channels = measurements.channels;
+    target.width = measurements.widthPixels;
+    target.height = measurements.heightPixels;
+    const size_t targetSize = size_t(
+        target.width * target.height * target.channels *
+        target.bytesPerChannel);
+    if (pImageBufferPool) {
+      target.pixelData = pImageBufferPool->allocate(targetSize);
+    } else {
+      target.pixelData.resize(targetSize);
+    }
 
-    blitImage(
-        target,
-        result.rectangle,
-        *loaded.image,
-        loaded.rectangle,
-        it->subset);
+    for (auto it = images.begin(); it != images.end(); ++it) {
+      const LoadedRasterOverlayImage& loaded = *it->pLoaded;
+      if (!loaded.image) {
+        continue;
+      }
+
+      blitImage(
+          target,
+          result.rectangle,
+          *loaded.image,
+          loaded.rectangle,
+          it->subset);
+    }
   }
 
   size_t combinedCreditsCount = 0;
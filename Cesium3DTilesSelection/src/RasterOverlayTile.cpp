@@ -61,6 +61,14 @@ RasterOverlayTile::~RasterOverlayTile() {
           pMainThreadResult);
     }
   }
+
+  // Now that the renderer is done with the image, its pixel data can be reused
+  // for another tile.
+  const std::shared_ptr<CesiumGltf::ImageBufferPool>& pImageBufferPool =
+      this->_pOverlay->getOptions().pImageBufferPool;
+  if (pImageBufferPool) {
+    pImageBufferPool->release(std::move(this->_image.pixelData));
+  }
 }
 
 void RasterOverlayTile::loadInMainThread() {
@@ -126,7 +126,8 @@ RasterOverlayTileProvider::loadTileImageFromUrl(
   return this->getAssetAccessor()
       ->requestAsset(this->getAsyncSystem(), url, headers)
       .thenInWorkerThread(
-          [options = std::move(options)](
+          [options = std::move(options),
+           pImageBufferPool = this->getOwner().getOptions().pImageBufferPool](
               std::shared_ptr<IAssetRequest>&& pRequest) mutable {
             CESIUM_TRACE("load image");
             const IAssetResponse* pResponse = pRequest->response();
@@ -176,7 +177,9 @@ RasterOverlayTileProvider::loadTileImageFromUrl(
             const gsl::span<const std::byte> data = pResponse->data();
 
             CesiumGltf::ImageReaderResult loadedImage =
-                RasterOverlayTileProvider::_gltfReader.readImage(data);
+                RasterOverlayTileProvider::_gltfReader.readImage(
+                    data,
+                    pImageBufferPool.get());
 
             if (!loadedImage.errors.empty()) {
               loadedImage.errors.push_back("Image url: " + pRequest->url());
@@ -3,147 +3,227 @@
 #include "Cesium3DTilesSelection/BoundingVolume.h"
 #include "Cesium3DTilesSelection/RasterOverlayTileProvider.h"
 #include "Cesium3DTilesSelection/spdlog-cesium.h"
-#include "TileUtilities.h"
 
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumAsync/IAssetAccessor.h>
 #include <CesiumGeospatial/GlobeRectangle.h>
 #include <CesiumUtility/IntrusivePointer.h>
+#include <CesiumUtility/Math.h>
 
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
 using namespace CesiumGeometry;
 using namespace CesiumGeospatial;
 
 namespace Cesium3DTilesSelection {
 namespace {
-void rasterizePolygons(
-    LoadedRasterOverlayImage& loaded,
-    const CesiumGeospatial::GlobeRectangle& rectangle,
-    const glm::dvec2& textureSize,
-    const std::vector<CartographicPolygon>& cartographicPolygons) {
-
-  CesiumGltf::ImageCesium& image = loaded.image.emplace();
-
-  // create a 1x1 mask if the rectangle is completely inside a polygon
-  if (Cesium3DTilesSelection::Impl::withinPolygons(
-          rectangle,
-          cartographicPolygons)) {
-    loaded.moreDetailAvailable = false;
-    image.width = 1;
-    image.height = 1;
-    image.channels = 1;
-    image.bytesPerChannel = 1;
-    image.pixelData.resize(1);
-
-    image.pixelData[0] = static_cast<std::byte>(0xff);
 
+// The number of sub-scanlines sampled per pixel row. Horizontal coverage is
+// computed exactly, so this only controls the vertical anti-aliasing quality.
+constexpr size_t SUBSCANLINES_PER_ROW = 4;
+
+// Rows are rasterized in bands on separate worker threads. Small images are
+// not worth splitting.
+constexpr size_t MINIMUM_ROWS_PER_BAND = 64;
+constexpr size_t MAXIMUM_BANDS = 16;
+
+/**
+ * @brief A triangle in the pixel space of a single raster tile, where x
+ * increases to the east and y increases to the south, one unit per pixel.
+ */
+struct PixelTriangle {
+  glm::dvec2 a;
+  glm::dvec2 b;
+  glm::dvec2 c;
+  double top;
+  double bottom;
+};
+
+LoadedRasterOverlayImage
+createUniformImage(const Rectangle& rectangle, std::byte value) {
+  LoadedRasterOverlayImage result;
+  result.rectangle = rectangle;
+  result.moreDetailAvailable = false;
+
+  CesiumGltf::ImageCesium& image = result.image.emplace();
+  image.width = 1;
+  image.height = 1;
+  image.channels = 1;
+  image.bytesPerChannel = 1;
+  image.pixelData.resize(1, value);
+
+  return result;
+}
+
+void intersectEdge(
+    const glm::dvec2& p,
+    const glm::dvec2& q,
+    double y,
+    double& left,
+    double& right) {
+  // Half-open on y, so a scanline through a vertex is counted exactly once.
+  if ((y < p.y) == (y < q.y)) {
     return;
   }
 
-  bool completelyOutsidePolygons = true;
-  for (const CartographicPolygon& selection : cartographicPolygons) {
-    const std::optional<CesiumGeospatial::GlobeRectangle>& boundingRectangle =
-        selection.getBoundingRectangle();
+  const double x = p.x + (y - p.y) * (q.x - p.x) / (q.y - p.y);
+  left = glm::min(left, x);
+  right = glm::max(right, x);
+}
 
-    if (boundingRectangle &&
-        rectangle.computeIntersection(*boundingRectangle)) {
-      completelyOutsidePolygons = false;
-      break;
-    }
+/**
+ * @brief Adds the coverage of the span [left, right) on one sub-scanline.
+ *
+ * Partially covered pixels at either end of the span are added to `coverage`
+ * directly. Fully covered pixels in between are added to `fill` as a
+ * difference array, so the cost is independent of the span width.
+ */
+void accumulateSpan(
+    double left,
+    double right,
+    double weight,
+    std::vector<double>& coverage,
+    std::vector<double>& fill) {
+  const size_t width = coverage.size() - 1;
+  left = glm::max(left, 0.0);
+  right = glm::min(right, double(width));
+  if (right <= left) {
+    return;
   }
 
-  // create a 1x1 mask if the rectangle is completely outside all polygons
-  if (completelyOutsidePolygons) {
-    loaded.moreDetailAvailable = false;
-    image.width = 1;
-    image.height = 1;
-    image.channels = 1;
-    image.bytesPerChannel = 1;
-    image.pixelData.resize(1);
-
+  const size_t first = size_t(left);
+  const size_t last = size_t(right);
+  if (first == last) {
+    coverage[first] += (right - left) * weight;
     return;
   }
 
-  const double rectangleWidth = rectangle.computeWidth();
-  const double rectangleHeight = rectangle.computeHeight();
+  coverage[first] += (double(first + 1) - left) * weight;
+  fill[first + 1] += weight;
+  fill[last] -= weight;
+  coverage[last] += (right - double(last)) * weight;
+}
 
-  // create source image
-  loaded.moreDetailAvailable = true;
-  image.width = int32_t(glm::round(textureSize.x));
-  image.height = int32_t(glm::round(textureSize.y));
-  image.channels = 1;
-  image.bytesPerChannel = 1;
-  image.pixelData.resize(size_t(image.width * image.height));
-
-  // TODO: this is naive approach, use line-triangle
-  // intersections to rasterize one row at a time
-  // NOTE: also completely ignores antimeridian (really these
-  // calculations should be normalized to the first vertex)
-  for (const CartographicPolygon& polygon : cartographicPolygons) {
-    const std::vector<glm::dvec2>& vertices = polygon.getVertices();
-    const std::vector<uint32_t>& indices = polygon.getIndices();
-    for (size_t triangle = 0; triangle < indices.size() / 3; ++triangle) {
-      const glm::dvec2& a = vertices[indices[3 * triangle]];
-      const glm::dvec2& b = vertices[indices[3 * triangle + 1]];
-      const glm::dvec2& c = vertices[indices[3 * triangle + 2]];
-
-      // TODO: deal with the corner cases here
-      const double minX = glm::min(a.x, glm::min(b.x, c.x));
-      const double minY = glm::min(a.y, glm::min(b.y, c.y));
-      const double maxX = glm::max(a.x, glm::max(b.x, c.x));
-      const double maxY = glm::max(a.y, glm::max(b.y, c.y));
-
-      const CesiumGeospatial::GlobeRectangle triangleBounds(
-          minX,
-          minY,
-          maxX,
-          maxY);
-
-      // skip this triangle if it is entirely outside the tile bounds
-      if (!rectangle.computeIntersection(triangleBounds)) {
-        continue;
-      }
+/**
+ * @brief Rasterizes the coverage of the indexed polygons into the rows
+ * [firstRow, firstRow + rowCount) of a `width` x `height` single-channel image
+ * spanning `rectangle`.
+ *
+ * Triangles are sorted by their top edge and swept with an active list, and
+ * each pixel receives its exact horizontal coverage averaged over
+ * SUBSCANLINES_PER_ROW sub-scanlines.
+ */
+std::vector<std::byte> rasterizeRows(
+    const CartographicPolygonIndex& polygonIndex,
+    const GlobeRectangle& rectangle,
+    size_t width,
+    size_t height,
+    size_t firstRow,
+    size_t rowCount) {
+  std::vector<std::byte> pixels(width * rowCount);
+  if (width == 0 || rowCount == 0) {
+    return pixels;
+  }
 
-      const glm::dvec2 ab = b - a;
-      const glm::dvec2 ab_perp(-ab.y, ab.x);
-      const glm::dvec2 bc = c - b;
-      const glm::dvec2 bc_perp(-bc.y, bc.x);
-      const glm::dvec2 ca = a - c;
-      const glm::dvec2 ca_perp(-ca.y, ca.x);
-
-      size_t width = size_t(image.width);
-      size_t height = size_t(image.height);
-
-      for (size_t j = 0; j < height; ++j) {
-        const double pixelY =
-            rectangle.getSouth() +
-            rectangleHeight * (1.0 - (double(j) + 0.5) / double(height));
-        for (size_t i = 0; i < width; ++i) {
-          const double pixelX = rectangle.getWest() + rectangleWidth *
-                                                          (double(i) + 0.5) /
-                                                          double(width);
-          const glm::dvec2 v(pixelX, pixelY);
-
-          const glm::dvec2 av = v - a;
-          const glm::dvec2 cv = v - c;
-
-          const double v_proj_ab_perp = glm::dot(av, ab_perp);
-          const double v_proj_bc_perp = glm::dot(cv, bc_perp);
-          const double v_proj_ca_perp = glm::dot(cv, ca_perp);
-
-          // will determine in or out, irrespective of winding
-          if ((v_proj_ab_perp >= 0.0 && v_proj_ca_perp >= 0.0 &&
-               v_proj_bc_perp >= 0.0) ||
-              (v_proj_ab_perp <= 0.0 && v_proj_ca_perp <= 0.0 &&
-               v_proj_bc_perp <= 0.0)) {
-            image.pixelData[width * j + i] = static_cast<std::byte>(0xff);
-          }
-        }
+  const double west = rectangle.getWest();
+  const double north = rectangle.getNorth();
+  const double scaleX = double(width) / rectangle.computeWidth();
+  const double scaleY = double(height) / rectangle.computeHeight();
+
+  // Find the triangles overlapping this band, already shifted across the
+  // antimeridian as needed, and project them into pixel space.
+  const GlobeRectangle bandRectangle(
+      west,
+      north - double(firstRow + rowCount) / scaleY,
+      rectangle.getEast(),
+      north - double(firstRow) / scaleY);
+
+  std::vector<CartographicPolygonIndex::Triangle> triangles;
+  polygonIndex.findTriangles(bandRectangle, triangles);
+
+  const auto toPixel = [west, north, scaleX, scaleY](const glm::dvec2& p) {
+    return glm::dvec2((p.x - west) * scaleX, (north - p.y) * scaleY);
+  };
+
+  std::vector<PixelTriangle> pixelTriangles;
+  pixelTriangles.reserve(triangles.size());
+  for (const CartographicPolygonIndex::Triangle& triangle : triangles) {
+    const glm::dvec2 a = toPixel(triangle.a);
+    const glm::dvec2 b = toPixel(triangle.b);
+    const glm::dvec2 c = toPixel(triangle.c);
+    pixelTriangles.push_back(PixelTriangle{
+        a,
+        b,
+        c,
+        glm::min(a.y, glm::min(b.y, c.y)),
+        glm::max(a.y, glm::max(b.y, c.y))});
+  }
+
+  std::sort(
+      pixelTriangles.begin(),
+      pixelTriangles.end(),
+      [](const PixelTriangle& lhs, const PixelTriangle& rhs) {
+        return lhs.top < rhs.top;
+      });
+
+  std::vector<const PixelTriangle*> active;
+  std::vector<double> coverage(width + 1);
+  std::vector<double> fill(width + 1);
+  const double weight = 1.0 / double(SUBSCANLINES_PER_ROW);
+
+  size_t next = 0;
+  for (size_t row = 0; row < rowCount; ++row) {
+    const double rowTop = double(firstRow + row);
+    const double rowBottom = rowTop + 1.0;
+
+    while (next < pixelTriangles.size() &&
+           pixelTriangles[next].top < rowBottom) {
+      active.push_back(&pixelTriangles[next]);
+      ++next;
+    }
+
+    active.erase(
+        std::remove_if(
+            active.begin(),
+            active.end(),
+            [rowTop](const PixelTriangle* pTriangle) {
+              return pTriangle->bottom <= rowTop;
+            }),
+        active.end());
+
+    if (active.empty()) {
+      continue;
+    }
+
+    std::fill(coverage.begin(), coverage.end(), 0.0);
+    std::fill(fill.begin(), fill.end(), 0.0);
+
+    for (const PixelTriangle* pTriangle : active) {
+      for (size_t sample = 0; sample < SUBSCANLINES_PER_ROW; ++sample) {
+        const double y = rowTop + (double(sample) + 0.5) * weight;
+        double left = std::numeric_limits<double>::max();
+        double right = std::numeric_limits<double>::lowest();
+        intersectEdge(pTriangle->a, pTriangle->b, y, left, right);
+        intersectEdge(pTriangle->b, pTriangle->c, y, left, right);
+        intersectEdge(pTriangle->c, pTriangle->a, y, left, right);
+        accumulateSpan(left, right, weight, coverage, fill);
       }
     }
+
+    std::byte* pRow = pixels.data() + row * width;
+    double filled = 0.0;
+    for (size_t i = 0; i < width; ++i) {
+      filled += fill[i];
+      const double value = glm::clamp(coverage[i] + filled, 0.0, 1.0);
+      pRow[i] = std::byte(uint8_t(value * 255.0 + 0.5));
+    }
   }
+
+  return pixels;
 }
 
 Rectangle computeCoverageRectangle(
@@ -166,6 +246,15 @@ Rectangle computeCoverageRectangle(
   }
 
   if (result) {
+    // A projected rectangle cannot wrap around the antimeridian, so cover the
+    // full range of longitudes instead.
+    if (result->getWest() > result->getEast()) {
+      result = GlobeRectangle(
+          -CesiumUtility::Math::ONE_PI,
+          result->getSouth(),
+          CesiumUtility::Math::ONE_PI,
+          result->getNorth());
+    }
     return projectRectangleSimple(projection, *result);
   } else {
     return Rectangle(0.0, 0.0, 0.0, 0.0);
@@ -178,7 +267,7 @@ class CESIUM3DTILESSELECTION_API RasterizedPolygonsTileProvider final
     : public RasterOverlayTileProvider {
 
 private:
-  std::vector<CartographicPolygon> _polygons;
+  std::shared_ptr<const CartographicPolygonIndex> _pPolygonIndex;
 
 public:
   RasterizedPolygonsTileProvider(
@@ -189,7 +278,8 @@ public:
           pPrepareRendererResources,
       const std::shared_ptr<spdlog::logger>& pLogger,
       const CesiumGeospatial::Projection& projection,
-      const std::vector<CartographicPolygon>& polygons)
+      const std::vector<CartographicPolygon>& polygons,
+      const std::shared_ptr<const CartographicPolygonIndex>& pPolygonIndex)
       : RasterOverlayTileProvider(
             owner,
             asyncSystem,
@@ -199,7 +289,7 @@ public:
             pLogger,
             projection,
             computeCoverageRectangle(projection, polygons)),
-        _polygons(polygons) {}
+        _pPolygonIndex(pPolygonIndex) {}
 
   virtual CesiumAsync::Future<LoadedRasterOverlayImage>
   loadTileImage(RasterOverlayTile& overlayTile) override {
@@ -210,21 +300,78 @@ public:
         overlayTile.getTargetScreenPixels() / options.maximumScreenSpaceError,
         glm::dvec2(options.maximumTextureSize));
 
-    return this->getAsyncSystem().runInWorkerThread(
-        [&polygons = this->_polygons,
-         projection = this->getProjection(),
-         rectangle = overlayTile.getRectangle(),
-         textureSize]() -> LoadedRasterOverlayImage {
-          const CesiumGeospatial::GlobeRectangle tileRectangle =
-              CesiumGeospatial::unprojectRectangleSimple(projection, rectangle);
+    const CesiumAsync::AsyncSystem& asyncSystem = this->getAsyncSystem();
+    const Rectangle& rectangle = overlayTile.getRectangle();
+    const GlobeRectangle tileRectangle =
+        unprojectRectangleSimple(this->getProjection(), rectangle);
 
-          LoadedRasterOverlayImage result;
-          result.rectangle = rectangle;
+    // create a 1x1 mask if the rectangle is completely outside all polygons
+    if (!this->_pPolygonIndex->intersects(tileRectangle)) {
+      return asyncSystem.createResolvedFuture(
+          createUniformImage(rectangle, std::byte(0x00)));
+    }
+
+    // create a 1x1 mask if the rectangle is completely inside a polygon
+    if (this->_pPolygonIndex->contains(tileRectangle)) {
+      return asyncSystem.createResolvedFuture(
+          createUniformImage(rectangle, std::byte(0xff)));
+    }
 
-          rasterizePolygons(result, tileRectangle, textureSize, polygons);
+    const size_t width = size_t(glm::round(textureSize.x));
+    const size_t height = size_t(glm::round(textureSize.y));
+
+    // Rasterize bands of rows in parallel. The bands are dispatched from here
+    // rather than from a worker thread, where they would run sequentially.
+    const size_t bandCount =
+        std::clamp(height / MINIMUM_ROWS_PER_BAND, size_t(1), MAXIMUM_BANDS);
+
+    std::vector<CesiumAsync::Future<std::vector<std::byte>>> bands;
+    bands.reserve(bandCount);
+    for (size_t band = 0; band < bandCount; ++band) {
+      const size_t firstRow = height * band / bandCount;
+      const size_t lastRow = height * (band + 1) / bandCount;
+      bands.emplace_back(asyncSystem.runInWorkerThread(
+          [pPolygonIndex = this->_pPolygonIndex,
+           tileRectangle,
+           width,
+           height,
+           firstRow,
+           rowCount = lastRow - firstRow]() {
+            return rasterizeRows(
+                *pPolygonIndex,
+                tileRectangle,
+                width,
+                height,
+                firstRow,
+                rowCount);
+          }));
+    }
 
-          return result;
-        });
+    return asyncSystem.all(std::move(bands))
+        .thenInWorkerThread(
+            [rectangle,
+             width,
+             height](std::vector<std::vector<std::byte>>&& rows)
+                -> LoadedRasterOverlayImage {
+              LoadedRasterOverlayImage result;
+              result.rectangle = rectangle;
+              result.moreDetailAvailable = true;
+
+              CesiumGltf::ImageCesium& image = result.image.emplace();
+              image.width = int32_t(width);
+              image.height = int32_t(height);
+              image.channels = 1;
+              image.bytesPerChannel = 1;
+              image.pixelData.reserve(width * height);
+              for (const std::vector<std::byte>& band : rows) {
+                image.pixelData.insert(
+                    image.pixelData.end(),
+                    band.begin(),
+                    band.end());
+              }
+
+              return result;
+            });
   }
 };
 
@@ -236,6 +383,8 @@ RasterizedPolygonsOverlay::RasterizedPolygonsOverlay(
     const RasterOverlayOptions& overlayOptions)
     : RasterOverlay(name, overlayOptions),
       _polygons(polygons),
+      _pPolygonIndex(
+          std::make_shared<const CartographicPolygonIndex>(polygons)),
       _ellipsoid(ellipsoid),
       _projection(projection) {}
 
@@ -261,7 +410,8 @@ RasterizedPolygonsOverlay::createTileProvider(
               pPrepareRendererResources,
               pLogger,
               this->_projection,
-              this->_polygons));
+              this->_polygons,
+              this->_pPolygonIndex));
 }
 
 } // namespace Cesium3DTilesSelection
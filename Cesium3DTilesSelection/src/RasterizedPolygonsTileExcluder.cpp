@@ -14,5 +14,5 @@ bool RasterizedPolygonsTileExcluder::shouldExclude(
     const Tile& tile) const noexcept {
   return Cesium3DTilesSelection::Impl::withinPolygons(
       tile.getBoundingVolume(),
-      this->_pOverlay->getPolygons());
+      this->_pOverlay->getPolygonIndex());
 }
@@ -0,0 +1,128 @@
+#include "Cesium3DTilesSelection/SubtreeAvailability.h"
+
+#include <utility>
+
+namespace Cesium3DTilesSelection {
+
+namespace {
+
+// Spreads the low 32 bits of a value so that there is one zero bit between
+// each of them.
+uint64_t spreadBitsBy1(uint32_t value) noexcept {
+  uint64_t result = value;
+  result = (result | (result << 16)) & 0x0000FFFF0000FFFFULL;
+  result = (result | (result << 8)) & 0x00FF00FF00FF00FFULL;
+  result = (result | (result << 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  result = (result | (result << 2)) & 0x3333333333333333ULL;
+  result = (result | (result << 1)) & 0x5555555555555555ULL;
+  return result;
+}
+
+// Spreads the low 21 bits of a value so that there are two zero bits between
+// each of them.
+uint64_t spreadBitsBy2(uint32_t value) noexcept {
+  uint64_t result = value & 0x1FFFFF;
+  result = (result | (result << 32)) & 0x001F00000000FFFFULL;
+  result = (result | (result << 16)) & 0x001F0000FF0000FFULL;
+  result = (result | (result << 8)) & 0x100F00F00F00F00FULL;
+  result = (result | (result << 4)) & 0x10C30C30C30C30C3ULL;
+  result = (result | (result << 2)) & 0x1249249249249249ULL;
+  return result;
+}
+
+} // namespace
+
+SubtreeAvailability::SubtreeAvailability(
+    ImplicitTilingSubdivisionScheme subdivisionScheme,
+    uint32_t subtreeLevels) noexcept
+    : _subdivisionScheme(subdivisionScheme),
+      _subtreeLevels(subtreeLevels),
+      _buffer(),
+      _tileAvailability(),
+      _contentAvailability(),
+      _subtreeAvailability() {}
+
+SubtreeAvailability::SubtreeAvailability(
+    ImplicitTilingSubdivisionScheme subdivisionScheme,
+    uint32_t subtreeLevels,
+    std::vector<std::byte>&& buffer,
+    const AvailabilityView& tileAvailability,
+    std::vector<AvailabilityView>&& contentAvailability,
+    const AvailabilityView& subtreeAvailability) noexcept
+    : _subdivisionScheme(subdivisionScheme),
+      _subtreeLevels(subtreeLevels),
+      _buffer(std::move(buffer)),
+      _tileAvailability(tileAvailability),
+      _contentAvailability(std::move(contentAvailability)),
+      _subtreeAvailability(subtreeAvailability) {}
+
+bool SubtreeAvailability::isTileAvailable(
+    uint32_t relativeLevel,
+    uint64_t mortonIndex) const noexcept {
+  if (relativeLevel >= this->_subtreeLevels) {
+    return false;
+  }
+
+  return this->isAvailable(
+      this->_tileAvailability,
+      this->getLevelOffset(relativeLevel) + mortonIndex);
+}
+
+bool SubtreeAvailability::isContentAvailable(
+    uint32_t relativeLevel,
+    uint64_t mortonIndex,
+    size_t contentIndex) const noexcept {
+  if (relativeLevel >= this->_subtreeLevels ||
+      contentIndex >= this->_contentAvailability.size()) {
+    return false;
+  }
+
+  return this->isAvailable(
+      this->_contentAvailability[contentIndex],
+      this->getLevelOffset(relativeLevel) + mortonIndex);
+}
+
+bool SubtreeAvailability::isSubtreeAvailable(
+    uint64_t mortonIndex) const noexcept {
+  return this->isAvailable(this->_subtreeAvailability, mortonIndex);
+}
+
+/*static*/ uint64_t
+SubtreeAvailability::computeMortonIndex(uint32_t x, uint32_t y) noexcept {
+  return spreadBitsBy1(x) | (spreadBitsBy1(y) << 1);
+}
+
+/*static*/ uint64_t SubtreeAvailability::computeMortonIndex(
+    uint32_t x,
+    uint32_t y,
+    uint32_t z) noexcept {
+  return spreadBitsBy2(x) | (spreadBitsBy2(y) << 1) | (spreadBitsBy2(z) << 2);
+}
+
+bool SubtreeAvailability::isAvailable(
+    const AvailabilityView& view,
+    uint64_t index) const noexcept {
+  if (view.byteLength == 0) {
+    return view.constant;
+  }
+
+  const uint64_t byte = index >> 3;
+  if (byte >= view.byteLength) {
+    return false;
+  }
+
+  const uint8_t bits = uint8_t(this->_buffer[view.byteOffset + byte]);
+  return ((bits >> (index & 7)) & 1) != 0;
+}
+
+uint64_t
+SubtreeAvailability::getLevelOffset(uint32_t relativeLevel) const noexcept {
+  // The number of tiles in the levels above this one, which is
+  // (4^level - 1) / 3 for a quadtree and (8^level - 1) / 7 for an octree.
+  if (this->_subdivisionScheme == ImplicitTilingSubdivisionScheme::Quadtree) {
+    return ((uint64_t(1) << (2 * relativeLevel)) - 1) / 3;
+  }
+  return ((uint64_t(1) << (3 * relativeLevel)) - 1) / 7;
+}
+
+} // namespace Cesium3DTilesSelection
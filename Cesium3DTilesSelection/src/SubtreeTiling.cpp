@@ -0,0 +1,384 @@
+#include "SubtreeTiling.h"
+
+#include "Cesium3DTilesSelection/Tileset.h"
+#include "Cesium3DTilesSelection/spdlog-cesium.h"
+#include "readSubtree.h"
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumAsync/IAssetRequest.h>
+#include <CesiumAsync/IAssetResponse.h>
+#include <CesiumGeometry/OrientedBoundingBox.h>
+#include <CesiumGeometry/QuadtreeTileID.h>
+#include <CesiumGeospatial/BoundingRegion.h>
+#include <CesiumGeospatial/GlobeRectangle.h>
+#include <CesiumUtility/Math.h>
+#include <CesiumUtility/Uri.h>
+#include <CesiumUtility/joinToString.h>
+
+#include <optional>
+#include <utility>
+#include <vector>
+
+using namespace CesiumAsync;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumUtility;
+
+namespace Cesium3DTilesSelection {
+
+namespace {
+
+std::optional<OctreeTileID> getImplicitTileID(const TileID& tileID) noexcept {
+  const QuadtreeTileID* pQuadtreeID = std::get_if<QuadtreeTileID>(&tileID);
+  if (pQuadtreeID) {
+    return OctreeTileID(pQuadtreeID->level, pQuadtreeID->x, pQuadtreeID->y, 0);
+  }
+
+  const OctreeTileID* pOctreeID = std::get_if<OctreeTileID>(&tileID);
+  if (pOctreeID) {
+    return *pOctreeID;
+  }
+
+  return std::nullopt;
+}
+
+OctreeTileID getSubtreeID(
+    const SubtreeTilingContext& context,
+    const OctreeTileID& tileID) noexcept {
+  const uint32_t relativeLevel = tileID.level % context.subtreeLevels;
+  return OctreeTileID(
+      tileID.level - relativeLevel,
+      tileID.x >> relativeLevel,
+      tileID.y >> relativeLevel,
+      tileID.z >> relativeLevel);
+}
+
+/**
+ * @brief Computes the Morton index of a tile's coordinates relative to those
+ * of one of its ancestors.
+ */
+uint64_t computeRelativeMortonIndex(
+    ImplicitTilingSubdivisionScheme subdivisionScheme,
+    const OctreeTileID& ancestorID,
+    const OctreeTileID& tileID) noexcept {
+  const uint32_t levels = tileID.level - ancestorID.level;
+  const uint32_t x = tileID.x - (ancestorID.x << levels);
+  const uint32_t y = tileID.y - (ancestorID.y << levels);
+  if (subdivisionScheme == ImplicitTilingSubdivisionScheme::Quadtree) {
+    return SubtreeAvailability::computeMortonIndex(x, y);
+  }
+
+  const uint32_t z = tileID.z - (ancestorID.z << levels);
+  return SubtreeAvailability::computeMortonIndex(x, y, z);
+}
+
+const SubtreeAvailability* getSubtree(
+    const SubtreeTilingContext& context,
+    const OctreeTileID& subtreeID) noexcept {
+  auto it = context.subtrees.find(subtreeID);
+  if (it == context.subtrees.end() || !it->second) {
+    return nullptr;
+  }
+  return &it->second.value();
+}
+
+std::string substituteTileID(
+    const std::string& templateUrl,
+    const OctreeTileID& tileID) {
+  return Uri::substituteTemplateParameters(
+      templateUrl,
+      [&tileID](const std::string& placeholder) -> std::string {
+        if (placeholder == "level") {
+          return std::to_string(tileID.level);
+        }
+        if (placeholder == "x") {
+          return std::to_string(tileID.x);
+        }
+        if (placeholder == "y") {
+          return std::to_string(tileID.y);
+        }
+        if (placeholder == "z") {
+          return std::to_string(tileID.z);
+        }
+
+        return placeholder;
+      });
+}
+
+SubtreeAvailability readSubtreeResponse(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const IAssetRequest& request,
+    ImplicitTilingSubdivisionScheme subdivisionScheme,
+    uint32_t subtreeLevels) {
+  const IAssetResponse* pResponse = request.response();
+  if (!pResponse) {
+    SPDLOG_LOGGER_ERROR(
+        pLogger,
+        "Did not receive a valid response for subtree {}",
+        request.url());
+    return SubtreeAvailability(subdivisionScheme, subtreeLevels);
+  }
+
+  if (pResponse->statusCode() != 0 &&
+      (pResponse->statusCode() < 200 || pResponse->statusCode() >= 300)) {
+    SPDLOG_LOGGER_ERROR(
+        pLogger,
+        "Received status code {} for subtree {}",
+        pResponse->statusCode(),
+        request.url());
+    return SubtreeAvailability(subdivisionScheme, subtreeLevels);
+  }
+
+  CesiumJsonReader::ReadJsonResult<SubtreeAvailability> result =
+      readSubtree(pResponse->data(), subdivisionScheme, subtreeLevels);
+  if (!result.warnings.empty()) {
+    SPDLOG_LOGGER_WARN(
+        pLogger,
+        "Warnings when reading subtree {}:\n- {}",
+        request.url(),
+        joinToString(result.warnings, "\n- "));
+  }
+  if (!result.value) {
+    SPDLOG_LOGGER_ERROR(
+        pLogger,
+        "Errors when reading subtree {}:\n- {}",
+        request.url(),
+        joinToString(result.errors, "\n- "));
+    return SubtreeAvailability(subdivisionScheme, subtreeLevels);
+  }
+
+  return std::move(result.value.value());
+}
+
+/**
+ * @brief Computes the bounding volume of a child of an implicit tile, which
+ * is the part of the tile's bounding volume with the given position in it.
+ */
+std::optional<BoundingVolume> subdivideBoundingVolume(
+    const BoundingVolume& boundingVolume,
+    ImplicitTilingSubdivisionScheme subdivisionScheme,
+    const glm::dvec3& childPosition) {
+  const bool isOctree =
+      subdivisionScheme == ImplicitTilingSubdivisionScheme::Octree;
+
+  const OrientedBoundingBox* pBox =
+      std::get_if<OrientedBoundingBox>(&boundingVolume);
+  if (pBox) {
+    // A position of 0 is the half of an axis in its negative direction.
+    const glm::dmat3& halfAxes = pBox->getHalfAxes();
+    const glm::dvec3 offset = childPosition - 0.5;
+
+    glm::dvec3 center =
+        pBox->getCenter() + halfAxes[0] * offset.x + halfAxes[1] * offset.y;
+    glm::dmat3 childHalfAxes(halfAxes[0] * 0.5, halfAxes[1] * 0.5, halfAxes[2]);
+    if (isOctree) {
+      center += halfAxes[2] * offset.z;
+      childHalfAxes[2] *= 0.5;
+    }
+
+    return OrientedBoundingBox(center, childHalfAxes);
+  }
+
+  const BoundingRegion* pRegion = std::get_if<BoundingRegion>(&boundingVolume);
+  if (pRegion) {
+    const GlobeRectangle& rectangle = pRegion->getRectangle();
+    // The region may cross the anti-meridian, in which case its east is less
+    // than its west.
+    const double width = rectangle.computeWidth() * 0.5;
+    const double height = (rectangle.getNorth() - rectangle.getSouth()) * 0.5;
+    const double west = rectangle.getWest() + width * childPosition.x;
+    const double south = rectangle.getSouth() + height * childPosition.y;
+
+    double minimumHeight = pRegion->getMinimumHeight();
+    double maximumHeight = pRegion->getMaximumHeight();
+    if (isOctree) {
+      const double heightRange = (maximumHeight - minimumHeight) * 0.5;
+      minimumHeight += heightRange * childPosition.z;
+      maximumHeight = minimumHeight + heightRange;
+    }
+
+    return BoundingRegion(
+        GlobeRectangle(
+            Math::negativePiToPi(west),
+            south,
+            Math::negativePiToPi(west + width),
+            south + height),
+        minimumHeight,
+        maximumHeight);
+  }
+
+  return std::nullopt;
+}
+
+} // namespace
+
+bool loadTileSubtree(Tile& tile) {
+  TileContext* pContext = tile.getContext();
+  if (!pContext || !pContext->subtreeContext) {
+    return true;
+  }
+
+  const std::optional<OctreeTileID> tileID =
+      getImplicitTileID(tile.getTileID());
+  if (!tileID) {
+    return true;
+  }
+
+  SubtreeTilingContext& context = *pContext->subtreeContext;
+  const OctreeTileID subtreeID = getSubtreeID(context, *tileID);
+
+  auto [it, added] = context.subtrees.try_emplace(subtreeID);
+  if (!added) {
+    return it->second.has_value();
+  }
+
+  Tileset* pTileset = tile.getTileset();
+  const TilesetExternals& externals = pTileset->getExternals();
+  const std::string url = Uri::resolve(
+      pContext->baseUrl,
+      substituteTileID(context.subtreeTemplateUrl, subtreeID),
+      true);
+
+  pTileset->notifyTileStartLoading(nullptr);
+
+  externals.pAssetAccessor
+      ->requestAsset(pTileset->getAsyncSystem(), url, pContext->requestHeaders)
+      .thenInWorkerThread(
+          [pLogger = externals.pLogger,
+           subdivisionScheme = context.subdivisionScheme,
+           subtreeLevels = context.subtreeLevels](
+              std::shared_ptr<IAssetRequest>&& pRequest) {
+            return readSubtreeResponse(
+                pLogger,
+                *pRequest,
+                subdivisionScheme,
+                subtreeLevels);
+          })
+      .thenInMainThread(
+          [pTileset, pContext, subtreeID](SubtreeAvailability&& subtree) {
+            pContext->subtreeContext->subtrees[subtreeID] = std::move(subtree);
+            pTileset->notifyTileDoneLoading(nullptr);
+          })
+      .catchInMainThread([pTileset, pContext, subtreeID, url](
+                             const std::exception& e) {
+        SPDLOG_LOGGER_ERROR(
+            pTileset->getExternals().pLogger,
+            "Unhandled error for subtree {}: {}",
+            url,
+            e.what());
+        SubtreeTilingContext& context = *pContext->subtreeContext;
+        context.subtrees[subtreeID].emplace(
+            context.subdivisionScheme,
+            context.subtreeLevels);
+        pTileset->notifyTileDoneLoading(nullptr);
+      });
+
+  return false;
+}
+
+void createSubtreeChildTiles(Tile& tile) {
+  TileContext* pContext = tile.getContext();
+  if (!pContext || !pContext->subtreeContext || !tile.getChildren().empty()) {
+    return;
+  }
+
+  const std::optional<OctreeTileID> tileID =
+      getImplicitTileID(tile.getTileID());
+  const SubtreeTilingContext& context = *pContext->subtreeContext;
+  if (!tileID || tileID->level + 1 >= context.availableLevels ||
+      !loadTileSubtree(tile)) {
+    return;
+  }
+
+  const OctreeTileID subtreeID = getSubtreeID(context, *tileID);
+  const SubtreeAvailability* pSubtree = getSubtree(context, subtreeID);
+  if (!pSubtree) {
+    return;
+  }
+
+  // The children of a tile in the last level of a subtree are the roots of
+  // child subtrees. They're available if their subtree is, and their own
+  // subtree is loaded when they're needed.
+  const bool childrenAreSubtreeRoots =
+      tileID->level + 1 - subtreeID.level == context.subtreeLevels;
+  const bool isOctree =
+      context.subdivisionScheme == ImplicitTilingSubdivisionScheme::Octree;
+  const uint32_t childCount = isOctree ? 8 : 4;
+
+  std::vector<Tile> children;
+  for (uint32_t i = 0; i < childCount; ++i) {
+    const glm::dvec3 childPosition(
+        double(i & 1),
+        double((i >> 1) & 1),
+        double((i >> 2) & 1));
+    const OctreeTileID childID(
+        tileID->level + 1,
+        tileID->x * 2 + (i & 1),
+        tileID->y * 2 + ((i >> 1) & 1),
+        tileID->z * 2 + ((i >> 2) & 1));
+
+    const uint64_t mortonIndex = computeRelativeMortonIndex(
+        context.subdivisionScheme,
+        subtreeID,
+        childID);
+    const bool isAvailable =
+        childrenAreSubtreeRoots
+            ? pSubtree->isSubtreeAvailable(mortonIndex)
+            : pSubtree->isTileAvailable(
+                  childID.level - subtreeID.level,
+                  mortonIndex);
+
+    if (!isAvailable) {
+      continue;
+    }
+
+    std::optional<BoundingVolume> boundingVolume = subdivideBoundingVolume(
+        tile.getBoundingVolume(),
+        context.subdivisionScheme,
+        childPosition);
+    if (!boundingVolume) {
+      return;
+    }
+
+    Tile& child = children.emplace_back();
+    child.setContext(pContext);
+    child.setParent(&tile);
+    if (isOctree) {
+      child.setTileID(childID);
+    } else {
+      child.setTileID(QuadtreeTileID(childID.level, childID.x, childID.y));
+    }
+    child.setTransform(tile.getTransform());
+    child.setRefine(tile.getRefine());
+    child.setGeometricError(tile.getGeometricError() * 0.5);
+    child.setBoundingVolume(std::move(*boundingVolume));
+  }
+
+  if (!children.empty()) {
+    tile.createChildTiles(std::move(children));
+  }
+}
+
+std::string getSubtreeTileContentUrl(
+    const SubtreeTilingContext& context,
+    const OctreeTileID& tileID) {
+  if (!context.contentTemplateUrl) {
+    return std::string();
+  }
+
+  const OctreeTileID subtreeID = getSubtreeID(context, tileID);
+  const SubtreeAvailability* pSubtree = getSubtree(context, subtreeID);
+  if (!pSubtree || !pSubtree->isContentAvailable(
+                       tileID.level - subtreeID.level,
+                       computeRelativeMortonIndex(
+                           context.subdivisionScheme,
+                           subtreeID,
+                           tileID))) {
+    return std::string();
+  }
+
+  return substituteTileID(*context.contentTemplateUrl, tileID);
+}
+
+} // namespace Cesium3DTilesSelection
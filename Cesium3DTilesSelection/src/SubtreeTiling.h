@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Cesium3DTilesSelection/Tile.h"
+#include "Cesium3DTilesSelection/TileContext.h"
+
+#include <CesiumGeometry/OctreeTileID.h>
+
+#include <string>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief Determines if the subtree that contains a tile of a
+ * {@link SubtreeTilingContext} has loaded, and starts loading it if it has not
+ * been requested yet.
+ *
+ * Once the subtree has loaded, or failed to load, it's stored in the
+ * context's {@link SubtreeTilingContext::subtrees}.
+ *
+ * @param tile The tile.
+ * @return Whether the tile's subtree has loaded. This is `true` for a tile
+ * that is not part of an implicit tileset.
+ */
+bool loadTileSubtree(Tile& tile);
+
+/**
+ * @brief Creates the available children of a tile of a
+ * {@link SubtreeTilingContext}.
+ *
+ * This does nothing if the tile already has children, or if the subtree that
+ * determines which of its children are available has not loaded yet, in which
+ * case it is requested.
+ *
+ * @param tile The tile.
+ */
+void createSubtreeChildTiles(Tile& tile);
+
+/**
+ * @brief Gets the relative URL of the content of a tile of a
+ * {@link SubtreeTilingContext}.
+ *
+ * Quadtree tiles are identified with a z-coordinate of 0.
+ *
+ * @param context The context.
+ * @param tileID The ID of the tile.
+ * @return The URL, or an empty string if the tile has no content or its
+ * subtree has not loaded.
+ */
+std::string getSubtreeTileContentUrl(
+    const SubtreeTilingContext& context,
+    const CesiumGeometry::OctreeTileID& tileID);
+
+} // namespace Cesium3DTilesSelection
@@ -1,10 +1,13 @@
 #include "Cesium3DTilesSelection/Tile.h"
 
+#include "Cesium3DTilesSelection/FeatureIndex.h"
 #include "Cesium3DTilesSelection/GltfContent.h"
 #include "Cesium3DTilesSelection/IPrepareRendererResources.h"
 #include "Cesium3DTilesSelection/TileContentFactory.h"
 #include "Cesium3DTilesSelection/Tileset.h"
+#include "SubtreeTiling.h"
 #include "TileUtilities.h"
+#include "readTilesetJson.h"
 #include "upsampleGltfForRasterOverlays.h"
 
 #include <CesiumAsync/AsyncSystem.h>
@@ -18,7 +21,10 @@
 #include <CesiumGltf/Model.h>
 #include <CesiumUtility/Tracing.h>
 
+#include <array>
 #include <cstddef>
+#include <mutex>
+#include <optional>
 
 using namespace CesiumAsync;
 using namespace CesiumGeometry;
@@ -39,9 +45,11 @@ Tile::Tile() noexcept
       _transform(1.0),
       _id(""s),
       _contentBoundingVolume(),
+      _packedTileRecord(),
       _state(LoadState::Unloaded),
       _pContent(nullptr),
       _pRendererResources(nullptr),
+      _pUpsampledChildren(),
       _lastSelectionState(),
       _loadedTilesLinks() {}
 
@@ -58,9 +66,11 @@ Tile::Tile(Tile&& rhs) noexcept
       _transform(rhs._transform),
       _id(std::move(rhs._id)),
       _contentBoundingVolume(rhs._contentBoundingVolume),
+      _packedTileRecord(rhs._packedTileRecord),
       _state(rhs.getState()),
       _pContent(std::move(rhs._pContent)),
       _pRendererResources(rhs._pRendererResources),
+      _pUpsampledChildren(std::move(rhs._pUpsampledChildren)),
       _lastSelectionState(rhs._lastSelectionState),
       _loadedTilesLinks() {}
 
@@ -77,9 +87,11 @@ Tile& Tile::operator=(Tile&& rhs) noexcept {
     this->_transform = rhs._transform;
     this->_id = std::move(rhs._id);
     this->_contentBoundingVolume = rhs._contentBoundingVolume;
+    this->_packedTileRecord = rhs._packedTileRecord;
     this->setState(rhs.getState());
     this->_pContent = std::move(rhs._pContent);
     this->_pRendererResources = rhs._pRendererResources;
+    this->_pUpsampledChildren = std::move(rhs._pUpsampledChildren);
     this->_lastSelectionState = rhs._lastSelectionState;
   }
 
@@ -100,6 +112,10 @@ void Tile::createChildTiles(std::vector<Tile>&& children) {
   this->_children = std::move(children);
 }
 
+void Tile::destroyChildTiles() noexcept {
+  this->_children = std::vector<Tile>();
+}
+
 double Tile::getNonZeroGeometricError() const noexcept {
   double geometricError = this->getGeometricError();
   if (geometricError > Math::EPSILON5) {
@@ -316,6 +332,12 @@ void Tile::loadContent() {
     return;
   }
 
+  // Whether an implicit tile has content isn't known until its subtree has
+  // loaded, so try again later.
+  if (!loadTileSubtree(*this)) {
+    return;
+  }
+
   this->setState(LoadState::ContentLoading);
 
   Tileset& tileset = *this->getTileset();
@@ -441,6 +463,14 @@ void Tile::loadContent() {
                         loadInput.tileContentBoundingVolume,
                         loadInput.tileBoundingVolume,
                         std::move(projections));
+
+                    if (loadInput.contentOptions.createFeatureIndex &&
+                        pContent->model) {
+                      pContent->featureIndex = FeatureIndex::create(
+                          *pContent->model,
+                          loadInput.tileTransform,
+                          loadInput.contentOptions.indexedFeatureProperties);
+                    }
                   }
 
                   return LoadResult{
@@ -510,6 +540,7 @@ bool Tile::unloadContent() noexcept {
 
   this->_pRendererResources = nullptr;
   this->_pContent.reset();
+  this->_pUpsampledChildren.reset();
   this->_rasterTiles.clear();
 
   return true;
@@ -738,6 +769,10 @@ void Tile::update(
     int32_t /*currentFrameNumber*/) {
   const TilesetExternals& externals = this->getTileset()->getExternals();
 
+  // Create children that were packed when the tileset.json was read, now that
+  // this tile is being traversed.
+  createPackedChildTiles(*this);
+
   if (this->getState() == LoadState::FailedTemporarily) {
     // Check with the TileContext to see if we should retry.
     if (this->_pContext->failedTileCallback) {
@@ -870,6 +905,10 @@ void Tile::update(
     }
   }
 
+  if (this->getContext()->subtreeContext && this->getChildren().empty()) {
+    createSubtreeChildTiles(*this);
+  }
+
   // TODO: if there's no model, we can actually free any existing overlays.
   if (this->getState() == LoadState::Done &&
       this->getTileset()->supportsRasterOverlays() && this->getContent() &&
@@ -942,31 +981,61 @@ void Tile::markPermanentlyFailed() noexcept {
   }
 }
 
-int64_t Tile::computeByteSize() const noexcept {
+static int64_t computeModelByteSize(const CesiumGltf::Model& model) noexcept {
   int64_t bytes = 0;
 
-  const TileContentLoadResult* pContent = this->getContent();
-  if (pContent && pContent->model) {
-    const CesiumGltf::Model& model = pContent->model.value();
+  // Add up the glTF buffers
+  for (const CesiumGltf::Buffer& buffer : model.buffers) {
+    bytes += int64_t(buffer.cesium.data.size());
+  }
 
-    // Add up the glTF buffers
-    for (const CesiumGltf::Buffer& buffer : model.buffers) {
-      bytes += int64_t(buffer.cesium.data.size());
+  // For images loaded from buffers, subtract the buffer size and add
+  // the decoded image size instead.
+  const std::vector<CesiumGltf::BufferView>& bufferViews = model.bufferViews;
+  for (const CesiumGltf::Image& image : model.images) {
+    const int32_t bufferView = image.bufferView;
+    if (bufferView < 0 ||
+        bufferView >= static_cast<int32_t>(bufferViews.size())) {
+      continue;
     }
 
-    // For images loaded from buffers, subtract the buffer size and add
-    // the decoded image size instead.
-    const std::vector<CesiumGltf::BufferView>& bufferViews = model.bufferViews;
-    for (const CesiumGltf::Image& image : model.images) {
-      const int32_t bufferView = image.bufferView;
-      if (bufferView < 0 ||
-          bufferView >= static_cast<int32_t>(bufferViews.size())) {
-        continue;
-      }
+    bytes -= bufferViews[size_t(bufferView)].byteLength;
+    bytes += int64_t(image.cesium.pixelData.size());
+  }
 
-      bytes -= bufferViews[size_t(bufferView)].byteLength;
-      bytes += int64_t(image.cesium.pixelData.size());
-    }
+  return bytes;
+}
+
+/**
+ * @brief The four models upsampled from the content of a tile.
+ *
+ * The first upsampled child to load clips the parent's content for all four
+ * children at once, and each child takes its own model when it loads. The
+ * models that are not taken yet count towards the parent's data bytes.
+ */
+struct UpsampledChildModels {
+  std::once_flag upsampled;
+
+  // Guards the models and the bytes they retain.
+  std::mutex mutex;
+  std::array<std::optional<CesiumGltf::Model>, 4> models;
+  int64_t retainedBytes = 0;
+
+  // The retained bytes that are included in the tileset's data bytes. Only
+  // used in the main thread.
+  int64_t countedBytes = 0;
+};
+
+int64_t Tile::computeByteSize() const noexcept {
+  int64_t bytes = 0;
+
+  const TileContentLoadResult* pContent = this->getContent();
+  if (pContent && pContent->model) {
+    bytes += computeModelByteSize(pContent->model.value());
+  }
+
+  if (this->_pUpsampledChildren) {
+    bytes += this->_pUpsampledChildren->countedBytes;
   }
 
   return bytes;
@@ -976,6 +1045,68 @@ void Tile::setState(LoadState value) noexcept {
   this->_state.store(value, std::memory_order::memory_order_release);
 }
 
+static CesiumGltf::Model takeUpsampledChild(
+    UpsampledChildModels& children,
+    const CesiumGltf::Model& parentModel,
+    const UpsampledQuadtreeNode& childID) {
+  const QuadtreeTileID& tileID = childID.tileID;
+  const size_t quadrant = size_t((tileID.x & 1U) | ((tileID.y & 1U) << 1U));
+
+  // Clip the parent's content without holding the mutex, so that the main
+  // thread is not blocked while it counts the retained bytes.
+  std::call_once(children.upsampled, [&children, &parentModel, &tileID]() {
+    std::array<CesiumGltf::Model, 4> models =
+        upsampleGltfForRasterOverlayChildren(
+            parentModel,
+            QuadtreeTileID(tileID.level - 1, tileID.x >> 1, tileID.y >> 1));
+
+    int64_t bytes = 0;
+    for (const CesiumGltf::Model& model : models) {
+      bytes += computeModelByteSize(model);
+    }
+
+    std::lock_guard<std::mutex> lock(children.mutex);
+    for (size_t i = 0; i < models.size(); ++i) {
+      children.models[i] = std::move(models[i]);
+    }
+    children.retainedBytes = bytes;
+  });
+
+  {
+    std::lock_guard<std::mutex> lock(children.mutex);
+    std::optional<CesiumGltf::Model>& model = children.models[quadrant];
+    if (model) {
+      children.retainedBytes -= computeModelByteSize(*model);
+      CesiumGltf::Model result = std::move(*model);
+      model.reset();
+      return result;
+    }
+  }
+
+  // The child already took its model once and is now loading again.
+  return upsampleGltfForRasterOverlays(parentModel, childID);
+}
+
+/**
+ * @brief Updates the tileset's data bytes to include the models that are
+ * currently retained for the upsampled children of a tile.
+ *
+ * Called in the main thread whenever an upsampled child has finished loading,
+ * which may have created or taken retained models.
+ */
+static void countUpsampledChildBytes(
+    Tileset& tileset,
+    UpsampledChildModels& children) noexcept {
+  int64_t retainedBytes = 0;
+  {
+    std::lock_guard<std::mutex> lock(children.mutex);
+    retainedBytes = children.retainedBytes;
+  }
+
+  tileset.notifyTileDataBytesChanged(retainedBytes - children.countedBytes);
+  children.countedBytes = retainedBytes;
+}
+
 void Tile::upsampleParent(
     std::vector<CesiumGeospatial::Projection>&& projections) {
   Tile* pParent = this->getParent();
@@ -994,6 +1125,12 @@ void Tile::upsampleParent(
 
   CesiumGltf::Model& parentModel = pParentContent->model.value();
 
+  if (!pParent->_pUpsampledChildren) {
+    pParent->_pUpsampledChildren = std::make_shared<UpsampledChildModels>();
+  }
+  std::shared_ptr<UpsampledChildModels> pUpsampledChildren =
+      pParent->_pUpsampledChildren;
+
   Tileset* pTileset = this->getTileset();
   pTileset->notifyTileStartLoading(this);
 
@@ -1006,6 +1143,7 @@ void Tile::upsampleParent(
   pTileset->getAsyncSystem()
       .runInWorkerThread(
           [&parentModel,
+           pUpsampledChildren,
            transform = this->getTransform(),
            projections = std::move(projections),
            pSubdividedParentID,
@@ -1019,7 +1157,8 @@ void Tile::upsampleParent(
                pTileset->getExternals().pPrepareRendererResources]() mutable {
             std::unique_ptr<TileContentLoadResult> pContent =
                 std::make_unique<TileContentLoadResult>();
-            pContent->model = upsampleGltfForRasterOverlays(
+            pContent->model = takeUpsampledChild(
+                *pUpsampledChildren,
                 parentModel,
                 *pSubdividedParentID);
 
@@ -1044,13 +1183,17 @@ void Tile::upsampleParent(
                 std::move(pContent),
                 pRendererResources};
           })
-      .thenInMainThread([this](LoadResult&& loadResult) noexcept {
+      .thenInMainThread([this, pUpsampledChildren](
+                            LoadResult&& loadResult) noexcept {
+        countUpsampledChildBytes(*this->getTileset(), *pUpsampledChildren);
         this->_pContent = std::move(loadResult.pContent);
         this->_pRendererResources = loadResult.pRendererResources;
         this->getTileset()->notifyTileDoneLoading(this);
         this->setState(loadResult.state);
       })
-      .catchInMainThread([this](const std::exception& /*e*/) noexcept {
+      .catchInMainThread([this, pUpsampledChildren](
+                             const std::exception& /*e*/) noexcept {
+        countUpsampledChildBytes(*this->getTileset(), *pUpsampledChildren);
         this->_pContent.reset();
         this->_pRendererResources = nullptr;
         this->getTileset()->notifyTileDoneLoading(this);
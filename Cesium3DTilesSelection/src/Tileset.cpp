@@ -7,8 +7,10 @@
 #include "Cesium3DTilesSelection/RasterizedPolygonsOverlay.h"
 #include "Cesium3DTilesSelection/TileID.h"
 #include "Cesium3DTilesSelection/spdlog-cesium.h"
+#include "SubtreeTiling.h"
 #include "TileUtilities.h"
 #include "calcQuadtreeMaxGeometricError.h"
+#include "readTilesetJson.h"
 
 #include <CesiumAsync/AsyncSystem.h>
 #include <CesiumAsync/IAssetAccessor.h>
@@ -23,6 +25,7 @@
 #include <CesiumUtility/Math.h>
 #include <CesiumUtility/Tracing.h>
 #include <CesiumUtility/Uri.h>
+#include <CesiumUtility/joinToString.h>
 
 #include <glm/common.hpp>
 #include <rapidjson/document.h>
@@ -446,6 +449,10 @@ void Tileset::notifyTileUnloading(Tile* pTile) noexcept {
   }
 }
 
+void Tileset::notifyTileDataBytesChanged(int64_t bytes) noexcept {
+  this->_tileDataBytes += bytes;
+}
+
 void Tileset::loadTilesFromJson(
     Tile& rootTile,
     const rapidjson::Value& tilesetJson,
@@ -491,6 +498,20 @@ void Tileset::forEachLoadedTile(
   }
 }
 
+void Tileset::forEachLoadedFeatureIndex(
+    const std::function<void(const Tile& tile, const FeatureIndex& index)>&
+        callback) const {
+  const Tile* pCurrent = this->_loadedTiles.head();
+  while (pCurrent) {
+    const Tile* pNext = this->_loadedTiles.next(pCurrent);
+    const TileContentLoadResult* pContent = pCurrent->getContent();
+    if (pContent && pContent->featureIndex) {
+      callback(*pCurrent, *pContent->featureIndex);
+    }
+    pCurrent = pNext;
+  }
+}
+
 int64_t Tileset::getTotalDataBytes() const noexcept {
   int64_t bytes = this->_tileDataBytes;
 
@@ -520,13 +541,13 @@ Future<void> Tileset::_loadTilesetJson(
       .thenInWorkerThread(
           [pLogger = this->_externals.pLogger,
            pContext = std::move(pContext),
-           useWaterMask = this->getOptions().contentOptions.enableWaterMask](
+           contentOptions = this->getOptions().contentOptions](
               std::shared_ptr<IAssetRequest>&& pRequest) mutable {
             return Tileset::_handleTilesetResponse(
                 std::move(pRequest),
                 std::move(pContext),
                 pLogger,
-                useWaterMask);
+                contentOptions);
           })
       .thenInMainThread([this](LoadResult&& loadResult) {
         this->_supportsRasterOverlays = loadResult.supportsRasterOverlays;
@@ -552,7 +573,7 @@ namespace {
  * @brief Obtains the up-axis that should be used for glTF content of the
  * tileset.
  *
- * If the given tileset JSON does not contain an `asset.gltfUpAxis` string
+ * If the tileset JSON does not contain an `asset.gltfUpAxis` string
  * property, then the default value of CesiumGeometry::Axis::Y is returned.
  *
  * Otherwise, a warning is printed, saying that the `gltfUpAxis` property is
@@ -562,17 +583,12 @@ namespace {
  * CesiumGeometry::Axis::Y, or CesiumGeometry::Axis::Z to be returned,
  * respectively.
  *
- * @param tileset The tileset JSON
+ * @param gltfUpAxis The value of the `asset.gltfUpAxis` property, if any
  * @return The up-axis to use for glTF content
  */
-CesiumGeometry::Axis obtainGltfUpAxis(const rapidjson::Document& tileset) {
-  const auto assetIt = tileset.FindMember("asset");
-  if (assetIt == tileset.MemberEnd()) {
-    return CesiumGeometry::Axis::Y;
-  }
-  const rapidjson::Value& assetJson = assetIt->value;
-  const auto gltfUpAxisIt = assetJson.FindMember("gltfUpAxis");
-  if (gltfUpAxisIt == assetJson.MemberEnd()) {
+CesiumGeometry::Axis
+obtainGltfUpAxis(const std::optional<std::string>& gltfUpAxis) {
+  if (!gltfUpAxis) {
     return CesiumGeometry::Axis::Y;
   }
 
@@ -580,8 +596,7 @@ CesiumGeometry::Axis obtainGltfUpAxis(const rapidjson::Document& tileset) {
               "This property is not part of the specification. "
               "All glTF content should use the Y-axis as the up-axis.");
 
-  const rapidjson::Value& gltfUpAxisJson = gltfUpAxisIt->value;
-  auto gltfUpAxisString = std::string(gltfUpAxisJson.GetString());
+  const std::string& gltfUpAxisString = *gltfUpAxis;
   if (gltfUpAxisString == "X" || gltfUpAxisString == "x") {
     return CesiumGeometry::Axis::X;
   }
@@ -600,7 +615,7 @@ CesiumGeometry::Axis obtainGltfUpAxis(const rapidjson::Document& tileset) {
     std::shared_ptr<IAssetRequest>&& pRequest,
     std::unique_ptr<TileContext>&& pContext,
     const std::shared_ptr<spdlog::logger>& pLogger,
-    bool useWaterMask) {
+    const TilesetContentOptions& contentOptions) {
   const IAssetResponse* pResponse = pRequest->response();
   if (!pResponse) {
     SPDLOG_LOGGER_ERROR(
@@ -624,47 +639,49 @@ CesiumGeometry::Axis obtainGltfUpAxis(const rapidjson::Document& tileset) {
 
   const gsl::span<const std::byte> data = pResponse->data();
 
-  rapidjson::Document tileset;
-  tileset.Parse(reinterpret_cast<const char*>(data.data()), data.size());
+  std::unique_ptr<Tile> pRootTile = std::make_unique<Tile>();
+  pRootTile->setContext(pContext.get());
 
-  if (tileset.HasParseError()) {
+  CesiumJsonReader::ReadJsonResult<TilesetJson> tilesetResult =
+      readTilesetJsonWithCache(
+          pRequest->url(),
+          pResponse->headers(),
+          data,
+          *pRootTile,
+          glm::dmat4(1.0),
+          TileRefine::Replace,
+          *pContext,
+          pLogger,
+          contentOptions.createChildTilesLazily,
+          contentOptions.pTilesetJsonCache.get());
+
+  if (!tilesetResult.value) {
     SPDLOG_LOGGER_ERROR(
         pLogger,
-        "Error when parsing tileset JSON, error code {} at byte offset {}",
-        tileset.GetParseError(),
-        tileset.GetErrorOffset());
+        "Error when parsing tileset JSON: {}",
+        CesiumUtility::joinToString(tilesetResult.errors, "\n- "));
     return LoadResult{std::move(pContext), nullptr, false};
   }
 
-  pContext->pTileset->_gltfUpAxis = obtainGltfUpAxis(tileset);
-
-  std::unique_ptr<Tile> pRootTile = std::make_unique<Tile>();
-  pRootTile->setContext(pContext.get());
+  const TilesetJson& tileset = *tilesetResult.value;
 
-  const auto rootIt = tileset.FindMember("root");
-  const auto formatIt = tileset.FindMember("format");
+  pContext->pTileset->_gltfUpAxis = obtainGltfUpAxis(tileset.gltfUpAxis);
 
   bool supportsRasterOverlays = false;
 
-  if (rootIt != tileset.MemberEnd()) {
-    const rapidjson::Value& rootJson = rootIt->value;
-    Tileset::_createTile(
-        *pRootTile,
-        rootJson,
-        glm::dmat4(1.0),
-        TileRefine::Replace,
-        *pContext,
-        pLogger);
+  if (tileset.hasRoot) {
     supportsRasterOverlays = true;
-  } else if (
-      formatIt != tileset.MemberEnd() && formatIt->value.IsString() &&
-      std::string(formatIt->value.GetString()) == "quantized-mesh-1.0") {
+  } else if (tileset.format && *tileset.format == "quantized-mesh-1.0") {
+    // A layer.json is small and its availability is read from a document, so
+    // it is parsed again here.
+    rapidjson::Document layerJson;
+    layerJson.Parse(reinterpret_cast<const char*>(data.data()), data.size());
     Tileset::_createTerrainTile(
         *pRootTile,
-        tileset,
+        layerJson,
         *pContext,
         pLogger,
-        useWaterMask);
+        contentOptions.enableWaterMask);
     supportsRasterOverlays = true;
   }
 
@@ -1910,12 +1927,56 @@ void Tileset::_unloadCachedTiles() noexcept {
     const bool removed = pTile->unloadContent();
     if (removed) {
       this->_loadedTiles.remove(*pTile);
+      this->_destroyUnusedPackedChildTiles(pTile->getParent());
     }
 
     pTile = pNext;
   }
 }
 
+void Tileset::_destroyUnusedPackedChildTiles(Tile* pTile) noexcept {
+  // Children that were created from packed tiles can be destroyed, and created
+  // again when they're next needed, once none of them are in use. Destroying
+  // a tile's children may leave its parent's children unused in turn.
+  while (pTile && pTile->getPackedTileRecord() &&
+         !pTile->getChildren().empty()) {
+    for (const Tile& child : pTile->getChildren()) {
+      if (!this->_isTileUnused(child)) {
+        return;
+      }
+    }
+
+    pTile->destroyChildTiles();
+    pTile = pTile->getParent();
+  }
+}
+
+bool Tileset::_isTileUnused(const Tile& tile) const noexcept {
+  // A tile is in use if it's loaded, was visited recently enough to be in
+  // the loaded tiles list, or was selected in the previous or current frame,
+  // in which case the renderer may still refer to it.
+  if (tile.getState() != Tile::LoadState::Unloaded ||
+      this->_loadedTiles.contains(tile) ||
+      tile.getLastSelectionState().getFrameNumber() >=
+          this->_previousFrameNumber) {
+    return false;
+  }
+
+  // Children that were not created from packed tiles, such as the root of an
+  // external tileset, can't be created again the same way, so they're kept.
+  if (!tile.getChildren().empty() && !tile.getPackedTileRecord()) {
+    return false;
+  }
+
+  for (const Tile& child : tile.getChildren()) {
+    if (!this->_isTileUnused(child)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
 void Tileset::_markTileVisited(Tile& tile) noexcept {
   this->_loadedTiles.insertAtTail(tile);
 }
@@ -1927,6 +1988,12 @@ std::string Tileset::getResolvedContentUrl(const Tile& tile) const {
     std::string operator()(const std::string& url) { return url; }
 
     std::string operator()(const QuadtreeTileID& quadtreeID) {
+      if (this->context.subtreeContext) {
+        return getSubtreeTileContentUrl(
+            *this->context.subtreeContext,
+            OctreeTileID(quadtreeID.level, quadtreeID.x, quadtreeID.y, 0));
+      }
+
       if (!this->context.implicitContext) {
         return std::string();
       }
@@ -1952,6 +2019,12 @@ std::string Tileset::getResolvedContentUrl(const Tile& tile) const {
     }
 
     std::string operator()(const OctreeTileID& octreeID) {
+      if (this->context.subtreeContext) {
+        return getSubtreeTileContentUrl(
+            *this->context.subtreeContext,
+            octreeID);
+      }
+
       if (!this->context.implicitContext) {
         return std::string();
       }
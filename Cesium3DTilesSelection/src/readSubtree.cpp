@@ -0,0 +1,301 @@
+#include "readSubtree.h"
+
+#include <CesiumUtility/JsonHelpers.h>
+
+#include <rapidjson/document.h>
+
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace CesiumJsonReader;
+using namespace CesiumUtility;
+
+namespace Cesium3DTilesSelection {
+
+namespace {
+
+struct SubtreeHeader {
+  unsigned char magic[4];
+  uint32_t version;
+  uint64_t jsonByteLength;
+  uint64_t binaryByteLength;
+};
+
+struct BufferViewRange {
+  size_t byteOffset = 0;
+  size_t byteLength = 0;
+};
+
+/**
+ * @brief Reads the availability object with the given name, which must
+ * describe at least the given number of items.
+ */
+std::optional<SubtreeAvailability::AvailabilityView> readAvailability(
+    const rapidjson::Value& availability,
+    const std::string& name,
+    const std::vector<BufferViewRange>& bufferViews,
+    uint64_t itemCount,
+    std::vector<std::string>& errors) {
+  if (!availability.IsObject()) {
+    errors.emplace_back("Subtree " + name + " is not an object.");
+    return std::nullopt;
+  }
+
+  SubtreeAvailability::AvailabilityView result;
+
+  auto bitstreamIt = availability.FindMember("bitstream");
+  if (bitstreamIt == availability.MemberEnd()) {
+    bitstreamIt = availability.FindMember("bufferView");
+  }
+
+  if (bitstreamIt == availability.MemberEnd()) {
+    const auto constantIt = availability.FindMember("constant");
+    if (constantIt == availability.MemberEnd() ||
+        !constantIt->value.IsNumber()) {
+      errors.emplace_back(
+          "Subtree " + name + " has neither a bitstream nor a constant.");
+      return std::nullopt;
+    }
+
+    result.constant = constantIt->value.GetDouble() != 0.0;
+    return result;
+  }
+
+  const int64_t bufferViewIndex =
+      JsonHelpers::getInt64OrDefault(bitstreamIt->value, -1);
+  if (bufferViewIndex < 0 ||
+      size_t(bufferViewIndex) >= bufferViews.size()) {
+    errors.emplace_back(
+        "Subtree " + name + " refers to an invalid buffer view " +
+        std::to_string(bufferViewIndex) + ".");
+    return std::nullopt;
+  }
+
+  const BufferViewRange& bufferView = bufferViews[size_t(bufferViewIndex)];
+  const uint64_t requiredByteLength = (itemCount + 7) / 8;
+  if (bufferView.byteLength < requiredByteLength) {
+    errors.emplace_back(
+        "Subtree " + name + " bitstream has " +
+        std::to_string(bufferView.byteLength) + " bytes, but " +
+        std::to_string(requiredByteLength) + " bytes are required.");
+    return std::nullopt;
+  }
+
+  result.byteOffset = bufferView.byteOffset;
+  result.byteLength = bufferView.byteLength;
+  return result;
+}
+
+} // namespace
+
+ReadJsonResult<SubtreeAvailability> readSubtree(
+    const gsl::span<const std::byte>& data,
+    ImplicitTilingSubdivisionScheme subdivisionScheme,
+    uint32_t subtreeLevels) {
+  ReadJsonResult<SubtreeAvailability> result;
+
+  const uint32_t bitsPerLevel =
+      subdivisionScheme == ImplicitTilingSubdivisionScheme::Quadtree ? 2 : 3;
+  if (subtreeLevels == 0 || uint64_t(subtreeLevels) * bitsPerLevel >= 64) {
+    result.errors.emplace_back(
+        "Subtrees with " + std::to_string(subtreeLevels) +
+        " levels are not supported.");
+    return result;
+  }
+
+  // The number of tiles in the subtree, and the number of tiles in the level
+  // below it, each of which may be the root of a child subtree.
+  const uint64_t childSubtreeCount = uint64_t(1)
+                                     << (bitsPerLevel * subtreeLevels);
+  const uint64_t tileCount =
+      (childSubtreeCount - 1) / ((uint64_t(1) << bitsPerLevel) - 1);
+
+  gsl::span<const std::byte> jsonChunk = data;
+  gsl::span<const std::byte> binaryChunk;
+
+  if (data.size() >= 4 && data[0] == std::byte('s') &&
+      data[1] == std::byte('u') && data[2] == std::byte('b') &&
+      data[3] == std::byte('t')) {
+    if (data.size() < sizeof(SubtreeHeader)) {
+      result.errors.emplace_back("The subtree is invalid because it is too "
+                                 "small to include a subtree header.");
+      return result;
+    }
+
+    const SubtreeHeader* pHeader =
+        reinterpret_cast<const SubtreeHeader*>(data.data());
+    if (pHeader->version != 1) {
+      result.errors.emplace_back(
+          "The subtree has an unsupported version " +
+          std::to_string(pHeader->version) + ".");
+      return result;
+    }
+
+    const uint64_t available = data.size() - sizeof(SubtreeHeader);
+    if (pHeader->jsonByteLength > available ||
+        pHeader->binaryByteLength > available - pHeader->jsonByteLength) {
+      result.errors.emplace_back("The subtree is invalid because its JSON and "
+                                 "binary chunks extend past the end of the "
+                                 "data.");
+      return result;
+    }
+
+    jsonChunk = data.subspan(
+        sizeof(SubtreeHeader),
+        size_t(pHeader->jsonByteLength));
+    binaryChunk = data.subspan(
+        sizeof(SubtreeHeader) + size_t(pHeader->jsonByteLength),
+        size_t(pHeader->binaryByteLength));
+  }
+
+  rapidjson::Document document;
+  document.Parse(
+      reinterpret_cast<const char*>(jsonChunk.data()),
+      jsonChunk.size());
+  if (document.HasParseError()) {
+    result.errors.emplace_back(
+        "Error when parsing subtree JSON, error code " +
+        std::to_string(document.GetParseError()) + " at byte offset " +
+        std::to_string(document.GetErrorOffset()));
+    return result;
+  }
+
+  if (!document.IsObject()) {
+    result.errors.emplace_back("The subtree JSON is not an object.");
+    return result;
+  }
+
+  // Only a buffer without a URI, which is the binary chunk, can be used.
+  std::vector<bool> isBinaryChunk;
+  const auto buffersIt = document.FindMember("buffers");
+  if (buffersIt != document.MemberEnd() && buffersIt->value.IsArray()) {
+    for (const rapidjson::Value& buffer : buffersIt->value.GetArray()) {
+      isBinaryChunk.emplace_back(
+          buffer.IsObject() && !buffer.HasMember("uri") &&
+          JsonHelpers::getUint64OrDefault(buffer, "byteLength", 0) <=
+              binaryChunk.size());
+    }
+  }
+
+  std::vector<BufferViewRange> bufferViews;
+  const auto bufferViewsIt = document.FindMember("bufferViews");
+  if (bufferViewsIt != document.MemberEnd() && bufferViewsIt->value.IsArray()) {
+    for (const rapidjson::Value& bufferView :
+         bufferViewsIt->value.GetArray()) {
+      const int64_t buffer =
+          JsonHelpers::getInt64OrDefault(bufferView, "buffer", -1);
+      const uint64_t byteOffset =
+          JsonHelpers::getUint64OrDefault(bufferView, "byteOffset", 0);
+      const uint64_t byteLength =
+          JsonHelpers::getUint64OrDefault(bufferView, "byteLength", 0);
+
+      if (buffer < 0 || size_t(buffer) >= isBinaryChunk.size()) {
+        result.errors.emplace_back(
+            "A subtree buffer view refers to an invalid buffer " +
+            std::to_string(buffer) + ".");
+        return result;
+      }
+
+      if (!isBinaryChunk[size_t(buffer)]) {
+        result.errors.emplace_back(
+            "A subtree buffer view refers to an external buffer, which is "
+            "not supported.");
+        return result;
+      }
+
+      if (byteOffset > binaryChunk.size() ||
+          byteLength > binaryChunk.size() - byteOffset) {
+        result.errors.emplace_back(
+            "A subtree buffer view extends past the end of its buffer.");
+        return result;
+      }
+
+      bufferViews.push_back(
+          BufferViewRange{size_t(byteOffset), size_t(byteLength)});
+    }
+  }
+
+  const auto tileAvailabilityIt = document.FindMember("tileAvailability");
+  if (tileAvailabilityIt == document.MemberEnd()) {
+    result.errors.emplace_back("The subtree does not have tileAvailability.");
+    return result;
+  }
+
+  std::optional<SubtreeAvailability::AvailabilityView> tileAvailability =
+      readAvailability(
+          tileAvailabilityIt->value,
+          "tileAvailability",
+          bufferViews,
+          tileCount,
+          result.errors);
+  if (!tileAvailability) {
+    return result;
+  }
+
+  const auto childSubtreeAvailabilityIt =
+      document.FindMember("childSubtreeAvailability");
+  if (childSubtreeAvailabilityIt == document.MemberEnd()) {
+    result.errors.emplace_back(
+        "The subtree does not have childSubtreeAvailability.");
+    return result;
+  }
+
+  std::optional<SubtreeAvailability::AvailabilityView>
+      childSubtreeAvailability = readAvailability(
+          childSubtreeAvailabilityIt->value,
+          "childSubtreeAvailability",
+          bufferViews,
+          childSubtreeCount,
+          result.errors);
+  if (!childSubtreeAvailability) {
+    return result;
+  }
+
+  // A tile without content availability has no content.
+  std::vector<SubtreeAvailability::AvailabilityView> contentAvailability;
+  const auto contentAvailabilityIt = document.FindMember("contentAvailability");
+  if (contentAvailabilityIt != document.MemberEnd()) {
+    const rapidjson::Value& value = contentAvailabilityIt->value;
+    if (value.IsArray()) {
+      for (const rapidjson::Value& content : value.GetArray()) {
+        std::optional<SubtreeAvailability::AvailabilityView> availability =
+            readAvailability(
+                content,
+                "contentAvailability",
+                bufferViews,
+                tileCount,
+                result.errors);
+        if (!availability) {
+          return result;
+        }
+        contentAvailability.emplace_back(*availability);
+      }
+    } else {
+      std::optional<SubtreeAvailability::AvailabilityView> availability =
+          readAvailability(
+              value,
+              "contentAvailability",
+              bufferViews,
+              tileCount,
+              result.errors);
+      if (!availability) {
+        return result;
+      }
+      contentAvailability.emplace_back(*availability);
+    }
+  }
+
+  result.value.emplace(
+      subdivisionScheme,
+      subtreeLevels,
+      std::vector<std::byte>(binaryChunk.begin(), binaryChunk.end()),
+      *tileAvailability,
+      std::move(contentAvailability),
+      *childSubtreeAvailability);
+
+  return result;
+}
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Cesium3DTilesSelection/SubtreeAvailability.h"
+
+#include <CesiumJsonReader/JsonReader.h>
+
+#include <gsl/span>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief Reads the availability of a subtree of a 3D Tiles implicit tileset.
+ *
+ * The subtree may be either a binary `.subtree` file or the JSON of one.
+ * Its bitstreams must be in its binary chunk; buffers with a `uri` are not
+ * supported.
+ *
+ * Both the `bitstream` properties and `contentAvailability` array of 3D Tiles
+ * 1.1 and the `bufferView` properties and `contentAvailability` object of the
+ * `3DTILES_implicit_tiling` extension are accepted.
+ *
+ * @param data The subtree.
+ * @param subdivisionScheme How the tiles of the implicit tileset are divided.
+ * @param subtreeLevels The number of levels in each subtree.
+ * @return The result of reading the subtree.
+ */
+CesiumJsonReader::ReadJsonResult<SubtreeAvailability> readSubtree(
+    const gsl::span<const std::byte>& data,
+    ImplicitTilingSubdivisionScheme subdivisionScheme,
+    uint32_t subtreeLevels);
+
+} // namespace Cesium3DTilesSelection
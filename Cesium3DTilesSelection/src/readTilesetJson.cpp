@@ -0,0 +1,2037 @@
+#include "readTilesetJson.h"
+
+#include "Cesium3DTilesSelection/BoundingVolume.h"
+#include "Cesium3DTilesSelection/spdlog-cesium.h"
+
+#include <CesiumAsync/ICacheDatabase.h>
+#include <CesiumGeometry/BoundingSphere.h>
+#include <CesiumGeometry/OrientedBoundingBox.h>
+#include <CesiumGeospatial/BoundingRegion.h>
+#include <CesiumGeospatial/GlobeRectangle.h>
+#include <CesiumGeospatial/S2CellBoundingVolume.h>
+#include <CesiumJsonReader/JsonHandler.h>
+#include <CesiumJsonReader/ObjectJsonHandler.h>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumJsonReader;
+
+namespace Cesium3DTilesSelection {
+
+namespace {
+
+// Tiles are created in the order that their JSON objects start, which is a
+// pre-order traversal of the tile tree. These flags are recorded for each tile
+// in that order, so that the pass that resolves the tiles after reading can
+// find them by walking the tree in the same order.
+//
+// When tiles are packed instead, the flags begin each tile's record.
+enum TileFlags : uint8_t {
+  // The tile's JSON value is an object.
+  TILE_IS_OBJECT = 1,
+
+  // The tile has both a bounding volume and a geometric error.
+  TILE_IS_COMPLETE = 2,
+
+  // The tile specifies its own refinement rather than inheriting it.
+  TILE_HAS_REFINE = 4,
+
+  // The remaining flags are only used in packed tiles.
+  TILE_REFINE_ADD = 8,
+  TILE_HAS_TILE_ID = 16,
+  TILE_HAS_TRANSFORM = 32,
+  TILE_HAS_CONTENT_BOUNDING_VOLUME = 64,
+  TILE_HAS_VIEWER_REQUEST_VOLUME = 128
+};
+
+struct TileReaderState {
+  std::shared_ptr<spdlog::logger> pLogger;
+  std::vector<uint8_t> tileFlags;
+
+  // The buffer into which tiles are packed, or nullptr if Tile objects are
+  // created instead.
+  std::vector<std::byte>* pPackedTiles;
+
+  // The implicit tiling of the tile that uses it, if any.
+  std::optional<SubtreeTilingContext> subtreeContext;
+};
+
+// In a packed tile record, this tile ID length marks the root tile of an
+// implicit tileset, whose ID is created from the context's subdivision scheme
+// rather than read from the record.
+const uint32_t IMPLICIT_ROOT_TILE_ID = 0xFFFFFFFF;
+
+// The binary form of a tileset.json's tiles that is cached starts with this
+// magic and version. The version must change whenever the form of the packed
+// tile records or of the cache changes.
+const char TILESET_CACHE_MAGIC[4] = {'c', 't', 'i', 'l'};
+const uint32_t TILESET_CACHE_VERSION = 1;
+
+// Cached tiles are keyed by the tileset.json's ETag, so they never become
+// stale, but they're allowed to expire so that the tiles of tilesets that are
+// no longer used are eventually pruned.
+const std::time_t TILESET_CACHE_LIFETIME = 30 * 24 * 60 * 60;
+
+/**
+ * @brief Reads a number into an optional, leaving it empty if the value is not
+ * a number.
+ */
+class NumberJsonHandler : public JsonHandler {
+public:
+  void reset(IJsonHandler* pParent, std::optional<double>* pNumber) {
+    JsonHandler::reset(pParent);
+    this->_pNumber = pNumber;
+  }
+
+  virtual IJsonHandler* readInt32(int32_t i) override {
+    return this->set(double(i));
+  }
+
+  virtual IJsonHandler* readUint32(uint32_t i) override {
+    return this->set(double(i));
+  }
+
+  virtual IJsonHandler* readInt64(int64_t i) override {
+    return this->set(double(i));
+  }
+
+  virtual IJsonHandler* readUint64(uint64_t i) override {
+    return this->set(double(i));
+  }
+
+  virtual IJsonHandler* readDouble(double d) override { return this->set(d); }
+
+private:
+  IJsonHandler* set(double value) {
+    *this->_pNumber = value;
+    return this->parent();
+  }
+
+  std::optional<double>* _pNumber = nullptr;
+};
+
+/**
+ * @brief Reads a string into an optional, leaving it empty if the value is not
+ * a string.
+ */
+class OptionalStringJsonHandler : public JsonHandler {
+public:
+  void reset(IJsonHandler* pParent, std::optional<std::string>* pString) {
+    JsonHandler::reset(pParent);
+    this->_pString = pString;
+  }
+
+  virtual IJsonHandler* readString(const std::string_view& str) override {
+    this->_pString->emplace(str);
+    return this->parent();
+  }
+
+private:
+  std::optional<std::string>* _pString = nullptr;
+};
+
+struct NumberArray {
+  /**
+   * @brief The numbers at the start of the array, up to the first element that
+   * is not a number.
+   */
+  std::vector<double> numbers;
+
+  /**
+   * @brief The number of elements in the array, including those that are not
+   * numbers.
+   */
+  size_t size = 0;
+};
+
+/**
+ * @brief Reads the numbers at the start of an array.
+ *
+ * Reading stops at the first element that is not a number, and the remaining
+ * elements are only counted.
+ */
+class NumberArrayJsonHandler : public JsonHandler {
+public:
+  void reset(IJsonHandler* pParent, NumberArray* pArray) {
+    JsonHandler::reset(pParent);
+    this->_pArray = pArray;
+    this->_arrayIsOpen = false;
+    this->_numbersEnded = false;
+  }
+
+  virtual IJsonHandler* readNull() override {
+    if (!this->_arrayIsOpen) {
+      return JsonHandler::readNull();
+    }
+    return this->endNumbers();
+  }
+
+  virtual IJsonHandler* readBool(bool b) override {
+    if (!this->_arrayIsOpen) {
+      return JsonHandler::readBool(b);
+    }
+    return this->endNumbers();
+  }
+
+  virtual IJsonHandler* readInt32(int32_t i) override {
+    if (!this->_arrayIsOpen) {
+      return JsonHandler::readInt32(i);
+    }
+    return this->add(double(i));
+  }
+
+  virtual IJsonHandler* readUint32(uint32_t i) override {
+    if (!this->_arrayIsOpen) {
+      return JsonHandler::readUint32(i);
+    }
+    return this->add(double(i));
+  }
+
+  virtual IJsonHandler* readInt64(int64_t i) override {
+    if (!this->_arrayIsOpen) {
+      return JsonHandler::readInt64(i);
+    }
+    return this->add(double(i));
+  }
+
+  virtual IJsonHandler* readUint64(uint64_t i) override {
+    if (!this->_arrayIsOpen) {
+      return JsonHandler::readUint64(i);
+    }
+    return this->add(double(i));
+  }
+
+  virtual IJsonHandler* readDouble(double d) override {
+    if (!this->_arrayIsOpen) {
+      return JsonHandler::readDouble(d);
+    }
+    return this->add(d);
+  }
+
+  virtual IJsonHandler* readString(const std::string_view& str) override {
+    if (!this->_arrayIsOpen) {
+      return JsonHandler::readString(str);
+    }
+    return this->endNumbers();
+  }
+
+  virtual IJsonHandler* readObjectStart() override {
+    if (!this->_arrayIsOpen) {
+      return JsonHandler::readObjectStart();
+    }
+    this->endNumbers();
+    return this->ignoreAndContinue()->readObjectStart();
+  }
+
+  virtual IJsonHandler* readArrayStart() override {
+    if (this->_arrayIsOpen) {
+      this->endNumbers();
+      return this->ignoreAndContinue()->readArrayStart();
+    }
+
+    this->_arrayIsOpen = true;
+    this->_pArray->numbers.clear();
+    this->_pArray->size = 0;
+    return this;
+  }
+
+  virtual IJsonHandler* readArrayEnd() override { return this->parent(); }
+
+private:
+  IJsonHandler* add(double value) {
+    if (!this->_numbersEnded) {
+      this->_pArray->numbers.emplace_back(value);
+    }
+    ++this->_pArray->size;
+    return this;
+  }
+
+  IJsonHandler* endNumbers() noexcept {
+    this->_numbersEnded = true;
+    ++this->_pArray->size;
+    return this;
+  }
+
+  NumberArray* _pArray = nullptr;
+  bool _arrayIsOpen = false;
+  bool _numbersEnded = false;
+};
+
+struct S2Json {
+  std::optional<std::string> token;
+  std::optional<double> minimumHeight;
+  std::optional<double> maximumHeight;
+};
+
+/**
+ * @brief Reads a `3DTILES_bounding_volume_S2` extension object.
+ */
+class S2JsonHandler : public ObjectJsonHandler {
+public:
+  void reset(IJsonHandler* pParent, std::optional<S2Json>* pS2) {
+    ObjectJsonHandler::reset(pParent);
+    this->_pS2 = pS2;
+  }
+
+  virtual IJsonHandler* readObjectStart() override {
+    this->_pS2->emplace();
+    return ObjectJsonHandler::readObjectStart();
+  }
+
+  virtual IJsonHandler* readObjectKey(const std::string_view& str) override {
+    using namespace std::string_literals;
+
+    S2Json& s2 = this->_pS2->value();
+
+    if ("token"s == str) {
+      this->setCurrentKey("token");
+      this->_string.reset(this, &s2.token);
+      return &this->_string;
+    }
+    if ("minimumHeight"s == str) {
+      this->setCurrentKey("minimumHeight");
+      this->_number.reset(this, &s2.minimumHeight);
+      return &this->_number;
+    }
+    if ("maximumHeight"s == str) {
+      this->setCurrentKey("maximumHeight");
+      this->_number.reset(this, &s2.maximumHeight);
+      return &this->_number;
+    }
+
+    return this->ignoreAndContinue();
+  }
+
+private:
+  std::optional<S2Json>* _pS2 = nullptr;
+  OptionalStringJsonHandler _string;
+  NumberJsonHandler _number;
+};
+
+/**
+ * @brief Reads the `extensions` of a bounding volume, of which only
+ * `3DTILES_bounding_volume_S2` is supported.
+ */
+class BoundingVolumeExtensionsJsonHandler : public ObjectJsonHandler {
+public:
+  void reset(IJsonHandler* pParent, std::optional<S2Json>* pS2) {
+    ObjectJsonHandler::reset(pParent);
+    this->_pS2 = pS2;
+  }
+
+  virtual IJsonHandler* readObjectKey(const std::string_view& str) override {
+    using namespace std::string_literals;
+
+    if ("3DTILES_bounding_volume_S2"s == str) {
+      this->setCurrentKey("3DTILES_bounding_volume_S2");
+      this->_s2.reset(this, this->_pS2);
+      return &this->_s2;
+    }
+
+    return this->ignoreAndContinue();
+  }
+
+private:
+  std::optional<S2Json>* _pS2 = nullptr;
+  S2JsonHandler _s2;
+};
+
+/**
+ * @brief The definition of a bounding volume, from which the bounding volume
+ * can be created when it is needed.
+ */
+struct BoundingVolumeJson {
+  enum class Type : uint8_t { None, S2, Box, Region, Sphere };
+
+  Type type = Type::None;
+
+  // The S2 cell of an S2 bounding volume.
+  uint64_t s2CellID = 0;
+
+  // The numbers of the volume, as in the JSON. For an S2 bounding volume,
+  // these are the minimum and maximum heights.
+  std::array<double, 12> values{};
+
+  size_t getValueCount() const noexcept {
+    switch (this->type) {
+    case Type::S2:
+      return 2;
+    case Type::Box:
+      return 12;
+    case Type::Region:
+      return 6;
+    case Type::Sphere:
+      return 4;
+    case Type::None:
+    default:
+      return 0;
+    }
+  }
+};
+
+/**
+ * @brief Creates a bounding volume from its definition, which must not have
+ * the type `None`.
+ */
+BoundingVolume createBoundingVolume(const BoundingVolumeJson& json) {
+  const std::array<double, 12>& a = json.values;
+
+  switch (json.type) {
+  case BoundingVolumeJson::Type::S2:
+    return S2CellBoundingVolume(S2CellID(json.s2CellID), a[0], a[1]);
+  case BoundingVolumeJson::Type::Box:
+    return OrientedBoundingBox(
+        glm::dvec3(a[0], a[1], a[2]),
+        glm::dmat3(a[3], a[4], a[5], a[6], a[7], a[8], a[9], a[10], a[11]));
+  case BoundingVolumeJson::Type::Region:
+    return BoundingRegion(GlobeRectangle(a[0], a[1], a[2], a[3]), a[4], a[5]);
+  case BoundingVolumeJson::Type::Sphere:
+  case BoundingVolumeJson::Type::None:
+  default:
+    return BoundingSphere(glm::dvec3(a[0], a[1], a[2]), a[3]);
+  }
+}
+
+template <typename T>
+void writePacked(std::vector<std::byte>& packed, const T& value) {
+  const size_t offset = packed.size();
+  packed.resize(offset + sizeof(T));
+  std::memcpy(packed.data() + offset, &value, sizeof(T));
+}
+
+void writePackedBoundingVolume(
+    std::vector<std::byte>& packed,
+    const BoundingVolumeJson& boundingVolume) {
+  writePacked(packed, boundingVolume.type);
+  if (boundingVolume.type == BoundingVolumeJson::Type::S2) {
+    writePacked(packed, boundingVolume.s2CellID);
+  }
+
+  const size_t count = boundingVolume.getValueCount();
+  for (size_t i = 0; i < count; ++i) {
+    writePacked(packed, boundingVolume.values[i]);
+  }
+}
+
+/**
+ * @brief Reads the fields of a packed tile record in order, and notes if any
+ * of them extend past the end of the packed tiles or are malformed.
+ *
+ * Values that cannot be read are returned as zero, so a malformed record,
+ * such as one from a corrupt cache entry, never causes a read out of bounds.
+ */
+class PackedTileReader {
+public:
+  PackedTileReader(const std::vector<std::byte>& packed, uint64_t offset)
+      : _packed(packed),
+        _offset(offset <= packed.size() ? size_t(offset) : packed.size()),
+        _isValid(offset <= packed.size()) {}
+
+  bool isValid() const noexcept { return this->_isValid; }
+
+  template <typename T> T read() noexcept {
+    T value{};
+    if (this->skip(sizeof(T))) {
+      std::memcpy(
+          &value,
+          this->_packed.data() + this->_offset - sizeof(T),
+          sizeof(T));
+    }
+    return value;
+  }
+
+  std::string readString(size_t length) {
+    if (!this->skip(length)) {
+      return std::string();
+    }
+    return std::string(
+        reinterpret_cast<const char*>(
+            this->_packed.data() + this->_offset - length),
+        length);
+  }
+
+  BoundingVolumeJson readBoundingVolume() noexcept {
+    BoundingVolumeJson result;
+    result.type = this->read<BoundingVolumeJson::Type>();
+    if (result.type == BoundingVolumeJson::Type::None ||
+        result.type > BoundingVolumeJson::Type::Sphere) {
+      this->_isValid = false;
+      result.type = BoundingVolumeJson::Type::None;
+      return result;
+    }
+
+    if (result.type == BoundingVolumeJson::Type::S2) {
+      result.s2CellID = this->read<uint64_t>();
+    }
+
+    const size_t count = result.getValueCount();
+    for (size_t i = 0; i < count; ++i) {
+      result.values[i] = this->read<double>();
+    }
+
+    return result;
+  }
+
+  bool skip(size_t bytes) noexcept {
+    if (!this->_isValid || bytes > this->_packed.size() - this->_offset) {
+      this->_isValid = false;
+      return false;
+    }
+
+    this->_offset += bytes;
+    return true;
+  }
+
+  size_t getRemainingBytes() const noexcept {
+    return this->_isValid ? this->_packed.size() - this->_offset : 0;
+  }
+
+private:
+  const std::vector<std::byte>& _packed;
+  size_t _offset;
+  bool _isValid;
+};
+
+/**
+ * @brief Reads a bounding volume object, such as a tile's `boundingVolume`.
+ *
+ * When the object ends, the bounding volume is defined by the first valid one
+ * of the S2 extension, `box`, `region`, and `sphere`, in that order. If there
+ * is none, or the value is not an object, the result is left with the type
+ * `None`.
+ */
+class BoundingVolumeJsonHandler : public ObjectJsonHandler {
+public:
+  void reset(IJsonHandler* pParent, BoundingVolumeJson* pBoundingVolume) {
+    ObjectJsonHandler::reset(pParent);
+    this->_pBoundingVolume = pBoundingVolume;
+    this->_s2.reset();
+    this->_box = NumberArray();
+    this->_region = NumberArray();
+    this->_sphere = NumberArray();
+  }
+
+  virtual IJsonHandler* readObjectKey(const std::string_view& str) override {
+    using namespace std::string_literals;
+
+    if ("box"s == str) {
+      return this->numbers("box", this->_box);
+    }
+    if ("region"s == str) {
+      return this->numbers("region", this->_region);
+    }
+    if ("sphere"s == str) {
+      return this->numbers("sphere", this->_sphere);
+    }
+    if ("extensions"s == str) {
+      this->setCurrentKey("extensions");
+      this->_extensions.reset(this, &this->_s2);
+      return &this->_extensions;
+    }
+
+    return this->ignoreAndContinue();
+  }
+
+  virtual IJsonHandler* readObjectEnd() override {
+    *this->_pBoundingVolume = this->defineBoundingVolume();
+    return ObjectJsonHandler::readObjectEnd();
+  }
+
+private:
+  IJsonHandler* numbers(const char* key, NumberArray& numbers) {
+    this->setCurrentKey(key);
+    this->_numbers.reset(this, &numbers);
+    return &this->_numbers;
+  }
+
+  BoundingVolumeJson defineBoundingVolume() const {
+    BoundingVolumeJson result;
+
+    if (this->_s2) {
+      result.type = BoundingVolumeJson::Type::S2;
+      result.s2CellID =
+          S2CellID::fromToken(this->_s2->token.value_or("1")).getID();
+      result.values[0] = this->_s2->minimumHeight.value_or(0.0);
+      result.values[1] = this->_s2->maximumHeight.value_or(0.0);
+      return result;
+    }
+
+    // As with a parsed document, the first of these arrays that is large
+    // enough determines the bounding volume, and it is invalid if any of its
+    // elements that are used are not numbers.
+    if (this->_box.size >= 12) {
+      return define(BoundingVolumeJson::Type::Box, this->_box);
+    }
+    if (this->_region.size >= 6) {
+      return define(BoundingVolumeJson::Type::Region, this->_region);
+    }
+    if (this->_sphere.size >= 4) {
+      return define(BoundingVolumeJson::Type::Sphere, this->_sphere);
+    }
+
+    return result;
+  }
+
+  static BoundingVolumeJson
+  define(BoundingVolumeJson::Type type, const NumberArray& array) {
+    BoundingVolumeJson result;
+    result.type = type;
+
+    const size_t count = result.getValueCount();
+    if (array.numbers.size() < count) {
+      return BoundingVolumeJson();
+    }
+
+    std::copy(
+        array.numbers.begin(),
+        array.numbers.begin() + int64_t(count),
+        result.values.begin());
+    return result;
+  }
+
+  BoundingVolumeJson* _pBoundingVolume = nullptr;
+  std::optional<S2Json> _s2;
+  NumberArray _box;
+  NumberArray _region;
+  NumberArray _sphere;
+  NumberArrayJsonHandler _numbers;
+  BoundingVolumeExtensionsJsonHandler _extensions;
+};
+
+struct ContentJson {
+  std::optional<std::string> uri;
+  std::optional<std::string> url;
+  BoundingVolumeJson boundingVolume;
+};
+
+/**
+ * @brief Reads a tile's `content` object.
+ */
+class ContentJsonHandler : public ObjectJsonHandler {
+public:
+  void reset(IJsonHandler* pParent, ContentJson* pContent) {
+    ObjectJsonHandler::reset(pParent);
+    this->_pContent = pContent;
+  }
+
+  virtual IJsonHandler* readObjectKey(const std::string_view& str) override {
+    using namespace std::string_literals;
+
+    if ("uri"s == str) {
+      this->setCurrentKey("uri");
+      this->_string.reset(this, &this->_pContent->uri);
+      return &this->_string;
+    }
+    if ("url"s == str) {
+      this->setCurrentKey("url");
+      this->_string.reset(this, &this->_pContent->url);
+      return &this->_string;
+    }
+    if ("boundingVolume"s == str) {
+      this->setCurrentKey("boundingVolume");
+      this->_boundingVolume.reset(this, &this->_pContent->boundingVolume);
+      return &this->_boundingVolume;
+    }
+
+    return this->ignoreAndContinue();
+  }
+
+private:
+  ContentJson* _pContent = nullptr;
+  OptionalStringJsonHandler _string;
+  BoundingVolumeJsonHandler _boundingVolume;
+};
+
+struct ImplicitTilingJson {
+  std::optional<std::string> subdivisionScheme;
+  std::optional<double> subtreeLevels;
+  std::optional<double> availableLevels;
+  std::optional<double> maximumLevel;
+  std::optional<std::string> subtreesUri;
+};
+
+/**
+ * @brief Reads the `subtrees` object of an implicit tiling, of which only the
+ * `uri` is needed.
+ */
+class SubtreesJsonHandler : public ObjectJsonHandler {
+public:
+  void reset(IJsonHandler* pParent, std::optional<std::string>* pUri) {
+    ObjectJsonHandler::reset(pParent);
+    this->_pUri = pUri;
+  }
+
+  virtual IJsonHandler* readObjectKey(const std::string_view& str) override {
+    using namespace std::string_literals;
+
+    if ("uri"s == str) {
+      this->setCurrentKey("uri");
+      this->_string.reset(this, this->_pUri);
+      return &this->_string;
+    }
+
+    return this->ignoreAndContinue();
+  }
+
+private:
+  std::optional<std::string>* _pUri = nullptr;
+  OptionalStringJsonHandler _string;
+};
+
+/**
+ * @brief Reads a tile's `implicitTiling` object, or its
+ * `3DTILES_implicit_tiling` extension, which differs only in using
+ * `maximumLevel` instead of `availableLevels`.
+ */
+class ImplicitTilingJsonHandler : public ObjectJsonHandler {
+public:
+  void reset(
+      IJsonHandler* pParent,
+      std::optional<ImplicitTilingJson>* pImplicitTiling) {
+    ObjectJsonHandler::reset(pParent);
+    this->_pImplicitTiling = pImplicitTiling;
+  }
+
+  virtual IJsonHandler* readObjectStart() override {
+    this->_pImplicitTiling->emplace();
+    return ObjectJsonHandler::readObjectStart();
+  }
+
+  virtual IJsonHandler* readObjectKey(const std::string_view& str) override {
+    using namespace std::string_literals;
+
+    ImplicitTilingJson& implicitTiling = this->_pImplicitTiling->value();
+
+    if ("subdivisionScheme"s == str) {
+      this->setCurrentKey("subdivisionScheme");
+      this->_string.reset(this, &implicitTiling.subdivisionScheme);
+      return &this->_string;
+    }
+    if ("subtreeLevels"s == str) {
+      this->setCurrentKey("subtreeLevels");
+      this->_number.reset(this, &implicitTiling.subtreeLevels);
+      return &this->_number;
+    }
+    if ("availableLevels"s == str) {
+      this->setCurrentKey("availableLevels");
+      this->_number.reset(this, &implicitTiling.availableLevels);
+      return &this->_number;
+    }
+    if ("maximumLevel"s == str) {
+      this->setCurrentKey("maximumLevel");
+      this->_number.reset(this, &implicitTiling.maximumLevel);
+      return &this->_number;
+    }
+    if ("subtrees"s == str) {
+      this->setCurrentKey("subtrees");
+      this->_subtrees.reset(this, &implicitTiling.subtreesUri);
+      return &this->_subtrees;
+    }
+
+    return this->ignoreAndContinue();
+  }
+
+private:
+  std::optional<ImplicitTilingJson>* _pImplicitTiling = nullptr;
+  OptionalStringJsonHandler _string;
+  NumberJsonHandler _number;
+  SubtreesJsonHandler _subtrees;
+};
+
+/**
+ * @brief Reads the `extensions` of a tile, of which only
+ * `3DTILES_implicit_tiling` is supported.
+ */
+class TileExtensionsJsonHandler : public ObjectJsonHandler {
+public:
+  void reset(
+      IJsonHandler* pParent,
+      std::optional<ImplicitTilingJson>* pImplicitTiling) {
+    ObjectJsonHandler::reset(pParent);
+    this->_pImplicitTiling = pImplicitTiling;
+  }
+
+  virtual IJsonHandler* readObjectKey(const std::string_view& str) override {
+    using namespace std::string_literals;
+
+    if ("3DTILES_implicit_tiling"s == str) {
+      this->setCurrentKey("3DTILES_implicit_tiling");
+      this->_implicitTiling.reset(this, this->_pImplicitTiling);
+      return &this->_implicitTiling;
+    }
+
+    return this->ignoreAndContinue();
+  }
+
+private:
+  std::optional<ImplicitTilingJson>* _pImplicitTiling = nullptr;
+  ImplicitTilingJsonHandler _implicitTiling;
+};
+
+/**
+ * @brief Gets the ID of the root tile of an implicit tileset.
+ */
+TileID getImplicitRootTileID(ImplicitTilingSubdivisionScheme scheme) noexcept {
+  if (scheme == ImplicitTilingSubdivisionScheme::Octree) {
+    return OctreeTileID(0, 0, 0, 0);
+  }
+  return QuadtreeTileID(0, 0, 0);
+}
+
+class TileJsonHandler;
+
+/**
+ * @brief Reads a tile's `children` array, creating a tile for each element.
+ *
+ * Elements that are not objects still create a (blank) tile, as they did when
+ * tiles were created from a parsed document.
+ *
+ * When tiles are packed, the offset of each child's record is collected
+ * instead.
+ */
+class TileChildrenJsonHandler : public JsonHandler {
+public:
+  explicit TileChildrenJsonHandler(TileReaderState& state) noexcept;
+  ~TileChildrenJsonHandler() noexcept;
+
+  void reset(IJsonHandler* pParent, std::vector<Tile>* pChildren) {
+    JsonHandler::reset(pParent);
+    this->_pChildren = pChildren;
+    this->_pChildRecords = nullptr;
+    this->_arrayIsOpen = false;
+  }
+
+  void reset(IJsonHandler* pParent, std::vector<uint64_t>* pChildRecords) {
+    JsonHandler::reset(pParent);
+    this->_pChildren = nullptr;
+    this->_pChildRecords = pChildRecords;
+    this->_arrayIsOpen = false;
+  }
+
+  virtual IJsonHandler* readNull() override {
+    if (!this->_arrayIsOpen) {
+      return JsonHandler::readNull();
+    }
+    return this->addBlankTile();
+  }
+
+  virtual IJsonHandler* readBool(bool b) override {
+    if (!this->_arrayIsOpen) {
+      return JsonHandler::readBool(b);
+    }
+    return this->addBlankTile();
+  }
+
+  virtual IJsonHandler* readInt32(int32_t i) override {
+    if (!this->_arrayIsOpen) {
+      return JsonHandler::readInt32(i);
+    }
+    return this->addBlankTile();
+  }
+
+  virtual IJsonHandler* readUint32(uint32_t i) override {
+    if (!this->_arrayIsOpen) {
+      return JsonHandler::readUint32(i);
+    }
+    return this->addBlankTile();
+  }
+
+  virtual IJsonHandler* readInt64(int64_t i) override {
+    if (!this->_arrayIsOpen) {
+      return JsonHandler::readInt64(i);
+    }
+    return this->addBlankTile();
+  }
+
+  virtual IJsonHandler* readUint64(uint64_t i) override {
+    if (!this->_arrayIsOpen) {
+      return JsonHandler::readUint64(i);
+    }
+    return this->addBlankTile();
+  }
+
+  virtual IJsonHandler* readDouble(double d) override {
+    if (!this->_arrayIsOpen) {
+      return JsonHandler::readDouble(d);
+    }
+    return this->addBlankTile();
+  }
+
+  virtual IJsonHandler* readString(const std::string_view& str) override {
+    if (!this->_arrayIsOpen) {
+      return JsonHandler::readString(str);
+    }
+    return this->addBlankTile();
+  }
+
+  virtual IJsonHandler* readObjectStart() override;
+
+  virtual IJsonHandler* readArrayStart() override {
+    if (this->_arrayIsOpen) {
+      this->addBlankTile();
+      return this->ignoreAndContinue()->readArrayStart();
+    }
+
+    this->_arrayIsOpen = true;
+    if (this->_pChildren) {
+      this->_pChildren->clear();
+    } else {
+      this->_pChildRecords->clear();
+    }
+    return this;
+  }
+
+  virtual IJsonHandler* readArrayEnd() override {
+    // The vector grew one tile at a time, so give back its excess capacity.
+    if (this->_pChildren) {
+      this->_pChildren->shrink_to_fit();
+    }
+    return this->parent();
+  }
+
+private:
+  IJsonHandler* addBlankTile() {
+    if (this->_pChildren) {
+      this->_pChildren->emplace_back();
+      this->_state.tileFlags.emplace_back(uint8_t(0));
+    } else {
+      std::vector<std::byte>& packed = *this->_state.pPackedTiles;
+      this->_pChildRecords->emplace_back(packed.size());
+      writePacked(packed, uint8_t(0));
+    }
+    return this;
+  }
+
+  TileReaderState& _state;
+  std::vector<Tile>* _pChildren = nullptr;
+  std::vector<uint64_t>* _pChildRecords = nullptr;
+  bool _arrayIsOpen = false;
+
+  // Created on demand, because each level of the tile tree needs its own
+  // handler.
+  std::unique_ptr<TileJsonHandler> _pTileHandler;
+};
+
+/**
+ * @brief Reads a tile object.
+ *
+ * The tile's properties are stored in the tile as they were specified, in the
+ * tile's own coordinate system. {@link resolveTile} later transforms them and
+ * applies inherited refinement.
+ *
+ * When tiles are packed, the properties are written to a record instead, after
+ * the records of the tile's descendants. {@link unpackTile} later creates the
+ * tile from the record.
+ */
+class TileJsonHandler : public ObjectJsonHandler {
+public:
+  explicit TileJsonHandler(TileReaderState& state) noexcept
+      : ObjectJsonHandler(), _state(state), _children(state) {}
+
+  void reset(IJsonHandler* pParent, Tile* pTile) {
+    ObjectJsonHandler::reset(pParent);
+    this->_pTile = pTile;
+    this->_pRecord = nullptr;
+  }
+
+  void reset(IJsonHandler* pParent, uint64_t* pRecord) {
+    ObjectJsonHandler::reset(pParent);
+    this->_pTile = nullptr;
+    this->_pRecord = pRecord;
+  }
+
+  virtual IJsonHandler* readObjectStart() override {
+    if (this->_state.pPackedTiles) {
+      this->_start = this->_state.pPackedTiles->size();
+    } else {
+      this->_start = this->_state.tileFlags.size();
+      this->_state.tileFlags.emplace_back(TILE_IS_OBJECT);
+    }
+
+    this->_boundingVolume = BoundingVolumeJson();
+    this->_viewerRequestVolume = BoundingVolumeJson();
+    this->_geometricError.reset();
+    this->_refine.reset();
+    this->_transform = NumberArray();
+    this->_content = ContentJson();
+    this->_implicitTiling.reset();
+    this->_childTiles.clear();
+    this->_childRecords.clear();
+
+    return ObjectJsonHandler::readObjectStart();
+  }
+
+  virtual IJsonHandler* readObjectKey(const std::string_view& str) override {
+    using namespace std::string_literals;
+
+    if ("boundingVolume"s == str) {
+      this->setCurrentKey("boundingVolume");
+      this->_boundingVolumeHandler.reset(this, &this->_boundingVolume);
+      return &this->_boundingVolumeHandler;
+    }
+    if ("viewerRequestVolume"s == str) {
+      this->setCurrentKey("viewerRequestVolume");
+      this->_boundingVolumeHandler.reset(this, &this->_viewerRequestVolume);
+      return &this->_boundingVolumeHandler;
+    }
+    if ("geometricError"s == str) {
+      this->setCurrentKey("geometricError");
+      this->_number.reset(this, &this->_geometricError);
+      return &this->_number;
+    }
+    if ("refine"s == str) {
+      this->setCurrentKey("refine");
+      this->_string.reset(this, &this->_refine);
+      return &this->_string;
+    }
+    if ("transform"s == str) {
+      this->setCurrentKey("transform");
+      this->_numbers.reset(this, &this->_transform);
+      return &this->_numbers;
+    }
+    if ("content"s == str) {
+      this->setCurrentKey("content");
+      this->_contentHandler.reset(this, &this->_content);
+      return &this->_contentHandler;
+    }
+    if ("implicitTiling"s == str) {
+      this->setCurrentKey("implicitTiling");
+      this->_implicitTilingHandler.reset(this, &this->_implicitTiling);
+      return &this->_implicitTilingHandler;
+    }
+    if ("extensions"s == str) {
+      this->setCurrentKey("extensions");
+      this->_extensions.reset(this, &this->_implicitTiling);
+      return &this->_extensions;
+    }
+    if ("children"s == str) {
+      this->setCurrentKey("children");
+      if (this->_state.pPackedTiles) {
+        this->_children.reset(this, &this->_childRecords);
+      } else {
+        this->_children.reset(this, &this->_childTiles);
+      }
+      return &this->_children;
+    }
+
+    return this->ignoreAndContinue();
+  }
+
+  virtual IJsonHandler* readObjectEnd() override {
+    const bool isComplete = this->isComplete();
+    const bool isImplicit =
+        isComplete && this->_implicitTiling && this->defineSubtreeContext();
+    if (this->_state.pPackedTiles) {
+      this->packTile(isComplete, isImplicit);
+    } else {
+      this->finishTile(isComplete, isImplicit);
+    }
+    return ObjectJsonHandler::readObjectEnd();
+  }
+
+private:
+  /**
+   * @brief Defines the tileset's implicit tiling from this tile's, if it is
+   * valid, and returns whether it was.
+   */
+  bool defineSubtreeContext() {
+    const ImplicitTilingJson& implicitTiling = *this->_implicitTiling;
+
+    if (this->_state.subtreeContext) {
+      SPDLOG_LOGGER_ERROR(
+          this->_state.pLogger,
+          "Only one tile in a tileset.json may use implicit tiling, so the "
+          "implicit tiling of another tile is ignored");
+      return false;
+    }
+
+    SubtreeTilingContext context;
+
+    const std::string& scheme =
+        implicitTiling.subdivisionScheme.value_or(std::string());
+    if (scheme == "QUADTREE") {
+      context.subdivisionScheme = ImplicitTilingSubdivisionScheme::Quadtree;
+    } else if (scheme == "OCTREE") {
+      context.subdivisionScheme = ImplicitTilingSubdivisionScheme::Octree;
+    } else {
+      SPDLOG_LOGGER_ERROR(
+          this->_state.pLogger,
+          "Tile implicit tiling has an unknown subdivisionScheme: {}",
+          scheme);
+      return false;
+    }
+
+    std::optional<double> availableLevels = implicitTiling.availableLevels;
+    if (!availableLevels && implicitTiling.maximumLevel) {
+      availableLevels = *implicitTiling.maximumLevel + 1.0;
+    }
+
+    if (!implicitTiling.subtreeLevels || *implicitTiling.subtreeLevels < 1.0 ||
+        !availableLevels || *availableLevels < 1.0 ||
+        !implicitTiling.subtreesUri) {
+      SPDLOG_LOGGER_ERROR(
+          this->_state.pLogger,
+          "Tile implicit tiling must have subtreeLevels, availableLevels, and "
+          "a subtrees uri");
+      return false;
+    }
+
+    if (this->_boundingVolume.type != BoundingVolumeJson::Type::Box &&
+        this->_boundingVolume.type != BoundingVolumeJson::Type::Region) {
+      SPDLOG_LOGGER_ERROR(
+          this->_state.pLogger,
+          "Tile implicit tiling is only supported for a box or region "
+          "boundingVolume");
+      return false;
+    }
+
+    context.subtreeLevels = uint32_t(*implicitTiling.subtreeLevels);
+    context.availableLevels = uint32_t(*availableLevels);
+    context.subtreeTemplateUrl = *implicitTiling.subtreesUri;
+
+    const std::string* pTileID = this->getTileID();
+    if (pTileID) {
+      context.contentTemplateUrl = *pTileID;
+    }
+
+    this->_state.subtreeContext = std::move(context);
+    return true;
+  }
+
+  bool isComplete() const {
+    if (this->_boundingVolume.type == BoundingVolumeJson::Type::None) {
+      SPDLOG_LOGGER_ERROR(
+          this->_state.pLogger,
+          "Tile did not contain a boundingVolume");
+      return false;
+    }
+
+    if (!this->_geometricError) {
+      SPDLOG_LOGGER_ERROR(
+          this->_state.pLogger,
+          "Tile did not contain a geometricError");
+      return false;
+    }
+
+    return true;
+  }
+
+  TileRefine getRefine() const {
+    const std::string& refine = *this->_refine;
+    if (refine == "ADD") {
+      return TileRefine::Add;
+    }
+    if (refine != "REPLACE") {
+      SPDLOG_LOGGER_ERROR(
+          this->_state.pLogger,
+          "Tile contained an unknown refine value: {}",
+          refine);
+    }
+    return TileRefine::Replace;
+  }
+
+  const std::string* getTileID() const noexcept {
+    if (this->_content.uri) {
+      return &*this->_content.uri;
+    }
+    if (this->_content.url) {
+      return &*this->_content.url;
+    }
+    return nullptr;
+  }
+
+  void finishTile(bool isComplete, bool isImplicit) {
+    Tile& tile = *this->_pTile;
+
+    const std::string* pTileID = this->getTileID();
+    if (isImplicit) {
+      tile.setTileID(getImplicitRootTileID(
+          this->_state.subtreeContext->subdivisionScheme));
+    } else if (pTileID) {
+      tile.setTileID(*pTileID);
+    }
+
+    if (this->_content.boundingVolume.type != BoundingVolumeJson::Type::None) {
+      tile.setContentBoundingVolume(
+          createBoundingVolume(this->_content.boundingVolume));
+    }
+
+    if (this->_transform.numbers.size() >= 16) {
+      const std::vector<double>& a = this->_transform.numbers;
+      tile.setTransform(glm::dmat4(
+          glm::dvec4(a[0], a[1], a[2], a[3]),
+          glm::dvec4(a[4], a[5], a[6], a[7]),
+          glm::dvec4(a[8], a[9], a[10], a[11]),
+          glm::dvec4(a[12], a[13], a[14], a[15])));
+    }
+
+    if (!isComplete || isImplicit) {
+      // An invalid tile has no children, and the children of an implicit
+      // tile are created from its subtrees, so forget the descendants that
+      // were read, which are all of the tiles after this one.
+      this->_state.tileFlags.resize(this->_start + 1);
+      this->_childTiles.clear();
+    }
+
+    if (!isComplete) {
+      return;
+    }
+
+    uint8_t& flags = this->_state.tileFlags[this->_start];
+    flags |= TILE_IS_COMPLETE;
+
+    tile.setBoundingVolume(createBoundingVolume(this->_boundingVolume));
+    tile.setGeometricError(*this->_geometricError);
+
+    if (this->_viewerRequestVolume.type != BoundingVolumeJson::Type::None) {
+      tile.setViewerRequestVolume(
+          createBoundingVolume(this->_viewerRequestVolume));
+    }
+
+    if (this->_refine) {
+      flags |= TILE_HAS_REFINE;
+      tile.setRefine(this->getRefine());
+    }
+
+    if (!this->_childTiles.empty()) {
+      tile.createChildTiles(std::move(this->_childTiles));
+      this->_childTiles = std::vector<Tile>();
+    }
+  }
+
+  void packTile(bool isComplete, bool isImplicit) {
+    std::vector<std::byte>& packed = *this->_state.pPackedTiles;
+
+    if (!isComplete || isImplicit) {
+      // An invalid tile has no children, and the children of an implicit
+      // tile are created from its subtrees, so discard the descendants that
+      // were packed, which are all of the records written since this tile
+      // started.
+      packed.resize(this->_start);
+      this->_childRecords.clear();
+    }
+
+    const std::string* pTileID = this->getTileID();
+    const bool hasTransform = this->_transform.numbers.size() >= 16;
+    const bool hasContentBoundingVolume =
+        this->_content.boundingVolume.type != BoundingVolumeJson::Type::None;
+    const bool hasViewerRequestVolume =
+        isComplete &&
+        this->_viewerRequestVolume.type != BoundingVolumeJson::Type::None;
+
+    uint8_t flags = TILE_IS_OBJECT;
+    if (isComplete) {
+      flags |= TILE_IS_COMPLETE;
+      if (this->_refine) {
+        flags |= TILE_HAS_REFINE;
+        if (this->getRefine() == TileRefine::Add) {
+          flags |= TILE_REFINE_ADD;
+        }
+      }
+    }
+    if (pTileID || isImplicit) {
+      flags |= TILE_HAS_TILE_ID;
+    }
+    if (hasTransform) {
+      flags |= TILE_HAS_TRANSFORM;
+    }
+    if (hasContentBoundingVolume) {
+      flags |= TILE_HAS_CONTENT_BOUNDING_VOLUME;
+    }
+    if (hasViewerRequestVolume) {
+      flags |= TILE_HAS_VIEWER_REQUEST_VOLUME;
+    }
+
+    *this->_pRecord = packed.size();
+
+    // The children come first, so that they can be found without reading the
+    // rest of the record.
+    writePacked(packed, flags);
+    if (isComplete) {
+      writePacked(packed, uint32_t(this->_childRecords.size()));
+      for (uint64_t childRecord : this->_childRecords) {
+        writePacked(packed, childRecord);
+      }
+    }
+
+    if (isImplicit) {
+      writePacked(packed, IMPLICIT_ROOT_TILE_ID);
+    } else if (pTileID) {
+      writePacked(packed, uint32_t(pTileID->size()));
+      const size_t offset = packed.size();
+      packed.resize(offset + pTileID->size());
+      std::memcpy(packed.data() + offset, pTileID->data(), pTileID->size());
+    }
+
+    if (hasTransform) {
+      for (size_t i = 0; i < 16; ++i) {
+        writePacked(packed, this->_transform.numbers[i]);
+      }
+    }
+
+    if (hasContentBoundingVolume) {
+      writePackedBoundingVolume(packed, this->_content.boundingVolume);
+    }
+
+    if (isComplete) {
+      writePacked(packed, *this->_geometricError);
+      writePackedBoundingVolume(packed, this->_boundingVolume);
+    }
+
+    if (hasViewerRequestVolume) {
+      writePackedBoundingVolume(packed, this->_viewerRequestVolume);
+    }
+  }
+
+  TileReaderState& _state;
+  Tile* _pTile = nullptr;
+  uint64_t* _pRecord = nullptr;
+
+  // The index of this tile's flags, or the size of the packed tiles when this
+  // tile started.
+  size_t _start = 0;
+
+  BoundingVolumeJson _boundingVolume;
+  BoundingVolumeJson _viewerRequestVolume;
+  std::optional<double> _geometricError;
+  std::optional<std::string> _refine;
+  NumberArray _transform;
+  ContentJson _content;
+  std::optional<ImplicitTilingJson> _implicitTiling;
+  std::vector<Tile> _childTiles;
+  std::vector<uint64_t> _childRecords;
+
+  BoundingVolumeJsonHandler _boundingVolumeHandler;
+  NumberJsonHandler _number;
+  OptionalStringJsonHandler _string;
+  NumberArrayJsonHandler _numbers;
+  ContentJsonHandler _contentHandler;
+  ImplicitTilingJsonHandler _implicitTilingHandler;
+  TileExtensionsJsonHandler _extensions;
+  TileChildrenJsonHandler _children;
+};
+
+TileChildrenJsonHandler::TileChildrenJsonHandler(
+    TileReaderState& state) noexcept
+    : JsonHandler(), _state(state), _pTileHandler() {}
+
+TileChildrenJsonHandler::~TileChildrenJsonHandler() noexcept = default;
+
+IJsonHandler* TileChildrenJsonHandler::readObjectStart() {
+  if (!this->_arrayIsOpen) {
+    return JsonHandler::readObjectStart();
+  }
+
+  if (!this->_pTileHandler) {
+    this->_pTileHandler = std::make_unique<TileJsonHandler>(this->_state);
+  }
+
+  if (this->_pChildren) {
+    Tile& child = this->_pChildren->emplace_back();
+    this->_pTileHandler->reset(this, &child);
+  } else {
+    uint64_t& childRecord = this->_pChildRecords->emplace_back();
+    this->_pTileHandler->reset(this, &childRecord);
+  }
+
+  return this->_pTileHandler->readObjectStart();
+}
+
+/**
+ * @brief Reads the `asset` object, of which only the non-standard
+ * `gltfUpAxis` is needed.
+ */
+class AssetJsonHandler : public ObjectJsonHandler {
+public:
+  void reset(IJsonHandler* pParent, std::optional<std::string>* pGltfUpAxis) {
+    ObjectJsonHandler::reset(pParent);
+    this->_pGltfUpAxis = pGltfUpAxis;
+  }
+
+  virtual IJsonHandler* readObjectKey(const std::string_view& str) override {
+    using namespace std::string_literals;
+
+    if ("gltfUpAxis"s == str) {
+      this->setCurrentKey("gltfUpAxis");
+      this->_string.reset(this, this->_pGltfUpAxis);
+      return &this->_string;
+    }
+
+    return this->ignoreAndContinue();
+  }
+
+private:
+  std::optional<std::string>* _pGltfUpAxis = nullptr;
+  OptionalStringJsonHandler _string;
+};
+
+/**
+ * @brief Reads the top-level tileset.json object.
+ */
+class TilesetJsonHandler : public ObjectJsonHandler {
+public:
+  using ValueType = TilesetJson;
+
+  TilesetJsonHandler(Tile& rootTile, TileReaderState& state) noexcept
+      : ObjectJsonHandler(), _state(state), _rootTile(rootTile), _root(state) {}
+
+  void reset(IJsonHandler* pParent, TilesetJson* pTileset) {
+    ObjectJsonHandler::reset(pParent);
+    this->_pTileset = pTileset;
+  }
+
+  /**
+   * @brief Gets the offset of the root tile's record, if tiles are packed.
+   *
+   * This is only valid if the root tile was packed, which is the case when any
+   * tiles were packed.
+   */
+  uint64_t getRootRecord() const noexcept { return this->_rootRecord; }
+
+  virtual IJsonHandler* readObjectKey(const std::string_view& str) override {
+    using namespace std::string_literals;
+
+    if ("asset"s == str) {
+      this->setCurrentKey("asset");
+      this->_asset.reset(this, &this->_pTileset->gltfUpAxis);
+      return &this->_asset;
+    }
+    if ("root"s == str) {
+      this->setCurrentKey("root");
+      this->_pTileset->hasRoot = true;
+      if (this->_state.pPackedTiles) {
+        this->_root.reset(this, &this->_rootRecord);
+      } else {
+        this->_root.reset(this, &this->_rootTile);
+      }
+      return &this->_root;
+    }
+    if ("format"s == str) {
+      this->setCurrentKey("format");
+      this->_format.reset(this, &this->_pTileset->format);
+      return &this->_format;
+    }
+
+    return this->ignoreAndContinue();
+  }
+
+private:
+  TileReaderState& _state;
+  TilesetJson* _pTileset = nullptr;
+  Tile& _rootTile;
+  uint64_t _rootRecord = 0;
+  AssetJsonHandler _asset;
+  TileJsonHandler _root;
+  OptionalStringJsonHandler _format;
+};
+
+double getMaximumScale(const glm::dmat4& transform) {
+  const glm::dvec3 scale = glm::dvec3(
+      glm::length(transform[0]),
+      glm::length(transform[1]),
+      glm::length(transform[2]));
+  return glm::max(scale.x, glm::max(scale.y, scale.z));
+}
+
+/**
+ * @brief Transforms a tile that was read by {@link TileJsonHandler}, and its
+ * descendants, into the tileset's coordinate system, and applies inherited
+ * refinement.
+ */
+void resolveTile(
+    Tile& tile,
+    const glm::dmat4& parentTransform,
+    TileRefine parentRefine,
+    TileContext& context,
+    const std::vector<uint8_t>& tileFlags,
+    size_t& tileIndex) {
+  const uint8_t flags = tileFlags[tileIndex++];
+  if (!(flags & TILE_IS_OBJECT)) {
+    return;
+  }
+
+  tile.setContext(&context);
+
+  const glm::dmat4 transform = parentTransform * tile.getTransform();
+  tile.setTransform(transform);
+
+  const std::optional<BoundingVolume>& contentBoundingVolume =
+      tile.getContentBoundingVolume();
+  if (contentBoundingVolume) {
+    tile.setContentBoundingVolume(
+        transformBoundingVolume(transform, *contentBoundingVolume));
+  }
+
+  if (!(flags & TILE_IS_COMPLETE)) {
+    return;
+  }
+
+  tile.setBoundingVolume(
+      transformBoundingVolume(transform, tile.getBoundingVolume()));
+  tile.setGeometricError(
+      tile.getGeometricError() * getMaximumScale(transform));
+
+  const std::optional<BoundingVolume>& viewerRequestVolume =
+      tile.getViewerRequestVolume();
+  if (viewerRequestVolume) {
+    tile.setViewerRequestVolume(
+        transformBoundingVolume(transform, *viewerRequestVolume));
+  }
+
+  if (!(flags & TILE_HAS_REFINE)) {
+    tile.setRefine(parentRefine);
+  }
+
+  for (Tile& child : tile.getChildren()) {
+    child.setParent(&tile);
+    resolveTile(
+        child,
+        transform,
+        tile.getRefine(),
+        context,
+        tileFlags,
+        tileIndex);
+  }
+}
+
+/**
+ * @brief Creates a tile, in the tileset's coordinate system, from a record
+ * written by {@link TileJsonHandler}.
+ *
+ * The tile's children are not created, but if it has any, the tile refers to
+ * its record so that they can be created by {@link createPackedChildTiles}.
+ */
+void unpackTile(
+    uint64_t record,
+    Tile& tile,
+    const glm::dmat4& parentTransform,
+    TileRefine parentRefine,
+    TileContext& context) {
+  PackedTileReader reader(context.packedTiles, record);
+
+  const uint8_t flags = reader.read<uint8_t>();
+  if (!(flags & TILE_IS_OBJECT)) {
+    return;
+  }
+
+  tile.setContext(&context);
+
+  uint32_t childCount = 0;
+  if (flags & TILE_IS_COMPLETE) {
+    childCount = reader.read<uint32_t>();
+    reader.skip(childCount * sizeof(uint64_t));
+  }
+
+  if (flags & TILE_HAS_TILE_ID) {
+    const uint32_t length = reader.read<uint32_t>();
+    if (length == IMPLICIT_ROOT_TILE_ID) {
+      tile.setTileID(
+          getImplicitRootTileID(context.subtreeContext->subdivisionScheme));
+    } else {
+      tile.setTileID(reader.readString(length));
+    }
+  }
+
+  glm::dmat4 transform = parentTransform;
+  if (flags & TILE_HAS_TRANSFORM) {
+    glm::dmat4 localTransform;
+    for (glm::length_t column = 0; column < 4; ++column) {
+      for (glm::length_t row = 0; row < 4; ++row) {
+        localTransform[column][row] = reader.read<double>();
+      }
+    }
+    transform = parentTransform * localTransform;
+  }
+  tile.setTransform(transform);
+
+  if (flags & TILE_HAS_CONTENT_BOUNDING_VOLUME) {
+    tile.setContentBoundingVolume(transformBoundingVolume(
+        transform,
+        createBoundingVolume(reader.readBoundingVolume())));
+  }
+
+  if (!(flags & TILE_IS_COMPLETE)) {
+    return;
+  }
+
+  const double geometricError = reader.read<double>();
+  tile.setGeometricError(geometricError * getMaximumScale(transform));
+  tile.setBoundingVolume(transformBoundingVolume(
+      transform,
+      createBoundingVolume(reader.readBoundingVolume())));
+
+  if (flags & TILE_HAS_VIEWER_REQUEST_VOLUME) {
+    tile.setViewerRequestVolume(transformBoundingVolume(
+        transform,
+        createBoundingVolume(reader.readBoundingVolume())));
+  }
+
+  if (flags & TILE_HAS_REFINE) {
+    tile.setRefine(
+        (flags & TILE_REFINE_ADD) ? TileRefine::Add : TileRefine::Replace);
+  } else {
+    tile.setRefine(parentRefine);
+  }
+
+  if (childCount > 0) {
+    tile.setPackedTileRecord(record);
+  }
+}
+
+/**
+ * @brief Reads a packed tile record as {@link unpackTile} would, and adds the
+ * records of its children to `childRecords`.
+ *
+ * @return Whether the record lies within the packed tiles and is well-formed.
+ * A child record must come before its parent's, as {@link TileJsonHandler}
+ * writes them, so the records cannot refer to each other in a cycle.
+ */
+bool readPackedTileChildren(
+    const std::vector<std::byte>& packed,
+    uint64_t record,
+    bool hasSubtreeContext,
+    std::vector<uint64_t>& childRecords) {
+  PackedTileReader reader(packed, record);
+
+  const uint8_t flags = reader.read<uint8_t>();
+  if (!(flags & TILE_IS_OBJECT)) {
+    return reader.isValid();
+  }
+
+  if (flags & TILE_IS_COMPLETE) {
+    const uint32_t childCount = reader.read<uint32_t>();
+    if (childCount > reader.getRemainingBytes() / sizeof(uint64_t)) {
+      return false;
+    }
+
+    for (uint32_t i = 0; i < childCount; ++i) {
+      const uint64_t childRecord = reader.read<uint64_t>();
+      if (childRecord >= record) {
+        return false;
+      }
+      childRecords.emplace_back(childRecord);
+    }
+  }
+
+  if (flags & TILE_HAS_TILE_ID) {
+    const uint32_t length = reader.read<uint32_t>();
+    if (length == IMPLICIT_ROOT_TILE_ID) {
+      if (!hasSubtreeContext) {
+        return false;
+      }
+    } else {
+      reader.skip(length);
+    }
+  }
+
+  if (flags & TILE_HAS_TRANSFORM) {
+    reader.skip(16 * sizeof(double));
+  }
+
+  if (flags & TILE_HAS_CONTENT_BOUNDING_VOLUME) {
+    reader.readBoundingVolume();
+  }
+
+  if (flags & TILE_IS_COMPLETE) {
+    reader.read<double>();
+    reader.readBoundingVolume();
+    if (flags & TILE_HAS_VIEWER_REQUEST_VOLUME) {
+      reader.readBoundingVolume();
+    }
+  }
+
+  return reader.isValid();
+}
+
+/**
+ * @brief Determines whether every packed tile record that can be reached from
+ * the root record is well-formed, so that none of them is read out of bounds
+ * when the tiles are created.
+ */
+bool validatePackedTiles(
+    const std::vector<std::byte>& packed,
+    uint64_t rootTileRecord,
+    bool hasSubtreeContext) {
+  std::vector<bool> visited(packed.size());
+  std::vector<uint64_t> records{rootTileRecord};
+  while (!records.empty()) {
+    const uint64_t record = records.back();
+    records.pop_back();
+
+    if (record >= packed.size()) {
+      return false;
+    }
+    if (visited[size_t(record)]) {
+      continue;
+    }
+    visited[size_t(record)] = true;
+
+    if (!readPackedTileChildren(packed, record, hasSubtreeContext, records)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+} // namespace
+
+ReadJsonResult<TilesetJson> readTilesetJson(
+    const gsl::span<const std::byte>& data,
+    Tile& rootTile,
+    const glm::dmat4& parentTransform,
+    TileRefine parentRefine,
+    TileContext& context,
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    bool createChildTilesLazily) {
+  std::vector<std::byte>& packed = context.packedTiles;
+  const size_t packedSize = packed.size();
+
+  TileReaderState state{
+      pLogger,
+      {},
+      createChildTilesLazily ? &packed : nullptr};
+  TilesetJsonHandler handler(rootTile, state);
+
+  ReadJsonResult<TilesetJson> result = JsonReader::readJson(data, handler);
+
+  if (result.value && state.subtreeContext) {
+    context.subtreeContext = std::move(state.subtreeContext);
+  }
+
+  if (!result.value) {
+    packed.resize(packedSize);
+  } else if (packed.size() > packedSize) {
+    packed.shrink_to_fit();
+    result.value->rootTileRecord = handler.getRootRecord();
+    unpackTile(
+        handler.getRootRecord(),
+        rootTile,
+        parentTransform,
+        parentRefine,
+        context);
+  } else if (!state.tileFlags.empty()) {
+    size_t tileIndex = 0;
+    resolveTile(
+        rootTile,
+        parentTransform,
+        parentRefine,
+        context,
+        state.tileFlags,
+        tileIndex);
+  }
+
+  return result;
+}
+
+void createPackedChildTiles(Tile& tile) {
+  const std::optional<uint64_t>& record = tile.getPackedTileRecord();
+  TileContext* pContext = tile.getContext();
+  if (!record || !pContext || !tile.getChildren().empty()) {
+    return;
+  }
+
+  PackedTileReader reader(pContext->packedTiles, *record);
+  reader.skip(sizeof(uint8_t));
+
+  const uint32_t childCount = reader.read<uint32_t>();
+  if (childCount > reader.getRemainingBytes() / sizeof(uint64_t)) {
+    return;
+  }
+
+  std::vector<Tile> children(childCount);
+  for (Tile& child : children) {
+    child.setParent(&tile);
+    unpackTile(
+        reader.read<uint64_t>(),
+        child,
+        tile.getTransform(),
+        tile.getRefine(),
+        *pContext);
+  }
+
+  tile.createChildTiles(std::move(children));
+}
+
+void createAllPackedChildTiles(Tile& tile) {
+  createPackedChildTiles(tile);
+  tile.setPackedTileRecord(std::nullopt);
+  for (Tile& child : tile.getChildren()) {
+    createAllPackedChildTiles(child);
+  }
+}
+
+namespace {
+
+void writeCachedString(std::vector<std::byte>& cache, const std::string& str) {
+  writePacked(cache, uint32_t(str.size()));
+  const size_t offset = cache.size();
+  cache.resize(offset + str.size());
+  std::memcpy(cache.data() + offset, str.data(), str.size());
+}
+
+void writeCachedString(
+    std::vector<std::byte>& cache,
+    const std::optional<std::string>& str) {
+  writePacked(cache, uint8_t(str ? 1 : 0));
+  if (str) {
+    writeCachedString(cache, *str);
+  }
+}
+
+/**
+ * @brief Reads the values written to a tileset cache in order, and notes if
+ * any of them extend past the end of the data.
+ */
+class TilesetCacheReader {
+public:
+  TilesetCacheReader(const gsl::span<const std::byte>& data) noexcept
+      : _data(data) {}
+
+  bool isValid() const noexcept { return this->_isValid; }
+
+  size_t getRemainingBytes() const noexcept {
+    return this->_isValid ? this->_data.size() - this->_offset : 0;
+  }
+
+  template <typename T> T read() noexcept {
+    T value{};
+    const gsl::span<const std::byte> bytes = this->readBytes(sizeof(T));
+    if (!bytes.empty()) {
+      std::memcpy(&value, bytes.data(), sizeof(T));
+    }
+    return value;
+  }
+
+  std::string readString() {
+    const uint32_t length = this->read<uint32_t>();
+    const gsl::span<const std::byte> bytes = this->readBytes(length);
+    return std::string(
+        reinterpret_cast<const char*>(bytes.data()),
+        bytes.size());
+  }
+
+  std::optional<std::string> readOptionalString() {
+    if (this->read<uint8_t>() == 0) {
+      return std::nullopt;
+    }
+    return this->readString();
+  }
+
+  gsl::span<const std::byte> readBytes(size_t length) noexcept {
+    if (!this->_isValid || length > this->_data.size() - this->_offset) {
+      this->_isValid = false;
+      return gsl::span<const std::byte>();
+    }
+
+    const gsl::span<const std::byte> result =
+        this->_data.subspan(this->_offset, length);
+    this->_offset += length;
+    return result;
+  }
+
+private:
+  gsl::span<const std::byte> _data;
+  size_t _offset = 0;
+  bool _isValid = true;
+};
+
+} // namespace
+
+std::vector<std::byte>
+writeTilesetJsonCache(const TilesetJson& tileset, const TileContext& context) {
+  std::vector<std::byte> cache;
+  for (char c : TILESET_CACHE_MAGIC) {
+    writePacked(cache, c);
+  }
+  writePacked(cache, TILESET_CACHE_VERSION);
+
+  writePacked(cache, uint8_t(tileset.hasRoot ? 1 : 0));
+  writeCachedString(cache, tileset.gltfUpAxis);
+  writeCachedString(cache, tileset.format);
+
+  const std::optional<SubtreeTilingContext>& subtreeContext =
+      context.subtreeContext;
+  writePacked(cache, uint8_t(subtreeContext ? 1 : 0));
+  if (subtreeContext) {
+    writePacked(cache, subtreeContext->subdivisionScheme);
+    writePacked(cache, subtreeContext->subtreeLevels);
+    writePacked(cache, subtreeContext->availableLevels);
+    writeCachedString(cache, subtreeContext->subtreeTemplateUrl);
+    writeCachedString(cache, subtreeContext->contentTemplateUrl);
+  }
+
+  // The packed records refer to each other by their offsets from the start of
+  // the packed tiles, so they're copied as they are.
+  writePacked(cache, tileset.rootTileRecord.value_or(0));
+  writePacked(cache, uint64_t(context.packedTiles.size()));
+  const size_t offset = cache.size();
+  cache.resize(offset + context.packedTiles.size());
+  std::memcpy(
+      cache.data() + offset,
+      context.packedTiles.data(),
+      context.packedTiles.size());
+
+  return cache;
+}
+
+std::optional<TilesetJson> readTilesetJsonCache(
+    const gsl::span<const std::byte>& data,
+    Tile& rootTile,
+    const glm::dmat4& parentTransform,
+    TileRefine parentRefine,
+    TileContext& context) {
+  if (!context.packedTiles.empty()) {
+    return std::nullopt;
+  }
+
+  TilesetCacheReader reader(data);
+  for (char c : TILESET_CACHE_MAGIC) {
+    if (reader.read<char>() != c) {
+      return std::nullopt;
+    }
+  }
+  if (reader.read<uint32_t>() != TILESET_CACHE_VERSION) {
+    return std::nullopt;
+  }
+
+  TilesetJson tileset;
+  tileset.hasRoot = reader.read<uint8_t>() != 0;
+  tileset.gltfUpAxis = reader.readOptionalString();
+  tileset.format = reader.readOptionalString();
+
+  std::optional<SubtreeTilingContext> subtreeContext;
+  if (reader.read<uint8_t>() != 0) {
+    SubtreeTilingContext& implicitTiling = subtreeContext.emplace();
+    implicitTiling.subdivisionScheme =
+        reader.read<ImplicitTilingSubdivisionScheme>();
+    implicitTiling.subtreeLevels = reader.read<uint32_t>();
+    implicitTiling.availableLevels = reader.read<uint32_t>();
+    implicitTiling.subtreeTemplateUrl = reader.readString();
+    implicitTiling.contentTemplateUrl = reader.readOptionalString();
+  }
+
+  const uint64_t rootTileRecord = reader.read<uint64_t>();
+  const uint64_t packedSize = reader.read<uint64_t>();
+  if (!reader.isValid() || packedSize != reader.getRemainingBytes() ||
+      (tileset.hasRoot && rootTileRecord >= packedSize)) {
+    return std::nullopt;
+  }
+
+  const gsl::span<const std::byte> packed = reader.readBytes(packedSize);
+  std::vector<std::byte> packedTiles(packed.begin(), packed.end());
+  if (tileset.hasRoot &&
+      !validatePackedTiles(
+          packedTiles,
+          rootTileRecord,
+          subtreeContext.has_value())) {
+    return std::nullopt;
+  }
+
+  context.packedTiles = std::move(packedTiles);
+  context.subtreeContext = std::move(subtreeContext);
+
+  if (tileset.hasRoot) {
+    tileset.rootTileRecord = rootTileRecord;
+    unpackTile(
+        rootTileRecord,
+        rootTile,
+        parentTransform,
+        parentRefine,
+        context);
+  }
+
+  return tileset;
+}
+
+ReadJsonResult<TilesetJson> readTilesetJsonWithCache(
+    const std::string& url,
+    const CesiumAsync::HttpHeaders& responseHeaders,
+    const gsl::span<const std::byte>& data,
+    Tile& rootTile,
+    const glm::dmat4& parentTransform,
+    TileRefine parentRefine,
+    TileContext& context,
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    bool createChildTilesLazily,
+    CesiumAsync::ICacheDatabase* pCache) {
+  const auto etagIt = responseHeaders.find("ETag");
+  if (!pCache || etagIt == responseHeaders.end() ||
+      !context.packedTiles.empty()) {
+    return readTilesetJson(
+        data,
+        rootTile,
+        parentTransform,
+        parentRefine,
+        context,
+        pLogger,
+        createChildTilesLazily);
+  }
+
+  const std::string key = "tileset.json:" + etagIt->second + ":" + url;
+
+  ReadJsonResult<TilesetJson> result;
+  std::optional<CesiumAsync::CacheItem> cacheItem = pCache->getEntry(key);
+  if (cacheItem) {
+    result.value = readTilesetJsonCache(
+        cacheItem->cacheResponse.data,
+        rootTile,
+        parentTransform,
+        parentRefine,
+        context);
+    if (!result.value) {
+      SPDLOG_LOGGER_WARN(
+          pLogger,
+          "Ignoring cached tiles for tileset {} that could not be read",
+          url);
+    }
+  }
+
+  if (!result.value) {
+    // The tiles are packed so that they can be cached, whether or not they're
+    // to be created lazily.
+    result = readTilesetJson(
+        data,
+        rootTile,
+        parentTransform,
+        parentRefine,
+        context,
+        pLogger,
+        true);
+
+    if (result.value) {
+      const std::vector<std::byte> cache =
+          writeTilesetJsonCache(*result.value, context);
+      pCache->storeEntry(
+          key,
+          std::time(nullptr) + TILESET_CACHE_LIFETIME,
+          url,
+          "GET",
+          CesiumAsync::HttpHeaders(),
+          200,
+          CesiumAsync::HttpHeaders{{"ETag", etagIt->second}},
+          cache);
+    }
+  }
+
+  if (result.value && !createChildTilesLazily) {
+    createAllPackedChildTiles(rootTile);
+    context.packedTiles = std::vector<std::byte>();
+  }
+
+  return result;
+}
+
+} // namespace Cesium3DTilesSelection
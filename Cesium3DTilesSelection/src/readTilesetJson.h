@@ -0,0 +1,188 @@
+#pragma once
+
+#include "Cesium3DTilesSelection/Tile.h"
+#include "Cesium3DTilesSelection/TileContext.h"
+#include "Cesium3DTilesSelection/TileRefine.h"
+
+#include <CesiumAsync/HttpHeaders.h>
+#include <CesiumJsonReader/JsonReader.h>
+
+#include <glm/mat4x4.hpp>
+#include <gsl/span>
+#include <spdlog/fwd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace CesiumAsync {
+class ICacheDatabase;
+}
+
+namespace Cesium3DTilesSelection {
+
+/**
+ * @brief The top-level properties of a tileset.json, other than its tiles,
+ * that are read by {@link readTilesetJson}.
+ */
+struct TilesetJson {
+  /**
+   * @brief The value of the non-standard `asset.gltfUpAxis` property, if it is
+   * a string.
+   */
+  std::optional<std::string> gltfUpAxis;
+
+  /**
+   * @brief The value of the `format` property, if it is a string.
+   *
+   * This is used to recognize a quantized-mesh `layer.json`, which does not
+   * have a root tile.
+   */
+  std::optional<std::string> format;
+
+  /**
+   * @brief Whether the JSON has a `root` property.
+   */
+  bool hasRoot = false;
+
+  /**
+   * @brief The offset of the root tile's record in the context's
+   * {@link TileContext::packedTiles}, if the tiles were packed.
+   */
+  std::optional<uint64_t> rootTileRecord;
+};
+
+/**
+ * @brief Reads a tileset.json and creates its tiles.
+ *
+ * The JSON is read in a single streaming pass, and the tiles are created as
+ * their JSON objects are read, without first parsing the JSON into a document.
+ * Once the JSON has been read successfully, a pass over the new tiles applies
+ * the transforms and refinement that each tile inherits from its ancestors,
+ * because a tile's own `transform` and `refine` may appear after its
+ * `children` in the JSON.
+ *
+ * If the tiles are created lazily, only the root tile is created. The other
+ * tiles are written to the context's {@link TileContext::packedTiles}, which is
+ * far smaller than the equivalent tiles, and are created a level at a time by
+ * {@link createPackedChildTiles}.
+ *
+ * If the JSON cannot be read, the result has no value and the tiles are left
+ * incomplete, so they should be discarded.
+ *
+ * @param data The tileset.json.
+ * @param rootTile A blank tile into which to load the root.
+ * @param parentTransform The root tile's parent transform.
+ * @param parentRefine The refinement to use for the root tile if it does not
+ * specify one.
+ * @param context The context of the new tiles.
+ * @param pLogger The logger to which to report invalid tiles.
+ * @param createChildTilesLazily Whether to create the root tile's descendants
+ * lazily.
+ * @return The result of reading the JSON.
+ */
+CesiumJsonReader::ReadJsonResult<TilesetJson> readTilesetJson(
+    const gsl::span<const std::byte>& data,
+    Tile& rootTile,
+    const glm::dmat4& parentTransform,
+    TileRefine parentRefine,
+    TileContext& context,
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    bool createChildTilesLazily = false);
+
+/**
+ * @brief Creates the children of a tile whose children were packed by
+ * {@link readTilesetJson}.
+ *
+ * This does nothing if the tile's children were not packed, or have already
+ * been created. The children's own children are not created.
+ *
+ * @param tile The tile.
+ */
+void createPackedChildTiles(Tile& tile);
+
+/**
+ * @brief Creates all of the descendants of a tile whose children were packed
+ * by {@link readTilesetJson}, so that none of them refer to their packed
+ * records any longer.
+ *
+ * @param tile The tile.
+ */
+void createAllPackedChildTiles(Tile& tile);
+
+/**
+ * @brief Writes the tiles of a tileset.json that were packed by
+ * {@link readTilesetJson} in a binary form that can be cached.
+ *
+ * @param tileset The result of reading the tileset.json, which must have a
+ * {@link TilesetJson::rootTileRecord}.
+ * @param context The context whose {@link TileContext::packedTiles} were
+ * written by reading only this tileset.json.
+ * @return The binary form of the tiles.
+ */
+std::vector<std::byte>
+writeTilesetJsonCache(const TilesetJson& tileset, const TileContext& context);
+
+/**
+ * @brief Creates the tiles of a tileset.json from the binary form written by
+ * {@link writeTilesetJsonCache}, without reading the JSON.
+ *
+ * The root tile is created as {@link readTilesetJson} would create it if its
+ * descendants were created lazily.
+ *
+ * @param data The binary form of the tiles.
+ * @param rootTile A blank tile into which to load the root.
+ * @param parentTransform The root tile's parent transform.
+ * @param parentRefine The refinement to use for the root tile if it does not
+ * specify one.
+ * @param context The context of the new tiles, which must not have any packed
+ * tiles yet.
+ * @return The top-level properties of the tileset.json, or `std::nullopt` if
+ * the data was written by an incompatible version or is invalid.
+ */
+std::optional<TilesetJson> readTilesetJsonCache(
+    const gsl::span<const std::byte>& data,
+    Tile& rootTile,
+    const glm::dmat4& parentTransform,
+    TileRefine parentRefine,
+    TileContext& context);
+
+/**
+ * @brief Reads a tileset.json response and creates its tiles, using and
+ * updating a cache of the binary form of its tiles.
+ *
+ * If the response has an `ETag` and the cache has the tiles for it and the
+ * URL, they are created from the cache instead of the JSON. Otherwise the
+ * JSON is read by {@link readTilesetJson}, and its tiles are added to the
+ * cache.
+ *
+ * @param url The URL of the tileset.json.
+ * @param responseHeaders The headers of the tileset.json response.
+ * @param data The tileset.json.
+ * @param rootTile A blank tile into which to load the root.
+ * @param parentTransform The root tile's parent transform.
+ * @param parentRefine The refinement to use for the root tile if it does not
+ * specify one.
+ * @param context The context of the new tiles.
+ * @param pLogger The logger to which to report invalid tiles.
+ * @param createChildTilesLazily Whether to create the root tile's descendants
+ * lazily.
+ * @param pCache The cache, or `nullptr` to always read the JSON.
+ * @return The result of reading the JSON or the cached tiles.
+ */
+CesiumJsonReader::ReadJsonResult<TilesetJson> readTilesetJsonWithCache(
+    const std::string& url,
+    const CesiumAsync::HttpHeaders& responseHeaders,
+    const gsl::span<const std::byte>& data,
+    Tile& rootTile,
+    const glm::dmat4& parentTransform,
+    TileRefine parentRefine,
+    TileContext& context,
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    bool createChildTilesLazily,
+    CesiumAsync::ICacheDatabase* pCache);
+
+} // namespace Cesium3DTilesSelection
@@ -5,6 +5,8 @@
 #include "Cesium3DTilesSelection/GltfContent.h"
 #include "Cesium3DTilesSelection/TileContentFactory.h"
 #include "CompositeContent.h"
+#include "Instanced3DModelContent.h"
+#include "PointCloudContent.h"
 #include "QuantizedMeshContent.h"
 
 namespace Cesium3DTilesSelection {
@@ -18,6 +20,12 @@ void registerAllTileContentTypes() {
   TileContentFactory::registerMagic(
       "cmpt",
       std::make_shared<CompositeContent>());
+  TileContentFactory::registerMagic(
+      "i3dm",
+      std::make_shared<Instanced3DModelContent>());
+  TileContentFactory::registerMagic(
+      "pnts",
+      std::make_shared<PointCloudContent>());
   TileContentFactory::registerMagic(
       "json",
       std::make_shared<ExternalTilesetContent>());
@@ -4,16 +4,20 @@
 
 #include <CesiumGltf/ExtensionMeshPrimitiveExtFeatureMetadata.h>
 #include <CesiumGltf/ExtensionModelExtFeatureMetadata.h>
+#include <CesiumGltf/LazyFeatureMetadata.h>
 #include <CesiumGltf/Model.h>
 #include <CesiumGltf/PropertyType.h>
 #include <CesiumGltf/PropertyTypeTraits.h>
 #include <CesiumUtility/Tracing.h>
+#include <CesiumUtility/parallelFor.h>
 
 #include <glm/glm.hpp>
 #include <rapidjson/document.h>
 #include <rapidjson/writer.h>
 
 #include <map>
+#include <optional>
+#include <thread>
 #include <type_traits>
 
 using namespace CesiumGltf;
@@ -39,6 +43,25 @@ struct CompatibleTypes {
   std::optional<MaskedType> componentType;
   std::optional<uint32_t> minComponentCount;
   std::optional<uint32_t> maxComponentCount;
+
+  // The sizes of the converted values, which are gathered while inferring the
+  // types so that the buffers can be allocated up front.
+  uint64_t totalComponentCount = 0;
+  uint64_t totalStringByteLength = 0;
+  bool hasNonStringValues = false;
+  bool hasNonStringComponents = false;
+};
+
+/**
+ * @brief The buffers of a JSON property, before they are added to the glTF.
+ *
+ * Properties are converted concurrently, so each one writes to its own buffers
+ * and they are added to the glTF afterwards, in the order of the batch table.
+ */
+struct ConvertedJsonProperty {
+  std::vector<std::byte> valueBuffer;
+  std::optional<std::vector<std::byte>> stringOffsetBuffer;
+  std::optional<std::vector<std::byte>> arrayOffsetBuffer;
 };
 
 struct BinaryProperty {
@@ -102,12 +125,40 @@ void copyStringBuffer(
   }
 }
 
-CompatibleTypes findCompatibleTypes(const rapidjson::Value& propertyValue) {
+PropertyType findOffsetType(uint64_t maxOffset) noexcept {
+  if (isInRangeForUnsignedInteger<uint8_t>(maxOffset)) {
+    return PropertyType::Uint8;
+  }
+
+  if (isInRangeForUnsignedInteger<uint16_t>(maxOffset)) {
+    return PropertyType::Uint16;
+  }
+
+  if (isInRangeForUnsignedInteger<uint32_t>(maxOffset)) {
+    return PropertyType::Uint32;
+  }
+
+  return PropertyType::Uint64;
+}
+
+CompatibleTypes
+findCompatibleTypes(const rapidjson::Value& propertyValue, int64_t count) {
   MaskedType type;
   std::optional<MaskedType> componentType;
   std::optional<uint32_t> minComponentCount;
   std::optional<uint32_t> maxComponentCount;
-  for (auto it = propertyValue.Begin(); it != propertyValue.End(); ++it) {
+  uint64_t totalComponentCount = 0;
+  uint64_t totalStringByteLength = 0;
+  bool hasNonStringValues = false;
+  bool hasNonStringComponents = false;
+  int64_t index = 0;
+  for (auto it = propertyValue.Begin(); it != propertyValue.End();
+       ++it, ++index) {
+    // Only the first count values are converted, so only they contribute to
+    // the sizes of the buffers.
+    const bool isConverted = index < count;
+    hasNonStringValues |= isConverted && !it->IsString();
+
     if (it->IsBool()) {
       // Should we allow conversion of bools to numeric 0 or 1? Nah.
       type.isInt8 = type.isUint8 = false;
@@ -171,7 +222,8 @@ CompatibleTypes findCompatibleTypes(const rapidjson::Value& propertyValue) {
       type.isFloat64 = false;
       type.isBool = false;
       type.isArray &= true;
-      CompatibleTypes currentComponentType = findCompatibleTypes(*it);
+      CompatibleTypes currentComponentType =
+          findCompatibleTypes(*it, static_cast<int64_t>(it->Size()));
       if (!componentType) {
         componentType = currentComponentType.type;
       } else {
@@ -195,6 +247,12 @@ CompatibleTypes findCompatibleTypes(const rapidjson::Value& propertyValue) {
       minComponentCount = minComponentCount
                               ? glm::min(*minComponentCount, it->Size())
                               : it->Size();
+
+      if (isConverted) {
+        totalComponentCount += it->Size();
+        totalStringByteLength += currentComponentType.totalStringByteLength;
+        hasNonStringComponents |= currentComponentType.hasNonStringValues;
+      }
     } else {
       // A string, null, or something else.
       type.isInt8 = type.isUint8 = false;
@@ -205,19 +263,114 @@ CompatibleTypes findCompatibleTypes(const rapidjson::Value& propertyValue) {
       type.isFloat64 = false;
       type.isBool = false;
       type.isArray = false;
+
+      if (isConverted && it->IsString()) {
+        totalStringByteLength +=
+            it->GetStringLength() * sizeof(rapidjson::Value::Ch);
+      }
     }
   }
 
-  return {type, componentType, minComponentCount, maxComponentCount};
+  return {
+      type,
+      componentType,
+      minComponentCount,
+      maxComponentCount,
+      totalComponentCount,
+      totalStringByteLength,
+      hasNonStringValues,
+      hasNonStringComponents};
+}
+
+template <typename OffsetType>
+void copyJsonStringBuffers(
+    std::vector<std::byte>& valueBuffer,
+    std::vector<std::byte>& offsetBuffer,
+    size_t totalByteLength,
+    const FeatureTable& featureTable,
+    const rapidjson::Value& propertyValue) {
+  valueBuffer.resize(totalByteLength);
+  offsetBuffer.resize(
+      sizeof(OffsetType) * static_cast<size_t>(featureTable.count + 1));
+  OffsetType* offset = reinterpret_cast<OffsetType*>(offsetBuffer.data());
+  OffsetType prevOffset = 0;
+
+  // Features past the end of the array are empty strings.
+  const int64_t numOfStrings =
+      glm::min(featureTable.count, static_cast<int64_t>(propertyValue.Size()));
+  const auto& jsonArray = propertyValue.GetArray();
+  for (int64_t i = 0; i < numOfStrings; ++i) {
+    const auto& str = jsonArray[static_cast<rapidjson::SizeType>(i)];
+    const size_t byteLength =
+        str.GetStringLength() * sizeof(rapidjson::Value::Ch);
+    std::memcpy(valueBuffer.data() + prevOffset, str.GetString(), byteLength);
+    *offset = prevOffset;
+    ++offset;
+    prevOffset = static_cast<OffsetType>(prevOffset + byteLength);
+  }
+
+  for (int64_t i = numOfStrings; i <= featureTable.count; ++i) {
+    *offset = prevOffset;
+    ++offset;
+  }
 }
 
 void updateExtensionWithJsonStringProperty(
-    Model& gltf,
+    ConvertedJsonProperty& convertedProperty,
     ClassProperty& classProperty,
     const FeatureTable& featureTable,
     FeatureTableProperty& featureTableProperty,
+    const CompatibleTypes& compatibleTypes,
     const rapidjson::Value& propertyValue) {
-  assert(propertyValue.Size() >= featureTable.count);
+  classProperty.type = "STRING";
+
+  std::vector<std::byte>& buffer = convertedProperty.valueBuffer;
+  std::vector<std::byte>& offsetBuffer =
+      convertedProperty.stringOffsetBuffer.emplace();
+
+  if (!compatibleTypes.hasNonStringValues) {
+    // The length of every string is already known, so copy them straight into
+    // a buffer of the right size.
+    const uint64_t totalSize = compatibleTypes.totalStringByteLength;
+    const PropertyType offsetType = findOffsetType(totalSize);
+    featureTableProperty.offsetType = convertPropertyTypeToString(offsetType);
+    switch (offsetType) {
+    case PropertyType::Uint8:
+      copyJsonStringBuffers<uint8_t>(
+          buffer,
+          offsetBuffer,
+          totalSize,
+          featureTable,
+          propertyValue);
+      break;
+    case PropertyType::Uint16:
+      copyJsonStringBuffers<uint16_t>(
+          buffer,
+          offsetBuffer,
+          totalSize,
+          featureTable,
+          propertyValue);
+      break;
+    case PropertyType::Uint32:
+      copyJsonStringBuffers<uint32_t>(
+          buffer,
+          offsetBuffer,
+          totalSize,
+          featureTable,
+          propertyValue);
+      break;
+    default:
+      copyJsonStringBuffers<uint64_t>(
+          buffer,
+          offsetBuffer,
+          totalSize,
+          featureTable,
+          propertyValue);
+      break;
+    }
+
+    return;
+  }
 
   rapidjson::StringBuffer rapidjsonStrBuffer;
   std::vector<uint64_t> rapidjsonOffsets;
@@ -226,10 +379,13 @@ void updateExtensionWithJsonStringProperty(
 
   auto it = propertyValue.Begin();
   for (int64_t i = 0; i < featureTable.count; ++i) {
-    if (!it->IsString()) {
+    if (it == propertyValue.End()) {
+      // Features past the end of the array are empty strings.
+    } else if (!it->IsString()) {
       // Everything else that is not string will be serialized by json
       rapidjson::Writer<rapidjson::StringBuffer> writer(rapidjsonStrBuffer);
       it->Accept(writer);
+      ++it;
     } else {
       // Because serialized string json will add double quotations in the buffer
       // which is not needed by us, we will manually add the string to the
@@ -239,15 +395,13 @@ void updateExtensionWithJsonStringProperty(
       for (rapidjson::SizeType j = 0; j < it->GetStringLength(); ++j) {
         rapidjsonStrBuffer.PutUnsafe(rapidjsonStr[j]);
       }
+      ++it;
     }
 
     rapidjsonOffsets.emplace_back(rapidjsonStrBuffer.GetLength());
-    ++it;
   }
 
   const uint64_t totalSize = rapidjsonOffsets.back();
-  std::vector<std::byte> buffer;
-  std::vector<std::byte> offsetBuffer;
   if (isInRangeForUnsignedInteger<uint8_t>(totalSize)) {
     copyStringBuffer<uint8_t>(
         rapidjsonStrBuffer,
@@ -277,64 +431,23 @@ void updateExtensionWithJsonStringProperty(
         offsetBuffer);
     featureTableProperty.offsetType = "UINT64";
   }
-
-  Buffer& gltfBuffer = gltf.buffers.emplace_back();
-  gltfBuffer.byteLength = static_cast<int64_t>(buffer.size());
-  gltfBuffer.cesium.data = std::move(buffer);
-
-  BufferView& gltfBufferView = gltf.bufferViews.emplace_back();
-  gltfBufferView.buffer = static_cast<int32_t>(gltf.buffers.size() - 1);
-  gltfBufferView.byteOffset = 0;
-  gltfBufferView.byteLength = static_cast<int64_t>(totalSize);
-  const int32_t valueBufferViewIdx =
-      static_cast<int32_t>(gltf.bufferViews.size() - 1);
-
-  Buffer& gltfOffsetBuffer = gltf.buffers.emplace_back();
-  gltfOffsetBuffer.byteLength = static_cast<int64_t>(offsetBuffer.size());
-  gltfOffsetBuffer.cesium.data = std::move(offsetBuffer);
-
-  BufferView& gltfOffsetBufferView = gltf.bufferViews.emplace_back();
-  gltfOffsetBufferView.buffer = static_cast<int32_t>(gltf.buffers.size() - 1);
-  gltfOffsetBufferView.byteOffset = 0;
-  gltfOffsetBufferView.byteLength =
-      static_cast<int64_t>(gltfOffsetBuffer.cesium.data.size());
-  const int32_t offsetBufferViewIdx =
-      static_cast<int32_t>(gltf.bufferViews.size() - 1);
-
-  classProperty.type = "STRING";
-
-  featureTableProperty.bufferView = valueBufferViewIdx;
-  featureTableProperty.stringOffsetBufferView = offsetBufferViewIdx;
 }
 
 template <typename T, typename TRapidJson = T>
 void updateExtensionWithJsonNumericProperty(
-    Model& gltf,
+    ConvertedJsonProperty& convertedProperty,
     ClassProperty& classProperty,
     const FeatureTable& featureTable,
-    FeatureTableProperty& featureTableProperty,
     const rapidjson::Value& propertyValue,
     const std::string& typeName) {
   assert(propertyValue.Size() >= featureTable.count);
 
   classProperty.type = typeName;
 
-  // Create a new buffer for this property.
-  const size_t bufferIndex = gltf.buffers.size();
-  Buffer& buffer = gltf.buffers.emplace_back();
-  buffer.byteLength =
-      static_cast<int64_t>(sizeof(T) * static_cast<size_t>(featureTable.count));
-  buffer.cesium.data.resize(static_cast<size_t>(buffer.byteLength));
-
-  const size_t bufferViewIndex = gltf.bufferViews.size();
-  BufferView& bufferView = gltf.bufferViews.emplace_back();
-  bufferView.buffer = int32_t(bufferIndex);
-  bufferView.byteOffset = 0;
-  bufferView.byteLength = buffer.byteLength;
+  std::vector<std::byte>& buffer = convertedProperty.valueBuffer;
+  buffer.resize(sizeof(T) * static_cast<size_t>(featureTable.count));
 
-  featureTableProperty.bufferView = int32_t(bufferViewIndex);
-
-  T* p = reinterpret_cast<T*>(buffer.cesium.data.data());
+  T* p = reinterpret_cast<T*>(buffer.data());
   auto it = propertyValue.Begin();
   for (int64_t i = 0; i < featureTable.count; ++i) {
     *p = static_cast<T>(it->Get<TRapidJson>());
@@ -344,14 +457,14 @@ void updateExtensionWithJsonNumericProperty(
 }
 
 void updateExtensionWithJsonBoolProperty(
-    Model& gltf,
+    ConvertedJsonProperty& convertedProperty,
     ClassProperty& classProperty,
     const FeatureTable& featureTable,
-    FeatureTableProperty& featureTableProperty,
     const rapidjson::Value& propertyValue) {
   assert(propertyValue.Size() >= featureTable.count);
 
-  std::vector<std::byte> data(static_cast<size_t>(
+  std::vector<std::byte>& data = convertedProperty.valueBuffer;
+  data.resize(static_cast<size_t>(
       glm::ceil(static_cast<double>(featureTable.count) / 8.0)));
   const auto& jsonArray = propertyValue.GetArray();
   for (rapidjson::SizeType i = 0;
@@ -364,19 +477,6 @@ void updateExtensionWithJsonBoolProperty(
         static_cast<std::byte>(value << bitIndex) | data[byteIndex];
   }
 
-  const size_t bufferIndex = gltf.buffers.size();
-  Buffer& buffer = gltf.buffers.emplace_back();
-  buffer.byteLength = static_cast<int64_t>(data.size());
-  buffer.cesium.data = std::move(data);
-
-  BufferView& bufferView = gltf.bufferViews.emplace_back();
-  bufferView.buffer = static_cast<int32_t>(bufferIndex);
-  bufferView.byteOffset = 0;
-  bufferView.byteLength = buffer.byteLength;
-
-  featureTableProperty.bufferView =
-      static_cast<int32_t>(gltf.bufferViews.size() - 1);
-
   classProperty.type = "BOOLEAN";
 }
 
@@ -413,7 +513,7 @@ void copyNumericDynamicArrayBuffers(
 
 template <typename TRapidjson, typename ValueType>
 void updateNumericArrayProperty(
-    Model& gltf,
+    ConvertedJsonProperty& convertedProperty,
     ClassProperty& classProperty,
     FeatureTableProperty& featureTableProperty,
     const FeatureTable& featureTable,
@@ -422,11 +522,17 @@ void updateNumericArrayProperty(
   assert(propertyValue.Size() >= featureTable.count);
   const auto& jsonOuterArray = propertyValue.GetArray();
 
+  classProperty.type = "ARRAY";
+  classProperty.componentType = convertPropertyTypeToString(
+      static_cast<PropertyType>(TypeToPropertyType<ValueType>::value));
+
+  std::vector<std::byte>& valueBuffer = convertedProperty.valueBuffer;
+
   // check if it's a fixed array
   if (compatibleTypes.minComponentCount == compatibleTypes.maxComponentCount) {
-    const size_t numOfValues = static_cast<size_t>(featureTable.count) *
-                               *compatibleTypes.minComponentCount;
-    std::vector<std::byte> valueBuffer(sizeof(ValueType) * numOfValues);
+    valueBuffer.resize(
+        sizeof(ValueType) *
+        static_cast<size_t>(compatibleTypes.totalComponentCount));
     ValueType* value = reinterpret_cast<ValueType*>(valueBuffer.data());
     for (int64_t i = 0; i < featureTable.count; ++i) {
       const auto& jsonArrayMember =
@@ -437,122 +543,95 @@ void updateNumericArrayProperty(
       }
     }
 
-    Buffer& gltfValueBuffer = gltf.buffers.emplace_back();
-    gltfValueBuffer.byteLength = static_cast<int64_t>(valueBuffer.size());
-    gltfValueBuffer.cesium.data = std::move(valueBuffer);
-
-    BufferView& gltfValueBufferView = gltf.bufferViews.emplace_back();
-    gltfValueBufferView.buffer = static_cast<int32_t>(gltf.buffers.size() - 1);
-    gltfValueBufferView.byteOffset = 0;
-    gltfValueBufferView.byteLength =
-        static_cast<int64_t>(gltfValueBuffer.cesium.data.size());
-
-    classProperty.type = "ARRAY";
-    classProperty.componentType = convertPropertyTypeToString(
-        static_cast<PropertyType>(TypeToPropertyType<ValueType>::value));
     classProperty.componentCount = *compatibleTypes.minComponentCount;
-
-    featureTableProperty.bufferView =
-        static_cast<int32_t>(gltf.bufferViews.size() - 1);
-
     return;
   }
 
-  // total size of value buffer
-  size_t numOfElements = 0;
-  for (int64_t i = 0; i < featureTable.count; ++i) {
-    const auto& jsonArrayMember =
-        jsonOuterArray[static_cast<rapidjson::SizeType>(i)];
-    numOfElements += jsonArrayMember.Size();
-  }
-
-  PropertyType offsetType = PropertyType::None;
-  std::vector<std::byte> valueBuffer;
-  std::vector<std::byte> offsetBuffer;
-  const uint64_t maxOffsetValue = numOfElements * sizeof(ValueType);
-  if (isInRangeForUnsignedInteger<uint8_t>(maxOffsetValue)) {
+  const size_t numOfElements =
+      static_cast<size_t>(compatibleTypes.totalComponentCount);
+  std::vector<std::byte>& offsetBuffer =
+      convertedProperty.arrayOffsetBuffer.emplace();
+  const PropertyType offsetType =
+      findOffsetType(numOfElements * sizeof(ValueType));
+  switch (offsetType) {
+  case PropertyType::Uint8:
     copyNumericDynamicArrayBuffers<TRapidjson, ValueType, uint8_t>(
         valueBuffer,
         offsetBuffer,
         numOfElements,
         featureTable,
         propertyValue);
-    offsetType = PropertyType::Uint8;
-  } else if (isInRangeForUnsignedInteger<uint16_t>(maxOffsetValue)) {
+    break;
+  case PropertyType::Uint16:
     copyNumericDynamicArrayBuffers<TRapidjson, ValueType, uint16_t>(
         valueBuffer,
         offsetBuffer,
         numOfElements,
         featureTable,
         propertyValue);
-    offsetType = PropertyType::Uint16;
-  } else if (isInRangeForUnsignedInteger<uint32_t>(maxOffsetValue)) {
+    break;
+  case PropertyType::Uint32:
     copyNumericDynamicArrayBuffers<TRapidjson, ValueType, uint32_t>(
         valueBuffer,
         offsetBuffer,
         numOfElements,
         featureTable,
         propertyValue);
-    offsetType = PropertyType::Uint32;
-  } else if (isInRangeForUnsignedInteger<uint64_t>(maxOffsetValue)) {
+    break;
+  default:
     copyNumericDynamicArrayBuffers<TRapidjson, ValueType, uint64_t>(
         valueBuffer,
         offsetBuffer,
         numOfElements,
         featureTable,
         propertyValue);
-    offsetType = PropertyType::Uint64;
+    break;
   }
 
-  Buffer& gltfValueBuffer = gltf.buffers.emplace_back();
-  gltfValueBuffer.byteLength = static_cast<int64_t>(valueBuffer.size());
-  gltfValueBuffer.cesium.data = std::move(valueBuffer);
-
-  BufferView& gltfValueBufferView = gltf.bufferViews.emplace_back();
-  gltfValueBufferView.buffer = static_cast<int32_t>(gltf.buffers.size() - 1);
-  gltfValueBufferView.byteOffset = 0;
-  gltfValueBufferView.byteLength =
-      static_cast<int64_t>(gltfValueBuffer.cesium.data.size());
-  const int32_t valueBufferIdx =
-      static_cast<int32_t>(gltf.bufferViews.size() - 1);
-
-  Buffer& gltfOffsetBuffer = gltf.buffers.emplace_back();
-  gltfOffsetBuffer.byteLength = static_cast<int64_t>(offsetBuffer.size());
-  gltfOffsetBuffer.cesium.data = std::move(offsetBuffer);
-
-  BufferView& gltfOffsetBufferView = gltf.bufferViews.emplace_back();
-  gltfOffsetBufferView.buffer = static_cast<int32_t>(gltf.buffers.size() - 1);
-  gltfOffsetBufferView.byteOffset = 0;
-  gltfOffsetBufferView.byteLength =
-      static_cast<int64_t>(gltfOffsetBuffer.cesium.data.size());
-  const int32_t offsetBufferIdx =
-      static_cast<int32_t>(gltf.bufferViews.size() - 1);
-
-  classProperty.type = "ARRAY";
-  classProperty.componentType = convertPropertyTypeToString(
-      static_cast<PropertyType>(TypeToPropertyType<ValueType>::value));
-
-  featureTableProperty.bufferView = valueBufferIdx;
-  featureTableProperty.arrayOffsetBufferView = offsetBufferIdx;
   featureTableProperty.offsetType = convertPropertyTypeToString(offsetType);
 }
 
+template <typename OffsetType>
+bool isInRangeForStringArrayOffsets(
+    uint64_t totalByteLength,
+    uint64_t numOfString,
+    bool isFixedArray) noexcept {
+  // The array offsets of a dynamic array point into the string offsets, so
+  // they must fit in the offset type, too.
+  return isInRangeForUnsignedInteger<OffsetType>(totalByteLength) &&
+         (isFixedArray || isInRangeForUnsignedInteger<OffsetType>(
+                              numOfString * sizeof(OffsetType)));
+}
+
 template <typename OffsetType>
 void copyStringArrayBuffers(
     std::vector<std::byte>& valueBuffer,
     std::vector<std::byte>& offsetBuffer,
+    std::vector<std::byte>* pArrayOffsetBuffer,
     size_t totalByteLength,
     size_t numOfString,
     const FeatureTable& featureTable,
     const rapidjson::Value& propertyValue) {
   valueBuffer.resize(totalByteLength);
   offsetBuffer.resize((numOfString + 1) * sizeof(OffsetType));
+  OffsetType* arrayOffset = nullptr;
+  if (pArrayOffsetBuffer) {
+    pArrayOffsetBuffer->resize(
+        static_cast<size_t>(featureTable.count + 1) * sizeof(OffsetType));
+    arrayOffset = reinterpret_cast<OffsetType*>(pArrayOffsetBuffer->data());
+  }
+
   OffsetType offset = 0;
   size_t offsetIndex = 0;
   const auto& jsonOuterArray = propertyValue.GetArray();
   for (int64_t i = 0; i < featureTable.count; ++i) {
     const auto& arrayMember =
         jsonOuterArray[static_cast<rapidjson::SizeType>(i)];
+    if (arrayOffset) {
+      arrayOffset[i] =
+          static_cast<OffsetType>(offsetIndex * sizeof(OffsetType));
+    }
+
     for (const auto& str : arrayMember.GetArray()) {
       OffsetType byteLength = static_cast<OffsetType>(
           str.GetStringLength() * sizeof(rapidjson::Value::Ch));
@@ -570,32 +649,14 @@ void copyStringArrayBuffers(
       offsetBuffer.data() + offsetIndex * sizeof(OffsetType),
       &offset,
       sizeof(OffsetType));
-}
-
-template <typename OffsetType>
-void copyArrayOffsetBufferForStringArrayProperty(
-    std::vector<std::byte>& offsetBuffer,
-    const FeatureTable& featureTable,
-    const rapidjson::Value& propertyValue) {
-  OffsetType prevOffset = 0;
-  offsetBuffer.resize(
-      static_cast<size_t>(featureTable.count + 1) * sizeof(OffsetType));
-  OffsetType* offset = reinterpret_cast<OffsetType*>(offsetBuffer.data());
-  const auto& jsonOuterArray = propertyValue.GetArray();
-  for (int64_t i = 0; i < featureTable.count; ++i) {
-    const auto& arrayMember =
-        jsonOuterArray[static_cast<rapidjson::SizeType>(i)];
-    *offset = prevOffset;
-    prevOffset = static_cast<OffsetType>(
-        prevOffset + arrayMember.Size() * sizeof(OffsetType));
-    ++offset;
+  if (arrayOffset) {
+    arrayOffset[featureTable.count] =
+        static_cast<OffsetType>(offsetIndex * sizeof(OffsetType));
   }
-
-  *offset = prevOffset;
 }
 
 void updateStringArrayProperty(
-    Model& gltf,
+    ConvertedJsonProperty& convertedProperty,
     ClassProperty& classProperty,
     FeatureTableProperty& featureTableProperty,
     const FeatureTable& featureTable,
@@ -603,148 +664,84 @@ void updateStringArrayProperty(
     const rapidjson::Value& propertyValue) {
   assert(propertyValue.Size() >= featureTable.count);
 
-  size_t numOfString = 0;
-  size_t totalChars = 0;
-  const auto& jsonOuterArray = propertyValue.GetArray();
-  for (int64_t i = 0; i < featureTable.count; ++i) {
-    const auto& arrayMember =
-        jsonOuterArray[static_cast<rapidjson::SizeType>(i)];
-    numOfString += arrayMember.Size();
-    for (const auto& str : arrayMember.GetArray()) {
-      totalChars += str.GetStringLength();
-    }
+  const size_t numOfString =
+      static_cast<size_t>(compatibleTypes.totalComponentCount);
+  const uint64_t totalByteLength = compatibleTypes.totalStringByteLength;
+
+  const bool isFixedArray =
+      compatibleTypes.minComponentCount == compatibleTypes.maxComponentCount;
+  PropertyType offsetType = PropertyType::Uint64;
+  if (isInRangeForStringArrayOffsets<uint8_t>(
+          totalByteLength,
+          numOfString,
+          isFixedArray)) {
+    offsetType = PropertyType::Uint8;
+  } else if (isInRangeForStringArrayOffsets<uint16_t>(
+                 totalByteLength,
+                 numOfString,
+                 isFixedArray)) {
+    offsetType = PropertyType::Uint16;
+  } else if (isInRangeForStringArrayOffsets<uint32_t>(
+                 totalByteLength,
+                 numOfString,
+                 isFixedArray)) {
+    offsetType = PropertyType::Uint32;
   }
 
-  const uint64_t totalByteLength = totalChars * sizeof(rapidjson::Value::Ch);
-  std::vector<std::byte> valueBuffer;
-  std::vector<std::byte> offsetBuffer;
-  PropertyType offsetType = PropertyType::None;
-  if (isInRangeForUnsignedInteger<uint8_t>(totalByteLength)) {
+  std::vector<std::byte>& valueBuffer = convertedProperty.valueBuffer;
+  std::vector<std::byte>& offsetBuffer =
+      convertedProperty.stringOffsetBuffer.emplace();
+  std::vector<std::byte>* pArrayOffsetBuffer =
+      isFixedArray ? nullptr : &convertedProperty.arrayOffsetBuffer.emplace();
+  switch (offsetType) {
+  case PropertyType::Uint8:
     copyStringArrayBuffers<uint8_t>(
         valueBuffer,
         offsetBuffer,
+        pArrayOffsetBuffer,
         totalByteLength,
         numOfString,
         featureTable,
         propertyValue);
-    offsetType = PropertyType::Uint8;
-  } else if (isInRangeForUnsignedInteger<uint16_t>(totalByteLength)) {
+    break;
+  case PropertyType::Uint16:
     copyStringArrayBuffers<uint16_t>(
         valueBuffer,
         offsetBuffer,
+        pArrayOffsetBuffer,
         totalByteLength,
         numOfString,
         featureTable,
         propertyValue);
-    offsetType = PropertyType::Uint16;
-  } else if (isInRangeForUnsignedInteger<uint32_t>(totalByteLength)) {
+    break;
+  case PropertyType::Uint32:
     copyStringArrayBuffers<uint32_t>(
         valueBuffer,
         offsetBuffer,
+        pArrayOffsetBuffer,
         totalByteLength,
         numOfString,
         featureTable,
         propertyValue);
-    offsetType = PropertyType::Uint32;
-  } else if (isInRangeForUnsignedInteger<uint64_t>(totalByteLength)) {
+    break;
+  default:
     copyStringArrayBuffers<uint64_t>(
         valueBuffer,
         offsetBuffer,
+        pArrayOffsetBuffer,
         totalByteLength,
         numOfString,
         featureTable,
         propertyValue);
-    offsetType = PropertyType::Uint64;
-  }
-
-  // create gltf value buffer view
-  Buffer& gltfValueBuffer = gltf.buffers.emplace_back();
-  gltfValueBuffer.byteLength = static_cast<int64_t>(valueBuffer.size());
-  gltfValueBuffer.cesium.data = std::move(valueBuffer);
-
-  BufferView& gltfValueBufferView = gltf.bufferViews.emplace_back();
-  gltfValueBufferView.buffer =
-      static_cast<std::int32_t>(gltf.buffers.size() - 1);
-  gltfValueBufferView.byteOffset = 0;
-  gltfValueBufferView.byteLength = gltfValueBuffer.byteLength;
-  const int32_t valueBufferViewIdx =
-      static_cast<int32_t>(gltf.bufferViews.size() - 1);
-
-  // create gltf string offset buffer view
-  Buffer& gltfOffsetBuffer = gltf.buffers.emplace_back();
-  gltfOffsetBuffer.byteLength = static_cast<int64_t>(offsetBuffer.size());
-  gltfOffsetBuffer.cesium.data = std::move(offsetBuffer);
-
-  BufferView& gltfOffsetBufferView = gltf.bufferViews.emplace_back();
-  gltfOffsetBufferView.buffer = static_cast<int32_t>(gltf.buffers.size() - 1);
-  gltfOffsetBufferView.byteOffset = 0;
-  gltfOffsetBufferView.byteLength = gltfOffsetBuffer.byteLength;
-  const int32_t offsetBufferViewIdx =
-      static_cast<int32_t>(gltf.bufferViews.size() - 1);
-
-  // fixed array of string
-  if (compatibleTypes.minComponentCount == compatibleTypes.maxComponentCount) {
-    classProperty.type = "ARRAY";
-    classProperty.componentCount = compatibleTypes.minComponentCount;
-    classProperty.componentType = "STRING";
-
-    featureTableProperty.bufferView = valueBufferViewIdx;
-    featureTableProperty.stringOffsetBufferView = offsetBufferViewIdx;
-    featureTableProperty.offsetType = convertPropertyTypeToString(offsetType);
-    return;
-  }
-
-  // dynamic array of string needs array offset buffer
-  std::vector<std::byte> arrayOffsetBuffer;
-  switch (offsetType) {
-  case PropertyType::Uint8:
-    copyArrayOffsetBufferForStringArrayProperty<uint8_t>(
-        arrayOffsetBuffer,
-        featureTable,
-        propertyValue);
-    break;
-  case PropertyType::Uint16:
-    copyArrayOffsetBufferForStringArrayProperty<uint16_t>(
-        arrayOffsetBuffer,
-        featureTable,
-        propertyValue);
-    break;
-  case PropertyType::Uint32:
-    copyArrayOffsetBufferForStringArrayProperty<uint32_t>(
-        arrayOffsetBuffer,
-        featureTable,
-        propertyValue);
-    break;
-  case PropertyType::Uint64:
-    copyArrayOffsetBufferForStringArrayProperty<uint64_t>(
-        arrayOffsetBuffer,
-        featureTable,
-        propertyValue);
-    break;
-  default:
     break;
   }
 
-  // create gltf array offset buffer view
-  Buffer& gltfArrayOffsetBuffer = gltf.buffers.emplace_back();
-  gltfArrayOffsetBuffer.byteLength =
-      static_cast<int64_t>(arrayOffsetBuffer.size());
-  gltfArrayOffsetBuffer.cesium.data = std::move(arrayOffsetBuffer);
-
-  BufferView& gltfArrayOffsetBufferView = gltf.bufferViews.emplace_back();
-  gltfArrayOffsetBufferView.buffer =
-      static_cast<int32_t>(gltf.buffers.size() - 1);
-  gltfArrayOffsetBufferView.byteOffset = 0;
-  gltfArrayOffsetBufferView.byteLength = gltfArrayOffsetBuffer.byteLength;
-  const int32_t arrayOffsetBufferViewIdx =
-      static_cast<int32_t>(gltf.bufferViews.size() - 1);
-
   classProperty.type = "ARRAY";
   classProperty.componentType = "STRING";
+  if (isFixedArray) {
+    classProperty.componentCount = compatibleTypes.minComponentCount;
+  }
 
-  featureTableProperty.bufferView = valueBufferViewIdx;
-  featureTableProperty.arrayOffsetBufferView = arrayOffsetBufferViewIdx;
-  featureTableProperty.stringOffsetBufferView = offsetBufferViewIdx;
   featureTableProperty.offsetType = convertPropertyTypeToString(offsetType);
 }
 
@@ -785,7 +782,7 @@ void copyBooleanArrayBuffers(
 }
 
 void updateBooleanArrayProperty(
-    Model& gltf,
+    ConvertedJsonProperty& convertedProperty,
     ClassProperty& classProperty,
     FeatureTableProperty& featureTableProperty,
     const FeatureTable& featureTable,
@@ -793,13 +790,18 @@ void updateBooleanArrayProperty(
     const rapidjson::Value& propertyValue) {
   assert(propertyValue.Size() >= featureTable.count);
 
+  classProperty.type = "ARRAY";
+  classProperty.componentType = "BOOLEAN";
+
+  const size_t numOfElements =
+      static_cast<size_t>(compatibleTypes.totalComponentCount);
+  std::vector<std::byte>& valueBuffer = convertedProperty.valueBuffer;
+
   // fixed array of boolean
   if (compatibleTypes.minComponentCount == compatibleTypes.maxComponentCount) {
-    const size_t numOfElements = static_cast<size_t>(
-        featureTable.count * compatibleTypes.minComponentCount.value());
     const size_t totalByteLength = static_cast<size_t>(
         glm::ceil(static_cast<double>(numOfElements) / 8.0));
-    std::vector<std::byte> valueBuffer(totalByteLength);
+    valueBuffer.resize(totalByteLength);
     size_t currentIndex = 0;
     const auto& jsonOuterArray = propertyValue.GetArray();
     for (int64_t i = 0; i < featureTable.count; ++i) {
@@ -815,105 +817,54 @@ void updateBooleanArrayProperty(
       }
     }
 
-    Buffer& gltfValueBuffer = gltf.buffers.emplace_back();
-    gltfValueBuffer.byteLength = static_cast<int64_t>(valueBuffer.size());
-    gltfValueBuffer.cesium.data = std::move(valueBuffer);
-
-    BufferView& gltfValueBufferView = gltf.bufferViews.emplace_back();
-    gltfValueBufferView.buffer = static_cast<int32_t>(gltf.buffers.size() - 1);
-    gltfValueBufferView.byteOffset = 0;
-    gltfValueBufferView.byteLength = gltfValueBuffer.byteLength;
-
-    classProperty.type = "ARRAY";
     classProperty.componentCount = compatibleTypes.minComponentCount;
-    classProperty.componentType = "BOOLEAN";
-
-    featureTableProperty.bufferView =
-        static_cast<int32_t>(gltf.bufferViews.size() - 1);
-
     return;
   }
 
   // dynamic array of boolean
-  size_t numOfElements = 0;
-  const auto& jsonOuterArray = propertyValue.GetArray();
-  for (int64_t i = 0; i < featureTable.count; ++i) {
-    const auto& arrayMember =
-        jsonOuterArray[static_cast<rapidjson::SizeType>(i)];
-    numOfElements += arrayMember.Size();
-  }
-
-  std::vector<std::byte> valueBuffer;
-  std::vector<std::byte> offsetBuffer;
-  PropertyType offsetType = PropertyType::None;
-  if (isInRangeForUnsignedInteger<uint8_t>(numOfElements)) {
+  std::vector<std::byte>& offsetBuffer =
+      convertedProperty.arrayOffsetBuffer.emplace();
+  const PropertyType offsetType = findOffsetType(numOfElements);
+  switch (offsetType) {
+  case PropertyType::Uint8:
     copyBooleanArrayBuffers<uint8_t>(
         valueBuffer,
         offsetBuffer,
         numOfElements,
         featureTable,
         propertyValue);
-    offsetType = PropertyType::Uint8;
-  } else if (isInRangeForUnsignedInteger<uint16_t>(numOfElements)) {
+    break;
+  case PropertyType::Uint16:
     copyBooleanArrayBuffers<uint16_t>(
         valueBuffer,
         offsetBuffer,
         numOfElements,
         featureTable,
         propertyValue);
-    offsetType = PropertyType::Uint16;
-  } else if (isInRangeForUnsignedInteger<uint32_t>(numOfElements)) {
+    break;
+  case PropertyType::Uint32:
     copyBooleanArrayBuffers<uint32_t>(
         valueBuffer,
         offsetBuffer,
         numOfElements,
         featureTable,
         propertyValue);
-    offsetType = PropertyType::Uint32;
-  } else {
+    break;
+  default:
     copyBooleanArrayBuffers<uint64_t>(
         valueBuffer,
         offsetBuffer,
         numOfElements,
         featureTable,
         propertyValue);
-    offsetType = PropertyType::Uint64;
+    break;
   }
 
-  Buffer& gltfValueBuffer = gltf.buffers.emplace_back();
-  gltfValueBuffer.byteLength = static_cast<int64_t>(valueBuffer.size());
-  gltfValueBuffer.cesium.data = std::move(valueBuffer);
-
-  BufferView& gltfValueBufferView = gltf.bufferViews.emplace_back();
-  gltfValueBufferView.buffer = static_cast<int32_t>(gltf.buffers.size() - 1);
-  gltfValueBufferView.byteOffset = 0;
-  gltfValueBufferView.byteLength =
-      static_cast<int64_t>(gltfValueBuffer.cesium.data.size());
-  const int32_t valueBufferIdx =
-      static_cast<int32_t>(gltf.bufferViews.size() - 1);
-
-  Buffer& gltfOffsetBuffer = gltf.buffers.emplace_back();
-  gltfOffsetBuffer.byteLength = static_cast<int64_t>(offsetBuffer.size());
-  gltfOffsetBuffer.cesium.data = std::move(offsetBuffer);
-
-  BufferView& gltfOffsetBufferView = gltf.bufferViews.emplace_back();
-  gltfOffsetBufferView.buffer = static_cast<int32_t>(gltf.buffers.size() - 1);
-  gltfOffsetBufferView.byteOffset = 0;
-  gltfOffsetBufferView.byteLength =
-      static_cast<int64_t>(gltfOffsetBuffer.cesium.data.size());
-  const int32_t offsetBufferIdx =
-      static_cast<int32_t>(gltf.bufferViews.size() - 1);
-
-  classProperty.type = "ARRAY";
-  classProperty.componentType = "BOOLEAN";
-
-  featureTableProperty.bufferView = valueBufferIdx;
-  featureTableProperty.arrayOffsetBufferView = offsetBufferIdx;
   featureTableProperty.offsetType = convertPropertyTypeToString(offsetType);
 }
 
 void updateExtensionWithArrayProperty(
-    Model& gltf,
+    ConvertedJsonProperty& convertedProperty,
     ClassProperty& classProperty,
     const FeatureTable& featureTable,
     FeatureTableProperty& featureTableProperty,
@@ -923,7 +874,7 @@ void updateExtensionWithArrayProperty(
 
   if (compatibleTypes.componentType->isBool) {
     updateBooleanArrayProperty(
-        gltf,
+        convertedProperty,
         classProperty,
         featureTableProperty,
         featureTable,
@@ -931,7 +882,7 @@ void updateExtensionWithArrayProperty(
         propertyValue);
   } else if (compatibleTypes.componentType->isInt8) {
     updateNumericArrayProperty<int32_t, int8_t>(
-        gltf,
+        convertedProperty,
         classProperty,
         featureTableProperty,
         featureTable,
@@ -939,7 +890,7 @@ void updateExtensionWithArrayProperty(
         propertyValue);
   } else if (compatibleTypes.componentType->isUint8) {
     updateNumericArrayProperty<uint32_t, uint8_t>(
-        gltf,
+        convertedProperty,
         classProperty,
         featureTableProperty,
         featureTable,
@@ -947,7 +898,7 @@ void updateExtensionWithArrayProperty(
         propertyValue);
   } else if (compatibleTypes.componentType->isInt16) {
     updateNumericArrayProperty<int32_t, int16_t>(
-        gltf,
+        convertedProperty,
         classProperty,
         featureTableProperty,
         featureTable,
@@ -955,7 +906,7 @@ void updateExtensionWithArrayProperty(
         propertyValue);
   } else if (compatibleTypes.componentType->isUint16) {
     updateNumericArrayProperty<uint32_t, uint16_t>(
-        gltf,
+        convertedProperty,
         classProperty,
         featureTableProperty,
         featureTable,
@@ -963,7 +914,7 @@ void updateExtensionWithArrayProperty(
         propertyValue);
   } else if (compatibleTypes.componentType->isInt32) {
     updateNumericArrayProperty<int32_t, int32_t>(
-        gltf,
+        convertedProperty,
         classProperty,
         featureTableProperty,
         featureTable,
@@ -971,7 +922,7 @@ void updateExtensionWithArrayProperty(
         propertyValue);
   } else if (compatibleTypes.componentType->isUint32) {
     updateNumericArrayProperty<uint32_t, uint32_t>(
-        gltf,
+        convertedProperty,
         classProperty,
         featureTableProperty,
         featureTable,
@@ -979,7 +930,7 @@ void updateExtensionWithArrayProperty(
         propertyValue);
   } else if (compatibleTypes.componentType->isInt64) {
     updateNumericArrayProperty<int64_t, int64_t>(
-        gltf,
+        convertedProperty,
         classProperty,
         featureTableProperty,
         featureTable,
@@ -987,7 +938,7 @@ void updateExtensionWithArrayProperty(
         propertyValue);
   } else if (compatibleTypes.componentType->isUint64) {
     updateNumericArrayProperty<uint64_t, uint64_t>(
-        gltf,
+        convertedProperty,
         classProperty,
         featureTableProperty,
         featureTable,
@@ -995,7 +946,7 @@ void updateExtensionWithArrayProperty(
         propertyValue);
   } else if (compatibleTypes.componentType->isFloat32) {
     updateNumericArrayProperty<float, float>(
-        gltf,
+        convertedProperty,
         classProperty,
         featureTableProperty,
         featureTable,
@@ -1003,134 +954,135 @@ void updateExtensionWithArrayProperty(
         propertyValue);
   } else if (compatibleTypes.componentType->isFloat64) {
     updateNumericArrayProperty<double, double>(
-        gltf,
+        convertedProperty,
         classProperty,
         featureTableProperty,
         featureTable,
         compatibleTypes,
         propertyValue);
-  } else {
+  } else if (!compatibleTypes.hasNonStringComponents) {
     updateStringArrayProperty(
-        gltf,
+        convertedProperty,
         classProperty,
         featureTableProperty,
         featureTable,
         compatibleTypes,
         propertyValue);
+  } else {
+    // The arrays mix strings with other values, so serialize each of them.
+    updateExtensionWithJsonStringProperty(
+        convertedProperty,
+        classProperty,
+        featureTable,
+        featureTableProperty,
+        compatibleTypes,
+        propertyValue);
   }
 }
 
 void updateExtensionWithJsonProperty(
-    Model& gltf,
+    ConvertedJsonProperty& convertedProperty,
     ClassProperty& classProperty,
     const FeatureTable& featureTable,
     FeatureTableProperty& featureTableProperty,
     const rapidjson::Value& propertyValue) {
+  // Figure out which types we can use for this data, and how large its
+  // buffers will be, in a single pass over the values.
+  // Use the smallest type we can, and prefer signed to unsigned.
+  const CompatibleTypes compatibleTypes =
+      findCompatibleTypes(propertyValue, featureTable.count);
 
   if (propertyValue.Empty() || propertyValue.Size() < featureTable.count) {
     // No property to infer the type from, so assume string.
     updateExtensionWithJsonStringProperty(
-        gltf,
+        convertedProperty,
         classProperty,
         featureTable,
         featureTableProperty,
+        compatibleTypes,
         propertyValue);
     return;
   }
 
-  // Figure out which types we can use for this data.
-  // Use the smallest type we can, and prefer signed to unsigned.
-  const CompatibleTypes compatibleTypes = findCompatibleTypes(propertyValue);
   if (compatibleTypes.type.isBool) {
     updateExtensionWithJsonBoolProperty(
-        gltf,
+        convertedProperty,
         classProperty,
         featureTable,
-        featureTableProperty,
         propertyValue);
   } else if (compatibleTypes.type.isInt8) {
     updateExtensionWithJsonNumericProperty<int8_t, int32_t>(
-        gltf,
+        convertedProperty,
         classProperty,
         featureTable,
-        featureTableProperty,
         propertyValue,
         "INT8");
   } else if (compatibleTypes.type.isUint8) {
     updateExtensionWithJsonNumericProperty<uint8_t, uint32_t>(
-        gltf,
+        convertedProperty,
         classProperty,
         featureTable,
-        featureTableProperty,
         propertyValue,
         "UINT8");
   } else if (compatibleTypes.type.isInt16) {
     updateExtensionWithJsonNumericProperty<int16_t, int32_t>(
-        gltf,
+        convertedProperty,
         classProperty,
         featureTable,
-        featureTableProperty,
         propertyValue,
         "INT16");
   } else if (compatibleTypes.type.isUint16) {
     updateExtensionWithJsonNumericProperty<uint16_t, uint32_t>(
-        gltf,
+        convertedProperty,
         classProperty,
         featureTable,
-        featureTableProperty,
         propertyValue,
         "UINT16");
   } else if (compatibleTypes.type.isInt32) {
     updateExtensionWithJsonNumericProperty<int32_t>(
-        gltf,
+        convertedProperty,
         classProperty,
         featureTable,
-        featureTableProperty,
         propertyValue,
         "INT32");
   } else if (compatibleTypes.type.isUint32) {
     updateExtensionWithJsonNumericProperty<uint32_t>(
-        gltf,
+        convertedProperty,
         classProperty,
         featureTable,
-        featureTableProperty,
         propertyValue,
         "UINT32");
   } else if (compatibleTypes.type.isInt64) {
     updateExtensionWithJsonNumericProperty<int64_t>(
-        gltf,
+        convertedProperty,
         classProperty,
         featureTable,
-        featureTableProperty,
         propertyValue,
         "INT64");
   } else if (compatibleTypes.type.isUint64) {
     updateExtensionWithJsonNumericProperty<uint64_t>(
-        gltf,
+        convertedProperty,
         classProperty,
         featureTable,
-        featureTableProperty,
         propertyValue,
         "UINT64");
   } else if (compatibleTypes.type.isFloat32) {
     updateExtensionWithJsonNumericProperty<float>(
-        gltf,
+        convertedProperty,
         classProperty,
         featureTable,
-        featureTableProperty,
         propertyValue,
         "FLOAT32");
   } else if (compatibleTypes.type.isFloat64) {
     updateExtensionWithJsonNumericProperty<double>(
-        gltf,
+        convertedProperty,
         classProperty,
         featureTable,
-        featureTableProperty,
         propertyValue,
         "FLOAT64");
   } else if (compatibleTypes.type.isArray) {
     updateExtensionWithArrayProperty(
-        gltf,
+        convertedProperty,
         classProperty,
         featureTable,
         featureTableProperty,
@@ -1138,10 +1090,11 @@ void updateExtensionWithJsonProperty(
         propertyValue);
   } else {
     updateExtensionWithJsonStringProperty(
-        gltf,
+        convertedProperty,
         classProperty,
         featureTable,
         featureTableProperty,
+        compatibleTypes,
         propertyValue);
   }
 }
@@ -1241,27 +1194,52 @@ void updateExtensionWithBinaryProperty(
   binaryProperty.gltfByteOffset = gltfBufferOffset;
   binaryProperty.byteLength = static_cast<int64_t>(bufferView.byteLength);
 }
-} // namespace
 
-namespace Cesium3DTilesSelection {
+int32_t addBufferView(Model& gltf, std::vector<std::byte>&& data) {
+  Buffer& buffer = gltf.buffers.emplace_back();
+  buffer.byteLength = static_cast<int64_t>(data.size());
+  buffer.cesium.data = std::move(data);
 
-void upgradeBatchTableToFeatureMetadata(
-    const std::shared_ptr<spdlog::logger>& pLogger,
-    CesiumGltf::Model& gltf,
-    const rapidjson::Document& featureTableJson,
-    const rapidjson::Document& batchTableJson,
-    const gsl::span<const std::byte>& batchTableBinaryData) {
+  BufferView& bufferView = gltf.bufferViews.emplace_back();
+  bufferView.buffer = static_cast<int32_t>(gltf.buffers.size() - 1);
+  bufferView.byteOffset = 0;
+  bufferView.byteLength = buffer.byteLength;
 
-  CESIUM_TRACE("upgradeBatchTableToFeatureMetadata");
+  return static_cast<int32_t>(gltf.bufferViews.size() - 1);
+}
 
-  // Check to make sure a char of rapidjson is 1 byte
-  static_assert(
-      sizeof(rapidjson::Value::Ch) == 1,
-      "RapidJson::Value::Ch is not 1 byte");
+void addConvertedJsonProperty(
+    Model& gltf,
+    FeatureTableProperty& featureTableProperty,
+    ConvertedJsonProperty&& convertedProperty) {
+  featureTableProperty.bufferView =
+      addBufferView(gltf, std::move(convertedProperty.valueBuffer));
 
-  // Parse the b3dm batch table and convert it to the EXT_feature_metadata
-  // extension.
+  if (convertedProperty.stringOffsetBuffer) {
+    featureTableProperty.stringOffsetBufferView =
+        addBufferView(gltf, std::move(*convertedProperty.stringOffsetBuffer));
+  }
+
+  if (convertedProperty.arrayOffsetBuffer) {
+    featureTableProperty.arrayOffsetBufferView =
+        addBufferView(gltf, std::move(*convertedProperty.arrayOffsetBuffer));
+  }
+}
+
+struct PendingProperty {
+  std::string name;
+  ClassProperty* pClassProperty;
+  FeatureTableProperty* pFeatureTableProperty;
+  const rapidjson::Value* pValue;
+  ConvertedJsonProperty convertedProperty;
+};
 
+// Starting a thread costs about as much as converting this many values, so
+// smaller batch tables are converted on the calling thread.
+const uint64_t minValuesPerThread = 1 << 16;
+std::optional<int64_t> getBatchLength(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    const rapidjson::Document& featureTableJson) {
   // If the feature table is missing the BATCH_LENGTH semantic, ignore the batch
   // table completely.
   const auto batchLengthIt = featureTableJson.FindMember("BATCH_LENGTH");
@@ -1272,11 +1250,18 @@ void upgradeBatchTableToFeatureMetadata(
         "The B3DM has a batch table, but it is being ignored because there is "
         "no BATCH_LENGTH semantic in the feature table or it is not an "
         "integer.");
-    return;
+    return std::nullopt;
   }
 
-  const int64_t batchLength = batchLengthIt->value.GetInt64();
+  return batchLengthIt->value.GetInt64();
+}
 
+void convertBatchTable(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    Model& gltf,
+    int64_t batchLength,
+    const rapidjson::Document& batchTableJson,
+    const gsl::span<const std::byte>& batchTableBinaryData) {
   // Add the binary part of the batch table - if any - to the glTF as a buffer.
   // We will reallign this buffer later on
   int32_t gltfBufferIndex = -1;
@@ -1300,7 +1285,10 @@ void upgradeBatchTableToFeatureMetadata(
   featureTable.count = batchLength;
   featureTable.classProperty = "default";
 
-  // Convert each regular property in the batch table
+  // Create each regular property in the batch table. Properties are added to
+  // maps, so this has to happen before converting them concurrently.
+  std::vector<PendingProperty> properties;
+  uint64_t totalJsonValues = 0;
   for (auto propertyIt = batchTableJson.MemberBegin();
        propertyIt != batchTableJson.MemberEnd();
        ++propertyIt) {
@@ -1311,21 +1299,63 @@ void upgradeBatchTableToFeatureMetadata(
       continue;
     }
 
-    ClassProperty& classProperty =
-        classDefinition.properties.emplace(name, ClassProperty()).first->second;
+    const auto [classPropertyIt, inserted] =
+        classDefinition.properties.emplace(name, ClassProperty());
+    ClassProperty& classProperty = classPropertyIt->second;
     classProperty.name = name;
 
     FeatureTableProperty& featureTableProperty =
         featureTable.properties.emplace(name, FeatureTableProperty())
             .first->second;
+
     const rapidjson::Value& propertyValue = propertyIt->value;
     if (propertyValue.IsArray()) {
+      totalJsonValues += propertyValue.Size();
+    }
+
+    if (!inserted) {
+      // A later property with the same name replaces the earlier one.
+      for (PendingProperty& property : properties) {
+        if (property.pClassProperty == &classProperty) {
+          property.pValue = &propertyValue;
+        }
+      }
+      continue;
+    }
+
+    properties.push_back(PendingProperty{
+        std::move(name),
+        &classProperty,
+        &featureTableProperty,
+        &propertyValue,
+        ConvertedJsonProperty()});
+  }
+
+  // Convert the JSON properties. Each one is converted independently, with one
+  // pass to find its type and sizes and another to fill its buffers.
+  const size_t maxThreads = static_cast<size_t>(glm::min(
+      static_cast<uint64_t>(glm::max(std::thread::hardware_concurrency(), 1U)),
+      totalJsonValues / minValuesPerThread + 1));
+  CesiumUtility::parallelFor(properties.size(), maxThreads, [&](size_t i) {
+    PendingProperty& property = properties[i];
+    if (property.pValue->IsArray()) {
       updateExtensionWithJsonProperty(
-          gltf,
-          classProperty,
+          property.convertedProperty,
+          *property.pClassProperty,
           featureTable,
-          featureTableProperty,
-          propertyValue);
+          *property.pFeatureTableProperty,
+          *property.pValue);
+    }
+  });
+
+  // Add the buffers to the glTF in the order of the batch table, so that the
+  // result doesn't depend on the order in which the properties were converted.
+  for (PendingProperty& property : properties) {
+    if (property.pValue->IsArray()) {
+      addConvertedJsonProperty(
+          gltf,
+          *property.pFeatureTableProperty,
+          std::move(property.convertedProperty));
     } else {
       BinaryProperty& binaryProperty = binaryProperties.emplace_back();
       updateExtensionWithBinaryProperty(
@@ -1333,11 +1363,11 @@ void upgradeBatchTableToFeatureMetadata(
           gltfBufferIndex,
           gltfBufferOffset,
           binaryProperty,
-          classProperty,
+          *property.pClassProperty,
           featureTable,
-          featureTableProperty,
-          name,
-          propertyValue,
+          *property.pFeatureTableProperty,
+          property.name,
+          *property.pValue,
           pLogger);
       gltfBufferOffset += roundUp(binaryProperty.byteLength, 8);
     }
@@ -1355,7 +1385,9 @@ void upgradeBatchTableToFeatureMetadata(
           static_cast<size_t>(binaryProperty.byteLength));
     }
   }
+}
 
+void addFeatureIdAttributes(Model& gltf) {
   // Create an EXT_feature_metadata extension for each primitive with a _BATCHID
   // attribute.
   for (Mesh& mesh : gltf.meshes) {
@@ -1381,4 +1413,93 @@ void upgradeBatchTableToFeatureMetadata(
   }
 }
 
+} // namespace
+
+namespace Cesium3DTilesSelection {
+
+void upgradeBatchTableToFeatureMetadata(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    CesiumGltf::Model& gltf,
+    const rapidjson::Document& featureTableJson,
+    const rapidjson::Document& batchTableJson,
+    const gsl::span<const std::byte>& batchTableBinaryData) {
+
+  CESIUM_TRACE("upgradeBatchTableToFeatureMetadata");
+
+  // Check to make sure a char of rapidjson is 1 byte
+  static_assert(
+      sizeof(rapidjson::Value::Ch) == 1,
+      "RapidJson::Value::Ch is not 1 byte");
+
+  // Parse the b3dm batch table and convert it to the EXT_feature_metadata
+  // extension.
+  const std::optional<int64_t> batchLength =
+      getBatchLength(pLogger, featureTableJson);
+  if (!batchLength) {
+    return;
+  }
+
+  convertBatchTable(
+      pLogger,
+      gltf,
+      *batchLength,
+      batchTableJson,
+      batchTableBinaryData);
+  addFeatureIdAttributes(gltf);
+}
+
+void deferBatchTableUpgradeToFeatureMetadata(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    CesiumGltf::Model& gltf,
+    const rapidjson::Document& featureTableJson,
+    const gsl::span<const std::byte>& batchTableJsonData,
+    const gsl::span<const std::byte>& batchTableBinaryData) {
+  const std::optional<int64_t> batchLength =
+      getBatchLength(pLogger, featureTableJson);
+  if (!batchLength) {
+    return;
+  }
+
+  // The tile's data is released once it is loaded, so keep a copy of the batch
+  // table until it is converted.
+  auto pBatchTableJsonData = std::make_shared<std::vector<std::byte>>(
+      batchTableJsonData.begin(),
+      batchTableJsonData.end());
+  auto pBatchTableBinaryData = std::make_shared<std::vector<std::byte>>(
+      batchTableBinaryData.begin(),
+      batchTableBinaryData.end());
+
+  gltf.pLazyFeatureMetadata = std::make_shared<LazyFeatureMetadata>(
+      [pLogger,
+       batchLength = *batchLength,
+       pBatchTableJsonData = std::move(pBatchTableJsonData),
+       pBatchTableBinaryData = std::move(pBatchTableBinaryData)](
+          Model& metadataModel) {
+        CESIUM_TRACE("upgradeBatchTableToFeatureMetadata (lazy)");
+
+        rapidjson::Document batchTableJson;
+        batchTableJson.Parse(
+            reinterpret_cast<const char*>(pBatchTableJsonData->data()),
+            pBatchTableJsonData->size());
+        if (batchTableJson.HasParseError()) {
+          SPDLOG_LOGGER_WARN(
+              pLogger,
+              "Error when parsing batch table JSON, error code {} at byte "
+              "offset {}. Skip parsing metadata",
+              batchTableJson.GetParseError(),
+              batchTableJson.GetErrorOffset());
+          return;
+        }
+
+        convertBatchTable(
+            pLogger,
+            metadataModel,
+            batchLength,
+            batchTableJson,
+            gsl::span<const std::byte>(*pBatchTableBinaryData));
+      });
+
+  addFeatureIdAttributes(gltf);
+}
+
 } // namespace Cesium3DTilesSelection
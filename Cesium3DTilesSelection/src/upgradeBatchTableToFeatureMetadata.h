@@ -29,4 +29,26 @@ void upgradeBatchTableToFeatureMetadata(
     const rapidjson::Document& batchTableJson,
     const gsl::span<const std::byte>& batchTableBinaryData);
 
+/**
+ * @brief Attaches the provided B3DM batch table to the provided glTF, to be
+ * upgraded to an EXT_feature_metadata extension the first time it is accessed.
+ *
+ * The batch table is copied into
+ * {@link CesiumGltf::Model::pLazyFeatureMetadata} without being parsed, while the primitives' `_BATCHID` attributes are
+ * renamed to feature ID attributes right away, as they are by
+ * {@link upgradeBatchTableToFeatureMetadata}.
+ *
+ * @param pLogger
+ * @param gltf
+ * @param featureTable
+ * @param batchTableJsonData
+ * @param batchTableBinaryData
+ */
+void deferBatchTableUpgradeToFeatureMetadata(
+    const std::shared_ptr<spdlog::logger>& pLogger,
+    CesiumGltf::Model& gltf,
+    const rapidjson::Document& featureTable,
+    const gsl::span<const std::byte>& batchTableJsonData,
+    const gsl::span<const std::byte>& batchTableBinaryData);
+
 } // namespace Cesium3DTilesSelection
@@ -6,15 +6,33 @@
 #include <CesiumGeospatial/Cartographic.h>
 #include <CesiumGeospatial/Ellipsoid.h>
 #include <CesiumGltf/AccessorView.h>
+#include <CesiumGltf/DequantizedAccessorView.h>
 #include <CesiumUtility/Math.h>
 #include <CesiumUtility/Tracing.h>
 
 #include <algorithm>
+#include <array>
+#include <cassert>
 #include <cstddef>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <utility>
 
 using namespace CesiumGltf;
 
 namespace Cesium3DTilesSelection {
+
+/**
+ * The children of an upsampled tile, indexed by quadrant. The quadrant index is
+ * `(east ? 1 : 0) + (north ? 2 : 0)`, so the order is southwest, southeast,
+ * northwest, northeast. This matches the order in which `Tile` creates its
+ * upsampled children.
+ */
+static constexpr size_t QUADRANT_COUNT = 4;
+
+static constexpr uint32_t NO_VERTEX = std::numeric_limits<uint32_t>::max();
+
 struct EdgeVertex {
   uint32_t index;
   glm::vec2 uv;
@@ -25,65 +43,287 @@ struct EdgeIndices {
   std::vector<EdgeVertex> south;
   std::vector<EdgeVertex> east;
   std::vector<EdgeVertex> north;
-};
 
-static void upsamplePrimitiveForRasterOverlays(
-    const Model& parentModel,
-    Model& model,
-    Mesh& mesh,
-    MeshPrimitive& primitive,
-    CesiumGeometry::UpsampledQuadtreeNode childID);
+  void clear() noexcept {
+    this->west.clear();
+    this->south.clear();
+    this->east.clear();
+    this->north.clear();
+  }
+};
 
+/**
+ * A vertex attribute of the parent primitive. Its values are converted to
+ * floats in the packed vertex data, where they are interpolated, and converted
+ * back to `outputComponentType` in the upsampled primitives. That is the
+ * parent's component type, so attributes quantized with `KHR_mesh_quantization`
+ * stay quantized.
+ */
 struct FloatVertexAttribute {
-  const std::vector<std::byte>& buffer;
-  int64_t offset;
+  const std::string* pName;
+  const std::byte* pData;
   int64_t stride;
   int64_t numberOfFloatsPerVertex;
-  int32_t accessorIndex;
-  std::vector<double> minimums;
-  std::vector<double> maximums;
+  int64_t offsetInVertex;
+  std::string type;
+  int32_t componentType;
+  bool normalized;
+  int32_t outputComponentType;
+  int64_t outputByteOffset;
 };
 
-static void addClippedPolygon(
-    std::vector<float>& output,
-    std::vector<uint32_t>& indices,
-    std::vector<FloatVertexAttribute>& attributes,
-    std::vector<uint32_t>& vertexMap,
-    std::vector<uint32_t>& clipVertexToIndices,
-    const std::vector<CesiumGeometry::TriangleClipVertex>& complements,
-    const std::vector<CesiumGeometry::TriangleClipVertex>& clipResult);
+/**
+ * Calls `f` with a value of the C++ type of a vertex attribute component type.
+ */
+template <typename Func>
+static void withComponentType(int32_t componentType, Func&& f) {
+  switch (componentType) {
+  case Accessor::ComponentType::BYTE:
+    f(int8_t());
+    break;
+  case Accessor::ComponentType::UNSIGNED_BYTE:
+    f(uint8_t());
+    break;
+  case Accessor::ComponentType::SHORT:
+    f(int16_t());
+    break;
+  case Accessor::ComponentType::UNSIGNED_SHORT:
+    f(uint16_t());
+    break;
+  default:
+    f(float());
+    break;
+  }
+}
 
-static void addEdge(
-    EdgeIndices& edgeIndices,
-    double thresholdU,
-    double thresholdV,
-    bool keepAboveU,
-    bool keepAboveV,
-    const AccessorView<glm::vec2>& uvs,
-    const std::vector<uint32_t>& clipVertexToIndices,
-    const std::vector<CesiumGeometry::TriangleClipVertex>& complements,
-    const std::vector<CesiumGeometry::TriangleClipVertex>& clipResult);
+/**
+ * Reads an attribute of the parent vertices into the packed vertex data,
+ * dequantizing it if necessary.
+ */
+template <typename T>
+static void readVertexAttribute(
+    const FloatVertexAttribute& attribute,
+    size_t vertexCount,
+    size_t vertexSizeFloats,
+    float* pVertices) {
+  const size_t components = size_t(attribute.numberOfFloatsPerVertex);
+  const std::byte* pInput = attribute.pData;
+  float* pOutput = pVertices + attribute.offsetInVertex;
+  for (size_t i = 0; i < vertexCount; ++i) {
+    if constexpr (std::is_same_v<T, float>) {
+      std::memcpy(pOutput, pInput, components * sizeof(float));
+    } else {
+      for (size_t c = 0; c < components; ++c) {
+        T value;
+        std::memcpy(&value, pInput + c * sizeof(T), sizeof(T));
+        pOutput[c] = dequantizeComponent(value, attribute.normalized);
+      }
+    }
+    pInput += attribute.stride;
+    pOutput += vertexSizeFloats;
+  }
+}
 
-static void addSkirt(
-    std::vector<float>& output,
-    std::vector<uint32_t>& indices,
-    std::vector<FloatVertexAttribute>& attributes,
-    const std::vector<uint32_t>& edgeIndices,
-    const glm::dvec3& center,
-    double skirtHeight,
-    int64_t vertexSizeFloats,
-    int32_t positionAttributeIndex);
+/**
+ * Writes an attribute of the packed vertex data to an interleaved vertex
+ * buffer, quantizing it if necessary, and computes the minimum and maximum of
+ * each component of the written values.
+ */
+template <typename T>
+static void writeVertexAttribute(
+    const FloatVertexAttribute& attribute,
+    const std::vector<float>& vertices,
+    size_t vertexSizeFloats,
+    int64_t byteStride,
+    std::byte* pVertexBuffer,
+    std::vector<double>& minimums,
+    std::vector<double>& maximums) {
+  const size_t components = size_t(attribute.numberOfFloatsPerVertex);
+  const size_t vertexCount = vertices.size() / vertexSizeFloats;
+  const float* pInput = vertices.data() + attribute.offsetInVertex;
+  std::byte* pOutput = pVertexBuffer + attribute.outputByteOffset;
+  for (size_t i = 0; i < vertexCount; ++i) {
+    for (size_t c = 0; c < components; ++c) {
+      const T value = quantizeComponent<T>(pInput[c], attribute.normalized);
+      std::memcpy(pOutput + c * sizeof(T), &value, sizeof(T));
+      minimums[c] = glm::min(minimums[c], static_cast<double>(value));
+      maximums[c] = glm::max(maximums[c], static_cast<double>(value));
+    }
+    pInput += vertexSizeFloats;
+    pOutput += byteStride;
+  }
+}
+
+/**
+ * An upsampled child model together with the ID of the tile it belongs to.
+ * A null `pModel` means this quadrant was not requested.
+ */
+struct UpsampledChild {
+  Model* pModel = nullptr;
+  CesiumGeometry::UpsampledQuadtreeNode childID{
+      CesiumGeometry::QuadtreeTileID(0, 0, 0)};
+};
+
+/**
+ * Maps a clipped edge, identified by the IDs of its two endpoints and the axis
+ * it was clipped against, to the ID of the vertex that was created at the clip
+ * point. A given edge crosses a given threshold at exactly one point, so every
+ * triangle sharing that edge (and every child quadrant on either side of it)
+ * reuses the same interpolated vertex.
+ *
+ * This is a flat open-addressing table with linear probing. Clearing it keeps
+ * its storage so that it can be reused for the next primitive.
+ */
+class ClipVertexMap {
+public:
+  void clear(size_t expectedSize) {
+    size_t capacity = 16;
+    while (capacity < expectedSize * 2) {
+      capacity *= 2;
+    }
+    this->_entries.assign(capacity, Entry{EMPTY_KEY, 0});
+    this->_size = 0;
+  }
+
+  /**
+   * Finds the vertex ID for the given key. If there isn't one yet, `newValue`
+   * is inserted and returned. The second member of the returned pair
+   * indicates whether an insertion happened.
+   */
+  std::pair<uint32_t, bool> findOrInsert(uint64_t key, uint32_t newValue) {
+    if ((this->_size + 1) * 2 > this->_entries.size()) {
+      this->grow();
+    }
+
+    const size_t mask = this->_entries.size() - 1;
+    size_t slot = hash(key) & mask;
+    while (true) {
+      Entry& entry = this->_entries[slot];
+      if (entry.key == key) {
+        return std::make_pair(entry.value, false);
+      }
+      if (entry.key == EMPTY_KEY) {
+        entry.key = key;
+        entry.value = newValue;
+        ++this->_size;
+        return std::make_pair(newValue, true);
+      }
+      slot = (slot + 1) & mask;
+    }
+  }
+
+private:
+  static constexpr uint64_t EMPTY_KEY = std::numeric_limits<uint64_t>::max();
+
+  struct Entry {
+    uint64_t key;
+    uint32_t value;
+  };
+
+  static size_t hash(uint64_t key) noexcept {
+    // Fibonacci hashing; the high bits are well mixed.
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ULL) >> 17);
+  }
+
+  void grow() {
+    std::vector<Entry> oldEntries;
+    oldEntries.swap(this->_entries);
+    this->_entries.assign(
+        std::max(oldEntries.size() * 2, size_t(16)),
+        Entry{EMPTY_KEY, 0});
+    this->_size = 0;
+
+    const size_t mask = this->_entries.size() - 1;
+    for (const Entry& entry : oldEntries) {
+      if (entry.key == EMPTY_KEY) {
+        continue;
+      }
+      size_t slot = hash(entry.key) & mask;
+      while (this->_entries[slot].key != EMPTY_KEY) {
+        slot = (slot + 1) & mask;
+      }
+      this->_entries[slot] = entry;
+      ++this->_size;
+    }
+  }
+
+  std::vector<Entry> _entries;
+  size_t _size = 0;
+};
+
+enum class ClipAxis : uint32_t { U = 0, V = 1 };
+
+static uint64_t
+makeClipVertexKey(uint32_t first, uint32_t second, ClipAxis axis) noexcept {
+  if (first > second) {
+    std::swap(first, second);
+  }
+  assert(second < (1U << 31));
+  return (uint64_t(first) << 32) | (uint64_t(second) << 1) |
+         uint64_t(static_cast<uint32_t>(axis));
+}
+
+/**
+ * The vertices and triangles of one child quadrant of one primitive.
+ */
+struct UpsampledPrimitive {
+  // Maps a vertex ID to the index of that vertex in this child, or
+  // NO_VERTEX if the child doesn't use the vertex (yet).
+  std::vector<uint32_t> vertexIndices;
+  std::vector<float> vertices;
+  std::vector<glm::vec2> uvs;
+  std::vector<uint32_t> indices;
+  EdgeIndices edgeIndices;
+
+  void clear(size_t parentVertexCount) {
+    this->vertexIndices.assign(parentVertexCount, NO_VERTEX);
+    this->vertices.clear();
+    this->uvs.clear();
+    this->indices.clear();
+    this->edgeIndices.clear();
+  }
+};
+
+/**
+ * Scratch storage used while upsampling a model. It is allocated once per
+ * model and reused, without releasing its memory, for every primitive in that
+ * model.
+ *
+ * Every vertex that any child may reference has an ID. IDs below the parent
+ * vertex count identify parent vertices; larger IDs identify vertices
+ * created by clipping. The packed vertex data and the raster overlay texture
+ * coordinates of all of them live in `vertices` and `uvs`, indexed by ID.
+ */
+struct UpsampleScratch {
+  std::vector<float> vertices;
+  std::vector<glm::vec2> uvs;
+  ClipVertexMap clipVertices;
+  std::vector<CesiumGeometry::TriangleClipVertex> clippedA;
+  std::vector<CesiumGeometry::TriangleClipVertex> clippedB;
+  std::array<UpsampledPrimitive, QUADRANT_COUNT> children;
+  std::vector<FloatVertexAttribute> attributes;
+  std::vector<uint32_t> sortedEdge;
+};
+
+static void upsampleModelForRasterOverlays(
+    const Model& parentModel,
+    const std::array<UpsampledChild, QUADRANT_COUNT>& children);
+
+static void upsamplePrimitiveForRasterOverlays(
+    const Model& parentModel,
+    size_t meshIndex,
+    size_t primitiveIndex,
+    const std::array<UpsampledChild, QUADRANT_COUNT>& children,
+    UpsampleScratch& scratch);
 
 static void addSkirts(
-    std::vector<float>& output,
-    std::vector<uint32_t>& indices,
-    std::vector<FloatVertexAttribute>& attributes,
+    UpsampledPrimitive& child,
+    UpsampleScratch& scratch,
     CesiumGeometry::UpsampledQuadtreeNode childID,
     SkirtMeshMetadata& currentSkirt,
     const SkirtMeshMetadata& parentSkirt,
-    EdgeIndices& edgeIndices,
-    int64_t vertexSizeFloats,
-    int32_t positionAttributeIndex);
+    size_t vertexSizeFloats,
+    int64_t positionOffset);
 
 static bool
 isWestChild(CesiumGeometry::UpsampledQuadtreeNode childID) noexcept {
@@ -95,12 +335,56 @@ isSouthChild(CesiumGeometry::UpsampledQuadtreeNode childID) noexcept {
   return (childID.tileID.y % 2) == 0;
 }
 
+static size_t
+getQuadrant(CesiumGeometry::UpsampledQuadtreeNode childID) noexcept {
+  return size_t(isWestChild(childID) ? 0 : 1) +
+         size_t(isSouthChild(childID) ? 0 : 2);
+}
+
 Model upsampleGltfForRasterOverlays(
     const Model& parentModel,
     CesiumGeometry::UpsampledQuadtreeNode childID) {
   CESIUM_TRACE("upsampleGltfForRasterOverlays");
   Model result;
 
+  std::array<UpsampledChild, QUADRANT_COUNT> children{};
+  children[getQuadrant(childID)] = UpsampledChild{&result, childID};
+
+  upsampleModelForRasterOverlays(parentModel, children);
+
+  return result;
+}
+
+std::array<Model, 4> upsampleGltfForRasterOverlayChildren(
+    const Model& parentModel,
+    const CesiumGeometry::QuadtreeTileID& parentTileID) {
+  CESIUM_TRACE("upsampleGltfForRasterOverlayChildren");
+  std::array<Model, 4> result;
+
+  const CesiumGeometry::QuadtreeTileID swID(
+      parentTileID.level + 1,
+      parentTileID.x * 2,
+      parentTileID.y * 2);
+
+  std::array<UpsampledChild, QUADRANT_COUNT> children{};
+  for (uint32_t quadrant = 0; quadrant < QUADRANT_COUNT; ++quadrant) {
+    children[quadrant] = UpsampledChild{
+        &result[quadrant],
+        CesiumGeometry::UpsampledQuadtreeNode{CesiumGeometry::QuadtreeTileID(
+            swID.level,
+            swID.x + (quadrant & 1U),
+            swID.y + (quadrant >> 1U))}};
+  }
+
+  upsampleModelForRasterOverlays(parentModel, children);
+
+  return result;
+}
+
+static void initializeUpsampledModel(
+    const Model& parentModel,
+    Model& result,
+    CesiumGeometry::UpsampledQuadtreeNode childID) {
   // Copy the entire parent model except for the buffers, bufferViews, and
   // accessors, which we'll be rewriting.
   result.animations = parentModel.animations;
@@ -135,851 +419,747 @@ Model upsampleGltfForRasterOverlays(
     name += "-Y" + std::to_string(childID.tileID.y);
     nameIt->second = name;
   }
+}
+
+static void upsampleModelForRasterOverlays(
+    const Model& parentModel,
+    const std::array<UpsampledChild, QUADRANT_COUNT>& children) {
+  for (const UpsampledChild& child : children) {
+    if (child.pModel) {
+      initializeUpsampledModel(parentModel, *child.pModel, child.childID);
+    }
+  }
 
-  for (Mesh& mesh : result.meshes) {
-    for (MeshPrimitive& primitive : mesh.primitives) {
+  UpsampleScratch scratch;
+
+  for (size_t meshIndex = 0; meshIndex < parentModel.meshes.size();
+       ++meshIndex) {
+    const Mesh& mesh = parentModel.meshes[meshIndex];
+    for (size_t primitiveIndex = 0; primitiveIndex < mesh.primitives.size();
+         ++primitiveIndex) {
       upsamplePrimitiveForRasterOverlays(
           parentModel,
-          result,
-          mesh,
-          primitive,
-          childID);
+          meshIndex,
+          primitiveIndex,
+          children,
+          scratch);
     }
   }
-
-  return result;
 }
 
-static void copyVertexAttributes(
-    std::vector<FloatVertexAttribute>& vertexAttributes,
-    const CesiumGeometry::TriangleClipVertex& vertex,
-    std::vector<float>& output,
-    bool skipMinMaxUpdate = false) {
-  struct Operation {
-    std::vector<FloatVertexAttribute>& vertexAttributes;
-    std::vector<float>& output;
-    bool skipMinMaxUpdate;
-
-    void operator()(int vertexIndex) {
-      for (FloatVertexAttribute& attribute : vertexAttributes) {
-        const float* pInput = reinterpret_cast<const float*>(
-            attribute.buffer.data() + attribute.offset +
-            attribute.stride * vertexIndex);
-        for (int32_t i = 0; i < attribute.numberOfFloatsPerVertex; ++i) {
-          const float value = *pInput;
-          output.push_back(value);
-          if (!skipMinMaxUpdate) {
-            attribute.minimums[static_cast<size_t>(i)] = glm::min(
-                attribute.minimums[static_cast<size_t>(i)],
-                static_cast<double>(value));
-            attribute.maximums[static_cast<size_t>(i)] = glm::max(
-                attribute.maximums[static_cast<size_t>(i)],
-                static_cast<double>(value));
-          }
-          ++pInput;
-        }
-      }
-    }
+/**
+ * Gets the ID of the vertex represented by a clip result. Parent vertices and
+ * previously-clipped vertices are passed through; a new interpolated vertex is
+ * created only the first time a given edge is clipped against a given axis.
+ */
+static uint32_t getVertexID(
+    UpsampleScratch& scratch,
+    size_t vertexSizeFloats,
+    const CesiumGeometry::TriangleClipVertex& clipVertex,
+    ClipAxis axis) {
+  const int* pIndex = std::get_if<int>(&clipVertex);
+  if (pIndex) {
+    return static_cast<uint32_t>(*pIndex);
+  }
 
-    void operator()(const CesiumGeometry::InterpolatedVertex& vertex) {
-      for (FloatVertexAttribute& attribute : vertexAttributes) {
-        const float* pInput0 = reinterpret_cast<const float*>(
-            attribute.buffer.data() + attribute.offset +
-            attribute.stride * vertex.first);
-        const float* pInput1 = reinterpret_cast<const float*>(
-            attribute.buffer.data() + attribute.offset +
-            attribute.stride * vertex.second);
-        for (int32_t i = 0; i < attribute.numberOfFloatsPerVertex; ++i) {
-          const float value = glm::mix(*pInput0, *pInput1, vertex.t);
-          output.push_back(value);
-          if (!skipMinMaxUpdate) {
-            attribute.minimums[static_cast<size_t>(i)] = glm::min(
-                attribute.minimums[static_cast<size_t>(i)],
-                static_cast<double>(value));
-            attribute.maximums[static_cast<size_t>(i)] = glm::max(
-                attribute.maximums[static_cast<size_t>(i)],
-                static_cast<double>(value));
-          }
-          ++pInput0;
-          ++pInput1;
-        }
-      }
-    }
-  };
+  const CesiumGeometry::InterpolatedVertex& interpolated =
+      std::get<CesiumGeometry::InterpolatedVertex>(clipVertex);
+  const uint32_t first = static_cast<uint32_t>(interpolated.first);
+  const uint32_t second = static_cast<uint32_t>(interpolated.second);
 
-  std::visit(Operation{vertexAttributes, output, skipMinMaxUpdate}, vertex);
-}
+  const std::pair<uint32_t, bool> found = scratch.clipVertices.findOrInsert(
+      makeClipVertexKey(first, second, axis),
+      static_cast<uint32_t>(scratch.uvs.size()));
+  if (!found.second) {
+    return found.first;
+  }
 
-static void copyVertexAttributes(
-    std::vector<FloatVertexAttribute>& vertexAttributes,
-    const std::vector<CesiumGeometry::TriangleClipVertex>& complements,
-    const CesiumGeometry::TriangleClipVertex& vertex,
-    std::vector<float>& output) {
-  struct Operation {
-    std::vector<FloatVertexAttribute>& vertexAttributes;
-    const std::vector<CesiumGeometry::TriangleClipVertex>& complements;
-    std::vector<float>& output;
-
-    void operator()(int vertexIndex) {
-      if (vertexIndex < 0) {
-        copyVertexAttributes(
-            vertexAttributes,
-            complements[static_cast<size_t>(~vertexIndex)],
-            output);
-      } else {
-        copyVertexAttributes(vertexAttributes, vertexIndex, output);
-      }
-    }
+  // Interpolate every attribute at once over the packed vertex data.
+  const size_t newOffset = scratch.vertices.size();
+  scratch.vertices.resize(newOffset + vertexSizeFloats);
+  const float* pInput0 = scratch.vertices.data() + first * vertexSizeFloats;
+  const float* pInput1 = scratch.vertices.data() + second * vertexSizeFloats;
+  float* pOutput = scratch.vertices.data() + newOffset;
+  for (size_t i = 0; i < vertexSizeFloats; ++i) {
+    pOutput[i] = glm::mix(pInput0[i], pInput1[i], interpolated.t);
+  }
 
-    void operator()(const CesiumGeometry::InterpolatedVertex& vertex) {
-      size_t outputIndex0 = output.size();
-
-      // Copy the two vertices into the output array
-      if (vertex.first < 0) {
-        copyVertexAttributes(
-            vertexAttributes,
-            complements[static_cast<size_t>(~vertex.first)],
-            output,
-            true);
-      } else {
-        copyVertexAttributes(vertexAttributes, vertex.first, output, true);
-      }
+  const glm::vec2 uv0 = scratch.uvs[first];
+  const glm::vec2 uv1 = scratch.uvs[second];
+  scratch.uvs.push_back(glm::mix(uv0, uv1, interpolated.t));
 
-      size_t outputIndex1 = output.size();
+  return found.first;
+}
 
-      if (vertex.second < 0) {
-        copyVertexAttributes(
-            vertexAttributes,
-            complements[static_cast<size_t>(~vertex.second)],
-            output,
-            true);
-      } else {
-        copyVertexAttributes(vertexAttributes, vertex.second, output, true);
-      }
+static uint32_t getOrCreateVertex(
+    UpsampledPrimitive& child,
+    const UpsampleScratch& scratch,
+    size_t vertexSizeFloats,
+    uint32_t vertexID) {
+  if (vertexID >= child.vertexIndices.size()) {
+    child.vertexIndices.resize(size_t(vertexID) + 1, NO_VERTEX);
+  }
 
-      // Interpolate between them and overwrite the first with the result.
-      for (FloatVertexAttribute& attribute : vertexAttributes) {
-        for (int32_t i = 0; i < attribute.numberOfFloatsPerVertex; ++i) {
-          float value =
-              glm::mix(output[outputIndex0], output[outputIndex1], vertex.t);
-          output[outputIndex0] = value;
-          attribute.minimums[static_cast<size_t>(i)] = glm::min(
-              attribute.minimums[static_cast<size_t>(i)],
-              static_cast<double>(value));
-          attribute.maximums[static_cast<size_t>(i)] = glm::max(
-              attribute.maximums[static_cast<size_t>(i)],
-              static_cast<double>(value));
-          ++outputIndex0;
-          ++outputIndex1;
-        }
-      }
+  uint32_t& index = child.vertexIndices[vertexID];
+  if (index != NO_VERTEX) {
+    return index;
+  }
 
-      // Remove the temporary second, which is now pointed to be outputIndex0.
-      output.erase(
-          output.begin() +
-              static_cast<std::vector<float>::iterator::difference_type>(
-                  outputIndex0),
-          output.end());
-    }
-  };
+  index = static_cast<uint32_t>(child.uvs.size());
+  const float* pInput = scratch.vertices.data() + vertexID * vertexSizeFloats;
+  child.vertices.insert(
+      child.vertices.end(),
+      pInput,
+      pInput + vertexSizeFloats);
+  child.uvs.push_back(scratch.uvs[vertexID]);
 
-  std::visit(
-      Operation{
-          vertexAttributes,
-          complements,
-          output,
-      },
-      vertex);
+  return index;
 }
 
-template <class T>
-static T getVertexValue(
-    const AccessorView<T>& accessor,
-    const CesiumGeometry::TriangleClipVertex& vertex) {
-  struct Operation {
-    const AccessorView<T>& accessor;
+static void addEdge(
+    EdgeIndices& edgeIndices,
+    double thresholdU,
+    double thresholdV,
+    bool keepAboveU,
+    bool keepAboveV,
+    uint32_t index,
+    const glm::vec2& uv) {
+  if (CesiumUtility::Math::equalsEpsilon(
+          uv.x,
+          0.0,
+          CesiumUtility::Math::EPSILON4)) {
+    edgeIndices.west.emplace_back(EdgeVertex{index, uv});
+  }
 
-    T operator()(int vertexIndex) { return accessor[vertexIndex]; }
+  if (CesiumUtility::Math::equalsEpsilon(
+          uv.x,
+          1.0,
+          CesiumUtility::Math::EPSILON4)) {
+    edgeIndices.east.emplace_back(EdgeVertex{index, uv});
+  }
 
-    T operator()(const CesiumGeometry::InterpolatedVertex& vertex) {
-      const T& v0 = accessor[vertex.first];
-      const T& v1 = accessor[vertex.second];
-      return glm::mix(v0, v1, vertex.t);
+  if (CesiumUtility::Math::equalsEpsilon(
+          uv.x,
+          thresholdU,
+          CesiumUtility::Math::EPSILON4)) {
+    if (keepAboveU) {
+      edgeIndices.west.emplace_back(EdgeVertex{index, uv});
+    } else {
+      edgeIndices.east.emplace_back(EdgeVertex{index, uv});
     }
-  };
+  }
 
-  return std::visit(Operation{accessor}, vertex);
-}
+  if (CesiumUtility::Math::equalsEpsilon(
+          uv.y,
+          0.0,
+          CesiumUtility::Math::EPSILON4)) {
+    edgeIndices.south.emplace_back(EdgeVertex{index, uv});
+  }
 
-template <class T>
-static T getVertexValue(
-    const AccessorView<T>& accessor,
-    const std::vector<CesiumGeometry::TriangleClipVertex>& complements,
-    const CesiumGeometry::TriangleClipVertex& vertex) {
-  struct Operation {
-    const AccessorView<T>& accessor;
-    const std::vector<CesiumGeometry::TriangleClipVertex>& complements;
-
-    T operator()(int vertexIndex) {
-      if (vertexIndex < 0) {
-        return getVertexValue(
-            accessor,
-            complements,
-            complements[static_cast<size_t>(~vertexIndex)]);
-      }
+  if (CesiumUtility::Math::equalsEpsilon(
+          uv.y,
+          1.0,
+          CesiumUtility::Math::EPSILON4)) {
+    edgeIndices.north.emplace_back(EdgeVertex{index, uv});
+  }
 
-      return accessor[vertexIndex];
+  if (CesiumUtility::Math::equalsEpsilon(
+          uv.y,
+          thresholdV,
+          CesiumUtility::Math::EPSILON4)) {
+    if (keepAboveV) {
+      edgeIndices.south.emplace_back(EdgeVertex{index, uv});
+    } else {
+      edgeIndices.north.emplace_back(EdgeVertex{index, uv});
     }
+  }
+}
 
-    T operator()(const CesiumGeometry::InterpolatedVertex& vertex) {
-      T v0{};
-      if (vertex.first < 0) {
-        v0 = getVertexValue(
-            accessor,
-            complements,
-            complements[static_cast<size_t>(~vertex.first)]);
-      } else {
-        v0 = accessor[vertex.first];
-      }
+/**
+ * Clips a triangle that is already on the correct East-West side of the child
+ * against the North-South boundary and adds the result, if any, to the child.
+ */
+static void addClippedTriangle(
+    UpsampledPrimitive& child,
+    UpsampleScratch& scratch,
+    size_t vertexSizeFloats,
+    bool keepAboveU,
+    bool keepAboveV,
+    bool hasSkirt,
+    uint32_t id0,
+    uint32_t id1,
+    uint32_t id2) {
+  scratch.clippedB.clear();
+  CesiumGeometry::clipTriangleAtAxisAlignedThreshold(
+      0.5,
+      keepAboveV,
+      static_cast<int>(id0),
+      static_cast<int>(id1),
+      static_cast<int>(id2),
+      scratch.uvs[id0].y,
+      scratch.uvs[id1].y,
+      scratch.uvs[id2].y,
+      scratch.clippedB);
+
+  const size_t polygonSize = scratch.clippedB.size();
+  if (polygonSize < 3) {
+    return;
+  }
 
-      T v1{};
-      if (vertex.second < 0) {
-        v1 = getVertexValue(
-            accessor,
-            complements,
-            complements[static_cast<size_t>(~vertex.second)]);
-      } else {
-        v1 = accessor[vertex.second];
-      }
+  std::array<uint32_t, 4> polygon{};
+  for (size_t i = 0; i < polygonSize; ++i) {
+    const uint32_t vertexID = getVertexID(
+        scratch,
+        vertexSizeFloats,
+        scratch.clippedB[i],
+        ClipAxis::V);
+    polygon[i] = getOrCreateVertex(child, scratch, vertexSizeFloats, vertexID);
+  }
 
-      return glm::mix(v0, v1, vertex.t);
-    }
-  };
+  child.indices.push_back(polygon[0]);
+  child.indices.push_back(polygon[1]);
+  child.indices.push_back(polygon[2]);
 
-  return std::visit(Operation{accessor, complements}, vertex);
+  if (polygonSize > 3) {
+    child.indices.push_back(polygon[0]);
+    child.indices.push_back(polygon[2]);
+    child.indices.push_back(polygon[3]);
+  }
+
+  if (hasSkirt) {
+    for (size_t i = 0; i < polygonSize; ++i) {
+      addEdge(
+          child.edgeIndices,
+          0.5,
+          0.5,
+          keepAboveU,
+          keepAboveV,
+          polygon[i],
+          child.uvs[polygon[i]]);
+    }
+  }
 }
 
 template <class TIndex>
 static void upsamplePrimitiveForRasterOverlays(
     const Model& parentModel,
-    Model& model,
-    Mesh& /*mesh*/,
-    MeshPrimitive& primitive,
-    CesiumGeometry::UpsampledQuadtreeNode childID) {
+    const MeshPrimitive& parentPrimitive,
+    size_t meshIndex,
+    size_t primitiveIndex,
+    const std::array<UpsampledChild, QUADRANT_COUNT>& children,
+    UpsampleScratch& scratch) {
   CESIUM_TRACE("upsamplePrimitiveForRasterOverlays");
 
-  // Add up the per-vertex size of all attributes and create buffers,
-  // bufferViews, and accessors
-  std::vector<FloatVertexAttribute> attributes;
-  attributes.reserve(primitive.attributes.size());
-
-  const size_t vertexBufferIndex = model.buffers.size();
-  model.buffers.emplace_back();
-
-  const size_t indexBufferIndex = model.buffers.size();
-  model.buffers.emplace_back();
+  // Gather the attributes to upsample, and make sure we can read all of them.
+  std::vector<FloatVertexAttribute>& attributes = scratch.attributes;
+  attributes.clear();
 
-  const size_t vertexBufferViewIndex = model.bufferViews.size();
-  model.bufferViews.emplace_back();
-
-  const size_t indexBufferViewIndex = model.bufferViews.size();
-  model.bufferViews.emplace_back();
-
-  BufferView& vertexBufferView = model.bufferViews[vertexBufferViewIndex];
-  vertexBufferView.buffer = static_cast<int>(vertexBufferIndex);
-  vertexBufferView.target = BufferView::Target::ARRAY_BUFFER;
-
-  BufferView& indexBufferView = model.bufferViews[indexBufferViewIndex];
-  indexBufferView.buffer = static_cast<int>(indexBufferIndex);
-  indexBufferView.target = BufferView::Target::ARRAY_BUFFER;
+  std::vector<const std::string*> toRemove;
 
   int64_t vertexSizeFloats = 0;
+  int64_t positionOffset = -1;
   int32_t uvAccessorIndex = -1;
-  int32_t positionAttributeIndex = -1;
+  int64_t minimumAttributeCount = std::numeric_limits<int64_t>::max();
 
-  std::vector<std::string> toRemove;
-
-  for (std::pair<const std::string, int>& attribute : primitive.attributes) {
+  for (const std::pair<const std::string, int>& attribute :
+       parentPrimitive.attributes) {
     if (attribute.first.find("_CESIUMOVERLAY_") == 0) {
       if (uvAccessorIndex == -1) {
         uvAccessorIndex = attribute.second;
       }
 
       // Do not include _CESIUMOVERLAY_*, it will be generated later.
-      toRemove.push_back(attribute.first);
+      toRemove.push_back(&attribute.first);
       continue;
     }
 
-    if (attribute.second < 0 ||
-        attribute.second >= static_cast<int>(parentModel.accessors.size())) {
-      toRemove.push_back(attribute.first);
+    const Accessor* pAccessor =
+        Model::getSafe(&parentModel.accessors, attribute.second);
+    const BufferView* pBufferView =
+        pAccessor
+            ? Model::getSafe(&parentModel.bufferViews, pAccessor->bufferView)
+            : nullptr;
+    const Buffer* pBuffer =
+        pBufferView ? Model::getSafe(&parentModel.buffers, pBufferView->buffer)
+                    : nullptr;
+    if (!pBuffer) {
+      toRemove.push_back(&attribute.first);
       continue;
     }
 
-    const Accessor& accessor =
-        parentModel.accessors[static_cast<size_t>(attribute.second)];
-    if (accessor.bufferView < 0 ||
-        accessor.bufferView >=
-            static_cast<int>(parentModel.bufferViews.size())) {
-      toRemove.push_back(attribute.first);
-      continue;
+    const int64_t componentBytes = pAccessor->computeByteSizeOfComponent();
+    if (componentBytes == 0 ||
+        pAccessor->componentType == Accessor::ComponentType::UNSIGNED_INT) {
+      // Can only interpolate floating point vertex attributes and the integer
+      // vertex attributes of KHR_mesh_quantization
+      return;
     }
 
-    const BufferView& bufferView =
-        parentModel.bufferViews[static_cast<size_t>(accessor.bufferView)];
-    if (bufferView.buffer < 0 ||
-        bufferView.buffer >= static_cast<int>(parentModel.buffers.size())) {
-      toRemove.push_back(attribute.first);
+    const int64_t numberOfFloats = pAccessor->computeNumberOfComponents();
+    const int64_t stride = pAccessor->computeByteStride(parentModel);
+    const int64_t byteOffset = pBufferView->byteOffset + pAccessor->byteOffset;
+    const int64_t bytesRequired =
+        pAccessor->count > 0
+            ? byteOffset + stride * (pAccessor->count - 1) +
+                  numberOfFloats * componentBytes
+            : 0;
+    if (numberOfFloats <= 0 || stride <= 0 || byteOffset < 0 ||
+        bytesRequired > int64_t(pBuffer->cesium.data.size())) {
+      toRemove.push_back(&attribute.first);
       continue;
     }
 
-    const Buffer& buffer =
-        parentModel.buffers[static_cast<size_t>(bufferView.buffer)];
-
-    const int64_t accessorByteStride = accessor.computeByteStride(parentModel);
-    const int64_t accessorComponentElements =
-        accessor.computeNumberOfComponents();
-    if (accessor.componentType != Accessor::ComponentType::FLOAT) {
-      // Can only interpolate floating point vertex attributes
-      return;
+    if (attribute.first == "POSITION") {
+      positionOffset = vertexSizeFloats;
     }
 
-    attribute.second = static_cast<int>(model.accessors.size());
-    model.accessors.emplace_back();
-    Accessor& newAccessor = model.accessors.back();
-    newAccessor.bufferView = static_cast<int>(vertexBufferIndex);
-    newAccessor.byteOffset = vertexSizeFloats * int64_t(sizeof(float));
-    newAccessor.componentType = Accessor::ComponentType::FLOAT;
-    newAccessor.type = accessor.type;
-
-    vertexSizeFloats += accessorComponentElements;
-
     attributes.push_back(FloatVertexAttribute{
-        buffer.cesium.data,
-        accessor.byteOffset,
-        accessorByteStride,
-        accessorComponentElements,
-        attribute.second,
-        std::vector<double>(
-            static_cast<size_t>(accessorComponentElements),
-            std::numeric_limits<double>::max()),
-        std::vector<double>(
-            static_cast<size_t>(accessorComponentElements),
-            std::numeric_limits<double>::lowest()),
-    });
-
-    // get position to be used to create for skirts later
-    if (attribute.first == "POSITION") {
-      positionAttributeIndex = int32_t(attributes.size() - 1);
-    }
+        &attribute.first,
+        pBuffer->cesium.data.data() + byteOffset,
+        stride,
+        numberOfFloats,
+        vertexSizeFloats,
+        pAccessor->type,
+        pAccessor->componentType,
+        pAccessor->normalized,
+        pAccessor->componentType,
+        0});
+
+    vertexSizeFloats += numberOfFloats;
+    minimumAttributeCount = std::min(minimumAttributeCount, pAccessor->count);
   }
 
-  if (uvAccessorIndex == -1) {
+  if (uvAccessorIndex == -1 || vertexSizeFloats == 0) {
     // We don't know how to divide this primitive, so just copy it verbatim.
     // TODO
     return;
   }
 
-  for (const std::string& attribute : toRemove) {
-    primitive.attributes.erase(attribute);
-  }
-
-  const bool keepAboveU = !isWestChild(childID);
-  const bool keepAboveV = !isSouthChild(childID);
-
-  const AccessorView<glm::vec2> uvView(parentModel, uvAccessorIndex);
-  const AccessorView<TIndex> indicesView(parentModel, primitive.indices);
+  const DequantizedAccessorView<glm::vec2> uvView(
+      parentModel,
+      uvAccessorIndex);
+  const AccessorView<TIndex> indicesView(parentModel, parentPrimitive.indices);
 
   if (uvView.status() != AccessorViewStatus::Valid ||
       indicesView.status() != AccessorViewStatus::Valid) {
     return;
   }
 
-  // check if the primitive has skirts
-  int64_t indicesBegin = 0;
-  int64_t indicesCount = indicesView.size();
-  std::optional<SkirtMeshMetadata> parentSkirtMeshMetadata =
-      SkirtMeshMetadata::parseFromGltfExtras(primitive.extras);
-  const bool hasSkirt = (parentSkirtMeshMetadata != std::nullopt) &&
-                        (positionAttributeIndex != -1);
-  if (hasSkirt) {
-    indicesBegin = parentSkirtMeshMetadata->noSkirtIndicesBegin;
-    indicesCount = parentSkirtMeshMetadata->noSkirtIndicesCount;
+  const int64_t vertexCount = uvView.size();
+  if (minimumAttributeCount < vertexCount ||
+      vertexCount >= int64_t(std::numeric_limits<int32_t>::max() / 2)) {
+    return;
   }
 
-  std::vector<uint32_t> clipVertexToIndices;
-  std::vector<CesiumGeometry::TriangleClipVertex> clippedA;
-  std::vector<CesiumGeometry::TriangleClipVertex> clippedB;
-
-  // Maps old (parentModel) vertex indices to new (model) vertex indices.
-  std::vector<uint32_t> vertexMap(
-      size_t(uvView.size()),
-      std::numeric_limits<uint32_t>::max());
+  const size_t vertexSize = size_t(vertexSizeFloats);
+  const size_t parentVertexCount = size_t(vertexCount);
 
-  // std::vector<unsigned char> newVertexBuffer(vertexSizeFloats *
-  // sizeof(float)); gsl::span<float>
-  // newVertexFloats(reinterpret_cast<float*>(newVertexBuffer.data()),
-  // newVertexBuffer.size() / sizeof(float));
-  std::vector<float> newVertexFloats;
-  std::vector<uint32_t> indices;
-  EdgeIndices edgeIndices;
+  // Copy the parent vertices into one packed array so that all attributes of a
+  // vertex can be copied or interpolated with a single loop. Each attribute is
+  // read with one bulk pass over its (possibly interleaved) source.
+  scratch.vertices.resize(parentVertexCount * vertexSize);
+  for (const FloatVertexAttribute& attribute : attributes) {
+    withComponentType(attribute.componentType, [&](auto component) {
+      readVertexAttribute<decltype(component)>(
+          attribute,
+          parentVertexCount,
+          vertexSize,
+          scratch.vertices.data());
+    });
+  }
 
-  for (int64_t i = indicesBegin; i < indicesBegin + indicesCount; i += 3) {
-    TIndex i0 = indicesView[i];
-    TIndex i1 = indicesView[i + 1];
-    TIndex i2 = indicesView[i + 2];
-
-    const glm::vec2 uv0 = uvView[i0];
-    const glm::vec2 uv1 = uvView[i1];
-    const glm::vec2 uv2 = uvView[i2];
-
-    // Clip this triangle against the East-West boundary
-    clippedA.clear();
-    clipTriangleAtAxisAlignedThreshold(
-        0.5,
-        keepAboveU,
-        static_cast<int>(i0),
-        static_cast<int>(i1),
-        static_cast<int>(i2),
-        uv0.x,
-        uv1.x,
-        uv2.x,
-        clippedA);
-
-    if (clippedA.size() < 3) {
-      // No part of this triangle is inside the target tile.
-      continue;
-    }
+  scratch.uvs.resize(parentVertexCount);
+  for (size_t i = 0; i < parentVertexCount; ++i) {
+    scratch.uvs[i] = uvView[int64_t(i)];
+  }
 
-    // Clip the first clipped triange against the North-South boundary
-    clipVertexToIndices.clear();
-    clippedB.clear();
-    clipTriangleAtAxisAlignedThreshold(
-        0.5,
-        keepAboveV,
-        ~0,
-        ~1,
-        ~2,
-        getVertexValue(uvView, clippedA[0]).y,
-        getVertexValue(uvView, clippedA[1]).y,
-        getVertexValue(uvView, clippedA[2]).y,
-        clippedB);
-
-    // Add the clipped triangle or quad, if any
-    addClippedPolygon(
-        newVertexFloats,
-        indices,
-        attributes,
-        vertexMap,
-        clipVertexToIndices,
-        clippedA,
-        clippedB);
-    if (hasSkirt) {
-      addEdge(
-          edgeIndices,
-          0.5,
-          0.5,
-          keepAboveU,
-          keepAboveV,
-          uvView,
-          clipVertexToIndices,
-          clippedA,
-          clippedB);
-    }
+  scratch.clipVertices.clear(parentVertexCount / 4);
 
-    // If the East-West clip yielded a quad (rather than a triangle), clip the
-    // second triangle of the quad, too.
-    if (clippedA.size() > 3) {
-      clipVertexToIndices.clear();
-      clippedB.clear();
-      clipTriangleAtAxisAlignedThreshold(
-          0.5,
-          keepAboveV,
-          ~0,
-          ~2,
-          ~3,
-          getVertexValue(uvView, clippedA[0]).y,
-          getVertexValue(uvView, clippedA[2]).y,
-          getVertexValue(uvView, clippedA[3]).y,
-          clippedB);
-
-      // Add the clipped triangle or quad, if any
-      addClippedPolygon(
-          newVertexFloats,
-          indices,
-          attributes,
-          vertexMap,
-          clipVertexToIndices,
-          clippedA,
-          clippedB);
-      if (hasSkirt) {
-        addEdge(
-            edgeIndices,
-            0.5,
-            0.5,
-            keepAboveU,
-            keepAboveV,
-            uvView,
-            clipVertexToIndices,
-            clippedA,
-            clippedB);
-      }
+  for (size_t quadrant = 0; quadrant < QUADRANT_COUNT; ++quadrant) {
+    if (children[quadrant].pModel) {
+      scratch.children[quadrant].clear(parentVertexCount);
     }
   }
 
-  // create mesh with skirt
-  std::optional<SkirtMeshMetadata> skirtMeshMetadata;
+  // check if the primitive has skirts
+  int64_t indicesBegin = 0;
+  int64_t indicesCount = indicesView.size();
+  const std::optional<SkirtMeshMetadata> parentSkirtMeshMetadata =
+      SkirtMeshMetadata::parseFromGltfExtras(parentPrimitive.extras);
+  const bool hasSkirt =
+      (parentSkirtMeshMetadata != std::nullopt) && (positionOffset != -1);
   if (hasSkirt) {
-    skirtMeshMetadata = std::make_optional<SkirtMeshMetadata>();
-    skirtMeshMetadata->noSkirtIndicesBegin = 0;
-    skirtMeshMetadata->noSkirtIndicesCount =
-        static_cast<uint32_t>(indices.size());
-    skirtMeshMetadata->meshCenter = parentSkirtMeshMetadata->meshCenter;
-    addSkirts(
-        newVertexFloats,
-        indices,
-        attributes,
-        childID,
-        *skirtMeshMetadata,
-        *parentSkirtMeshMetadata,
-        edgeIndices,
-        vertexSizeFloats,
-        positionAttributeIndex);
-  }
-
-  // Update the accessor vertex counts and min/max values
-  const int64_t numberOfVertices =
-      int64_t(newVertexFloats.size()) / vertexSizeFloats;
-  for (const FloatVertexAttribute& attribute : attributes) {
-    Accessor& accessor =
-        model.accessors[static_cast<size_t>(attribute.accessorIndex)];
-    accessor.count = numberOfVertices;
-    accessor.min = std::move(attribute.minimums);
-    accessor.max = std::move(attribute.maximums);
+    indicesBegin = parentSkirtMeshMetadata->noSkirtIndicesBegin;
+    indicesCount = std::min(
+        int64_t(parentSkirtMeshMetadata->noSkirtIndicesCount),
+        indicesView.size() - indicesBegin);
   }
 
-  // Add an accessor for the indices
-  const size_t indexAccessorIndex = model.accessors.size();
-  model.accessors.emplace_back();
-  Accessor& newIndicesAccessor = model.accessors.back();
-  newIndicesAccessor.bufferView = static_cast<int>(indexBufferViewIndex);
-  newIndicesAccessor.byteOffset = 0;
-  newIndicesAccessor.count = int64_t(indices.size());
-  newIndicesAccessor.componentType = Accessor::ComponentType::UNSIGNED_INT;
-  newIndicesAccessor.type = Accessor::Type::SCALAR;
-
-  // Populate the buffers
-  Buffer& vertexBuffer = model.buffers[vertexBufferIndex];
-  vertexBuffer.cesium.data.resize(newVertexFloats.size() * sizeof(float));
-  float* pAsFloats = reinterpret_cast<float*>(vertexBuffer.cesium.data.data());
-  std::copy(newVertexFloats.begin(), newVertexFloats.end(), pAsFloats);
-  vertexBufferView.byteLength = int64_t(vertexBuffer.cesium.data.size());
-  vertexBufferView.byteStride = vertexSizeFloats * int64_t(sizeof(float));
-
-  Buffer& indexBuffer = model.buffers[indexBufferIndex];
-  indexBuffer.cesium.data.resize(indices.size() * sizeof(uint32_t));
-  uint32_t* pAsUint32s =
-      reinterpret_cast<uint32_t*>(indexBuffer.cesium.data.data());
-  std::copy(indices.begin(), indices.end(), pAsUint32s);
-  indexBufferView.byteLength = int64_t(indexBuffer.cesium.data.size());
-
-  bool onlyWater = false;
-  bool onlyLand = true;
-  int64_t waterMaskTextureId = -1;
-
-  auto onlyWaterIt = primitive.extras.find("OnlyWater");
-  auto onlyLandIt = primitive.extras.find("OnlyLand");
-
-  if (onlyWaterIt != primitive.extras.end() && onlyWaterIt->second.isBool() &&
-      onlyLandIt != primitive.extras.end() && onlyLandIt->second.isBool()) {
-
-    onlyWater = onlyWaterIt->second.getBoolOrDefault(false);
-    onlyLand = onlyLandIt->second.getBoolOrDefault(true);
-
-    if (!onlyWater && !onlyLand) {
-      // We have to use the parent's water mask
-      auto waterMaskTextureIdIt = primitive.extras.find("WaterMaskTex");
-      if (waterMaskTextureIdIt != primitive.extras.end() &&
-          waterMaskTextureIdIt->second.isInt64()) {
-        waterMaskTextureId = waterMaskTextureIdIt->second.getInt64OrDefault(-1);
-      }
+  // Lay out the upsampled vertices with each attribute in its parent's
+  // component type, padded to four bytes as glTF requires. Skirt vertices are
+  // outside the range of quantized positions, so positions with skirts are
+  // written as floats.
+  int64_t vertexByteStride = 0;
+  for (FloatVertexAttribute& attribute : attributes) {
+    if (hasSkirt && attribute.offsetInVertex == positionOffset) {
+      attribute.outputComponentType = Accessor::ComponentType::FLOAT;
     }
-  }
 
-  double waterMaskTranslationX = 0.0;
-  double waterMaskTranslationY = 0.0;
-  double waterMaskScale = 0.0;
-
-  auto waterMaskTranslationXIt = primitive.extras.find("WaterMaskTranslationX");
-  auto waterMaskTranslationYIt = primitive.extras.find("WaterMaskTranslationY");
-  auto waterMaskScaleIt = primitive.extras.find("WaterMaskScale");
-
-  if (waterMaskTranslationXIt != primitive.extras.end() &&
-      waterMaskTranslationXIt->second.isDouble() &&
-      waterMaskTranslationYIt != primitive.extras.end() &&
-      waterMaskTranslationYIt->second.isDouble() &&
-      waterMaskScaleIt != primitive.extras.end() &&
-      waterMaskScaleIt->second.isDouble()) {
-    waterMaskScale = 0.5 * waterMaskScaleIt->second.getDoubleOrDefault(0.0);
-    waterMaskTranslationX =
-        waterMaskTranslationXIt->second.getDoubleOrDefault(0.0) +
-        waterMaskScale * (childID.tileID.x % 2);
-    waterMaskTranslationY =
-        waterMaskTranslationYIt->second.getDoubleOrDefault(0.0) +
-        waterMaskScale * (childID.tileID.y % 2);
+    attribute.outputByteOffset = vertexByteStride;
+    const int64_t attributeBytes =
+        attribute.numberOfFloatsPerVertex *
+        Accessor::computeByteSizeOfComponent(attribute.outputComponentType);
+    vertexByteStride += (attributeBytes + 3) & ~int64_t(3);
   }
 
-  // add skirts to extras to be upsampled later if needed
-  if (hasSkirt) {
-    primitive.extras = SkirtMeshMetadata::createGltfExtras(*skirtMeshMetadata);
-  }
-
-  primitive.extras.emplace("OnlyWater", onlyWater);
-  primitive.extras.emplace("OnlyLand", onlyLand);
+  // Clip every parent triangle once against the East-West boundary for each
+  // requested side, and then clip the result against the North-South boundary
+  // for each requested child on that side.
+  const int64_t indicesEnd = indicesBegin + indicesCount;
+  for (int64_t i = indicesBegin; i + 2 < indicesEnd; i += 3) {
+    const uint32_t i0 = static_cast<uint32_t>(indicesView[i]);
+    const uint32_t i1 = static_cast<uint32_t>(indicesView[i + 1]);
+    const uint32_t i2 = static_cast<uint32_t>(indicesView[i + 2]);
+    if (i0 >= parentVertexCount || i1 >= parentVertexCount ||
+        i2 >= parentVertexCount) {
+      continue;
+    }
 
-  primitive.extras.emplace("WaterMaskTex", waterMaskTextureId);
+    for (size_t east = 0; east < 2; ++east) {
+      if (!children[east].pModel && !children[east + 2].pModel) {
+        continue;
+      }
 
-  primitive.extras.emplace("WaterMaskTranslationX", waterMaskTranslationX);
-  primitive.extras.emplace("WaterMaskTranslationY", waterMaskTranslationY);
-  primitive.extras.emplace("WaterMaskScale", waterMaskScale);
+      const bool keepAboveU = east == 1;
 
-  primitive.indices = static_cast<int>(indexAccessorIndex);
-}
+      scratch.clippedA.clear();
+      CesiumGeometry::clipTriangleAtAxisAlignedThreshold(
+          0.5,
+          keepAboveU,
+          static_cast<int>(i0),
+          static_cast<int>(i1),
+          static_cast<int>(i2),
+          scratch.uvs[i0].x,
+          scratch.uvs[i1].x,
+          scratch.uvs[i2].x,
+          scratch.clippedA);
+
+      if (scratch.clippedA.size() < 3) {
+        // No part of this triangle is inside the target tiles.
+        continue;
+      }
 
-static uint32_t getOrCreateVertex(
-    std::vector<float>& output,
-    std::vector<FloatVertexAttribute>& attributes,
-    std::vector<uint32_t>& vertexMap,
-    const std::vector<CesiumGeometry::TriangleClipVertex>& complements,
-    const CesiumGeometry::TriangleClipVertex& clipVertex) {
-  const int* pIndex = std::get_if<int>(&clipVertex);
-  if (pIndex) {
-    if (*pIndex < 0) {
-      return getOrCreateVertex(
-          output,
-          attributes,
-          vertexMap,
-          complements,
-          complements[static_cast<size_t>(~(*pIndex))]);
-    }
+      std::array<uint32_t, 4> idsA{};
+      for (size_t j = 0; j < scratch.clippedA.size(); ++j) {
+        idsA[j] =
+            getVertexID(scratch, vertexSize, scratch.clippedA[j], ClipAxis::U);
+      }
 
-    const uint32_t existingIndex = vertexMap[static_cast<size_t>(*pIndex)];
-    if (existingIndex != std::numeric_limits<uint32_t>::max()) {
-      return existingIndex;
-    }
-  }
+      for (size_t north = 0; north < 2; ++north) {
+        const size_t quadrant = east + 2 * north;
+        if (!children[quadrant].pModel) {
+          continue;
+        }
 
-  const uint32_t beforeOutput = static_cast<uint32_t>(output.size());
-  copyVertexAttributes(attributes, complements, clipVertex, output);
-  uint32_t newIndex =
-      beforeOutput / (static_cast<uint32_t>(output.size()) - beforeOutput);
+        const bool keepAboveV = north == 1;
+        UpsampledPrimitive& child = scratch.children[quadrant];
 
-  if (pIndex && *pIndex >= 0) {
-    vertexMap[static_cast<size_t>(*pIndex)] = newIndex;
+        addClippedTriangle(
+            child,
+            scratch,
+            vertexSize,
+            keepAboveU,
+            keepAboveV,
+            hasSkirt,
+            idsA[0],
+            idsA[1],
+            idsA[2]);
+
+        // If the East-West clip yielded a quad (rather than a triangle), clip
+        // the second triangle of the quad, too.
+        if (scratch.clippedA.size() > 3) {
+          addClippedTriangle(
+              child,
+              scratch,
+              vertexSize,
+              keepAboveU,
+              keepAboveV,
+              hasSkirt,
+              idsA[0],
+              idsA[2],
+              idsA[3]);
+        }
+      }
+    }
   }
 
-  return newIndex;
-}
+  for (size_t quadrant = 0; quadrant < QUADRANT_COUNT; ++quadrant) {
+    if (!children[quadrant].pModel) {
+      continue;
+    }
 
-static void addClippedPolygon(
-    std::vector<float>& output,
-    std::vector<uint32_t>& indices,
-    std::vector<FloatVertexAttribute>& attributes,
-    std::vector<uint32_t>& vertexMap,
-    std::vector<uint32_t>& clipVertexToIndices,
-    const std::vector<CesiumGeometry::TriangleClipVertex>& complements,
-    const std::vector<CesiumGeometry::TriangleClipVertex>& clipResult) {
-  if (clipResult.size() < 3) {
-    return;
-  }
+    Model& model = *children[quadrant].pModel;
+    const CesiumGeometry::UpsampledQuadtreeNode childID =
+        children[quadrant].childID;
+    MeshPrimitive& primitive =
+        model.meshes[meshIndex].primitives[primitiveIndex];
+    UpsampledPrimitive& child = scratch.children[quadrant];
 
-  const uint32_t i0 = getOrCreateVertex(
-      output,
-      attributes,
-      vertexMap,
-      complements,
-      clipResult[0]);
-  const uint32_t i1 = getOrCreateVertex(
-      output,
-      attributes,
-      vertexMap,
-      complements,
-      clipResult[1]);
-  const uint32_t i2 = getOrCreateVertex(
-      output,
-      attributes,
-      vertexMap,
-      complements,
-      clipResult[2]);
-
-  indices.push_back(i0);
-  indices.push_back(i1);
-  indices.push_back(i2);
-
-  clipVertexToIndices.push_back(i0);
-  clipVertexToIndices.push_back(i1);
-  clipVertexToIndices.push_back(i2);
-
-  if (clipResult.size() > 3) {
-    const uint32_t i3 = getOrCreateVertex(
-        output,
-        attributes,
-        vertexMap,
-        complements,
-        clipResult[3]);
-
-    indices.push_back(i0);
-    indices.push_back(i2);
-    indices.push_back(i3);
-
-    clipVertexToIndices.push_back(i3);
-  }
-}
+    for (const std::string* pName : toRemove) {
+      primitive.attributes.erase(*pName);
+    }
 
-static void addEdge(
-    EdgeIndices& edgeIndices,
-    double thresholdU,
-    double thresholdV,
-    bool keepAboveU,
-    bool keepAboveV,
-    const AccessorView<glm::vec2>& uvs,
-    const std::vector<uint32_t>& clipVertexToIndices,
-    const std::vector<CesiumGeometry::TriangleClipVertex>& complements,
-    const std::vector<CesiumGeometry::TriangleClipVertex>& clipResult) {
-  for (uint32_t i = 0; i < clipVertexToIndices.size(); ++i) {
-    const glm::vec2 uv = getVertexValue(uvs, complements, clipResult[i]);
-
-    if (CesiumUtility::Math::equalsEpsilon(
-            uv.x,
-            0.0,
-            CesiumUtility::Math::EPSILON4)) {
-      edgeIndices.west.emplace_back(EdgeVertex{clipVertexToIndices[i], uv});
+    // create mesh with skirt
+    std::optional<SkirtMeshMetadata> skirtMeshMetadata;
+    if (hasSkirt) {
+      skirtMeshMetadata = std::make_optional<SkirtMeshMetadata>();
+      skirtMeshMetadata->noSkirtIndicesBegin = 0;
+      skirtMeshMetadata->noSkirtIndicesCount =
+          static_cast<uint32_t>(child.indices.size());
+      skirtMeshMetadata->meshCenter = parentSkirtMeshMetadata->meshCenter;
+      addSkirts(
+          child,
+          scratch,
+          childID,
+          *skirtMeshMetadata,
+          *parentSkirtMeshMetadata,
+          vertexSize,
+          positionOffset);
     }
 
-    if (CesiumUtility::Math::equalsEpsilon(
-            uv.x,
-            1.0,
-            CesiumUtility::Math::EPSILON4)) {
-      edgeIndices.east.emplace_back(EdgeVertex{clipVertexToIndices[i], uv});
+    const size_t numberOfVertices = child.vertices.size() / vertexSize;
+
+    // Create buffers, bufferViews, and accessors
+    const size_t vertexBufferIndex = model.buffers.size();
+    model.buffers.emplace_back();
+
+    const size_t indexBufferIndex = model.buffers.size();
+    model.buffers.emplace_back();
+
+    const size_t vertexBufferViewIndex = model.bufferViews.size();
+    model.bufferViews.emplace_back();
+
+    const size_t indexBufferViewIndex = model.bufferViews.size();
+    model.bufferViews.emplace_back();
+
+    Buffer& vertexBuffer = model.buffers[vertexBufferIndex];
+    vertexBuffer.cesium.data.resize(
+        numberOfVertices * size_t(vertexByteStride));
+
+    for (const FloatVertexAttribute& attribute : attributes) {
+      // Write the attribute and compute its min/max in one pass over the final
+      // vertices, skirts included. The min/max of quantized attributes are of
+      // the stored values, as glTF requires.
+      const size_t components = size_t(attribute.numberOfFloatsPerVertex);
+      std::vector<double> minimums(
+          components,
+          std::numeric_limits<double>::max());
+      std::vector<double> maximums(
+          components,
+          std::numeric_limits<double>::lowest());
+      withComponentType(attribute.outputComponentType, [&](auto component) {
+        writeVertexAttribute<decltype(component)>(
+            attribute,
+            child.vertices,
+            vertexSize,
+            vertexByteStride,
+            vertexBuffer.cesium.data.data(),
+            minimums,
+            maximums);
+      });
+
+      primitive.attributes[*attribute.pName] =
+          static_cast<int>(model.accessors.size());
+      Accessor& newAccessor = model.accessors.emplace_back();
+      newAccessor.bufferView = static_cast<int>(vertexBufferViewIndex);
+      newAccessor.byteOffset = attribute.outputByteOffset;
+      newAccessor.count = int64_t(numberOfVertices);
+      newAccessor.componentType = attribute.outputComponentType;
+      newAccessor.normalized =
+          attribute.outputComponentType != Accessor::ComponentType::FLOAT &&
+          attribute.normalized;
+      newAccessor.type = attribute.type;
+      newAccessor.min = std::move(minimums);
+      newAccessor.max = std::move(maximums);
     }
 
-    if (CesiumUtility::Math::equalsEpsilon(
-            uv.x,
-            thresholdU,
-            CesiumUtility::Math::EPSILON4)) {
-      if (keepAboveU) {
-        edgeIndices.west.emplace_back(EdgeVertex{clipVertexToIndices[i], uv});
-      } else {
-        edgeIndices.east.emplace_back(EdgeVertex{clipVertexToIndices[i], uv});
+    // Add an accessor for the indices
+    const size_t indexAccessorIndex = model.accessors.size();
+    Accessor& newIndicesAccessor = model.accessors.emplace_back();
+    newIndicesAccessor.bufferView = static_cast<int>(indexBufferViewIndex);
+    newIndicesAccessor.byteOffset = 0;
+    newIndicesAccessor.count = int64_t(child.indices.size());
+    newIndicesAccessor.componentType = Accessor::ComponentType::UNSIGNED_INT;
+    newIndicesAccessor.type = Accessor::Type::SCALAR;
+
+    // Populate the buffers
+    BufferView& vertexBufferView = model.bufferViews[vertexBufferViewIndex];
+    vertexBufferView.buffer = static_cast<int>(vertexBufferIndex);
+    vertexBufferView.target = BufferView::Target::ARRAY_BUFFER;
+    vertexBufferView.byteLength = int64_t(vertexBuffer.cesium.data.size());
+    vertexBufferView.byteStride = vertexByteStride;
+
+    Buffer& indexBuffer = model.buffers[indexBufferIndex];
+    indexBuffer.cesium.data.resize(child.indices.size() * sizeof(uint32_t));
+    std::memcpy(
+        indexBuffer.cesium.data.data(),
+        child.indices.data(),
+        indexBuffer.cesium.data.size());
+
+    BufferView& indexBufferView = model.bufferViews[indexBufferViewIndex];
+    indexBufferView.buffer = static_cast<int>(indexBufferIndex);
+    indexBufferView.target = BufferView::Target::ELEMENT_ARRAY_BUFFER;
+    indexBufferView.byteLength = int64_t(indexBuffer.cesium.data.size());
+
+    bool onlyWater = false;
+    bool onlyLand = true;
+    int64_t waterMaskTextureId = -1;
+
+    auto onlyWaterIt = primitive.extras.find("OnlyWater");
+    auto onlyLandIt = primitive.extras.find("OnlyLand");
+
+    if (onlyWaterIt != primitive.extras.end() &&
+        onlyWaterIt->second.isBool() && onlyLandIt != primitive.extras.end() &&
+        onlyLandIt->second.isBool()) {
+
+      onlyWater = onlyWaterIt->second.getBoolOrDefault(false);
+      onlyLand = onlyLandIt->second.getBoolOrDefault(true);
+
+      if (!onlyWater && !onlyLand) {
+        // We have to use the parent's water mask
+        auto waterMaskTextureIdIt = primitive.extras.find("WaterMaskTex");
+        if (waterMaskTextureIdIt != primitive.extras.end() &&
+            waterMaskTextureIdIt->second.isInt64()) {
+          waterMaskTextureId =
+              waterMaskTextureIdIt->second.getInt64OrDefault(-1);
+        }
       }
     }
 
-    if (CesiumUtility::Math::equalsEpsilon(
-            uv.y,
-            0.0,
-            CesiumUtility::Math::EPSILON4)) {
-      edgeIndices.south.emplace_back(EdgeVertex{clipVertexToIndices[i], uv});
+    double waterMaskTranslationX = 0.0;
+    double waterMaskTranslationY = 0.0;
+    double waterMaskScale = 0.0;
+
+    auto waterMaskTranslationXIt =
+        primitive.extras.find("WaterMaskTranslationX");
+    auto waterMaskTranslationYIt =
+        primitive.extras.find("WaterMaskTranslationY");
+    auto waterMaskScaleIt = primitive.extras.find("WaterMaskScale");
+
+    if (waterMaskTranslationXIt != primitive.extras.end() &&
+        waterMaskTranslationXIt->second.isDouble() &&
+        waterMaskTranslationYIt != primitive.extras.end() &&
+        waterMaskTranslationYIt->second.isDouble() &&
+        waterMaskScaleIt != primitive.extras.end() &&
+        waterMaskScaleIt->second.isDouble()) {
+      waterMaskScale = 0.5 * waterMaskScaleIt->second.getDoubleOrDefault(0.0);
+      waterMaskTranslationX =
+          waterMaskTranslationXIt->second.getDoubleOrDefault(0.0) +
+          waterMaskScale * (childID.tileID.x % 2);
+      waterMaskTranslationY =
+          waterMaskTranslationYIt->second.getDoubleOrDefault(0.0) +
+          waterMaskScale * (childID.tileID.y % 2);
     }
 
-    if (CesiumUtility::Math::equalsEpsilon(
-            uv.y,
-            1.0,
-            CesiumUtility::Math::EPSILON4)) {
-      edgeIndices.north.emplace_back(EdgeVertex{clipVertexToIndices[i], uv});
+    // add skirts to extras to be upsampled later if needed
+    if (hasSkirt) {
+      primitive.extras =
+          SkirtMeshMetadata::createGltfExtras(*skirtMeshMetadata);
     }
 
-    if (CesiumUtility::Math::equalsEpsilon(
-            uv.y,
-            thresholdV,
-            CesiumUtility::Math::EPSILON4)) {
-      if (keepAboveV) {
-        edgeIndices.south.emplace_back(EdgeVertex{clipVertexToIndices[i], uv});
-      } else {
-        edgeIndices.north.emplace_back(EdgeVertex{clipVertexToIndices[i], uv});
-      }
-    }
+    primitive.extras.emplace("OnlyWater", onlyWater);
+    primitive.extras.emplace("OnlyLand", onlyLand);
+
+    primitive.extras.emplace("WaterMaskTex", waterMaskTextureId);
+
+    primitive.extras.emplace("WaterMaskTranslationX", waterMaskTranslationX);
+    primitive.extras.emplace("WaterMaskTranslationY", waterMaskTranslationY);
+    primitive.extras.emplace("WaterMaskScale", waterMaskScale);
+
+    primitive.indices = static_cast<int>(indexAccessorIndex);
   }
 }
 
 static void addSkirt(
-    std::vector<float>& output,
-    std::vector<uint32_t>& indices,
-    std::vector<FloatVertexAttribute>& attributes,
+    UpsampledPrimitive& child,
     const std::vector<uint32_t>& edgeIndices,
     const glm::dvec3& center,
     double skirtHeight,
-    int64_t vertexSizeFloats,
-    int32_t positionAttributeIndex) {
+    size_t vertexSizeFloats,
+    int64_t positionOffset) {
   const CesiumGeospatial::Ellipsoid& ellipsoid =
       CesiumGeospatial::Ellipsoid::WGS84;
 
-  uint32_t newEdgeIndex = uint32_t(output.size() / size_t(vertexSizeFloats));
+  uint32_t newEdgeIndex =
+      static_cast<uint32_t>(child.vertices.size() / vertexSizeFloats);
   for (size_t i = 0; i < edgeIndices.size(); ++i) {
     const uint32_t edgeIdx = edgeIndices[i];
-    uint32_t offset = 0;
-    for (size_t j = 0; j < attributes.size(); ++j) {
-      FloatVertexAttribute& attribute = attributes[j];
-      const uint32_t valueIndex = offset + uint32_t(vertexSizeFloats) * edgeIdx;
-
-      if (int32_t(j) == positionAttributeIndex) {
-        glm::dvec3 position{
-            output[valueIndex],
-            output[valueIndex + 1],
-            output[valueIndex + 2]};
-        position += center;
-
-        position -= skirtHeight * ellipsoid.geodeticSurfaceNormal(position);
-        position -= center;
-
-        for (uint32_t c = 0; c < 3; ++c) {
-          output.push_back(static_cast<float>(position[c]));
-          attribute.minimums[c] = glm::min(attribute.minimums[c], position[c]);
-          attribute.maximums[c] = glm::max(attribute.maximums[c], position[c]);
-        }
-      } else {
-        for (uint32_t c = 0;
-             c < static_cast<uint32_t>(attribute.numberOfFloatsPerVertex);
-             ++c) {
-          output.push_back(output[valueIndex + c]);
-          attribute.minimums[c] = glm::min(
-              attribute.minimums[c],
-              static_cast<double>(output.back()));
-          attribute.maximums[c] = glm::max(
-              attribute.maximums[c],
-              static_cast<double>(output.back()));
-        }
-      }
 
-      offset += static_cast<uint32_t>(attribute.numberOfFloatsPerVertex);
-    }
+    const size_t newOffset = child.vertices.size();
+    child.vertices.resize(newOffset + vertexSizeFloats);
+    float* pOutput = child.vertices.data() + newOffset;
+    std::copy_n(
+        child.vertices.data() + size_t(edgeIdx) * vertexSizeFloats,
+        vertexSizeFloats,
+        pOutput);
+
+    float* pPosition = pOutput + positionOffset;
+    glm::dvec3 position{pPosition[0], pPosition[1], pPosition[2]};
+    position += center;
+
+    position -= skirtHeight * ellipsoid.geodeticSurfaceNormal(position);
+    position -= center;
+
+    pPosition[0] = static_cast<float>(position.x);
+    pPosition[1] = static_cast<float>(position.y);
+    pPosition[2] = static_cast<float>(position.z);
 
     if (i < edgeIndices.size() - 1) {
       const uint32_t nextEdgeIdx = edgeIndices[i + 1];
-      indices.push_back(edgeIdx);
-      indices.push_back(nextEdgeIdx);
-      indices.push_back(newEdgeIndex);
+      child.indices.push_back(edgeIdx);
+      child.indices.push_back(nextEdgeIdx);
+      child.indices.push_back(newEdgeIndex);
 
-      indices.push_back(newEdgeIndex);
-      indices.push_back(nextEdgeIdx);
-      indices.push_back(newEdgeIndex + 1);
+      child.indices.push_back(newEdgeIndex);
+      child.indices.push_back(nextEdgeIdx);
+      child.indices.push_back(newEdgeIndex + 1);
     }
 
     ++newEdgeIndex;
   }
 }
 
+template <class Compare>
+static const std::vector<uint32_t>& sortEdge(
+    std::vector<EdgeVertex>& edge,
+    std::vector<uint32_t>& sortedEdge,
+    Compare compare) {
+  std::sort(edge.begin(), edge.end(), compare);
+
+  // Vertices shared by several triangles are reported once per triangle, but
+  // only need one skirt vertex.
+  sortedEdge.clear();
+  for (const EdgeVertex& vertex : edge) {
+    if (sortedEdge.empty() || sortedEdge.back() != vertex.index) {
+      sortedEdge.push_back(vertex.index);
+    }
+  }
+
+  return sortedEdge;
+}
+
 static void addSkirts(
-    std::vector<float>& output,
-    std::vector<uint32_t>& indices,
-    std::vector<FloatVertexAttribute>& attributes,
+    UpsampledPrimitive& child,
+    UpsampleScratch& scratch,
     CesiumGeometry::UpsampledQuadtreeNode childID,
     SkirtMeshMetadata& currentSkirt,
     const SkirtMeshMetadata& parentSkirt,
-    EdgeIndices& edgeIndices,
-    int64_t vertexSizeFloats,
-    int32_t positionAttributeIndex) {
+    size_t vertexSizeFloats,
+    int64_t positionOffset) {
   CESIUM_TRACE("addSkirts");
 
+  EdgeIndices& edgeIndices = child.edgeIndices;
+
   const glm::dvec3 center = currentSkirt.meshCenter;
   double shortestSkirtHeight =
       glm::min(parentSkirt.skirtWestHeight, parentSkirt.skirtEastHeight);
@@ -995,27 +1175,18 @@ static void addSkirts(
     currentSkirt.skirtWestHeight = shortestSkirtHeight * 0.5;
   }
 
-  std::vector<uint32_t> sortEdgeIndices(edgeIndices.west.size());
-  std::sort(
-      edgeIndices.west.begin(),
-      edgeIndices.west.end(),
-      [](const EdgeVertex& lhs, const EdgeVertex& rhs) {
-        return lhs.uv.y < rhs.uv.y;
-      });
-  std::transform(
-      edgeIndices.west.begin(),
-      edgeIndices.west.end(),
-      sortEdgeIndices.begin(),
-      [](const EdgeVertex& v) { return v.index; });
   addSkirt(
-      output,
-      indices,
-      attributes,
-      sortEdgeIndices,
+      child,
+      sortEdge(
+          edgeIndices.west,
+          scratch.sortedEdge,
+          [](const EdgeVertex& lhs, const EdgeVertex& rhs) {
+            return lhs.uv.y < rhs.uv.y;
+          }),
       center,
       currentSkirt.skirtWestHeight,
       vertexSizeFloats,
-      positionAttributeIndex);
+      positionOffset);
 
   // south
   if (isSouthChild(childID)) {
@@ -1024,27 +1195,18 @@ static void addSkirts(
     currentSkirt.skirtSouthHeight = shortestSkirtHeight * 0.5;
   }
 
-  sortEdgeIndices.resize(edgeIndices.south.size());
-  std::sort(
-      edgeIndices.south.begin(),
-      edgeIndices.south.end(),
-      [](const EdgeVertex& lhs, const EdgeVertex& rhs) {
-        return lhs.uv.x > rhs.uv.x;
-      });
-  std::transform(
-      edgeIndices.south.begin(),
-      edgeIndices.south.end(),
-      sortEdgeIndices.begin(),
-      [](const EdgeVertex& v) { return v.index; });
   addSkirt(
-      output,
-      indices,
-      attributes,
-      sortEdgeIndices,
+      child,
+      sortEdge(
+          edgeIndices.south,
+          scratch.sortedEdge,
+          [](const EdgeVertex& lhs, const EdgeVertex& rhs) {
+            return lhs.uv.x > rhs.uv.x;
+          }),
       center,
       currentSkirt.skirtSouthHeight,
       vertexSizeFloats,
-      positionAttributeIndex);
+      positionOffset);
 
   // east
   if (!isWestChild(childID)) {
@@ -1053,27 +1215,18 @@ static void addSkirts(
     currentSkirt.skirtEastHeight = shortestSkirtHeight * 0.5;
   }
 
-  sortEdgeIndices.resize(edgeIndices.east.size());
-  std::sort(
-      edgeIndices.east.begin(),
-      edgeIndices.east.end(),
-      [](const EdgeVertex& lhs, const EdgeVertex& rhs) {
-        return lhs.uv.y > rhs.uv.y;
-      });
-  std::transform(
-      edgeIndices.east.begin(),
-      edgeIndices.east.end(),
-      sortEdgeIndices.begin(),
-      [](const EdgeVertex& v) { return v.index; });
   addSkirt(
-      output,
-      indices,
-      attributes,
-      sortEdgeIndices,
+      child,
+      sortEdge(
+          edgeIndices.east,
+          scratch.sortedEdge,
+          [](const EdgeVertex& lhs, const EdgeVertex& rhs) {
+            return lhs.uv.y > rhs.uv.y;
+          }),
       center,
       currentSkirt.skirtEastHeight,
       vertexSizeFloats,
-      positionAttributeIndex);
+      positionOffset);
 
   // north
   if (!isSouthChild(childID)) {
@@ -1082,35 +1235,28 @@ static void addSkirts(
     currentSkirt.skirtNorthHeight = shortestSkirtHeight * 0.5;
   }
 
-  sortEdgeIndices.resize(edgeIndices.north.size());
-  std::sort(
-      edgeIndices.north.begin(),
-      edgeIndices.north.end(),
-      [](const EdgeVertex& lhs, const EdgeVertex& rhs) {
-        return lhs.uv.x < rhs.uv.x;
-      });
-  std::transform(
-      edgeIndices.north.begin(),
-      edgeIndices.north.end(),
-      sortEdgeIndices.begin(),
-      [](const EdgeVertex& v) { return v.index; });
   addSkirt(
-      output,
-      indices,
-      attributes,
-      sortEdgeIndices,
+      child,
+      sortEdge(
+          edgeIndices.north,
+          scratch.sortedEdge,
+          [](const EdgeVertex& lhs, const EdgeVertex& rhs) {
+            return lhs.uv.x < rhs.uv.x;
+          }),
       center,
       currentSkirt.skirtNorthHeight,
       vertexSizeFloats,
-      positionAttributeIndex);
+      positionOffset);
 }
 
 static void upsamplePrimitiveForRasterOverlays(
     const Model& parentModel,
-    Model& model,
-    Mesh& mesh,
-    MeshPrimitive& primitive,
-    CesiumGeometry::UpsampledQuadtreeNode childID) {
+    size_t meshIndex,
+    size_t primitiveIndex,
+    const std::array<UpsampledChild, QUADRANT_COUNT>& children,
+    UpsampleScratch& scratch) {
+  const MeshPrimitive& primitive =
+      parentModel.meshes[meshIndex].primitives[primitiveIndex];
   if (primitive.mode != MeshPrimitive::Mode::TRIANGLES ||
       primitive.indices < 0 ||
       primitive.indices >= static_cast<int>(parentModel.accessors.size())) {
@@ -1126,19 +1272,21 @@ static void upsamplePrimitiveForRasterOverlays(
       Accessor::ComponentType::UNSIGNED_SHORT) {
     upsamplePrimitiveForRasterOverlays<uint16_t>(
         parentModel,
-        model,
-        mesh,
         primitive,
-        childID);
+        meshIndex,
+        primitiveIndex,
+        children,
+        scratch);
   } else if (
       indicesAccessorGltf.componentType ==
       Accessor::ComponentType::UNSIGNED_INT) {
     upsamplePrimitiveForRasterOverlays<uint32_t>(
         parentModel,
-        model,
-        mesh,
         primitive,
-        childID);
+        meshIndex,
+        primitiveIndex,
+        children,
+        scratch);
   }
 }
 
@@ -3,10 +3,30 @@
 #include <CesiumGeometry/QuadtreeTileID.h>
 #include <CesiumGltf/Model.h>
 
+#include <array>
+
 namespace Cesium3DTilesSelection {
 
 CesiumGltf::Model upsampleGltfForRasterOverlays(
     const CesiumGltf::Model& parentModel,
     CesiumGeometry::UpsampledQuadtreeNode childID);
 
-}
+/**
+ * @brief Upsamples all four children of a tile in a single pass over the
+ * parent's triangles.
+ *
+ * This is equivalent to calling {@link upsampleGltfForRasterOverlays} once per
+ * child, but each parent triangle is only read and clipped against the
+ * East-West boundary once, and vertices on the clip boundaries are only
+ * interpolated once.
+ *
+ * @param parentModel The model to upsample.
+ * @param parentTileID The ID of the tile containing the parent model.
+ * @return The southwest, southeast, northwest, and northeast children, in that
+ * order.
+ */
+std::array<CesiumGltf::Model, 4> upsampleGltfForRasterOverlayChildren(
+    const CesiumGltf::Model& parentModel,
+    const CesiumGeometry::QuadtreeTileID& parentTileID);
+
+} // namespace Cesium3DTilesSelection
@@ -0,0 +1,180 @@
+#include "Cesium3DTilesSelection/registerAllTileContentTypes.h"
+#include "CompositeContent.h"
+#include "SimpleAssetAccessor.h"
+#include "SimpleAssetRequest.h"
+#include "SimpleAssetResponse.h"
+#include "SimpleTaskProcessor.h"
+#include "readFile.h"
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/HttpHeaders.h>
+
+#include <catch2/catch.hpp>
+#include <spdlog/spdlog.h>
+
+#include <cstring>
+#include <filesystem>
+#include <thread>
+
+using namespace CesiumGltf;
+using namespace Cesium3DTilesSelection;
+
+namespace {
+
+class ThreadTaskProcessor : public CesiumAsync::ITaskProcessor {
+public:
+  virtual void startTask(std::function<void()> f) override {
+    std::thread(std::move(f)).detach();
+  }
+};
+
+void writeUint32(std::vector<std::byte>& data, size_t offset, uint32_t value) {
+  std::memcpy(data.data() + offset, &value, sizeof(value));
+}
+
+std::vector<std::byte>
+createCmpt(const std::vector<std::vector<std::byte>>& innerTiles) {
+  std::vector<std::byte> result(16);
+  std::memcpy(result.data(), "cmpt", 4);
+  writeUint32(result, 4, 1);
+  writeUint32(result, 12, static_cast<uint32_t>(innerTiles.size()));
+
+  for (const std::vector<std::byte>& innerTile : innerTiles) {
+    result.insert(result.end(), innerTile.begin(), innerTile.end());
+  }
+
+  writeUint32(result, 8, static_cast<uint32_t>(result.size()));
+  return result;
+}
+
+std::unique_ptr<TileContentLoadResult> loadCmpt(
+    const std::shared_ptr<CesiumAsync::ITaskProcessor>& pTaskProcessor,
+    const std::vector<std::byte>& data) {
+  std::shared_ptr<SimpleAssetRequest> pRequest =
+      std::make_shared<SimpleAssetRequest>(
+          "GET",
+          "test.url",
+          CesiumAsync::HttpHeaders(),
+          std::make_unique<SimpleAssetResponse>(
+              static_cast<uint16_t>(200),
+              "",
+              CesiumAsync::HttpHeaders(),
+              data));
+
+  std::map<std::string, std::shared_ptr<SimpleAssetRequest>> mockedRequests = {
+      {"test.url", pRequest}};
+
+  TileContentLoadInput input;
+  input.asyncSystem = CesiumAsync::AsyncSystem(pTaskProcessor);
+  input.pLogger = spdlog::default_logger();
+  input.pAssetAccessor =
+      std::make_shared<SimpleAssetAccessor>(std::move(mockedRequests));
+  input.pRequest = std::move(pRequest);
+
+  return CompositeContent().load(input).wait();
+}
+
+std::vector<std::vector<std::byte>> readInnerTiles(size_t count) {
+  const std::filesystem::path dataDir =
+      std::filesystem::path(Cesium3DTilesSelection_TEST_DATA_DIR) /
+      "ReplaceTileset";
+  const std::vector<std::string> names =
+      {"parent.b3dm", "ll.b3dm", "lr.b3dm", "ul.b3dm", "ur.b3dm"};
+
+  std::vector<std::vector<std::byte>> result;
+  for (size_t i = 0; i < count; ++i) {
+    result.emplace_back(readFile(dataDir / names[i % names.size()]));
+  }
+  return result;
+}
+
+} // namespace
+
+TEST_CASE("CompositeContent merges the models of its inner tiles") {
+  registerAllTileContentTypes();
+
+  const std::vector<std::vector<std::byte>> innerTiles = readInnerTiles(3);
+
+  std::unique_ptr<TileContentLoadResult> pSingle = loadCmpt(
+      std::make_shared<SimpleTaskProcessor>(),
+      createCmpt({innerTiles[0]}));
+  REQUIRE(pSingle);
+  REQUIRE(pSingle->model);
+  const Model& single = *pSingle->model;
+
+  SECTION("with inline tasks") {
+    std::unique_ptr<TileContentLoadResult> pResult = loadCmpt(
+        std::make_shared<SimpleTaskProcessor>(),
+        createCmpt(innerTiles));
+    REQUIRE(pResult);
+    REQUIRE(pResult->model);
+
+    const Model& model = *pResult->model;
+    CHECK(model.meshes.size() == 3 * single.meshes.size());
+    CHECK(model.buffers.size() == 3 * single.buffers.size());
+    CHECK(model.nodes.size() == 3 * single.nodes.size());
+  }
+
+  SECTION("with concurrent tasks") {
+    std::unique_ptr<TileContentLoadResult> pResult = loadCmpt(
+        std::make_shared<ThreadTaskProcessor>(),
+        createCmpt(innerTiles));
+    REQUIRE(pResult);
+    REQUIRE(pResult->model);
+
+    const Model& model = *pResult->model;
+    REQUIRE(model.buffers.size() == 3 * single.buffers.size());
+    CHECK(model.meshes.size() == 3 * single.meshes.size());
+
+    // The inner tiles are merged in order.
+    for (size_t i = 0; i < single.buffers.size(); ++i) {
+      CHECK(
+          model.buffers[i].cesium.data == single.buffers[i].cesium.data);
+    }
+  }
+
+  SECTION("skips inner tiles that fail to load") {
+    std::vector<std::byte> invalid(16);
+    std::memcpy(invalid.data(), "xxxx", 4);
+    writeUint32(invalid, 8, static_cast<uint32_t>(invalid.size()));
+
+    std::unique_ptr<TileContentLoadResult> pResult = loadCmpt(
+        std::make_shared<SimpleTaskProcessor>(),
+        createCmpt({invalid, innerTiles[0], innerTiles[1]}));
+    REQUIRE(pResult);
+    REQUIRE(pResult->model);
+    CHECK(pResult->model->meshes.size() == 2 * single.meshes.size());
+  }
+}
+
+TEST_CASE("Model::merge moves the buffers of the merged model") {
+  Model model;
+  model.buffers.emplace_back().cesium.data.resize(8);
+
+  Model other;
+  other.buffers.emplace_back().cesium.data.resize(1024);
+  const std::byte* pData = other.buffers[0].cesium.data.data();
+
+  model.merge(std::move(other));
+
+  REQUIRE(model.buffers.size() == 2);
+  CHECK(model.buffers[1].cesium.data.data() == pData);
+}
+
+TEST_CASE("Benchmark composite tile loading", "[.][benchmark]") {
+  registerAllTileContentTypes();
+
+  const std::vector<std::byte> data = createCmpt(readInnerTiles(16));
+
+  const std::shared_ptr<CesiumAsync::ITaskProcessor> pInline =
+      std::make_shared<SimpleTaskProcessor>();
+  BENCHMARK("16 inner tiles, one at a time") {
+    return loadCmpt(pInline, data);
+  };
+
+  const std::shared_ptr<CesiumAsync::ITaskProcessor> pThreads =
+      std::make_shared<ThreadTaskProcessor>();
+  BENCHMARK("16 inner tiles, concurrently") {
+    return loadCmpt(pThreads, data);
+  };
+}
@@ -0,0 +1,223 @@
+#include "Cesium3DTilesSelection/FeatureIndex.h"
+
+#include <CesiumGeometry/Axis.h>
+#include <CesiumGeospatial/Cartographic.h>
+#include <CesiumGeospatial/Ellipsoid.h>
+#include <CesiumGltf/ExtensionMeshPrimitiveExtFeatureMetadata.h>
+#include <CesiumGltf/ExtensionModelExtFeatureMetadata.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumUtility/Math.h>
+
+#include <catch2/catch.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeospatial;
+using namespace CesiumGltf;
+using namespace CesiumUtility;
+
+template <typename T>
+static int32_t addBufferView(Model& model, const std::vector<T>& values) {
+  Buffer& buffer = model.buffers.emplace_back();
+  buffer.cesium.data.resize(values.size() * sizeof(T));
+  buffer.byteLength = static_cast<int64_t>(buffer.cesium.data.size());
+  std::memcpy(
+      buffer.cesium.data.data(),
+      values.data(),
+      buffer.cesium.data.size());
+
+  BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = static_cast<int32_t>(model.buffers.size() - 1);
+  bufferView.byteLength = buffer.byteLength;
+  return static_cast<int32_t>(model.bufferViews.size() - 1);
+}
+
+template <typename T>
+static int32_t addAccessor(
+    Model& model,
+    const std::vector<T>& values,
+    int32_t componentType,
+    const std::string& type) {
+  Accessor& accessor = model.accessors.emplace_back();
+  accessor.bufferView = addBufferView(model, values);
+  accessor.componentType = componentType;
+  accessor.type = type;
+  accessor.count = static_cast<int64_t>(values.size());
+  return static_cast<int32_t>(model.accessors.size() - 1);
+}
+
+static std::vector<std::string> getFeatureIds(
+    const std::function<void(const FeatureIndex::Callback&)>& query) {
+  std::vector<std::string> result;
+  query([&result](const std::string& featureTable, int64_t featureId) {
+    result.emplace_back(featureTable + ":" + std::to_string(featureId));
+  });
+  return result;
+}
+
+TEST_CASE("Test FeatureIndex") {
+  const Ellipsoid& ellipsoid = Ellipsoid::WGS84;
+  const glm::dvec3 center = ellipsoid.cartographicToCartesian(
+      Cartographic::fromDegrees(10.5, 20.5, 0.0));
+
+  // Feature 0 spans 10 to 10.2 degrees longitude, feature 1 spans 11 to 11.2
+  // degrees, and feature 2 is at 12 degrees. Feature 3 has no vertices.
+  const std::vector<Cartographic> cartographics = {
+      Cartographic::fromDegrees(10.0, 20.0, 5.0),
+      Cartographic::fromDegrees(10.2, 20.2, 15.0),
+      Cartographic::fromDegrees(11.0, 20.0, 0.0),
+      Cartographic::fromDegrees(11.2, 20.2, 0.0),
+      Cartographic::fromDegrees(12.0, 21.0, 0.0)};
+  std::vector<glm::vec3> positions;
+  for (const Cartographic& cartographic : cartographics) {
+    positions.emplace_back(
+        ellipsoid.cartographicToCartesian(cartographic) - center);
+  }
+  const std::vector<uint16_t> featureIds = {0, 0, 1, 1, 2};
+
+  Model model;
+  model.extras["gltfUpAxis"] = static_cast<int64_t>(CesiumGeometry::Axis::Z);
+
+  MeshPrimitive& primitive =
+      model.meshes.emplace_back().primitives.emplace_back();
+  primitive.attributes["POSITION"] = addAccessor(
+      model,
+      positions,
+      Accessor::ComponentType::FLOAT,
+      Accessor::Type::VEC3);
+  primitive.attributes["_FEATURE_ID_0"] = addAccessor(
+      model,
+      featureIds,
+      Accessor::ComponentType::UNSIGNED_SHORT,
+      Accessor::Type::SCALAR);
+
+  model.nodes.emplace_back().mesh = 0;
+  model.scenes.emplace_back().nodes.emplace_back(0);
+  model.scene = 0;
+
+  ExtensionMeshPrimitiveExtFeatureMetadata& primitiveMetadata =
+      primitive.addExtension<ExtensionMeshPrimitiveExtFeatureMetadata>();
+  FeatureIDAttribute& attribute =
+      primitiveMetadata.featureIdAttributes.emplace_back();
+  attribute.featureTable = "buildings";
+  attribute.featureIds.attribute = "_FEATURE_ID_0";
+
+  ExtensionModelExtFeatureMetadata& metadata =
+      model.addExtension<ExtensionModelExtFeatureMetadata>();
+  Class& buildingClass = metadata.schema.emplace().classes["building"];
+  buildingClass.properties["height"].type = ClassProperty::Type::FLOAT64;
+  buildingClass.properties["isTall"].type = ClassProperty::Type::BOOLEAN;
+  buildingClass.properties["name"].type = ClassProperty::Type::STRING;
+
+  FeatureTable& featureTable = metadata.featureTables["buildings"];
+  featureTable.classProperty = "building";
+  featureTable.count = 4;
+  featureTable.properties["height"].bufferView = addBufferView(
+      model,
+      std::vector<double>{
+          30.0,
+          10.0,
+          std::numeric_limits<double>::quiet_NaN(),
+          20.0});
+  featureTable.properties["isTall"].bufferView =
+      addBufferView(model, std::vector<uint8_t>{0b0101});
+
+  FeatureTableProperty& name = featureTable.properties["name"];
+  name.bufferView =
+      addBufferView(model, std::vector<char>{'b', 'a', 'b', 'c'});
+  name.stringOffsetBufferView =
+      addBufferView(model, std::vector<uint32_t>{0, 1, 2, 3, 4});
+
+  const FeatureIndex index = FeatureIndex::create(
+      model,
+      glm::translate(glm::dmat4(1.0), center),
+      {"height", "isTall", "name", "missing"});
+
+  SECTION("Bounding regions") {
+    std::optional<BoundingRegion> region =
+        index.getFeatureBoundingRegion("buildings", 0);
+    REQUIRE(region);
+    const GlobeRectangle& rectangle = region->getRectangle();
+    CHECK(Math::equalsEpsilon(
+        rectangle.getWest(),
+        Math::degreesToRadians(10.0),
+        Math::EPSILON6));
+    CHECK(Math::equalsEpsilon(
+        rectangle.getEast(),
+        Math::degreesToRadians(10.2),
+        Math::EPSILON6));
+    CHECK(Math::equalsEpsilon(
+        rectangle.getSouth(),
+        Math::degreesToRadians(20.0),
+        Math::EPSILON6));
+    CHECK(Math::equalsEpsilon(
+        rectangle.getNorth(),
+        Math::degreesToRadians(20.2),
+        Math::EPSILON6));
+    CHECK(Math::equalsEpsilon(region->getMinimumHeight(), 5.0, 0.01));
+    CHECK(Math::equalsEpsilon(region->getMaximumHeight(), 15.0, 0.01));
+
+    CHECK(!index.getFeatureBoundingRegion("buildings", 3));
+    CHECK(!index.getFeatureBoundingRegion("buildings", 4));
+    CHECK(!index.getFeatureBoundingRegion("buildings", -1));
+    CHECK(!index.getFeatureBoundingRegion("trees", 0));
+  }
+
+  SECTION("Find features in a rectangle") {
+    const GlobeRectangle rectangle =
+        GlobeRectangle::fromDegrees(10.1, 19.0, 11.1, 22.0);
+    CHECK(
+        getFeatureIds([&index, &rectangle](const FeatureIndex::Callback& f) {
+          index.findFeaturesInRectangle(rectangle, f);
+        }) == std::vector<std::string>{"buildings:0", "buildings:1"});
+  }
+
+  SECTION("Find features by numeric range") {
+    CHECK(
+        getFeatureIds([&index](const FeatureIndex::Callback& f) {
+          index.findFeaturesInRange("height", 10.0, 20.0, f);
+        }) == std::vector<std::string>{"buildings:1", "buildings:3"});
+    CHECK(
+        getFeatureIds([&index](const FeatureIndex::Callback& f) {
+          index.findFeaturesInRange(
+              "height",
+              std::numeric_limits<double>::lowest(),
+              std::numeric_limits<double>::max(),
+              f);
+        }) == std::vector<std::string>{
+                  "buildings:1",
+                  "buildings:3",
+                  "buildings:0"});
+    CHECK(getFeatureIds([&index](const FeatureIndex::Callback& f) {
+            index.findFeaturesInRange("missing", 0.0, 100.0, f);
+          }).empty());
+  }
+
+  SECTION("Find features by boolean value") {
+    CHECK(
+        getFeatureIds([&index](const FeatureIndex::Callback& f) {
+          index.findFeaturesWithBoolean("isTall", true, f);
+        }) == std::vector<std::string>{"buildings:0", "buildings:2"});
+    CHECK(
+        getFeatureIds([&index](const FeatureIndex::Callback& f) {
+          index.findFeaturesWithBoolean("isTall", false, f);
+        }) == std::vector<std::string>{"buildings:1", "buildings:3"});
+  }
+
+  SECTION("Find features by string value") {
+    CHECK(
+        getFeatureIds([&index](const FeatureIndex::Callback& f) {
+          index.findFeaturesWithString("name", "b", f);
+        }) == std::vector<std::string>{"buildings:0", "buildings:2"});
+    CHECK(getFeatureIds([&index](const FeatureIndex::Callback& f) {
+            index.findFeaturesWithString("name", "d", f);
+          }).empty());
+  }
+}
@@ -0,0 +1,442 @@
+#include "Cesium3DTilesSelection/TileContentFactory.h"
+#include "Cesium3DTilesSelection/registerAllTileContentTypes.h"
+#include "Instanced3DModelContent.h"
+#include "SimpleAssetAccessor.h"
+#include "SimpleAssetRequest.h"
+#include "SimpleAssetResponse.h"
+#include "SimpleTaskProcessor.h"
+#include "readFile.h"
+
+#include <CesiumAsync/AsyncSystem.h>
+#include <CesiumAsync/HttpHeaders.h>
+#include <CesiumAsync/Promise.h>
+#include <CesiumGltf/AccessorView.h>
+#include <CesiumGltf/ExtensionExtMeshGpuInstancing.h>
+
+#include <catch2/catch.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <spdlog/spdlog.h>
+
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <utility>
+
+using namespace CesiumGltf;
+using namespace Cesium3DTilesSelection;
+using namespace CesiumUtility;
+
+namespace {
+
+void writeUint32(std::vector<std::byte>& data, size_t offset, uint32_t value) {
+  std::memcpy(data.data() + offset, &value, sizeof(value));
+}
+
+template <typename T>
+void appendValues(std::vector<std::byte>& data, const std::vector<T>& values) {
+  const size_t offset = data.size();
+  data.resize(offset + values.size() * sizeof(T));
+  std::memcpy(data.data() + offset, values.data(), values.size() * sizeof(T));
+}
+
+std::vector<std::byte> readGlb() {
+  const std::vector<std::byte> b3dm = readFile(
+      std::filesystem::path(Cesium3DTilesSelection_TEST_DATA_DIR) /
+      "ReplaceTileset" / "parent.b3dm");
+
+  // Skip the B3DM header and its feature and batch tables.
+  uint32_t tableLengths[4];
+  std::memcpy(tableLengths, b3dm.data() + 12, sizeof(tableLengths));
+  const size_t glbStart = 28 + size_t(tableLengths[0]) + tableLengths[1] +
+                          tableLengths[2] + tableLengths[3];
+  return std::vector<std::byte>(b3dm.begin() + int64_t(glbStart), b3dm.end());
+}
+
+std::vector<std::byte> createI3dm(
+    const std::string& featureTableJson,
+    const std::vector<std::byte>& featureTableBinary,
+    uint32_t gltfFormat,
+    const std::vector<std::byte>& gltf) {
+  std::string json = featureTableJson;
+  json.resize((json.size() + 7) & ~size_t(7), ' ');
+
+  std::vector<std::byte> result(32);
+  std::memcpy(result.data(), "i3dm", 4);
+  writeUint32(result, 4, 1);
+  writeUint32(result, 12, static_cast<uint32_t>(json.size()));
+  writeUint32(result, 16, static_cast<uint32_t>(featureTableBinary.size()));
+  writeUint32(result, 28, gltfFormat);
+
+  const std::byte* pJson = reinterpret_cast<const std::byte*>(json.data());
+  result.insert(result.end(), pJson, pJson + json.size());
+  result.insert(
+      result.end(),
+      featureTableBinary.begin(),
+      featureTableBinary.end());
+  result.insert(result.end(), gltf.begin(), gltf.end());
+
+  writeUint32(result, 8, static_cast<uint32_t>(result.size()));
+  return result;
+}
+
+std::shared_ptr<SimpleAssetRequest>
+createRequest(const std::string& url, const std::vector<std::byte>& data) {
+  return std::make_shared<SimpleAssetRequest>(
+      "GET",
+      url,
+      CesiumAsync::HttpHeaders(),
+      std::make_unique<SimpleAssetResponse>(
+          static_cast<uint16_t>(200),
+          "",
+          CesiumAsync::HttpHeaders(),
+          data));
+}
+
+// Counts requests and keeps them pending until they are completed, so that
+// several tiles can be loading at once.
+class DeferredAssetAccessor : public SimpleAssetAccessor {
+public:
+  DeferredAssetAccessor(
+      std::map<std::string, std::shared_ptr<SimpleAssetRequest>>&&
+          mockCompletedRequests)
+      : SimpleAssetAccessor(std::move(mockCompletedRequests)) {}
+
+  virtual CesiumAsync::Future<std::shared_ptr<CesiumAsync::IAssetRequest>>
+  requestAsset(
+      const CesiumAsync::AsyncSystem& asyncSystem,
+      const std::string& url,
+      const std::vector<THeader>&) override {
+    ++this->requestCount;
+    CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>> promise =
+        asyncSystem
+            .createPromise<std::shared_ptr<CesiumAsync::IAssetRequest>>();
+    this->pendingRequests.emplace_back(url, promise);
+    return promise.getFuture();
+  }
+
+  void completeRequests() {
+    for (auto& [url, promise] : this->takePendingRequests()) {
+      auto mockRequestIt = this->mockCompletedRequests.find(url);
+      promise.resolve(
+          mockRequestIt == this->mockCompletedRequests.end()
+              ? nullptr
+              : mockRequestIt->second);
+    }
+  }
+
+  void rejectRequests() {
+    for (auto& [url, promise] : this->takePendingRequests()) {
+      promise.reject(std::runtime_error("Request failed: " + url));
+    }
+  }
+
+  size_t requestCount = 0;
+
+private:
+  using PendingRequest = std::pair<
+      std::string,
+      CesiumAsync::Promise<std::shared_ptr<CesiumAsync::IAssetRequest>>>;
+
+  std::vector<PendingRequest> takePendingRequests() {
+    std::vector<PendingRequest> result;
+    result.swap(this->pendingRequests);
+    return result;
+  }
+
+  std::vector<PendingRequest> pendingRequests;
+};
+
+CesiumAsync::Future<std::unique_ptr<TileContentLoadResult>> startLoadI3dm(
+    Instanced3DModelContent& loader,
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    const std::string& url,
+    const std::vector<std::byte>& data) {
+  TileContentLoadInput input;
+  input.asyncSystem =
+      CesiumAsync::AsyncSystem(std::make_shared<SimpleTaskProcessor>());
+  input.pLogger = spdlog::default_logger();
+  input.pAssetAccessor = pAssetAccessor;
+  input.pRequest = createRequest(url, data);
+
+  return loader.load(input);
+}
+
+std::unique_ptr<TileContentLoadResult> loadI3dm(
+    Instanced3DModelContent& loader,
+    const std::shared_ptr<CesiumAsync::IAssetAccessor>& pAssetAccessor,
+    const std::string& url,
+    const std::vector<std::byte>& data) {
+  return startLoadI3dm(loader, pAssetAccessor, url, data).wait();
+}
+
+std::unique_ptr<TileContentLoadResult> loadI3dm(
+    const std::string& featureTableJson,
+    const std::vector<std::byte>& featureTableBinary) {
+  Instanced3DModelContent loader;
+  return loadI3dm(
+      loader,
+      std::make_shared<SimpleAssetAccessor>(
+          std::map<std::string, std::shared_ptr<SimpleAssetRequest>>()),
+      "test.i3dm",
+      createI3dm(featureTableJson, featureTableBinary, 1, readGlb()));
+}
+
+const ExtensionExtMeshGpuInstancing& getInstancing(const Model& model) {
+  REQUIRE(model.nodes.size() == 1);
+  const ExtensionExtMeshGpuInstancing* pInstancing =
+      model.nodes[0].getExtension<ExtensionExtMeshGpuInstancing>();
+  REQUIRE(pInstancing);
+  return *pInstancing;
+}
+
+} // namespace
+
+TEST_CASE("Instanced3DModelContent adds EXT_mesh_gpu_instancing") {
+  SECTION("with positions, scales, and batch IDs") {
+    std::vector<std::byte> binary;
+    appendValues<float>(binary, {1.0f, 2.0f, 3.0f, -4.0f, -5.0f, -6.0f});
+    appendValues<float>(binary, {2.0f, 0.5f});
+    appendValues<uint16_t>(binary, {7, 3});
+
+    std::unique_ptr<TileContentLoadResult> pResult = loadI3dm(
+        "{\"INSTANCES_LENGTH\":2,\"RTC_CENTER\":[10,20,30],"
+        "\"POSITION\":{\"byteOffset\":0},\"SCALE\":{\"byteOffset\":24},"
+        "\"BATCH_ID\":{\"byteOffset\":32}}",
+        binary);
+    REQUIRE(pResult);
+    REQUIRE(pResult->model);
+    const Model& model = *pResult->model;
+
+    const JsonValue::Array& rtcCenter =
+        model.extras.at("RTC_CENTER").getArray();
+    REQUIRE(rtcCenter.size() == 3);
+    CHECK(rtcCenter[0].getSafeNumberOrDefault<double>(0.0) == 10.0);
+    CHECK(rtcCenter[1].getSafeNumberOrDefault<double>(0.0) == 20.0);
+    CHECK(rtcCenter[2].getSafeNumberOrDefault<double>(0.0) == 30.0);
+
+    const ExtensionExtMeshGpuInstancing& instancing = getInstancing(model);
+    CHECK(
+        instancing.attributes.find("ROTATION") ==
+        instancing.attributes.end());
+
+    // The node's Z-up to Y-up matrix cancels the glTF up-axis transform, so the
+    // instances are stored as they are in the feature table.
+    AccessorView<glm::vec3> translations(
+        model,
+        instancing.attributes.at("TRANSLATION"));
+    REQUIRE(translations.size() == 2);
+    CHECK(translations[0] == glm::vec3(1.0f, 2.0f, 3.0f));
+    CHECK(translations[1] == glm::vec3(-4.0f, -5.0f, -6.0f));
+
+    AccessorView<glm::vec3> scales(model, instancing.attributes.at("SCALE"));
+    REQUIRE(scales.size() == 2);
+    CHECK(scales[0] == glm::vec3(2.0f));
+    CHECK(scales[1] == glm::vec3(0.5f));
+
+    AccessorView<uint16_t> featureIds(
+        model,
+        instancing.attributes.at("_FEATURE_ID_0"));
+    REQUIRE(featureIds.size() == 2);
+    CHECK(featureIds[0] == 7);
+    CHECK(featureIds[1] == 3);
+
+    CHECK(
+        std::find(
+            model.extensionsRequired.begin(),
+            model.extensionsRequired.end(),
+            ExtensionExtMeshGpuInstancing::ExtensionName) !=
+        model.extensionsRequired.end());
+  }
+
+  SECTION("with quantized positions and no RTC_CENTER") {
+    std::vector<std::byte> binary;
+    appendValues<uint16_t>(binary, {0, 0, 0, 65535, 65535, 65535});
+
+    std::unique_ptr<TileContentLoadResult> pResult = loadI3dm(
+        "{\"INSTANCES_LENGTH\":2,\"POSITION_QUANTIZED\":{\"byteOffset\":0},"
+        "\"QUANTIZED_VOLUME_OFFSET\":[100,200,300],"
+        "\"QUANTIZED_VOLUME_SCALE\":[10,20,30]}",
+        binary);
+    REQUIRE(pResult);
+    REQUIRE(pResult->model);
+    const Model& model = *pResult->model;
+
+    // The translations are relative to the center of the instances.
+    const JsonValue::Array& rtcCenter =
+        model.extras.at("RTC_CENTER").getArray();
+    REQUIRE(rtcCenter.size() == 3);
+    CHECK(rtcCenter[0].getSafeNumberOrDefault<double>(0.0) == 105.0);
+    CHECK(rtcCenter[1].getSafeNumberOrDefault<double>(0.0) == 210.0);
+    CHECK(rtcCenter[2].getSafeNumberOrDefault<double>(0.0) == 315.0);
+
+    const ExtensionExtMeshGpuInstancing& instancing = getInstancing(model);
+    AccessorView<glm::vec3> translations(
+        model,
+        instancing.attributes.at("TRANSLATION"));
+    REQUIRE(translations.size() == 2);
+    CHECK(translations[0] == glm::vec3(-5.0f, -10.0f, -15.0f));
+    CHECK(translations[1] == glm::vec3(5.0f, 10.0f, 15.0f));
+  }
+
+  SECTION("with oct-encoded normals") {
+    std::vector<std::byte> binary;
+    appendValues<float>(binary, {0.0f, 0.0f, 0.0f});
+    appendValues<float>(binary, {0.0f, 0.0f, 1.0f});
+    // (1, 0, 0) oct-encoded.
+    appendValues<uint16_t>(binary, {65535, 32768});
+
+    std::unique_ptr<TileContentLoadResult> pResult = loadI3dm(
+        "{\"INSTANCES_LENGTH\":1,\"POSITION\":{\"byteOffset\":0},"
+        "\"NORMAL_UP\":{\"byteOffset\":12},"
+        "\"NORMAL_RIGHT_OCT32P\":{\"byteOffset\":24}}",
+        binary);
+    REQUIRE(pResult);
+    REQUIRE(pResult->model);
+    const Model& model = *pResult->model;
+
+    // Right is x and up is z, which is a quarter turn around x.
+    const ExtensionExtMeshGpuInstancing& instancing = getInstancing(model);
+    AccessorView<glm::vec4> rotations(
+        model,
+        instancing.attributes.at("ROTATION"));
+    REQUIRE(rotations.size() == 1);
+    CHECK(rotations[0].x == Approx(std::sqrt(0.5)).margin(1e-4));
+    CHECK(rotations[0].y == Approx(0.0).margin(1e-4));
+    CHECK(rotations[0].z == Approx(0.0).margin(1e-4));
+    CHECK(rotations[0].w == Approx(std::sqrt(0.5)).margin(1e-4));
+  }
+
+  SECTION("ignores an I3DM without instances") {
+    std::unique_ptr<TileContentLoadResult> pResult =
+        loadI3dm("{\"INSTANCES_LENGTH\":0}", {});
+    CHECK(!pResult);
+  }
+}
+
+TEST_CASE("Instanced3DModelContent shares a glTF request between loading "
+          "tiles") {
+  const std::string gltfUrl = "https://example.com/models/instance.glb";
+  const std::map<std::string, std::shared_ptr<SimpleAssetRequest>>
+      mockedRequests = {{gltfUrl, createRequest(gltfUrl, readGlb())}};
+  std::shared_ptr<DeferredAssetAccessor> pAssetAccessor =
+      std::make_shared<DeferredAssetAccessor>(
+          std::map<std::string, std::shared_ptr<SimpleAssetRequest>>(
+              mockedRequests));
+
+  std::vector<std::byte> binary;
+  appendValues<float>(binary, {1.0f, 2.0f, 3.0f});
+  std::string uri = "../models/instance.glb";
+  uri.resize(32, ' ');
+  const std::vector<std::byte> i3dm = createI3dm(
+      "{\"INSTANCES_LENGTH\":1,\"POSITION\":{\"byteOffset\":0}}",
+      binary,
+      0,
+      std::vector<std::byte>(
+          reinterpret_cast<const std::byte*>(uri.data()),
+          reinterpret_cast<const std::byte*>(uri.data() + uri.size())));
+
+  Instanced3DModelContent loader;
+  const std::vector<std::string> urls = {
+      "https://example.com/tiles/a.i3dm",
+      "https://example.com/tiles/b.i3dm"};
+  std::vector<CesiumAsync::Future<std::unique_ptr<TileContentLoadResult>>>
+      futures;
+  for (const std::string& url : urls) {
+    futures.emplace_back(startLoadI3dm(loader, pAssetAccessor, url, i3dm));
+  }
+
+  CHECK(pAssetAccessor->requestCount == 1);
+
+  SECTION("and gives every tile the glTF") {
+    pAssetAccessor->completeRequests();
+    for (auto& future : futures) {
+      std::unique_ptr<TileContentLoadResult> pResult = future.wait();
+      REQUIRE(pResult);
+      REQUIRE(pResult->model);
+      CHECK(pResult->model->nodes[0]
+                .getExtension<ExtensionExtMeshGpuInstancing>());
+    }
+  }
+
+  SECTION("but not with another asset accessor") {
+    std::shared_ptr<DeferredAssetAccessor> pOtherAssetAccessor =
+        std::make_shared<DeferredAssetAccessor>(
+            std::map<std::string, std::shared_ptr<SimpleAssetRequest>>(
+                mockedRequests));
+    futures.emplace_back(
+        startLoadI3dm(loader, pOtherAssetAccessor, urls[0], i3dm));
+    CHECK(pOtherAssetAccessor->requestCount == 1);
+    CHECK(pAssetAccessor->requestCount == 1);
+
+    pAssetAccessor->completeRequests();
+    pOtherAssetAccessor->completeRequests();
+    for (auto& future : futures) {
+      CHECK(future.wait());
+    }
+  }
+
+  SECTION("and forgets the request once the tiles have loaded") {
+    pAssetAccessor->completeRequests();
+    for (auto& future : futures) {
+      CHECK(future.wait());
+    }
+
+    CesiumAsync::Future<std::unique_ptr<TileContentLoadResult>> future =
+        startLoadI3dm(loader, pAssetAccessor, urls[0], i3dm);
+    CHECK(pAssetAccessor->requestCount == 2);
+    pAssetAccessor->completeRequests();
+    CHECK(future.wait());
+  }
+
+  SECTION("and requests it again when it fails") {
+    pAssetAccessor->rejectRequests();
+    for (auto& future : futures) {
+      CHECK(!future.wait());
+    }
+
+    CesiumAsync::Future<std::unique_ptr<TileContentLoadResult>> future =
+        startLoadI3dm(loader, pAssetAccessor, urls[0], i3dm);
+    CHECK(pAssetAccessor->requestCount == 2);
+    pAssetAccessor->completeRequests();
+    CHECK(future.wait());
+  }
+}
+
+TEST_CASE("Instanced3DModelContent rejects an INSTANCES_LENGTH that its "
+          "feature table cannot hold") {
+  std::vector<std::byte> binary;
+  appendValues<float>(binary, {1.0f, 2.0f, 3.0f});
+  CHECK(!loadI3dm(
+      "{\"INSTANCES_LENGTH\":4000000000,\"POSITION\":{\"byteOffset\":0}}",
+      binary));
+}
+
+TEST_CASE("Instanced3DModelContent is registered for the i3dm magic") {
+  registerAllTileContentTypes();
+
+  std::vector<std::byte> binary;
+  appendValues<float>(binary, {1.0f, 2.0f, 3.0f});
+  std::shared_ptr<SimpleAssetRequest> pRequest = createRequest(
+      "test.i3dm",
+      createI3dm(
+          "{\"INSTANCES_LENGTH\":1,\"POSITION\":{\"byteOffset\":0}}",
+          binary,
+          1,
+          readGlb()));
+
+  TileContentLoadInput input;
+  input.asyncSystem =
+      CesiumAsync::AsyncSystem(std::make_shared<SimpleTaskProcessor>());
+  input.pLogger = spdlog::default_logger();
+  input.pAssetAccessor = std::make_shared<SimpleAssetAccessor>(
+      std::map<std::string, std::shared_ptr<SimpleAssetRequest>>());
+  input.pRequest = pRequest;
+
+  std::unique_ptr<TileContentLoadResult> pResult =
+      TileContentFactory::createContent(input).wait();
+  REQUIRE(pResult);
+  REQUIRE(pResult->model);
+  CHECK(pResult->model->nodes[0].getExtension<ExtensionExtMeshGpuInstancing>());
+}
@@ -0,0 +1,309 @@
+#include "PointCloudContent.h"
+
+#include <CesiumGltf/AccessorView.h>
+#include <CesiumGltf/ExtensionMeshPrimitiveExtFeatureMetadata.h>
+#include <CesiumGltf/ExtensionModelExtFeatureMetadata.h>
+
+#include <catch2/catch.hpp>
+#include <glm/vec3.hpp>
+#include <spdlog/spdlog.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace CesiumGltf;
+using namespace Cesium3DTilesSelection;
+
+namespace {
+
+void writeUint32(std::vector<std::byte>& data, size_t offset, uint32_t value) {
+  std::memcpy(data.data() + offset, &value, sizeof(value));
+}
+
+template <typename T>
+void appendValues(std::vector<std::byte>& data, const std::vector<T>& values) {
+  const size_t offset = data.size();
+  data.resize(offset + values.size() * sizeof(T));
+  std::memcpy(data.data() + offset, values.data(), values.size() * sizeof(T));
+}
+
+void appendJson(std::vector<std::byte>& data, const std::string& json) {
+  std::string padded = json;
+  padded.resize((padded.size() + 7) & ~size_t(7), ' ');
+  const std::byte* pJson = reinterpret_cast<const std::byte*>(padded.data());
+  data.insert(data.end(), pJson, pJson + padded.size());
+}
+
+std::vector<std::byte> createPnts(
+    const std::string& featureTableJson,
+    const std::vector<std::byte>& featureTableBinary,
+    const std::string& batchTableJson = "") {
+  std::vector<std::byte> result(28);
+  std::memcpy(result.data(), "pnts", 4);
+  writeUint32(result, 4, 1);
+
+  appendJson(result, featureTableJson);
+  writeUint32(result, 12, static_cast<uint32_t>(result.size() - 28));
+  result.insert(
+      result.end(),
+      featureTableBinary.begin(),
+      featureTableBinary.end());
+  writeUint32(result, 16, static_cast<uint32_t>(featureTableBinary.size()));
+
+  if (!batchTableJson.empty()) {
+    const size_t batchTableStart = result.size();
+    appendJson(result, batchTableJson);
+    writeUint32(
+        result,
+        20,
+        static_cast<uint32_t>(result.size() - batchTableStart));
+  }
+
+  writeUint32(result, 8, static_cast<uint32_t>(result.size()));
+  return result;
+}
+
+std::unique_ptr<TileContentLoadResult> loadPnts(
+    const std::string& featureTableJson,
+    const std::vector<std::byte>& featureTableBinary,
+    const std::string& batchTableJson = "") {
+  return PointCloudContent::load(
+      spdlog::default_logger(),
+      "test.pnts",
+      createPnts(featureTableJson, featureTableBinary, batchTableJson));
+}
+
+using Color = AccessorTypes::VEC3<uint8_t>;
+
+std::vector<uint8_t> toVector(const Color& color) {
+  return std::vector<uint8_t>(color.value, color.value + 3);
+}
+
+const MeshPrimitive& getPrimitive(const Model& model) {
+  REQUIRE(model.meshes.size() == 1);
+  REQUIRE(model.meshes[0].primitives.size() == 1);
+  return model.meshes[0].primitives[0];
+}
+
+} // namespace
+
+TEST_CASE("PointCloudContent creates a glTF point primitive") {
+  SECTION("with positions and RGB colors") {
+    std::vector<std::byte> binary;
+    appendValues<float>(binary, {1.0f, 2.0f, 3.0f, -1.0f, -2.0f, -3.0f});
+    appendValues<uint8_t>(binary, {255, 0, 0, 0, 128, 255});
+
+    std::unique_ptr<TileContentLoadResult> pResult = loadPnts(
+        "{\"POINTS_LENGTH\":2,\"RTC_CENTER\":[10,20,30],"
+        "\"POSITION\":{\"byteOffset\":0},\"RGB\":{\"byteOffset\":24}}",
+        binary);
+    REQUIRE(pResult);
+    REQUIRE(pResult->model);
+    const Model& model = *pResult->model;
+    const MeshPrimitive& primitive = getPrimitive(model);
+    CHECK(primitive.mode == MeshPrimitive::Mode::POINTS);
+
+    // The RTC_CENTER is in the node's Z-up to Y-up matrix.
+    REQUIRE(model.nodes.size() == 1);
+    const std::vector<double>& matrix = model.nodes[0].matrix;
+    CHECK(matrix[12] == 10.0);
+    CHECK(matrix[13] == 30.0);
+    CHECK(matrix[14] == -20.0);
+
+    AccessorView<glm::vec3> positions(
+        model,
+        primitive.attributes.at("POSITION"));
+    REQUIRE(positions.size() == 2);
+    CHECK(positions[0] == glm::vec3(1.0f, 2.0f, 3.0f));
+    CHECK(positions[1] == glm::vec3(-1.0f, -2.0f, -3.0f));
+
+    const Accessor& positionAccessor =
+        model.accessors[size_t(primitive.attributes.at("POSITION"))];
+    CHECK(positionAccessor.min == std::vector<double>{-1.0, -2.0, -3.0});
+    CHECK(positionAccessor.max == std::vector<double>{1.0, 2.0, 3.0});
+
+    // The colors stay normalized bytes.
+    const int32_t colorAccessorId = primitive.attributes.at("COLOR_0");
+    const Accessor& colorAccessor = model.accessors[size_t(colorAccessorId)];
+    CHECK(
+        colorAccessor.componentType == Accessor::ComponentType::UNSIGNED_BYTE);
+    CHECK(colorAccessor.type == Accessor::Type::VEC3);
+    CHECK(colorAccessor.normalized);
+    AccessorView<Color> colors(model, colorAccessorId);
+    REQUIRE(colors.size() == 2);
+    CHECK(toVector(colors[0]) == std::vector<uint8_t>{255, 0, 0});
+    CHECK(toVector(colors[1]) == std::vector<uint8_t>{0, 128, 255});
+  }
+
+  SECTION("with quantized positions, RGB565 colors, and oct-encoded normals") {
+    std::vector<std::byte> binary;
+    appendValues<uint16_t>(binary, {0, 0, 0, 65535, 65535, 65535});
+    appendValues<uint16_t>(binary, {0xf800, 0x07ff});
+    // (0, 0, 1) and (1, 0, 0) oct-encoded.
+    appendValues<uint8_t>(binary, {128, 128, 255, 128});
+
+    std::unique_ptr<TileContentLoadResult> pResult = loadPnts(
+        "{\"POINTS_LENGTH\":2,\"POSITION_QUANTIZED\":{\"byteOffset\":0},"
+        "\"QUANTIZED_VOLUME_OFFSET\":[100,200,300],"
+        "\"QUANTIZED_VOLUME_SCALE\":[10,20,30],"
+        "\"RGB565\":{\"byteOffset\":12},\"NORMAL_OCT16P\":{\"byteOffset\":16},"
+        "\"CONSTANT_RGBA\":[255,255,255,128]}",
+        binary);
+    REQUIRE(pResult);
+    REQUIRE(pResult->model);
+    const Model& model = *pResult->model;
+    const MeshPrimitive& primitive = getPrimitive(model);
+
+    // The positions are relative to the middle of the quantized volume.
+    const std::vector<double>& matrix = model.nodes[0].matrix;
+    CHECK(matrix[12] == 105.0);
+    CHECK(matrix[13] == 315.0);
+    CHECK(matrix[14] == -210.0);
+
+    AccessorView<glm::vec3> positions(
+        model,
+        primitive.attributes.at("POSITION"));
+    REQUIRE(positions.size() == 2);
+    CHECK(positions[0].x == Approx(-5.0f));
+    CHECK(positions[0].y == Approx(-10.0f));
+    CHECK(positions[0].z == Approx(-15.0f));
+    CHECK(positions[1].x == Approx(5.0f));
+    CHECK(positions[1].y == Approx(10.0f));
+    CHECK(positions[1].z == Approx(15.0f));
+
+    AccessorView<Color> colors(model, primitive.attributes.at("COLOR_0"));
+    REQUIRE(colors.size() == 2);
+    CHECK(toVector(colors[0]) == std::vector<uint8_t>{255, 0, 0});
+    CHECK(toVector(colors[1]) == std::vector<uint8_t>{0, 255, 255});
+
+    AccessorView<glm::vec3> normals(model, primitive.attributes.at("NORMAL"));
+    REQUIRE(normals.size() == 2);
+    CHECK(normals[0].z == Approx(1.0f).margin(0.01f));
+    CHECK(normals[1].x == Approx(1.0f).margin(0.01f));
+
+    REQUIRE(model.materials.size() == 1);
+    const Material& material = model.materials[0];
+    CHECK(material.alphaMode == Material::AlphaMode::BLEND);
+    REQUIRE(material.pbrMetallicRoughness);
+    CHECK(
+        material.pbrMetallicRoughness->baseColorFactor[3] ==
+        Approx(128.0 / 255.0));
+  }
+
+  SECTION("with batch IDs and a batch table") {
+    std::vector<std::byte> binary;
+    appendValues<float>(binary, {0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f});
+    appendValues<uint8_t>(binary, {1, 0});
+
+    std::unique_ptr<TileContentLoadResult> pResult = loadPnts(
+        "{\"POINTS_LENGTH\":2,\"BATCH_LENGTH\":2,"
+        "\"POSITION\":{\"byteOffset\":0},"
+        "\"BATCH_ID\":{\"byteOffset\":24,\"componentType\":\"UNSIGNED_BYTE\"}}",
+        binary,
+        "{\"name\":[\"a\",\"b\"]}");
+    REQUIRE(pResult);
+    REQUIRE(pResult->model);
+    const Model& model = *pResult->model;
+    const MeshPrimitive& primitive = getPrimitive(model);
+
+    CHECK(model.getExtension<ExtensionModelExtFeatureMetadata>());
+    CHECK(primitive.attributes.find("_BATCHID") == primitive.attributes.end());
+    AccessorView<uint8_t> featureIds(
+        model,
+        primitive.attributes.at("_FEATURE_ID_0"));
+    REQUIRE(featureIds.size() == 2);
+    CHECK(featureIds[0] == 1);
+    CHECK(featureIds[1] == 0);
+  }
+
+  SECTION("with a batch table for each point") {
+    std::vector<std::byte> binary;
+    appendValues<float>(binary, {0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f});
+
+    std::unique_ptr<TileContentLoadResult> pResult = loadPnts(
+        "{\"POINTS_LENGTH\":2,\"POSITION\":{\"byteOffset\":0}}",
+        binary,
+        "{\"intensity\":[3,4]}");
+    REQUIRE(pResult);
+    REQUIRE(pResult->model);
+    const Model& model = *pResult->model;
+    const MeshPrimitive& primitive = getPrimitive(model);
+
+    const ExtensionModelExtFeatureMetadata* pMetadata =
+        model.getExtension<ExtensionModelExtFeatureMetadata>();
+    REQUIRE(pMetadata);
+    CHECK(pMetadata->featureTables.at("default").count == 2);
+
+    const ExtensionMeshPrimitiveExtFeatureMetadata* pPrimitiveMetadata =
+        primitive.getExtension<ExtensionMeshPrimitiveExtFeatureMetadata>();
+    REQUIRE(pPrimitiveMetadata);
+    REQUIRE(pPrimitiveMetadata->featureIdAttributes.size() == 1);
+    const FeatureIDs& featureIds =
+        pPrimitiveMetadata->featureIdAttributes[0].featureIds;
+    CHECK(!featureIds.attribute);
+    CHECK(featureIds.constant == 0);
+    CHECK(featureIds.divisor == 1);
+  }
+
+  SECTION("ignores a CONSTANT_RGBA that is not four numbers") {
+    std::vector<std::byte> binary;
+    appendValues<float>(binary, {1.0f, 2.0f, 3.0f});
+
+    const std::vector<std::string> invalidValues =
+        {"[255,0,0]", "[\"red\",0,0,128]", "{\"r\":255}", "128"};
+    for (const std::string& constantRgba : invalidValues) {
+      std::unique_ptr<TileContentLoadResult> pResult = loadPnts(
+          "{\"POINTS_LENGTH\":1,\"POSITION\":{\"byteOffset\":0},"
+          "\"CONSTANT_RGBA\":" +
+              constantRgba + "}",
+          binary);
+      REQUIRE(pResult);
+      REQUIRE(pResult->model);
+      REQUIRE(pResult->model->materials.size() == 1);
+      const Material& material = pResult->model->materials[0];
+      CHECK(material.alphaMode == Material::AlphaMode::OPAQUE);
+      REQUIRE(material.pbrMetallicRoughness);
+      CHECK(
+          material.pbrMetallicRoughness->baseColorFactor ==
+          std::vector<double>{1.0, 1.0, 1.0, 1.0});
+    }
+  }
+
+  SECTION("ignores a PNTS without positions") {
+    CHECK(!loadPnts("{\"POINTS_LENGTH\":2}", {}));
+  }
+}
+
+TEST_CASE("Benchmark point cloud decoding", "[.][benchmark]") {
+  constexpr size_t count = 1000000;
+
+  std::vector<uint16_t> positions(count * 3);
+  std::vector<uint16_t> colors(count);
+  std::vector<uint8_t> normals(count * 2);
+  for (size_t i = 0; i < count; ++i) {
+    positions[3 * i] = static_cast<uint16_t>(i);
+    positions[3 * i + 1] = static_cast<uint16_t>(i * 7);
+    positions[3 * i + 2] = static_cast<uint16_t>(i * 13);
+    colors[i] = static_cast<uint16_t>(i * 31);
+    normals[2 * i] = static_cast<uint8_t>(i);
+    normals[2 * i + 1] = static_cast<uint8_t>(i * 3);
+  }
+
+  std::vector<std::byte> binary;
+  appendValues(binary, positions);
+  appendValues(binary, colors);
+  appendValues(binary, normals);
+
+  const std::vector<std::byte> data = createPnts(
+      "{\"POINTS_LENGTH\":1000000,\"POSITION_QUANTIZED\":{\"byteOffset\":0},"
+      "\"QUANTIZED_VOLUME_OFFSET\":[0,0,0],"
+      "\"QUANTIZED_VOLUME_SCALE\":[100,100,100],"
+      "\"RGB565\":{\"byteOffset\":6000000},"
+      "\"NORMAL_OCT16P\":{\"byteOffset\":8000000}}",
+      binary);
+
+  BENCHMARK("1M quantized points with RGB565 colors and oct normals") {
+    return PointCloudContent::load(spdlog::default_logger(), "test.pnts", data);
+  };
+}
@@ -0,0 +1,155 @@
+#include "Cesium3DTilesSelection/RasterizedPolygonsOverlay.h"
+#include "SimpleAssetAccessor.h"
+
+#include <CesiumGeospatial/GeographicProjection.h>
+#include <CesiumUtility/Math.h>
+
+#include <catch2/catch.hpp>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumAsync;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumGltf;
+using namespace CesiumUtility;
+
+namespace {
+
+class MockTaskProcessor : public ITaskProcessor {
+public:
+  virtual void startTask(std::function<void()> f) { std::thread(f).detach(); }
+};
+
+const ImageCesium& loadImage(
+    const AsyncSystem& asyncSystem,
+    RasterOverlayTileProvider& provider,
+    IntrusivePointer<RasterOverlayTile>& pTile,
+    const GlobeRectangle& rectangle,
+    const glm::dvec2& targetScreenPixels) {
+  pTile = provider.getTile(
+      projectRectangleSimple(provider.getProjection(), rectangle),
+      targetScreenPixels);
+  REQUIRE(pTile);
+  provider.loadTile(*pTile);
+
+  while (pTile->getState() != RasterOverlayTile::LoadState::Loaded) {
+    asyncSystem.dispatchMainThreadTasks();
+  }
+
+  return pTile->getImage();
+}
+
+} // namespace
+
+TEST_CASE("RasterizedPolygonsOverlay rasterizes polygons") {
+  auto pTaskProcessor = std::make_shared<MockTaskProcessor>();
+  auto pAssetAccessor = std::make_shared<SimpleAssetAccessor>(
+      std::map<std::string, std::shared_ptr<SimpleAssetRequest>>());
+
+  AsyncSystem asyncSystem(pTaskProcessor);
+
+  std::vector<CartographicPolygon> polygons;
+
+  // A rectangle whose east edge falls half way through the fifth column of
+  // an 8x8 image of the tile from (0, 0) to (1, 1).
+  polygons.emplace_back(std::vector<glm::dvec2>{
+      glm::dvec2(0.0, 0.0),
+      glm::dvec2(0.5625, 0.0),
+      glm::dvec2(0.5625, 1.0),
+      glm::dvec2(0.0, 1.0)});
+
+  // A rectangle crossing the antimeridian.
+  polygons.emplace_back(std::vector<glm::dvec2>{
+      glm::dvec2(3.0, 0.0),
+      glm::dvec2(-3.0, 0.0),
+      glm::dvec2(-3.0, 1.0),
+      glm::dvec2(3.0, 1.0)});
+
+  RasterizedPolygonsOverlay overlay(
+      "Test",
+      polygons,
+      Ellipsoid::WGS84,
+      GeographicProjection());
+
+  overlay.loadTileProvider(
+      asyncSystem,
+      pAssetAccessor,
+      nullptr,
+      nullptr,
+      spdlog::default_logger());
+
+  asyncSystem.dispatchMainThreadTasks();
+
+  RasterOverlayTileProvider* pProvider = overlay.getTileProvider();
+  REQUIRE(pProvider);
+  REQUIRE(!pProvider->isPlaceholder());
+
+  IntrusivePointer<RasterOverlayTile> pTile;
+
+  SECTION("computes the coverage of partially covered pixels") {
+    const ImageCesium& image = loadImage(
+        asyncSystem,
+        *pProvider,
+        pTile,
+        GlobeRectangle(0.0, 0.0, 1.0, 1.0),
+        glm::dvec2(16.0));
+
+    REQUIRE(image.width == 8);
+    REQUIRE(image.height == 8);
+    REQUIRE(image.pixelData.size() == 64);
+
+    for (size_t row = 0; row < 8; ++row) {
+      for (size_t column = 0; column < 8; ++column) {
+        const uint8_t value = uint8_t(image.pixelData[row * 8 + column]);
+        if (column < 4) {
+          CHECK(value == 255);
+        } else if (column == 4) {
+          CHECK(value == 128);
+        } else {
+          CHECK(value == 0);
+        }
+      }
+    }
+  }
+
+  SECTION("rasterizes polygons crossing the antimeridian") {
+    // The polygon covers the western 0.1416 radians of this 0.2416 radian
+    // wide tile, so 4.69 of the 8 columns.
+    const ImageCesium& image = loadImage(
+        asyncSystem,
+        *pProvider,
+        pTile,
+        GlobeRectangle(-Math::ONE_PI, 0.0, -2.9, 1.0),
+        glm::dvec2(16.0, 4.0));
+
+    REQUIRE(image.width == 8);
+    REQUIRE(image.height == 2);
+
+    for (size_t row = 0; row < 2; ++row) {
+      for (size_t column = 0; column < 8; ++column) {
+        const uint8_t value = uint8_t(image.pixelData[row * 8 + column]);
+        if (column < 4) {
+          CHECK(value == 255);
+        } else if (column == 4) {
+          CHECK(value == 176);
+        } else {
+          CHECK(value == 0);
+        }
+      }
+    }
+  }
+
+  SECTION("creates a 1x1 mask for a tile inside a polygon") {
+    const ImageCesium& image = loadImage(
+        asyncSystem,
+        *pProvider,
+        pTile,
+        GlobeRectangle(0.1, 0.1, 0.2, 0.2),
+        glm::dvec2(16.0));
+
+    REQUIRE(image.width == 1);
+    REQUIRE(image.height == 1);
+    REQUIRE(image.pixelData.size() == 1);
+    CHECK(image.pixelData[0] == std::byte(0xff));
+  }
+}
@@ -0,0 +1,435 @@
+#include "Cesium3DTilesSelection/Tile.h"
+#include "Cesium3DTilesSelection/TileContext.h"
+#include "Cesium3DTilesSelection/Tileset.h"
+#include "readFile.h"
+#include "readTilesetJson.h"
+
+#include <CesiumGeometry/BoundingSphere.h>
+#include <CesiumGeometry/OrientedBoundingBox.h>
+#include <CesiumGeometry/QuadtreeTileID.h>
+#include <CesiumGeospatial/BoundingRegion.h>
+
+#include <catch2/catch.hpp>
+#include <glm/mat4x4.hpp>
+#include <rapidjson/document.h>
+#include <spdlog/spdlog.h>
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+
+namespace {
+
+gsl::span<const std::byte> asBytes(const std::string& json) {
+  return gsl::span<const std::byte>(
+      reinterpret_cast<const std::byte*>(json.data()),
+      json.size());
+}
+
+void checkSameTile(const Tile& actual, const Tile& expected) {
+  CHECK(actual.getContext() == expected.getContext());
+  CHECK(actual.getGeometricError() == expected.getGeometricError());
+  CHECK(actual.getRefine() == expected.getRefine());
+  CHECK(actual.getTransform() == expected.getTransform());
+
+  const std::string* pActualId = std::get_if<std::string>(&actual.getTileID());
+  const std::string* pExpectedId =
+      std::get_if<std::string>(&expected.getTileID());
+  REQUIRE((pActualId == nullptr) == (pExpectedId == nullptr));
+  if (pActualId) {
+    CHECK(*pActualId == *pExpectedId);
+  }
+
+  CHECK(
+      actual.getBoundingVolume().index() ==
+      expected.getBoundingVolume().index());
+  CHECK(
+      getBoundingVolumeCenter(actual.getBoundingVolume()) ==
+      getBoundingVolumeCenter(expected.getBoundingVolume()));
+  CHECK(
+      actual.getContentBoundingVolume().has_value() ==
+      expected.getContentBoundingVolume().has_value());
+  CHECK(
+      actual.getViewerRequestVolume().has_value() ==
+      expected.getViewerRequestVolume().has_value());
+
+  REQUIRE(actual.getChildren().size() == expected.getChildren().size());
+  for (size_t i = 0; i < actual.getChildren().size(); ++i) {
+    const Tile& actualChild = actual.getChildren()[i];
+    CHECK(actualChild.getParent() == &actual);
+    checkSameTile(actualChild, expected.getChildren()[i]);
+  }
+}
+
+} // namespace
+
+TEST_CASE("readTilesetJson creates the same tiles as a parsed document") {
+  const std::filesystem::path testDataPath =
+      Cesium3DTilesSelection_TEST_DATA_DIR;
+  const std::filesystem::path tilesetPath = GENERATE(
+      "Tileset/tileset.json",
+      "AddTileset/tileset.json",
+      "ReplaceTileset/tileset.json",
+      "ErrorChildrenAddTileset/tileset.json");
+
+  const std::vector<std::byte> data = readFile(testDataPath / tilesetPath);
+  const glm::dmat4 parentTransform = glm::dmat4(
+      glm::dvec4(2.0, 0.0, 0.0, 0.0),
+      glm::dvec4(0.0, 2.0, 0.0, 0.0),
+      glm::dvec4(0.0, 0.0, 2.0, 0.0),
+      glm::dvec4(10.0, 20.0, 30.0, 1.0));
+  TileContext context;
+
+  Tile streamed;
+  CesiumJsonReader::ReadJsonResult<TilesetJson> result = readTilesetJson(
+      data,
+      streamed,
+      parentTransform,
+      TileRefine::Add,
+      context,
+      spdlog::default_logger());
+  REQUIRE(result.value);
+  CHECK(result.errors.empty());
+  CHECK(result.value->hasRoot);
+
+  rapidjson::Document document;
+  document.Parse(reinterpret_cast<const char*>(data.data()), data.size());
+  REQUIRE(!document.HasParseError());
+
+  Tile parsed;
+  Tileset::loadTilesFromJson(
+      parsed,
+      document,
+      parentTransform,
+      TileRefine::Add,
+      context,
+      spdlog::default_logger());
+
+  checkSameTile(streamed, parsed);
+
+  TileContext lazyContext;
+  Tile lazy;
+  result = readTilesetJson(
+      data,
+      lazy,
+      parentTransform,
+      TileRefine::Add,
+      lazyContext,
+      spdlog::default_logger(),
+      true);
+  REQUIRE(result.value);
+  CHECK(result.errors.empty());
+  CHECK(lazy.getChildren().empty());
+  CHECK(
+      lazy.getPackedTileRecord().has_value() ==
+      !parsed.getChildren().empty());
+
+  const std::vector<std::byte> cache =
+      writeTilesetJsonCache(*result.value, lazyContext);
+
+  createAllPackedChildTiles(lazy);
+  CHECK(lazy.getContext() == &lazyContext);
+
+  // Compare against tiles created eagerly with the same context.
+  Tile eager;
+  readTilesetJson(
+      data,
+      eager,
+      parentTransform,
+      TileRefine::Add,
+      lazyContext,
+      spdlog::default_logger());
+  checkSameTile(lazy, eager);
+
+  // The cached tiles are the same as the ones they were cached from.
+  TileContext cachedContext;
+  Tile cached;
+  cached.setContext(&cachedContext);
+  std::optional<TilesetJson> cachedTileset = readTilesetJsonCache(
+      cache,
+      cached,
+      parentTransform,
+      TileRefine::Add,
+      cachedContext);
+  REQUIRE(cachedTileset);
+  CHECK(cachedTileset->hasRoot);
+  CHECK(cachedTileset->rootTileRecord == result.value->rootTileRecord);
+  CHECK(cachedContext.packedTiles == lazyContext.packedTiles);
+
+  createAllPackedChildTiles(cached);
+  CHECK(!cached.getPackedTileRecord());
+
+  Tile eagerCached;
+  readTilesetJson(
+      data,
+      eagerCached,
+      parentTransform,
+      TileRefine::Add,
+      cachedContext,
+      spdlog::default_logger());
+  checkSameTile(cached, eagerCached);
+}
+
+TEST_CASE("readTilesetJson") {
+  TileContext context;
+
+  SECTION("applies a transform and refine that follow the children") {
+    const std::string json = R"(
+      {
+        "asset": { "version": "1.0", "gltfUpAxis": "Z" },
+        "root": {
+          "children": [
+            {
+              "boundingVolume": { "sphere": [1.0, 2.0, 3.0, 4.0] },
+              "geometricError": 5.0,
+              "content": { "uri": "child.b3dm" }
+            }
+          ],
+          "boundingVolume": { "sphere": [0.0, 0.0, 0.0, 10.0] },
+          "geometricError": 100.0,
+          "refine": "ADD",
+          "transform": [
+            3.0, 0.0, 0.0, 0.0,
+            0.0, 3.0, 0.0, 0.0,
+            0.0, 0.0, 3.0, 0.0,
+            1.0, 1.0, 1.0, 1.0
+          ]
+        }
+      }
+    )";
+
+    Tile root;
+    CesiumJsonReader::ReadJsonResult<TilesetJson> result = readTilesetJson(
+        asBytes(json),
+        root,
+        glm::dmat4(1.0),
+        TileRefine::Replace,
+        context,
+        spdlog::default_logger());
+    REQUIRE(result.value);
+    CHECK(result.value->gltfUpAxis == "Z");
+    CHECK(root.getContext() == &context);
+    CHECK(root.getRefine() == TileRefine::Add);
+    CHECK(root.getGeometricError() == 300.0);
+
+    REQUIRE(root.getChildren().size() == 1);
+    const Tile& child = root.getChildren()[0];
+    CHECK(child.getParent() == &root);
+    CHECK(child.getContext() == &context);
+    CHECK(child.getRefine() == TileRefine::Add);
+    CHECK(child.getGeometricError() == 15.0);
+    CHECK(std::get<std::string>(child.getTileID()) == "child.b3dm");
+
+    const BoundingSphere* pSphere =
+        std::get_if<BoundingSphere>(&child.getBoundingVolume());
+    REQUIRE(pSphere);
+    CHECK(pSphere->getCenter() == glm::dvec3(4.0, 7.0, 10.0));
+    CHECK(pSphere->getRadius() == 12.0);
+  }
+
+  SECTION("does not create the children of an invalid tile") {
+    const std::string json = R"(
+      {
+        "root": {
+          "boundingVolume": { "box": [0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0, 1] },
+          "geometricError": 100.0,
+          "children": [
+            {
+              "geometricError": 5.0,
+              "children": [
+                {
+                  "boundingVolume": { "sphere": [0, 0, 0, 1] },
+                  "geometricError": 1.0
+                }
+              ]
+            },
+            {
+              "boundingVolume": { "region": [0, 0, 1, 1, 0, 10] },
+              "geometricError": 2.0,
+              "refine": "ADD"
+            }
+          ]
+        }
+      }
+    )";
+
+    Tile root;
+    CesiumJsonReader::ReadJsonResult<TilesetJson> result = readTilesetJson(
+        asBytes(json),
+        root,
+        glm::dmat4(1.0),
+        TileRefine::Replace,
+        context,
+        spdlog::default_logger());
+    REQUIRE(result.value);
+    CHECK(std::holds_alternative<OrientedBoundingBox>(root.getBoundingVolume()));
+
+    REQUIRE(root.getChildren().size() == 2);
+    CHECK(root.getChildren()[0].getChildren().empty());
+    CHECK(root.getChildren()[0].getParent() == &root);
+
+    const Tile& valid = root.getChildren()[1];
+    CHECK(valid.getParent() == &root);
+    CHECK(valid.getRefine() == TileRefine::Add);
+    CHECK(std::holds_alternative<BoundingRegion>(valid.getBoundingVolume()));
+  }
+
+  SECTION("defines the implicit tiling of a tile") {
+    const std::string json = R"(
+      {
+        "root": {
+          "boundingVolume": { "region": [0, 0, 1, 1, 0, 10] },
+          "geometricError": 100.0,
+          "content": { "uri": "content/{level}/{x}/{y}.glb" },
+          "implicitTiling": {
+            "subdivisionScheme": "QUADTREE",
+            "subtreeLevels": 3,
+            "availableLevels": 6,
+            "subtrees": { "uri": "subtrees/{level}/{x}/{y}.subtree" }
+          },
+          "children": [
+            {
+              "boundingVolume": { "sphere": [0, 0, 0, 1] },
+              "geometricError": 1.0
+            }
+          ]
+        }
+      }
+    )";
+
+    Tile root;
+    CesiumJsonReader::ReadJsonResult<TilesetJson> result = readTilesetJson(
+        asBytes(json),
+        root,
+        glm::dmat4(1.0),
+        TileRefine::Replace,
+        context,
+        spdlog::default_logger());
+    REQUIRE(result.value);
+    CHECK(
+        std::get<QuadtreeTileID>(root.getTileID()) == QuadtreeTileID(0, 0, 0));
+    CHECK(root.getChildren().empty());
+
+    REQUIRE(context.subtreeContext);
+    const SubtreeTilingContext& subtreeContext = *context.subtreeContext;
+    CHECK(
+        subtreeContext.subdivisionScheme ==
+        ImplicitTilingSubdivisionScheme::Quadtree);
+    CHECK(subtreeContext.subtreeLevels == 3);
+    CHECK(subtreeContext.availableLevels == 6);
+    CHECK(
+        subtreeContext.subtreeTemplateUrl ==
+        "subtrees/{level}/{x}/{y}.subtree");
+    CHECK(subtreeContext.contentTemplateUrl == "content/{level}/{x}/{y}.glb");
+  }
+
+  SECTION("reads the format of a layer.json") {
+    const std::string json = R"({ "format": "quantized-mesh-1.0" })";
+
+    Tile root;
+    CesiumJsonReader::ReadJsonResult<TilesetJson> result = readTilesetJson(
+        asBytes(json),
+        root,
+        glm::dmat4(1.0),
+        TileRefine::Replace,
+        context,
+        spdlog::default_logger());
+    REQUIRE(result.value);
+    CHECK(!result.value->hasRoot);
+    CHECK(result.value->format == "quantized-mesh-1.0");
+  }
+
+  SECTION("does not read a tileset cache that is invalid") {
+    const std::string json = R"(
+      {
+        "root": {
+          "geometricError": 10.0,
+          "boundingVolume": { "sphere": [0.0, 0.0, 0.0, 1.0] },
+          "children": [{
+            "geometricError": 5.0,
+            "boundingVolume": { "sphere": [0.0, 0.0, 0.0, 1.0] }
+          }]
+        }
+      }
+    )";
+
+    Tile tile;
+    CesiumJsonReader::ReadJsonResult<TilesetJson> result = readTilesetJson(
+        asBytes(json),
+        tile,
+        glm::dmat4(1.0),
+        TileRefine::Replace,
+        context,
+        spdlog::default_logger(),
+        true);
+    REQUIRE(result.value);
+    REQUIRE(result.value->rootTileRecord);
+    const std::vector<std::byte> cache =
+        writeTilesetJsonCache(*result.value, context);
+
+    TileContext cachedContext;
+    Tile cached;
+    CHECK(readTilesetJsonCache(
+        cache,
+        cached,
+        glm::dmat4(1.0),
+        TileRefine::Replace,
+        cachedContext));
+
+    std::vector<std::byte> wrongMagic = cache;
+    wrongMagic[0] = std::byte('x');
+    std::vector<std::byte> wrongVersion = cache;
+    wrongVersion[4] = std::byte(99);
+    std::vector<std::byte> truncated(cache.begin(), cache.end() - 1);
+
+    // The root record is the flags, the child count, the one child record,
+    // the geometric error, and the bounding volume, in that order.
+    const size_t root = cache.size() - context.packedTiles.size() +
+                        size_t(*result.value->rootTileRecord);
+    std::vector<std::byte> wrongChildCount = cache;
+    wrongChildCount[root + 1] = std::byte(0xff);
+    wrongChildCount[root + 2] = std::byte(0xff);
+    std::vector<std::byte> wrongChildRecord = cache;
+    wrongChildRecord[root + 12] = std::byte(0x7f);
+    std::vector<std::byte> wrongBoundingVolume = cache;
+    wrongBoundingVolume[root + 21] = std::byte(99);
+
+    for (const std::vector<std::byte>& invalid :
+         {wrongMagic,
+          wrongVersion,
+          truncated,
+          wrongChildCount,
+          wrongChildRecord,
+          wrongBoundingVolume}) {
+      TileContext invalidContext;
+      CHECK(!readTilesetJsonCache(
+          invalid,
+          cached,
+          glm::dmat4(1.0),
+          TileRefine::Replace,
+          invalidContext));
+      CHECK(invalidContext.packedTiles.empty());
+    }
+  }
+
+  SECTION("reports invalid JSON") {
+    const std::string json = R"({ "root": { "geometricError": )";
+
+    Tile root;
+    CesiumJsonReader::ReadJsonResult<TilesetJson> result = readTilesetJson(
+        asBytes(json),
+        root,
+        glm::dmat4(1.0),
+        TileRefine::Replace,
+        context,
+        spdlog::default_logger());
+    CHECK(!result.value);
+    CHECK(!result.errors.empty());
+  }
+}
@@ -0,0 +1,246 @@
+#include "Cesium3DTilesSelection/SubtreeAvailability.h"
+#include "Cesium3DTilesSelection/Tile.h"
+#include "Cesium3DTilesSelection/TileContext.h"
+#include "SubtreeTiling.h"
+#include "readSubtree.h"
+
+#include <CesiumGeometry/OrientedBoundingBox.h>
+#include <CesiumGeometry/QuadtreeTileID.h>
+#include <CesiumGeospatial/BoundingRegion.h>
+#include <CesiumGeospatial/GlobeRectangle.h>
+#include <CesiumUtility/Math.h>
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace Cesium3DTilesSelection;
+using namespace CesiumGeometry;
+using namespace CesiumGeospatial;
+using namespace CesiumUtility;
+
+namespace {
+
+std::vector<std::byte> createSubtree(
+    const std::string& json,
+    const std::vector<uint8_t>& binary) {
+  const uint32_t version = 1;
+  const uint64_t jsonByteLength = json.size();
+  const uint64_t binaryByteLength = binary.size();
+
+  std::vector<std::byte> result(24 + json.size() + binary.size());
+  std::memcpy(result.data(), "subt", 4);
+  std::memcpy(result.data() + 4, &version, sizeof(version));
+  std::memcpy(result.data() + 8, &jsonByteLength, sizeof(jsonByteLength));
+  std::memcpy(result.data() + 16, &binaryByteLength, sizeof(binaryByteLength));
+  std::memcpy(result.data() + 24, json.data(), json.size());
+  std::memcpy(result.data() + 24 + json.size(), binary.data(), binary.size());
+  return result;
+}
+
+// A quadtree subtree with two levels, in which the root and the level 1 tiles
+// (0, 0) and (1, 1) are available, only (1, 1) has content, and the child
+// subtrees (0, 0) and (3, 3) are available.
+const std::string subtreeJson = R"(
+  {
+    "buffers": [{ "byteLength": 4 }],
+    "bufferViews": [
+      { "buffer": 0, "byteOffset": 0, "byteLength": 1 },
+      { "buffer": 0, "byteOffset": 1, "byteLength": 1 },
+      { "buffer": 0, "byteOffset": 2, "byteLength": 2 }
+    ],
+    "tileAvailability": { "bitstream": 0 },
+    "contentAvailability": [{ "bitstream": 1 }],
+    "childSubtreeAvailability": { "bitstream": 2 }
+  }
+)";
+const std::vector<uint8_t> subtreeBinary{0x13, 0x10, 0x01, 0x80};
+
+SubtreeTilingContext& createSubtreeContext(TileContext& context) {
+  const std::vector<std::byte> data = createSubtree(subtreeJson, subtreeBinary);
+  CesiumJsonReader::ReadJsonResult<SubtreeAvailability> result =
+      readSubtree(data, ImplicitTilingSubdivisionScheme::Quadtree, 2);
+  REQUIRE(result.value);
+
+  SubtreeTilingContext& subtreeContext = context.subtreeContext.emplace();
+  subtreeContext.subdivisionScheme = ImplicitTilingSubdivisionScheme::Quadtree;
+  subtreeContext.subtreeLevels = 2;
+  subtreeContext.availableLevels = 4;
+  subtreeContext.subtreeTemplateUrl = "subtrees/{level}/{x}/{y}.subtree";
+  subtreeContext.contentTemplateUrl = "content/{level}/{x}/{y}.glb";
+  subtreeContext.subtrees.emplace(
+      OctreeTileID(0, 0, 0, 0),
+      std::move(*result.value));
+  return subtreeContext;
+}
+
+} // namespace
+
+TEST_CASE("SubtreeAvailability computes Morton indices") {
+  CHECK(SubtreeAvailability::computeMortonIndex(0, 0) == 0);
+  CHECK(SubtreeAvailability::computeMortonIndex(1, 0) == 1);
+  CHECK(SubtreeAvailability::computeMortonIndex(0, 1) == 2);
+  CHECK(SubtreeAvailability::computeMortonIndex(3, 5) == 0b100111);
+  CHECK(SubtreeAvailability::computeMortonIndex(1, 1, 1) == 7);
+  CHECK(SubtreeAvailability::computeMortonIndex(2, 0, 1) == 0b001100);
+}
+
+TEST_CASE("readSubtree") {
+  SECTION("reads availability bitstreams") {
+    const std::vector<std::byte> data =
+        createSubtree(subtreeJson, subtreeBinary);
+    CesiumJsonReader::ReadJsonResult<SubtreeAvailability> result =
+        readSubtree(data, ImplicitTilingSubdivisionScheme::Quadtree, 2);
+    REQUIRE(result.value);
+    CHECK(result.errors.empty());
+
+    const SubtreeAvailability& subtree = *result.value;
+    CHECK(subtree.isTileAvailable(0, 0));
+    CHECK(subtree.isTileAvailable(1, 0));
+    CHECK(!subtree.isTileAvailable(1, 1));
+    CHECK(!subtree.isTileAvailable(1, 2));
+    CHECK(subtree.isTileAvailable(1, 3));
+    CHECK(!subtree.isTileAvailable(2, 0));
+
+    CHECK(!subtree.isContentAvailable(0, 0));
+    CHECK(!subtree.isContentAvailable(1, 0));
+    CHECK(subtree.isContentAvailable(1, 3));
+    CHECK(!subtree.isContentAvailable(1, 3, 1));
+
+    CHECK(subtree.isSubtreeAvailable(0));
+    CHECK(!subtree.isSubtreeAvailable(1));
+    CHECK(subtree.isSubtreeAvailable(15));
+    CHECK(!subtree.isSubtreeAvailable(16));
+  }
+
+  SECTION("reads constant availability from JSON") {
+    const std::string json = R"(
+      {
+        "tileAvailability": { "constant": 1 },
+        "childSubtreeAvailability": { "constant": 0 }
+      }
+    )";
+    CesiumJsonReader::ReadJsonResult<SubtreeAvailability> result = readSubtree(
+        gsl::span<const std::byte>(
+            reinterpret_cast<const std::byte*>(json.data()),
+            json.size()),
+        ImplicitTilingSubdivisionScheme::Octree,
+        3);
+    REQUIRE(result.value);
+    CHECK(result.value->isTileAvailable(2, 63));
+    CHECK(!result.value->isContentAvailable(0, 0));
+    CHECK(!result.value->isSubtreeAvailable(0));
+  }
+
+  SECTION("reports a bitstream that is too short") {
+    const std::vector<std::byte> data =
+        createSubtree(subtreeJson, subtreeBinary);
+    CesiumJsonReader::ReadJsonResult<SubtreeAvailability> result =
+        readSubtree(data, ImplicitTilingSubdivisionScheme::Quadtree, 3);
+    CHECK(!result.value);
+    CHECK(!result.errors.empty());
+  }
+
+  SECTION("reports an external buffer") {
+    const std::string json = R"(
+      {
+        "buffers": [{ "uri": "external.bin", "byteLength": 1 }],
+        "bufferViews": [{ "buffer": 0, "byteOffset": 0, "byteLength": 1 }],
+        "tileAvailability": { "bitstream": 0 },
+        "childSubtreeAvailability": { "constant": 0 }
+      }
+    )";
+    const std::vector<std::byte> data = createSubtree(json, {});
+    CesiumJsonReader::ReadJsonResult<SubtreeAvailability> result =
+        readSubtree(data, ImplicitTilingSubdivisionScheme::Quadtree, 1);
+    CHECK(!result.value);
+    CHECK(!result.errors.empty());
+  }
+}
+
+TEST_CASE("Subtree tiling creates the available children of a tile") {
+  TileContext context;
+  const SubtreeTilingContext& subtreeContext = createSubtreeContext(context);
+
+  Tile root;
+  root.setContext(&context);
+  root.setTileID(QuadtreeTileID(0, 0, 0));
+  root.setGeometricError(100.0);
+  root.setBoundingVolume(OrientedBoundingBox(
+      glm::dvec3(0.0, 0.0, 0.0),
+      glm::dmat3(
+          glm::dvec3(2.0, 0.0, 0.0),
+          glm::dvec3(0.0, 2.0, 0.0),
+          glm::dvec3(0.0, 0.0, 1.0))));
+
+  createSubtreeChildTiles(root);
+  REQUIRE(root.getChildren().size() == 2);
+
+  const Tile& first = root.getChildren()[0];
+  CHECK(first.getParent() == &root);
+  CHECK(first.getContext() == &context);
+  CHECK(first.getGeometricError() == 50.0);
+  CHECK(std::get<QuadtreeTileID>(first.getTileID()) == QuadtreeTileID(1, 0, 0));
+  const OrientedBoundingBox& firstBox =
+      std::get<OrientedBoundingBox>(first.getBoundingVolume());
+  CHECK(firstBox.getCenter() == glm::dvec3(-1.0, -1.0, 0.0));
+  CHECK(firstBox.getHalfAxes()[0] == glm::dvec3(1.0, 0.0, 0.0));
+  CHECK(firstBox.getHalfAxes()[2] == glm::dvec3(0.0, 0.0, 1.0));
+
+  Tile& last = root.getChildren()[1];
+  CHECK(std::get<QuadtreeTileID>(last.getTileID()) == QuadtreeTileID(1, 1, 1));
+  CHECK(
+      std::get<OrientedBoundingBox>(last.getBoundingVolume()).getCenter() ==
+      glm::dvec3(1.0, 1.0, 0.0));
+
+  CHECK(getSubtreeTileContentUrl(subtreeContext, OctreeTileID(1, 0, 0, 0))
+            .empty());
+  CHECK(
+      getSubtreeTileContentUrl(subtreeContext, OctreeTileID(1, 1, 1, 0)) ==
+      "content/1/1/1.glb");
+
+  // The children of the last level of the subtree are the roots of the
+  // available child subtrees.
+  createSubtreeChildTiles(last);
+  REQUIRE(last.getChildren().size() == 1);
+  CHECK(
+      std::get<QuadtreeTileID>(last.getChildren()[0].getTileID()) ==
+      QuadtreeTileID(2, 3, 3));
+}
+
+TEST_CASE("Subtree tiling subdivides a region across the anti-meridian") {
+  TileContext context;
+  createSubtreeContext(context);
+
+  Tile root;
+  root.setContext(&context);
+  root.setTileID(QuadtreeTileID(0, 0, 0));
+  root.setGeometricError(100.0);
+  root.setBoundingVolume(
+      BoundingRegion(GlobeRectangle(3.0, -0.5, -3.0, 0.5), 0.0, 10.0));
+
+  createSubtreeChildTiles(root);
+  REQUIRE(root.getChildren().size() == 2);
+
+  const double childWidth = Math::ONE_PI - 3.0;
+
+  const GlobeRectangle& first =
+      std::get<BoundingRegion>(root.getChildren()[0].getBoundingVolume())
+          .getRectangle();
+  CHECK(Math::equalsEpsilon(first.getWest(), 3.0, Math::EPSILON14));
+  CHECK(Math::equalsEpsilon(first.getEast(), Math::ONE_PI, Math::EPSILON14));
+  CHECK(first.getSouth() == -0.5);
+  CHECK(first.getNorth() == 0.0);
+
+  const GlobeRectangle& last =
+      std::get<BoundingRegion>(root.getChildren()[1].getBoundingVolume())
+          .getRectangle();
+  CHECK(Math::equalsEpsilon(last.getEast(), -3.0, Math::EPSILON14));
+  CHECK(Math::equalsEpsilon(last.computeWidth(), childWidth, Math::EPSILON14));
+  CHECK(last.getSouth() == 0.0);
+  CHECK(last.getNorth() == 0.5);
+}
@@ -10,6 +10,7 @@
 #include <CesiumAsync/HttpHeaders.h>
 #include <CesiumGltf/ExtensionMeshPrimitiveExtFeatureMetadata.h>
 #include <CesiumGltf/ExtensionModelExtFeatureMetadata.h>
+#include <CesiumGltf/LazyFeatureMetadata.h>
 #include <CesiumGltf/MetadataFeatureTableView.h>
 #include <CesiumGltf/MetadataPropertyView.h>
 
@@ -247,8 +248,9 @@ static void createTestForArrayJson(
       totalInstances);
 }
 
-static std::unique_ptr<TileContentLoadResult>
-loadB3dm(const std::filesystem::path& filePath) {
+static std::unique_ptr<TileContentLoadResult> loadB3dm(
+    const std::filesystem::path& filePath,
+    const TilesetContentOptions& contentOptions = TilesetContentOptions()) {
 
   std::unique_ptr<SimpleAssetResponse> pResponse =
       std::make_unique<SimpleAssetResponse>(
@@ -275,6 +277,7 @@ loadB3dm(const std::filesystem::path& filePath) {
   input.pAssetAccessor =
       std::make_shared<SimpleAssetAccessor>(std::move(mockedRequests)),
   input.pRequest = std::move(pRequest);
+  input.contentOptions = contentOptions;
 
   return Batched3DModelContent().load(input).wait();
 }
@@ -607,6 +610,85 @@ TEST_CASE("Convert binary batch table to EXT_feature_metadata") {
   }
 }
 
+TEST_CASE("Convert batch table to EXT_feature_metadata lazily") {
+  std::filesystem::path testFilePath = Cesium3DTilesSelection_TEST_DATA_DIR;
+  testFilePath =
+      testFilePath / "BatchTables" / "batchedWithBatchTableBinary.b3dm";
+
+  TilesetContentOptions contentOptions;
+  contentOptions.convertBatchTablesLazily = true;
+  std::unique_ptr<TileContentLoadResult> pLazyResult =
+      loadB3dm(testFilePath, contentOptions);
+  std::unique_ptr<TileContentLoadResult> pResult = loadB3dm(testFilePath);
+
+  REQUIRE(pLazyResult != nullptr);
+  REQUIRE(pLazyResult->model != std::nullopt);
+  REQUIRE(pResult != nullptr);
+  REQUIRE(pResult->model != std::nullopt);
+
+  const Model& lazyModel = *pLazyResult->model;
+  const Model& model = *pResult->model;
+
+  // The batch table is not converted until it is viewed, but the batch IDs
+  // are already feature IDs.
+  REQUIRE(
+      lazyModel.getExtension<ExtensionModelExtFeatureMetadata>() == nullptr);
+  REQUIRE(lazyModel.pLazyFeatureMetadata != nullptr);
+  REQUIRE(!lazyModel.pLazyFeatureMetadata->isConverted());
+  REQUIRE(lazyModel.buffers.size() < model.buffers.size());
+  for (const Mesh& mesh : lazyModel.meshes) {
+    for (const MeshPrimitive& primitive : mesh.primitives) {
+      CHECK(
+          primitive.attributes.find("_BATCHID") == primitive.attributes.end());
+      CHECK(
+          primitive.attributes.find("_FEATURE_ID_0") !=
+          primitive.attributes.end());
+      CHECK(
+          primitive.getExtension<ExtensionMeshPrimitiveExtFeatureMetadata>() !=
+          nullptr);
+    }
+  }
+
+  MetadataFeatureTableView lazyView(&lazyModel, "default");
+  REQUIRE(lazyModel.pLazyFeatureMetadata->isConverted());
+
+  const ExtensionModelExtFeatureMetadata* pMetadata =
+      model.getExtension<ExtensionModelExtFeatureMetadata>();
+  REQUIRE(pMetadata != nullptr);
+  const ExtensionModelExtFeatureMetadata* pLazyMetadata =
+      lazyModel.getFeatureMetadataModel()
+          .getExtension<ExtensionModelExtFeatureMetadata>();
+  REQUIRE(pLazyMetadata != nullptr);
+
+  const FeatureTable& featureTable = pMetadata->featureTables.at("default");
+  const Class& defaultClass = pMetadata->schema->classes.at("default");
+  REQUIRE(
+      pLazyMetadata->featureTables.at("default").count == featureTable.count);
+  REQUIRE(
+      pLazyMetadata->schema->classes.at("default").properties.size() ==
+      defaultClass.properties.size());
+
+  MetadataFeatureTableView view(&model, &featureTable);
+  for (const auto& [name, classProperty] : defaultClass.properties) {
+    CHECK(lazyView.getClassProperty(name)->type == classProperty.type);
+  }
+
+  MetadataPropertyView<int8_t> ids = view.getPropertyView<int8_t>("id");
+  MetadataPropertyView<int8_t> lazyIds = lazyView.getPropertyView<int8_t>("id");
+  MetadataPropertyView<double> heights =
+      view.getPropertyView<double>("Height");
+  MetadataPropertyView<double> lazyHeights =
+      lazyView.getPropertyView<double>("Height");
+  REQUIRE(lazyIds.status() == MetadataPropertyViewStatus::Valid);
+  REQUIRE(lazyHeights.status() == MetadataPropertyViewStatus::Valid);
+  REQUIRE(lazyIds.size() == ids.size());
+  REQUIRE(lazyHeights.size() == heights.size());
+  for (int64_t i = 0; i < ids.size(); ++i) {
+    REQUIRE(lazyIds.get(i) == ids.get(i));
+    REQUIRE(lazyHeights.get(i) == heights.get(i));
+  }
+}
+
 TEST_CASE("Upgrade json nested json metadata to string") {
   std::filesystem::path testFilePath = Cesium3DTilesSelection_TEST_DATA_DIR;
   testFilePath =
@@ -1187,3 +1269,150 @@ TEST_CASE("Cannot write pass batch length table") {
         2);
   }
 }
+
+TEST_CASE("Upgrade dynamic string array with more strings than bytes") {
+  // The array offsets point to string offsets, so they need a larger offset
+  // type than the strings themselves.
+  std::vector<std::vector<std::string>> expected{
+      std::vector<std::string>(300, ""),
+      {"a"}};
+  createTestForArrayJson<std::string, std::string_view>(
+      expected,
+      "STRING",
+      0,
+      expected.size());
+}
+
+static void addJsonPropertiesToBatchTable(
+    rapidjson::Document& batchTableJson,
+    size_t propertyCount,
+    int64_t featureCount) {
+  for (size_t i = 0; i < propertyCount; ++i) {
+    rapidjson::Value values(rapidjson::kArrayType);
+    for (int64_t j = 0; j < featureCount; ++j) {
+      if (i % 3 == 0) {
+        values.PushBack(
+            rapidjson::Value(
+                static_cast<double>(j) * 0.5 + static_cast<double>(i)),
+            batchTableJson.GetAllocator());
+      } else if (i % 3 == 1) {
+        const std::string str = "feature" + std::to_string(j);
+        values.PushBack(
+            rapidjson::Value(
+                str.c_str(),
+                static_cast<rapidjson::SizeType>(str.size()),
+                batchTableJson.GetAllocator()),
+            batchTableJson.GetAllocator());
+      } else {
+        rapidjson::Value array(rapidjson::kArrayType);
+        for (int64_t k = 0; k < j % 4; ++k) {
+          array.PushBack(rapidjson::Value(k), batchTableJson.GetAllocator());
+        }
+        values.PushBack(array, batchTableJson.GetAllocator());
+      }
+    }
+
+    const std::string name = "property" + std::to_string(i);
+    batchTableJson.AddMember(
+        rapidjson::Value(
+            name.c_str(),
+            static_cast<rapidjson::SizeType>(name.size()),
+            batchTableJson.GetAllocator()),
+        values,
+        batchTableJson.GetAllocator());
+  }
+}
+
+TEST_CASE("Upgrade many json properties in batch table order") {
+  const size_t propertyCount = 30;
+  const int64_t featureCount = 5000;
+
+  rapidjson::Document featureTableJson;
+  featureTableJson.SetObject();
+  featureTableJson.AddMember(
+      "BATCH_LENGTH",
+      rapidjson::Value(featureCount),
+      featureTableJson.GetAllocator());
+
+  rapidjson::Document batchTableJson;
+  batchTableJson.SetObject();
+  addJsonPropertiesToBatchTable(batchTableJson, propertyCount, featureCount);
+
+  Model model;
+  upgradeBatchTableToFeatureMetadata(
+      spdlog::default_logger(),
+      model,
+      featureTableJson,
+      batchTableJson,
+      gsl::span<const std::byte>());
+
+  ExtensionModelExtFeatureMetadata* metadata =
+      model.getExtension<ExtensionModelExtFeatureMetadata>();
+  REQUIRE(metadata != nullptr);
+
+  const FeatureTable& featureTable = metadata->featureTables["default"];
+  REQUIRE(featureTable.properties.size() == propertyCount);
+
+  // The buffers are added in the order of the properties in the batch table.
+  int32_t previousBufferView = -1;
+  for (size_t i = 0; i < propertyCount; ++i) {
+    const FeatureTableProperty& property =
+        featureTable.properties.at("property" + std::to_string(i));
+    REQUIRE(property.bufferView > previousBufferView);
+    previousBufferView = glm::max(
+        property.bufferView,
+        glm::max(
+            property.stringOffsetBufferView,
+            property.arrayOffsetBufferView));
+  }
+
+  REQUIRE(
+      static_cast<size_t>(previousBufferView + 1) == model.bufferViews.size());
+
+  MetadataFeatureTableView view(&model, &featureTable);
+  MetadataPropertyView<float> floats =
+      view.getPropertyView<float>("property27");
+  MetadataPropertyView<std::string_view> strings =
+      view.getPropertyView<std::string_view>("property28");
+  MetadataPropertyView<MetadataArrayView<int8_t>> arrays =
+      view.getPropertyView<MetadataArrayView<int8_t>>("property29");
+  REQUIRE(floats.status() == MetadataPropertyViewStatus::Valid);
+  REQUIRE(strings.status() == MetadataPropertyViewStatus::Valid);
+  REQUIRE(arrays.status() == MetadataPropertyViewStatus::Valid);
+  for (int64_t i = 0; i < featureCount; ++i) {
+    REQUIRE(floats.get(i) == static_cast<float>(i) * 0.5f + 27.0f);
+    REQUIRE(strings.get(i) == "feature" + std::to_string(i));
+
+    MetadataArrayView<int8_t> array = arrays.get(i);
+    REQUIRE(array.size() == i % 4);
+    for (int64_t j = 0; j < array.size(); ++j) {
+      REQUIRE(array[j] == j);
+    }
+  }
+}
+
+TEST_CASE("Benchmark batch table upgrade", "[.][benchmark]") {
+  const int64_t featureCount = 100000;
+
+  rapidjson::Document featureTableJson;
+  featureTableJson.SetObject();
+  featureTableJson.AddMember(
+      "BATCH_LENGTH",
+      rapidjson::Value(featureCount),
+      featureTableJson.GetAllocator());
+
+  rapidjson::Document batchTableJson;
+  batchTableJson.SetObject();
+  addJsonPropertiesToBatchTable(batchTableJson, 24, featureCount);
+
+  BENCHMARK("Upgrade 24 properties of 100000 features") {
+    Model model;
+    upgradeBatchTableToFeatureMetadata(
+        spdlog::default_logger(),
+        model,
+        featureTableJson,
+        batchTableJson,
+        gsl::span<const std::byte>());
+    return model.buffers.size();
+  };
+}
@@ -4,11 +4,13 @@
 #include <CesiumGeospatial/Cartographic.h>
 #include <CesiumGeospatial/Ellipsoid.h>
 #include <CesiumGltf/AccessorView.h>
+#include <CesiumGltf/DequantizedAccessorView.h>
 #include <CesiumUtility/Math.h>
 
 #include <catch2/catch.hpp>
 #include <glm/trigonometric.hpp>
 
+#include <array>
 #include <cstring>
 #include <vector>
 
@@ -212,6 +214,9 @@ TEST_CASE("Test upsample tile without skirts") {
         upsampledModel,
         upsampledPrimitive.indices);
 
+    // Vertices shared between the clipped triangles are only created once.
+    REQUIRE(upsampledPosition.size() == 5);
+
     glm::vec3 p0 = upsampledPosition[0];
     REQUIRE(
         glm::epsilonEqual(
@@ -230,7 +235,7 @@ TEST_CASE("Test upsample tile without skirts") {
     REQUIRE(
         glm::epsilonEqual(
             p2,
-            (upsampledPosition[1] + positions[1]) * 0.5f,
+            (positions[1] + (positions[0] + positions[2]) * 0.5f) * 0.5f,
             glm::vec3(static_cast<float>(Math::EPSILON7))) == glm::bvec3(true));
 
     glm::vec3 p3 = upsampledPosition[3];
@@ -244,22 +249,8 @@ TEST_CASE("Test upsample tile without skirts") {
     REQUIRE(
         glm::epsilonEqual(
             p4,
-            (positions[0] + positions[2]) * 0.5f,
-            glm::vec3(static_cast<float>(Math::EPSILON7))) == glm::bvec3(true));
-
-    glm::vec3 p5 = upsampledPosition[5];
-    REQUIRE(
-        glm::epsilonEqual(
-            p5,
             (positions[1] + positions[2]) * 0.5f,
             glm::vec3(static_cast<float>(Math::EPSILON7))) == glm::bvec3(true));
-
-    glm::vec3 p6 = upsampledPosition[6];
-    REQUIRE(
-        glm::epsilonEqual(
-            p6,
-            (upsampledPosition[4] + positions[1]) * 0.5f,
-            glm::vec3(static_cast<float>(Math::EPSILON7))) == glm::bvec3(true));
   }
 
   SECTION("Upsample upper left child") {
@@ -282,6 +273,9 @@ TEST_CASE("Test upsample tile without skirts") {
         upsampledModel,
         upsampledPrimitive.indices);
 
+    // Vertices shared between the clipped triangles are only created once.
+    REQUIRE(upsampledPosition.size() == 5);
+
     glm::vec3 p0 = upsampledPosition[0];
     REQUIRE(
         glm::epsilonEqual(
@@ -314,20 +308,6 @@ TEST_CASE("Test upsample tile without skirts") {
     REQUIRE(
         glm::epsilonEqual(
             p4,
-            p2,
-            glm::vec3(static_cast<float>(Math::EPSILON7))) == glm::bvec3(true));
-
-    glm::vec3 p5 = upsampledPosition[5];
-    REQUIRE(
-        glm::epsilonEqual(
-            p5,
-            (positions[1] + positions[2]) * 0.5f,
-            glm::vec3(static_cast<float>(Math::EPSILON7))) == glm::bvec3(true));
-
-    glm::vec3 p6 = upsampledPosition[6];
-    REQUIRE(
-        glm::epsilonEqual(
-            p6,
             (positions[1] + positions[3]) * 0.5f,
             glm::vec3(static_cast<float>(Math::EPSILON7))) == glm::bvec3(true));
   }
@@ -352,6 +332,9 @@ TEST_CASE("Test upsample tile without skirts") {
         upsampledModel,
         upsampledPrimitive.indices);
 
+    // Vertices shared between the clipped triangles are only created once.
+    REQUIRE(upsampledPosition.size() == 5);
+
     glm::vec3 p0 = upsampledPosition[0];
     REQUIRE(
         glm::epsilonEqual(
@@ -384,22 +367,8 @@ TEST_CASE("Test upsample tile without skirts") {
     REQUIRE(
         glm::epsilonEqual(
             p4,
-            (positions[1] + positions[3]) * 0.5f,
-            glm::vec3(static_cast<float>(Math::EPSILON7))) == glm::bvec3(true));
-
-    glm::vec3 p5 = upsampledPosition[5];
-    REQUIRE(
-        glm::epsilonEqual(
-            p5,
             (positions[1] + positions[2]) * 0.5f,
             glm::vec3(static_cast<float>(Math::EPSILON7))) == glm::bvec3(true));
-
-    glm::vec3 p6 = upsampledPosition[6];
-    REQUIRE(
-        glm::epsilonEqual(
-            p6,
-            p2,
-            glm::vec3(static_cast<float>(Math::EPSILON7))) == glm::bvec3(true));
   }
 
   SECTION("Upsample bottom right child") {
@@ -422,6 +391,9 @@ TEST_CASE("Test upsample tile without skirts") {
         upsampledModel,
         upsampledPrimitive.indices);
 
+    // Vertices shared between the clipped triangles are only created once.
+    REQUIRE(upsampledPosition.size() == 5);
+
     glm::vec3 p0 = upsampledPosition[0];
     REQUIRE(
         glm::epsilonEqual(
@@ -456,20 +428,26 @@ TEST_CASE("Test upsample tile without skirts") {
             p4,
             (positions[2] + (positions[1] + positions[3]) * 0.5f) * 0.5f,
             glm::vec3(static_cast<float>(Math::EPSILON7))) == glm::bvec3(true));
+  }
 
-    glm::vec3 p5 = upsampledPosition[5];
-    REQUIRE(
-        glm::epsilonEqual(
-            p5,
-            (positions[1] + positions[2]) * 0.5f,
-            glm::vec3(static_cast<float>(Math::EPSILON7))) == glm::bvec3(true));
-
-    glm::vec3 p6 = upsampledPosition[6];
-    REQUIRE(
-        glm::epsilonEqual(
-            p6,
-            p4,
-            glm::vec3(static_cast<float>(Math::EPSILON7))) == glm::bvec3(true));
+  SECTION("Upsample all children in one pass") {
+    std::array<Model, 4> children = upsampleGltfForRasterOverlayChildren(
+        model,
+        CesiumGeometry::QuadtreeTileID(0, 0, 0));
+    std::array<Model, 4> expected{
+        upsampleGltfForRasterOverlays(model, lowerLeft),
+        upsampleGltfForRasterOverlays(model, lowerRight),
+        upsampleGltfForRasterOverlays(model, upperLeft),
+        upsampleGltfForRasterOverlays(model, upperRight)};
+
+    for (size_t i = 0; i < children.size(); ++i) {
+      REQUIRE(children[i].buffers.size() == expected[i].buffers.size());
+      for (size_t j = 0; j < children[i].buffers.size(); ++j) {
+        REQUIRE(
+            children[i].buffers[j].cesium.data ==
+            expected[i].buffers[j].cesium.data);
+      }
+    }
   }
 
   SECTION("Check skirt") {
@@ -507,17 +485,20 @@ TEST_CASE("Test upsample tile without skirts") {
           upsampledModel,
           upsampledPrimitive.indices);
 
+      // Each edge vertex gets exactly one skirt vertex.
+      REQUIRE(upsampledPosition.size() == 14);
+
       // check west edge
       checkSkirt(
           ellipsoid,
           upsampledPosition[0],
-          upsampledPosition[7],
+          upsampledPosition[5],
           center,
           skirtHeight);
       checkSkirt(
           ellipsoid,
           upsampledPosition[3],
-          upsampledPosition[8],
+          upsampledPosition[6],
           center,
           skirtHeight);
 
@@ -525,39 +506,27 @@ TEST_CASE("Test upsample tile without skirts") {
       checkSkirt(
           ellipsoid,
           upsampledPosition[1],
-          upsampledPosition[9],
-          center,
-          skirtHeight);
-      checkSkirt(
-          ellipsoid,
-          upsampledPosition[4],
-          upsampledPosition[10],
+          upsampledPosition[7],
           center,
           skirtHeight);
       checkSkirt(
           ellipsoid,
           upsampledPosition[0],
-          upsampledPosition[11],
+          upsampledPosition[8],
           center,
           skirtHeight);
 
       // check east edge
       checkSkirt(
           ellipsoid,
-          upsampledPosition[5],
-          upsampledPosition[12],
+          upsampledPosition[4],
+          upsampledPosition[9],
           center,
           skirtHeight * 0.5);
       checkSkirt(
           ellipsoid,
           upsampledPosition[1],
-          upsampledPosition[13],
-          center,
-          skirtHeight * 0.5);
-      checkSkirt(
-          ellipsoid,
-          upsampledPosition[4],
-          upsampledPosition[14],
+          upsampledPosition[10],
           center,
           skirtHeight * 0.5);
 
@@ -565,25 +534,19 @@ TEST_CASE("Test upsample tile without skirts") {
       checkSkirt(
           ellipsoid,
           upsampledPosition[3],
-          upsampledPosition[15],
+          upsampledPosition[11],
           center,
           skirtHeight * 0.5);
       checkSkirt(
           ellipsoid,
           upsampledPosition[2],
-          upsampledPosition[16],
-          center,
-          skirtHeight * 0.5);
-      checkSkirt(
-          ellipsoid,
-          upsampledPosition[6],
-          upsampledPosition[17],
+          upsampledPosition[12],
           center,
           skirtHeight * 0.5);
       checkSkirt(
           ellipsoid,
-          upsampledPosition[5],
-          upsampledPosition[18],
+          upsampledPosition[4],
+          upsampledPosition[13],
           center,
           skirtHeight * 0.5);
     }
@@ -608,29 +571,20 @@ TEST_CASE("Test upsample tile without skirts") {
           upsampledModel,
           upsampledPrimitive.indices);
 
+      // Each edge vertex gets exactly one skirt vertex.
+      REQUIRE(upsampledPosition.size() == 14);
+
       // check west edge
       checkSkirt(
           ellipsoid,
           upsampledPosition[1],
-          upsampledPosition[7],
-          center,
-          skirtHeight);
-      checkSkirt(
-          ellipsoid,
-          upsampledPosition[0],
-          upsampledPosition[8],
-          center,
-          skirtHeight);
-      checkSkirt(
-          ellipsoid,
-          upsampledPosition[0],
-          upsampledPosition[9],
+          upsampledPosition[5],
           center,
           skirtHeight);
       checkSkirt(
           ellipsoid,
           upsampledPosition[0],
-          upsampledPosition[10],
+          upsampledPosition[6],
           center,
           skirtHeight);
 
@@ -638,51 +592,33 @@ TEST_CASE("Test upsample tile without skirts") {
       checkSkirt(
           ellipsoid,
           upsampledPosition[3],
-          upsampledPosition[11],
-          center,
-          skirtHeight * 0.5);
-      checkSkirt(
-          ellipsoid,
-          upsampledPosition[5],
-          upsampledPosition[12],
+          upsampledPosition[7],
           center,
           skirtHeight * 0.5);
       checkSkirt(
           ellipsoid,
           upsampledPosition[2],
-          upsampledPosition[13],
-          center,
-          skirtHeight * 0.5);
-      checkSkirt(
-          ellipsoid,
-          upsampledPosition[4],
-          upsampledPosition[14],
+          upsampledPosition[8],
           center,
           skirtHeight * 0.5);
       checkSkirt(
           ellipsoid,
           upsampledPosition[1],
-          upsampledPosition[15],
+          upsampledPosition[9],
           center,
           skirtHeight * 0.5);
 
       // check east edge
       checkSkirt(
           ellipsoid,
-          upsampledPosition[6],
-          upsampledPosition[16],
+          upsampledPosition[4],
+          upsampledPosition[10],
           center,
           skirtHeight * 0.5);
       checkSkirt(
           ellipsoid,
           upsampledPosition[3],
-          upsampledPosition[17],
-          center,
-          skirtHeight * 0.5);
-      checkSkirt(
-          ellipsoid,
-          upsampledPosition[5],
-          upsampledPosition[18],
+          upsampledPosition[11],
           center,
           skirtHeight * 0.5);
 
@@ -690,25 +626,13 @@ TEST_CASE("Test upsample tile without skirts") {
       checkSkirt(
           ellipsoid,
           upsampledPosition[0],
-          upsampledPosition[19],
-          center,
-          skirtHeight);
-      checkSkirt(
-          ellipsoid,
-          upsampledPosition[0],
-          upsampledPosition[20],
-          center,
-          skirtHeight);
-      checkSkirt(
-          ellipsoid,
-          upsampledPosition[0],
-          upsampledPosition[21],
+          upsampledPosition[12],
           center,
           skirtHeight);
       checkSkirt(
           ellipsoid,
-          upsampledPosition[6],
-          upsampledPosition[22],
+          upsampledPosition[4],
+          upsampledPosition[13],
           center,
           skirtHeight);
     }
@@ -733,23 +657,20 @@ TEST_CASE("Test upsample tile without skirts") {
           upsampledModel,
           upsampledPrimitive.indices);
 
+      // Each edge vertex gets exactly one skirt vertex.
+      REQUIRE(upsampledPosition.size() == 14);
+
       // check west edge
       checkSkirt(
           ellipsoid,
+          upsampledPosition[4],
           upsampledPosition[5],
-          upsampledPosition[7],
           center,
           skirtHeight * 0.5);
       checkSkirt(
           ellipsoid,
           upsampledPosition[1],
-          upsampledPosition[8],
-          center,
-          skirtHeight * 0.5);
-      checkSkirt(
-          ellipsoid,
-          upsampledPosition[4],
-          upsampledPosition[9],
+          upsampledPosition[6],
           center,
           skirtHeight * 0.5);
 
@@ -757,25 +678,19 @@ TEST_CASE("Test upsample tile without skirts") {
       checkSkirt(
           ellipsoid,
           upsampledPosition[3],
-          upsampledPosition[10],
+          upsampledPosition[7],
           center,
           skirtHeight * 0.5);
       checkSkirt(
           ellipsoid,
           upsampledPosition[2],
-          upsampledPosition[11],
-          center,
-          skirtHeight * 0.5);
-      checkSkirt(
-          ellipsoid,
-          upsampledPosition[6],
-          upsampledPosition[12],
+          upsampledPosition[8],
           center,
           skirtHeight * 0.5);
       checkSkirt(
           ellipsoid,
-          upsampledPosition[5],
-          upsampledPosition[13],
+          upsampledPosition[4],
+          upsampledPosition[9],
           center,
           skirtHeight * 0.5);
 
@@ -783,13 +698,13 @@ TEST_CASE("Test upsample tile without skirts") {
       checkSkirt(
           ellipsoid,
           upsampledPosition[0],
-          upsampledPosition[14],
+          upsampledPosition[10],
           center,
           skirtHeight);
       checkSkirt(
           ellipsoid,
           upsampledPosition[3],
-          upsampledPosition[15],
+          upsampledPosition[11],
           center,
           skirtHeight);
 
@@ -797,19 +712,13 @@ TEST_CASE("Test upsample tile without skirts") {
       checkSkirt(
           ellipsoid,
           upsampledPosition[1],
-          upsampledPosition[16],
-          center,
-          skirtHeight);
-      checkSkirt(
-          ellipsoid,
-          upsampledPosition[4],
-          upsampledPosition[17],
+          upsampledPosition[12],
           center,
           skirtHeight);
       checkSkirt(
           ellipsoid,
           upsampledPosition[0],
-          upsampledPosition[18],
+          upsampledPosition[13],
           center,
           skirtHeight);
     }
@@ -834,23 +743,20 @@ TEST_CASE("Test upsample tile without skirts") {
           upsampledModel,
           upsampledPrimitive.indices);
 
+      // Each edge vertex gets exactly one skirt vertex.
+      REQUIRE(upsampledPosition.size() == 14);
+
       // check west edge
       checkSkirt(
           ellipsoid,
           upsampledPosition[2],
-          upsampledPosition[7],
+          upsampledPosition[5],
           center,
           skirtHeight * 0.5);
       checkSkirt(
           ellipsoid,
           upsampledPosition[1],
-          upsampledPosition[8],
-          center,
-          skirtHeight * 0.5);
-      checkSkirt(
-          ellipsoid,
-          upsampledPosition[5],
-          upsampledPosition[9],
+          upsampledPosition[6],
           center,
           skirtHeight * 0.5);
 
@@ -858,25 +764,13 @@ TEST_CASE("Test upsample tile without skirts") {
       checkSkirt(
           ellipsoid,
           upsampledPosition[0],
-          upsampledPosition[10],
-          center,
-          skirtHeight);
-      checkSkirt(
-          ellipsoid,
-          upsampledPosition[0],
-          upsampledPosition[11],
-          center,
-          skirtHeight);
-      checkSkirt(
-          ellipsoid,
-          upsampledPosition[0],
-          upsampledPosition[12],
+          upsampledPosition[7],
           center,
           skirtHeight);
       checkSkirt(
           ellipsoid,
           upsampledPosition[2],
-          upsampledPosition[13],
+          upsampledPosition[8],
           center,
           skirtHeight);
 
@@ -884,25 +778,13 @@ TEST_CASE("Test upsample tile without skirts") {
       checkSkirt(
           ellipsoid,
           upsampledPosition[3],
-          upsampledPosition[14],
-          center,
-          skirtHeight);
-      checkSkirt(
-          ellipsoid,
-          upsampledPosition[0],
-          upsampledPosition[15],
-          center,
-          skirtHeight);
-      checkSkirt(
-          ellipsoid,
-          upsampledPosition[0],
-          upsampledPosition[16],
+          upsampledPosition[9],
           center,
           skirtHeight);
       checkSkirt(
           ellipsoid,
           upsampledPosition[0],
-          upsampledPosition[17],
+          upsampledPosition[10],
           center,
           skirtHeight);
 
@@ -910,33 +792,305 @@ TEST_CASE("Test upsample tile without skirts") {
       checkSkirt(
           ellipsoid,
           upsampledPosition[1],
-          upsampledPosition[18],
-          center,
-          skirtHeight * 0.5);
-      checkSkirt(
-          ellipsoid,
-          upsampledPosition[5],
-          upsampledPosition[19],
+          upsampledPosition[11],
           center,
           skirtHeight * 0.5);
       checkSkirt(
           ellipsoid,
           upsampledPosition[4],
-          upsampledPosition[20],
-          center,
-          skirtHeight * 0.5);
-      checkSkirt(
-          ellipsoid,
-          upsampledPosition[6],
-          upsampledPosition[21],
+          upsampledPosition[12],
           center,
           skirtHeight * 0.5);
       checkSkirt(
           ellipsoid,
           upsampledPosition[3],
-          upsampledPosition[22],
+          upsampledPosition[13],
           center,
           skirtHeight * 0.5);
     }
   }
 }
+
+// Creates a grid of triangles with the given texture coordinates along both
+// axes.
+static Model createGridModel(const std::vector<float>& coordinates) {
+  std::vector<glm::vec3> positions;
+  std::vector<glm::vec2> uvs;
+  std::vector<uint32_t> indices;
+
+  const uint32_t verticesPerSide = static_cast<uint32_t>(coordinates.size());
+  for (float v : coordinates) {
+    for (float u : coordinates) {
+      positions.emplace_back(u * 1000.0f, v * 1000.0f, 0.0f);
+      uvs.emplace_back(u, v);
+    }
+  }
+
+  for (uint32_t y = 0; y + 1 < verticesPerSide; ++y) {
+    for (uint32_t x = 0; x + 1 < verticesPerSide; ++x) {
+      const uint32_t sw = y * verticesPerSide + x;
+      const uint32_t se = sw + 1;
+      const uint32_t nw = sw + verticesPerSide;
+      const uint32_t ne = nw + 1;
+      indices.insert(indices.end(), {sw, se, nw, nw, se, ne});
+    }
+  }
+
+  Model model;
+  Buffer& buffer = model.buffers.emplace_back();
+  const size_t positionsSize = positions.size() * sizeof(glm::vec3);
+  const size_t uvsSize = uvs.size() * sizeof(glm::vec2);
+  const size_t indicesSize = indices.size() * sizeof(uint32_t);
+  buffer.cesium.data.resize(positionsSize + uvsSize + indicesSize);
+  std::memcpy(buffer.cesium.data.data(), positions.data(), positionsSize);
+  std::memcpy(buffer.cesium.data.data() + positionsSize, uvs.data(), uvsSize);
+  std::memcpy(
+      buffer.cesium.data.data() + positionsSize + uvsSize,
+      indices.data(),
+      indicesSize);
+
+  const auto addAccessor = [&model](
+                               int64_t byteOffset,
+                               int64_t byteLength,
+                               int64_t count,
+                               int32_t componentType,
+                               const std::string& type) {
+    BufferView& bufferView = model.bufferViews.emplace_back();
+    bufferView.buffer = 0;
+    bufferView.byteOffset = byteOffset;
+    bufferView.byteLength = byteLength;
+
+    Accessor& accessor = model.accessors.emplace_back();
+    accessor.bufferView = static_cast<int32_t>(model.bufferViews.size() - 1);
+    accessor.count = count;
+    accessor.componentType = componentType;
+    accessor.type = type;
+    return static_cast<int32_t>(model.accessors.size() - 1);
+  };
+
+  MeshPrimitive& primitive =
+      model.meshes.emplace_back().primitives.emplace_back();
+  primitive.mode = MeshPrimitive::Mode::TRIANGLES;
+  primitive.attributes["POSITION"] = addAccessor(
+      0,
+      int64_t(positionsSize),
+      int64_t(positions.size()),
+      Accessor::ComponentType::FLOAT,
+      Accessor::Type::VEC3);
+  primitive.attributes["_CESIUMOVERLAY_0"] = addAccessor(
+      int64_t(positionsSize),
+      int64_t(uvsSize),
+      int64_t(uvs.size()),
+      Accessor::ComponentType::FLOAT,
+      Accessor::Type::VEC2);
+  primitive.indices = addAccessor(
+      int64_t(positionsSize + uvsSize),
+      int64_t(indicesSize),
+      int64_t(indices.size()),
+      Accessor::ComponentType::UNSIGNED_INT,
+      Accessor::Type::SCALAR);
+
+  return model;
+}
+
+TEST_CASE("Upsampled children share vertices along clipped edges") {
+  // These coordinates make every clip point exactly representable.
+  const Model model = createGridModel({0.0f, 0.25f, 0.75f, 1.0f});
+  const std::array<Model, 4> children = upsampleGltfForRasterOverlayChildren(
+      model,
+      CesiumGeometry::QuadtreeTileID(0, 0, 0));
+
+  for (const Model& child : children) {
+    const MeshPrimitive& primitive = child.meshes[0].primitives[0];
+    const AccessorView<glm::vec3> positions(
+        child,
+        primitive.attributes.at("POSITION"));
+    REQUIRE(positions.status() == AccessorViewStatus::Valid);
+    REQUIRE(positions.size() > 0);
+
+    for (int64_t i = 0; i < positions.size(); ++i) {
+      for (int64_t j = i + 1; j < positions.size(); ++j) {
+        CHECK(positions[i] != positions[j]);
+      }
+    }
+  }
+}
+
+template <typename T>
+static int32_t addQuantizedAccessor(
+    Model& model,
+    const std::vector<T>& values,
+    int64_t count,
+    int32_t componentType,
+    const std::string& type,
+    bool normalized) {
+  Buffer& buffer = model.buffers.emplace_back();
+  buffer.cesium.data.resize(values.size() * sizeof(T));
+  buffer.byteLength = static_cast<int64_t>(buffer.cesium.data.size());
+  std::memcpy(
+      buffer.cesium.data.data(),
+      values.data(),
+      buffer.cesium.data.size());
+
+  BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = static_cast<int32_t>(model.buffers.size() - 1);
+  bufferView.byteLength = buffer.byteLength;
+  bufferView.byteStride = buffer.byteLength / count;
+
+  Accessor& accessor = model.accessors.emplace_back();
+  accessor.bufferView = static_cast<int32_t>(model.bufferViews.size() - 1);
+  accessor.count = count;
+  accessor.componentType = componentType;
+  accessor.type = type;
+  accessor.normalized = normalized;
+  return static_cast<int32_t>(model.accessors.size() - 1);
+}
+
+TEST_CASE("Upsampling preserves quantized attributes") {
+  const std::vector<float> coordinates = {0.0f, 0.25f, 0.75f, 1.0f};
+  Model model = createGridModel(coordinates);
+  MeshPrimitive& primitive = model.meshes[0].primitives[0];
+
+  // Replace the float positions with shorts, and add normals stored as
+  // normalized bytes and texture coordinates stored as normalized unsigned
+  // shorts, each padded to 4-byte alignment.
+  std::vector<int16_t> positions;
+  std::vector<int8_t> normals;
+  std::vector<uint16_t> texCoords;
+  for (float v : coordinates) {
+    for (float u : coordinates) {
+      positions.insert(
+          positions.end(),
+          {static_cast<int16_t>(u * 1000.0f),
+           static_cast<int16_t>(v * 1000.0f),
+           0,
+           0});
+      normals.insert(normals.end(), {0, 0, 127, 0});
+      texCoords.insert(
+          texCoords.end(),
+          {static_cast<uint16_t>(u * 65535.0f),
+           static_cast<uint16_t>(v * 65535.0f)});
+    }
+  }
+
+  const int64_t vertexCount =
+      static_cast<int64_t>(coordinates.size() * coordinates.size());
+  primitive.attributes["POSITION"] = addQuantizedAccessor(
+      model,
+      positions,
+      vertexCount,
+      Accessor::ComponentType::SHORT,
+      Accessor::Type::VEC3,
+      false);
+  primitive.attributes["NORMAL"] = addQuantizedAccessor(
+      model,
+      normals,
+      vertexCount,
+      Accessor::ComponentType::BYTE,
+      Accessor::Type::VEC3,
+      true);
+  primitive.attributes["TEXCOORD_0"] = addQuantizedAccessor(
+      model,
+      texCoords,
+      vertexCount,
+      Accessor::ComponentType::UNSIGNED_SHORT,
+      Accessor::Type::VEC2,
+      true);
+
+  const std::array<Model, 4> children = upsampleGltfForRasterOverlayChildren(
+      model,
+      CesiumGeometry::QuadtreeTileID(0, 0, 0));
+
+  for (const Model& child : children) {
+    const MeshPrimitive& childPrimitive = child.meshes[0].primitives[0];
+    const Accessor& position =
+        child.accessors[size_t(childPrimitive.attributes.at("POSITION"))];
+    const Accessor& normal =
+        child.accessors[size_t(childPrimitive.attributes.at("NORMAL"))];
+    const Accessor& texCoord =
+        child.accessors[size_t(childPrimitive.attributes.at("TEXCOORD_0"))];
+    CHECK(position.componentType == Accessor::ComponentType::SHORT);
+    CHECK(!position.normalized);
+    CHECK(normal.componentType == Accessor::ComponentType::BYTE);
+    CHECK(normal.normalized);
+    CHECK(texCoord.componentType == Accessor::ComponentType::UNSIGNED_SHORT);
+    CHECK(texCoord.normalized);
+
+    const DequantizedAccessorView<glm::vec3> positionView(child, position);
+    const DequantizedAccessorView<glm::vec3> normalView(child, normal);
+    const DequantizedAccessorView<glm::vec2> texCoordView(child, texCoord);
+    REQUIRE(positionView.status() == AccessorViewStatus::Valid);
+    REQUIRE(normalView.status() == AccessorViewStatus::Valid);
+    REQUIRE(texCoordView.status() == AccessorViewStatus::Valid);
+    REQUIRE(positionView.size() > 0);
+
+    for (int64_t i = 0; i < positionView.size(); ++i) {
+      CHECK(normalView[i] == glm::vec3(0.0f, 0.0f, 1.0f));
+
+      // The texture coordinates follow the positions they were created with.
+      const glm::vec3 p = positionView[i];
+      const glm::vec2 uv = texCoordView[i];
+      CHECK(uv.x == Approx(p.x / 1000.0f).margin(1e-4));
+      CHECK(uv.y == Approx(p.y / 1000.0f).margin(1e-4));
+    }
+  }
+
+  // Skirt vertices may fall outside the range of the quantized positions, so
+  // skirted positions are widened to floats.
+  SkirtMeshMetadata skirtMeshMetadata;
+  skirtMeshMetadata.noSkirtIndicesBegin = 0;
+  skirtMeshMetadata.noSkirtIndicesCount =
+      static_cast<uint32_t>(model.accessors[size_t(primitive.indices)].count);
+  skirtMeshMetadata.skirtWestHeight = 10.0;
+  skirtMeshMetadata.skirtSouthHeight = 10.0;
+  skirtMeshMetadata.skirtEastHeight = 10.0;
+  skirtMeshMetadata.skirtNorthHeight = 10.0;
+  primitive.extras = SkirtMeshMetadata::createGltfExtras(skirtMeshMetadata);
+
+  const Model skirted = upsampleGltfForRasterOverlays(
+      model,
+      CesiumGeometry::UpsampledQuadtreeNode{
+          CesiumGeometry::QuadtreeTileID(1, 0, 0)});
+  const MeshPrimitive& skirtedPrimitive = skirted.meshes[0].primitives[0];
+  CHECK(
+      skirted.accessors[size_t(skirtedPrimitive.attributes.at("POSITION"))]
+          .componentType == Accessor::ComponentType::FLOAT);
+  CHECK(
+      skirted.accessors[size_t(skirtedPrimitive.attributes.at("NORMAL"))]
+          .componentType == Accessor::ComponentType::BYTE);
+}
+
+TEST_CASE(
+    "Benchmark upsampling raster overlay children",
+    "[.][benchmark]") {
+  std::vector<float> coordinates(256);
+  for (size_t i = 0; i < coordinates.size(); ++i) {
+    coordinates[i] =
+        static_cast<float>(i) / static_cast<float>(coordinates.size() - 1);
+  }
+  const Model model = createGridModel(coordinates);
+  const CesiumGeometry::QuadtreeTileID parentID(0, 0, 0);
+
+  BENCHMARK("one child") {
+    return upsampleGltfForRasterOverlays(
+        model,
+        CesiumGeometry::UpsampledQuadtreeNode{
+            CesiumGeometry::QuadtreeTileID(1, 0, 0)});
+  };
+
+  // This is how Tile upsampled its children before they shared one pass.
+  BENCHMARK("four children, one at a time") {
+    std::array<Model, 4> children;
+    for (uint32_t i = 0; i < 4; ++i) {
+      children[i] = upsampleGltfForRasterOverlays(
+          model,
+          CesiumGeometry::UpsampledQuadtreeNode{
+              CesiumGeometry::QuadtreeTileID(1, i & 1U, i >> 1U)});
+    }
+    return children;
+  };
+
+  BENCHMARK("four children in one pass") {
+    return upsampleGltfForRasterOverlayChildren(model, parentID);
+  };
+}
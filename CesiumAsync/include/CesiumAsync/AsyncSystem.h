@@ -123,6 +123,33 @@ public:
             Impl::WithTracing<void>::end(tracingName, std::forward<Func>(f))));
   }
 
+  /**
+   * @brief Starts a function in a new worker thread task, returning a Future
+   * that resolves when the function completes.
+   *
+   * This is like {@link runInWorkerThread}, except that the function is
+   * always handed to the {@link ITaskProcessor}, even if this method is called
+   * from a worker thread. Use it to start work that should proceed
+   * concurrently with the calling worker rather than before it continues.
+   *
+   * @tparam Func The type of the function.
+   * @param f The function.
+   * @return A future that resolves after the supplied function completes.
+   */
+  template <typename Func>
+  Impl::ContinuationFutureType_t<Func, void>
+  startInWorkerThread(Func&& f) const {
+    static const char* tracingName = "waiting for worker thread";
+
+    CESIUM_TRACE_BEGIN_IN_TRACK(tracingName);
+
+    return Impl::ContinuationFutureType_t<Func, void>(
+        this->_pSchedulers,
+        async::spawn(
+            this->_pSchedulers->workerThread,
+            Impl::WithTracing<void>::end(tracingName, std::forward<Func>(f))));
+  }
+
   /**
    * @brief Runs a function in the main thread, returning a Future that
    * resolves when the function completes.
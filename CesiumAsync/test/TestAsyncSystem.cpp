@@ -89,6 +89,20 @@ TEST_CASE("AsyncSystem") {
     CHECK(executed2);
   }
 
+  SECTION("worker tasks started from a worker get their own task") {
+    std::atomic<bool> executed = false;
+
+    asyncSystem
+        .runInWorkerThread([asyncSystem, &executed]() {
+          return asyncSystem.startInWorkerThread(
+              [&executed]() { executed = true; });
+        })
+        .wait();
+
+    CHECK(pTaskProcessor->tasksStarted == 2);
+    CHECK(executed);
+  }
+
   SECTION("main thread continuations following a main thread task run "
           "immediately") {
     bool executed1 = false;
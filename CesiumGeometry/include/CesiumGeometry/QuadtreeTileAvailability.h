@@ -7,13 +7,20 @@
 
 #include <glm/vec2.hpp>
 
-#include <memory>
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace CesiumGeometry {
 
 /**
  * @brief Manages information about the availability of tiles in a quadtree.
+ *
+ * The available tiles of each level are kept as sorted bands of rows, each
+ * with the sorted ranges of columns that are available in it, so finding
+ * whether a tile is available at a level is a pair of binary searches.
+ * Each level also keeps the tiles that have available descendants, so that
+ * searching deeper levels stops as soon as there is nothing left to find.
  */
 class CESIUMGEOMETRY_API QuadtreeTileAvailability final {
 public:
@@ -26,16 +33,18 @@ public:
    */
   QuadtreeTileAvailability(
       const QuadtreeTilingScheme& tilingScheme,
-      uint32_t maximumLevel) noexcept;
+      uint32_t maximumLevel);
 
   /**
    * @brief Adds the specified range to the set of available tiles.
    *
+   * Ranges at levels above the maximum level given to the constructor are
+   * ignored.
+   *
    * @param range The {@link QuadtreeTileRectangularRange} that describes
    * the range of available tiles.
    */
-  void
-  addAvailableTileRange(const QuadtreeTileRectangularRange& range) noexcept;
+  void addAvailableTileRange(const QuadtreeTileRectangularRange& range);
 
   /**
    * @brief Computes the maximum level for the given 2D position.
@@ -64,56 +73,67 @@ public:
   bool isTileAvailable(const QuadtreeTileID& id) const noexcept;
 
 private:
-  struct RectangleWithLevel {
-    uint32_t level;
-    Rectangle rectangle;
+  /**
+   * @brief A range of columns, from `first` to `last` inclusive.
+   */
+  struct ColumnRange {
+    uint32_t first;
+    uint32_t last;
   };
 
-  struct QuadtreeNode {
-    QuadtreeNode(
-        const QuadtreeTileID& id_,
-        const Rectangle& extent_,
-        QuadtreeNode* pParent_) noexcept
-        : id(id_),
-          extent(extent_),
-          pParent(pParent_),
-          ll(),
-          lr(),
-          ul(),
-          ur(),
-          rectangles() {}
-
-    QuadtreeTileID id;
-
-    CesiumGeometry::Rectangle extent;
-
-    QuadtreeNode* pParent;
-    std::unique_ptr<QuadtreeNode> ll;
-    std::unique_ptr<QuadtreeNode> lr;
-    std::unique_ptr<QuadtreeNode> ul;
-    std::unique_ptr<QuadtreeNode> ur;
+  /**
+   * @brief A band of rows that all have the same columns.
+   *
+   * The band extends from `firstRow` to the row before the `firstRow` of the
+   * next band.
+   */
+  struct RowBand {
+    uint32_t firstRow;
+    std::vector<ColumnRange> columns;
+  };
 
-    std::vector<RectangleWithLevel> rectangles;
+  /**
+   * @brief The tiles of one level.
+   *
+   * Each set of tiles is kept as bands of rows sorted by their first row. The
+   * last band of a set that has any tiles has no columns, so that it ends the
+   * bands before it.
+   */
+  struct LevelAvailability {
+    /**
+     * @brief The tiles that are available.
+     */
+    std::vector<RowBand> tiles;
+
+    /**
+     * @brief The tiles that have an available descendant. A tile's center is
+     * only in a deeper available tile if one of the tiles of this set touches
+     * it, so this ends the search for such a tile early.
+     */
+    std::vector<RowBand> ancestorTiles;
   };
 
+  static void addTileRange(
+      std::vector<RowBand>& bands,
+      const QuadtreeTileRectangularRange& range);
+  static bool containsTile(
+      const std::vector<RowBand>& bands,
+      uint32_t x,
+      uint32_t y) noexcept;
+  static bool containsTileRange(
+      const std::vector<RowBand>& bands,
+      const QuadtreeTileRectangularRange& range) noexcept;
+  static size_t splitBandsAtRow(std::vector<RowBand>& bands, uint32_t row);
+  static void addColumnRange(
+      std::vector<ColumnRange>& columns,
+      const ColumnRange& range);
+  static void mergeEqualBands(
+      std::vector<RowBand>& bands,
+      size_t firstBand,
+      size_t lastBand) noexcept;
+
   QuadtreeTilingScheme _tilingScheme;
   uint32_t _maximumLevel;
-  std::vector<std::unique_ptr<QuadtreeNode>> _rootNodes;
-
-  static void putRectangleInQuadtree(
-      const QuadtreeTilingScheme& tilingScheme,
-      uint32_t maximumLevel,
-      QuadtreeTileAvailability::QuadtreeNode& node,
-      const QuadtreeTileAvailability::RectangleWithLevel& rectangle) noexcept;
-  static bool rectangleLevelComparator(
-      const QuadtreeTileAvailability::RectangleWithLevel& a,
-      const QuadtreeTileAvailability::RectangleWithLevel& b) noexcept;
-  static uint32_t findMaxLevelFromNode(
-      QuadtreeNode* pStopNode,
-      QuadtreeNode& node,
-      const glm::dvec2& position) noexcept;
-  static void createNodeChildrenIfNecessary(
-      QuadtreeNode& node,
-      const QuadtreeTilingScheme& tilingScheme) noexcept;
+  std::vector<LevelAvailability> _levels;
 };
 } // namespace CesiumGeometry
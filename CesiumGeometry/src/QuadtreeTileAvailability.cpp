@@ -1,230 +1,304 @@
 #include "CesiumGeometry/QuadtreeTileAvailability.h"
 
-#include <glm/common.hpp>
-
 #include <algorithm>
 
 namespace CesiumGeometry {
 
 QuadtreeTileAvailability::QuadtreeTileAvailability(
     const QuadtreeTilingScheme& tilingScheme,
-    uint32_t maximumLevel) noexcept
-    : _tilingScheme(tilingScheme),
-      _maximumLevel(maximumLevel),
-      _rootNodes(
-          this->_tilingScheme.getRootTilesX() *
-          this->_tilingScheme.getRootTilesY()) {
-  for (uint32_t j = 0; j < this->_tilingScheme.getRootTilesY(); ++j) {
-    const uint32_t rowStart = j * this->_tilingScheme.getRootTilesX();
-    for (uint32_t i = 0; i < this->_tilingScheme.getRootTilesX(); ++i) {
-      QuadtreeTileID id(0, i, j);
-      Rectangle extent = tilingScheme.tileToRectangle(id);
-      this->_rootNodes[rowStart + i] =
-          std::make_unique<QuadtreeNode>(id, extent, nullptr);
-    }
-  }
+    uint32_t maximumLevel)
+    : _tilingScheme(tilingScheme), _maximumLevel(maximumLevel), _levels() {
+  this->_levels.reserve(maximumLevel + 1);
 }
 
 void QuadtreeTileAvailability::addAvailableTileRange(
-    const QuadtreeTileRectangularRange& range) noexcept {
-  const Rectangle ll = this->_tilingScheme.tileToRectangle(
-      QuadtreeTileID(range.level, range.minimumX, range.minimumY));
-  const Rectangle ur = this->_tilingScheme.tileToRectangle(
-      QuadtreeTileID(range.level, range.maximumX, range.maximumY));
-
-  RectangleWithLevel rectangleWithLevel{
-      range.level,
-      Rectangle(ll.minimumX, ll.minimumY, ur.maximumX, ur.maximumY)};
-
-  for (const std::unique_ptr<QuadtreeNode>& pNode : this->_rootNodes) {
-    if (pNode->extent.overlaps(rectangleWithLevel.rectangle)) {
-      putRectangleInQuadtree(
-          this->_tilingScheme,
-          this->_maximumLevel,
-          *pNode,
-          rectangleWithLevel);
+    const QuadtreeTileRectangularRange& range) {
+  if (range.level > this->_maximumLevel || range.minimumX > range.maximumX ||
+      range.minimumY > range.maximumY) {
+    return;
+  }
+
+  if (range.level >= this->_levels.size()) {
+    this->_levels.resize(range.level + 1);
+  }
+
+  addTileRange(this->_levels[range.level].tiles, range);
+
+  // Record the ancestors of the range's tiles, stopping at the first level at
+  // which they're already known, because their own ancestors are too.
+  for (uint32_t level = range.level; level > 0; --level) {
+    const uint32_t shift = range.level - level + 1;
+    const QuadtreeTileRectangularRange ancestors{
+        level - 1,
+        range.minimumX >> shift,
+        range.minimumY >> shift,
+        range.maximumX >> shift,
+        range.maximumY >> shift};
+
+    std::vector<RowBand>& ancestorTiles =
+        this->_levels[level - 1].ancestorTiles;
+    if (containsTileRange(ancestorTiles, ancestors)) {
+      break;
     }
+    addTileRange(ancestorTiles, ancestors);
   }
 }
 
 uint32_t QuadtreeTileAvailability::computeMaximumLevelAtPosition(
     const glm::dvec2& position) const noexcept {
-  // Find the root node that contains this position.
-  for (const std::unique_ptr<QuadtreeNode>& pNode : this->_rootNodes) {
-    if (pNode->extent.contains(position)) {
-      return findMaxLevelFromNode(nullptr, *pNode, position);
+  const Rectangle& rectangle = this->_tilingScheme.getRectangle();
+  if (!rectangle.contains(position)) {
+    return 0;
+  }
+
+  const double distanceFromWest = position.x - rectangle.minimumX;
+  const double distanceFromSouth = position.y - rectangle.minimumY;
+
+  uint32_t maxLevel = 0;
+  for (size_t i = 0; i < this->_levels.size(); ++i) {
+    const uint32_t level = static_cast<uint32_t>(i);
+    const uint32_t xTiles =
+        this->_tilingScheme.getNumberOfXTilesAtLevel(level);
+    const uint32_t yTiles =
+        this->_tilingScheme.getNumberOfYTilesAtLevel(level);
+    const double x = distanceFromWest / (rectangle.computeWidth() / xTiles);
+    const double y = distanceFromSouth / (rectangle.computeHeight() / yTiles);
+
+    // A position on the boundary between two tiles is in both of them.
+    const uint32_t maxX = std::min(static_cast<uint32_t>(x), xTiles - 1);
+    const uint32_t maxY = std::min(static_cast<uint32_t>(y), yTiles - 1);
+    const uint32_t minX = maxX > 0 && double(maxX) == x ? maxX - 1 : maxX;
+    const uint32_t minY = maxY > 0 && double(maxY) == y ? maxY - 1 : maxY;
+
+    bool isAvailable = false;
+    bool hasAvailableDescendants = false;
+    for (uint32_t tileY = minY; tileY <= maxY; ++tileY) {
+      for (uint32_t tileX = minX; tileX <= maxX; ++tileX) {
+        isAvailable =
+            isAvailable || containsTile(this->_levels[i].tiles, tileX, tileY);
+        hasAvailableDescendants =
+            hasAvailableDescendants ||
+            containsTile(this->_levels[i].ancestorTiles, tileX, tileY);
+      }
+    }
+
+    if (isAvailable) {
+      maxLevel = level;
+    }
+    if (!hasAvailableDescendants) {
+      break;
     }
   }
 
-  return 0;
+  return maxLevel;
 }
 
 bool QuadtreeTileAvailability::isTileAvailable(
     const QuadtreeTileID& id) const noexcept {
-  // Get the center of the tile and find the maximum level at that position.
-  // Because availability is by tile, if the level is available at that point,
-  // it is sure to be available for the whole tile.  We assume that if a tile at
-  // level n exists, then all its parent tiles back to level 0 exist too.  This
-  // isn't really enforced anywhere, but Cesium would never load a tile for
-  // which this is not true.
-  const CesiumGeometry::Rectangle rectangle =
-      this->_tilingScheme.tileToRectangle(id);
-  const glm::dvec2 center = rectangle.getCenter();
-  return this->computeMaximumLevelAtPosition(center) >= id.level;
-}
+  // A tile is available if any tile at its level or deeper contains the tile's
+  // center. We assume that if a tile at level n exists, then all its parent
+  // tiles back to level 0 exist too.  This isn't really enforced anywhere, but
+  // Cesium would never load a tile for which this is not true.
+  if (id.level == 0) {
+    return true;
+  }
 
-/*static*/ void QuadtreeTileAvailability::putRectangleInQuadtree(
-    const QuadtreeTilingScheme& tilingScheme,
-    uint32_t maximumLevel,
-    QuadtreeTileAvailability::QuadtreeNode& node,
-    const QuadtreeTileAvailability::RectangleWithLevel& rectangle) noexcept {
-  QuadtreeNode* pNode = &node;
-
-  while (pNode->id.level < maximumLevel) {
-    createNodeChildrenIfNecessary(*pNode, tilingScheme);
-    if (pNode->ll && pNode->ll->extent.fullyContains(rectangle.rectangle)) {
-      pNode = pNode->ll.get();
-    } else if (
-        pNode->lr && pNode->lr->extent.fullyContains(rectangle.rectangle)) {
-      pNode = pNode->lr.get();
-    } else if (
-        pNode->ul && pNode->ul->extent.fullyContains(rectangle.rectangle)) {
-      pNode = pNode->ul.get();
-    } else if (
-        pNode->ur && pNode->ur->extent.fullyContains(rectangle.rectangle)) {
-      pNode = pNode->ur.get();
-    } else {
-      break;
+  if (id.level >= this->_levels.size()) {
+    return false;
+  }
+
+  const LevelAvailability& tileLevel = this->_levels[id.level];
+  if (containsTile(tileLevel.tiles, id.x, id.y)) {
+    return true;
+  }
+  if (!containsTile(tileLevel.ancestorTiles, id.x, id.y)) {
+    return false;
+  }
+
+  // At deeper levels, the center is the corner shared by four tiles, which
+  // are at the given column and row and the ones before them.
+  const auto touchesCorner = [](const std::vector<RowBand>& bands,
+                                uint32_t x,
+                                uint32_t y) {
+    return containsTile(bands, x - 1, y - 1) ||
+           containsTile(bands, x, y - 1) || containsTile(bands, x - 1, y) ||
+           containsTile(bands, x, y);
+  };
+
+  uint32_t x = id.x * 2 + 1;
+  uint32_t y = id.y * 2 + 1;
+  for (size_t level = id.level + 1; level < this->_levels.size(); ++level) {
+    const LevelAvailability& deeperLevel = this->_levels[level];
+    if (touchesCorner(deeperLevel.tiles, x, y)) {
+      return true;
+    }
+    if (!touchesCorner(deeperLevel.ancestorTiles, x, y)) {
+      return false;
     }
+
+    x *= 2;
+    y *= 2;
   }
 
-  if (pNode->rectangles.empty() ||
-      pNode->rectangles.back().level <= rectangle.level) {
-    pNode->rectangles.push_back(rectangle);
-  } else {
-    // Maintain ordering by level when inserting.
-    std::push_heap(
-        pNode->rectangles.begin(),
-        pNode->rectangles.end(),
-        QuadtreeTileAvailability::rectangleLevelComparator);
+  return false;
+}
+
+/*static*/ void QuadtreeTileAvailability::addTileRange(
+    std::vector<RowBand>& bands,
+    const QuadtreeTileRectangularRange& range) {
+  // Make sure the range's rows start and end bands of their own, so the
+  // range's columns can be added to exactly the bands that it covers.
+  const size_t firstBand = splitBandsAtRow(bands, range.minimumY);
+  const size_t endBand = range.maximumY < UINT32_MAX
+                             ? splitBandsAtRow(bands, range.maximumY + 1)
+                             : bands.size();
+
+  for (size_t i = firstBand; i < endBand; ++i) {
+    addColumnRange(
+        bands[i].columns,
+        ColumnRange{range.minimumX, range.maximumX});
   }
+
+  mergeEqualBands(bands, firstBand, endBand);
 }
 
-/*static*/ bool QuadtreeTileAvailability::rectangleLevelComparator(
-    const QuadtreeTileAvailability::RectangleWithLevel& a,
-    const QuadtreeTileAvailability::RectangleWithLevel& b) noexcept {
-  return a.level < b.level;
+/*static*/ bool QuadtreeTileAvailability::containsTile(
+    const std::vector<RowBand>& bands,
+    uint32_t x,
+    uint32_t y) noexcept {
+  auto bandIt = std::upper_bound(
+      bands.begin(),
+      bands.end(),
+      y,
+      [](uint32_t row, const RowBand& band) { return row < band.firstRow; });
+  if (bandIt == bands.begin()) {
+    return false;
+  }
+
+  const std::vector<ColumnRange>& columns = (bandIt - 1)->columns;
+  auto columnIt = std::upper_bound(
+      columns.begin(),
+      columns.end(),
+      x,
+      [](uint32_t column, const ColumnRange& range) {
+        return column < range.first;
+      });
+  return columnIt != columns.begin() && x <= (columnIt - 1)->last;
 }
 
-/*static*/ uint32_t QuadtreeTileAvailability::findMaxLevelFromNode(
-    QuadtreeTileAvailability::QuadtreeNode* pStopNode,
-    QuadtreeTileAvailability::QuadtreeNode& node,
-    const glm::dvec2& position) noexcept {
-  uint32_t maxLevel = 0;
-  QuadtreeTileAvailability::QuadtreeNode* pNode = &node;
-
-  // Find the deepest quadtree node containing this point.
-  bool found = false;
-  while (!found) {
-    const uint32_t ll =
-        pNode->ll && pNode->ll->extent.contains(position) ? 1 : 0;
-    const uint32_t lr =
-        pNode->lr && pNode->lr->extent.contains(position) ? 1 : 0;
-    const uint32_t ul =
-        pNode->ul && pNode->ul->extent.contains(position) ? 1 : 0;
-    const uint32_t ur =
-        pNode->ur && pNode->ur->extent.contains(position) ? 1 : 0;
-
-    // The common scenario is that the point is in only one quadrant and we can
-    // simply iterate down the tree.  But if the point is on a boundary between
-    // tiles, it is in multiple tiles and we need to check all of them, so use
-    // recursion.
-    if (ll + lr + ul + ur > 1) {
-      if (ll) {
-        maxLevel = glm::max(
-            maxLevel,
-            findMaxLevelFromNode(pNode, *pNode->ll, position));
-      }
-      if (lr) {
-        maxLevel = glm::max(
-            maxLevel,
-            findMaxLevelFromNode(pNode, *pNode->lr, position));
-      }
-      if (ul) {
-        maxLevel = glm::max(
-            maxLevel,
-            findMaxLevelFromNode(pNode, *pNode->ul, position));
-      }
-      if (ur) {
-        maxLevel = glm::max(
-            maxLevel,
-            findMaxLevelFromNode(pNode, *pNode->ur, position));
-      }
-      break;
-    }
-    if (ll) {
-      pNode = pNode->ll.get();
-    } else if (lr) {
-      pNode = pNode->lr.get();
-    } else if (ul) {
-      pNode = pNode->ul.get();
-    } else if (ur) {
-      pNode = pNode->ur.get();
-    } else {
-      found = true;
+/*static*/ bool QuadtreeTileAvailability::containsTileRange(
+    const std::vector<RowBand>& bands,
+    const QuadtreeTileRectangularRange& range) noexcept {
+  auto bandIt = std::upper_bound(
+      bands.begin(),
+      bands.end(),
+      range.minimumY,
+      [](uint32_t row, const RowBand& band) { return row < band.firstRow; });
+  if (bandIt == bands.begin()) {
+    return false;
+  }
+
+  for (--bandIt; bandIt != bands.end() && bandIt->firstRow <= range.maximumY;
+       ++bandIt) {
+    const std::vector<ColumnRange>& columns = bandIt->columns;
+    auto columnIt = std::upper_bound(
+        columns.begin(),
+        columns.end(),
+        range.minimumX,
+        [](uint32_t column, const ColumnRange& columnRange) {
+          return column < columnRange.first;
+        });
+    if (columnIt == columns.begin() ||
+        (columnIt - 1)->last < range.maximumX) {
+      return false;
     }
   }
 
-  // Wal up the tree until we find a rectangle that contains this point.
-  while (pNode != pStopNode) {
-    const std::vector<RectangleWithLevel>& rectangles = pNode->rectangles;
+  return true;
+}
 
-    // Rectangles are sorted by level, lowest first.
-    for (int32_t i = static_cast<int32_t>(rectangles.size()) - 1;
-         i >= 0 && rectangles[static_cast<size_t>(i)].level > maxLevel;
-         --i) {
-      const RectangleWithLevel& rectangle = rectangles[static_cast<size_t>(i)];
-      if (rectangle.rectangle.contains(position)) {
-        maxLevel = rectangle.level;
-      }
-    }
+/*static*/ size_t QuadtreeTileAvailability::splitBandsAtRow(
+    std::vector<RowBand>& bands,
+    uint32_t row) {
+  auto it = std::upper_bound(
+      bands.begin(),
+      bands.end(),
+      row,
+      [](uint32_t value, const RowBand& band) {
+        return value < band.firstRow;
+      });
 
-    pNode = pNode->pParent;
+  // Rows before the first band have no columns.
+  if (it == bands.begin()) {
+    bands.insert(it, RowBand{row, {}});
+    return 0;
   }
 
-  return maxLevel;
+  const size_t previous = static_cast<size_t>(it - bands.begin()) - 1;
+  if (bands[previous].firstRow == row) {
+    return previous;
+  }
+
+  std::vector<ColumnRange> columns = bands[previous].columns;
+  bands.insert(it, RowBand{row, std::move(columns)});
+  return previous + 1;
 }
 
-/*static*/ void QuadtreeTileAvailability::createNodeChildrenIfNecessary(
-    QuadtreeTileAvailability::QuadtreeNode& node,
-    const QuadtreeTilingScheme& tilingScheme) noexcept {
-  if (node.ll) {
+/*static*/ void QuadtreeTileAvailability::addColumnRange(
+    std::vector<ColumnRange>& columns,
+    const ColumnRange& range) {
+  // Find the ranges that overlap or touch the new one, and replace them with a
+  // single range that covers them all.
+  auto first = std::lower_bound(
+      columns.begin(),
+      columns.end(),
+      range,
+      [](const ColumnRange& existing, const ColumnRange& added) {
+        return uint64_t(existing.last) + 1 < added.first;
+      });
+  auto last = std::upper_bound(
+      first,
+      columns.end(),
+      range,
+      [](const ColumnRange& added, const ColumnRange& existing) {
+        return uint64_t(added.last) + 1 < existing.first;
+      });
+
+  if (first == last) {
+    columns.insert(first, range);
     return;
   }
 
-  QuadtreeTileID llID(node.id.level + 1, node.id.x * 2, node.id.y * 2);
-  node.ll = std::make_unique<QuadtreeNode>(
-      llID,
-      tilingScheme.tileToRectangle(llID),
-      &node);
-
-  QuadtreeTileID lrID(llID.level, llID.x + 1, llID.y);
-  node.lr = std::make_unique<QuadtreeNode>(
-      lrID,
-      tilingScheme.tileToRectangle(lrID),
-      &node);
-
-  QuadtreeTileID ulID(llID.level, llID.x, llID.y + 1);
-  node.ul = std::make_unique<QuadtreeNode>(
-      ulID,
-      tilingScheme.tileToRectangle(ulID),
-      &node);
-
-  QuadtreeTileID urID(llID.level, llID.x + 1, llID.y + 1);
-  node.ur = std::make_unique<QuadtreeNode>(
-      urID,
-      tilingScheme.tileToRectangle(urID),
-      &node);
+  first->first = std::min(first->first, range.first);
+  first->last = std::max((last - 1)->last, range.last);
+  columns.erase(first + 1, last);
+}
+
+/*static*/ void QuadtreeTileAvailability::mergeEqualBands(
+    std::vector<RowBand>& bands,
+    size_t firstBand,
+    size_t lastBand) noexcept {
+  const auto isSameColumns = [](const RowBand& a, const RowBand& b) {
+    return std::equal(
+        a.columns.begin(),
+        a.columns.end(),
+        b.columns.begin(),
+        b.columns.end(),
+        [](const ColumnRange& ca, const ColumnRange& cb) {
+          return ca.first == cb.first && ca.last == cb.last;
+        });
+  };
+
+  size_t i = std::max<size_t>(firstBand, 1);
+  size_t last = std::min(lastBand, bands.size() - 1);
+  while (i <= last) {
+    if (isSameColumns(bands[i - 1], bands[i])) {
+      bands.erase(bands.begin() + static_cast<std::ptrdiff_t>(i));
+      --last;
+    } else {
+      ++i;
+    }
+  }
 }
 
 } // namespace CesiumGeometry
@@ -0,0 +1,389 @@
+#include "CesiumGeometry/QuadtreeTileAvailability.h"
+
+#include <catch2/catch.hpp>
+#include <glm/common.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace CesiumGeometry;
+
+namespace {
+
+/**
+ * @brief The availability of tiles as a tree of rectangles, which is how
+ * QuadtreeTileAvailability used to store it. This is used to check the results
+ * of the compact availability, and to compare their performance.
+ */
+class RectangleTreeAvailability {
+public:
+  RectangleTreeAvailability(
+      const QuadtreeTilingScheme& tilingScheme,
+      uint32_t maximumLevel)
+      : _tilingScheme(tilingScheme), _maximumLevel(maximumLevel) {
+    for (uint32_t j = 0; j < tilingScheme.getRootTilesY(); ++j) {
+      for (uint32_t i = 0; i < tilingScheme.getRootTilesX(); ++i) {
+        const QuadtreeTileID id(0, i, j);
+        this->_rootNodes.emplace_back(std::make_unique<Node>(
+            Node{id, tilingScheme.tileToRectangle(id), {}, {}}));
+      }
+    }
+  }
+
+  void addAvailableTileRange(const QuadtreeTileRectangularRange& range) {
+    const Rectangle ll = this->_tilingScheme.tileToRectangle(
+        QuadtreeTileID(range.level, range.minimumX, range.minimumY));
+    const Rectangle ur = this->_tilingScheme.tileToRectangle(
+        QuadtreeTileID(range.level, range.maximumX, range.maximumY));
+    const RectangleWithLevel rectangle{
+        range.level,
+        Rectangle(ll.minimumX, ll.minimumY, ur.maximumX, ur.maximumY)};
+
+    for (const std::unique_ptr<Node>& pRoot : this->_rootNodes) {
+      if (!pRoot->extent.overlaps(rectangle.rectangle)) {
+        continue;
+      }
+
+      Node* pNode = pRoot.get();
+      while (pNode->id.level < this->_maximumLevel) {
+        this->createChildren(*pNode);
+        Node* pChild = nullptr;
+        for (const std::unique_ptr<Node>& pCandidate : pNode->children) {
+          if (pCandidate->extent.fullyContains(rectangle.rectangle)) {
+            pChild = pCandidate.get();
+            break;
+          }
+        }
+        if (!pChild) {
+          break;
+        }
+        pNode = pChild;
+      }
+
+      pNode->rectangles.push_back(rectangle);
+      std::stable_sort(
+          pNode->rectangles.begin(),
+          pNode->rectangles.end(),
+          [](const RectangleWithLevel& a, const RectangleWithLevel& b) {
+            return a.level < b.level;
+          });
+    }
+  }
+
+  uint32_t computeMaximumLevelAtPosition(const glm::dvec2& position) const {
+    for (const std::unique_ptr<Node>& pRoot : this->_rootNodes) {
+      if (pRoot->extent.contains(position)) {
+        return findMaxLevel(*pRoot, position);
+      }
+    }
+    return 0;
+  }
+
+  bool isTileAvailable(const QuadtreeTileID& id) const {
+    const Rectangle rectangle = this->_tilingScheme.tileToRectangle(id);
+    return this->computeMaximumLevelAtPosition(rectangle.getCenter()) >=
+           id.level;
+  }
+
+private:
+  struct RectangleWithLevel {
+    uint32_t level;
+    Rectangle rectangle;
+  };
+
+  struct Node {
+    QuadtreeTileID id;
+    Rectangle extent;
+    std::vector<std::unique_ptr<Node>> children;
+    std::vector<RectangleWithLevel> rectangles;
+  };
+
+  void createChildren(Node& node) const {
+    if (!node.children.empty()) {
+      return;
+    }
+
+    for (uint32_t i = 0; i < 4; ++i) {
+      const QuadtreeTileID id(
+          node.id.level + 1,
+          node.id.x * 2 + (i & 1),
+          node.id.y * 2 + (i >> 1));
+      node.children.emplace_back(std::make_unique<Node>(
+          Node{id, this->_tilingScheme.tileToRectangle(id), {}, {}}));
+    }
+  }
+
+  static uint32_t findMaxLevel(const Node& node, const glm::dvec2& position) {
+    uint32_t maxLevel = 0;
+    for (const RectangleWithLevel& rectangle : node.rectangles) {
+      if (rectangle.level > maxLevel &&
+          rectangle.rectangle.contains(position)) {
+        maxLevel = rectangle.level;
+      }
+    }
+    for (const std::unique_ptr<Node>& pChild : node.children) {
+      if (pChild->extent.contains(position)) {
+        maxLevel = glm::max(maxLevel, findMaxLevel(*pChild, position));
+      }
+    }
+    return maxLevel;
+  }
+
+  QuadtreeTilingScheme _tilingScheme;
+  uint32_t _maximumLevel;
+  std::vector<std::unique_ptr<Node>> _rootNodes;
+};
+
+uint32_t randomBelow(std::mt19937& random, uint32_t count) {
+  return static_cast<uint32_t>(random() % count);
+}
+
+QuadtreeTilingScheme createTilingScheme() {
+  return QuadtreeTilingScheme(Rectangle(-180.0, -90.0, 180.0, 90.0), 2, 1);
+}
+
+/**
+ * @brief Creates ranges at random places, which may or may not overlap the
+ * ranges of other levels.
+ */
+std::vector<QuadtreeTileRectangularRange> createRandomRanges(
+    const QuadtreeTilingScheme& tilingScheme,
+    uint32_t maximumLevel) {
+  std::mt19937 random(42);
+  std::vector<QuadtreeTileRectangularRange> ranges;
+  for (uint32_t level = 0; level <= maximumLevel; ++level) {
+    const uint32_t xTiles = tilingScheme.getNumberOfXTilesAtLevel(level);
+    const uint32_t yTiles = tilingScheme.getNumberOfYTilesAtLevel(level);
+    const uint32_t count = level < 4 ? 1 : 8 * level;
+    for (uint32_t i = 0; i < count; ++i) {
+      const uint32_t minimumX = randomBelow(random, xTiles);
+      const uint32_t minimumY = randomBelow(random, yTiles);
+      const uint32_t width =
+          1 + randomBelow(random, glm::max(xTiles / 16, 1U));
+      const uint32_t height =
+          1 + randomBelow(random, glm::max(yTiles / 16, 1U));
+      ranges.push_back(QuadtreeTileRectangularRange{
+          level,
+          minimumX,
+          minimumY,
+          glm::min(minimumX + width, xTiles) - 1,
+          glm::min(minimumY + height, yTiles) - 1});
+    }
+  }
+  return ranges;
+}
+
+/**
+ * @brief Creates ranges like those of a terrain layer.json, in which the first
+ * few levels are complete and the ranges of each deeper level are within
+ * those of the level above it.
+ */
+std::vector<QuadtreeTileRectangularRange> createTerrainRanges(
+    const QuadtreeTilingScheme& tilingScheme,
+    uint32_t maximumLevel) {
+  std::mt19937 random(42);
+  std::vector<QuadtreeTileRectangularRange> ranges;
+  size_t parentBegin = 0;
+  for (uint32_t level = 0; level <= maximumLevel; ++level) {
+    const size_t parentEnd = ranges.size();
+    if (level < 4) {
+      ranges.push_back(QuadtreeTileRectangularRange{
+          level,
+          0,
+          0,
+          tilingScheme.getNumberOfXTilesAtLevel(level) - 1,
+          tilingScheme.getNumberOfYTilesAtLevel(level) - 1});
+    } else {
+      for (size_t i = parentBegin; i < parentEnd; ++i) {
+        const QuadtreeTileRectangularRange parent = ranges[i];
+        const uint32_t width = (parent.maximumX - parent.minimumX + 1) * 2;
+        const uint32_t height = (parent.maximumY - parent.minimumY + 1) * 2;
+        const uint32_t count = randomBelow(random, 5) < 4 ? 2 : 0;
+        for (uint32_t j = 0; j < count; ++j) {
+          const uint32_t minimumX =
+              parent.minimumX * 2 + randomBelow(random, width);
+          const uint32_t minimumY =
+              parent.minimumY * 2 + randomBelow(random, height);
+          const uint32_t maximumX = glm::min(
+              minimumX + randomBelow(random, width),
+              parent.maximumX * 2 + 1);
+          const uint32_t maximumY = glm::min(
+              minimumY + randomBelow(random, height),
+              parent.maximumY * 2 + 1);
+          ranges.push_back(QuadtreeTileRectangularRange{
+              level,
+              minimumX,
+              minimumY,
+              maximumX,
+              maximumY});
+        }
+      }
+    }
+    parentBegin = parentEnd;
+  }
+  return ranges;
+}
+
+} // namespace
+
+TEST_CASE("QuadtreeTileAvailability") {
+  const QuadtreeTilingScheme tilingScheme = createTilingScheme();
+  QuadtreeTileAvailability availability(tilingScheme, 10);
+
+  SECTION("has only the level 0 tiles when nothing is available") {
+    CHECK(availability.isTileAvailable(QuadtreeTileID(0, 0, 0)));
+    CHECK(!availability.isTileAvailable(QuadtreeTileID(1, 0, 0)));
+    CHECK(
+        availability.computeMaximumLevelAtPosition(glm::dvec2(0.0, 0.0)) == 0);
+  }
+
+  SECTION("finds the tiles in overlapping and adjacent ranges") {
+    availability.addAvailableTileRange({2, 0, 0, 3, 1});
+    availability.addAvailableTileRange({2, 2, 1, 5, 3});
+    availability.addAvailableTileRange({2, 6, 2, 7, 2});
+
+    CHECK(availability.isTileAvailable(QuadtreeTileID(2, 0, 0)));
+    CHECK(availability.isTileAvailable(QuadtreeTileID(2, 3, 1)));
+    CHECK(availability.isTileAvailable(QuadtreeTileID(2, 5, 3)));
+    CHECK(availability.isTileAvailable(QuadtreeTileID(2, 7, 2)));
+    CHECK(!availability.isTileAvailable(QuadtreeTileID(2, 0, 2)));
+    CHECK(!availability.isTileAvailable(QuadtreeTileID(2, 6, 3)));
+    CHECK(!availability.isTileAvailable(QuadtreeTileID(2, 7, 1)));
+  }
+
+  SECTION("treats a tile that contains a deeper tile's corner as available") {
+    availability.addAvailableTileRange({3, 2, 2, 2, 2});
+
+    // The center of tile (1, 0, 0) is the corner of tile (3, 2, 2).
+    CHECK(availability.isTileAvailable(QuadtreeTileID(1, 0, 0)));
+    CHECK(!availability.isTileAvailable(QuadtreeTileID(2, 0, 0)));
+    CHECK(!availability.isTileAvailable(QuadtreeTileID(1, 1, 0)));
+  }
+
+  SECTION("computes the maximum level at tile boundaries") {
+    availability.addAvailableTileRange({1, 0, 0, 0, 0});
+    availability.addAvailableTileRange({2, 2, 0, 2, 0});
+
+    // The west edge of tile (2, 2, 0) is the east edge of tile (1, 0, 0).
+    CHECK(
+        availability.computeMaximumLevelAtPosition(glm::dvec2(-90.0, -60.0)) ==
+        2);
+    CHECK(
+        availability.computeMaximumLevelAtPosition(glm::dvec2(-100.0, -60.0)) ==
+        1);
+    CHECK(
+        availability.computeMaximumLevelAtPosition(glm::dvec2(200.0, 0.0)) ==
+        0);
+  }
+
+  SECTION("ignores ranges above the maximum level") {
+    availability.addAvailableTileRange({11, 0, 0, 0, 0});
+    availability.addAvailableTileRange({0xffffffff, 0, 0, 0, 0});
+
+    CHECK(!availability.isTileAvailable(QuadtreeTileID(1, 0, 0)));
+    CHECK(!availability.isTileAvailable(QuadtreeTileID(11, 0, 0)));
+    CHECK(
+        availability.computeMaximumLevelAtPosition(glm::dvec2(-180.0, -90.0)) ==
+        0);
+  }
+}
+
+TEST_CASE("QuadtreeTileAvailability matches a tree of rectangles") {
+  const QuadtreeTilingScheme tilingScheme = createTilingScheme();
+  const uint32_t maximumLevel = 12;
+  QuadtreeTileAvailability availability(tilingScheme, maximumLevel);
+  RectangleTreeAvailability expected(tilingScheme, maximumLevel);
+
+  const std::vector<QuadtreeTileRectangularRange> ranges = GENERATE_COPY(
+      createRandomRanges(tilingScheme, maximumLevel),
+      createTerrainRanges(tilingScheme, maximumLevel));
+  for (const QuadtreeTileRectangularRange& range : ranges) {
+    availability.addAvailableTileRange(range);
+    expected.addAvailableTileRange(range);
+  }
+
+  std::mt19937 random(7);
+  for (uint32_t i = 0; i < 10000; ++i) {
+    const uint32_t level = randomBelow(random, maximumLevel + 1);
+    const QuadtreeTileID id(
+        level,
+        randomBelow(random, tilingScheme.getNumberOfXTilesAtLevel(level)),
+        randomBelow(random, tilingScheme.getNumberOfYTilesAtLevel(level)));
+    CHECK(availability.isTileAvailable(id) == expected.isTileAvailable(id));
+
+    const glm::dvec2 position(
+        std::uniform_real_distribution<double>(-180.0, 180.0)(random),
+        std::uniform_real_distribution<double>(-90.0, 90.0)(random));
+    CHECK(
+        availability.computeMaximumLevelAtPosition(position) ==
+        expected.computeMaximumLevelAtPosition(position));
+  }
+}
+
+TEST_CASE("Benchmark QuadtreeTileAvailability", "[.][benchmark]") {
+  const QuadtreeTilingScheme tilingScheme = createTilingScheme();
+  const uint32_t maximumLevel = 16;
+  const std::vector<QuadtreeTileRectangularRange> ranges =
+      createTerrainRanges(tilingScheme, maximumLevel);
+
+  QuadtreeTileAvailability availability(tilingScheme, maximumLevel);
+  RectangleTreeAvailability tree(tilingScheme, maximumLevel);
+  for (const QuadtreeTileRectangularRange& range : ranges) {
+    availability.addAvailableTileRange(range);
+    tree.addAvailableTileRange(range);
+  }
+
+  // Like the terrain tiles that are created for the children of available
+  // tiles, query the children of tiles in random ranges.
+  std::mt19937 random(7);
+  std::vector<QuadtreeTileID> ids;
+  for (uint32_t i = 0; i < 1000; ++i) {
+    const QuadtreeTileRectangularRange& range =
+        ranges[randomBelow(random, static_cast<uint32_t>(ranges.size()))];
+    const uint32_t x =
+        range.minimumX +
+        randomBelow(random, range.maximumX - range.minimumX + 1);
+    const uint32_t y =
+        range.minimumY +
+        randomBelow(random, range.maximumY - range.minimumY + 1);
+    for (uint32_t j = 0; j < 4; ++j) {
+      ids.emplace_back(range.level + 1, x * 2 + (j & 1), y * 2 + (j >> 1));
+    }
+  }
+
+  BENCHMARK("add ranges, compact") {
+    QuadtreeTileAvailability result(tilingScheme, maximumLevel);
+    for (const QuadtreeTileRectangularRange& range : ranges) {
+      result.addAvailableTileRange(range);
+    }
+    return result;
+  };
+
+  BENCHMARK("add ranges, rectangle tree") {
+    auto pResult = std::make_unique<RectangleTreeAvailability>(
+        tilingScheme,
+        maximumLevel);
+    for (const QuadtreeTileRectangularRange& range : ranges) {
+      pResult->addAvailableTileRange(range);
+    }
+    return pResult;
+  };
+
+  BENCHMARK("isTileAvailable, compact") {
+    uint32_t count = 0;
+    for (const QuadtreeTileID& id : ids) {
+      count += availability.isTileAvailable(id) ? 1U : 0U;
+    }
+    return count;
+  };
+
+  BENCHMARK("isTileAvailable, rectangle tree") {
+    uint32_t count = 0;
+    for (const QuadtreeTileID& id : ids) {
+      count += tree.isTileAvailable(id) ? 1U : 0U;
+    }
+    return count;
+  };
+}
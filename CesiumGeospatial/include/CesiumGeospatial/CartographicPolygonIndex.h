@@ -0,0 +1,144 @@
+#pragma once
+
+#include "CartographicPolygon.h"
+#include "GlobeRectangle.h"
+#include "Library.h"
+
+#include <CesiumGeometry/Rectangle.h>
+
+#include <glm/vec2.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace CesiumGeospatial {
+
+/**
+ * @brief A spatial index over the triangles and edges of a set of
+ * {@link CartographicPolygon} instances.
+ *
+ * The triangles and edges are bulk-loaded into packed R-trees, so queries
+ * against a {@link GlobeRectangle} visit only the parts of the polygons near
+ * that rectangle rather than every triangle.
+ *
+ * Longitudes within each polygon are unwrapped relative to the polygon's first
+ * vertex, so polygons crossing the antimeridian are contiguous in the index
+ * and may extend outside the range [-PI, PI].
+ */
+class CESIUMGEOSPATIAL_API CartographicPolygonIndex final {
+public:
+  /**
+   * @brief A triangle of one of the indexed polygons.
+   */
+  struct Triangle {
+    /**
+     * @brief The first vertex of the triangle, as longitude and latitude in
+     * radians.
+     */
+    glm::dvec2 a;
+
+    /**
+     * @brief The second vertex of the triangle, as longitude and latitude in
+     * radians.
+     */
+    glm::dvec2 b;
+
+    /**
+     * @brief The third vertex of the triangle, as longitude and latitude in
+     * radians.
+     */
+    glm::dvec2 c;
+
+    /**
+     * @brief The index of the polygon that this triangle belongs to.
+     */
+    size_t polygonIndex;
+  };
+
+  /**
+   * @brief Constructs an empty index.
+   */
+  CartographicPolygonIndex() = default;
+
+  /**
+   * @brief Constructs an index over the given polygons.
+   *
+   * @param polygons The polygons to index.
+   */
+  explicit CartographicPolygonIndex(
+      const std::vector<CartographicPolygon>& polygons);
+
+  /**
+   * @brief Determines whether the given rectangle is entirely inside any one
+   * of the indexed polygons.
+   *
+   * @param rectangle The rectangle to test.
+   * @return true if the rectangle is inside a polygon.
+   */
+  bool contains(const GlobeRectangle& rectangle) const noexcept;
+
+  /**
+   * @brief Determines whether the bounding rectangle of any triangle of the
+   * indexed polygons overlaps the given rectangle.
+   *
+   * This is conservative: it may return true for a rectangle that lies close
+   * to, but outside, every polygon.
+   *
+   * @param rectangle The rectangle to test.
+   * @return true if the rectangle may overlap a polygon.
+   */
+  bool intersects(const GlobeRectangle& rectangle) const noexcept;
+
+  /**
+   * @brief Finds the triangles whose bounding rectangles overlap the given
+   * rectangle.
+   *
+   * The returned triangles are shifted by a multiple of 2*PI in longitude so
+   * that they are expressed relative to the rectangle, in which longitude
+   * increases continuously from `rectangle.getWest()` to
+   * `rectangle.getWest() + rectangle.computeWidth()`. A triangle may be
+   * returned twice, with different shifts, when the rectangle spans more than
+   * half of the globe.
+   *
+   * @param rectangle The rectangle to query.
+   * @param result The vector to which the triangles are appended.
+   */
+  void findTriangles(
+      const GlobeRectangle& rectangle,
+      std::vector<Triangle>& result) const;
+
+  /**
+   * @brief Gets all of the indexed triangles, in the order they are stored in
+   * the index.
+   */
+  const std::vector<Triangle>& getTriangles() const noexcept {
+    return this->_triangles;
+  }
+
+private:
+  /**
+   * @brief An edge of the perimeter of one of the indexed polygons.
+   */
+  struct Edge {
+    glm::dvec2 a;
+    glm::dvec2 b;
+    size_t polygonIndex;
+  };
+
+  /**
+   * @brief A packed R-tree. The nodes of each level are stored contiguously,
+   * starting with the leaves, and each node covers up to a fixed number of
+   * consecutive entries of the level below it.
+   */
+  struct Tree {
+    std::vector<CesiumGeometry::Rectangle> nodes;
+    std::vector<size_t> levelOffsets;
+  };
+
+  std::vector<Triangle> _triangles;
+  Tree _triangleTree;
+  std::vector<Edge> _edges;
+  Tree _edgeTree;
+};
+
+} // namespace CesiumGeospatial
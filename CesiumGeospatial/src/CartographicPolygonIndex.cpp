@@ -0,0 +1,432 @@
+#include "CesiumGeospatial/CartographicPolygonIndex.h"
+
+#include <CesiumUtility/Math.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+using namespace CesiumGeometry;
+using namespace CesiumUtility;
+
+namespace CesiumGeospatial {
+
+namespace {
+
+// The maximum number of entries covered by a single node of a packed R-tree.
+constexpr size_t NODE_SIZE = 16;
+
+// The size of the grid on which the Hilbert curve used to order the entries is
+// evaluated.
+constexpr uint32_t HILBERT_SIZE = 1U << 16;
+
+// Enough for any tree that can be indexed with a size_t: each visited level
+// leaves at most NODE_SIZE - 1 siblings on the stack.
+constexpr size_t MAXIMUM_STACK_SIZE = 16 * NODE_SIZE;
+
+// The longitude shifts that bring unwrapped polygon longitudes, which are
+// within 2*PI of zero, into the frame of a rectangle whose west edge is in
+// [-PI, PI].
+constexpr std::array<double, 3> LONGITUDE_SHIFTS{
+    -Math::TWO_PI,
+    0.0,
+    Math::TWO_PI};
+
+Rectangle computeBounds(const CartographicPolygonIndex::Triangle& triangle) {
+  return Rectangle(
+      glm::min(triangle.a.x, glm::min(triangle.b.x, triangle.c.x)),
+      glm::min(triangle.a.y, glm::min(triangle.b.y, triangle.c.y)),
+      glm::max(triangle.a.x, glm::max(triangle.b.x, triangle.c.x)),
+      glm::max(triangle.a.y, glm::max(triangle.b.y, triangle.c.y)));
+}
+
+template <typename TEdge> Rectangle computeBounds(const TEdge& edge) {
+  return Rectangle(
+      glm::min(edge.a.x, edge.b.x),
+      glm::min(edge.a.y, edge.b.y),
+      glm::max(edge.a.x, edge.b.x),
+      glm::max(edge.a.y, edge.b.y));
+}
+
+Rectangle computeUnion(const Rectangle& lhs, const Rectangle& rhs) {
+  return Rectangle(
+      glm::min(lhs.minimumX, rhs.minimumX),
+      glm::min(lhs.minimumY, rhs.minimumY),
+      glm::max(lhs.maximumX, rhs.maximumX),
+      glm::max(lhs.maximumY, rhs.maximumY));
+}
+
+bool overlaps(const Rectangle& lhs, const Rectangle& rhs) {
+  return lhs.minimumX <= rhs.maximumX && rhs.minimumX <= lhs.maximumX &&
+         lhs.minimumY <= rhs.maximumY && rhs.minimumY <= lhs.maximumY;
+}
+
+uint32_t computeHilbertIndex(uint32_t x, uint32_t y) {
+  uint32_t index = 0;
+  for (uint32_t s = HILBERT_SIZE / 2; s > 0; s /= 2) {
+    const uint32_t rx = (x & s) > 0 ? 1U : 0U;
+    const uint32_t ry = (y & s) > 0 ? 1U : 0U;
+    index += s * s * ((3U * rx) ^ ry);
+
+    // rotate the quadrant
+    if (ry == 0) {
+      if (rx == 1) {
+        x = HILBERT_SIZE - 1 - x;
+        y = HILBERT_SIZE - 1 - y;
+      }
+      std::swap(x, y);
+    }
+  }
+  return index;
+}
+
+std::vector<glm::dvec2>
+unwrapVertices(const std::vector<glm::dvec2>& vertices) {
+  std::vector<glm::dvec2> result(vertices.size());
+  if (vertices.empty()) {
+    return result;
+  }
+
+  // normalize the longitude relative to the first point, the same way the
+  // polygon is triangulated
+  const double longitude0 = vertices[0].x;
+  for (size_t i = 0; i < vertices.size(); ++i) {
+    double longitude = vertices[i].x - longitude0;
+    if (glm::abs(longitude) > Math::ONE_PI) {
+      longitude += longitude > 0.0 ? -Math::TWO_PI : Math::TWO_PI;
+    }
+    result[i] = glm::dvec2(longitude0 + longitude, vertices[i].y);
+  }
+
+  return result;
+}
+
+bool isInsideTriangle(
+    const glm::dvec2& point,
+    const CartographicPolygonIndex::Triangle& triangle) {
+  const glm::dvec2& a = triangle.a;
+  const glm::dvec2& b = triangle.b;
+  const glm::dvec2& c = triangle.c;
+
+  const double ab =
+      (b.x - a.x) * (point.y - a.y) - (b.y - a.y) * (point.x - a.x);
+  const double bc =
+      (c.x - b.x) * (point.y - b.y) - (c.y - b.y) * (point.x - b.x);
+  const double ca =
+      (a.x - c.x) * (point.y - c.y) - (a.y - c.y) * (point.x - c.x);
+
+  // This will determine in or out, irrespective of winding.
+  return (ab >= 0.0 && bc >= 0.0 && ca >= 0.0) ||
+         (ab <= 0.0 && bc <= 0.0 && ca <= 0.0);
+}
+
+// Clips the segment from a to b against the rectangle, Liang-Barsky style, and
+// returns whether any part of it remains.
+bool segmentIntersectsRectangle(
+    const glm::dvec2& a,
+    const glm::dvec2& b,
+    const Rectangle& rectangle) {
+  const glm::dvec2 direction = b - a;
+  double tMin = 0.0;
+  double tMax = 1.0;
+
+  const auto clip = [&tMin, &tMax](double denominator, double numerator) {
+    if (denominator == 0.0) {
+      return numerator >= 0.0;
+    }
+
+    const double t = numerator / denominator;
+    if (denominator > 0.0) {
+      tMax = glm::min(tMax, t);
+    } else {
+      tMin = glm::max(tMin, t);
+    }
+    return tMin <= tMax;
+  };
+
+  return clip(direction.x, rectangle.maximumX - a.x) &&
+         clip(-direction.x, a.x - rectangle.minimumX) &&
+         clip(direction.y, rectangle.maximumY - a.y) &&
+         clip(-direction.y, a.y - rectangle.minimumY);
+}
+
+} // namespace
+
+// Sorts the items along a Hilbert curve and packs them, and then each level of
+// nodes, into nodes of NODE_SIZE entries.
+template <typename TItem, typename TTree>
+static TTree buildTree(std::vector<TItem>& items) {
+  TTree tree;
+  if (items.empty()) {
+    return tree;
+  }
+
+  std::vector<Rectangle> bounds(items.size());
+  Rectangle extent = computeBounds(items[0]);
+  for (size_t i = 0; i < items.size(); ++i) {
+    bounds[i] = computeBounds(items[i]);
+    extent = computeUnion(extent, bounds[i]);
+  }
+
+  const double scaleX =
+      extent.computeWidth() > 0.0
+          ? double(HILBERT_SIZE - 1) / extent.computeWidth()
+          : 0.0;
+  const double scaleY =
+      extent.computeHeight() > 0.0
+          ? double(HILBERT_SIZE - 1) / extent.computeHeight()
+          : 0.0;
+
+  std::vector<std::pair<uint32_t, size_t>> order(items.size());
+  for (size_t i = 0; i < items.size(); ++i) {
+    const glm::dvec2 center = bounds[i].getCenter();
+    order[i].first = computeHilbertIndex(
+        uint32_t((center.x - extent.minimumX) * scaleX),
+        uint32_t((center.y - extent.minimumY) * scaleY));
+    order[i].second = i;
+  }
+  std::sort(order.begin(), order.end());
+
+  std::vector<TItem> sortedItems;
+  sortedItems.reserve(items.size());
+  for (const std::pair<uint32_t, size_t>& entry : order) {
+    sortedItems.emplace_back(std::move(items[entry.second]));
+  }
+  items = std::move(sortedItems);
+
+  tree.levelOffsets.emplace_back(0);
+  for (size_t i = 0; i < order.size(); i += NODE_SIZE) {
+    Rectangle node = bounds[order[i].second];
+    const size_t end = std::min(i + NODE_SIZE, order.size());
+    for (size_t j = i + 1; j < end; ++j) {
+      node = computeUnion(node, bounds[order[j].second]);
+    }
+    tree.nodes.emplace_back(node);
+  }
+
+  size_t levelBegin = 0;
+  size_t levelEnd = tree.nodes.size();
+  while (levelEnd - levelBegin > 1) {
+    tree.levelOffsets.emplace_back(levelEnd);
+    for (size_t i = levelBegin; i < levelEnd; i += NODE_SIZE) {
+      Rectangle node = tree.nodes[i];
+      const size_t end = std::min(i + NODE_SIZE, levelEnd);
+      for (size_t j = i + 1; j < end; ++j) {
+        node = computeUnion(node, tree.nodes[j]);
+      }
+      tree.nodes.emplace_back(node);
+    }
+    levelBegin = levelEnd;
+    levelEnd = tree.nodes.size();
+  }
+
+  return tree;
+}
+
+// Invokes the callback with the index of each item in a leaf node overlapping
+// the rectangle, until the callback returns false. Returns false if the
+// callback stopped the traversal.
+template <typename TTree, typename TCallback>
+static bool visitTree(
+    const TTree& tree,
+    size_t itemCount,
+    const Rectangle& rectangle,
+    TCallback&& callback) {
+  if (tree.nodes.empty()) {
+    return true;
+  }
+
+  std::array<std::pair<size_t, size_t>, MAXIMUM_STACK_SIZE> stack;
+  size_t stackSize = 0;
+  stack[stackSize++] = {tree.levelOffsets.size() - 1, tree.nodes.size() - 1};
+
+  while (stackSize > 0) {
+    const auto [level, node] = stack[--stackSize];
+    if (!overlaps(tree.nodes[node], rectangle)) {
+      continue;
+    }
+
+    const size_t first = (node - tree.levelOffsets[level]) * NODE_SIZE;
+    if (level == 0) {
+      const size_t end = std::min(first + NODE_SIZE, itemCount);
+      for (size_t item = first; item < end; ++item) {
+        if (!callback(item)) {
+          return false;
+        }
+      }
+    } else {
+      const size_t childOffset = tree.levelOffsets[level - 1];
+      const size_t end =
+          std::min(childOffset + first + NODE_SIZE, tree.levelOffsets[level]);
+      for (size_t child = childOffset + first; child < end; ++child) {
+        stack[stackSize++] = {level - 1, child};
+      }
+    }
+  }
+
+  return true;
+}
+
+CartographicPolygonIndex::CartographicPolygonIndex(
+    const std::vector<CartographicPolygon>& polygons) {
+  for (size_t polygonIndex = 0; polygonIndex < polygons.size();
+       ++polygonIndex) {
+    const CartographicPolygon& polygon = polygons[polygonIndex];
+    const std::vector<glm::dvec2> vertices =
+        unwrapVertices(polygon.getVertices());
+    const std::vector<uint32_t>& indices = polygon.getIndices();
+
+    for (size_t i = 2; i < indices.size(); i += 3) {
+      this->_triangles.emplace_back(Triangle{
+          vertices[indices[i - 2]],
+          vertices[indices[i - 1]],
+          vertices[indices[i]],
+          polygonIndex});
+    }
+
+    for (size_t i = 0; i < vertices.size(); ++i) {
+      this->_edges.emplace_back(Edge{
+          vertices[i],
+          vertices[(i + 1) % vertices.size()],
+          polygonIndex});
+    }
+  }
+
+  this->_triangleTree = buildTree<Triangle, Tree>(this->_triangles);
+  this->_edgeTree = buildTree<Edge, Tree>(this->_edges);
+}
+
+bool CartographicPolygonIndex::contains(
+    const GlobeRectangle& rectangle) const noexcept {
+  const double west = rectangle.getWest();
+  const double east = west + rectangle.computeWidth();
+  const glm::dvec2 corner(west, rectangle.getSouth());
+
+  // The polygons already tested, so that a corner on a shared triangle edge
+  // or vertex does not test the same polygon again. This never allocates, so
+  // once it is full a polygon may simply be tested more than once.
+  std::array<size_t, 16> checkedPolygons{};
+  size_t checkedPolygonCount = 0;
+  bool result = false;
+
+  // The rectangle is inside a polygon if one of its corners is inside the
+  // polygon and none of the polygon's edges touch the rectangle.
+  const auto isInsidePolygon = [this, west, east, &rectangle](
+                                   size_t polygonIndex) {
+    for (double shift : LONGITUDE_SHIFTS) {
+      const Rectangle query(
+          west - shift,
+          rectangle.getSouth(),
+          east - shift,
+          rectangle.getNorth());
+      const bool noEdgeTouches = visitTree(
+          this->_edgeTree,
+          this->_edges.size(),
+          query,
+          [this, polygonIndex, &query](size_t edgeIndex) {
+            const Edge& edge = this->_edges[edgeIndex];
+            return edge.polygonIndex != polygonIndex ||
+                   !segmentIntersectsRectangle(edge.a, edge.b, query);
+          });
+      if (!noEdgeTouches) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  for (double shift : LONGITUDE_SHIFTS) {
+    const glm::dvec2 point(corner.x - shift, corner.y);
+    visitTree(
+        this->_triangleTree,
+        this->_triangles.size(),
+        Rectangle(point.x, point.y, point.x, point.y),
+        [&](size_t triangleIndex) {
+          const Triangle& triangle = this->_triangles[triangleIndex];
+          const auto checkedEnd = checkedPolygons.begin() +
+                                  std::ptrdiff_t(checkedPolygonCount);
+          if (!isInsideTriangle(point, triangle) ||
+              std::find(
+                  checkedPolygons.begin(),
+                  checkedEnd,
+                  triangle.polygonIndex) != checkedEnd) {
+            return true;
+          }
+
+          if (checkedPolygonCount < checkedPolygons.size()) {
+            checkedPolygons[checkedPolygonCount++] = triangle.polygonIndex;
+          }
+          result = isInsidePolygon(triangle.polygonIndex);
+          return !result;
+        });
+
+    if (result) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool CartographicPolygonIndex::intersects(
+    const GlobeRectangle& rectangle) const noexcept {
+  const double west = rectangle.getWest();
+  const double east = west + rectangle.computeWidth();
+
+  for (double shift : LONGITUDE_SHIFTS) {
+    const Rectangle query(
+        west - shift,
+        rectangle.getSouth(),
+        east - shift,
+        rectangle.getNorth());
+    const bool found = !visitTree(
+        this->_triangleTree,
+        this->_triangles.size(),
+        query,
+        [this, &query](size_t triangleIndex) {
+          return !overlaps(
+              computeBounds(this->_triangles[triangleIndex]),
+              query);
+        });
+    if (found) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void CartographicPolygonIndex::findTriangles(
+    const GlobeRectangle& rectangle,
+    std::vector<Triangle>& result) const {
+  const double west = rectangle.getWest();
+  const double east = west + rectangle.computeWidth();
+
+  for (double shift : LONGITUDE_SHIFTS) {
+    const Rectangle query(
+        west - shift,
+        rectangle.getSouth(),
+        east - shift,
+        rectangle.getNorth());
+    visitTree(
+        this->_triangleTree,
+        this->_triangles.size(),
+        query,
+        [this, shift, &query, &result](size_t triangleIndex) {
+          const Triangle& triangle = this->_triangles[triangleIndex];
+          if (overlaps(computeBounds(triangle), query)) {
+            const glm::dvec2 offset(shift, 0.0);
+            result.emplace_back(Triangle{
+                triangle.a + offset,
+                triangle.b + offset,
+                triangle.c + offset,
+                triangle.polygonIndex});
+          }
+          return true;
+        });
+  }
+}
+
+} // namespace CesiumGeospatial
@@ -0,0 +1,101 @@
+#include "CesiumGeospatial/CartographicPolygonIndex.h"
+
+#include <CesiumUtility/Math.h>
+
+#include <catch2/catch.hpp>
+
+using namespace CesiumGeospatial;
+using namespace CesiumUtility;
+
+namespace {
+
+CartographicPolygon
+createRectanglePolygon(double west, double south, double east, double north) {
+  return CartographicPolygon(std::vector<glm::dvec2>{
+      glm::dvec2(west, south),
+      glm::dvec2(east, south),
+      glm::dvec2(east, north),
+      glm::dvec2(west, north)});
+}
+
+} // namespace
+
+TEST_CASE("CartographicPolygonIndex") {
+  std::vector<CartographicPolygon> polygons{
+      createRectanglePolygon(0.0, 0.0, 0.5, 0.5),
+      // crosses the antimeridian
+      createRectanglePolygon(3.0, 0.0, -3.0, 0.5)};
+
+  CartographicPolygonIndex index(polygons);
+  CHECK(index.getTriangles().size() == 4);
+
+  SECTION("contains") {
+    CHECK(index.contains(GlobeRectangle(0.1, 0.1, 0.2, 0.2)));
+    CHECK(!index.contains(GlobeRectangle(0.4, 0.1, 0.6, 0.2)));
+    CHECK(!index.contains(GlobeRectangle(1.0, 0.1, 1.1, 0.2)));
+    CHECK(!index.contains(GlobeRectangle(-0.2, -0.2, 0.6, 0.6)));
+
+    CHECK(index.contains(GlobeRectangle(3.05, 0.1, 3.1, 0.2)));
+    CHECK(index.contains(GlobeRectangle(-3.1, 0.1, -3.05, 0.2)));
+    CHECK(index.contains(GlobeRectangle(3.1, 0.1, -3.1, 0.2)));
+    CHECK(!index.contains(GlobeRectangle(2.9, 0.1, -3.1, 0.2)));
+  }
+
+  SECTION("intersects") {
+    CHECK(index.intersects(GlobeRectangle(0.4, 0.4, 0.6, 0.6)));
+    CHECK(index.intersects(GlobeRectangle(-3.1, 0.1, -3.05, 0.2)));
+    CHECK(!index.intersects(GlobeRectangle(1.0, 0.1, 1.1, 0.2)));
+    CHECK(!index.intersects(GlobeRectangle(0.1, 0.6, 0.2, 0.7)));
+  }
+
+  SECTION("findTriangles shifts triangles into the rectangle's frame") {
+    std::vector<CartographicPolygonIndex::Triangle> triangles;
+    index.findTriangles(
+        GlobeRectangle(-Math::ONE_PI, 0.0, -3.0, 0.5),
+        triangles);
+    REQUIRE(triangles.size() == 2);
+
+    for (const CartographicPolygonIndex::Triangle& triangle : triangles) {
+      CHECK(triangle.polygonIndex == 1);
+      for (const glm::dvec2& vertex : {triangle.a, triangle.b, triangle.c}) {
+        // The polygon spans longitudes [3.0, 2*PI - 3.0] when unwrapped, so
+        // it must be shifted west by a full turn.
+        CHECK(vertex.x >= 3.0 - Math::TWO_PI - Math::EPSILON10);
+        CHECK(vertex.x <= -3.0 + Math::EPSILON10);
+      }
+    }
+  }
+
+  SECTION("matches a brute force search") {
+    std::vector<CartographicPolygon> grid;
+    for (int32_t i = 0; i < 40; ++i) {
+      for (int32_t j = 0; j < 20; ++j) {
+        const double west = -3.0 + 0.15 * i;
+        const double south = -1.5 + 0.15 * j;
+        grid.emplace_back(
+            createRectanglePolygon(west, south, west + 0.1, south + 0.1));
+      }
+    }
+
+    CartographicPolygonIndex gridIndex(grid);
+    REQUIRE(gridIndex.getTriangles().size() == grid.size() * 2);
+
+    const GlobeRectangle query(0.12, 0.12, 0.5, 0.3);
+    std::vector<CartographicPolygonIndex::Triangle> triangles;
+    gridIndex.findTriangles(query, triangles);
+
+    size_t expected = 0;
+    for (const CartographicPolygon& polygon : grid) {
+      const GlobeRectangle& bounds = *polygon.getBoundingRectangle();
+      if (bounds.getWest() <= query.getEast() &&
+          query.getWest() <= bounds.getEast() &&
+          bounds.getSouth() <= query.getNorth() &&
+          query.getSouth() <= bounds.getNorth()) {
+        expected += 2;
+      }
+    }
+
+    CHECK(expected > 0);
+    CHECK(triangles.size() == expected);
+  }
+}
@@ -0,0 +1,276 @@
+#pragma once
+
+#include "AccessorView.h"
+#include "Model.h"
+
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace CesiumGltf {
+
+/**
+ * @brief Converts one component of an accessor element to a float.
+ *
+ * Normalized integers are mapped to [0, 1] or [-1, 1] as described by the glTF
+ * specification, which is how `KHR_mesh_quantization` attributes are read.
+ * Other integers are converted to the float with the same value.
+ *
+ * @tparam T The component type.
+ * @param value The component value.
+ * @param normalized Whether the accessor is {@link Accessor::normalized}.
+ * @return The float value.
+ */
+template <typename T>
+float dequantizeComponent(T value, bool normalized) noexcept {
+  if constexpr (std::is_floating_point_v<T>) {
+    return static_cast<float>(value);
+  } else {
+    if (!normalized) {
+      return static_cast<float>(value);
+    }
+
+    const float result = static_cast<float>(
+        static_cast<double>(value) /
+        static_cast<double>(std::numeric_limits<T>::max()));
+    return std::is_signed_v<T> ? std::max(result, -1.0f) : result;
+  }
+}
+
+/**
+ * @brief Converts a float to one component of an accessor element.
+ *
+ * This is the inverse of {@link dequantizeComponent}. Values are rounded to the
+ * nearest integer and clamped to the range of the component type.
+ *
+ * @tparam T The component type.
+ * @param value The float value.
+ * @param normalized Whether the accessor is {@link Accessor::normalized}.
+ * @return The component value.
+ */
+template <typename T>
+T quantizeComponent(float value, bool normalized) noexcept {
+  if constexpr (std::is_floating_point_v<T>) {
+    return static_cast<T>(value);
+  } else {
+    double scaled = static_cast<double>(value);
+    if (normalized) {
+      scaled *= static_cast<double>(std::numeric_limits<T>::max());
+    }
+
+    return static_cast<T>(std::clamp(
+        std::round(scaled),
+        static_cast<double>(std::numeric_limits<T>::lowest()),
+        static_cast<double>(std::numeric_limits<T>::max())));
+  }
+}
+
+/**
+ * @brief A view on the data of one accessor of a glTF asset that reads each
+ * element as a vector of floats, whatever its component type.
+ *
+ * This is used to read vertex attributes that may be quantized with the
+ * `KHR_mesh_quantization` extension, such as a `POSITION` stored as shorts, a
+ * `NORMAL` stored as normalized bytes, or a `TEXCOORD_0` stored as normalized
+ * unsigned shorts, without first expanding the whole accessor to floats. Each
+ * component is converted with {@link dequantizeComponent} as it is read.
+ *
+ * The accessor must have a {@link Accessor::type} with as many components as
+ * `T`, such as `VEC3` for `glm::vec3`.
+ *
+ * @tparam T The type of the elements returned, such as `glm::vec3`.
+ */
+template <class T> class DequantizedAccessorView final {
+public:
+  /**
+   * @brief The type of the elements returned by this view.
+   */
+  typedef T value_type;
+
+  /**
+   * @brief Construct a new instance not pointing to any data.
+   *
+   * @param status The status of the new view. Defaults to
+   * {@link AccessorViewStatus::InvalidAccessorIndex}.
+   */
+  DequantizedAccessorView(
+      AccessorViewStatus status = AccessorViewStatus::InvalidAccessorIndex)
+      : _pData(nullptr),
+        _stride(0),
+        _size(0),
+        _componentType(Accessor::ComponentType::FLOAT),
+        _normalized(false),
+        _status(status) {}
+
+  /**
+   * @brief Creates a new instance from a given model and {@link Accessor}.
+   *
+   * If the accessor cannot be viewed, {@link size} will return 0 and
+   * {@link status} will indicate what went wrong.
+   *
+   * @param model The model to access.
+   * @param accessor The accessor to view.
+   */
+  DequantizedAccessorView(const Model& model, const Accessor& accessor) noexcept
+      : DequantizedAccessorView() {
+    this->create(model, accessor);
+  }
+
+  /**
+   * @brief Creates a new instance from a given model and accessor index.
+   *
+   * If the accessor cannot be viewed, {@link size} will return 0 and
+   * {@link status} will indicate what went wrong.
+   *
+   * @param model The model to access.
+   * @param accessorIndex The index of the accessor to view in the model's
+   * {@link Model::accessors} list.
+   */
+  DequantizedAccessorView(const Model& model, int32_t accessorIndex) noexcept
+      : DequantizedAccessorView() {
+    const Accessor* pAccessor = Model::getSafe(&model.accessors, accessorIndex);
+    if (!pAccessor) {
+      this->_status = AccessorViewStatus::InvalidAccessorIndex;
+      return;
+    }
+
+    this->create(model, *pAccessor);
+  }
+
+  /**
+   * @brief Provides the specified accessor element, converted to floats.
+   *
+   * @param i The index of the element.
+   * @returns The element.
+   * @throws A `std::range_error` if the given index is negative
+   * or not smaller than the {@link size} of this accessor.
+   */
+  T operator[](int64_t i) const {
+    if (i < 0 || i >= this->_size) {
+      throw std::range_error("index out of range");
+    }
+
+    const std::byte* pElement = this->_pData + i * this->_stride;
+    switch (this->_componentType) {
+    case Accessor::ComponentType::BYTE:
+      return this->read<int8_t>(pElement);
+    case Accessor::ComponentType::UNSIGNED_BYTE:
+      return this->read<uint8_t>(pElement);
+    case Accessor::ComponentType::SHORT:
+      return this->read<int16_t>(pElement);
+    case Accessor::ComponentType::UNSIGNED_SHORT:
+      return this->read<uint16_t>(pElement);
+    case Accessor::ComponentType::UNSIGNED_INT:
+      return this->read<uint32_t>(pElement);
+    default:
+      return this->read<float>(pElement);
+    }
+  }
+
+  /**
+   * @brief Returns the size (number of elements) of this accessor.
+   */
+  int64_t size() const noexcept { return this->_size; }
+
+  /**
+   * @brief Gets the status of this view.
+   *
+   * Indicates whether the view accurately reflects the accessor's data, or
+   * whether an error occurred.
+   */
+  AccessorViewStatus status() const noexcept { return this->_status; }
+
+  /**
+   * @brief Gets the {@link Accessor::componentType} of the viewed accessor.
+   */
+  int32_t componentType() const noexcept { return this->_componentType; }
+
+  /**
+   * @brief Gets whether the viewed accessor is {@link Accessor::normalized}.
+   */
+  bool normalized() const noexcept { return this->_normalized; }
+
+private:
+  static constexpr size_t ComponentCount = size_t(T::length());
+
+  template <typename TComponent>
+  T read(const std::byte* pElement) const noexcept {
+    T result;
+    for (glm::length_t c = 0; c < T::length(); ++c) {
+      TComponent component;
+      std::memcpy(
+          &component,
+          pElement + static_cast<size_t>(c) * sizeof(TComponent),
+          sizeof(TComponent));
+      result[c] = dequantizeComponent(component, this->_normalized);
+    }
+    return result;
+  }
+
+  void create(const Model& model, const Accessor& accessor) noexcept {
+    if (size_t(accessor.computeNumberOfComponents()) != ComponentCount) {
+      this->_status = AccessorViewStatus::InvalidType;
+      return;
+    }
+
+    const int64_t componentBytes = accessor.computeByteSizeOfComponent();
+    if (componentBytes == 0) {
+      this->_status = AccessorViewStatus::InvalidComponentType;
+      return;
+    }
+
+    const BufferView* pBufferView =
+        Model::getSafe(&model.bufferViews, accessor.bufferView);
+    if (!pBufferView) {
+      this->_status = AccessorViewStatus::InvalidBufferViewIndex;
+      return;
+    }
+
+    const Buffer* pBuffer = Model::getSafe(&model.buffers, pBufferView->buffer);
+    if (!pBuffer) {
+      this->_status = AccessorViewStatus::InvalidBufferIndex;
+      return;
+    }
+
+    const int64_t bufferBytes = int64_t(pBuffer->cesium.data.size());
+    if (pBufferView->byteOffset + pBufferView->byteLength > bufferBytes) {
+      this->_status = AccessorViewStatus::BufferTooSmall;
+      return;
+    }
+
+    const int64_t stride = accessor.computeByteStride(model);
+    const int64_t elementBytes = int64_t(ComponentCount) * componentBytes;
+    if (accessor.count > 0 &&
+        accessor.byteOffset + stride * (accessor.count - 1) + elementBytes >
+            pBufferView->byteLength) {
+      this->_status = AccessorViewStatus::BufferViewTooSmall;
+      return;
+    }
+
+    this->_pData = pBuffer->cesium.data.data() + pBufferView->byteOffset +
+                   accessor.byteOffset;
+    this->_stride = stride;
+    this->_size = accessor.count;
+    this->_componentType = accessor.componentType;
+    this->_normalized = accessor.normalized;
+    this->_status = AccessorViewStatus::Valid;
+  }
+
+  const std::byte* _pData;
+  int64_t _stride;
+  int64_t _size;
+  int32_t _componentType;
+  bool _normalized;
+  AccessorViewStatus _status;
+};
+
+} // namespace CesiumGltf
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "Library.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace CesiumGltf {
+
+/**
+ * @brief Options for an {@link ImageBufferPool}.
+ */
+struct CESIUMGLTF_API ImageBufferPoolOptions {
+  /**
+   * @brief The maximum total capacity, in bytes, of the buffers held by the
+   * pool.
+   *
+   * Buffers that are released while the pool is at this limit are freed
+   * instead.
+   */
+  int64_t maximumPooledBytes = 4 * 1024 * 1024;
+
+  /**
+   * @brief The maximum number of buffers held by the pool in each size class.
+   */
+  size_t maximumBuffersPerSizeClass = 16;
+
+  /**
+   * @brief The size, in bytes, below which buffers are never pooled.
+   *
+   * Small buffers are cheap to allocate, so pooling them only takes space away
+   * from the larger buffers that benefit from it.
+   */
+  size_t minimumBufferSize = 4096;
+};
+
+/**
+ * @brief Statistics about the use of an {@link ImageBufferPool}.
+ */
+struct CESIUMGLTF_API ImageBufferPoolStatistics {
+  /**
+   * @brief The number of allocations that were satisfied by a pooled buffer.
+   */
+  int64_t hits = 0;
+
+  /**
+   * @brief The number of poolable allocations that required a new buffer
+   * because no pooled buffer of the right size class was available.
+   */
+  int64_t misses = 0;
+
+  /**
+   * @brief The number of released buffers that were added to the pool.
+   */
+  int64_t returns = 0;
+
+  /**
+   * @brief The number of released buffers that were freed because the pool was
+   * full or the buffer was too small to be pooled.
+   */
+  int64_t discards = 0;
+
+  /**
+   * @brief The number of buffers currently held by the pool.
+   */
+  int64_t pooledBuffers = 0;
+
+  /**
+   * @brief The total capacity, in bytes, of the buffers currently held by the
+   * pool.
+   */
+  int64_t pooledBytes = 0;
+
+  /**
+   * @brief Gets the fraction of poolable allocations that were satisfied by a
+   * pooled buffer, or 0.0 if there have been no such allocations.
+   */
+  double getHitRate() const noexcept {
+    const int64_t total = this->hits + this->misses;
+    return total > 0 ? double(this->hits) / double(total) : 0.0;
+  }
+};
+
+/**
+ * @brief A thread-safe pool of pixel buffers for {@link ImageCesium}.
+ *
+ * Images of a raster overlay or tileset tend to have a handful of distinct
+ * sizes, so reusing the buffers of images that are no longer needed avoids
+ * much of the allocator churn of loading and unloading them.
+ *
+ * Buffers are grouped into size classes by powers of two. A buffer allocated
+ * by the pool has a capacity of the smallest power of two that holds the
+ * requested size, so that it can be reused for any request in the same class.
+ * Buffers that were not allocated by the pool may be released to it as well,
+ * and are used for requests no larger than their capacity.
+ */
+class CESIUMGLTF_API ImageBufferPool final {
+public:
+  /**
+   * @brief Constructs an empty pool.
+   *
+   * @param options The options for the pool.
+   */
+  explicit ImageBufferPool(
+      const ImageBufferPoolOptions& options = ImageBufferPoolOptions());
+
+  /**
+   * @brief Gets the options for this pool.
+   */
+  const ImageBufferPoolOptions& getOptions() const noexcept {
+    return this->_options;
+  }
+
+  /**
+   * @brief Allocates a buffer of the given size.
+   *
+   * The buffer is taken from the pool if a suitable one is available, or is
+   * newly allocated otherwise. In either case, all of its bytes are zero.
+   *
+   * @param size The size of the buffer, in bytes.
+   * @return The buffer.
+   */
+  std::vector<std::byte> allocate(size_t size);
+
+  /**
+   * @brief Returns a buffer that is no longer needed to the pool.
+   *
+   * If the pool is full, or the buffer is too small to be pooled, the buffer
+   * is freed instead.
+   *
+   * @param buffer The buffer, which is left empty.
+   */
+  void release(std::vector<std::byte>&& buffer) noexcept;
+
+  /**
+   * @brief Frees all of the buffers held by the pool.
+   */
+  void clear() noexcept;
+
+  /**
+   * @brief Gets statistics about the use of this pool.
+   */
+  ImageBufferPoolStatistics getStatistics() const;
+
+private:
+  static constexpr size_t SIZE_CLASSES = 64;
+
+  ImageBufferPoolOptions _options;
+  mutable std::mutex _mutex;
+  std::array<std::vector<std::vector<std::byte>>, SIZE_CLASSES> _buffers;
+  ImageBufferPoolStatistics _statistics;
+};
+
+} // namespace CesiumGltf
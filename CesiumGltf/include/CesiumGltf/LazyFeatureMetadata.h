@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Library.h"
+#include "Model.h"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+namespace CesiumGltf {
+
+/**
+ * @brief Feature metadata of a {@link Model} that is converted to
+ * `EXT_feature_metadata` only when it is first accessed.
+ *
+ * The conversion adds the extension, along with the buffers and buffer views
+ * that its feature tables refer to, to a separate model, so the model that the
+ * metadata belongs to is never modified after it is loaded.
+ *
+ * This class is thread-safe. The conversion runs only once, and threads that
+ * access the metadata while it is being converted wait for it to finish.
+ */
+class CESIUMGLTF_API LazyFeatureMetadata final {
+public:
+  /**
+   * @brief A function that adds the `EXT_feature_metadata` extension to the
+   * given empty model.
+   */
+  using Converter = std::function<void(Model& metadataModel)>;
+
+  /**
+   * @brief Creates an instance that is converted with the given function.
+   *
+   * @param converter The function that converts the metadata. It is called at
+   * most once, and then released.
+   */
+  explicit LazyFeatureMetadata(Converter&& converter);
+
+  /**
+   * @brief Gets the model that holds the `EXT_feature_metadata` extension,
+   * converting the metadata if this is the first access.
+   *
+   * The model has no meshes; it only holds the extension and the buffers and
+   * buffer views of its feature tables. If the metadata could not be
+   * converted, it has no extension.
+   */
+  const Model& getModel() const;
+
+  /**
+   * @brief Determines whether the metadata has already been converted.
+   */
+  bool isConverted() const noexcept {
+    return this->_isConverted.load(std::memory_order_acquire);
+  }
+
+private:
+  mutable std::once_flag _conversionFlag;
+  mutable Converter _converter;
+  mutable Model _model;
+  mutable std::atomic<bool> _isConverted;
+};
+
+} // namespace CesiumGltf
@@ -21,6 +21,10 @@ class MetadataFeatureTableView {
 public:
   /**
    * @brief Create an instance of MetadataFeatureTableView
+   *
+   * If the model's metadata is converted lazily, it is converted here, and
+   * the feature table must be one of the converted model's.
+   *
    * @param model The Gltf Model that stores featureTable data
    * @param featureTable The FeatureTable that will be used to retrieve the data
    * from
@@ -29,6 +33,21 @@ public:
       const Model* pModel,
       const FeatureTable* pFeatureTable);
 
+  /**
+   * @brief Create an instance of MetadataFeatureTableView for the feature table
+   * with the given name.
+   *
+   * If the model's metadata is converted lazily, it is converted here. If the
+   * model has no such feature table, the view has no properties.
+   *
+   * @param model The Gltf Model that stores featureTable data
+   * @param featureTableName The name of the FeatureTable that will be used to
+   * retrieve the data from
+   */
+  MetadataFeatureTableView(
+      const Model* pModel,
+      const std::string& featureTableName);
+
   /**
    * @brief Find the {@link ClassProperty} which stores the type information of a property based on the property name
    * @param propertyName The name of the property to retrieve type info
@@ -137,6 +156,75 @@ public:
     }
   }
 
+  /**
+   * @brief Copies the values of consecutive instances of a numeric or boolean
+   * property into a buffer, converting them to T.
+   *
+   * The type of the property is looked up once for all of the instances, so a
+   * whole column can be read without knowing how it is stored. Integer values
+   * are normalized when T is float or double and the property's
+   * {@link ClassProperty::normalized} is set. Boolean values become 0 or 1.
+   *
+   * @param propertyName The name of the property to copy.
+   * @param firstInstance The index of the first instance to copy.
+   * @param output The buffer that receives the values. Its size is the number
+   * of instances to copy.
+   * @return The status of the property. The output is only written if this
+   * is {@link MetadataPropertyViewStatus::Valid}.
+   */
+  template <typename T>
+  MetadataPropertyViewStatus copyPropertyValues(
+      const std::string& propertyName,
+      int64_t firstInstance,
+      gsl::span<T> output) const {
+    static_assert(
+        IsMetadataNumeric<T>::value,
+        "Property values can only be copied to a numeric type");
+
+    if (_pFeatureTable->count < 0) {
+      return MetadataPropertyViewStatus::InvalidPropertyNotExist;
+    }
+
+    const ClassProperty* pClassProperty = getClassProperty(propertyName);
+    if (!pClassProperty) {
+      return MetadataPropertyViewStatus::InvalidPropertyNotExist;
+    }
+
+    const PropertyType type = convertStringToPropertyType(pClassProperty->type);
+    MetadataPropertyViewStatus status =
+        MetadataPropertyViewStatus::InvalidTypeMismatch;
+    getScalarPropertyViewImpl(
+        propertyName,
+        *pClassProperty,
+        type,
+        [pClassProperty, firstInstance, output, &status](
+            const std::string& /*propertyName*/,
+            auto propertyView) {
+          using ElementType = decltype(propertyView.get(0));
+          if constexpr (IsMetadataString<ElementType>::value) {
+            return;
+          } else {
+            status = propertyView.status();
+            if (status != MetadataPropertyViewStatus::Valid) {
+              return;
+            }
+
+            if constexpr (
+                IsMetadataInteger<ElementType>::value &&
+                IsMetadataFloating<T>::value) {
+              if (pClassProperty->normalized) {
+                propertyView.copyNormalizedValues(firstInstance, output);
+                return;
+              }
+            }
+
+            propertyView.copyValues(firstInstance, output);
+          }
+        });
+
+    return status;
+  }
+
 private:
   template <typename Callback>
   void getArrayPropertyViewImpl(
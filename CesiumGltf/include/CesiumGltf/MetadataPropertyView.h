@@ -6,9 +6,12 @@
 
 #include <gsl/span>
 
+#include <algorithm>
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <limits>
 #include <string_view>
 #include <type_traits>
 
@@ -230,7 +233,300 @@ public:
    */
   int64_t size() const noexcept { return _instanceCount; }
 
+  /**
+   * @brief Gets the values of all instances of a numeric property without
+   * copying them.
+   *
+   * This is only available when ElementType is a numeric type.
+   *
+   * @return The values of the instances, or an empty span if the view is not
+   * valid.
+   */
+  gsl::span<const ElementType> getValues() const noexcept {
+    static_assert(
+        IsMetadataNumeric<ElementType>::value,
+        "getValues is only available for numeric properties");
+    return gsl::span<const ElementType>(
+        reinterpret_cast<const ElementType*>(_valueBuffer.data()),
+        static_cast<size_t>(_instanceCount));
+  }
+
+  /**
+   * @brief Copies the values of consecutive instances into a buffer.
+   *
+   * The values are read with a single dispatch on the type and offset type of
+   * the property rather than one per instance, so this is much faster than
+   * calling {@link get} for each instance. Numeric values may be converted to
+   * another numeric type T with `static_cast`, and boolean values may be
+   * copied to a numeric T as 0 or 1. Otherwise T must be ElementType.
+   *
+   * @param firstInstance The index of the first instance to copy.
+   * @param output The buffer that receives the values. Its size is the number
+   * of instances to copy.
+   */
+  template <typename T>
+  void copyValues(int64_t firstInstance, gsl::span<T> output) const noexcept {
+    assert(
+        _status == MetadataPropertyViewStatus::Valid &&
+        "Check the status() first to make sure view is valid");
+    assert(firstInstance >= 0 && "instance index must be positive");
+    assert(
+        firstInstance + static_cast<int64_t>(output.size()) <= size() &&
+        "output must not extend past the last instance");
+
+    if constexpr (std::is_same_v<T, ElementType> &&
+                  IsMetadataNumeric<ElementType>::value) {
+      if (!output.empty()) {
+        std::memcpy(
+            output.data(),
+            getValues().data() + firstInstance,
+            output.size() * sizeof(T));
+      }
+    } else {
+      copyValuesImpl(output, [firstInstance](size_t i) noexcept {
+        return firstInstance + static_cast<int64_t>(i);
+      });
+    }
+  }
+
+  /**
+   * @brief Copies the values of the given instances into a buffer.
+   *
+   * This is like {@link copyValues(int64_t, gsl::span<T>) const}, but gathers
+   * the values of arbitrary instances, such as the feature IDs of a primitive.
+   *
+   * @param instances The indices of the instances to copy.
+   * @param output The buffer that receives the values. It must be the same size
+   * as `instances`.
+   */
+  template <typename T, typename IndexType>
+  void copyValues(
+      gsl::span<const IndexType> instances,
+      gsl::span<T> output) const noexcept {
+    assert(
+        _status == MetadataPropertyViewStatus::Valid &&
+        "Check the status() first to make sure view is valid");
+    assert(
+        instances.size() == output.size() &&
+        "output must have one value per instance");
+
+    copyValuesImpl(output, [instances](size_t i) noexcept {
+      return static_cast<int64_t>(instances[i]);
+    });
+  }
+
+  /**
+   * @brief Copies the normalized values of consecutive instances of an integer
+   * property into a buffer.
+   *
+   * Values of unsigned integer types are normalized to `[0.0, 1.0]`, and
+   * values of signed integer types to `[-1.0, 1.0]`, as for properties with
+   * {@link ClassProperty::normalized} set.
+   *
+   * @param firstInstance The index of the first instance to copy.
+   * @param output The buffer that receives the values. Its size is the number
+   * of instances to copy.
+   */
+  template <typename T>
+  void copyNormalizedValues(int64_t firstInstance, gsl::span<T> output)
+      const noexcept {
+    assert(
+        _status == MetadataPropertyViewStatus::Valid &&
+        "Check the status() first to make sure view is valid");
+    assert(firstInstance >= 0 && "instance index must be positive");
+    assert(
+        firstInstance + static_cast<int64_t>(output.size()) <= size() &&
+        "output must not extend past the last instance");
+
+    copyNormalizedValuesImpl(output, [firstInstance](size_t i) noexcept {
+      return firstInstance + static_cast<int64_t>(i);
+    });
+  }
+
+  /**
+   * @brief Copies the normalized values of the given instances of an integer
+   * property into a buffer.
+   *
+   * This is like
+   * {@link copyNormalizedValues(int64_t, gsl::span<T>) const}, but gathers the
+   * values of arbitrary instances, such as the feature IDs of a primitive.
+   *
+   * @param instances The indices of the instances to copy.
+   * @param output The buffer that receives the values. It must be the same size
+   * as `instances`.
+   */
+  template <typename T, typename IndexType>
+  void copyNormalizedValues(
+      gsl::span<const IndexType> instances,
+      gsl::span<T> output) const noexcept {
+    assert(
+        _status == MetadataPropertyViewStatus::Valid &&
+        "Check the status() first to make sure view is valid");
+    assert(
+        instances.size() == output.size() &&
+        "output must have one value per instance");
+
+    copyNormalizedValuesImpl(output, [instances](size_t i) noexcept {
+      return static_cast<int64_t>(instances[i]);
+    });
+  }
+
 private:
+  template <typename T, typename GetInstance>
+  void copyValuesImpl(gsl::span<T> output, GetInstance&& getInstance)
+      const noexcept {
+    // Write through a pointer, because the bounds checks of the span would
+    // keep the loops from being vectorized.
+    T* pOutput = output.data();
+    if constexpr (IsMetadataNumeric<ElementType>::value) {
+      static_assert(
+          IsMetadataNumeric<T>::value,
+          "Numeric values can only be copied to a numeric type");
+      const ElementType* pValues =
+          reinterpret_cast<const ElementType*>(_valueBuffer.data());
+      for (size_t i = 0; i < output.size(); ++i) {
+        pOutput[i] = static_cast<T>(pValues[getInstance(i)]);
+      }
+    } else if constexpr (IsMetadataBoolean<ElementType>::value) {
+      static_assert(
+          IsMetadataBoolean<T>::value || IsMetadataNumeric<T>::value,
+          "Boolean values can only be copied to bool or a numeric type");
+      const uint8_t* pBits =
+          reinterpret_cast<const uint8_t*>(_valueBuffer.data());
+      for (size_t i = 0; i < output.size(); ++i) {
+        const int64_t instance = getInstance(i);
+        pOutput[i] =
+            static_cast<T>((pBits[instance / 8] >> (instance % 8)) & 1);
+      }
+    } else if constexpr (IsMetadataString<ElementType>::value) {
+      static_assert(
+          std::is_same_v<T, ElementType>,
+          "String values can only be copied to std::string_view");
+      switch (_offsetType) {
+      case PropertyType::Uint8:
+        copyStrings<uint8_t>(output, getInstance);
+        break;
+      case PropertyType::Uint16:
+        copyStrings<uint16_t>(output, getInstance);
+        break;
+      case PropertyType::Uint32:
+        copyStrings<uint32_t>(output, getInstance);
+        break;
+      case PropertyType::Uint64:
+        copyStrings<uint64_t>(output, getInstance);
+        break;
+      default:
+        assert(false && "Offset type has unknown type");
+        break;
+      }
+    } else if constexpr (IsMetadataNumericArray<ElementType>::value) {
+      static_assert(
+          std::is_same_v<T, ElementType>,
+          "Array values can only be copied to the same array type");
+      using ComponentType = typename MetadataArrayType<ElementType>::type;
+      if (_componentCount > 0) {
+        const size_t arrayByteLength =
+            static_cast<size_t>(_componentCount) * sizeof(ComponentType);
+        for (size_t i = 0; i < output.size(); ++i) {
+          pOutput[i] = ElementType(_valueBuffer.subspan(
+              static_cast<size_t>(getInstance(i)) * arrayByteLength,
+              arrayByteLength));
+        }
+        return;
+      }
+
+      switch (_offsetType) {
+      case PropertyType::Uint8:
+        copyNumericArrays<uint8_t>(output, getInstance);
+        break;
+      case PropertyType::Uint16:
+        copyNumericArrays<uint16_t>(output, getInstance);
+        break;
+      case PropertyType::Uint32:
+        copyNumericArrays<uint32_t>(output, getInstance);
+        break;
+      case PropertyType::Uint64:
+        copyNumericArrays<uint64_t>(output, getInstance);
+        break;
+      default:
+        assert(false && "Offset type has unknown type");
+        break;
+      }
+    } else {
+      static_assert(
+          std::is_same_v<T, ElementType>,
+          "Array values can only be copied to the same array type");
+      for (size_t i = 0; i < output.size(); ++i) {
+        pOutput[i] = get(getInstance(i));
+      }
+    }
+  }
+
+  template <typename T, typename GetInstance>
+  void copyNormalizedValuesImpl(gsl::span<T> output, GetInstance&& getInstance)
+      const noexcept {
+    T* pOutput = output.data();
+    static_assert(
+        IsMetadataInteger<ElementType>::value,
+        "Only integer values can be normalized");
+    static_assert(
+        IsMetadataFloating<T>::value,
+        "Normalized values can only be copied to float or double");
+
+    // Dividing by the maximum maps both the minimum and the maximum of an
+    // unsigned type to the ends of [0.0, 1.0], but a signed type has one more
+    // negative value, which is clamped to -1.0. Values wider than 16 bits are
+    // divided in double so that they keep their precision when T is float.
+    using Scalar =
+        std::conditional_t<sizeof(ElementType) <= sizeof(uint16_t), T, double>;
+    constexpr Scalar maximum =
+        static_cast<Scalar>(std::numeric_limits<ElementType>::max());
+    const ElementType* pValues =
+        reinterpret_cast<const ElementType*>(_valueBuffer.data());
+    for (size_t i = 0; i < output.size(); ++i) {
+      const Scalar value =
+          static_cast<Scalar>(pValues[getInstance(i)]) / maximum;
+      if constexpr (std::is_signed_v<ElementType>) {
+        pOutput[i] = static_cast<T>(std::max(value, Scalar(-1.0)));
+      } else {
+        pOutput[i] = static_cast<T>(value);
+      }
+    }
+  }
+
+  template <typename OffsetType, typename GetInstance>
+  void copyStrings(
+      gsl::span<std::string_view> output,
+      GetInstance& getInstance) const noexcept {
+    std::string_view* pOutput = output.data();
+    const OffsetType* pOffsets =
+        reinterpret_cast<const OffsetType*>(_stringOffsetBuffer.data());
+    const char* pChars = reinterpret_cast<const char*>(_valueBuffer.data());
+    for (size_t i = 0; i < output.size(); ++i) {
+      const int64_t instance = getInstance(i);
+      const size_t currentOffset = static_cast<size_t>(pOffsets[instance]);
+      const size_t nextOffset = static_cast<size_t>(pOffsets[instance + 1]);
+      pOutput[i] =
+          std::string_view(pChars + currentOffset, nextOffset - currentOffset);
+    }
+  }
+
+  template <typename OffsetType, typename GetInstance>
+  void copyNumericArrays(
+      gsl::span<ElementType> output,
+      GetInstance& getInstance) const noexcept {
+    ElementType* pOutput = output.data();
+    const OffsetType* pOffsets =
+        reinterpret_cast<const OffsetType*>(_arrayOffsetBuffer.data());
+    for (size_t i = 0; i < output.size(); ++i) {
+      const int64_t instance = getInstance(i);
+      const size_t currentOffset = static_cast<size_t>(pOffsets[instance]);
+      const size_t nextOffset = static_cast<size_t>(pOffsets[instance + 1]);
+      pOutput[i] = ElementType(
+          _valueBuffer.subspan(currentOffset, nextOffset - currentOffset));
+    }
+  }
+
   ElementType getNumeric(int64_t instance) const noexcept {
     return reinterpret_cast<const ElementType*>(_valueBuffer.data())[instance];
   }
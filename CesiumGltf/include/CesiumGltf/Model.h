@@ -6,11 +6,24 @@
 #include <glm/mat4x4.hpp>
 
 #include <functional>
+#include <memory>
 
 namespace CesiumGltf {
 
+class LazyFeatureMetadata;
+
 /** @copydoc ModelSpec */
 struct CESIUMGLTF_API Model : public ModelSpec {
+  /**
+   * @brief Feature metadata that is converted to `EXT_feature_metadata` the
+   * first time it is accessed, or `nullptr` if there is none.
+   *
+   * This is set instead of adding the extension when a loader defers the
+   * conversion of its metadata. Use {@link getFeatureMetadataModel} to get the
+   * model that holds the extension in either case.
+   */
+  std::shared_ptr<LazyFeatureMetadata> pLazyFeatureMetadata;
+
   /**
    * @brief Merges another model into this one.
    *
@@ -74,8 +87,23 @@ struct CESIUMGLTF_API Model : public ModelSpec {
       int sceneID,
       std::function<ForEachPrimitiveInSceneConstCallback>&& callback) const;
 
+  /**
+   * @brief Gets the model that holds the `EXT_feature_metadata` extension of
+   * this model.
+   *
+   * This is the model itself, unless the model has no such extension and its
+   * {@link pLazyFeatureMetadata} is set, in which case the metadata is
+   * converted if necessary and the model that holds it is returned. The
+   * buffer views of the feature tables in the extension refer to the returned
+   * model.
+   */
+  const Model& getFeatureMetadataModel() const;
+
   /**
    * @brief Fills in smooth normals for any primitives with missing normals.
+   *
+   * Positions may be quantized as allowed by `KHR_mesh_quantization`, in which
+   * case the normals are normalized bytes rather than floats.
    */
   void generateMissingNormalsSmooth();
 
@@ -0,0 +1,118 @@
+#include "CesiumGltf/ImageBufferPool.h"
+
+#include <utility>
+
+namespace CesiumGltf {
+
+namespace {
+
+// The size class of a buffer is the base-two logarithm of its capacity. A
+// buffer in class `k` has a capacity of at least `2^k` bytes.
+size_t floorLog2(size_t value) noexcept {
+  size_t result = 0;
+  while (value >>= 1) {
+    ++result;
+  }
+  return result;
+}
+
+size_t ceilLog2(size_t value) noexcept {
+  const size_t result = floorLog2(value);
+  return (size_t(1) << result) < value ? result + 1 : result;
+}
+
+} // namespace
+
+ImageBufferPool::ImageBufferPool(const ImageBufferPoolOptions& options)
+    : _options(options), _mutex(), _buffers(), _statistics() {}
+
+std::vector<std::byte> ImageBufferPool::allocate(size_t size) {
+  if (size < this->_options.minimumBufferSize) {
+    return std::vector<std::byte>(size);
+  }
+
+  const size_t sizeClass = ceilLog2(size);
+
+  std::vector<std::byte> buffer;
+
+  {
+    std::lock_guard<std::mutex> lock(this->_mutex);
+
+    std::vector<std::vector<std::byte>>& buffers = this->_buffers[sizeClass];
+    if (!buffers.empty()) {
+      buffer = std::move(buffers.back());
+      buffers.pop_back();
+
+      ++this->_statistics.hits;
+      --this->_statistics.pooledBuffers;
+      this->_statistics.pooledBytes -= int64_t(buffer.capacity());
+    } else {
+      ++this->_statistics.misses;
+
+      // Reserve space for this class's buffers up front, so that releasing a
+      // buffer never needs to allocate.
+      buffers.reserve(this->_options.maximumBuffersPerSizeClass);
+    }
+  }
+
+  if (buffer.capacity() == 0) {
+    buffer.reserve(size_t(1) << sizeClass);
+  }
+
+  buffer.resize(size);
+  return buffer;
+}
+
+void ImageBufferPool::release(std::vector<std::byte>&& buffer) noexcept {
+  // Take ownership of the buffer so that, if it is not pooled, it is freed
+  // outside the lock.
+  std::vector<std::byte> released = std::move(buffer);
+
+  const size_t capacity = released.capacity();
+  if (capacity == 0) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(this->_mutex);
+
+  if (capacity < this->_options.minimumBufferSize) {
+    ++this->_statistics.discards;
+    return;
+  }
+
+  std::vector<std::vector<std::byte>>& buffers =
+      this->_buffers[floorLog2(capacity)];
+  if (buffers.size() >= this->_options.maximumBuffersPerSizeClass ||
+      buffers.size() >= buffers.capacity() ||
+      this->_statistics.pooledBytes + int64_t(capacity) >
+          this->_options.maximumPooledBytes) {
+    ++this->_statistics.discards;
+    return;
+  }
+
+  released.clear();
+  buffers.push_back(std::move(released));
+
+  ++this->_statistics.returns;
+  ++this->_statistics.pooledBuffers;
+  this->_statistics.pooledBytes += int64_t(capacity);
+}
+
+void ImageBufferPool::clear() noexcept {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+
+  // Clear each class's buffers without giving up the reserved space for them.
+  for (std::vector<std::vector<std::byte>>& buffers : this->_buffers) {
+    buffers.clear();
+  }
+
+  this->_statistics.pooledBuffers = 0;
+  this->_statistics.pooledBytes = 0;
+}
+
+ImageBufferPoolStatistics ImageBufferPool::getStatistics() const {
+  std::lock_guard<std::mutex> lock(this->_mutex);
+  return this->_statistics;
+}
+
+} // namespace CesiumGltf
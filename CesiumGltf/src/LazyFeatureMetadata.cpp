@@ -0,0 +1,23 @@
+#include "CesiumGltf/LazyFeatureMetadata.h"
+
+#include <utility>
+
+namespace CesiumGltf {
+
+LazyFeatureMetadata::LazyFeatureMetadata(Converter&& converter)
+    : _conversionFlag(),
+      _converter(std::move(converter)),
+      _model(),
+      _isConverted(false) {}
+
+const Model& LazyFeatureMetadata::getModel() const {
+  std::call_once(this->_conversionFlag, [this]() {
+    this->_converter(this->_model);
+    this->_converter = nullptr;
+    this->_isConverted.store(true, std::memory_order_release);
+  });
+
+  return this->_model;
+}
+
+} // namespace CesiumGltf
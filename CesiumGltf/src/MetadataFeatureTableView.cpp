@@ -74,8 +74,10 @@ MetadataFeatureTableView::MetadataFeatureTableView(
   assert(pModel != nullptr && "model must not be nullptr");
   assert(pFeatureTable != nullptr && "featureTable must not be nullptr");
 
+  _pModel = &pModel->getFeatureMetadataModel();
+
   const ExtensionModelExtFeatureMetadata* pMetadata =
-      pModel->getExtension<ExtensionModelExtFeatureMetadata>();
+      _pModel->getExtension<ExtensionModelExtFeatureMetadata>();
   assert(
       pMetadata != nullptr &&
       "Model must contain ExtensionModelExtFeatureMetadata to use "
@@ -93,6 +95,40 @@ MetadataFeatureTableView::MetadataFeatureTableView(
   }
 }
 
+MetadataFeatureTableView::MetadataFeatureTableView(
+    const Model* pModel,
+    const std::string& featureTableName)
+    : _pModel{pModel}, _pFeatureTable{nullptr}, _pClass{nullptr} {
+  assert(pModel != nullptr && "model must not be nullptr");
+
+  static const FeatureTable emptyFeatureTable;
+  _pFeatureTable = &emptyFeatureTable;
+  _pModel = &pModel->getFeatureMetadataModel();
+
+  const ExtensionModelExtFeatureMetadata* pMetadata =
+      _pModel->getExtension<ExtensionModelExtFeatureMetadata>();
+  if (pMetadata == nullptr) {
+    return;
+  }
+
+  auto featureTableIter = pMetadata->featureTables.find(featureTableName);
+  if (featureTableIter == pMetadata->featureTables.end()) {
+    return;
+  }
+
+  _pFeatureTable = &featureTableIter->second;
+
+  if (!pMetadata->schema) {
+    return;
+  }
+
+  const auto& classes = pMetadata->schema->classes;
+  auto classIter = classes.find(_pFeatureTable->classProperty.value_or(""));
+  if (classIter != classes.end()) {
+    _pClass = &classIter->second;
+  }
+}
+
 const ClassProperty* MetadataFeatureTableView::getClassProperty(
     const std::string& propertyName) const {
   if (_pClass == nullptr) {
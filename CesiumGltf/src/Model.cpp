@@ -1,7 +1,10 @@
 #include "CesiumGltf/Model.h"
 
 #include "CesiumGltf/AccessorView.h"
+#include "CesiumGltf/DequantizedAccessorView.h"
 #include "CesiumGltf/ExtensionKhrDracoMeshCompression.h"
+#include "CesiumGltf/ExtensionModelExtFeatureMetadata.h"
+#include "CesiumGltf/LazyFeatureMetadata.h"
 
 #include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/norm.hpp>
@@ -9,17 +12,20 @@
 #include <gsl/span>
 
 #include <algorithm>
+#include <cstring>
+#include <iterator>
 
 using namespace CesiumGltf;
 
 namespace {
 template <typename T>
-size_t copyElements(std::vector<T>& to, std::vector<T>& from) {
+size_t moveElements(std::vector<T>& to, std::vector<T>& from) {
   const size_t out = to.size();
-  to.resize(out + from.size());
-  for (size_t i = 0; i < from.size(); ++i) {
-    to[out + i] = std::move(from[i]);
-  }
+  to.insert(
+      to.end(),
+      std::make_move_iterator(from.begin()),
+      std::make_move_iterator(from.end()));
+  from.clear();
 
   return out;
 }
@@ -36,14 +42,14 @@ void Model::merge(Model&& rhs) {
   // TODO: we could generate this pretty easily if the glTF JSON schema made
   // it clear which index properties refer to which types of objects.
 
-  // Copy all the source data into this instance.
-  copyElements(this->extensionsUsed, rhs.extensionsUsed);
+  // Move all the source data into this instance.
+  moveElements(this->extensionsUsed, rhs.extensionsUsed);
   std::sort(this->extensionsUsed.begin(), this->extensionsUsed.end());
   this->extensionsUsed.erase(
       std::unique(this->extensionsUsed.begin(), this->extensionsUsed.end()),
       this->extensionsUsed.end());
 
-  copyElements(this->extensionsRequired, rhs.extensionsRequired);
+  moveElements(this->extensionsRequired, rhs.extensionsRequired);
   std::sort(this->extensionsRequired.begin(), this->extensionsRequired.end());
   this->extensionsRequired.erase(
       std::unique(
@@ -51,20 +57,20 @@ void Model::merge(Model&& rhs) {
           this->extensionsRequired.end()),
       this->extensionsRequired.end());
 
-  const size_t firstAccessor = copyElements(this->accessors, rhs.accessors);
-  const size_t firstAnimation = copyElements(this->animations, rhs.animations);
-  const size_t firstBuffer = copyElements(this->buffers, rhs.buffers);
+  const size_t firstAccessor = moveElements(this->accessors, rhs.accessors);
+  const size_t firstAnimation = moveElements(this->animations, rhs.animations);
+  const size_t firstBuffer = moveElements(this->buffers, rhs.buffers);
   const size_t firstBufferView =
-      copyElements(this->bufferViews, rhs.bufferViews);
-  const size_t firstCamera = copyElements(this->cameras, rhs.cameras);
-  const size_t firstImage = copyElements(this->images, rhs.images);
-  const size_t firstMaterial = copyElements(this->materials, rhs.materials);
-  const size_t firstMesh = copyElements(this->meshes, rhs.meshes);
-  const size_t firstNode = copyElements(this->nodes, rhs.nodes);
-  const size_t firstSampler = copyElements(this->samplers, rhs.samplers);
-  const size_t firstScene = copyElements(this->scenes, rhs.scenes);
-  const size_t firstSkin = copyElements(this->skins, rhs.skins);
-  const size_t firstTexture = copyElements(this->textures, rhs.textures);
+      moveElements(this->bufferViews, rhs.bufferViews);
+  const size_t firstCamera = moveElements(this->cameras, rhs.cameras);
+  const size_t firstImage = moveElements(this->images, rhs.images);
+  const size_t firstMaterial = moveElements(this->materials, rhs.materials);
+  const size_t firstMesh = moveElements(this->meshes, rhs.meshes);
+  const size_t firstNode = moveElements(this->nodes, rhs.nodes);
+  const size_t firstSampler = moveElements(this->samplers, rhs.samplers);
+  const size_t firstScene = moveElements(this->scenes, rhs.scenes);
+  const size_t firstSkin = moveElements(this->skins, rhs.skins);
+  const size_t firstTexture = moveElements(this->textures, rhs.textures);
 
   // Update the copied indices
   for (size_t i = firstAccessor; i < this->accessors.size(); ++i) {
@@ -404,7 +410,7 @@ namespace {
 template <typename TIndex>
 void addTriangleNormalToVertexNormals(
     const gsl::span<glm::vec3>& normals,
-    const AccessorView<glm::vec3>& positionView,
+    const DequantizedAccessorView<glm::vec3>& positionView,
     TIndex tIndex0,
     TIndex tIndex1,
     TIndex tIndex2) {
@@ -415,9 +421,9 @@ void addTriangleNormalToVertexNormals(
   const uint32_t index1 = static_cast<uint32_t>(tIndex1);
   const uint32_t index2 = static_cast<uint32_t>(tIndex2);
 
-  const glm::vec3& vertex0 = positionView[index0];
-  const glm::vec3& vertex1 = positionView[index1];
-  const glm::vec3& vertex2 = positionView[index2];
+  const glm::vec3 vertex0 = positionView[index0];
+  const glm::vec3 vertex1 = positionView[index1];
+  const glm::vec3 vertex2 = positionView[index2];
 
   const glm::vec3 triangleNormal =
       glm::cross(vertex1 - vertex0, vertex2 - vertex0);
@@ -433,7 +439,7 @@ template <typename TIndex, typename GetIndex>
 bool accumulateNormals(
     int32_t meshPrimitiveMode,
     const gsl::span<glm::vec3>& normals,
-    const AccessorView<glm::vec3>& positionView,
+    const DequantizedAccessorView<glm::vec3>& positionView,
     int64_t numIndices,
     GetIndex getIndex) {
 
@@ -510,7 +516,7 @@ template <typename TIndex>
 void generateSmoothNormals(
     Model& gltf,
     MeshPrimitive& primitive,
-    const AccessorView<glm::vec3>& positionView,
+    const DequantizedAccessorView<glm::vec3>& positionView,
     const std::optional<Accessor>& indexAccessor) {
 
   const size_t count = static_cast<size_t>(positionView.size());
@@ -562,24 +568,45 @@ void generateSmoothNormals(
     }
   }
 
+  // Quantized positions get normalized byte normals, as allowed by
+  // KHR_mesh_quantization, rather than normals four times their size. Each
+  // normal is padded to four bytes to keep vertex attributes aligned.
+  const bool quantize =
+      positionView.componentType() != Accessor::ComponentType::FLOAT;
+  if (quantize) {
+    std::vector<std::byte> quantizedBuffer(count * 4);
+    for (size_t i = 0; i < count; ++i) {
+      const int8_t quantized[4] = {
+          quantizeComponent<int8_t>(normals[i].x, true),
+          quantizeComponent<int8_t>(normals[i].y, true),
+          quantizeComponent<int8_t>(normals[i].z, true),
+          0};
+      std::memcpy(quantizedBuffer.data() + i * 4, quantized, 4);
+    }
+    normalByteBuffer = std::move(quantizedBuffer);
+  }
+
   const size_t normalBufferId = gltf.buffers.size();
   Buffer& normalBuffer = gltf.buffers.emplace_back();
-  normalBuffer.byteLength = static_cast<int64_t>(normalBufferSize);
+  normalBuffer.byteLength = static_cast<int64_t>(normalByteBuffer.size());
   normalBuffer.cesium.data = std::move(normalByteBuffer);
 
   const size_t normalBufferViewId = gltf.bufferViews.size();
   BufferView& normalBufferView = gltf.bufferViews.emplace_back();
   normalBufferView.buffer = static_cast<int32_t>(normalBufferId);
-  normalBufferView.byteLength = static_cast<int64_t>(normalBufferSize);
+  normalBufferView.byteLength = normalBuffer.byteLength;
   normalBufferView.byteOffset = 0;
-  normalBufferView.byteStride = static_cast<int64_t>(normalBufferStride);
+  normalBufferView.byteStride =
+      quantize ? 4 : static_cast<int64_t>(normalBufferStride);
   normalBufferView.target = BufferView::Target::ARRAY_BUFFER;
 
   const size_t normalAccessorId = gltf.accessors.size();
   Accessor& normalAccessor = gltf.accessors.emplace_back();
   normalAccessor.byteOffset = 0;
   normalAccessor.bufferView = static_cast<int32_t>(normalBufferViewId);
-  normalAccessor.componentType = Accessor::ComponentType::FLOAT;
+  normalAccessor.componentType = quantize ? Accessor::ComponentType::BYTE
+                                          : Accessor::ComponentType::FLOAT;
+  normalAccessor.normalized = quantize;
   normalAccessor.count = positionView.size();
   normalAccessor.type = Accessor::Type::VEC3;
 
@@ -591,7 +618,7 @@ void generateSmoothNormals(
 void generateSmoothNormals(
     Model& gltf,
     MeshPrimitive& primitive,
-    const AccessorView<glm::vec3>& positionView,
+    const DequantizedAccessorView<glm::vec3>& positionView,
     const std::optional<Accessor>& indexAccessor) {
   if (indexAccessor) {
     switch (indexAccessor->componentType) {
@@ -629,6 +656,15 @@ void generateSmoothNormals(
 }
 } // namespace
 
+const Model& Model::getFeatureMetadataModel() const {
+  if (!this->pLazyFeatureMetadata ||
+      this->getExtension<ExtensionModelExtFeatureMetadata>()) {
+    return *this;
+  }
+
+  return this->pLazyFeatureMetadata->getModel();
+}
+
 void Model::generateMissingNormalsSmooth() {
   forEachPrimitiveInScene(
       -1,
@@ -650,7 +686,9 @@ void Model::generateMissingNormalsSmooth() {
         }
 
         const int positionAccessorId = positionIt->second;
-        const AccessorView<glm::vec3> positionView(gltf_, positionAccessorId);
+        const DequantizedAccessorView<glm::vec3> positionView(
+            gltf_,
+            positionAccessorId);
         if (positionView.status() != AccessorViewStatus::Valid) {
           return;
         }
@@ -0,0 +1,167 @@
+#include "CesiumGltf/DequantizedAccessorView.h"
+#include "CesiumGltf/Model.h"
+
+#include <catch2/catch.hpp>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace CesiumGltf;
+
+namespace {
+template <typename T>
+Model createModel(
+    const std::vector<T>& values,
+    int32_t componentType,
+    const std::string& type,
+    int64_t count,
+    int64_t byteStride,
+    bool normalized) {
+  Model model;
+
+  Buffer& buffer = model.buffers.emplace_back();
+  buffer.byteLength = static_cast<int64_t>(values.size() * sizeof(T));
+  buffer.cesium.data.resize(size_t(buffer.byteLength));
+  std::memcpy(
+      buffer.cesium.data.data(),
+      values.data(),
+      buffer.cesium.data.size());
+
+  BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = 0;
+  bufferView.byteLength = buffer.byteLength;
+  if (byteStride > 0) {
+    bufferView.byteStride = byteStride;
+  }
+
+  Accessor& accessor = model.accessors.emplace_back();
+  accessor.bufferView = 0;
+  accessor.componentType = componentType;
+  accessor.type = type;
+  accessor.count = count;
+  accessor.normalized = normalized;
+
+  return model;
+}
+} // namespace
+
+TEST_CASE("DequantizedAccessorView reads quantized attributes") {
+  SECTION("Normalized bytes") {
+    const std::vector<int8_t> values = {127, -127, 0, 0, -128, 64, 0, 0};
+    Model model = createModel(
+        values,
+        Accessor::ComponentType::BYTE,
+        Accessor::Type::VEC3,
+        2,
+        4,
+        true);
+
+    DequantizedAccessorView<glm::vec3> view(model, 0);
+    REQUIRE(view.status() == AccessorViewStatus::Valid);
+    REQUIRE(view.size() == 2);
+    CHECK(view.componentType() == Accessor::ComponentType::BYTE);
+    CHECK(view.normalized());
+    CHECK(view[0] == glm::vec3(1.0f, -1.0f, 0.0f));
+    CHECK(view[1].x == -1.0f);
+    CHECK(view[1].y == Approx(64.0f / 127.0f));
+  }
+
+  SECTION("Normalized unsigned shorts") {
+    const std::vector<uint16_t> values = {0, 65535, 32768, 16384};
+    Model model = createModel(
+        values,
+        Accessor::ComponentType::UNSIGNED_SHORT,
+        Accessor::Type::VEC2,
+        2,
+        4,
+        true);
+
+    DequantizedAccessorView<glm::vec2> view(model, 0);
+    REQUIRE(view.status() == AccessorViewStatus::Valid);
+    CHECK(view[0] == glm::vec2(0.0f, 1.0f));
+    CHECK(view[1].x == Approx(32768.0f / 65535.0f));
+    CHECK(view[1].y == Approx(16384.0f / 65535.0f));
+  }
+
+  SECTION("Shorts that are not normalized") {
+    const std::vector<int16_t> values = {-300, 2, 1000, 0};
+    Model model = createModel(
+        values,
+        Accessor::ComponentType::SHORT,
+        Accessor::Type::VEC3,
+        1,
+        8,
+        false);
+
+    DequantizedAccessorView<glm::vec3> view(model, 0);
+    REQUIRE(view.status() == AccessorViewStatus::Valid);
+    CHECK(view[0] == glm::vec3(-300.0f, 2.0f, 1000.0f));
+  }
+
+  SECTION("Floats") {
+    const std::vector<float> values = {1.5f, -2.0f, 3.25f};
+    Model model = createModel(
+        values,
+        Accessor::ComponentType::FLOAT,
+        Accessor::Type::VEC3,
+        1,
+        0,
+        false);
+
+    DequantizedAccessorView<glm::vec3> view(model, 0);
+    REQUIRE(view.status() == AccessorViewStatus::Valid);
+    CHECK(view[0] == glm::vec3(1.5f, -2.0f, 3.25f));
+    CHECK_THROWS(view[1]);
+  }
+
+  SECTION("Mismatched type") {
+    const std::vector<float> values = {1.0f, 2.0f};
+    Model model = createModel(
+        values,
+        Accessor::ComponentType::FLOAT,
+        Accessor::Type::VEC2,
+        1,
+        0,
+        false);
+
+    DequantizedAccessorView<glm::vec3> view(model, 0);
+    CHECK(view.status() == AccessorViewStatus::InvalidType);
+    CHECK(view.size() == 0);
+  }
+
+  SECTION("Buffer view too small") {
+    const std::vector<int16_t> values = {1, 2, 3, 0};
+    Model model = createModel(
+        values,
+        Accessor::ComponentType::SHORT,
+        Accessor::Type::VEC3,
+        2,
+        8,
+        false);
+
+    DequantizedAccessorView<glm::vec3> view(model, 0);
+    CHECK(view.status() == AccessorViewStatus::BufferViewTooSmall);
+  }
+}
+
+TEST_CASE("quantizeComponent inverts dequantizeComponent") {
+  CHECK(quantizeComponent<int8_t>(1.0f, true) == 127);
+  CHECK(quantizeComponent<int8_t>(-1.0f, true) == -127);
+  CHECK(quantizeComponent<int8_t>(2.0f, true) == 127);
+  CHECK(quantizeComponent<uint8_t>(-0.5f, true) == 0);
+  CHECK(quantizeComponent<uint16_t>(0.5f, true) == 32768);
+  CHECK(quantizeComponent<int16_t>(-300.4f, false) == -300);
+  CHECK(quantizeComponent<int16_t>(40000.0f, false) == 32767);
+  CHECK(quantizeComponent<float>(0.25f, true) == 0.25f);
+
+  for (int32_t i = -32767; i <= 32767; i += 255) {
+    const int16_t value = static_cast<int16_t>(i);
+    CHECK(
+        quantizeComponent<int16_t>(dequantizeComponent(value, true), true) ==
+        value);
+  }
+}
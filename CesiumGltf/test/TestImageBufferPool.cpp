@@ -0,0 +1,98 @@
+#include "CesiumGltf/ImageBufferPool.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+using namespace CesiumGltf;
+
+TEST_CASE("ImageBufferPool") {
+  ImageBufferPoolOptions options;
+  options.maximumPooledBytes = 1024 * 1024;
+  options.maximumBuffersPerSizeClass = 2;
+  options.minimumBufferSize = 1024;
+
+  ImageBufferPool pool(options);
+
+  SECTION("reuses released buffers of the same size class") {
+    std::vector<std::byte> buffer = pool.allocate(5000);
+    REQUIRE(buffer.size() == 5000);
+    const size_t capacity = buffer.capacity();
+    CHECK(capacity >= 8192);
+
+    buffer[0] = std::byte(42);
+    const std::byte* pData = buffer.data();
+    pool.release(std::move(buffer));
+
+    ImageBufferPoolStatistics statistics = pool.getStatistics();
+    CHECK(statistics.returns == 1);
+    CHECK(statistics.pooledBuffers == 1);
+    CHECK(statistics.pooledBytes == int64_t(capacity));
+
+    std::vector<std::byte> reused = pool.allocate(6000);
+    CHECK(reused.data() == pData);
+    REQUIRE(reused.size() == 6000);
+    CHECK(std::all_of(reused.begin(), reused.end(), [](std::byte b) {
+      return b == std::byte(0);
+    }));
+
+    statistics = pool.getStatistics();
+    CHECK(statistics.hits == 1);
+    CHECK(statistics.misses == 1);
+    CHECK(statistics.pooledBuffers == 0);
+    CHECK(statistics.pooledBytes == 0);
+    CHECK(statistics.getHitRate() == 0.5);
+  }
+
+  SECTION("does not pool small buffers") {
+    std::vector<std::byte> buffer = pool.allocate(100);
+    CHECK(buffer.size() == 100);
+    pool.release(std::move(buffer));
+
+    const ImageBufferPoolStatistics statistics = pool.getStatistics();
+    CHECK(statistics.hits == 0);
+    CHECK(statistics.misses == 0);
+    CHECK(statistics.discards == 1);
+    CHECK(statistics.pooledBuffers == 0);
+  }
+
+  SECTION("limits the number of buffers in each size class") {
+    std::vector<std::vector<std::byte>> buffers;
+    for (int i = 0; i < 3; ++i) {
+      buffers.emplace_back(pool.allocate(4096));
+    }
+    for (std::vector<std::byte>& buffer : buffers) {
+      pool.release(std::move(buffer));
+    }
+
+    const ImageBufferPoolStatistics statistics = pool.getStatistics();
+    CHECK(statistics.returns == 2);
+    CHECK(statistics.discards == 1);
+    CHECK(statistics.pooledBuffers == 2);
+    CHECK(statistics.pooledBytes >= 8192);
+  }
+
+  SECTION("limits the total size of the pooled buffers") {
+    std::vector<std::byte> first = pool.allocate(600 * 1024);
+    std::vector<std::byte> second = pool.allocate(600 * 1024);
+    pool.release(std::move(first));
+    pool.release(std::move(second));
+
+    // Each buffer has a capacity of 1 MiB, so only the first one fits.
+    ImageBufferPoolStatistics statistics = pool.getStatistics();
+    CHECK(statistics.returns == 1);
+    CHECK(statistics.discards == 1);
+    CHECK(statistics.pooledBytes == 1024 * 1024);
+
+    pool.clear();
+    statistics = pool.getStatistics();
+    CHECK(statistics.pooledBuffers == 0);
+    CHECK(statistics.pooledBytes == 0);
+
+    // The pool accepts buffers again after it is cleared.
+    pool.release(pool.allocate(300 * 1024));
+    CHECK(pool.getStatistics().pooledBuffers == 1);
+  }
+}
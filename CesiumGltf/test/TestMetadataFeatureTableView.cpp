@@ -1,8 +1,13 @@
+#include "CesiumGltf/LazyFeatureMetadata.h"
 #include "CesiumGltf/MetadataFeatureTableView.h"
 
 #include <catch2/catch.hpp>
+#include <gsl/span>
 
+#include <atomic>
 #include <cstring>
+#include <string>
+#include <thread>
 
 using namespace CesiumGltf;
 
@@ -178,6 +183,48 @@ TEST_CASE("Test numeric properties") {
     REQUIRE(
         uint32Property.status() ==
         MetadataPropertyViewStatus::InvalidBufferViewSizeNotFitInstanceCount);
+
+    std::vector<double> copied(values.size());
+    REQUIRE(
+        view.copyPropertyValues(
+            "TestClassProperty",
+            0,
+            gsl::span<double>(copied)) ==
+        MetadataPropertyViewStatus::InvalidBufferViewSizeNotFitInstanceCount);
+  }
+
+  SECTION("Copy property values") {
+    std::vector<double> copied(values.size() - 2);
+    REQUIRE(
+        view.copyPropertyValues(
+            "TestClassProperty",
+            2,
+            gsl::span<double>(copied)) ==
+        MetadataPropertyViewStatus::Valid);
+    for (size_t i = 0; i < copied.size(); ++i) {
+      REQUIRE(copied[i] == static_cast<double>(values[i + 2]));
+    }
+
+    testClassProperty.normalized = true;
+    std::vector<float> normalized(values.size());
+    REQUIRE(
+        view.copyPropertyValues(
+            "TestClassProperty",
+            0,
+            gsl::span<float>(normalized)) == MetadataPropertyViewStatus::Valid);
+    for (size_t i = 0; i < normalized.size(); ++i) {
+      REQUIRE(
+          normalized[i] ==
+          Approx(static_cast<double>(values[i]) / 4294967295.0));
+    }
+
+    std::vector<double> missing(1);
+    REQUIRE(
+        view.copyPropertyValues(
+            "NonExistentProperty",
+            0,
+            gsl::span<double>(missing)) ==
+        MetadataPropertyViewStatus::InvalidPropertyNotExist);
   }
 }
 
@@ -1157,3 +1204,239 @@ TEST_CASE("Test dynamic array of string") {
     }
   }
 }
+
+TEST_CASE("Test lazily converted feature metadata") {
+  std::vector<uint32_t> values = {12, 34, 30, 11, 34, 34, 11, 33, 122, 33};
+
+  std::atomic<int> conversionCount = 0;
+  Model model;
+  model.pLazyFeatureMetadata = std::make_shared<LazyFeatureMetadata>(
+      [&values, &conversionCount](Model& metadataModel) {
+        ++conversionCount;
+
+        Buffer& valueBuffer = metadataModel.buffers.emplace_back();
+        valueBuffer.cesium.data.resize(values.size() * sizeof(uint32_t));
+        valueBuffer.byteLength =
+            static_cast<int64_t>(valueBuffer.cesium.data.size());
+        std::memcpy(
+            valueBuffer.cesium.data.data(),
+            values.data(),
+            valueBuffer.cesium.data.size());
+
+        BufferView& valueBufferView =
+            metadataModel.bufferViews.emplace_back();
+        valueBufferView.buffer = 0;
+        valueBufferView.byteOffset = 0;
+        valueBufferView.byteLength = valueBuffer.byteLength;
+
+        ExtensionModelExtFeatureMetadata& metadata =
+            metadataModel.addExtension<ExtensionModelExtFeatureMetadata>();
+        Schema& schema = metadata.schema.emplace();
+        Class& testClass = schema.classes["TestClass"];
+        testClass.properties["TestClassProperty"].type =
+            ClassProperty::Type::UINT32;
+
+        FeatureTable& featureTable = metadata.featureTables["TestFeatureTable"];
+        featureTable.classProperty = "TestClass";
+        featureTable.count = static_cast<int64_t>(values.size());
+        featureTable.properties["TestClassProperty"].bufferView = 0;
+      });
+
+  REQUIRE(!model.pLazyFeatureMetadata->isConverted());
+  REQUIRE(model.getExtension<ExtensionModelExtFeatureMetadata>() == nullptr);
+
+  SECTION("Convert once when views are created concurrently") {
+    std::vector<std::thread> threads;
+    std::atomic<int> validCount = 0;
+    for (int i = 0; i < 4; ++i) {
+      threads.emplace_back([&model, &values, &validCount]() {
+        MetadataFeatureTableView view(&model, "TestFeatureTable");
+        MetadataPropertyView<uint32_t> property =
+            view.getPropertyView<uint32_t>("TestClassProperty");
+        if (property.status() != MetadataPropertyViewStatus::Valid ||
+            property.size() != static_cast<int64_t>(values.size())) {
+          return;
+        }
+
+        for (int64_t j = 0; j < property.size(); ++j) {
+          if (property.get(j) != values[static_cast<size_t>(j)]) {
+            return;
+          }
+        }
+
+        ++validCount;
+      });
+    }
+
+    for (std::thread& thread : threads) {
+      thread.join();
+    }
+
+    REQUIRE(conversionCount == 1);
+    REQUIRE(validCount == 4);
+    REQUIRE(model.pLazyFeatureMetadata->isConverted());
+    REQUIRE(model.buffers.empty());
+  }
+
+  SECTION("View a feature table of the converted model") {
+    const Model& metadataModel = model.getFeatureMetadataModel();
+    REQUIRE(&metadataModel != &model);
+
+    const ExtensionModelExtFeatureMetadata* pMetadata =
+        metadataModel.getExtension<ExtensionModelExtFeatureMetadata>();
+    REQUIRE(pMetadata != nullptr);
+
+    MetadataFeatureTableView view(
+        &model,
+        &pMetadata->featureTables.at("TestFeatureTable"));
+    MetadataPropertyView<uint32_t> property =
+        view.getPropertyView<uint32_t>("TestClassProperty");
+    REQUIRE(property.status() == MetadataPropertyViewStatus::Valid);
+    REQUIRE(property.get(8) == 122);
+    REQUIRE(conversionCount == 1);
+  }
+
+  SECTION("Missing feature table has no properties") {
+    MetadataFeatureTableView view(&model, "NonExistentFeatureTable");
+    REQUIRE(view.getClassProperty("TestClassProperty") == nullptr);
+    MetadataPropertyView<uint32_t> property =
+        view.getPropertyView<uint32_t>("TestClassProperty");
+    REQUIRE(property.status() != MetadataPropertyViewStatus::Valid);
+  }
+}
+
+TEST_CASE("Benchmark bulk property reads", "[.][benchmark]") {
+  const int64_t instanceCount = 1000000;
+
+  Model model;
+  ExtensionModelExtFeatureMetadata& metadata =
+      model.addExtension<ExtensionModelExtFeatureMetadata>();
+  Schema& schema = metadata.schema.emplace();
+  Class& testClass = schema.classes["TestClass"];
+  FeatureTable& featureTable = metadata.featureTables["TestFeatureTable"];
+  featureTable.classProperty = "TestClass";
+  featureTable.count = instanceCount;
+
+  auto addBufferView = [&model](std::vector<std::byte>&& data) {
+    Buffer& buffer = model.buffers.emplace_back();
+    buffer.byteLength = static_cast<int64_t>(data.size());
+    buffer.cesium.data = std::move(data);
+
+    BufferView& bufferView = model.bufferViews.emplace_back();
+    bufferView.buffer = static_cast<int32_t>(model.buffers.size() - 1);
+    bufferView.byteOffset = 0;
+    bufferView.byteLength = buffer.byteLength;
+    return static_cast<int32_t>(model.bufferViews.size() - 1);
+  };
+
+  {
+    std::vector<std::byte> data(
+        static_cast<size_t>(instanceCount) * sizeof(uint16_t));
+    uint16_t* pValues = reinterpret_cast<uint16_t*>(data.data());
+    for (int64_t i = 0; i < instanceCount; ++i) {
+      pValues[i] = static_cast<uint16_t>(i * 7);
+    }
+
+    ClassProperty& classProperty = testClass.properties["Intensity"];
+    classProperty.type = ClassProperty::Type::UINT16;
+    classProperty.normalized = true;
+    featureTable.properties["Intensity"].bufferView =
+        addBufferView(std::move(data));
+  }
+
+  {
+    std::vector<std::byte> data(
+        static_cast<size_t>(instanceCount) * sizeof(float));
+    float* pValues = reinterpret_cast<float*>(data.data());
+    for (int64_t i = 0; i < instanceCount; ++i) {
+      pValues[i] = static_cast<float>(i) * 0.25f;
+    }
+
+    testClass.properties["Height"].type = ClassProperty::Type::FLOAT32;
+    featureTable.properties["Height"].bufferView =
+        addBufferView(std::move(data));
+  }
+
+  {
+    std::vector<std::byte> data;
+    std::vector<std::byte> offsets(
+        static_cast<size_t>(instanceCount + 1) * sizeof(uint32_t));
+    uint32_t* pOffsets = reinterpret_cast<uint32_t*>(offsets.data());
+    for (int64_t i = 0; i < instanceCount; ++i) {
+      pOffsets[i] = static_cast<uint32_t>(data.size());
+      const std::string name = "building" + std::to_string(i);
+      const std::byte* pName = reinterpret_cast<const std::byte*>(name.data());
+      data.insert(data.end(), pName, pName + name.size());
+    }
+    pOffsets[instanceCount] = static_cast<uint32_t>(data.size());
+
+    testClass.properties["Name"].type = ClassProperty::Type::STRING;
+    FeatureTableProperty& property = featureTable.properties["Name"];
+    property.bufferView = addBufferView(std::move(data));
+    property.stringOffsetBufferView = addBufferView(std::move(offsets));
+    property.offsetType = FeatureTableProperty::OffsetType::UINT32;
+  }
+
+  MetadataFeatureTableView view(&model, &featureTable);
+  MetadataPropertyView<uint16_t> intensity =
+      view.getPropertyView<uint16_t>("Intensity");
+  MetadataPropertyView<float> height = view.getPropertyView<float>("Height");
+  MetadataPropertyView<std::string_view> name =
+      view.getPropertyView<std::string_view>("Name");
+  REQUIRE(intensity.status() == MetadataPropertyViewStatus::Valid);
+  REQUIRE(height.status() == MetadataPropertyViewStatus::Valid);
+  REQUIRE(name.status() == MetadataPropertyViewStatus::Valid);
+
+  std::vector<float> floats(static_cast<size_t>(instanceCount));
+  std::vector<std::string_view> strings(static_cast<size_t>(instanceCount));
+
+  BENCHMARK("Normalize with get") {
+    for (int64_t i = 0; i < instanceCount; ++i) {
+      floats[static_cast<size_t>(i)] =
+          static_cast<float>(intensity.get(i)) / 65535.0f;
+    }
+    return floats.back();
+  };
+
+  BENCHMARK("Normalize with copyNormalizedValues") {
+    intensity.copyNormalizedValues(0, gsl::span<float>(floats));
+    return floats.back();
+  };
+
+  BENCHMARK("Normalize with copyPropertyValues") {
+    view.copyPropertyValues("Intensity", 0, gsl::span<float>(floats));
+    return floats.back();
+  };
+
+  BENCHMARK("Copy floats with get") {
+    for (int64_t i = 0; i < instanceCount; ++i) {
+      floats[static_cast<size_t>(i)] = height.get(i);
+    }
+    return floats.back();
+  };
+
+  BENCHMARK("Copy floats with copyValues") {
+    height.copyValues(0, gsl::span<float>(floats));
+    return floats.back();
+  };
+
+  BENCHMARK("Sum floats with getValues") {
+    double sum = 0.0;
+    for (float value : height.getValues()) {
+      sum += static_cast<double>(value);
+    }
+    return sum;
+  };
+
+  BENCHMARK("Decode strings with get") {
+    for (int64_t i = 0; i < instanceCount; ++i) {
+      strings[static_cast<size_t>(i)] = name.get(i);
+    }
+    return strings.back();
+  };
+
+  BENCHMARK("Decode strings with copyValues") {
+    name.copyValues(0, gsl::span<std::string_view>(strings));
+    return strings.back();
+  };
+}
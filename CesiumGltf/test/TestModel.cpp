@@ -1,4 +1,5 @@
 #include "CesiumGltf/AccessorView.h"
+#include "CesiumGltf/DequantizedAccessorView.h"
 #include "CesiumGltf/Model.h"
 
 #include <catch2/catch.hpp>
@@ -480,4 +481,44 @@ TEST_CASE("Test smooth normal generation") {
     REQUIRE(glm::all(
         glm::epsilonEqual(vertex0Normal, expectedNormal, DEFAULT_EPSILON)));
   }
+  SECTION("Test normal generation for quantized positions") {
+    Model model = createTriangleStrip();
+
+    // Store the positions as shorts padded to 4-byte alignment, as allowed by
+    // KHR_mesh_quantization.
+    const std::vector<int16_t> quantized =
+        {0, 1, 0, 0, 1, 0, 0, 0, 0, 0, -1, 0, 1, 1, -1, 0};
+    Buffer& vertexBuffer = model.buffers[0];
+    vertexBuffer.byteLength =
+        static_cast<int64_t>(quantized.size() * sizeof(int16_t));
+    vertexBuffer.cesium.data.resize(size_t(vertexBuffer.byteLength));
+    std::memcpy(
+        vertexBuffer.cesium.data.data(),
+        quantized.data(),
+        vertexBuffer.cesium.data.size());
+    model.bufferViews[0].byteLength = vertexBuffer.byteLength;
+    model.bufferViews[0].byteStride = 4 * int64_t(sizeof(int16_t));
+    model.accessors[0].componentType = Accessor::ComponentType::SHORT;
+
+    model.generateMissingNormalsSmooth();
+
+    MeshPrimitive& primitive = model.meshes[0].primitives[0];
+    auto normalIt = primitive.attributes.find("NORMAL");
+    REQUIRE(normalIt != primitive.attributes.end());
+
+    const Accessor& normalAccessor = model.accessors[size_t(normalIt->second)];
+    CHECK(normalAccessor.componentType == Accessor::ComponentType::BYTE);
+    CHECK(normalAccessor.normalized);
+
+    DequantizedAccessorView<glm::vec3> normalView(model, normalIt->second);
+    REQUIRE(normalView.status() == AccessorViewStatus::Valid);
+    REQUIRE(normalView.size() == 4);
+
+    const glm::vec3 expectedNormal(0.0f, 1.0f, 0.0f);
+    CHECK(glm::all(
+        glm::epsilonEqual(normalView[1], expectedNormal, DEFAULT_EPSILON)));
+    CHECK(glm::all(
+        glm::epsilonEqual(normalView[2], expectedNormal, DEFAULT_EPSILON)));
+  }
 }
+
@@ -3,6 +3,7 @@
 #include <catch2/catch.hpp>
 #include <gsl/span>
 
+#include <algorithm>
 #include <bitset>
 #include <climits>
 #include <cstddef>
@@ -26,6 +27,29 @@ template <typename T> static void checkNumeric(const std::vector<T>& expected) {
   for (int64_t i = 0; i < property.size(); ++i) {
     REQUIRE(property.get(i) == expected[static_cast<size_t>(i)]);
   }
+
+  gsl::span<const T> values = property.getValues();
+  REQUIRE(values.size() == expected.size());
+  REQUIRE(std::equal(values.begin(), values.end(), expected.begin()));
+
+  std::vector<T> copied(expected.size() - 1);
+  property.copyValues(1, gsl::span<T>(copied));
+  REQUIRE(std::equal(copied.begin(), copied.end(), expected.begin() + 1));
+
+  std::vector<double> converted(expected.size());
+  property.copyValues(0, gsl::span<double>(converted));
+  for (size_t i = 0; i < expected.size(); ++i) {
+    REQUIRE(converted[i] == static_cast<double>(expected[i]));
+  }
+
+  const std::vector<uint32_t> instances{3, 0, 3, 1};
+  std::vector<T> gathered(instances.size());
+  property.copyValues(
+      gsl::span<const uint32_t>(instances),
+      gsl::span<T>(gathered));
+  for (size_t i = 0; i < instances.size(); ++i) {
+    REQUIRE(gathered[i] == expected[instances[i]]);
+  }
 }
 
 template <typename T, typename E>
@@ -63,6 +87,21 @@ static void checkDynamicArray(
   }
 
   REQUIRE(expectedIdx == data.size());
+
+  std::vector<CesiumGltf::MetadataArrayView<T>> arrays(
+      static_cast<size_t>(instanceCount));
+  property.copyValues(
+      0,
+      gsl::span<CesiumGltf::MetadataArrayView<T>>(arrays));
+  expectedIdx = 0;
+  for (const CesiumGltf::MetadataArrayView<T>& vals : arrays) {
+    for (int64_t j = 0; j < vals.size(); ++j) {
+      REQUIRE(vals[j] == data[expectedIdx]);
+      ++expectedIdx;
+    }
+  }
+
+  REQUIRE(expectedIdx == data.size());
 }
 
 template <typename T>
@@ -139,6 +178,12 @@ TEST_CASE("Check boolean value") {
   for (int64_t i = 0; i < property.size(); ++i) {
     REQUIRE(property.get(i) == bits[static_cast<size_t>(i)]);
   }
+
+  std::vector<uint8_t> copied(instanceCount - 3);
+  property.copyValues(3, gsl::span<uint8_t>(copied));
+  for (size_t i = 0; i < copied.size(); ++i) {
+    REQUIRE(copied[i] == (bits[i + 3] ? 1 : 0));
+  }
 }
 
 TEST_CASE("Check string value") {
@@ -189,6 +234,74 @@ TEST_CASE("Check string value") {
   for (int64_t i = 0; i < property.size(); ++i) {
     REQUIRE(property.get(i) == strings[static_cast<size_t>(i)]);
   }
+
+  std::vector<std::string_view> copied(strings.size());
+  property.copyValues(0, gsl::span<std::string_view>(copied));
+  for (size_t i = 0; i < strings.size(); ++i) {
+    REQUIRE(copied[i] == strings[i]);
+  }
+
+  const std::vector<int64_t> instances{2, 1};
+  std::vector<std::string_view> gathered(instances.size());
+  property.copyValues(
+      gsl::span<const int64_t>(instances),
+      gsl::span<std::string_view>(gathered));
+  REQUIRE(gathered[0] == strings[2]);
+  REQUIRE(gathered[1] == strings[1]);
+}
+
+TEST_CASE("Check normalized values") {
+  SECTION("Uint8") {
+    std::vector<uint8_t> values{0, 51, 255};
+    std::vector<std::byte> data(values.size());
+    std::memcpy(data.data(), values.data(), data.size());
+
+    CesiumGltf::MetadataPropertyView<uint8_t> property(
+        CesiumGltf::MetadataPropertyViewStatus::Valid,
+        gsl::span<const std::byte>(data.data(), data.size()),
+        gsl::span<const std::byte>(),
+        gsl::span<const std::byte>(),
+        CesiumGltf::PropertyType::None,
+        0,
+        static_cast<int64_t>(values.size()));
+
+    std::vector<float> normalized(values.size());
+    property.copyNormalizedValues(0, gsl::span<float>(normalized));
+    REQUIRE(normalized[0] == 0.0f);
+    REQUIRE(normalized[1] == Approx(0.2f));
+    REQUIRE(normalized[2] == 1.0f);
+  }
+
+  SECTION("Int16") {
+    std::vector<int16_t> values{-32768, -32767, 0, 16384, 32767};
+    std::vector<std::byte> data(values.size() * sizeof(int16_t));
+    std::memcpy(data.data(), values.data(), data.size());
+
+    CesiumGltf::MetadataPropertyView<int16_t> property(
+        CesiumGltf::MetadataPropertyViewStatus::Valid,
+        gsl::span<const std::byte>(data.data(), data.size()),
+        gsl::span<const std::byte>(),
+        gsl::span<const std::byte>(),
+        CesiumGltf::PropertyType::None,
+        0,
+        static_cast<int64_t>(values.size()));
+
+    std::vector<double> normalized(values.size());
+    property.copyNormalizedValues(0, gsl::span<double>(normalized));
+    REQUIRE(normalized[0] == -1.0);
+    REQUIRE(normalized[1] == -1.0);
+    REQUIRE(normalized[2] == 0.0);
+    REQUIRE(normalized[3] == Approx(16384.0 / 32767.0));
+    REQUIRE(normalized[4] == 1.0);
+
+    const std::vector<uint16_t> instances{4, 2};
+    std::vector<double> gathered(instances.size());
+    property.copyNormalizedValues(
+        gsl::span<const uint16_t>(instances),
+        gsl::span<double>(gathered));
+    REQUIRE(gathered[0] == 1.0);
+    REQUIRE(gathered[1] == 0.0);
+  }
 }
 
 TEST_CASE("Check fixed numeric array") {
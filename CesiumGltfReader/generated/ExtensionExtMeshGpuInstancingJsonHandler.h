@@ -0,0 +1,95 @@
+// This file was generated by generate-classes.
+// DO NOT EDIT THIS FILE!
+#pragma once
+
+#include <CesiumGltf/ExtensionExtMeshGpuInstancing.h>
+#include <CesiumJsonReader/DictionaryJsonHandler.h>
+#include <CesiumJsonReader/ExtensibleObjectJsonHandler.h>
+#include <CesiumJsonReader/IntegerJsonHandler.h>
+
+namespace CesiumJsonReader {
+class ExtensionReaderContext;
+}
+
+namespace CesiumGltf {
+class ExtensionExtMeshGpuInstancingJsonHandler
+    : public CesiumJsonReader::ExtensibleObjectJsonHandler,
+      public CesiumJsonReader::IExtensionJsonHandler {
+public:
+  using ValueType = ExtensionExtMeshGpuInstancing;
+
+  static inline constexpr const char* ExtensionName =
+      "EXT_mesh_gpu_instancing";
+
+  ExtensionExtMeshGpuInstancingJsonHandler(
+      const CesiumJsonReader::ExtensionReaderContext& context) noexcept;
+  void reset(
+      IJsonHandler* pParentHandler,
+      ExtensionExtMeshGpuInstancing* pObject);
+
+  virtual IJsonHandler* readObjectKey(const std::string_view& str) override;
+
+  virtual void reset(
+      IJsonHandler* pParentHandler,
+      CesiumUtility::ExtensibleObject& o,
+      const std::string_view& extensionName) override;
+
+  virtual IJsonHandler* readNull() override {
+    return CesiumJsonReader::ExtensibleObjectJsonHandler::readNull();
+  };
+  virtual IJsonHandler* readBool(bool b) override {
+    return CesiumJsonReader::ExtensibleObjectJsonHandler::readBool(b);
+  }
+  virtual IJsonHandler* readInt32(int32_t i) override {
+    return CesiumJsonReader::ExtensibleObjectJsonHandler::readInt32(i);
+  }
+  virtual IJsonHandler* readUint32(uint32_t i) override {
+    return CesiumJsonReader::ExtensibleObjectJsonHandler::readUint32(i);
+  }
+  virtual IJsonHandler* readInt64(int64_t i) override {
+    return CesiumJsonReader::ExtensibleObjectJsonHandler::readInt64(i);
+  }
+  virtual IJsonHandler* readUint64(uint64_t i) override {
+    return CesiumJsonReader::ExtensibleObjectJsonHandler::readUint64(i);
+  }
+  virtual IJsonHandler* readDouble(double d) override {
+    return CesiumJsonReader::ExtensibleObjectJsonHandler::readDouble(d);
+  }
+  virtual IJsonHandler* readString(const std::string_view& str) override {
+    return CesiumJsonReader::ExtensibleObjectJsonHandler::readString(str);
+  }
+  virtual IJsonHandler* readObjectStart() override {
+    return CesiumJsonReader::ExtensibleObjectJsonHandler::readObjectStart();
+  }
+  virtual IJsonHandler* readObjectEnd() override {
+    return CesiumJsonReader::ExtensibleObjectJsonHandler::readObjectEnd();
+  }
+  virtual IJsonHandler* readArrayStart() override {
+    return CesiumJsonReader::ExtensibleObjectJsonHandler::readArrayStart();
+  }
+  virtual IJsonHandler* readArrayEnd() override {
+    return CesiumJsonReader::ExtensibleObjectJsonHandler::readArrayEnd();
+  }
+  virtual void reportWarning(
+      const std::string& warning,
+      std::vector<std::string>&& context =
+          std::vector<std::string>()) override {
+    CesiumJsonReader::ExtensibleObjectJsonHandler::reportWarning(
+        warning,
+        std::move(context));
+  }
+
+protected:
+  IJsonHandler* readObjectKeyExtensionExtMeshGpuInstancing(
+      const std::string& objectType,
+      const std::string_view& str,
+      ExtensionExtMeshGpuInstancing& o);
+
+private:
+  ExtensionExtMeshGpuInstancing* _pObject = nullptr;
+  CesiumJsonReader::DictionaryJsonHandler<
+      int32_t,
+      CesiumJsonReader::IntegerJsonHandler<int32_t>>
+      _attributes;
+};
+} // namespace CesiumGltf
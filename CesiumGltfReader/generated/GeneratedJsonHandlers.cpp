@@ -209,6 +209,202 @@ ExtensionMeshPrimitiveExtFeatureMetadataJsonHandler::
 }
 // This file was generated by generate-classes.
 // DO NOT EDIT THIS FILE!
+#include "ExtensionExtMeshGpuInstancingJsonHandler.h"
+
+#include <CesiumGltf/ExtensionExtMeshGpuInstancing.h>
+
+#include <cassert>
+#include <string>
+
+using namespace CesiumGltf;
+
+ExtensionExtMeshGpuInstancingJsonHandler::
+    ExtensionExtMeshGpuInstancingJsonHandler(
+        const CesiumJsonReader::ExtensionReaderContext& context) noexcept
+    : CesiumJsonReader::ExtensibleObjectJsonHandler(context),
+      _attributes() {}
+
+void ExtensionExtMeshGpuInstancingJsonHandler::reset(
+    CesiumJsonReader::IJsonHandler* pParentHandler,
+    ExtensionExtMeshGpuInstancing* pObject) {
+  CesiumJsonReader::ExtensibleObjectJsonHandler::reset(pParentHandler, pObject);
+  this->_pObject = pObject;
+}
+
+CesiumJsonReader::IJsonHandler*
+ExtensionExtMeshGpuInstancingJsonHandler::readObjectKey(
+    const std::string_view& str) {
+  assert(this->_pObject);
+  return this->readObjectKeyExtensionExtMeshGpuInstancing(
+      ExtensionExtMeshGpuInstancing::TypeName,
+      str,
+      *this->_pObject);
+}
+
+void ExtensionExtMeshGpuInstancingJsonHandler::reset(
+    CesiumJsonReader::IJsonHandler* pParentHandler,
+    CesiumUtility::ExtensibleObject& o,
+    const std::string_view& extensionName) {
+  std::any& value =
+      o.extensions.emplace(extensionName, ExtensionExtMeshGpuInstancing())
+          .first->second;
+  this->reset(
+      pParentHandler,
+      &std::any_cast<ExtensionExtMeshGpuInstancing&>(value));
+}
+
+CesiumJsonReader::IJsonHandler* ExtensionExtMeshGpuInstancingJsonHandler::
+    readObjectKeyExtensionExtMeshGpuInstancing(
+        const std::string& objectType,
+        const std::string_view& str,
+        ExtensionExtMeshGpuInstancing& o) {
+  using namespace std::string_literals;
+
+  if ("attributes"s == str)
+    return property("attributes", this->_attributes, o.attributes);
+
+  return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
+}
+// This file was generated by generate-classes.
+// DO NOT EDIT THIS FILE!
+#include "ExtensionBufferViewExtMeshoptCompressionJsonHandler.h"
+
+#include <CesiumGltf/ExtensionBufferViewExtMeshoptCompression.h>
+
+#include <cassert>
+#include <string>
+
+using namespace CesiumGltf;
+
+ExtensionBufferViewExtMeshoptCompressionJsonHandler::
+    ExtensionBufferViewExtMeshoptCompressionJsonHandler(
+        const CesiumJsonReader::ExtensionReaderContext& context) noexcept
+    : CesiumJsonReader::ExtensibleObjectJsonHandler(context),
+      _buffer(),
+      _byteOffset(),
+      _byteLength(),
+      _byteStride(),
+      _count(),
+      _mode(),
+      _filter() {}
+
+void ExtensionBufferViewExtMeshoptCompressionJsonHandler::reset(
+    CesiumJsonReader::IJsonHandler* pParentHandler,
+    ExtensionBufferViewExtMeshoptCompression* pObject) {
+  CesiumJsonReader::ExtensibleObjectJsonHandler::reset(pParentHandler, pObject);
+  this->_pObject = pObject;
+}
+
+CesiumJsonReader::IJsonHandler*
+ExtensionBufferViewExtMeshoptCompressionJsonHandler::readObjectKey(
+    const std::string_view& str) {
+  assert(this->_pObject);
+  return this->readObjectKeyExtensionBufferViewExtMeshoptCompression(
+      ExtensionBufferViewExtMeshoptCompression::TypeName,
+      str,
+      *this->_pObject);
+}
+
+void ExtensionBufferViewExtMeshoptCompressionJsonHandler::reset(
+    CesiumJsonReader::IJsonHandler* pParentHandler,
+    CesiumUtility::ExtensibleObject& o,
+    const std::string_view& extensionName) {
+  std::any& value =
+      o.extensions
+          .emplace(extensionName, ExtensionBufferViewExtMeshoptCompression())
+          .first->second;
+  this->reset(
+      pParentHandler,
+      &std::any_cast<ExtensionBufferViewExtMeshoptCompression&>(value));
+}
+
+CesiumJsonReader::IJsonHandler*
+ExtensionBufferViewExtMeshoptCompressionJsonHandler::
+    readObjectKeyExtensionBufferViewExtMeshoptCompression(
+        const std::string& objectType,
+        const std::string_view& str,
+        ExtensionBufferViewExtMeshoptCompression& o) {
+  using namespace std::string_literals;
+
+  if ("buffer"s == str)
+    return property("buffer", this->_buffer, o.buffer);
+  if ("byteOffset"s == str)
+    return property("byteOffset", this->_byteOffset, o.byteOffset);
+  if ("byteLength"s == str)
+    return property("byteLength", this->_byteLength, o.byteLength);
+  if ("byteStride"s == str)
+    return property("byteStride", this->_byteStride, o.byteStride);
+  if ("count"s == str)
+    return property("count", this->_count, o.count);
+  if ("mode"s == str)
+    return property("mode", this->_mode, o.mode);
+  if ("filter"s == str)
+    return property("filter", this->_filter, o.filter);
+
+  return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
+}
+// This file was generated by generate-classes.
+// DO NOT EDIT THIS FILE!
+#include "ExtensionBufferExtMeshoptCompressionJsonHandler.h"
+
+#include <CesiumGltf/ExtensionBufferExtMeshoptCompression.h>
+
+#include <cassert>
+#include <string>
+
+using namespace CesiumGltf;
+
+ExtensionBufferExtMeshoptCompressionJsonHandler::
+    ExtensionBufferExtMeshoptCompressionJsonHandler(
+        const CesiumJsonReader::ExtensionReaderContext& context) noexcept
+    : CesiumJsonReader::ExtensibleObjectJsonHandler(context),
+      _fallback() {}
+
+void ExtensionBufferExtMeshoptCompressionJsonHandler::reset(
+    CesiumJsonReader::IJsonHandler* pParentHandler,
+    ExtensionBufferExtMeshoptCompression* pObject) {
+  CesiumJsonReader::ExtensibleObjectJsonHandler::reset(pParentHandler, pObject);
+  this->_pObject = pObject;
+}
+
+CesiumJsonReader::IJsonHandler*
+ExtensionBufferExtMeshoptCompressionJsonHandler::readObjectKey(
+    const std::string_view& str) {
+  assert(this->_pObject);
+  return this->readObjectKeyExtensionBufferExtMeshoptCompression(
+      ExtensionBufferExtMeshoptCompression::TypeName,
+      str,
+      *this->_pObject);
+}
+
+void ExtensionBufferExtMeshoptCompressionJsonHandler::reset(
+    CesiumJsonReader::IJsonHandler* pParentHandler,
+    CesiumUtility::ExtensibleObject& o,
+    const std::string_view& extensionName) {
+  std::any& value =
+      o.extensions
+          .emplace(extensionName, ExtensionBufferExtMeshoptCompression())
+          .first->second;
+  this->reset(
+      pParentHandler,
+      &std::any_cast<ExtensionBufferExtMeshoptCompression&>(value));
+}
+
+CesiumJsonReader::IJsonHandler*
+ExtensionBufferExtMeshoptCompressionJsonHandler::
+    readObjectKeyExtensionBufferExtMeshoptCompression(
+        const std::string& objectType,
+        const std::string_view& str,
+        ExtensionBufferExtMeshoptCompression& o) {
+  using namespace std::string_literals;
+
+  if ("fallback"s == str)
+    return property("fallback", this->_fallback, o.fallback);
+
+  return this->readObjectKeyExtensibleObject(objectType, str, *this->_pObject);
+}
+// This file was generated by generate-classes.
+// DO NOT EDIT THIS FILE!
 #include "FeatureIDTextureJsonHandler.h"
 
 #include <CesiumGltf/FeatureIDTexture.h>
@@ -6,6 +6,7 @@
 #include <CesiumAsync/Future.h>
 #include <CesiumAsync/HttpHeaders.h>
 #include <CesiumAsync/IAssetAccessor.h>
+#include <CesiumGltf/ImageBufferPool.h>
 #include <CesiumGltf/Model.h>
 #include <CesiumJsonReader/ExtensionReaderContext.h>
 #include <CesiumJsonReader/IExtensionJsonHandler.h>
@@ -15,6 +16,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -22,6 +24,8 @@
 
 namespace CesiumGltf {
 
+class ModelReaderJsonHandler;
+
 /**
  * @brief The result of reading a glTF model with
  * {@link GltfReader::readModel}.
@@ -100,6 +104,57 @@ struct CESIUMGLTFREADER_API ReadModelOptions {
    * extension should be automatically decoded as part of the load process.
    */
   bool decodeDraco = true;
+
+  /**
+   * @brief Whether buffer views compressed using the `EXT_meshopt_compression`
+   * extension should be automatically decoded as part of the load process.
+   *
+   * The decoded data is written to the fallback buffer of each compressed
+   * buffer view, so the buffer views can then be used like any others.
+   */
+  bool decodeMeshOpt = true;
+
+  /**
+   * @brief Whether the `animations` of the glTF should be read.
+   *
+   * When false, they are skipped without being parsed, and
+   * {@link Model::animations} is empty.
+   */
+  bool readAnimations = true;
+
+  /**
+   * @brief Whether the `skins` of the glTF should be read.
+   *
+   * When false, they are skipped without being parsed, and
+   * {@link Model::skins} is empty.
+   */
+  bool readSkins = true;
+
+  /**
+   * @brief Whether the `cameras` of the glTF should be read.
+   *
+   * When false, they are skipped without being parsed, and
+   * {@link Model::cameras} is empty.
+   */
+  bool readCameras = true;
+
+  /**
+   * @brief Whether the `extras` of the objects in the glTF should be read.
+   *
+   * When false, they are skipped without being parsed, and the
+   * {@link CesiumUtility::ExtensibleObject::extras} of every object are empty.
+   */
+  bool readExtras = true;
+
+  /**
+   * @brief Whether extensions should be read when they have no
+   * statically-typed class registered and no state of their own set with
+   * {@link CesiumJsonReader::ExtensionReaderContext::setExtensionState}.
+   *
+   * When true, they are read into a {@link CesiumUtility::JsonValue}. When
+   * false, they are skipped without being parsed.
+   */
+  bool readUnknownExtensions = true;
 };
 
 /**
@@ -112,6 +167,28 @@ public:
    */
   GltfReader();
 
+  /**
+   * @brief Copies the extensions of another reader.
+   */
+  GltfReader(const GltfReader& rhs);
+
+  /**
+   * @brief Moves the extensions of another reader.
+   */
+  GltfReader(GltfReader&& rhs) noexcept;
+
+  ~GltfReader() noexcept;
+
+  /**
+   * @brief Copies the extensions of another reader.
+   */
+  GltfReader& operator=(const GltfReader& rhs);
+
+  /**
+   * @brief Moves the extensions of another reader.
+   */
+  GltfReader& operator=(GltfReader&& rhs) noexcept;
+
   /**
    * @brief Gets the context used to control how extensions are loaded from glTF
    * files.
@@ -160,12 +237,23 @@ public:
    * images in `JPG`, `PNG`, `TGA`, `BMP`, `PSD`, `GIF`, `HDR`, or `PIC` format.
    *
    * @param data The buffer from which to read the image.
+   * @param pBufferPool The pool from which to allocate the pixel data of the
+   * image, or `nullptr` to allocate it directly.
    * @return The result of reading the image.
    */
-  static ImageReaderResult readImage(const gsl::span<const std::byte>& data);
+  static ImageReaderResult readImage(
+      const gsl::span<const std::byte>& data,
+      ImageBufferPool* pBufferPool = nullptr);
 
 private:
   CesiumJsonReader::ExtensionReaderContext _context;
+
+  // Building the tree of JSON handlers for a model takes many small
+  // allocations, so the handlers are kept and reused by later reads. There is
+  // one set for each model that is being read at the same time. The handlers
+  // refer to this reader's _context, so copies and moves start with none.
+  mutable std::mutex _modelHandlersMutex;
+  mutable std::vector<std::unique_ptr<ModelReaderJsonHandler>> _modelHandlers;
 };
 
 } // namespace CesiumGltf
@@ -6,12 +6,16 @@
 #include "CesiumJsonReader/JsonReader.h"
 #include "CesiumUtility/Tracing.h"
 #include "CesiumUtility/Uri.h"
+#include "ExtensionBufferExtMeshoptCompressionJsonHandler.h"
+#include "ExtensionBufferViewExtMeshoptCompressionJsonHandler.h"
+#include "ExtensionExtMeshGpuInstancingJsonHandler.h"
 #include "ExtensionKhrDracoMeshCompressionJsonHandler.h"
 #include "ExtensionMeshPrimitiveExtFeatureMetadataJsonHandler.h"
 #include "ExtensionModelExtFeatureMetadataJsonHandler.h"
 #include "ModelJsonHandler.h"
 #include "decodeDataUrls.h"
 #include "decodeDraco.h"
+#include "decodeMeshOpt.h"
 
 #include <CesiumJsonReader/ExtensionReaderContext.h>
 #include <CesiumJsonReader/JsonHandler.h>
@@ -23,6 +27,8 @@
 #include <algorithm>
 #include <cstddef>
 #include <iomanip>
+#include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 
@@ -35,6 +41,50 @@ using namespace CesiumGltf;
 using namespace CesiumJsonReader;
 using namespace CesiumUtility;
 
+namespace CesiumGltf {
+
+/**
+ * @brief Reads a model, skipping the top-level properties that the
+ * {@link ReadModelOptions} say are not needed.
+ *
+ * This is the root of the handlers of a read, so it also gives them the
+ * {@link JsonReaderOptions} that control how `extras` and extensions are read.
+ */
+class ModelReaderJsonHandler : public ModelJsonHandler {
+public:
+  ModelReaderJsonHandler(const ExtensionReaderContext& context) noexcept
+      : ModelJsonHandler(context), _pOptions(nullptr), _readerOptions() {}
+
+  void setOptions(const ReadModelOptions& options) noexcept {
+    this->_pOptions = &options;
+    this->_readerOptions.readExtras = options.readExtras;
+    this->_readerOptions.readUnknownExtensions = options.readUnknownExtensions;
+  }
+
+  virtual const JsonReaderOptions& getReaderOptions() const noexcept override {
+    return this->_readerOptions;
+  }
+
+  virtual IJsonHandler* readObjectKey(const std::string_view& str) override {
+    if (this->_pOptions) {
+      const ReadModelOptions& options = *this->_pOptions;
+      if ((!options.readAnimations && str == "animations") ||
+          (!options.readSkins && str == "skins") ||
+          (!options.readCameras && str == "cameras")) {
+        return this->ignoreAndContinue();
+      }
+    }
+
+    return ModelJsonHandler::readObjectKey(str);
+  }
+
+private:
+  const ReadModelOptions* _pOptions;
+  JsonReaderOptions _readerOptions;
+};
+
+} // namespace CesiumGltf
+
 namespace {
 
 #pragma pack(push, 1)
@@ -59,12 +109,11 @@ bool isBinaryGltf(const gsl::span<const std::byte>& data) noexcept {
 }
 
 ModelReaderResult readJsonModel(
-    const CesiumJsonReader::ExtensionReaderContext& context,
+    ModelReaderJsonHandler& modelHandler,
     const gsl::span<const std::byte>& data) {
 
   CESIUM_TRACE("CesiumGltf::ModelReader::readJsonModel");
 
-  ModelJsonHandler modelHandler(context);
   ReadJsonResult<Model> jsonResult = JsonReader::readJson(data, modelHandler);
 
   return ModelReaderResult{
@@ -96,7 +145,7 @@ std::string toMagicString(uint32_t i) {
 } // namespace
 
 ModelReaderResult readBinaryModel(
-    const CesiumJsonReader::ExtensionReaderContext& context,
+    ModelReaderJsonHandler& modelHandler,
     const gsl::span<const std::byte>& data) {
   CESIUM_TRACE("CesiumGltf::ModelReader::readBinaryModel");
 
@@ -185,7 +234,7 @@ ModelReaderResult readBinaryModel(
     binaryChunk = glbData.subspan(binaryStart, pBinaryChunkHeader->chunkLength);
   }
 
-  ModelReaderResult result = readJsonModel(context, jsonChunk);
+  ModelReaderResult result = readJsonModel(modelHandler, jsonChunk);
 
   if (result.model && !binaryChunk.empty()) {
     Model& model = result.model.value();
@@ -229,6 +278,10 @@ void postprocess(
     decodeDataUrls(reader, readModel, options.clearDecodedDataUrls);
   }
 
+  if (options.decodeMeshOpt) {
+    decodeMeshOpt(readModel);
+  }
+
   if (options.decodeEmbeddedImages) {
     CESIUM_TRACE("CesiumGltf::decodeEmbeddedImages");
     for (Image& image : model.images) {
@@ -286,7 +339,8 @@ void postprocess(
 
 } // namespace
 
-GltfReader::GltfReader() : _context() {
+GltfReader::GltfReader()
+    : _context(), _modelHandlersMutex(), _modelHandlers() {
   this->_context.registerExtension<
       MeshPrimitive,
       ExtensionKhrDracoMeshCompressionJsonHandler>();
@@ -296,6 +350,48 @@ GltfReader::GltfReader() : _context() {
   this->_context.registerExtension<
       MeshPrimitive,
       ExtensionMeshPrimitiveExtFeatureMetadataJsonHandler>();
+
+  this->_context
+      .registerExtension<Node, ExtensionExtMeshGpuInstancingJsonHandler>();
+
+  this->_context.registerExtension<
+      BufferView,
+      ExtensionBufferViewExtMeshoptCompressionJsonHandler>();
+  this->_context.registerExtension<
+      Buffer,
+      ExtensionBufferExtMeshoptCompressionJsonHandler>();
+}
+
+GltfReader::GltfReader(const GltfReader& rhs)
+    : _context(rhs._context), _modelHandlersMutex(), _modelHandlers() {}
+
+GltfReader::GltfReader(GltfReader&& rhs) noexcept
+    : _context(std::move(rhs._context)),
+      _modelHandlersMutex(),
+      _modelHandlers() {}
+
+GltfReader::~GltfReader() noexcept = default;
+
+GltfReader& GltfReader::operator=(const GltfReader& rhs) {
+  if (this != &rhs) {
+    this->_context = rhs._context;
+
+    std::lock_guard<std::mutex> lock(this->_modelHandlersMutex);
+    this->_modelHandlers.clear();
+  }
+
+  return *this;
+}
+
+GltfReader& GltfReader::operator=(GltfReader&& rhs) noexcept {
+  if (this != &rhs) {
+    this->_context = std::move(rhs._context);
+
+    std::lock_guard<std::mutex> lock(this->_modelHandlersMutex);
+    this->_modelHandlers.clear();
+  }
+
+  return *this;
 }
 
 CesiumJsonReader::ExtensionReaderContext& GltfReader::getExtensions() {
@@ -311,10 +407,30 @@ ModelReaderResult GltfReader::readModel(
     const gsl::span<const std::byte>& data,
     const ReadModelOptions& options) const {
 
-  const CesiumJsonReader::ExtensionReaderContext& context =
-      this->getExtensions();
-  ModelReaderResult result = isBinaryGltf(data) ? readBinaryModel(context, data)
-                                                : readJsonModel(context, data);
+  std::unique_ptr<ModelReaderJsonHandler> pModelHandler;
+  {
+    std::lock_guard<std::mutex> lock(this->_modelHandlersMutex);
+    if (!this->_modelHandlers.empty()) {
+      pModelHandler = std::move(this->_modelHandlers.back());
+      this->_modelHandlers.pop_back();
+    }
+  }
+
+  if (!pModelHandler) {
+    pModelHandler =
+        std::make_unique<ModelReaderJsonHandler>(this->getExtensions());
+  }
+
+  pModelHandler->setOptions(options);
+
+  ModelReaderResult result = isBinaryGltf(data)
+                                 ? readBinaryModel(*pModelHandler, data)
+                                 : readJsonModel(*pModelHandler, data);
+
+  {
+    std::lock_guard<std::mutex> lock(this->_modelHandlersMutex);
+    this->_modelHandlers.emplace_back(std::move(pModelHandler));
+  }
 
   if (result.model) {
     postprocess(*this, result, options);
@@ -445,8 +561,9 @@ Future<ModelReaderResult> GltfReader::resolveExternalData(
 }
 
 /*static*/
-ImageReaderResult
-GltfReader::readImage(const gsl::span<const std::byte>& data) {
+ImageReaderResult GltfReader::readImage(
+    const gsl::span<const std::byte>& data,
+    ImageBufferPool* pBufferPool) {
   CESIUM_TRACE("CesiumGltf::readImage");
 
   ImageReaderResult result;
@@ -474,7 +591,12 @@ GltfReader::readImage(const gsl::span<const std::byte>& data) {
     // reinterpret_cast to (safely) force the conversion.
     const auto lastByte =
         image.width * image.height * image.channels * image.bytesPerChannel;
-    image.pixelData.resize(static_cast<std::size_t>(lastByte));
+    if (pBufferPool) {
+      image.pixelData =
+          pBufferPool->allocate(static_cast<std::size_t>(lastByte));
+    } else {
+      image.pixelData.resize(static_cast<std::size_t>(lastByte));
+    }
     std::uint8_t* u8Pointer =
         reinterpret_cast<std::uint8_t*>(image.pixelData.data());
     std::copy(pImage, pImage + lastByte, u8Pointer);
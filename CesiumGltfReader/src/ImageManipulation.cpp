@@ -2,14 +2,134 @@
 
 #include <CesiumGltf/ImageCesium.h>
 
+#include <glm/common.hpp>
+
+#include <algorithm>
 #include <cassert>
 #include <cstring>
+#include <vector>
 
 #define STB_IMAGE_RESIZE_IMPLEMENTATION
 #include <stb_image_resize.h>
 
 using namespace CesiumGltf;
 
+namespace {
+
+// Bilinear weights are fixed point with this many fractional bits.
+constexpr uint32_t WEIGHT_BITS = 8;
+constexpr uint32_t WEIGHT_ONE = 1U << WEIGHT_BITS;
+
+struct BilinearTap {
+  size_t first;
+  size_t second;
+  uint32_t weight;
+};
+
+// Computes, for each target pixel along one axis, the two source pixels it
+// interpolates between and the weight of the second one. Pixel centers are
+// aligned and source pixels are clamped at the edges.
+std::vector<BilinearTap>
+computeBilinearTaps(size_t sourceSize, size_t targetSize) {
+  std::vector<BilinearTap> taps(targetSize);
+  const double scale = double(sourceSize) / double(targetSize);
+  for (size_t i = 0; i < targetSize; ++i) {
+    const double position = glm::max((double(i) + 0.5) * scale - 0.5, 0.0);
+    const size_t first = std::min(size_t(position), sourceSize - 1);
+    const size_t second = std::min(first + 1, sourceSize - 1);
+    const double fraction = position - double(first);
+    taps[i] = BilinearTap{
+        first,
+        second,
+        uint32_t(fraction * double(WEIGHT_ONE) + 0.5)};
+  }
+  return taps;
+}
+
+// Enlarges an 8-bit-per-channel image with bilinear filtering.
+void upsampleBilinear(
+    std::byte* pTarget,
+    size_t targetRowStride,
+    size_t targetWidth,
+    size_t targetHeight,
+    const std::byte* pSource,
+    size_t sourceRowStride,
+    size_t sourceWidth,
+    size_t sourceHeight,
+    size_t channels) {
+  const std::vector<BilinearTap> columns =
+      computeBilinearTaps(sourceWidth, targetWidth);
+  const std::vector<BilinearTap> rows =
+      computeBilinearTaps(sourceHeight, targetHeight);
+
+  for (size_t j = 0; j < targetHeight; ++j) {
+    const BilinearTap& row = rows[j];
+    const uint8_t* pTop =
+        reinterpret_cast<const uint8_t*>(pSource + row.first * sourceRowStride);
+    const uint8_t* pBottom = reinterpret_cast<const uint8_t*>(
+        pSource + row.second * sourceRowStride);
+    uint8_t* pOut = reinterpret_cast<uint8_t*>(pTarget + j * targetRowStride);
+
+    for (size_t i = 0; i < targetWidth; ++i) {
+      const BilinearTap& column = columns[i];
+      const size_t left = column.first * channels;
+      const size_t right = column.second * channels;
+      for (size_t k = 0; k < channels; ++k) {
+        const uint32_t top =
+            pTop[left + k] * (WEIGHT_ONE - column.weight) +
+            pTop[right + k] * column.weight;
+        const uint32_t bottom =
+            pBottom[left + k] * (WEIGHT_ONE - column.weight) +
+            pBottom[right + k] * column.weight;
+        const uint32_t value =
+            top * (WEIGHT_ONE - row.weight) + bottom * row.weight;
+        pOut[i * channels + k] = uint8_t(
+            (value + (1U << (2 * WEIGHT_BITS - 1))) >> (2 * WEIGHT_BITS));
+      }
+    }
+  }
+}
+
+// Shrinks an 8-bit-per-channel image by integer factors, averaging each block
+// of source pixels into one target pixel.
+void downsampleBox(
+    std::byte* pTarget,
+    size_t targetRowStride,
+    size_t targetWidth,
+    size_t targetHeight,
+    const std::byte* pSource,
+    size_t sourceRowStride,
+    size_t factorX,
+    size_t factorY,
+    size_t channels) {
+  std::vector<uint32_t> sums(targetWidth * channels);
+  const uint32_t count = uint32_t(factorX * factorY);
+
+  for (size_t j = 0; j < targetHeight; ++j) {
+    std::fill(sums.begin(), sums.end(), 0U);
+
+    for (size_t y = 0; y < factorY; ++y) {
+      const uint8_t* pRow = reinterpret_cast<const uint8_t*>(
+          pSource + (j * factorY + y) * sourceRowStride);
+      for (size_t i = 0; i < targetWidth; ++i) {
+        const uint8_t* pBlock = pRow + i * factorX * channels;
+        for (size_t x = 0; x < factorX; ++x) {
+          for (size_t k = 0; k < channels; ++k) {
+            sums[i * channels + k] += pBlock[x * channels + k];
+          }
+        }
+      }
+    }
+
+    uint8_t* pOut = reinterpret_cast<uint8_t*>(pTarget + j * targetRowStride);
+    for (size_t i = 0; i < sums.size(); ++i) {
+      pOut[i] = uint8_t((sums[i] + count / 2) / count);
+    }
+  }
+}
+
+} // namespace
+
 void ImageManipulation::unsafeBlitImage(
     std::byte* pTarget,
     size_t targetRowStride,
@@ -99,6 +219,49 @@ bool ImageManipulation::blitImage(
       return false;
     }
 
+    const size_t sourceWidth = size_t(sourcePixels.width);
+    const size_t sourceHeight = size_t(sourcePixels.height);
+    const size_t targetWidth = size_t(targetPixels.width);
+    const size_t targetHeight = size_t(targetPixels.height);
+    const size_t channels = size_t(target.channels);
+
+    if (targetWidth == 0 || targetHeight == 0 || sourceWidth == 0 ||
+        sourceHeight == 0) {
+      // Nothing to copy.
+      return true;
+    }
+
+    // Raster overlay tiles from different quadtree levels are nearly always
+    // scaled by a whole factor, which these kernels handle far more cheaply
+    // than the general-purpose resampler.
+    if (targetWidth >= sourceWidth && targetHeight >= sourceHeight) {
+      upsampleBilinear(
+          pTarget,
+          bytesPerTargetRow,
+          targetWidth,
+          targetHeight,
+          pSource,
+          bytesPerSourceRow,
+          sourceWidth,
+          sourceHeight,
+          channels);
+      return true;
+    }
+
+    if (sourceWidth % targetWidth == 0 && sourceHeight % targetHeight == 0) {
+      downsampleBox(
+          pTarget,
+          bytesPerTargetRow,
+          targetWidth,
+          targetHeight,
+          pSource,
+          bytesPerSourceRow,
+          sourceWidth / targetWidth,
+          sourceHeight / targetHeight,
+          channels);
+      return true;
+    }
+
     // Use STB to do the copy / scale
     stbir_resize_uint8(
         reinterpret_cast<const unsigned char*>(pSource),
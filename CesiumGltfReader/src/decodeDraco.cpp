@@ -5,9 +5,15 @@
 #include <CesiumGltf/ExtensionKhrDracoMeshCompression.h>
 #include <CesiumGltf/Model.h>
 #include <CesiumUtility/Tracing.h>
+#include <CesiumUtility/parallelFor.h>
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
+#include <exception>
 #include <string>
+#include <thread>
+#include <vector>
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -24,36 +30,40 @@
 namespace {
 using namespace CesiumGltf;
 
+/**
+ * @brief Decodes the Draco mesh of a primitive.
+ *
+ * This only reads the model, so it may be called for several primitives at
+ * once. Warnings are added to `warnings` rather than to the
+ * {@link ModelReaderResult} for the same reason.
+ */
 std::unique_ptr<draco::Mesh> decodeBufferViewToDracoMesh(
-    ModelReaderResult& readModel,
-    MeshPrimitive& /* primitive */,
-    const ExtensionKhrDracoMeshCompression& draco) {
+    const Model& model,
+    const ExtensionKhrDracoMeshCompression& draco,
+    std::vector<std::string>& warnings) {
   CESIUM_TRACE("CesiumGltf::decodeBufferViewToDracoMesh");
-  Model& model = readModel.model.value();
 
-  BufferView* pBufferView =
+  const BufferView* pBufferView =
       Model::getSafe(&model.bufferViews, draco.bufferView);
   if (!pBufferView) {
-    readModel.warnings.emplace_back("Draco bufferView index is invalid.");
+    warnings.emplace_back("Draco bufferView index is invalid.");
     return nullptr;
   }
 
   const BufferView& bufferView = *pBufferView;
 
-  Buffer* pBuffer = Model::getSafe(&model.buffers, bufferView.buffer);
+  const Buffer* pBuffer = Model::getSafe(&model.buffers, bufferView.buffer);
   if (!pBuffer) {
-    readModel.warnings.emplace_back(
-        "Draco bufferView has an invalid buffer index.");
+    warnings.emplace_back("Draco bufferView has an invalid buffer index.");
     return nullptr;
   }
 
-  Buffer& buffer = *pBuffer;
+  const Buffer& buffer = *pBuffer;
 
   if (bufferView.byteOffset < 0 || bufferView.byteLength < 0 ||
       bufferView.byteOffset + bufferView.byteLength >
           static_cast<int64_t>(buffer.cesium.data.size())) {
-    readModel.warnings.emplace_back(
-        "Draco bufferView extends beyond its buffer.");
+    warnings.emplace_back("Draco bufferView extends beyond its buffer.");
     return nullptr;
   }
 
@@ -65,11 +75,10 @@ std::unique_ptr<draco::Mesh> decodeBufferViewToDracoMesh(
   decodeBuffer.Init(reinterpret_cast<const char*>(data.data()), data.size());
 
   draco::Decoder decoder;
-  draco::Mesh mesh;
   draco::StatusOr<std::unique_ptr<draco::Mesh>> result =
       decoder.DecodeMeshFromBuffer(&decodeBuffer);
   if (!result.ok()) {
-    readModel.warnings.emplace_back(
+    warnings.emplace_back(
         std::string("Draco decoding failed: ") +
         result.status().error_msg_string());
     return nullptr;
@@ -96,7 +105,7 @@ void copyData(const T* pSource, T* pDestination, int64_t length) {
 void copyDecodedIndices(
     ModelReaderResult& readModel,
     const MeshPrimitive& primitive,
-    draco::Mesh* pMesh) {
+    const draco::Mesh* pMesh) {
   CESIUM_TRACE("CesiumGltf::copyDecodedIndices");
   Model& model = readModel.model.value();
 
@@ -152,6 +161,10 @@ void copyDecodedIndices(
   indicesBufferView.target = BufferView::Target::ELEMENT_ARRAY_BUFFER;
   pIndicesAccessor->type = Accessor::Type::SCALAR;
 
+  if (pIndicesAccessor->count == 0) {
+    return;
+  }
+
   static_assert(sizeof(draco::PointIndex) == sizeof(uint32_t));
 
   const uint32_t* pSourceIndices =
@@ -197,6 +210,25 @@ void copyDecodedIndices(
   }
 }
 
+draco::DataType getDracoDataType(int32_t componentType) noexcept {
+  switch (componentType) {
+  case Accessor::ComponentType::BYTE:
+    return draco::DT_INT8;
+  case Accessor::ComponentType::UNSIGNED_BYTE:
+    return draco::DT_UINT8;
+  case Accessor::ComponentType::SHORT:
+    return draco::DT_INT16;
+  case Accessor::ComponentType::UNSIGNED_SHORT:
+    return draco::DT_UINT16;
+  case Accessor::ComponentType::UNSIGNED_INT:
+    return draco::DT_UINT32;
+  case Accessor::ComponentType::FLOAT:
+    return draco::DT_FLOAT32;
+  default:
+    return draco::DT_INVALID;
+  }
+}
+
 void copyDecodedAttribute(
     ModelReaderResult& readModel,
     MeshPrimitive& /* primitive */,
@@ -231,32 +263,61 @@ void copyDecodedAttribute(
   bufferView.byteOffset = 0;
   pAccessor->byteOffset = 0;
 
-  const auto doCopy = [pMesh, pAttribute, numberOfComponents](auto pOut) {
-    for (draco::PointIndex i(0); i < pMesh->num_points(); ++i) {
+  const draco::PointIndex::ValueType count =
+      static_cast<draco::PointIndex::ValueType>(pAccessor->count);
+  std::byte* pDestination = buffer.cesium.data.data();
+
+  // When the decoded values already have the layout of the accessor, which is
+  // the usual case, copy their bytes directly instead of converting them one
+  // component at a time.
+  if (pAttribute->data_type() == getDracoDataType(pAccessor->componentType) &&
+      pAttribute->num_components() == numberOfComponents &&
+      pAttribute->byte_stride() == stride) {
+    const size_t valueBytes = static_cast<size_t>(stride);
+    if (pAttribute->is_mapping_identity() && pAttribute->size() >= count) {
+      if (count > 0) {
+        std::memcpy(
+            pDestination,
+            pAttribute->GetAddress(draco::AttributeValueIndex(0)),
+            static_cast<size_t>(sizeBytes));
+      }
+    } else {
+      for (draco::PointIndex i(0); i < count; ++i) {
+        std::memcpy(
+            pDestination + i.value() * valueBytes,
+            pAttribute->GetAddress(pAttribute->mapped_index(i)),
+            valueBytes);
+      }
+    }
+    return;
+  }
+
+  const auto doCopy = [pAttribute, numberOfComponents, count](auto pOut) {
+    for (draco::PointIndex i(0); i < count; ++i) {
       const draco::AttributeValueIndex valueIndex = pAttribute->mapped_index(i);
       pAttribute->ConvertValue(valueIndex, numberOfComponents, pOut);
-      pOut += pAttribute->num_components();
+      pOut += numberOfComponents;
     }
   };
 
   switch (pAccessor->componentType) {
   case Accessor::ComponentType::BYTE:
-    doCopy(reinterpret_cast<int8_t*>(buffer.cesium.data.data()));
+    doCopy(reinterpret_cast<int8_t*>(pDestination));
     break;
   case Accessor::ComponentType::UNSIGNED_BYTE:
-    doCopy(reinterpret_cast<uint8_t*>(buffer.cesium.data.data()));
+    doCopy(reinterpret_cast<uint8_t*>(pDestination));
     break;
   case Accessor::ComponentType::SHORT:
-    doCopy(reinterpret_cast<int16_t*>(buffer.cesium.data.data()));
+    doCopy(reinterpret_cast<int16_t*>(pDestination));
     break;
   case Accessor::ComponentType::UNSIGNED_SHORT:
-    doCopy(reinterpret_cast<uint16_t*>(buffer.cesium.data.data()));
+    doCopy(reinterpret_cast<uint16_t*>(pDestination));
     break;
   case Accessor::ComponentType::UNSIGNED_INT:
-    doCopy(reinterpret_cast<uint32_t*>(buffer.cesium.data.data()));
+    doCopy(reinterpret_cast<uint32_t*>(pDestination));
     break;
   case Accessor::ComponentType::FLOAT:
-    doCopy(reinterpret_cast<float*>(buffer.cesium.data.data()));
+    doCopy(reinterpret_cast<float*>(pDestination));
     break;
   default:
     readModel.warnings.emplace_back(
@@ -266,20 +327,15 @@ void copyDecodedAttribute(
   }
 }
 
-void decodePrimitive(
+void copyDecodedPrimitive(
     ModelReaderResult& readModel,
     MeshPrimitive& primitive,
-    ExtensionKhrDracoMeshCompression& draco) {
-  CESIUM_TRACE("CesiumGltf::decodePrimitive");
+    const ExtensionKhrDracoMeshCompression& draco,
+    const draco::Mesh* pMesh) {
+  CESIUM_TRACE("CesiumGltf::copyDecodedPrimitive");
   Model& model = readModel.model.value();
 
-  std::unique_ptr<draco::Mesh> pMesh =
-      decodeBufferViewToDracoMesh(readModel, primitive, draco);
-  if (!pMesh) {
-    return;
-  }
-
-  copyDecodedIndices(readModel, primitive, pMesh.get());
+  copyDecodedIndices(readModel, primitive, pMesh);
 
   for (const std::pair<const std::string, int32_t>& attribute :
        draco.attributes) {
@@ -311,14 +367,24 @@ void decodePrimitive(
       continue;
     }
 
-    copyDecodedAttribute(
-        readModel,
-        primitive,
-        pAccessor,
-        pMesh.get(),
-        pAttribute);
+    copyDecodedAttribute(readModel, primitive, pAccessor, pMesh, pAttribute);
   }
 }
+
+struct PendingPrimitive {
+  MeshPrimitive* pPrimitive;
+  ExtensionKhrDracoMeshCompression* pDraco;
+  std::unique_ptr<draco::Mesh> pMesh;
+  std::vector<std::string> warnings;
+};
+
+// Below this many compressed bytes per thread, starting a thread takes longer
+// than the decoding it saves.
+const int64_t minimumBytesPerThread = 32 * 1024;
+
+// Models with fewer Draco primitives than this are decoded in the load thread,
+// because there is too little work to share between threads.
+const size_t minimumPrimitivesForParallelDecode = 4;
 } // namespace
 
 namespace CesiumGltf {
@@ -331,6 +397,8 @@ void decodeDraco(CesiumGltf::ModelReaderResult& readModel) {
 
   Model& model = readModel.model.value();
 
+  std::vector<PendingPrimitive> primitives;
+  int64_t totalBytes = 0;
   for (Mesh& mesh : model.meshes) {
     for (MeshPrimitive& primitive : mesh.primitives) {
       ExtensionKhrDracoMeshCompression* pDraco =
@@ -339,7 +407,63 @@ void decodeDraco(CesiumGltf::ModelReaderResult& readModel) {
         continue;
       }
 
-      decodePrimitive(readModel, primitive, *pDraco);
+      primitives.push_back(PendingPrimitive{&primitive, pDraco, nullptr, {}});
+
+      const BufferView* pBufferView =
+          Model::getSafe(&model.bufferViews, pDraco->bufferView);
+      if (pBufferView) {
+        totalBytes += std::max(pBufferView->byteLength, int64_t(0));
+      }
+    }
+  }
+
+  // Decoding is by far the slowest part, and the primitives are independent,
+  // so decode them in parallel. The decoded meshes are then copied into the
+  // model one at a time, in order, because that adds buffers to the model.
+  // A primitive that fails to decode, even by throwing, only adds a warning, so
+  // that it does not stop the other primitives from being decoded.
+  const size_t maxThreads =
+      primitives.size() < minimumPrimitivesForParallelDecode
+          ? 1
+          : static_cast<size_t>(std::min(
+                static_cast<int64_t>(
+                    std::max(std::thread::hardware_concurrency(), 1U)),
+                totalBytes / minimumBytesPerThread + 1));
+  CesiumUtility::parallelFor(
+      primitives.size(),
+      maxThreads,
+      [&model, &primitives](size_t i) {
+        PendingPrimitive& primitive = primitives[i];
+        try {
+          primitive.pMesh = decodeBufferViewToDracoMesh(
+              model,
+              *primitive.pDraco,
+              primitive.warnings);
+        } catch (const std::exception& e) {
+          primitive.pMesh.reset();
+          primitive.warnings.emplace_back(
+              std::string("Draco decoding failed: ") + e.what());
+        } catch (...) {
+          primitive.pMesh.reset();
+          primitive.warnings.emplace_back("Draco decoding failed.");
+        }
+      });
+
+  for (PendingPrimitive& primitive : primitives) {
+    readModel.warnings.insert(
+        readModel.warnings.end(),
+        std::make_move_iterator(primitive.warnings.begin()),
+        std::make_move_iterator(primitive.warnings.end()));
+
+    if (primitive.pMesh) {
+      copyDecodedPrimitive(
+          readModel,
+          *primitive.pPrimitive,
+          *primitive.pDraco,
+          primitive.pMesh.get());
+
+      // Free each decoded mesh as soon as it is copied, to limit peak memory.
+      primitive.pMesh.reset();
     }
   }
 }
@@ -0,0 +1,689 @@
+#include "decodeMeshOpt.h"
+
+#include "CesiumGltf/GltfReader.h"
+
+#include <CesiumGltf/ExtensionBufferViewExtMeshoptCompression.h>
+#include <CesiumGltf/Model.h>
+#include <CesiumUtility/Tracing.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+using namespace CesiumGltf;
+
+using MeshOpt = ExtensionBufferViewExtMeshoptCompression;
+
+// The decoders below follow the bitstreams described in the
+// EXT_meshopt_compression specification, which are the formats written by the
+// meshoptimizer library. Each one returns false if the data is malformed.
+
+const uint8_t vertexHeader = 0xa0;
+const uint8_t triangleHeader = 0xe0;
+const uint8_t sequenceHeader = 0xd0;
+
+const size_t vertexBlockSizeBytes = 8192;
+const size_t vertexBlockMaxSize = 256;
+const size_t byteGroupSize = 16;
+const size_t byteGroupDecodeLimit = 24;
+const size_t tailMaxSize = 32;
+
+size_t getVertexBlockSize(size_t vertexSize) noexcept {
+  const size_t result =
+      (vertexBlockSizeBytes / vertexSize) & ~(byteGroupSize - 1);
+  return std::min(result, vertexBlockMaxSize);
+}
+
+uint8_t unzigzag8(uint8_t v) noexcept {
+  return static_cast<uint8_t>(-(v & 1) ^ (v >> 1));
+}
+
+uint32_t unzigzag32(uint32_t v) noexcept { return (v >> 1) ^ (0U - (v & 1)); }
+
+/**
+ * @brief Decodes a group of 16 bytes that are packed into `Bits` bits each.
+ *
+ * Values are packed from the most significant bits of each byte. A value with
+ * all bits set is a sentinel for a full byte, which follows the packed bits.
+ */
+template <int Bits>
+const uint8_t* decodeBytesGroupBits(const uint8_t* pData, uint8_t* pBuffer) {
+  constexpr size_t bits = static_cast<size_t>(Bits);
+  constexpr size_t valuesPerByte = 8 / bits;
+  constexpr uint8_t sentinel = (1 << Bits) - 1;
+
+  const uint8_t* pExtra = pData + byteGroupSize / valuesPerByte;
+  for (size_t i = 0; i < byteGroupSize; ++i) {
+    const size_t shift = 8 - bits * (1 + i % valuesPerByte);
+    const uint8_t value =
+        static_cast<uint8_t>((pData[i / valuesPerByte] >> shift) & sentinel);
+    pBuffer[i] = value == sentinel ? *pExtra : value;
+    pExtra += value == sentinel;
+  }
+  return pExtra;
+}
+
+const uint8_t*
+decodeBytesGroup(const uint8_t* pData, uint8_t* pBuffer, int bitsLog2) {
+  switch (bitsLog2) {
+  case 0:
+    std::memset(pBuffer, 0, byteGroupSize);
+    return pData;
+  case 1:
+    return decodeBytesGroupBits<2>(pData, pBuffer);
+  case 2:
+    return decodeBytesGroupBits<4>(pData, pBuffer);
+  default:
+    std::memcpy(pBuffer, pData, byteGroupSize);
+    return pData + byteGroupSize;
+  }
+}
+
+const uint8_t* decodeBytes(
+    const uint8_t* pData,
+    const uint8_t* pDataEnd,
+    uint8_t* pBuffer,
+    size_t bufferSize) {
+  // Each group has a two-bit header, four to a byte.
+  const uint8_t* pHeader = pData;
+  const size_t headerSize = (bufferSize / byteGroupSize + 3) / 4;
+  if (static_cast<size_t>(pDataEnd - pData) < headerSize) {
+    return nullptr;
+  }
+
+  pData += headerSize;
+
+  for (size_t i = 0; i < bufferSize; i += byteGroupSize) {
+    // The tail of the stream guarantees that a group can be decoded without
+    // further bounds checks once this much data remains.
+    if (static_cast<size_t>(pDataEnd - pData) < byteGroupDecodeLimit) {
+      return nullptr;
+    }
+
+    const size_t group = i / byteGroupSize;
+    const int bitsLog2 = (pHeader[group / 4] >> ((group % 4) * 2)) & 3;
+    pData = decodeBytesGroup(pData, pBuffer + i, bitsLog2);
+  }
+
+  return pData;
+}
+
+const uint8_t* decodeVertexBlock(
+    const uint8_t* pData,
+    const uint8_t* pDataEnd,
+    uint8_t* pVertexData,
+    size_t vertexCount,
+    size_t vertexSize,
+    uint8_t* pLastVertex) {
+  uint8_t buffer[vertexBlockMaxSize];
+
+  const size_t vertexCountAligned =
+      (vertexCount + byteGroupSize - 1) & ~(byteGroupSize - 1);
+
+  // Each byte of the vertex is stored separately, as deltas from the same byte
+  // of the previous vertex.
+  for (size_t k = 0; k < vertexSize; ++k) {
+    pData = decodeBytes(pData, pDataEnd, buffer, vertexCountAligned);
+    if (!pData) {
+      return nullptr;
+    }
+
+    uint8_t p = pLastVertex[k];
+    uint8_t* pOut = pVertexData + k;
+    for (size_t i = 0; i < vertexCount; ++i) {
+      p = static_cast<uint8_t>(p + unzigzag8(buffer[i]));
+      pOut[i * vertexSize] = p;
+    }
+  }
+
+  std::memcpy(
+      pLastVertex,
+      pVertexData + vertexSize * (vertexCount - 1),
+      vertexSize);
+
+  return pData;
+}
+
+bool decodeVertexBuffer(
+    uint8_t* pDestination,
+    size_t vertexCount,
+    size_t vertexSize,
+    const uint8_t* pSource,
+    size_t sourceSize) {
+  if (vertexSize == 0 || vertexSize > 256 || vertexSize % 4 != 0) {
+    return false;
+  }
+
+  const size_t tailSize = std::max(vertexSize, tailMaxSize);
+  if (sourceSize < 1 + tailSize) {
+    return false;
+  }
+
+  const uint8_t* pData = pSource;
+  const uint8_t* pDataEnd = pSource + sourceSize;
+
+  // Only version 0 is defined.
+  if (*pData++ != vertexHeader) {
+    return false;
+  }
+
+  // The first vertex is predicted from the last bytes of the stream.
+  uint8_t lastVertex[256];
+  std::memcpy(lastVertex, pDataEnd - vertexSize, vertexSize);
+
+  const size_t blockSize = getVertexBlockSize(vertexSize);
+
+  for (size_t offset = 0; offset < vertexCount; offset += blockSize) {
+    pData = decodeVertexBlock(
+        pData,
+        pDataEnd,
+        pDestination + offset * vertexSize,
+        std::min(blockSize, vertexCount - offset),
+        vertexSize,
+        lastVertex);
+    if (!pData) {
+      return false;
+    }
+  }
+
+  return static_cast<size_t>(pDataEnd - pData) == tailSize;
+}
+
+uint32_t decodeVByte(const uint8_t*& pData) noexcept {
+  const uint8_t lead = *pData++;
+  if (lead < 128) {
+    return lead;
+  }
+
+  // Up to four more bytes, so that malformed data can't read further.
+  uint32_t result = lead & 127U;
+  uint32_t shift = 7;
+  for (int i = 0; i < 4; ++i) {
+    const uint8_t group = *pData++;
+    result |= static_cast<uint32_t>(group & 127) << shift;
+    shift += 7;
+
+    if (group < 128) {
+      break;
+    }
+  }
+
+  return result;
+}
+
+uint32_t decodeIndex(const uint8_t*& pData, uint32_t last) noexcept {
+  return last + unzigzag32(decodeVByte(pData));
+}
+
+/**
+ * @brief The state of the triangle decoder: a FIFO of recently seen edges, a
+ * FIFO of recently seen vertices, the next new vertex, and the last explicitly
+ * encoded vertex.
+ */
+struct TriangleDecoder {
+  uint32_t edges[16][2];
+  uint32_t vertices[16];
+  size_t edgeOffset = 0;
+  size_t vertexOffset = 0;
+  uint32_t next = 0;
+  uint32_t last = 0;
+
+  TriangleDecoder() noexcept {
+    std::memset(edges, 0xff, sizeof(edges));
+    std::memset(vertices, 0xff, sizeof(vertices));
+  }
+
+  void pushEdge(uint32_t a, uint32_t b) noexcept {
+    edges[edgeOffset][0] = a;
+    edges[edgeOffset][1] = b;
+    edgeOffset = (edgeOffset + 1) & 15;
+  }
+
+  void pushVertex(uint32_t v, bool condition = true) noexcept {
+    vertices[vertexOffset] = v;
+    vertexOffset = (vertexOffset + condition) & 15;
+  }
+};
+
+template <typename T>
+bool decodeIndexBuffer(
+    T* pDestination,
+    size_t indexCount,
+    const uint8_t* pSource,
+    size_t sourceSize) {
+  if (indexCount % 3 != 0) {
+    return false;
+  }
+
+  // The smallest encoding is the header, a code per triangle, and a table of
+  // 16 codes at the end.
+  const size_t triangleCount = indexCount / 3;
+  if (sourceSize < 1 + triangleCount + 16) {
+    return false;
+  }
+
+  if ((pSource[0] & 0xf0) != triangleHeader) {
+    return false;
+  }
+
+  const int version = pSource[0] & 0x0f;
+  if (version > 1) {
+    return false;
+  }
+
+  TriangleDecoder decoder;
+
+  // Versions 0 and 1 differ in whether codes 13 and 14 read the vertex FIFO
+  // or are small deltas from the last encoded vertex.
+  const uint32_t fecMax = version >= 1 ? 13 : 15;
+
+  const uint8_t* pCode = pSource + 1;
+  const uint8_t* pData = pCode + triangleCount;
+  const uint8_t* pDataSafeEnd = pSource + sourceSize - 16;
+  const uint8_t* pCodeAuxTable = pDataSafeEnd;
+
+  for (size_t i = 0; i < indexCount; i += 3) {
+    // A triangle reads at most 16 bytes of data, which the table at the end
+    // guarantees are there.
+    if (pData > pDataSafeEnd) {
+      return false;
+    }
+
+    const uint8_t codeTri = *pCode++;
+    uint32_t a;
+    uint32_t b;
+    uint32_t c;
+
+    if (codeTri < 0xf0) {
+      // The triangle shares an edge from the FIFO.
+      const size_t edge = (decoder.edgeOffset - 1 - (codeTri >> 4)) & 15;
+      a = decoder.edges[edge][0];
+      b = decoder.edges[edge][1];
+
+      const uint32_t fec = codeTri & 15U;
+      if (fec < fecMax) {
+        // The third vertex is new or from the FIFO.
+        c = fec == 0
+                ? decoder.next
+                : decoder.vertices[(decoder.vertexOffset - 1 - fec) & 15];
+        decoder.next += fec == 0;
+        decoder.pushVertex(c, fec == 0);
+      } else {
+        // The third vertex is encoded relative to the last encoded vertex.
+        c = decoder.last =
+            fec != 15 ? decoder.last + (fec - (fec ^ 3))
+                      : decodeIndex(pData, decoder.last);
+        decoder.pushVertex(c);
+      }
+
+      decoder.pushEdge(c, b);
+      decoder.pushEdge(a, c);
+    } else if (codeTri < 0xfe) {
+      // Common combinations of vertex codes come from the table. The first
+      // vertex is always new.
+      const uint8_t codeAux = pCodeAuxTable[codeTri & 15];
+      const uint32_t feb = static_cast<uint32_t>(codeAux >> 4);
+      const uint32_t fec = codeAux & 15U;
+
+      a = decoder.next++;
+      b = feb == 0 ? decoder.next++
+                   : decoder.vertices[(decoder.vertexOffset - feb) & 15];
+      c = fec == 0 ? decoder.next++
+                   : decoder.vertices[(decoder.vertexOffset - fec) & 15];
+
+      decoder.pushVertex(a);
+      decoder.pushVertex(b, feb == 0);
+      decoder.pushVertex(c, fec == 0);
+
+      decoder.pushEdge(b, a);
+      decoder.pushEdge(c, b);
+      decoder.pushEdge(a, c);
+    } else {
+      // The vertex codes are in the data, and a code of 15 means that the
+      // vertex is encoded relative to the last encoded vertex.
+      const uint8_t codeAux = *pData++;
+      const uint32_t feb = static_cast<uint32_t>(codeAux >> 4);
+      const uint32_t fec = codeAux & 15U;
+
+      // A zero code restarts the numbering of new vertices.
+      if (codeAux == 0) {
+        decoder.next = 0;
+      }
+
+      a = codeTri == 0xfe ? decoder.next++ : 0;
+      b = feb == 0 ? decoder.next++
+                   : decoder.vertices[(decoder.vertexOffset - feb) & 15];
+      c = fec == 0 ? decoder.next++
+                   : decoder.vertices[(decoder.vertexOffset - fec) & 15];
+
+      if (codeTri == 0xff) {
+        a = decoder.last = decodeIndex(pData, decoder.last);
+      }
+
+      if (feb == 15) {
+        b = decoder.last = decodeIndex(pData, decoder.last);
+      }
+
+      if (fec == 15) {
+        c = decoder.last = decodeIndex(pData, decoder.last);
+      }
+
+      decoder.pushVertex(a);
+      decoder.pushVertex(b, feb == 0 || feb == 15);
+      decoder.pushVertex(c, fec == 0 || fec == 15);
+
+      decoder.pushEdge(b, a);
+      decoder.pushEdge(c, b);
+      decoder.pushEdge(a, c);
+    }
+
+    pDestination[i + 0] = static_cast<T>(a);
+    pDestination[i + 1] = static_cast<T>(b);
+    pDestination[i + 2] = static_cast<T>(c);
+  }
+
+  // All of the data must have been used.
+  return pData == pDataSafeEnd;
+}
+
+template <typename T>
+bool decodeIndexSequence(
+    T* pDestination,
+    size_t indexCount,
+    const uint8_t* pSource,
+    size_t sourceSize) {
+  // The smallest encoding is the header, a byte per index, and a 4-byte tail.
+  if (sourceSize < 1 + indexCount + 4) {
+    return false;
+  }
+
+  if ((pSource[0] & 0xf0) != sequenceHeader) {
+    return false;
+  }
+
+  const int version = pSource[0] & 0x0f;
+  if (version > 1) {
+    return false;
+  }
+
+  const uint8_t* pData = pSource + 1;
+  const uint8_t* pDataSafeEnd = pSource + sourceSize - 4;
+
+  // Each index is a delta from one of two baselines, chosen by its low bit.
+  uint32_t last[2] = {0, 0};
+
+  for (size_t i = 0; i < indexCount; ++i) {
+    // An index reads at most 5 bytes, which the tail guarantees are there.
+    if (pData >= pDataSafeEnd) {
+      return false;
+    }
+
+    const uint32_t v = decodeVByte(pData);
+    const uint32_t baseline = v & 1;
+    const uint32_t index = last[baseline] + unzigzag32(v >> 1);
+    last[baseline] = index;
+    pDestination[i] = static_cast<T>(index);
+  }
+
+  return pData == pDataSafeEnd;
+}
+
+// The filters are simple loops without data-dependent control flow, so that
+// the compiler can vectorize them.
+
+template <typename T>
+void decodeOctahedralFilter(T* pData, size_t count) noexcept {
+  const float maximum = float((1 << (sizeof(T) * 8 - 1)) - 1);
+
+  for (size_t i = 0; i < count; ++i) {
+    T* pVector = pData + i * 4;
+
+    // Reconstruct z, assuming that it encodes 1.0 with the same precision.
+    float x = float(pVector[0]);
+    float y = float(pVector[1]);
+    const float z = float(pVector[2]) - std::fabs(x) - std::fabs(y);
+
+    // Unfold the lower hemisphere.
+    const float t = std::min(z, 0.0f);
+    x += x >= 0.0f ? t : -t;
+    y += y >= 0.0f ? t : -t;
+
+    const float scale = maximum / std::sqrt(x * x + y * y + z * z);
+
+    pVector[0] = static_cast<T>(x * scale + (x >= 0.0f ? 0.5f : -0.5f));
+    pVector[1] = static_cast<T>(y * scale + (y >= 0.0f ? 0.5f : -0.5f));
+    pVector[2] = static_cast<T>(z * scale + (z >= 0.0f ? 0.5f : -0.5f));
+  }
+}
+
+void decodeQuaternionFilter(int16_t* pData, size_t count) noexcept {
+  const float scale = 1.0f / std::sqrt(2.0f);
+
+  for (size_t i = 0; i < count; ++i) {
+    int16_t* pQuaternion = pData + i * 4;
+
+    // The last component holds the scale of the others in its high bits, and
+    // which component was dropped in its low two bits.
+    const int encoded = pQuaternion[3];
+    const float componentScale = scale / float(encoded | 3);
+
+    const float x = float(pQuaternion[0]) * componentScale;
+    const float y = float(pQuaternion[1]) * componentScale;
+    const float z = float(pQuaternion[2]) * componentScale;
+
+    // The dropped component is the largest, so it is never negative.
+    const float w = std::sqrt(std::max(1.0f - x * x - y * y - z * z, 0.0f));
+
+    const int dropped = encoded & 3;
+    pQuaternion[(dropped + 1) & 3] =
+        static_cast<int16_t>(x * 32767.0f + (x >= 0.0f ? 0.5f : -0.5f));
+    pQuaternion[(dropped + 2) & 3] =
+        static_cast<int16_t>(y * 32767.0f + (y >= 0.0f ? 0.5f : -0.5f));
+    pQuaternion[(dropped + 3) & 3] =
+        static_cast<int16_t>(z * 32767.0f + (z >= 0.0f ? 0.5f : -0.5f));
+    pQuaternion[dropped] = static_cast<int16_t>(w * 32767.0f + 0.5f);
+  }
+}
+
+void decodeExponentialFilter(uint32_t* pData, size_t count) noexcept {
+  for (size_t i = 0; i < count; ++i) {
+    // A 24-bit signed mantissa and an 8-bit signed exponent.
+    const uint32_t v = pData[i];
+    const int32_t mantissa = static_cast<int32_t>(v << 8) >> 8;
+    const int32_t exponent = static_cast<int32_t>(v) >> 24;
+
+    // Compute mantissa * 2^exponent by building 2^exponent directly.
+    const uint32_t powerBits = static_cast<uint32_t>(exponent + 127) << 23;
+    float power;
+    std::memcpy(&power, &powerBits, sizeof(float));
+    const float value = power * float(mantissa);
+    std::memcpy(pData + i, &value, sizeof(float));
+  }
+}
+
+bool decodeAttributes(
+    std::byte* pDestination,
+    const MeshOpt& meshOpt,
+    const uint8_t* pSource,
+    std::string& error) {
+  const size_t count = static_cast<size_t>(meshOpt.count);
+  const size_t stride = static_cast<size_t>(meshOpt.byteStride);
+
+  const bool validFilter =
+      meshOpt.filter == MeshOpt::Filter::NONE ||
+      (meshOpt.filter == MeshOpt::Filter::OCTAHEDRAL &&
+       (stride == 4 || stride == 8)) ||
+      (meshOpt.filter == MeshOpt::Filter::QUATERNION && stride == 8) ||
+      (meshOpt.filter == MeshOpt::Filter::EXPONENTIAL && stride % 4 == 0);
+  if (!validFilter) {
+    error = "The " + meshOpt.filter +
+            " filter can't be used with a stride of " +
+            std::to_string(stride) + " bytes.";
+    return false;
+  }
+
+  if (!decodeVertexBuffer(
+          reinterpret_cast<uint8_t*>(pDestination),
+          count,
+          stride,
+          pSource,
+          static_cast<size_t>(meshOpt.byteLength))) {
+    error = "The vertex data is malformed.";
+    return false;
+  }
+
+  if (meshOpt.filter == MeshOpt::Filter::OCTAHEDRAL) {
+    if (stride == 4) {
+      decodeOctahedralFilter(reinterpret_cast<int8_t*>(pDestination), count);
+    } else {
+      decodeOctahedralFilter(reinterpret_cast<int16_t*>(pDestination), count);
+    }
+  } else if (meshOpt.filter == MeshOpt::Filter::QUATERNION) {
+    decodeQuaternionFilter(reinterpret_cast<int16_t*>(pDestination), count);
+  } else if (meshOpt.filter == MeshOpt::Filter::EXPONENTIAL) {
+    decodeExponentialFilter(
+        reinterpret_cast<uint32_t*>(pDestination),
+        count * stride / 4);
+  }
+
+  return true;
+}
+
+template <typename T>
+bool decodeIndices(
+    T* pDestination,
+    const MeshOpt& meshOpt,
+    const uint8_t* pSource) {
+  const size_t count = static_cast<size_t>(meshOpt.count);
+  const size_t sourceSize = static_cast<size_t>(meshOpt.byteLength);
+  if (meshOpt.mode == MeshOpt::Mode::TRIANGLES) {
+    return decodeIndexBuffer(pDestination, count, pSource, sourceSize);
+  }
+  return decodeIndexSequence(pDestination, count, pSource, sourceSize);
+}
+
+void decodeBufferView(
+    ModelReaderResult& readModel,
+    BufferView& bufferView,
+    const MeshOpt& meshOpt) {
+  Model& model = readModel.model.value();
+
+  const Buffer* pSourceBuffer = Model::getSafe(&model.buffers, meshOpt.buffer);
+  if (!pSourceBuffer) {
+    readModel.warnings.emplace_back(
+        "EXT_meshopt_compression buffer index is invalid.");
+    return;
+  }
+
+  if (meshOpt.byteOffset < 0 || meshOpt.byteLength < 0 ||
+      meshOpt.byteOffset + meshOpt.byteLength >
+          static_cast<int64_t>(pSourceBuffer->cesium.data.size())) {
+    readModel.warnings.emplace_back(
+        "EXT_meshopt_compression data extends beyond its buffer.");
+    return;
+  }
+
+  Buffer* pDestinationBuffer =
+      Model::getSafe(&model.buffers, bufferView.buffer);
+  if (!pDestinationBuffer || pDestinationBuffer == pSourceBuffer) {
+    readModel.warnings.emplace_back(
+        "EXT_meshopt_compression bufferView has an invalid buffer index.");
+    return;
+  }
+
+  const bool isAttributes = meshOpt.mode == MeshOpt::Mode::ATTRIBUTES;
+  const bool isIndices = meshOpt.mode == MeshOpt::Mode::TRIANGLES ||
+                         meshOpt.mode == MeshOpt::Mode::INDICES;
+  if (!isAttributes && !isIndices) {
+    readModel.warnings.emplace_back(
+        "EXT_meshopt_compression mode " + meshOpt.mode + " is not supported.");
+    return;
+  }
+
+  if (meshOpt.count < 0 || meshOpt.byteStride <= 0 ||
+      (isIndices && meshOpt.byteStride != 2 && meshOpt.byteStride != 4)) {
+    readModel.warnings.emplace_back(
+        "EXT_meshopt_compression has an invalid count or byteStride.");
+    return;
+  }
+
+  // The fallback buffer's byteLength bounds how much memory is allocated for
+  // the decoded data, so the bufferView must lie within it.
+  const int64_t bufferLength = pDestinationBuffer->byteLength;
+  if (bufferView.byteOffset < 0 || bufferView.byteLength < 0 ||
+      bufferView.byteOffset > bufferLength ||
+      bufferView.byteLength > bufferLength - bufferView.byteOffset) {
+    readModel.warnings.emplace_back(
+        "EXT_meshopt_compression bufferView extends beyond its fallback "
+        "buffer.");
+    return;
+  }
+
+  if (meshOpt.count > bufferView.byteLength / meshOpt.byteStride) {
+    readModel.warnings.emplace_back(
+        "EXT_meshopt_compression decoded data is larger than its bufferView.");
+    return;
+  }
+
+  // The bufferView refers to a fallback buffer, which usually has no data of
+  // its own, so make room in it for the decoded data.
+  std::vector<std::byte>& destination = pDestinationBuffer->cesium.data;
+  if (destination.size() < static_cast<size_t>(bufferLength)) {
+    destination.resize(static_cast<size_t>(bufferLength));
+  }
+
+  std::byte* pDestination = destination.data() + bufferView.byteOffset;
+  const uint8_t* pSource = reinterpret_cast<const uint8_t*>(
+      pSourceBuffer->cesium.data.data() + meshOpt.byteOffset);
+
+  std::string error;
+  bool success;
+  if (isAttributes) {
+    success = decodeAttributes(pDestination, meshOpt, pSource, error);
+  } else if (meshOpt.byteStride == 2) {
+    success = decodeIndices(
+        reinterpret_cast<uint16_t*>(pDestination),
+        meshOpt,
+        pSource);
+  } else {
+    success = decodeIndices(
+        reinterpret_cast<uint32_t*>(pDestination),
+        meshOpt,
+        pSource);
+  }
+
+  if (!success) {
+    readModel.warnings.emplace_back(
+        "EXT_meshopt_compression decoding failed: " +
+        (error.empty() ? std::string("The index data is malformed.") : error));
+  }
+}
+} // namespace
+
+namespace CesiumGltf {
+
+void decodeMeshOpt(ModelReaderResult& readModel) {
+  CESIUM_TRACE("CesiumGltf::decodeMeshOpt");
+  if (!readModel.model) {
+    return;
+  }
+
+  Model& model = readModel.model.value();
+
+  for (BufferView& bufferView : model.bufferViews) {
+    const ExtensionBufferViewExtMeshoptCompression* pMeshOpt =
+        bufferView.getExtension<ExtensionBufferViewExtMeshoptCompression>();
+    if (!pMeshOpt) {
+      continue;
+    }
+
+    decodeBufferView(readModel, bufferView, *pMeshOpt);
+  }
+}
+
+} // namespace CesiumGltf
@@ -0,0 +1,7 @@
+#pragma once
+
+namespace CesiumGltf {
+struct ModelReaderResult;
+
+void decodeMeshOpt(ModelReaderResult& readModel);
+} // namespace CesiumGltf
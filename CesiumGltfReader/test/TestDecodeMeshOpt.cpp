@@ -0,0 +1,514 @@
+#include "CesiumGltf/GltfReader.h"
+#include "decodeMeshOpt.h"
+
+#include <CesiumGltf/ExtensionBufferExtMeshoptCompression.h>
+#include <CesiumGltf/ExtensionBufferViewExtMeshoptCompression.h>
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace CesiumGltf;
+
+namespace {
+using MeshOpt = ExtensionBufferViewExtMeshoptCompression;
+
+void writeVByte(std::vector<uint8_t>& data, uint32_t value) {
+  while (value >= 128) {
+    data.push_back(static_cast<uint8_t>((value & 127) | 128));
+    value >>= 7;
+  }
+  data.push_back(static_cast<uint8_t>(value));
+}
+
+uint32_t zigzag(uint32_t delta) {
+  return (delta << 1) ^ (0U - (delta >> 31));
+}
+
+// Encodes vertices with every byte group stored as literal deltas, which is
+// the simplest valid encoding.
+std::vector<uint8_t> encodeVertices(
+    const std::vector<uint8_t>& vertices,
+    size_t vertexSize) {
+  const size_t vertexCount = vertices.size() / vertexSize;
+  const size_t blockSize =
+      std::min((8192 / vertexSize) & ~size_t(15), size_t(256));
+
+  std::vector<uint8_t> result{0xa0};
+  const auto firstVertexEnd =
+      vertices.begin() + static_cast<std::ptrdiff_t>(vertexSize);
+  std::vector<uint8_t> last(vertices.begin(), firstVertexEnd);
+
+  for (size_t offset = 0; offset < vertexCount; offset += blockSize) {
+    const size_t count = std::min(blockSize, vertexCount - offset);
+    const size_t alignedCount = (count + 15) & ~size_t(15);
+    for (size_t k = 0; k < vertexSize; ++k) {
+      result.insert(result.end(), (alignedCount / 16 + 3) / 4, 0xff);
+
+      uint8_t previous = last[k];
+      for (size_t i = 0; i < alignedCount; ++i) {
+        if (i >= count) {
+          result.push_back(0);
+          continue;
+        }
+
+        const uint8_t value = vertices[(offset + i) * vertexSize + k];
+        const int8_t delta = static_cast<int8_t>(value - previous);
+        result.push_back(
+            static_cast<uint8_t>((delta << 1) ^ (delta >> 7)));
+        previous = value;
+      }
+      last[k] = previous;
+    }
+  }
+
+  // The tail is padded, and ends with the first vertex.
+  result.insert(result.end(), std::max(vertexSize, size_t(32)) - vertexSize, 0);
+  result.insert(result.end(), vertices.begin(), firstVertexEnd);
+  return result;
+}
+
+// Encodes each triangle with explicit indices.
+std::vector<uint8_t> encodeTriangles(const std::vector<uint32_t>& indices) {
+  std::vector<uint8_t> result{0xe1};
+  result.insert(result.end(), indices.size() / 3, 0xff);
+
+  uint32_t last = 0;
+  for (size_t i = 0; i < indices.size(); i += 3) {
+    result.push_back(0xff);
+    for (size_t j = 0; j < 3; ++j) {
+      writeVByte(result, zigzag(indices[i + j] - last));
+      last = indices[i + j];
+    }
+  }
+
+  result.insert(result.end(), 16, 0);
+  return result;
+}
+
+std::vector<uint8_t> encodeSequence(const std::vector<uint32_t>& indices) {
+  std::vector<uint8_t> result{0xd1};
+
+  uint32_t last = 0;
+  for (uint32_t index : indices) {
+    writeVByte(result, zigzag(index - last) << 1);
+    last = index;
+  }
+
+  result.insert(result.end(), 4, 0);
+  return result;
+}
+
+ModelReaderResult createModel(
+    const std::vector<uint8_t>& compressed,
+    int64_t count,
+    int64_t byteStride,
+    const std::string& mode,
+    const std::string& filter) {
+  ModelReaderResult result;
+  Model& model = result.model.emplace();
+
+  Buffer& source = model.buffers.emplace_back();
+  source.byteLength = static_cast<int64_t>(compressed.size());
+  source.cesium.data.resize(compressed.size());
+  std::memcpy(source.cesium.data.data(), compressed.data(), compressed.size());
+
+  Buffer& fallback = model.buffers.emplace_back();
+  fallback.byteLength = count * byteStride;
+  fallback.addExtension<ExtensionBufferExtMeshoptCompression>().fallback =
+      true;
+
+  BufferView& bufferView = model.bufferViews.emplace_back();
+  bufferView.buffer = 1;
+  bufferView.byteLength = count * byteStride;
+  bufferView.byteStride = byteStride;
+
+  MeshOpt& meshOpt = bufferView.addExtension<MeshOpt>();
+  meshOpt.buffer = 0;
+  meshOpt.byteLength = static_cast<int64_t>(compressed.size());
+  meshOpt.byteStride = byteStride;
+  meshOpt.count = count;
+  meshOpt.mode = mode;
+  meshOpt.filter = filter;
+
+  return result;
+}
+
+template <typename T>
+std::vector<uint8_t> toBytes(const std::vector<T>& values) {
+  std::vector<uint8_t> result(values.size() * sizeof(T));
+  std::memcpy(result.data(), values.data(), result.size());
+  return result;
+}
+
+template <typename T>
+std::vector<T> getDecoded(const ModelReaderResult& result) {
+  const std::vector<std::byte>& data = result.model->buffers[1].cesium.data;
+  std::vector<T> values(data.size() / sizeof(T));
+  std::memcpy(values.data(), data.data(), values.size() * sizeof(T));
+  return values;
+}
+
+// Encoded data and the results of decoding it, from the test suites of
+// meshoptimizer, whose encoder writes the data of glTF tools such as gltfpack.
+// clang-format off
+const std::vector<uint8_t> referenceVertices = {
+    0xa0, 0x01, 0x3f, 0x00, 0x00, 0x00, 0x58, 0x57, 0x58, 0x01, 0x26, 0x00,
+    0x00, 0x00, 0x01, 0x0c, 0x00, 0x00, 0x00, 0x58, 0x01, 0x08, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00};
+const std::vector<uint16_t> referenceVerticesDecoded = {
+    0, 0, 0, 0, 300, 0, 0, 0, 0, 300, 0, 0, 300, 300, 0, 0};
+
+const std::vector<uint8_t> referenceTriangles = {
+    0xe0, 0xf0, 0x10, 0xfe, 0xff, 0xf0, 0x0c, 0xff, 0x02, 0x02, 0x02, 0x00,
+    0x76, 0x87, 0x56, 0x67, 0x78, 0xa9, 0x86, 0x65, 0x89, 0x68, 0x98, 0x01,
+    0x69, 0x00, 0x00};
+const std::vector<uint32_t> referenceTrianglesDecoded = {
+    0, 1, 2, 2, 1, 3, 4, 6, 5, 7, 8, 9};
+
+const std::vector<uint8_t> referenceSequence = {
+    0xd1, 0x00, 0x04, 0xcd, 0x01, 0x04, 0x07, 0x98, 0x1f, 0x00, 0x00, 0x00,
+    0x00};
+const std::vector<uint32_t> referenceSequenceDecoded = {
+    0, 1, 51, 2, 49, 1000};
+
+const std::vector<uint8_t> referenceOctahedral8 = {
+    0, 1, 127, 0, 0, 187, 127, 1, 255, 1, 127, 0, 14, 130, 127, 1};
+const std::vector<uint8_t> referenceOctahedral8Decoded = {
+    0, 1, 127, 0, 0, 159, 82, 1, 255, 1, 127, 0, 1, 130, 241, 1};
+
+const std::vector<uint16_t> referenceOctahedral16 = {
+    0, 1, 2047, 0, 0, 1870, 2047, 1, 2017, 1, 2047, 0, 14, 1300, 2047, 1};
+const std::vector<uint16_t> referenceOctahedral16Decoded = {
+    0, 16, 32767, 0, 0, 32621, 3088, 1,
+    32764, 16, 471, 0, 307, 28541, 16093, 1};
+
+const std::vector<uint16_t> referenceQuaternion = {
+    0, 1, 0, 0x7fc, 0, 1870, 0, 0x7fd, 2017, 1, 0, 0x7fe, 14, 1300, 0, 0x7ff};
+const std::vector<uint16_t> referenceQuaternionDecoded = {
+    32767, 0, 11, 0, 0, 25013, 0, 21166,
+    11, 0, 23504, 22830, 158, 14715, 0, 29277};
+
+const std::vector<uint32_t> referenceExponential = {
+    0, 0xff000003, 0x02fffff7, 0xfe7fffff};
+const std::vector<uint32_t> referenceExponentialDecoded = {
+    0, 0x3fc00000, 0xc2100000, 0x49fffffe};
+// clang-format on
+} // namespace
+
+TEST_CASE("Test decodeMeshOpt") {
+  SECTION("Decodes attributes") {
+    // More than one block of 12-byte vertices.
+    std::vector<uint8_t> vertices(12 * 700);
+    for (size_t i = 0; i < vertices.size(); ++i) {
+      vertices[i] = static_cast<uint8_t>((i * 37) ^ (i >> 5));
+    }
+
+    ModelReaderResult result = createModel(
+        encodeVertices(vertices, 12),
+        700,
+        12,
+        MeshOpt::Mode::ATTRIBUTES,
+        MeshOpt::Filter::NONE);
+    decodeMeshOpt(result);
+
+    CHECK(result.warnings.empty());
+    CHECK(getDecoded<uint8_t>(result) == vertices);
+  }
+
+  SECTION("Decodes triangles") {
+    const std::vector<uint32_t> indices = {0, 1, 2, 2, 1, 3, 70000, 5, 4};
+
+    ModelReaderResult result = createModel(
+        encodeTriangles(indices),
+        9,
+        4,
+        MeshOpt::Mode::TRIANGLES,
+        MeshOpt::Filter::NONE);
+    decodeMeshOpt(result);
+
+    CHECK(result.warnings.empty());
+    CHECK(getDecoded<uint32_t>(result) == indices);
+  }
+
+  SECTION("Decodes index sequences") {
+    const std::vector<uint32_t> indices = {5, 3, 400, 401, 0};
+
+    ModelReaderResult result = createModel(
+        encodeSequence(indices),
+        5,
+        2,
+        MeshOpt::Mode::INDICES,
+        MeshOpt::Filter::NONE);
+    decodeMeshOpt(result);
+
+    CHECK(result.warnings.empty());
+    CHECK(
+        getDecoded<uint16_t>(result) ==
+        std::vector<uint16_t>{5, 3, 400, 401, 0});
+  }
+
+  SECTION("Applies the octahedral filter") {
+    // +Z, +X, and -Z, which is folded into the corner.
+    const std::vector<uint8_t> vertices =
+        {0, 0, 127, 1, 127, 0, 127, 2, 127, 127, 127, 3};
+
+    ModelReaderResult result = createModel(
+        encodeVertices(vertices, 4),
+        3,
+        4,
+        MeshOpt::Mode::ATTRIBUTES,
+        MeshOpt::Filter::OCTAHEDRAL);
+    decodeMeshOpt(result);
+
+    CHECK(result.warnings.empty());
+    CHECK(
+        getDecoded<int8_t>(result) ==
+        std::vector<int8_t>{0, 0, 127, 1, 127, 0, 0, 2, 0, 0, -127, 3});
+  }
+
+  SECTION("Applies the quaternion filter") {
+    // The identity with w dropped, and a rotation about X with x dropped.
+    const std::vector<int16_t> quaternions = {0, 0, 0, 32767, 0, 0, 0, 32764};
+    std::vector<uint8_t> vertices(quaternions.size() * sizeof(int16_t));
+    std::memcpy(vertices.data(), quaternions.data(), vertices.size());
+
+    ModelReaderResult result = createModel(
+        encodeVertices(vertices, 8),
+        2,
+        8,
+        MeshOpt::Mode::ATTRIBUTES,
+        MeshOpt::Filter::QUATERNION);
+    decodeMeshOpt(result);
+
+    CHECK(result.warnings.empty());
+    CHECK(
+        getDecoded<int16_t>(result) ==
+        std::vector<int16_t>{0, 0, 0, 32767, 32767, 0, 0, 0});
+  }
+
+  SECTION("Applies the exponential filter") {
+    // 3 * 2^-1 and -5 * 2^2.
+    const std::vector<uint32_t> encoded = {
+        0xff000003,
+        (2U << 24) | ((0U - 5U) & 0xffffff)};
+    std::vector<uint8_t> vertices(encoded.size() * sizeof(uint32_t));
+    std::memcpy(vertices.data(), encoded.data(), vertices.size());
+
+    ModelReaderResult result = createModel(
+        encodeVertices(vertices, 4),
+        2,
+        4,
+        MeshOpt::Mode::ATTRIBUTES,
+        MeshOpt::Filter::EXPONENTIAL);
+    decodeMeshOpt(result);
+
+    CHECK(result.warnings.empty());
+    CHECK(getDecoded<float>(result) == std::vector<float>{1.5f, -20.0f});
+  }
+
+  SECTION("Warns about malformed data") {
+    std::vector<uint8_t> compressed = encodeSequence({1, 2, 3});
+    compressed.pop_back();
+
+    ModelReaderResult result = createModel(
+        compressed,
+        3,
+        4,
+        MeshOpt::Mode::INDICES,
+        MeshOpt::Filter::NONE);
+    decodeMeshOpt(result);
+
+    CHECK(result.warnings.size() == 1);
+  }
+
+  SECTION("Warns about a filter that does not match the stride") {
+    ModelReaderResult result = createModel(
+        encodeVertices(std::vector<uint8_t>(12), 12),
+        1,
+        12,
+        MeshOpt::Mode::ATTRIBUTES,
+        MeshOpt::Filter::QUATERNION);
+    decodeMeshOpt(result);
+
+    CHECK(result.warnings.size() == 1);
+  }
+
+  SECTION("Warns about a bufferView beyond its fallback buffer") {
+    ModelReaderResult result = createModel(
+        encodeSequence({1, 2, 3}),
+        3,
+        4,
+        MeshOpt::Mode::INDICES,
+        MeshOpt::Filter::NONE);
+    result.model->bufferViews[0].byteOffset = int64_t(1) << 40;
+    decodeMeshOpt(result);
+
+    CHECK(result.warnings.size() == 1);
+    CHECK(result.model->buffers[1].cesium.data.empty());
+  }
+}
+
+TEST_CASE("Test decodeMeshOpt with meshoptimizer reference data") {
+  SECTION("Decodes 2-bit byte groups with escaped values") {
+    ModelReaderResult result = createModel(
+        referenceVertices,
+        4,
+        8,
+        MeshOpt::Mode::ATTRIBUTES,
+        MeshOpt::Filter::NONE);
+    decodeMeshOpt(result);
+
+    CHECK(result.warnings.empty());
+    CHECK(getDecoded<uint16_t>(result) == referenceVerticesDecoded);
+  }
+
+  SECTION("Decodes triangles from the code table and the edge FIFO") {
+    ModelReaderResult result = createModel(
+        referenceTriangles,
+        12,
+        4,
+        MeshOpt::Mode::TRIANGLES,
+        MeshOpt::Filter::NONE);
+    decodeMeshOpt(result);
+
+    CHECK(result.warnings.empty());
+    CHECK(getDecoded<uint32_t>(result) == referenceTrianglesDecoded);
+  }
+
+  SECTION("Decodes an index sequence") {
+    ModelReaderResult result = createModel(
+        referenceSequence,
+        6,
+        4,
+        MeshOpt::Mode::INDICES,
+        MeshOpt::Filter::NONE);
+    decodeMeshOpt(result);
+
+    CHECK(result.warnings.empty());
+    CHECK(getDecoded<uint32_t>(result) == referenceSequenceDecoded);
+  }
+
+  // meshoptimizer tests its filters without the vertex codec, so the filtered
+  // values are stored with the literal encoding.
+  SECTION("Applies the octahedral filter to bytes") {
+    ModelReaderResult result = createModel(
+        encodeVertices(referenceOctahedral8, 4),
+        4,
+        4,
+        MeshOpt::Mode::ATTRIBUTES,
+        MeshOpt::Filter::OCTAHEDRAL);
+    decodeMeshOpt(result);
+
+    CHECK(result.warnings.empty());
+    CHECK(getDecoded<uint8_t>(result) == referenceOctahedral8Decoded);
+  }
+
+  SECTION("Applies the octahedral filter to shorts") {
+    ModelReaderResult result = createModel(
+        encodeVertices(toBytes(referenceOctahedral16), 8),
+        4,
+        8,
+        MeshOpt::Mode::ATTRIBUTES,
+        MeshOpt::Filter::OCTAHEDRAL);
+    decodeMeshOpt(result);
+
+    CHECK(result.warnings.empty());
+    CHECK(getDecoded<uint16_t>(result) == referenceOctahedral16Decoded);
+  }
+
+  SECTION("Applies the quaternion filter") {
+    ModelReaderResult result = createModel(
+        encodeVertices(toBytes(referenceQuaternion), 8),
+        4,
+        8,
+        MeshOpt::Mode::ATTRIBUTES,
+        MeshOpt::Filter::QUATERNION);
+    decodeMeshOpt(result);
+
+    CHECK(result.warnings.empty());
+    CHECK(getDecoded<uint16_t>(result) == referenceQuaternionDecoded);
+  }
+
+  SECTION("Applies the exponential filter") {
+    ModelReaderResult result = createModel(
+        encodeVertices(toBytes(referenceExponential), 4),
+        4,
+        4,
+        MeshOpt::Mode::ATTRIBUTES,
+        MeshOpt::Filter::EXPONENTIAL);
+    decodeMeshOpt(result);
+
+    CHECK(result.warnings.empty());
+    CHECK(getDecoded<uint32_t>(result) == referenceExponentialDecoded);
+  }
+}
+
+// meshoptimizer's test suites have no small examples of these paths, so these
+// streams are assembled by hand, as meshoptimizer's encoder would write them.
+TEST_CASE("Test decodeMeshOpt with hand-assembled data") {
+  SECTION("Decodes 4-bit byte groups with escaped values") {
+    // The first byte of each vertex increases by 3 fourteen times and then by
+    // 100, so its zigzag deltas are 0, fourteen 6s, and 200, which does not
+    // fit in 4 bits. The other bytes are zero.
+    // clang-format off
+    std::vector<uint8_t> compressed = {
+        0xa0, 0x02, 0x06, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66, 0x6f, 0xc8, 0x00,
+        0x00, 0x00};
+    // clang-format on
+    compressed.resize(compressed.size() + 32, 0);
+
+    ModelReaderResult result = createModel(
+        compressed,
+        16,
+        4,
+        MeshOpt::Mode::ATTRIBUTES,
+        MeshOpt::Filter::NONE);
+    decodeMeshOpt(result);
+
+    std::vector<uint8_t> expected(16 * 4, 0);
+    for (size_t i = 0; i < 15; ++i) {
+      expected[i * 4] = static_cast<uint8_t>(i * 3);
+    }
+    expected[15 * 4] = 142;
+
+    CHECK(result.warnings.empty());
+    CHECK(getDecoded<uint8_t>(result) == expected);
+  }
+
+  SECTION("Decodes explicit, relative, and restarted triangles") {
+    // 0xf0 reads three new vertices from the code table. 0x1f reuses the
+    // second most recent edge with the explicit index 10, stored as 0x14.
+    // 0x0e and 0x0d reuse the most recent edge with the last explicit index
+    // plus and minus one. 0xfe followed by a code of 0 restarts the new
+    // vertices at 0. The tail is the code table of the reference data.
+    std::vector<uint8_t> compressed =
+        {0xe1, 0xf0, 0x1f, 0x0e, 0x0d, 0xfe, 0x14, 0x00};
+    compressed.insert(
+        compressed.end(),
+        referenceTriangles.end() - 16,
+        referenceTriangles.end());
+
+    ModelReaderResult result = createModel(
+        compressed,
+        15,
+        4,
+        MeshOpt::Mode::TRIANGLES,
+        MeshOpt::Filter::NONE);
+    decodeMeshOpt(result);
+
+    const std::vector<uint32_t> expected =
+        {0, 1, 2, 2, 1, 10, 2, 10, 11, 2, 11, 10, 0, 1, 2};
+
+    CHECK(result.warnings.empty());
+    CHECK(getDecoded<uint32_t>(result) == expected);
+  }
+}
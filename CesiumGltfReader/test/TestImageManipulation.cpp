@@ -332,3 +332,55 @@ TEST_CASE("ImageManipulation::blitImage") {
     verifyTargetUnchanged();
   }
 }
+
+TEST_CASE("ImageManipulation::blitImage filters scaled pixels") {
+  ImageCesium source;
+  source.width = 4;
+  source.height = 2;
+  source.channels = 1;
+  source.bytesPerChannel = 1;
+  source.pixelData = {
+      std::byte(10),
+      std::byte(20),
+      std::byte(30),
+      std::byte(40),
+      std::byte(50),
+      std::byte(60),
+      std::byte(70),
+      std::byte(80)};
+
+  ImageCesium target;
+  target.channels = 1;
+  target.bytesPerChannel = 1;
+
+  SECTION("enlarges with bilinear filtering") {
+    target.width = 4;
+    target.height = 1;
+    target.pixelData.resize(4);
+
+    // The first row of the source is (10, 20), scaled by two.
+    CHECK(ImageManipulation::blitImage(
+        target,
+        PixelRectangle{0, 0, 4, 1},
+        source,
+        PixelRectangle{0, 0, 2, 1}));
+    CHECK(target.pixelData[0] == std::byte(10));
+    CHECK(target.pixelData[1] == std::byte(13));
+    CHECK(target.pixelData[2] == std::byte(18));
+    CHECK(target.pixelData[3] == std::byte(20));
+  }
+
+  SECTION("shrinks by averaging blocks of pixels") {
+    target.width = 2;
+    target.height = 1;
+    target.pixelData.resize(2);
+
+    CHECK(ImageManipulation::blitImage(
+        target,
+        PixelRectangle{0, 0, 2, 1},
+        source,
+        PixelRectangle{0, 0, 4, 2}));
+    CHECK(target.pixelData[0] == std::byte(35));
+    CHECK(target.pixelData[1] == std::byte(55));
+  }
+}
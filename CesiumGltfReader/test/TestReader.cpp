@@ -1,6 +1,8 @@
 #include "CesiumGltf/GltfReader.h"
 
 #include <CesiumGltf/AccessorView.h>
+#include <CesiumGltf/ExtensionBufferExtMeshoptCompression.h>
+#include <CesiumGltf/ExtensionBufferViewExtMeshoptCompression.h>
 #include <CesiumGltf/ExtensionKhrDracoMeshCompression.h>
 
 #include <catch2/catch.hpp>
@@ -10,6 +12,7 @@
 
 #include <filesystem>
 #include <fstream>
+#include <optional>
 #include <string>
 
 using namespace CesiumGltf;
@@ -276,6 +279,82 @@ TEST_CASE("Can deserialize KHR_draco_mesh_compression") {
   REQUIRE(!primitive3.getExtension<ExtensionKhrDracoMeshCompression>());
 }
 
+TEST_CASE("Can deserialize EXT_meshopt_compression") {
+  const std::string s = R"(
+    {
+      "asset": {
+        "version": "2.0"
+      },
+      "buffers": [
+        {
+          "byteLength": 100
+        },
+        {
+          "byteLength": 160,
+          "extensions": {
+            "EXT_meshopt_compression": {
+              "fallback": true
+            }
+          }
+        }
+      ],
+      "bufferViews": [
+        {
+          "buffer": 1,
+          "byteLength": 160,
+          "byteStride": 8,
+          "extensions": {
+            "EXT_meshopt_compression": {
+              "buffer": 0,
+              "byteOffset": 4,
+              "byteLength": 96,
+              "byteStride": 8,
+              "count": 20,
+              "mode": "ATTRIBUTES",
+              "filter": "QUATERNION"
+            }
+          }
+        }
+      ]
+    }
+  )";
+
+  ReadModelOptions options;
+  options.decodeMeshOpt = false;
+  CesiumGltf::GltfReader reader;
+  ModelReaderResult modelResult = reader.readModel(
+      gsl::span(reinterpret_cast<const std::byte*>(s.c_str()), s.size()),
+      options);
+
+  REQUIRE(modelResult.errors.empty());
+  REQUIRE(modelResult.model.has_value());
+
+  Model& model = modelResult.model.value();
+  REQUIRE(model.buffers.size() == 2);
+  REQUIRE(model.bufferViews.size() == 1);
+
+  ExtensionBufferExtMeshoptCompression* pFallback =
+      model.buffers[1].getExtension<ExtensionBufferExtMeshoptCompression>();
+  REQUIRE(pFallback);
+  CHECK(pFallback->fallback);
+
+  ExtensionBufferViewExtMeshoptCompression* pMeshOpt =
+      model.bufferViews[0]
+          .getExtension<ExtensionBufferViewExtMeshoptCompression>();
+  REQUIRE(pMeshOpt);
+  CHECK(pMeshOpt->buffer == 0);
+  CHECK(pMeshOpt->byteOffset == 4);
+  CHECK(pMeshOpt->byteLength == 96);
+  CHECK(pMeshOpt->byteStride == 8);
+  CHECK(pMeshOpt->count == 20);
+  CHECK(
+      pMeshOpt->mode ==
+      ExtensionBufferViewExtMeshoptCompression::Mode::ATTRIBUTES);
+  CHECK(
+      pMeshOpt->filter ==
+      ExtensionBufferViewExtMeshoptCompression::Filter::QUATERNION);
+}
+
 TEST_CASE("Extensions deserialize to JsonVaue iff "
           "a default extension is registered") {
   const std::string s = R"(
@@ -359,3 +438,191 @@ TEST_CASE("Unknown MIME types are handled") {
   // because no images could be read.
   REQUIRE(modelResult.model.has_value());
 }
+
+namespace {
+// Creates the JSON of a glTF with many small objects, like the ones of tiles
+// that are split into many meshes and nodes.
+std::string createLargeGltfJson(size_t meshCount) {
+  std::string accessors;
+  std::string meshes;
+  std::string nodes;
+  std::string children;
+  for (size_t i = 0; i < meshCount; ++i) {
+    const std::string index = std::to_string(i);
+    const std::string separator = i == 0 ? "" : ",";
+    accessors += separator +
+                 R"({"bufferView": 0, "componentType": 5126, "count": 3,)"
+                 R"( "type": "VEC3", "min": [0, 0, 0], "max": [1, 1, 1],)"
+                 R"( "name": "positions )" +
+                 index + R"("})";
+    meshes += separator + R"({"primitives": [{"attributes": {"POSITION": )" +
+              index + R"(}, "material": 0, "extras": {"id": )" + index +
+              "}}]}";
+    nodes += separator + R"({"mesh": )" + index +
+             R"(, "translation": [1.0, 2.0, 3.0]})";
+    children += separator + std::to_string(i + 1);
+  }
+
+  return R"({"asset": {"version": "2.0"},)"
+         R"( "buffers": [{"byteLength": 36}],)"
+         R"( "bufferViews": [{"buffer": 0, "byteLength": 36}],)"
+         R"( "materials": [{"pbrMetallicRoughness": {"metallicFactor": 0}}],)"
+         R"( "accessors": [)" +
+         accessors + R"(], "meshes": [)" + meshes +
+         R"(], "nodes": [{"children": [)" + children + "]}, " + nodes +
+         R"(], "scenes": [{"nodes": [0]}], "scene": 0})";
+}
+} // namespace
+
+TEST_CASE("GltfReader reads the same model again with reused handlers") {
+  const std::string json = createLargeGltfJson(10);
+  const gsl::span<const std::byte> data(
+      reinterpret_cast<const std::byte*>(json.data()),
+      json.size());
+
+  CesiumGltf::GltfReader reader;
+  ModelReaderResult first = reader.readModel(data);
+  REQUIRE(first.model);
+  CHECK(first.errors.empty());
+
+  // A model with an error leaves the handlers in the middle of an object.
+  const std::string invalid = R"({"meshes": [{"primitives": [{"attributes")";
+  ModelReaderResult failed = reader.readModel(gsl::span<const std::byte>(
+      reinterpret_cast<const std::byte*>(invalid.data()),
+      invalid.size()));
+  CHECK(!failed.model);
+
+  ModelReaderResult second = reader.readModel(data);
+  REQUIRE(second.model);
+  CHECK(second.errors.empty());
+
+  const Model& model = *second.model;
+  REQUIRE(model.accessors.size() == 10);
+  REQUIRE(model.meshes.size() == 10);
+  REQUIRE(model.nodes.size() == 11);
+  CHECK(model.accessors[9].name == "positions 9");
+  CHECK(model.accessors[9].max == std::vector<double>{1.0, 1.0, 1.0});
+  CHECK(model.meshes[9].primitives.size() == 1);
+  CHECK(model.meshes[9].primitives[0].attributes.at("POSITION") == 9);
+  CHECK(
+      model.meshes[9].primitives[0].extras.at("id").getSafeNumberOrDefault(
+          0) == 9);
+  CHECK(model.nodes[0].children.size() == 10);
+  CHECK(model.nodes[10].mesh == 9);
+  CHECK(model.materials.size() == 1);
+}
+
+TEST_CASE("GltfReader can be copied and moved after reading") {
+  const std::string json = createLargeGltfJson(2);
+  const gsl::span<const std::byte> data(
+      reinterpret_cast<const std::byte*>(json.data()),
+      json.size());
+
+  std::optional<CesiumGltf::GltfReader> original(std::in_place);
+  REQUIRE(original->readModel(data).model);
+
+  CesiumGltf::GltfReader copied(*original);
+  CesiumGltf::GltfReader moved(std::move(*original));
+  original.reset();
+
+  ModelReaderResult fromCopy = copied.readModel(data);
+  REQUIRE(fromCopy.model);
+  CHECK(fromCopy.model->meshes.size() == 2);
+
+  ModelReaderResult fromMove = moved.readModel(data);
+  REQUIRE(fromMove.model);
+  CHECK(fromMove.model->meshes.size() == 2);
+
+  copied = moved;
+  moved = std::move(copied);
+  ModelReaderResult fromAssigned = moved.readModel(data);
+  REQUIRE(fromAssigned.model);
+  CHECK(fromAssigned.model->meshes.size() == 2);
+}
+
+TEST_CASE("Benchmark GltfReader::readModel", "[.][benchmark]") {
+  const std::string json = createLargeGltfJson(5000);
+  const gsl::span<const std::byte> data(
+      reinterpret_cast<const std::byte*>(json.data()),
+      json.size());
+
+  CesiumGltf::GltfReader reader;
+  ReadModelOptions options;
+  options.decodeDataUrls = false;
+  options.decodeEmbeddedImages = false;
+  options.decodeDraco = false;
+
+  BENCHMARK("read 5000 meshes") {
+    return reader.readModel(data, options).model->meshes.size();
+  };
+
+  ReadModelOptions skippingOptions = options;
+  skippingOptions.readExtras = false;
+
+  BENCHMARK("read 5000 meshes, skipping extras") {
+    return reader.readModel(data, skippingOptions).model->meshes.size();
+  };
+}
+
+TEST_CASE("GltfReader skips the parts of a glTF that are not needed") {
+  const std::string json = R"(
+    {
+      "asset": { "version": "2.0", "extras": { "generator": "test" } },
+      "animations": [{ "channels": [], "samplers": [] }],
+      "skins": [{ "joints": [0] }],
+      "cameras": [{ "type": "perspective" }],
+      "nodes": [{
+        "extras": { "id": 1 },
+        "extensions": { "EXT_unknown": { "value": 2 } }
+      }]
+    }
+  )";
+  const gsl::span<const std::byte> data(
+      reinterpret_cast<const std::byte*>(json.data()),
+      json.size());
+
+  CesiumGltf::GltfReader reader;
+  ModelReaderResult all = reader.readModel(data);
+  REQUIRE(all.model);
+  CHECK(all.model->animations.size() == 1);
+  CHECK(all.model->skins.size() == 1);
+  CHECK(all.model->cameras.size() == 1);
+  CHECK(all.model->nodes[0].extras.size() == 1);
+  CHECK(all.model->nodes[0].getGenericExtension("EXT_unknown") != nullptr);
+
+  ReadModelOptions options;
+  options.readAnimations = false;
+  options.readSkins = false;
+  options.readCameras = false;
+  options.readExtras = false;
+  options.readUnknownExtensions = false;
+
+  ModelReaderResult skipped = reader.readModel(data, options);
+  REQUIRE(skipped.model);
+  CHECK(skipped.errors.empty());
+  CHECK(skipped.model->animations.empty());
+  CHECK(skipped.model->skins.empty());
+  CHECK(skipped.model->cameras.empty());
+  CHECK(skipped.model->asset.version == "2.0");
+  CHECK(skipped.model->asset.extras.empty());
+  REQUIRE(skipped.model->nodes.size() == 1);
+  CHECK(skipped.model->nodes[0].extras.empty());
+  CHECK(skipped.model->nodes[0].extensions.empty());
+
+  // An unknown extension with a state of its own is still read.
+  reader.getExtensions().setExtensionState(
+      "EXT_unknown",
+      CesiumJsonReader::ExtensionState::Enabled);
+  ModelReaderResult withExtension = reader.readModel(data, options);
+  REQUIRE(withExtension.model);
+  CHECK(
+      withExtension.model->nodes[0].getGenericExtension("EXT_unknown") !=
+      nullptr);
+
+  // The options apply only to the read they are given to.
+  ModelReaderResult again = reader.readModel(data);
+  REQUIRE(again.model);
+  CHECK(again.model->cameras.size() == 1);
+  CHECK(again.model->asset.extras.size() == 1);
+  CHECK(again.model->nodes[0].extras.size() == 1);
+}
@@ -7,12 +7,21 @@
 
 #include <CesiumGltf/Model.h>
 
+#include <gsl/span>
+
 #include <cstdint>
+#include <functional>
 #include <string_view>
 #include <vector>
 
 namespace CesiumGltf {
 
+/**
+ * @brief Receives the bytes of a glTF or GLB asset, in order, as they are
+ * written. The bytes are only valid for the duration of the call.
+ */
+using WriteModelSink = std::function<void(const gsl::span<const std::byte>&)>;
+
 /**
  * @brief Write a glTF or glb asset to a byte vector.
  *
@@ -81,4 +90,32 @@ CESIUMGLTFWRITER_API WriteModelResult writeModelAndExternalFiles(
     const WriteModelOptions& options,
     std::string_view filename,
     const WriteGLTFCallback& writeGLTFCallback);
+
+/**
+ * @brief Write a glTF or glb asset to a sink incrementally, without building
+ * the whole asset in memory.
+ *
+ * @param model Final assembled glTF asset, ready for serialization.
+ * @param options Options to use for exporting the asset.
+ * @param sink The sink to receive the bytes of the asset.
+ *
+ * @returns A {@link CesiumGltf::WriteModelResult} containing a list of
+ * errors and warnings. Its `gltfAssetBytes` are always empty.
+ *
+ * @details Serializes the model in the same way as
+ * {@link CesiumGltf::writeModelAsEmbeddedBytes}. Only the JSON is built in
+ * memory. For a GLB, the sizes of the chunks and their padding are computed
+ * from the JSON and `model.buffers[0].cesium.data`, and then the header, the
+ * JSON chunk, and the binary chunk are passed to the sink in order. The binary
+ * chunk is passed directly from `model.buffers[0].cesium.data` rather than
+ * copied.
+ *
+ * Nothing is passed to the sink if there are errors, including a
+ * GLBTooLarge error if the GLB would be 4 GiB or more, which is more than
+ * its header can describe.
+ */
+CESIUMGLTFWRITER_API WriteModelResult writeModelToSink(
+    const Model& model,
+    const WriteModelOptions& options,
+    const WriteModelSink& sink);
 } // namespace CesiumGltf
@@ -1,6 +1,6 @@
 #include "WriteBinaryGLB.h"
 
-#include <algorithm>
+#include <array>
 
 const std::size_t BYTE_HEADER_SIZE = 12;
 const std::size_t CHUNK_HEADER_MINIMUM_SIZE = 8;
@@ -8,91 +8,90 @@ const std::uint32_t GLB_CONTAINER_VERSION = 2;
 const std::byte PADDING_CHAR = std::byte(0x20);
 
 [[nodiscard]] inline std::size_t nextMultipleOfFour(std::size_t n) noexcept {
-  return (n + 3) & ~0x03ul;
+  return (n + 3) & ~std::size_t(0x03);
 }
 
-void writeGLTFHeader(std::vector<std::byte>& glbBuffer) noexcept {
-  glbBuffer[0] = std::byte('g');
-  glbBuffer[1] = std::byte('l');
-  glbBuffer[2] = std::byte('T');
-  glbBuffer[3] = std::byte('F');
-
-  glbBuffer[4] = std::byte(GLB_CONTAINER_VERSION & 0xff);
-  glbBuffer[5] = std::byte((GLB_CONTAINER_VERSION >> 8) & 0xff);
-  glbBuffer[6] = std::byte((GLB_CONTAINER_VERSION >> 16) & 0xff);
-  glbBuffer[7] = std::byte((GLB_CONTAINER_VERSION >> 24) & 0xff);
+void writeUint32(std::byte* pDestination, std::uint64_t value) noexcept {
+  pDestination[0] = std::byte(value & 0xff);
+  pDestination[1] = std::byte((value >> 8) & 0xff);
+  pDestination[2] = std::byte((value >> 16) & 0xff);
+  pDestination[3] = std::byte((value >> 24) & 0xff);
 }
 
-void writeGLBSize(std::vector<std::byte>& glbBuffer) noexcept {
-  const auto totalGLBLength = glbBuffer.size();
-  glbBuffer[8] = std::byte(totalGLBLength & 0xff);
-  glbBuffer[9] = std::byte((totalGLBLength >> 8) & 0xff);
-  glbBuffer[10] = std::byte((totalGLBLength >> 16) & 0xff);
-  glbBuffer[11] = std::byte((totalGLBLength >> 24) & 0xff);
+void writePadding(
+    std::size_t paddingLength,
+    const CesiumGltf::WriteModelSink& sink) {
+  static const std::array<std::byte, 3> padding{
+      PADDING_CHAR,
+      PADDING_CHAR,
+      PADDING_CHAR};
+  if (paddingLength > 0) {
+    sink(gsl::span<const std::byte>(padding.data(), paddingLength));
+  }
 }
 
-void writeGLBJsonChunk(
-    std::vector<std::byte>& glbBuffer,
-    const std::string_view& gltfJson) {
-  const auto jsonLength = gltfJson.size();
-  const auto paddingLength = nextMultipleOfFour(jsonLength) - jsonLength;
-  const auto chunkLength = jsonLength + paddingLength;
-
-  glbBuffer[12] = std::byte(chunkLength & 0xff);
-  glbBuffer[13] = std::byte((chunkLength >> 8) & 0xff);
-  glbBuffer[14] = std::byte((chunkLength >> 16) & 0xff);
-  glbBuffer[15] = std::byte((chunkLength >> 24) & 0xff);
-
-  glbBuffer[16] = std::byte(GLBChunkType::JSON & 0xff);
-  glbBuffer[17] = std::byte((GLBChunkType::JSON >> 8) & 0xff);
-  glbBuffer[18] = std::byte((GLBChunkType::JSON >> 16) & 0xff);
-  glbBuffer[19] = std::byte((GLBChunkType::JSON >> 24) & 0xff);
-
-  for (const auto c : gltfJson) {
-    glbBuffer.emplace_back(std::byte(c));
+std::uint64_t CesiumGltf::computeBinaryGLBSize(
+    std::size_t binaryChunkSize,
+    std::size_t gltfJsonSize) noexcept {
+  std::uint64_t size = BYTE_HEADER_SIZE + CHUNK_HEADER_MINIMUM_SIZE +
+                       nextMultipleOfFour(gltfJsonSize);
+  if (binaryChunkSize > 0) {
+    size += CHUNK_HEADER_MINIMUM_SIZE + nextMultipleOfFour(binaryChunkSize);
   }
-
-  glbBuffer.insert(glbBuffer.end(), paddingLength, PADDING_CHAR);
+  return size;
 }
 
-void writeGLBBinaryChunk(
-    std::vector<std::byte>& glbBuffer,
-    const std::vector<std::byte>& binaryChunk,
-    std::size_t byteOffset) {
+void CesiumGltf::writeBinaryGLB(
+    const gsl::span<const std::byte>& binaryChunk,
+    const std::string_view& gltfJson,
+    const WriteModelSink& sink) {
+  const std::size_t jsonChunkLength = nextMultipleOfFour(gltfJson.size());
+
+  std::array<std::byte, BYTE_HEADER_SIZE + CHUNK_HEADER_MINIMUM_SIZE> header;
+  header[0] = std::byte('g');
+  header[1] = std::byte('l');
+  header[2] = std::byte('T');
+  header[3] = std::byte('F');
+  writeUint32(&header[4], GLB_CONTAINER_VERSION);
+  writeUint32(
+      &header[8],
+      computeBinaryGLBSize(binaryChunk.size(), gltfJson.size()));
+  writeUint32(&header[12], jsonChunkLength);
+  writeUint32(&header[16], GLBChunkType::JSON);
+
+  sink(header);
+  sink(gsl::span<const std::byte>(
+      reinterpret_cast<const std::byte*>(gltfJson.data()),
+      gltfJson.size()));
+  writePadding(jsonChunkLength - gltfJson.size(), sink);
 
-  const auto bufferLength = binaryChunk.size();
-  const auto paddingLength = nextMultipleOfFour(bufferLength) - bufferLength;
-  const auto chunkLength = bufferLength + paddingLength;
-
-  glbBuffer.resize(glbBuffer.size() + CHUNK_HEADER_MINIMUM_SIZE);
-
-  glbBuffer[byteOffset + 0] = std::byte(chunkLength & 0xff);
-  glbBuffer[byteOffset + 1] = std::byte((chunkLength >> 8) & 0xff);
-  glbBuffer[byteOffset + 2] = std::byte((chunkLength >> 16) & 0xff);
-  glbBuffer[byteOffset + 3] = std::byte((chunkLength >> 24) & 0xff);
+  if (!binaryChunk.empty()) {
+    const std::size_t binaryChunkLength =
+        nextMultipleOfFour(binaryChunk.size());
 
-  glbBuffer[byteOffset + 4] = std::byte(GLBChunkType::BIN & 0xff);
-  glbBuffer[byteOffset + 5] = std::byte((GLBChunkType::BIN >> 8) & 0xff);
-  glbBuffer[byteOffset + 6] = std::byte((GLBChunkType::BIN >> 16) & 0xff);
-  glbBuffer[byteOffset + 7] = std::byte((GLBChunkType::BIN >> 24) & 0xff);
+    std::array<std::byte, CHUNK_HEADER_MINIMUM_SIZE> chunkHeader;
+    writeUint32(&chunkHeader[0], binaryChunkLength);
+    writeUint32(&chunkHeader[4], GLBChunkType::BIN);
 
-  glbBuffer.insert(glbBuffer.end(), binaryChunk.begin(), binaryChunk.end());
-  glbBuffer.insert(glbBuffer.end(), paddingLength, PADDING_CHAR);
+    sink(chunkHeader);
+    sink(binaryChunk);
+    writePadding(binaryChunkLength - binaryChunk.size(), sink);
+  }
 }
 
 [[nodiscard]] std::vector<std::byte> CesiumGltf::writeBinaryGLB(
     const std::vector<std::byte>& binaryChunk,
     const std::string_view& gltfJson) {
+  std::vector<std::byte> glbBuffer;
+  glbBuffer.reserve(static_cast<std::size_t>(
+      computeBinaryGLBSize(binaryChunk.size(), gltfJson.size())));
 
-  std::vector<std::byte> glbBuffer(
-      BYTE_HEADER_SIZE + CHUNK_HEADER_MINIMUM_SIZE);
-  writeGLTFHeader(glbBuffer);
-  writeGLBJsonChunk(glbBuffer, gltfJson);
-
-  if (!binaryChunk.empty()) {
-    writeGLBBinaryChunk(glbBuffer, binaryChunk, glbBuffer.size());
-  }
+  writeBinaryGLB(
+      binaryChunk,
+      gltfJson,
+      [&glbBuffer](const gsl::span<const std::byte>& bytes) {
+        glbBuffer.insert(glbBuffer.end(), bytes.begin(), bytes.end());
+      });
 
-  writeGLBSize(glbBuffer);
   return glbBuffer;
 }
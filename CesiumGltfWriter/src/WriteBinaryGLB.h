@@ -1,6 +1,9 @@
 #pragma once
 
 #include <CesiumGltf/Model.h>
+#include <CesiumGltf/Writer.h>
+
+#include <gsl/span>
 
 #include <cstdint>
 #include <string_view>
@@ -9,7 +12,29 @@
 enum GLBChunkType { JSON = 0x4E4F534A, BIN = 0x004E4942 };
 
 namespace CesiumGltf {
+/**
+ * @brief Computes the total size of a GLB, including its header and the
+ * headers and padding of its chunks.
+ *
+ * @param binaryChunkSize The size of the binary chunk, or 0 if there is none.
+ * @param gltfJsonSize The size of the JSON.
+ */
+std::uint64_t computeBinaryGLBSize(
+    std::size_t binaryChunkSize,
+    std::size_t gltfJsonSize) noexcept;
+
+/**
+ * @brief Writes a GLB to a sink in order, without assembling it in memory.
+ *
+ * The binary chunk is passed to the sink directly from `binaryChunk`. The
+ * total size must fit in the 32-bit length of the GLB header.
+ */
+void writeBinaryGLB(
+    const gsl::span<const std::byte>& binaryChunk,
+    const std::string_view& gltfJson,
+    const WriteModelSink& sink);
+
 std::vector<std::byte> writeBinaryGLB(
     const std::vector<std::byte>& binaryChunk,
     const std::string_view& gltfJson);
-}
+} // namespace CesiumGltf
@@ -28,6 +28,7 @@
 
 #include <array>
 #include <cstdio>
+#include <limits>
 #include <optional>
 #include <stdexcept>
 #include <string_view>
@@ -55,6 +56,50 @@ WriteModelResult CesiumGltf::writeModelAndExternalFiles(
   return writeModel(model, options, filename, writeGLTFCallback);
 }
 
+namespace {
+std::unique_ptr<CesiumJsonWriter::JsonWriter> writeModelJson(
+    WriteModelResult& result,
+    const Model& model,
+    const WriteModelOptions& options,
+    const WriteGLTFCallback& writeGLTFCallback);
+} // namespace
+
+WriteModelResult CesiumGltf::writeModelToSink(
+    const Model& model,
+    const WriteModelOptions& options,
+    const WriteModelSink& sink) {
+  WriteModelResult result;
+  const std::unique_ptr<CesiumJsonWriter::JsonWriter> writer =
+      writeModelJson(result, model, options, noopGltfWriter);
+  if (!result.errors.empty()) {
+    return result;
+  }
+
+  const std::string_view gltfJson = writer->toStringView();
+  if (options.exportType != GltfExportType::GLB) {
+    sink(gsl::span<const std::byte>(
+        reinterpret_cast<const std::byte*>(gltfJson.data()),
+        gltfJson.size()));
+    return result;
+  }
+
+  gsl::span<const std::byte> binaryChunk;
+  if (!model.buffers.empty()) {
+    binaryChunk = model.buffers[0].cesium.data;
+  }
+
+  if (computeBinaryGLBSize(binaryChunk.size(), gltfJson.size()) >
+      std::numeric_limits<std::uint32_t>::max()) {
+    result.errors.emplace_back(
+        "GLBTooLarge: the GLB would be 4 GiB or larger, which is more than "
+        "the length in its header can describe");
+    return result;
+  }
+
+  writeBinaryGLB(binaryChunk, gltfJson, sink);
+  return result;
+}
+
 WriteModelResult writeModel(
     const Model& model,
     const WriteModelOptions& options,
@@ -62,6 +107,34 @@ WriteModelResult writeModel(
     const WriteGLTFCallback& writeGLTFCallback) {
 
   WriteModelResult result;
+  const std::unique_ptr<CesiumJsonWriter::JsonWriter> writer =
+      writeModelJson(result, model, options, writeGLTFCallback);
+
+  if (options.exportType == GltfExportType::GLB) {
+    if (model.buffers.empty()) {
+      result.gltfAssetBytes =
+          writeBinaryGLB(std::vector<std::byte>{}, writer->toStringView());
+    }
+
+    else {
+      result.gltfAssetBytes = writeBinaryGLB(
+          model.buffers.at(0).cesium.data,
+          writer->toStringView());
+    }
+  } else {
+    result.gltfAssetBytes = writer->toBytes();
+  }
+
+  writeGLTFCallback(filename, result.gltfAssetBytes);
+  return result;
+}
+
+namespace {
+std::unique_ptr<CesiumJsonWriter::JsonWriter> writeModelJson(
+    WriteModelResult& result,
+    const Model& model,
+    const WriteModelOptions& options,
+    const WriteGLTFCallback& writeGLTFCallback) {
   std::unique_ptr<CesiumJsonWriter::JsonWriter> writer;
 
   if (options.prettyPrint) {
@@ -120,21 +193,6 @@ WriteModelResult writeModel(
 
   writer->EndObject();
 
-  if (options.exportType == GltfExportType::GLB) {
-    if (model.buffers.empty()) {
-      result.gltfAssetBytes =
-          writeBinaryGLB(std::vector<std::byte>{}, writer->toStringView());
-    }
-
-    else {
-      result.gltfAssetBytes = writeBinaryGLB(
-          model.buffers.at(0).cesium.data,
-          writer->toStringView());
-    }
-  } else {
-    result.gltfAssetBytes = writer->toBytes();
-  }
-
-  writeGLTFCallback(filename, result.gltfAssetBytes);
-  return result;
+  return writer;
 }
+} // namespace
@@ -272,3 +272,58 @@ TEST_CASE("Basic triangle is serialized to embedded glTF 2.0", "[GltfWriter]") {
   REQUIRE(writeResultGlb.warnings.empty());
   validateStructure(writeResultGlb.gltfAssetBytes);
 }
+
+TEST_CASE("Writes a model to a sink incrementally", "[GltfWriter]") {
+  const Model model = generateTriangleModel();
+
+  std::vector<std::byte> streamed;
+  bool isBufferWrittenDirectly = false;
+  const WriteModelSink sink = [&](const gsl::span<const std::byte>& bytes) {
+    if (bytes.data() == model.buffers[0].cesium.data.data()) {
+      isBufferWrittenDirectly = true;
+    }
+    streamed.insert(streamed.end(), bytes.begin(), bytes.end());
+  };
+
+  CesiumGltf::WriteModelOptions options;
+  options.exportType = CesiumGltf::GltfExportType::GLB;
+
+  const WriteModelResult glbResult = writeModelToSink(model, options, sink);
+  REQUIRE(glbResult.errors.empty());
+  CHECK(glbResult.gltfAssetBytes.empty());
+  CHECK(isBufferWrittenDirectly);
+  CHECK(
+      streamed ==
+      writeModelAsEmbeddedBytes(model, options).gltfAssetBytes);
+  CHECK(streamed.size() % 4 == 0);
+
+  streamed.clear();
+  options.exportType = CesiumGltf::GltfExportType::GLTF;
+  options.autoConvertDataToBase64 = true;
+
+  const WriteModelResult gltfResult = writeModelToSink(model, options, sink);
+  REQUIRE(gltfResult.errors.empty());
+  CHECK(
+      streamed ==
+      writeModelAsEmbeddedBytes(model, options).gltfAssetBytes);
+}
+
+TEST_CASE(
+    "Writes nothing to a sink if the model has errors",
+    "[GltfWriter]") {
+  Model model = generateTriangleModel();
+  model.buffers[0].uri = "triangle.bin";
+
+  CesiumGltf::WriteModelOptions options;
+  options.exportType = CesiumGltf::GltfExportType::GLB;
+
+  bool isSinkCalled = false;
+  const WriteModelResult result = writeModelToSink(
+      model,
+      options,
+      [&isSinkCalled](const gsl::span<const std::byte>& /*bytes*/) {
+        isSinkCalled = true;
+      });
+  CHECK(!result.errors.empty());
+  CHECK(!isSinkCalled);
+}
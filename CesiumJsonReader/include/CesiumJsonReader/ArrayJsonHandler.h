@@ -26,7 +26,12 @@ public:
     JsonHandler::reset(pParent);
     this->_pArray = pArray;
     this->_arrayIsOpen = false;
-    this->_objectHandler.reset(this->_handlerFactory());
+
+    // The element handler may own a large tree of nested handlers, so it is
+    // created the first time it's needed and then reused for every array.
+    if (!this->_objectHandler) {
+      this->_objectHandler.reset(this->_handlerFactory());
+    }
   }
 
   virtual IJsonHandler* readNull() override {
@@ -4,7 +4,10 @@
 #include "Library.h"
 #include "ObjectJsonHandler.h"
 
+#include <CesiumUtility/JsonValue.h>
+
 #include <map>
+#include <type_traits>
 #include <unordered_map>
 
 namespace CesiumJsonReader {
@@ -27,8 +30,21 @@ public:
     this->_pDictionary2 = pDictionary;
   }
 
+  void reset(IJsonHandler* pParent, CesiumUtility::JsonObject* pDictionary) {
+    ObjectJsonHandler::reset(pParent);
+    this->_pDictionary3 = pDictionary;
+  }
+
   virtual IJsonHandler* readObjectKey(const std::string_view& str) override {
-    assert(this->_pDictionary1 || this->_pDictionary2);
+    assert(this->_pDictionary1 || this->_pDictionary2 || this->_pDictionary3);
+
+    if constexpr (std::is_same_v<T, CesiumUtility::JsonValue>) {
+      if (this->_pDictionary3) {
+        auto it = this->_pDictionary3->emplace(str).first;
+
+        return this->property(it->first.c_str(), this->_item, it->second);
+      }
+    }
 
     if (this->_pDictionary1) {
       auto it = this->_pDictionary1->emplace(str, T()).first;
@@ -44,6 +60,7 @@ public:
 private:
   std::unordered_map<std::string, T>* _pDictionary1 = nullptr;
   std::map<std::string, T>* _pDictionary2 = nullptr;
+  CesiumUtility::JsonObject* _pDictionary3 = nullptr;
   THandler _item;
 };
 } // namespace CesiumJsonReader
@@ -107,9 +107,21 @@ public:
   void
   setExtensionState(const std::string& extensionName, ExtensionState newState);
 
+  /**
+   * @brief Creates a handler for an extension of an object.
+   *
+   * @param extensionName The name of the extension.
+   * @param extendedObjectType The type of the object that is extended.
+   * @param readUnknownExtensions Whether an extension that has no
+   * statically-typed class registered and no state of its own is read into a
+   * {@link CesiumUtility::JsonValue}, as
+   * {@link JsonReaderOptions::readUnknownExtensions} specifies.
+   * @return The handler, or `nullptr` if the extension should be skipped.
+   */
   std::unique_ptr<IExtensionJsonHandler> createExtensionHandler(
       const std::string_view& extensionName,
-      const std::string& extendedObjectType) const;
+      const std::string& extendedObjectType,
+      bool readUnknownExtensions = true) const;
 
 private:
   using ExtensionHandlerFactory =
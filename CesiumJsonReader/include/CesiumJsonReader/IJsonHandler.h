@@ -1,5 +1,6 @@
 #pragma once
 
+#include "JsonReaderOptions.h"
 #include "Library.h"
 
 #include <cstdint>
@@ -27,5 +28,18 @@ public:
   virtual void reportWarning(
       const std::string& warning,
       std::vector<std::string>&& context = std::vector<std::string>()) = 0;
+
+  /**
+   * @brief Gets the options of the read that this handler is a part of.
+   *
+   * A {@link JsonHandler} asks its parent, in the same way that it reports
+   * warnings to its parent, so the handler at the root of a read determines
+   * the options of every handler below it. The default options are returned
+   * by a handler that does not override this.
+   */
+  virtual const JsonReaderOptions& getReaderOptions() const noexcept {
+    static const JsonReaderOptions defaultOptions;
+    return defaultOptions;
+  }
 };
 } // namespace CesiumJsonReader
@@ -10,12 +10,28 @@
 #include <string>
 #include <vector>
 
-namespace rapidjson {
-struct MemoryStream;
-}
-
 namespace CesiumJsonReader {
 
+/**
+ * @brief The parser with which {@link JsonReader} tokenizes JSON.
+ */
+enum class JsonReaderBackend {
+  /**
+   * @brief Indexes the structural characters of the whole document with SIMD
+   * instructions before parsing its values, in the style of simdjson, and
+   * passes strings to the handlers without copying them where possible.
+   *
+   * Documents of 4 GiB or more are read with {@link RapidJson} instead.
+   */
+  StructuralIndex,
+
+  /**
+   * @brief Reads the document one token at a time with the rapidjson SAX
+   * reader.
+   */
+  RapidJson
+};
+
 /**
  * @brief The result of {@link Reader::readJson}.
  */
@@ -46,11 +62,15 @@ public:
    *
    * @param data The buffer from which to read JSON.
    * @param handler The handler to receive the top-level JSON object.
+   * @param backend The parser with which to tokenize the JSON. Both report the
+   * same values to the handler.
    * @return The result of reading the JSON.
    */
   template <typename T>
-  static ReadJsonResult<typename T::ValueType>
-  readJson(const gsl::span<const std::byte>& data, T& handler) {
+  static ReadJsonResult<typename T::ValueType> readJson(
+      const gsl::span<const std::byte>& data,
+      T& handler,
+      JsonReaderBackend backend = JsonReaderBackend::StructuralIndex) {
     ReadJsonResult<typename T::ValueType> result;
 
     result.value.emplace();
@@ -61,6 +81,7 @@ public:
     JsonReader::internalRead(
         data,
         handler,
+        backend,
         finalHandler,
         result.errors,
         result.warnings);
@@ -79,16 +100,22 @@ private:
     virtual void reportWarning(
         const std::string& warning,
         std::vector<std::string>&& context) override;
-    void setInputStream(rapidjson::MemoryStream* pInputStream) noexcept;
+    virtual const JsonReaderOptions&
+    getReaderOptions() const noexcept override;
+    void setInputPosition(
+        const char* pInputBegin,
+        const char* const* ppInputCurrent) noexcept;
 
   private:
     std::vector<std::string>& _warnings;
-    rapidjson::MemoryStream* _pInputStream;
+    const char* _pInputBegin;
+    const char* const* _ppInputCurrent;
   };
 
   static void internalRead(
       const gsl::span<const std::byte>& data,
       IJsonHandler& handler,
+      JsonReaderBackend backend,
       FinalJsonHandler& finalHandler,
       std::vector<std::string>& errors,
       std::vector<std::string>& warnings);
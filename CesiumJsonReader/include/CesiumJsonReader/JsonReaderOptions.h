@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Library.h"
+
+namespace CesiumJsonReader {
+
+/**
+ * @brief Options for a single read of a JSON document.
+ *
+ * The handler at the root of a read provides these from
+ * {@link IJsonHandler::getReaderOptions}, and the handlers below it ask their
+ * parents for them, so reads that happen at the same time with the same
+ * {@link ExtensionReaderContext} may use different options.
+ */
+struct CESIUMJSONREADER_API JsonReaderOptions {
+  /**
+   * @brief Whether the `extras` of objects are read.
+   *
+   * When false, they are skipped without being parsed, and the
+   * {@link CesiumUtility::ExtensibleObject::extras} of every object are empty.
+   */
+  bool readExtras = true;
+
+  /**
+   * @brief Whether extensions that have no statically-typed class registered
+   * and no state of their own set with
+   * {@link ExtensionReaderContext::setExtensionState} are read.
+   *
+   * When true, they are read into a {@link CesiumUtility::JsonValue}. When
+   * false, they are skipped without being parsed.
+   */
+  bool readUnknownExtensions = true;
+};
+
+} // namespace CesiumJsonReader
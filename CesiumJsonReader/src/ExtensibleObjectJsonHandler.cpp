@@ -23,8 +23,12 @@ IJsonHandler* ExtensibleObjectJsonHandler::readObjectKeyExtensibleObject(
     ExtensibleObject& o) {
   using namespace std::string_literals;
 
-  if ("extras"s == str)
+  if ("extras"s == str) {
+    if (!this->getReaderOptions().readExtras) {
+      return this->ignoreAndContinue();
+    }
     return property("extras", this->_extras, o.extras);
+  }
 
   if ("extensions"s == str) {
     this->_extensions.reset(this, &o, objectType);
@@ -81,7 +81,8 @@ void ExtensionReaderContext::setExtensionState(
 std::unique_ptr<IExtensionJsonHandler>
 ExtensionReaderContext::createExtensionHandler(
     const std::string_view& extensionName,
-    const std::string& extendedObjectType) const {
+    const std::string& extendedObjectType,
+    bool readUnknownExtensions) const {
 
   std::string extensionNameString{extensionName};
 
@@ -95,14 +96,16 @@ ExtensionReaderContext::createExtensionHandler(
   }
 
   auto extensionNameIt = this->_extensions.find(extensionNameString);
-  if (extensionNameIt == this->_extensions.end()) {
-    return std::make_unique<AnyExtensionJsonHandler>();
+  if (extensionNameIt != this->_extensions.end()) {
+    auto objectTypeIt = extensionNameIt->second.find(extendedObjectType);
+    if (objectTypeIt != extensionNameIt->second.end()) {
+      return objectTypeIt->second(*this);
+    }
   }
 
-  auto objectTypeIt = extensionNameIt->second.find(extendedObjectType);
-  if (objectTypeIt == extensionNameIt->second.end()) {
-    return std::make_unique<AnyExtensionJsonHandler>();
+  if (stateIt == this->_extensionStates.end() && !readUnknownExtensions) {
+    return nullptr;
   }
 
-  return objectTypeIt->second(*this);
+  return std::make_unique<AnyExtensionJsonHandler>();
 }
@@ -19,8 +19,10 @@ void ExtensionsJsonHandler::reset(
 
 IJsonHandler*
 ExtensionsJsonHandler::readObjectKey(const std::string_view& str) {
-  this->_currentExtensionHandler =
-      this->_context.createExtensionHandler(str, this->_objectType);
+  this->_currentExtensionHandler = this->_context.createExtensionHandler(
+      str,
+      this->_objectType,
+      this->getReaderOptions().readUnknownExtensions);
   if (this->_currentExtensionHandler) {
     this->_currentExtensionHandler->reset(this, *this->_pObject, str);
     return this->_currentExtensionHandler.get();
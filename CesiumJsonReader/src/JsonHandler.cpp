@@ -80,4 +80,9 @@ void JsonHandler::reportWarning(
   this->parent()->reportWarning(warning, std::move(context));
 }
 
+const JsonReaderOptions& JsonHandler::getReaderOptions() const noexcept {
+  return this->_pParent ? this->_pParent->getReaderOptions()
+                        : IJsonHandler::getReaderOptions();
+}
+
 void JsonHandler::reset(IJsonHandler* pParent) { this->_pParent = pParent; }
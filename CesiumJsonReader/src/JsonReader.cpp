@@ -1,5 +1,7 @@
 #include "CesiumJsonReader/JsonReader.h"
 
+#include "StructuralJsonParser.h"
+
 #include <rapidjson/reader.h>
 
 #include <cassert>
@@ -91,11 +93,22 @@ std::string getMessageFromRapidJsonError(rapidjson::ParseErrorCode code) {
   }
 }
 
+std::string createErrorMessage(size_t offset, rapidjson::ParseErrorCode code) {
+  std::string s("JSON parsing error at byte offset ");
+  s += std::to_string(offset);
+  s += ": ";
+  s += getMessageFromRapidJsonError(code);
+  return s;
+}
+
 } // namespace
 
 JsonReader::FinalJsonHandler::FinalJsonHandler(
     std::vector<std::string>& warnings)
-    : JsonHandler(), _warnings(warnings), _pInputStream(nullptr) {
+    : JsonHandler(),
+      _warnings(warnings),
+      _pInputBegin(nullptr),
+      _ppInputCurrent(nullptr) {
   reset(this);
 }
 
@@ -109,31 +122,64 @@ void JsonReader::FinalJsonHandler::reportWarning(
   }
 
   fullWarning += "\n  From byte offset: ";
-  fullWarning += this->_pInputStream
-                     ? std::to_string(this->_pInputStream->Tell())
+  fullWarning += this->_ppInputCurrent
+                     ? std::to_string(
+                           *this->_ppInputCurrent - this->_pInputBegin)
                      : "unknown";
 
   this->_warnings.emplace_back(std::move(fullWarning));
 }
 
-void JsonReader::FinalJsonHandler::setInputStream(
-    rapidjson::MemoryStream* pInputStream) noexcept {
-  this->_pInputStream = pInputStream;
+const JsonReaderOptions&
+JsonReader::FinalJsonHandler::getReaderOptions() const noexcept {
+  // This handler is its own parent, so it ends the search for options with the
+  // defaults, unless the handler of the value overrides them.
+  return IJsonHandler::getReaderOptions();
+}
+
+void JsonReader::FinalJsonHandler::setInputPosition(
+    const char* pInputBegin,
+    const char* const* ppInputCurrent) noexcept {
+  this->_pInputBegin = pInputBegin;
+  this->_ppInputCurrent = ppInputCurrent;
 }
 
 /*static*/ void JsonReader::internalRead(
     const gsl::span<const std::byte>& data,
     IJsonHandler& handler,
+    JsonReaderBackend backend,
     FinalJsonHandler& finalHandler,
     std::vector<std::string>& errors,
     std::vector<std::string>& /* warnings */) {
 
+  if (backend == JsonReaderBackend::StructuralIndex) {
+    const std::string_view json(
+        reinterpret_cast<const char*>(data.data()),
+        data.size());
+
+    StructuralJsonParser parser;
+    finalHandler.setInputPosition(json.data(), parser.getCurrentPosition());
+
+    // The parser only declines documents that are too large to index, which
+    // rapidjson can still read.
+    const bool parsed = parser.parse(json, handler);
+    finalHandler.setInputPosition(nullptr, nullptr);
+    if (parsed) {
+      if (parser.hasParseError()) {
+        errors.emplace_back(createErrorMessage(
+            parser.getErrorOffset(),
+            parser.getParseErrorCode()));
+      }
+      return;
+    }
+  }
+
   rapidjson::Reader reader;
   rapidjson::MemoryStream inputStream(
       reinterpret_cast<const char*>(data.data()),
       data.size());
 
-  finalHandler.setInputStream(&inputStream);
+  finalHandler.setInputPosition(inputStream.begin_, &inputStream.src_);
 
   Dispatcher dispatcher{&handler};
 
@@ -147,11 +193,11 @@ void JsonReader::FinalJsonHandler::setInputStream(
         dispatcher);
   }
 
+  finalHandler.setInputPosition(nullptr, nullptr);
+
   if (reader.HasParseError()) {
-    std::string s("JSON parsing error at byte offset ");
-    s += std::to_string(reader.GetErrorOffset());
-    s += ": ";
-    s += getMessageFromRapidJsonError(reader.GetParseErrorCode());
-    errors.emplace_back(std::move(s));
+    errors.emplace_back(createErrorMessage(
+        reader.GetErrorOffset(),
+        reader.GetParseErrorCode()));
   }
 }
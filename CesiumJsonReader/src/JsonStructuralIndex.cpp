@@ -0,0 +1,265 @@
+#include "JsonStructuralIndex.h"
+
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CESIUM_JSON_READER_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+#include <intrin.h>
+#endif
+
+using namespace CesiumJsonReader;
+
+namespace {
+
+const size_t BLOCK_SIZE = 64;
+
+/**
+ * @brief The bit masks of the interesting characters of a 64-byte block,
+ * where bit n corresponds to the n-th byte of the block.
+ */
+struct BlockMasks {
+  uint64_t quote = 0;
+  uint64_t backslash = 0;
+  uint64_t whitespace = 0;
+  uint64_t op = 0;
+  uint64_t control = 0;
+};
+
+int countTrailingZeros(uint64_t value) noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+  unsigned long index;
+  _BitScanForward64(&index, value);
+  return static_cast<int>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+  return __builtin_ctzll(value);
+#else
+  int count = 0;
+  while ((value & 1) == 0) {
+    value >>= 1;
+    ++count;
+  }
+  return count;
+#endif
+}
+
+#ifdef CESIUM_JSON_READER_SSE2
+
+uint64_t toMask(__m128i matches, size_t shift) noexcept {
+  return static_cast<uint64_t>(
+             static_cast<uint32_t>(_mm_movemask_epi8(matches)))
+         << shift;
+}
+
+BlockMasks classifyBlock(const char* pBlock) noexcept {
+  const __m128i quote = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i space = _mm_set1_epi8(' ');
+  const __m128i tab = _mm_set1_epi8('\t');
+  const __m128i newline = _mm_set1_epi8('\n');
+  const __m128i carriageReturn = _mm_set1_epi8('\r');
+  const __m128i lowercaseBit = _mm_set1_epi8(0x20);
+  const __m128i openBrace = _mm_set1_epi8('{');
+  const __m128i closeBrace = _mm_set1_epi8('}');
+  const __m128i colon = _mm_set1_epi8(':');
+  const __m128i comma = _mm_set1_epi8(',');
+  const __m128i lastControl = _mm_set1_epi8(0x1F);
+
+  BlockMasks masks;
+  for (size_t i = 0; i < BLOCK_SIZE; i += 16) {
+    const __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pBlock + i));
+
+    masks.quote |= toMask(_mm_cmpeq_epi8(chunk, quote), i);
+    masks.backslash |= toMask(_mm_cmpeq_epi8(chunk, backslash), i);
+    masks.whitespace |= toMask(
+        _mm_or_si128(
+            _mm_or_si128(
+                _mm_cmpeq_epi8(chunk, space),
+                _mm_cmpeq_epi8(chunk, tab)),
+            _mm_or_si128(
+                _mm_cmpeq_epi8(chunk, newline),
+                _mm_cmpeq_epi8(chunk, carriageReturn))),
+        i);
+
+    // '[' and ']' differ from '{' and '}' only in the lowercase bit.
+    const __m128i lowered = _mm_or_si128(chunk, lowercaseBit);
+    masks.op |= toMask(
+        _mm_or_si128(
+            _mm_or_si128(
+                _mm_cmpeq_epi8(lowered, openBrace),
+                _mm_cmpeq_epi8(lowered, closeBrace)),
+            _mm_or_si128(
+                _mm_cmpeq_epi8(chunk, colon),
+                _mm_cmpeq_epi8(chunk, comma))),
+        i);
+
+    masks.control |= toMask(
+        _mm_cmpeq_epi8(_mm_max_epu8(chunk, lastControl), lastControl),
+        i);
+  }
+
+  return masks;
+}
+
+#else
+
+enum CharacterClass : uint8_t {
+  Quote = 1,
+  Backslash = 2,
+  Whitespace = 4,
+  Operator = 8,
+  Control = 16
+};
+
+struct CharacterClasses {
+  uint8_t classes[256];
+};
+
+constexpr CharacterClasses createCharacterClasses() noexcept {
+  CharacterClasses result{};
+  for (size_t c = 0; c < 0x20; ++c) {
+    result.classes[c] = Control;
+  }
+  result.classes[size_t('"')] = Quote;
+  result.classes[size_t('\\')] = Backslash;
+  result.classes[size_t(' ')] = Whitespace;
+  result.classes[size_t('\t')] |= Whitespace;
+  result.classes[size_t('\n')] |= Whitespace;
+  result.classes[size_t('\r')] |= Whitespace;
+  result.classes[size_t('{')] = Operator;
+  result.classes[size_t('}')] = Operator;
+  result.classes[size_t('[')] = Operator;
+  result.classes[size_t(']')] = Operator;
+  result.classes[size_t(':')] = Operator;
+  result.classes[size_t(',')] = Operator;
+  return result;
+}
+
+constexpr CharacterClasses characterClasses = createCharacterClasses();
+
+BlockMasks classifyBlock(const char* pBlock) noexcept {
+  BlockMasks masks;
+  for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+    const uint8_t classes =
+        characterClasses.classes[static_cast<uint8_t>(pBlock[i])];
+    const uint64_t bit = uint64_t(1) << i;
+    masks.quote |= (classes & Quote) ? bit : 0;
+    masks.backslash |= (classes & Backslash) ? bit : 0;
+    masks.whitespace |= (classes & Whitespace) ? bit : 0;
+    masks.op |= (classes & Operator) ? bit : 0;
+    masks.control |= (classes & Control) ? bit : 0;
+  }
+  return masks;
+}
+
+#endif
+
+/**
+ * @brief Finds the characters of a block that are escaped by a backslash.
+ *
+ * @param backslash The backslashes of the block.
+ * @param previousEscaped On input, 1 if the first character of the block is
+ * escaped by the last character of the previous block, otherwise 0. On output,
+ * the same for the next block.
+ */
+uint64_t findEscaped(uint64_t backslash, uint64_t& previousEscaped) noexcept {
+  uint64_t escaped = previousEscaped;
+  previousEscaped = 0;
+
+  // Backslashes are rare, so visit them one at a time. A backslash that is
+  // itself escaped does not escape the character after it.
+  backslash &= ~escaped;
+  while (backslash != 0) {
+    const uint64_t first = backslash & (0 - backslash);
+    const uint64_t next = first << 1;
+    if (next == 0) {
+      previousEscaped = 1;
+    }
+    escaped |= next;
+    backslash &= ~(first | next);
+  }
+
+  return escaped;
+}
+
+/**
+ * @brief Computes the exclusive-or of every bit with all of the bits below
+ * it, which turns a mask of quotes into a mask of the characters from each
+ * opening quote up to, but not including, its closing quote.
+ */
+uint64_t prefixXor(uint64_t bits) noexcept {
+  bits ^= bits << 1;
+  bits ^= bits << 2;
+  bits ^= bits << 4;
+  bits ^= bits << 8;
+  bits ^= bits << 16;
+  bits ^= bits << 32;
+  return bits;
+}
+
+} // namespace
+
+bool JsonStructuralIndex::build(const std::string_view& json) {
+  this->_positions.clear();
+  this->_firstControlCharacter = json.size();
+
+  if (json.size() >= std::numeric_limits<uint32_t>::max()) {
+    return false;
+  }
+
+  // JSON usually has a structural character every three or four bytes.
+  this->_positions.reserve(json.size() / 4 + 1);
+
+  uint64_t previousInString = 0;
+  uint64_t previousEscaped = 0;
+  uint64_t previousScalar = 0;
+  char lastBlock[BLOCK_SIZE];
+
+  for (size_t offset = 0; offset < json.size(); offset += BLOCK_SIZE) {
+    const char* pBlock = json.data() + offset;
+    const size_t remaining = json.size() - offset;
+    if (remaining < BLOCK_SIZE) {
+      // Pad the end of the document with whitespace, which is never
+      // structural.
+      std::memset(lastBlock, ' ', BLOCK_SIZE);
+      std::memcpy(lastBlock, pBlock, remaining);
+      pBlock = lastBlock;
+    }
+
+    const BlockMasks masks = classifyBlock(pBlock);
+
+    const uint64_t quotes =
+        masks.quote & ~findEscaped(masks.backslash, previousEscaped);
+    const uint64_t inString = prefixXor(quotes) ^ previousInString;
+    previousInString = 0 - (inString >> 63);
+
+    const uint64_t control = masks.control & inString;
+    if (control != 0 && this->_firstControlCharacter == json.size()) {
+      this->_firstControlCharacter =
+          offset + static_cast<size_t>(countTrailingZeros(control));
+    }
+
+    // Numbers, true, false, and null are runs of characters outside of
+    // strings that are not whitespace, operators, or quotes. Only the first
+    // character of each run is structural.
+    const uint64_t scalar =
+        ~(masks.whitespace | masks.op | masks.quote | inString);
+    const uint64_t scalarStart = scalar & ~((scalar << 1) | previousScalar);
+    previousScalar = scalar >> 63;
+
+    uint64_t structurals = (masks.op & ~inString) | quotes | scalarStart;
+    while (structurals != 0) {
+      this->_positions.push_back(static_cast<uint32_t>(
+          offset + static_cast<size_t>(countTrailingZeros(structurals))));
+      structurals &= structurals - 1;
+    }
+  }
+
+  return true;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace CesiumJsonReader {
+
+/**
+ * @brief The positions of the structural characters of a JSON document.
+ *
+ * This is the first stage of a two-stage parse in the style of simdjson. The
+ * document is classified 64 bytes at a time into bit masks of quotes,
+ * backslashes, whitespace, and operators, using SIMD instructions where they
+ * are available. The extent of every string is found from these masks with a
+ * handful of bitwise operations rather than a branch per character. Then the
+ * offsets of the brackets, braces, colons, and commas outside of strings, of
+ * both quotes of every string, and of the first character of every other value
+ * are recorded in document order, so that the second stage can step directly
+ * from one token to the next.
+ */
+class JsonStructuralIndex {
+public:
+  /**
+   * @brief Indexes a JSON document.
+   *
+   * @param json The document.
+   * @return `false` if the document is too large to be indexed, which is 4 GiB
+   * or more.
+   */
+  bool build(const std::string_view& json);
+
+  /**
+   * @brief Gets the byte offsets of the structural characters, in document
+   * order.
+   */
+  const std::vector<uint32_t>& getPositions() const noexcept {
+    return this->_positions;
+  }
+
+  /**
+   * @brief Gets the byte offset of the first control character that appears
+   * unescaped inside a string, which is not allowed in JSON.
+   *
+   * @return The offset, or the size of the document if there is no such
+   * character.
+   */
+  size_t getFirstControlCharacter() const noexcept {
+    return this->_firstControlCharacter;
+  }
+
+private:
+  std::vector<uint32_t> _positions;
+  size_t _firstControlCharacter = 0;
+};
+
+} // namespace CesiumJsonReader
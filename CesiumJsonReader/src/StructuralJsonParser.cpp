@@ -0,0 +1,601 @@
+#include "StructuralJsonParser.h"
+
+#include "CesiumJsonReader/IJsonHandler.h"
+
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <locale>
+#include <sstream>
+#include <vector>
+
+using namespace CesiumJsonReader;
+
+namespace {
+
+enum class State {
+  Value,
+  ObjectFirstKey,
+  ObjectKey,
+  ObjectColon,
+  ObjectNext,
+  ArrayFirst,
+  ArrayNext,
+  Done
+};
+
+// The powers of ten that are exactly representable as doubles.
+const double exactPowersOfTen[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+
+const int64_t MAXIMUM_EXACT_POWER_OF_TEN = 22;
+const uint64_t MAXIMUM_EXACT_SIGNIFICAND = uint64_t(1) << 53;
+
+bool isDigit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+bool readHex4(const char* p, const char* pEnd, uint32_t& value) noexcept {
+  if (pEnd - p < 4) {
+    return false;
+  }
+
+  value = 0;
+  for (int i = 0; i < 4; ++i) {
+    const char c = p[i];
+    uint32_t digit;
+    if (c >= '0' && c <= '9') {
+      digit = static_cast<uint32_t>(c - '0');
+    } else if (c >= 'a' && c <= 'f') {
+      digit = static_cast<uint32_t>(c - 'a' + 10);
+    } else if (c >= 'A' && c <= 'F') {
+      digit = static_cast<uint32_t>(c - 'A' + 10);
+    } else {
+      return false;
+    }
+    value = (value << 4) | digit;
+  }
+
+  return true;
+}
+
+void appendUtf8(std::string& s, uint32_t codepoint) {
+  if (codepoint < 0x80) {
+    s += static_cast<char>(codepoint);
+  } else if (codepoint < 0x800) {
+    s += static_cast<char>(0xC0 | (codepoint >> 6));
+    s += static_cast<char>(0x80 | (codepoint & 0x3F));
+  } else if (codepoint < 0x10000) {
+    s += static_cast<char>(0xE0 | (codepoint >> 12));
+    s += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+    s += static_cast<char>(0x80 | (codepoint & 0x3F));
+  } else {
+    s += static_cast<char>(0xF0 | (codepoint >> 18));
+    s += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F));
+    s += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F));
+    s += static_cast<char>(0x80 | (codepoint & 0x3F));
+  }
+}
+
+/**
+ * @brief Converts a JSON number to the nearest double.
+ *
+ * @return `false` if the number is too large or too small to be represented.
+ */
+bool parseDouble(const char* pStart, const char* pEnd, double& value) {
+#if defined(__cpp_lib_to_chars)
+  const std::from_chars_result result = std::from_chars(pStart, pEnd, value);
+  if (result.ec == std::errc()) {
+    return true;
+  }
+
+  // Some implementations report subnormal numbers as out of range, so try
+  // again below.
+#endif
+
+  std::istringstream stream(std::string(pStart, pEnd));
+  stream.imbue(std::locale::classic());
+  stream >> value;
+  return !stream.fail();
+}
+
+} // namespace
+
+bool StructuralJsonParser::parse(
+    const std::string_view& document,
+    IJsonHandler& handler) {
+  // Like rapidjson, treat a NUL character as the end of the input, so that the
+  // NUL padding after the JSON in some GLB chunks and tile feature tables is
+  // accepted.
+  const std::string_view json = document.substr(0, document.find('\0'));
+
+  this->_json = json;
+  this->_pHandler = &handler;
+  this->_pCurrent = json.data();
+  this->_errorCode = rapidjson::kParseErrorNone;
+  this->_errorOffset = 0;
+
+  if (!this->_index.build(json)) {
+    return false;
+  }
+
+  const std::vector<uint32_t>& positions = this->_index.getPositions();
+
+  // '{' or '[' for each object or array that is open.
+  std::vector<char> containers;
+  const auto afterValue = [&containers]() {
+    if (containers.empty()) {
+      return State::Done;
+    }
+    return containers.back() == '{' ? State::ObjectNext : State::ArrayNext;
+  };
+
+  State state = State::Value;
+  size_t i = 0;
+  while (i < positions.size()) {
+    const char* p = json.data() + positions[i];
+    this->_pCurrent = p;
+
+    switch (state) {
+    case State::Value:
+      if (*p == '{') {
+        if (!this->update(this->_pHandler->readObjectStart())) {
+          return true;
+        }
+        containers.push_back('{');
+        state = State::ObjectFirstKey;
+        ++i;
+      } else if (*p == '[') {
+        if (!this->update(this->_pHandler->readArrayStart())) {
+          return true;
+        }
+        containers.push_back('[');
+        state = State::ArrayFirst;
+        ++i;
+      } else if (*p == '"') {
+        if (!this->parseString(i, false)) {
+          return true;
+        }
+        state = afterValue();
+        i += 2;
+      } else {
+        if (!this->parseScalar(i)) {
+          return true;
+        }
+        state = afterValue();
+        ++i;
+      }
+      break;
+    case State::ObjectFirstKey:
+      if (*p == '}') {
+        if (!this->update(this->_pHandler->readObjectEnd())) {
+          return true;
+        }
+        containers.pop_back();
+        state = afterValue();
+        ++i;
+        break;
+      }
+      [[fallthrough]];
+    case State::ObjectKey:
+      if (*p != '"') {
+        this->setError(rapidjson::kParseErrorObjectMissName, p);
+        return true;
+      }
+      if (!this->parseString(i, true)) {
+        return true;
+      }
+      state = State::ObjectColon;
+      i += 2;
+      break;
+    case State::ObjectColon:
+      if (*p != ':') {
+        this->setError(rapidjson::kParseErrorObjectMissColon, p);
+        return true;
+      }
+      state = State::Value;
+      ++i;
+      break;
+    case State::ObjectNext:
+      if (*p == ',') {
+        state = State::ObjectKey;
+      } else if (*p == '}') {
+        if (!this->update(this->_pHandler->readObjectEnd())) {
+          return true;
+        }
+        containers.pop_back();
+        state = afterValue();
+      } else {
+        this->setError(rapidjson::kParseErrorObjectMissCommaOrCurlyBracket, p);
+        return true;
+      }
+      ++i;
+      break;
+    case State::ArrayFirst:
+      if (*p == ']') {
+        if (!this->update(this->_pHandler->readArrayEnd())) {
+          return true;
+        }
+        containers.pop_back();
+        state = afterValue();
+        ++i;
+      } else {
+        // Parse the same character again as the first element.
+        state = State::Value;
+      }
+      break;
+    case State::ArrayNext:
+      if (*p == ',') {
+        state = State::Value;
+      } else if (*p == ']') {
+        if (!this->update(this->_pHandler->readArrayEnd())) {
+          return true;
+        }
+        containers.pop_back();
+        state = afterValue();
+      } else {
+        this->setError(rapidjson::kParseErrorArrayMissCommaOrSquareBracket, p);
+        return true;
+      }
+      ++i;
+      break;
+    case State::Done:
+      this->setError(rapidjson::kParseErrorDocumentRootNotSingular, p);
+      return true;
+    }
+  }
+
+  const char* pEnd = json.data() + json.size();
+  this->_pCurrent = pEnd;
+
+  switch (state) {
+  case State::Done:
+    break;
+  case State::Value:
+    this->setError(
+        positions.empty() ? rapidjson::kParseErrorDocumentEmpty
+                          : rapidjson::kParseErrorValueInvalid,
+        pEnd);
+    break;
+  case State::ArrayFirst:
+    this->setError(rapidjson::kParseErrorValueInvalid, pEnd);
+    break;
+  case State::ObjectFirstKey:
+  case State::ObjectKey:
+    this->setError(rapidjson::kParseErrorObjectMissName, pEnd);
+    break;
+  case State::ObjectColon:
+    this->setError(rapidjson::kParseErrorObjectMissColon, pEnd);
+    break;
+  case State::ObjectNext:
+    this->setError(rapidjson::kParseErrorObjectMissCommaOrCurlyBracket, pEnd);
+    break;
+  case State::ArrayNext:
+    this->setError(rapidjson::kParseErrorArrayMissCommaOrSquareBracket, pEnd);
+    break;
+  }
+
+  return true;
+}
+
+bool StructuralJsonParser::parseString(size_t index, bool isKey) {
+  const std::vector<uint32_t>& positions = this->_index.getPositions();
+  const bool isClosed = index + 1 < positions.size();
+  const size_t open = positions[index];
+  const size_t close = isClosed ? positions[index + 1] : this->_json.size();
+
+  const size_t control = this->_index.getFirstControlCharacter();
+  if (control > open && control < close) {
+    return this->setError(
+        rapidjson::kParseErrorStringInvalidEncoding,
+        this->_json.data() + control);
+  }
+
+  const char* pEnd = this->_json.data() + close;
+  if (!isClosed) {
+    return this->setError(rapidjson::kParseErrorStringMissQuotationMark, pEnd);
+  }
+
+  const char* pStart = this->_json.data() + open + 1;
+  const size_t length = close - open - 1;
+
+  std::string_view value;
+  if (std::memchr(pStart, '\\', length) == nullptr) {
+    value = std::string_view(pStart, length);
+  } else if (this->unescape(pStart, pEnd)) {
+    value = this->_unescaped;
+  } else {
+    return false;
+  }
+
+  return this->update(
+      isKey ? this->_pHandler->readObjectKey(value)
+            : this->_pHandler->readString(value));
+}
+
+bool StructuralJsonParser::parseScalar(size_t index) {
+  const char* p = this->_json.data() + this->_index.getPositions()[index];
+  switch (*p) {
+  case 't':
+    return this->parseLiteral(p, "true") &&
+           this->update(this->_pHandler->readBool(true));
+  case 'f':
+    return this->parseLiteral(p, "false") &&
+           this->update(this->_pHandler->readBool(false));
+  case 'n':
+    return this->parseLiteral(p, "null") &&
+           this->update(this->_pHandler->readNull());
+  default:
+    if (*p == '-' || isDigit(*p)) {
+      return this->parseNumber(p);
+    }
+    return this->setError(rapidjson::kParseErrorValueInvalid, p);
+  }
+}
+
+bool StructuralJsonParser::parseNumber(const char* pStart) {
+  const char* pEnd = this->_json.data() + this->_json.size();
+  const char* p = pStart;
+
+  const bool negative = *p == '-';
+  if (negative) {
+    ++p;
+  }
+  if (p == pEnd || !isDigit(*p)) {
+    return this->setError(rapidjson::kParseErrorValueInvalid, pStart);
+  }
+
+  // The digits of the number without its decimal point, if they fit.
+  uint64_t significand = 0;
+  bool significandOverflow = false;
+  const auto addDigit = [&significand, &significandOverflow](char c) {
+    const uint64_t digit = static_cast<uint64_t>(c - '0');
+    if (significandOverflow ||
+        significand > (std::numeric_limits<uint64_t>::max() - digit) / 10) {
+      significandOverflow = true;
+    } else {
+      significand = significand * 10 + digit;
+    }
+  };
+
+  int64_t integerDigits = 0;
+  if (*p == '0') {
+    ++p;
+  } else {
+    while (p != pEnd && isDigit(*p)) {
+      addDigit(*p);
+      ++integerDigits;
+      ++p;
+    }
+  }
+
+  bool isInteger = true;
+  int64_t fractionDigits = 0;
+  int64_t leadingFractionZeros = 0;
+  if (p != pEnd && *p == '.') {
+    isInteger = false;
+    ++p;
+    if (p == pEnd || !isDigit(*p)) {
+      return this->setError(rapidjson::kParseErrorNumberMissFraction, p);
+    }
+    while (p != pEnd && isDigit(*p)) {
+      if (significand == 0 && *p == '0') {
+        ++leadingFractionZeros;
+      }
+      addDigit(*p);
+      ++fractionDigits;
+      ++p;
+    }
+  }
+
+  int64_t exponent = 0;
+  if (p != pEnd && (*p == 'e' || *p == 'E')) {
+    isInteger = false;
+    ++p;
+    bool negativeExponent = false;
+    if (p != pEnd && (*p == '+' || *p == '-')) {
+      negativeExponent = *p == '-';
+      ++p;
+    }
+    if (p == pEnd || !isDigit(*p)) {
+      return this->setError(rapidjson::kParseErrorNumberMissExponent, p);
+    }
+    while (p != pEnd && isDigit(*p)) {
+      // Any larger exponent is out of range anyway.
+      if (exponent < 100000) {
+        exponent = exponent * 10 + (*p - '0');
+      }
+      ++p;
+    }
+    if (negativeExponent) {
+      exponent = -exponent;
+    }
+  }
+
+  if (!this->isScalarEnd(p)) {
+    return this->setError(rapidjson::kParseErrorValueInvalid, p);
+  }
+
+  if (isInteger && !significandOverflow) {
+    if (!negative) {
+      if (significand <= std::numeric_limits<uint32_t>::max()) {
+        return this->update(this->_pHandler->readUint32(
+            static_cast<uint32_t>(significand)));
+      }
+      return this->update(this->_pHandler->readUint64(significand));
+    }
+
+    if (significand <= uint64_t(1) << 31) {
+      return this->update(this->_pHandler->readInt32(
+          static_cast<int32_t>(-static_cast<int64_t>(significand))));
+    }
+    if (significand <= uint64_t(1) << 63) {
+      return this->update(this->_pHandler->readInt64(
+          significand == uint64_t(1) << 63
+              ? std::numeric_limits<int64_t>::min()
+              : -static_cast<int64_t>(significand)));
+    }
+  }
+
+  // A significand and a power of ten that are both exact as doubles give a
+  // correctly-rounded result with a single multiplication or division.
+  double value;
+  const int64_t exponent10 = exponent - fractionDigits;
+  if (!significandOverflow && significand <= MAXIMUM_EXACT_SIGNIFICAND &&
+      exponent10 >= -MAXIMUM_EXACT_POWER_OF_TEN &&
+      exponent10 <= MAXIMUM_EXACT_POWER_OF_TEN) {
+    value = static_cast<double>(significand);
+    if (exponent10 < 0) {
+      value /= exactPowersOfTen[static_cast<size_t>(-exponent10)];
+    } else {
+      value *= exactPowersOfTen[static_cast<size_t>(exponent10)];
+    }
+    if (negative) {
+      value = -value;
+    }
+  } else if (!parseDouble(pStart, p, value)) {
+    // The number is out of range. Numbers that are too small become zero.
+    const int64_t magnitude =
+        (integerDigits > 0 ? integerDigits : -leadingFractionZeros) + exponent;
+    if (magnitude > 0) {
+      return this->setError(rapidjson::kParseErrorNumberTooBig, pStart);
+    }
+    value = negative ? -0.0 : 0.0;
+  }
+
+  return this->update(this->_pHandler->readDouble(value));
+}
+
+bool StructuralJsonParser::parseLiteral(
+    const char* pStart,
+    const std::string_view& literal) {
+  const char* pEnd = this->_json.data() + this->_json.size();
+  if (static_cast<size_t>(pEnd - pStart) < literal.size() ||
+      std::memcmp(pStart, literal.data(), literal.size()) != 0 ||
+      !this->isScalarEnd(pStart + literal.size())) {
+    return this->setError(rapidjson::kParseErrorValueInvalid, pStart);
+  }
+  return true;
+}
+
+bool StructuralJsonParser::unescape(const char* p, const char* pEnd) {
+  std::string& result = this->_unescaped;
+  result.clear();
+
+  while (p < pEnd) {
+    const char* pBackslash = static_cast<const char*>(
+        std::memchr(p, '\\', static_cast<size_t>(pEnd - p)));
+    if (pBackslash == nullptr) {
+      result.append(p, pEnd);
+      break;
+    }
+
+    result.append(p, pBackslash);
+
+    // A backslash can't escape the closing quote, so there is always another
+    // character in the string after it.
+    p = pBackslash + 1;
+    switch (*p) {
+    case '"':
+    case '\\':
+    case '/':
+      result += *p;
+      break;
+    case 'b':
+      result += '\b';
+      break;
+    case 'f':
+      result += '\f';
+      break;
+    case 'n':
+      result += '\n';
+      break;
+    case 'r':
+      result += '\r';
+      break;
+    case 't':
+      result += '\t';
+      break;
+    case 'u': {
+      uint32_t codepoint;
+      if (!readHex4(p + 1, pEnd, codepoint)) {
+        return this->setError(
+            rapidjson::kParseErrorStringUnicodeEscapeInvalidHex,
+            p + 1);
+      }
+      p += 4;
+
+      if (codepoint >= 0xD800 && codepoint <= 0xDBFF) {
+        uint32_t low;
+        if (pEnd - p < 3 || p[1] != '\\' || p[2] != 'u') {
+          return this->setError(
+              rapidjson::kParseErrorStringUnicodeSurrogateInvalid,
+              p + 1);
+        }
+        if (!readHex4(p + 3, pEnd, low)) {
+          return this->setError(
+              rapidjson::kParseErrorStringUnicodeEscapeInvalidHex,
+              p + 3);
+        }
+        if (low < 0xDC00 || low > 0xDFFF) {
+          return this->setError(
+              rapidjson::kParseErrorStringUnicodeSurrogateInvalid,
+              p + 3);
+        }
+        codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+        p += 6;
+      }
+
+      appendUtf8(result, codepoint);
+      break;
+    }
+    default:
+      return this->setError(
+          rapidjson::kParseErrorStringEscapeInvalid,
+          pBackslash);
+    }
+
+    ++p;
+  }
+
+  return true;
+}
+
+bool StructuralJsonParser::isScalarEnd(const char* p) const noexcept {
+  if (p == this->_json.data() + this->_json.size()) {
+    return true;
+  }
+
+  switch (*p) {
+  case ' ':
+  case '\t':
+  case '\n':
+  case '\r':
+  case ',':
+  case ':':
+  case ']':
+  case '}':
+  case '[':
+  case '{':
+  case '"':
+    return true;
+  default:
+    return false;
+  }
+}
+
+bool StructuralJsonParser::update(IJsonHandler* pNext) noexcept {
+  if (pNext == nullptr) {
+    return this->setError(rapidjson::kParseErrorTermination, this->_pCurrent);
+  }
+
+  this->_pHandler = pNext;
+  return true;
+}
+
+bool StructuralJsonParser::setError(
+    rapidjson::ParseErrorCode code,
+    const char* p) noexcept {
+  this->_errorCode = code;
+  this->_errorOffset = static_cast<size_t>(p - this->_json.data());
+  return false;
+}
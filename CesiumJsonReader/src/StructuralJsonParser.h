@@ -0,0 +1,91 @@
+#pragma once
+
+#include "JsonStructuralIndex.h"
+
+#include <rapidjson/error/error.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace CesiumJsonReader {
+
+class IJsonHandler;
+
+/**
+ * @brief Parses JSON from a {@link JsonStructuralIndex}, streaming its values
+ * into an {@link IJsonHandler}.
+ *
+ * This is the second stage of the parse. It steps from one structural
+ * character to the next, so it never looks at whitespace, and it passes
+ * strings without escape sequences to the handler directly from the input
+ * rather than copying them. It reports the same values as the rapidjson reader
+ * with `kParseFullPrecisionFlag`: integers are reported as the smallest of
+ * `uint32_t`, `int32_t`, `uint64_t`, and `int64_t` that holds them and other
+ * numbers as correctly-rounded doubles. Errors are
+ * reported with rapidjson's error codes, but a malformed document may be
+ * reported with a different code or offset than rapidjson would give.
+ */
+class StructuralJsonParser {
+public:
+  /**
+   * @brief Parses a JSON document.
+   *
+   * @param document The document. Like rapidjson, the parser treats a NUL
+   * character as the end of the input, so anything after one is ignored.
+   * @param handler The handler to receive the values of the document.
+   * @return `false` if the document could not be indexed, in which case the
+   * handler has not been called. Otherwise `true`, even if there was a parse
+   * error.
+   */
+  bool parse(const std::string_view& document, IJsonHandler& handler);
+
+  /**
+   * @brief Gets a pointer to the position of the token being parsed, which
+   * is updated as parsing proceeds.
+   */
+  const char* const* getCurrentPosition() const noexcept {
+    return &this->_pCurrent;
+  }
+
+  /**
+   * @brief Determines if the last call to {@link parse} found an error.
+   */
+  bool hasParseError() const noexcept {
+    return this->_errorCode != rapidjson::kParseErrorNone;
+  }
+
+  /**
+   * @brief Gets the error found by the last call to {@link parse}.
+   */
+  rapidjson::ParseErrorCode getParseErrorCode() const noexcept {
+    return this->_errorCode;
+  }
+
+  /**
+   * @brief Gets the byte offset of the error found by the last call to
+   * {@link parse}.
+   */
+  size_t getErrorOffset() const noexcept { return this->_errorOffset; }
+
+private:
+  bool parseString(size_t index, bool isKey);
+  bool parseScalar(size_t index);
+  bool parseNumber(const char* pStart);
+  bool parseLiteral(const char* pStart, const std::string_view& literal);
+  bool unescape(const char* pStart, const char* pEnd);
+  bool isScalarEnd(const char* p) const noexcept;
+  bool update(IJsonHandler* pNext) noexcept;
+  bool setError(rapidjson::ParseErrorCode code, const char* p) noexcept;
+
+  JsonStructuralIndex _index;
+  std::string_view _json;
+  IJsonHandler* _pHandler = nullptr;
+  const char* _pCurrent = nullptr;
+  std::string _unescaped;
+  rapidjson::ParseErrorCode _errorCode = rapidjson::kParseErrorNone;
+  size_t _errorOffset = 0;
+};
+
+} // namespace CesiumJsonReader
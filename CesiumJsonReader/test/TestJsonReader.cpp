@@ -0,0 +1,432 @@
+#include "CesiumJsonReader/JsonReader.h"
+#include "JsonStructuralIndex.h"
+
+#include <catch2/catch.hpp>
+#include <gsl/span>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace CesiumJsonReader;
+
+namespace {
+
+/**
+ * @brief Records every value it reads as a string, so the values reported by
+ * different backends can be compared exactly.
+ */
+class TokenJsonHandler : public IJsonHandler {
+public:
+  using ValueType = std::vector<std::string>;
+
+  void reset(IJsonHandler* pParent, std::vector<std::string>* pTokens) {
+    this->_pParent = pParent;
+    this->_pTokens = pTokens;
+    this->_depth = 0;
+  }
+
+  IJsonHandler* readNull() override { return this->record("null"); }
+  IJsonHandler* readBool(bool b) override {
+    return this->record(b ? "true" : "false");
+  }
+  IJsonHandler* readInt32(int32_t i) override {
+    return this->record("int32 " + std::to_string(i));
+  }
+  IJsonHandler* readUint32(uint32_t i) override {
+    return this->record("uint32 " + std::to_string(i));
+  }
+  IJsonHandler* readInt64(int64_t i) override {
+    return this->record("int64 " + std::to_string(i));
+  }
+  IJsonHandler* readUint64(uint64_t i) override {
+    return this->record("uint64 " + std::to_string(i));
+  }
+  IJsonHandler* readDouble(double d) override {
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "double %a", d);
+    return this->record(buffer);
+  }
+  IJsonHandler* readString(const std::string_view& str) override {
+    return this->record("string " + std::string(str));
+  }
+  IJsonHandler* readObjectStart() override {
+    ++this->_depth;
+    return this->record("{");
+  }
+  IJsonHandler* readObjectKey(const std::string_view& str) override {
+    return this->record("key " + std::string(str));
+  }
+  IJsonHandler* readObjectEnd() override {
+    --this->_depth;
+    return this->record("}");
+  }
+  IJsonHandler* readArrayStart() override {
+    ++this->_depth;
+    return this->record("[");
+  }
+  IJsonHandler* readArrayEnd() override {
+    --this->_depth;
+    return this->record("]");
+  }
+
+  void reportWarning(
+      const std::string& warning,
+      std::vector<std::string>&& context) override {
+    this->_pParent->reportWarning(warning, std::move(context));
+  }
+
+private:
+  IJsonHandler* record(std::string&& token) {
+    this->_pTokens->emplace_back(std::move(token));
+    return this->_depth == 0 ? this->_pParent : this;
+  }
+
+  IJsonHandler* _pParent = nullptr;
+  std::vector<std::string>* _pTokens = nullptr;
+  int _depth = 0;
+};
+
+/**
+ * @brief Counts the values it reads, so that a benchmark measures little
+ * more than the parser.
+ */
+class CountingJsonHandler : public IJsonHandler {
+public:
+  using ValueType = size_t;
+
+  void reset(IJsonHandler* pParent, size_t* pCount) {
+    this->_pParent = pParent;
+    this->_pCount = pCount;
+    this->_depth = 0;
+  }
+
+  IJsonHandler* readNull() override { return this->count(); }
+  IJsonHandler* readBool(bool /*b*/) override { return this->count(); }
+  IJsonHandler* readInt32(int32_t /*i*/) override { return this->count(); }
+  IJsonHandler* readUint32(uint32_t /*i*/) override { return this->count(); }
+  IJsonHandler* readInt64(int64_t /*i*/) override { return this->count(); }
+  IJsonHandler* readUint64(uint64_t /*i*/) override { return this->count(); }
+  IJsonHandler* readDouble(double /*d*/) override { return this->count(); }
+  IJsonHandler* readString(const std::string_view& /*str*/) override {
+    return this->count();
+  }
+  IJsonHandler* readObjectStart() override {
+    ++this->_depth;
+    return this->count();
+  }
+  IJsonHandler* readObjectKey(const std::string_view& /*str*/) override {
+    return this->count();
+  }
+  IJsonHandler* readObjectEnd() override {
+    --this->_depth;
+    return this->count();
+  }
+  IJsonHandler* readArrayStart() override {
+    ++this->_depth;
+    return this->count();
+  }
+  IJsonHandler* readArrayEnd() override {
+    --this->_depth;
+    return this->count();
+  }
+
+  void reportWarning(
+      const std::string& warning,
+      std::vector<std::string>&& context) override {
+    this->_pParent->reportWarning(warning, std::move(context));
+  }
+
+private:
+  IJsonHandler* count() {
+    ++*this->_pCount;
+    return this->_depth == 0 ? this->_pParent : this;
+  }
+
+  IJsonHandler* _pParent = nullptr;
+  size_t* _pCount = nullptr;
+  int _depth = 0;
+};
+
+gsl::span<const std::byte> asBytes(const std::string& s) {
+  return gsl::span<const std::byte>(
+      reinterpret_cast<const std::byte*>(s.data()),
+      s.size());
+}
+
+ReadJsonResult<std::vector<std::string>>
+readTokens(const std::string& json, JsonReaderBackend backend) {
+  TokenJsonHandler handler;
+  return JsonReader::readJson(asBytes(json), handler, backend);
+}
+
+std::vector<std::string> readTokensWithBothBackends(const std::string& json) {
+  ReadJsonResult<std::vector<std::string>> structural =
+      readTokens(json, JsonReaderBackend::StructuralIndex);
+  ReadJsonResult<std::vector<std::string>> rapidJson =
+      readTokens(json, JsonReaderBackend::RapidJson);
+
+  CAPTURE(json);
+  CHECK(structural.errors.empty());
+  CHECK(rapidJson.errors.empty());
+  REQUIRE(structural.value);
+  REQUIRE(rapidJson.value);
+  CHECK(*structural.value == *rapidJson.value);
+  return *structural.value;
+}
+
+std::string readError(const std::string& json) {
+  ReadJsonResult<std::vector<std::string>> structural =
+      readTokens(json, JsonReaderBackend::StructuralIndex);
+  ReadJsonResult<std::vector<std::string>> rapidJson =
+      readTokens(json, JsonReaderBackend::RapidJson);
+
+  CAPTURE(json);
+  CHECK(!structural.value);
+  CHECK(!rapidJson.value);
+  REQUIRE(structural.errors.size() == 1);
+  CHECK(rapidJson.errors.size() == 1);
+  return structural.errors[0];
+}
+
+std::vector<std::byte> readFile(const std::filesystem::path& fileName) {
+  std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+  REQUIRE(file);
+
+  std::streamsize size = file.tellg();
+  file.seekg(0, std::ios::beg);
+
+  std::vector<std::byte> buffer(static_cast<size_t>(size));
+  file.read(reinterpret_cast<char*>(buffer.data()), size);
+
+  return buffer;
+}
+
+} // namespace
+
+TEST_CASE("JsonStructuralIndex finds the structural characters") {
+  const std::string json = R"({"a\"{": [10, true], "b":null})";
+
+  JsonStructuralIndex index;
+  REQUIRE(index.build(json));
+
+  std::string structurals;
+  for (uint32_t position : index.getPositions()) {
+    structurals += json[position];
+  }
+  CHECK(structurals == R"({"":[1,t],"":n})");
+  CHECK(index.getFirstControlCharacter() == json.size());
+
+  const std::string withControl = "[\"a\tb\", \"c\"]";
+  REQUIRE(index.build(withControl));
+  CHECK(index.getFirstControlCharacter() == 3);
+}
+
+TEST_CASE("JsonReader backends read the same values") {
+  SECTION("objects and arrays") {
+    const std::vector<std::string> tokens = readTokensWithBothBackends(
+        R"( { "a" : [ [], {}, [null, true, false] ], "b": {"c": {}} } )");
+    const std::vector<std::string> expected{
+        "{",
+        "key a",
+        "[",
+        "[",
+        "]",
+        "{",
+        "}",
+        "[",
+        "null",
+        "true",
+        "false",
+        "]",
+        "]",
+        "key b",
+        "{",
+        "key c",
+        "{",
+        "}",
+        "}",
+        "}",
+    };
+    CHECK(tokens == expected);
+  }
+
+  SECTION("scalars at the root") {
+    CHECK(
+        readTokensWithBothBackends("null") ==
+        std::vector<std::string>{"null"});
+    CHECK(
+        readTokensWithBothBackends(" \"text\"\n") ==
+        std::vector<std::string>{"string text"});
+    CHECK(
+        readTokensWithBothBackends("42") ==
+        std::vector<std::string>{"uint32 42"});
+  }
+
+  SECTION("documents padded with NUL characters") {
+    const std::vector<std::string> expected{"{", "key a", "uint32 1", "}"};
+    CHECK(
+        readTokensWithBothBackends(R"({"a": 1})" + std::string(3, '\0')) ==
+        expected);
+    CHECK(
+        readTokensWithBothBackends(
+            R"({"a": 1} )" + std::string(100, '\0') + "[2]") == expected);
+    CHECK(
+        readTokensWithBothBackends("42" + std::string(1, '\0')) ==
+        std::vector<std::string>{"uint32 42"});
+  }
+
+  SECTION("integers of every size") {
+    const std::vector<std::string> tokens = readTokensWithBothBackends(
+        "[0, -0, -1, 4294967295, 4294967296, -2147483648, -2147483649, "
+        "18446744073709551615, -9223372036854775808, 18446744073709551616, "
+        "-9223372036854775809]");
+    REQUIRE(tokens.size() == 13);
+    CHECK(tokens[1] == "uint32 0");
+    CHECK(tokens[2] == "int32 0");
+    CHECK(tokens[3] == "int32 -1");
+    CHECK(tokens[4] == "uint32 4294967295");
+    CHECK(tokens[5] == "uint64 4294967296");
+    CHECK(tokens[6] == "int32 -2147483648");
+    CHECK(tokens[7] == "int64 -2147483649");
+    CHECK(tokens[8] == "uint64 18446744073709551615");
+    CHECK(tokens[9] == "int64 -9223372036854775808");
+    CHECK(tokens[10].rfind("double ", 0) == 0);
+    CHECK(tokens[11].rfind("double ", 0) == 0);
+  }
+
+  SECTION("doubles") {
+    readTokensWithBothBackends(
+        "[1.5, -0.0, 1e2, 1E+2, 25e-1, 0.1, 0.30000000000000004, "
+        "494.50961650991815, -0.0005589940528287436, 6378137.0, "
+        "1.7976931348623157e308, 4.9e-324, 1e-400, 123456789012345678901234, "
+        "0.000000000000000000000000000001, 9007199254740993]");
+
+    const std::vector<std::string> tokens =
+        readTokensWithBothBackends("[0.1, 1e-400, 1e2]");
+    char buffer[64];
+    std::snprintf(buffer, sizeof(buffer), "double %a", 0.1);
+    CHECK(tokens[1] == buffer);
+    std::snprintf(buffer, sizeof(buffer), "double %a", 0.0);
+    CHECK(tokens[2] == buffer);
+    std::snprintf(buffer, sizeof(buffer), "double %a", 100.0);
+    CHECK(tokens[3] == buffer);
+  }
+
+  SECTION("strings with escapes") {
+    const std::vector<std::string> tokens = readTokensWithBothBackends(
+        R"(["a\"b", "\\", "\/\b\f\n\r\t", "\u00e9\u20AC", "\ud83d\ude00",)"
+        R"( "\\\"", "\\\\"])");
+    REQUIRE(tokens.size() == 9);
+    CHECK(tokens[1] == "string a\"b");
+    CHECK(tokens[2] == "string \\");
+    CHECK(tokens[3] == "string /\b\f\n\r\t");
+    CHECK(tokens[4] == "string \xC3\xA9\xE2\x82\xAC");
+    CHECK(tokens[5] == "string \xF0\x9F\x98\x80");
+    CHECK(tokens[6] == "string \\\"");
+    CHECK(tokens[7] == "string \\\\");
+  }
+
+  SECTION("escapes and values across block boundaries") {
+    for (size_t padding = 0; padding < 140; ++padding) {
+      const std::string filler(padding, 'x');
+      readTokensWithBothBackends(
+          "{\"" + filler + "\": [\"" + filler + "\\\\\\\"\", \"\\\\" +
+          filler + "\\\\\", 123456, \"" + filler + "\\\"{[\"], \"k\": \"" +
+          filler + "\\\\\"}");
+      readTokensWithBothBackends(
+          std::string(padding, ' ') + "[12345, true, \"" + filler + "\"]");
+    }
+  }
+}
+
+TEST_CASE("JsonReader backends reject the same documents") {
+  CHECK(readError("").find("The document is empty.") != std::string::npos);
+  CHECK(readError("  \n").find("The document is empty.") != std::string::npos);
+  CHECK(
+      readError("[1] 2").find("must not be followed by other values") !=
+      std::string::npos);
+  CHECK(readError("[1,]").find("Invalid value.") != std::string::npos);
+  CHECK(readError("[1 2]").find("Missing a comma or ']'") != std::string::npos);
+  CHECK(
+      readError(R"({"a" 1})").find("Missing a colon") != std::string::npos);
+  CHECK(
+      readError(R"({"a": 1 "b": 2})").find("Missing a comma or '}'") !=
+      std::string::npos);
+  CHECK(
+      readError(R"({1: 2})").find("Missing a name for object member.") !=
+      std::string::npos);
+  CHECK(
+      readError(R"(["abc)").find("Missing a closing quotation mark") !=
+      std::string::npos);
+  CHECK(
+      readError(std::string("[\"a\0\"]", 6))
+          .find("Missing a closing quotation mark") != std::string::npos);
+  CHECK(
+      readError(std::string(" \0{}", 4)).find("The document is empty.") !=
+      std::string::npos);
+  CHECK(
+      readError("[\"a\x01\"]").find("Invalid encoding in string.") !=
+      std::string::npos);
+  CHECK(
+      readError(R"(["\x"])").find("Invalid escape character") !=
+      std::string::npos);
+  CHECK(
+      readError(R"(["\u12G4"])").find("Incorrect hex digit") !=
+      std::string::npos);
+  CHECK(
+      readError(R"(["\ud800x"])").find("surrogate pair in string is invalid") !=
+      std::string::npos);
+  CHECK(
+      readError("[1.]").find("Missing fraction part in number.") !=
+      std::string::npos);
+  CHECK(
+      readError("[1e+]").find("Missing exponent in number.") !=
+      std::string::npos);
+  CHECK(
+      readError("[1e400]").find("Number too big to be stored in double.") !=
+      std::string::npos);
+  CHECK(readError("[-]").find("Invalid value.") != std::string::npos);
+  CHECK(readError("[tru]").find("Invalid value.") != std::string::npos);
+  CHECK(readError("{").find("JSON parsing error at byte offset") == 0);
+  CHECK(readError("[").find("JSON parsing error at byte offset") == 0);
+}
+
+TEST_CASE("Benchmark JsonReader backends", "[.][benchmark]") {
+  const std::vector<std::byte> tileset = readFile(
+      std::filesystem::path(Cesium3DTilesReader_TEST_DATA_DIR) /
+      "tileset.json");
+  const std::vector<std::byte> gltf = readFile(
+      std::filesystem::path(CesiumGltfReader_TEST_DATA_DIR) /
+      "BoxTexturedWebp" / "glTF" / "BoxTexturedWebp.gltf");
+
+  CountingJsonHandler handler;
+
+  BENCHMARK("tileset.json, structural index") {
+    return JsonReader::readJson(
+               tileset,
+               handler,
+               JsonReaderBackend::StructuralIndex)
+        .value;
+  };
+
+  BENCHMARK("tileset.json, rapidjson") {
+    return JsonReader::readJson(tileset, handler, JsonReaderBackend::RapidJson)
+        .value;
+  };
+
+  BENCHMARK("glTF, structural index") {
+    return JsonReader::readJson(
+               gltf,
+               handler,
+               JsonReaderBackend::StructuralIndex)
+        .value;
+  };
+
+  BENCHMARK("glTF, rapidjson") {
+    return JsonReader::readJson(gltf, handler, JsonReaderBackend::RapidJson)
+        .value;
+  };
+}
@@ -174,6 +174,15 @@ public:
    */
   size_t size() const noexcept { return this->_size; }
 
+  /**
+   * @brief Determines if the given node is in this list.
+   *
+   * The node must not be in any other list that uses the same pointers.
+   */
+  bool contains(const T& node) const noexcept {
+    return (node.*Pointers).pPrevious != nullptr || this->_pHead == &node;
+  }
+
   /**
    * @brief Returns the head node of this list, or `nullptr` if the list is
    * empty.
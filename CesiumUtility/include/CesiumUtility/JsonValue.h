@@ -4,15 +4,19 @@
 
 #include <gsl/narrow>
 
+#include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <initializer_list>
-#include <map>
+#include <iterator>
 #include <optional>
 #include <stdexcept>
 #include <string>
 #include <string_view>
+#include <tuple>
 #include <type_traits>
+#include <utility>
 #include <variant>
 #include <vector>
 
@@ -43,6 +47,289 @@ constexpr T losslessNarrowOrDefault(U u, T defaultValue) noexcept {
   return t;
 }
 
+class JsonValue;
+
+/**
+ * @brief The properties of a JSON object, sorted by key.
+ *
+ * This has the interface of a `std::map<std::string, JsonValue>`, but keeps
+ * the properties in a single sorted vector. An object is one allocation
+ * rather than one for each property, an empty object is no allocation at all,
+ * and a key is found with a binary search over contiguous memory.
+ *
+ * Unlike a `std::map`, adding or removing a property invalidates iterators
+ * and references to the other properties of the object. And like a
+ * `std::flat_map`, an iterator dereferences to a pair of references to the
+ * key and value of a property, rather than to a `value_type&`, so that a key
+ * can never be changed in a way that breaks the order of the properties.
+ */
+class CESIUMUTILITY_API JsonObject final {
+public:
+  using key_type = std::string;
+  using mapped_type = JsonValue;
+  using value_type = std::pair<std::string, JsonValue>;
+  using size_type = std::size_t;
+
+  /**
+   * @brief An iterator over the properties of a {@link JsonObject}, which
+   * gives access to the key of each property only as a `const std::string&`.
+   *
+   * @tparam IsConst Whether the values of the properties are also `const`.
+   */
+  template <bool IsConst> class Iterator {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = JsonObject::value_type;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::pair<
+        const std::string&,
+        std::conditional_t<IsConst, const JsonValue&, JsonValue&>>;
+
+    /**
+     * @brief The result of {@link Iterator::operator->}, which holds the
+     * pair of references that the iterator dereferences to.
+     */
+    class pointer {
+    public:
+      const reference* operator->() const noexcept {
+        return &this->_reference;
+      }
+
+    private:
+      friend class Iterator;
+      explicit pointer(const reference& reference) noexcept
+          : _reference(reference) {}
+
+      reference _reference;
+    };
+
+    Iterator() noexcept = default;
+
+    /**
+     * @brief Converts an iterator to a `const_iterator`.
+     */
+    template <
+        bool WasConst,
+        typename = std::enable_if_t<IsConst && !WasConst>>
+    Iterator(const Iterator<WasConst>& other) noexcept : _it(other._it) {}
+
+    reference operator*() const noexcept {
+      return reference(this->_it->first, this->_it->second);
+    }
+    pointer operator->() const noexcept { return pointer(**this); }
+    reference operator[](difference_type n) const noexcept {
+      return *(*this + n);
+    }
+
+    Iterator& operator++() noexcept {
+      ++this->_it;
+      return *this;
+    }
+    Iterator operator++(int) noexcept { return Iterator(this->_it++); }
+    Iterator& operator--() noexcept {
+      --this->_it;
+      return *this;
+    }
+    Iterator operator--(int) noexcept { return Iterator(this->_it--); }
+    Iterator& operator+=(difference_type n) noexcept {
+      this->_it += n;
+      return *this;
+    }
+    Iterator& operator-=(difference_type n) noexcept {
+      this->_it -= n;
+      return *this;
+    }
+    Iterator operator+(difference_type n) const noexcept {
+      return Iterator(this->_it + n);
+    }
+    friend Iterator operator+(difference_type n, const Iterator& it) noexcept {
+      return it + n;
+    }
+    Iterator operator-(difference_type n) const noexcept {
+      return Iterator(this->_it - n);
+    }
+
+    template <bool OtherConst>
+    difference_type
+    operator-(const Iterator<OtherConst>& other) const noexcept {
+      return this->_it - other._it;
+    }
+    template <bool OtherConst>
+    bool operator==(const Iterator<OtherConst>& other) const noexcept {
+      return this->_it == other._it;
+    }
+    template <bool OtherConst>
+    bool operator!=(const Iterator<OtherConst>& other) const noexcept {
+      return this->_it != other._it;
+    }
+    template <bool OtherConst>
+    bool operator<(const Iterator<OtherConst>& other) const noexcept {
+      return this->_it < other._it;
+    }
+    template <bool OtherConst>
+    bool operator>(const Iterator<OtherConst>& other) const noexcept {
+      return this->_it > other._it;
+    }
+    template <bool OtherConst>
+    bool operator<=(const Iterator<OtherConst>& other) const noexcept {
+      return this->_it <= other._it;
+    }
+    template <bool OtherConst>
+    bool operator>=(const Iterator<OtherConst>& other) const noexcept {
+      return this->_it >= other._it;
+    }
+
+  private:
+    using PropertyIterator = std::conditional_t<
+        IsConst,
+        std::vector<value_type>::const_iterator,
+        std::vector<value_type>::iterator>;
+
+    friend class JsonObject;
+    template <bool> friend class Iterator;
+
+    explicit Iterator(PropertyIterator it) noexcept : _it(it) {}
+
+    PropertyIterator _it{};
+  };
+
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+  using reference = iterator::reference;
+  using const_reference = const_iterator::reference;
+
+  /**
+   * @brief Creates an empty object.
+   */
+  JsonObject() noexcept = default;
+
+  /**
+   * @brief Creates an object with the given properties.
+   *
+   * If a key appears more than once, the first property with the key is kept.
+   */
+  JsonObject(std::initializer_list<value_type> properties);
+
+  /**
+   * @brief Creates an object with the properties in the given range, such as
+   * the range of a `std::map<std::string, JsonValue>`.
+   *
+   * If a key appears more than once, the first property with the key is kept.
+   */
+  template <typename TIterator> JsonObject(TIterator first, TIterator last);
+
+  iterator begin() noexcept { return iterator(this->_properties.begin()); }
+  const_iterator begin() const noexcept {
+    return const_iterator(this->_properties.begin());
+  }
+  const_iterator cbegin() const noexcept { return this->begin(); }
+  iterator end() noexcept { return iterator(this->_properties.end()); }
+  const_iterator end() const noexcept {
+    return const_iterator(this->_properties.end());
+  }
+  const_iterator cend() const noexcept { return this->end(); }
+
+  size_type size() const noexcept { return this->_properties.size(); }
+  bool empty() const noexcept { return this->_properties.empty(); }
+  void clear() noexcept { this->_properties.clear(); }
+
+  /**
+   * @brief Reserves space for the given number of properties.
+   */
+  void reserve(size_type count) { this->_properties.reserve(count); }
+
+  /**
+   * @brief Finds the property with the given key, or returns {@link end} if
+   * there is none.
+   */
+  iterator find(const std::string_view& key) noexcept;
+
+  /** @copydoc find */
+  const_iterator find(const std::string_view& key) const noexcept;
+
+  /**
+   * @brief Returns 1 if the object has a property with the given key, or 0
+   * otherwise.
+   */
+  size_type count(const std::string_view& key) const noexcept;
+
+  /**
+   * @brief Returns whether the object has a property with the given key.
+   */
+  bool contains(const std::string_view& key) const noexcept;
+
+  /**
+   * @brief Gets the value of the property with the given key.
+   *
+   * @throws std::out_of_range if there is no property with the key.
+   */
+  JsonValue& at(const std::string_view& key);
+
+  /** @copydoc at */
+  const JsonValue& at(const std::string_view& key) const;
+
+  /**
+   * @brief Gets the value of the property with the given key, adding a `null`
+   * property with the key if there is none.
+   */
+  JsonValue& operator[](const std::string_view& key);
+
+  /**
+   * @brief Adds a property with the given key and a value constructed from
+   * the given arguments, unless the object already has a property with the
+   * key.
+   *
+   * Adding properties in order of their keys is the fastest, because each one
+   * is appended.
+   *
+   * @return The property with the key, and whether it was added.
+   */
+  template <typename... TArgs>
+  std::pair<iterator, bool>
+  emplace(const std::string_view& key, TArgs&&... args);
+
+  /** @copydoc emplace */
+  template <typename... TArgs>
+  std::pair<iterator, bool>
+  try_emplace(const std::string_view& key, TArgs&&... args) {
+    return this->emplace(key, std::forward<TArgs>(args)...);
+  }
+
+  /**
+   * @brief Adds the given property, unless the object already has a property
+   * with its key.
+   *
+   * @return The property with the key, and whether it was added.
+   */
+  std::pair<iterator, bool> insert(value_type&& property);
+
+  /** @copydoc insert */
+  std::pair<iterator, bool> insert(const value_type& property);
+
+  /**
+   * @brief Removes the given property.
+   *
+   * @return The property after the removed one.
+   */
+  iterator erase(const_iterator position);
+
+  /**
+   * @brief Removes the property with the given key, if there is one.
+   *
+   * @return The number of properties removed, which is 0 or 1.
+   */
+  size_type erase(const std::string_view& key);
+
+private:
+  using PropertyIterator = std::vector<value_type>::iterator;
+  using ConstPropertyIterator = std::vector<value_type>::const_iterator;
+
+  PropertyIterator lowerBound(const std::string_view& key) noexcept;
+  ConstPropertyIterator lowerBound(const std::string_view& key) const noexcept;
+
+  std::vector<value_type> _properties;
+};
+
 /**
  * @brief A generic implementation of a value in a JSON structure.
  *
@@ -69,7 +356,7 @@ public:
   /**
    * @brief The type to represent an `Object` JSON value.
    */
-  using Object = std::map<std::string, JsonValue>;
+  using Object = JsonObject;
 
   /**
    * @brief The type to represent an `Array` JSON value.
@@ -168,12 +455,12 @@ public:
   /**
    * @brief Creates an `Object` JSON value with the given properties.
    */
-  JsonValue(const std::map<std::string, JsonValue>& v) : value(v) {}
+  JsonValue(const Object& v) : value(v) {}
 
   /**
    * @brief Creates an `Object` JSON value with the given properties.
    */
-  JsonValue(std::map<std::string, JsonValue>&& v) : value(std::move(v)) {}
+  JsonValue(Object&& v) noexcept : value(std::move(v)) {}
 
   /**
    * @brief Creates an `Array` JSON value with the given elements.
@@ -195,7 +482,7 @@ public:
    * @brief Creates an JSON value from the given initializer list.
    */
   JsonValue(std::initializer_list<std::pair<const std::string, JsonValue>> v)
-      : value(std::map<std::string, JsonValue>(v)) {}
+      : value(Object(v.begin(), v.end())) {}
 
   [[nodiscard]] const JsonValue*
   getValuePtrForKey(const std::string& key) const;
@@ -617,4 +904,132 @@ public:
       Array>
       value;
 };
+
+inline JsonObject::JsonObject(std::initializer_list<value_type> properties)
+    : JsonObject(properties.begin(), properties.end()) {}
+
+template <typename TIterator>
+JsonObject::JsonObject(TIterator first, TIterator last) : _properties() {
+  for (; first != last; ++first) {
+    this->emplace(first->first, first->second);
+  }
+}
+
+inline JsonObject::iterator
+JsonObject::find(const std::string_view& key) noexcept {
+  const PropertyIterator it = this->lowerBound(key);
+  return it != this->_properties.end() && it->first == key
+             ? iterator(it)
+             : this->end();
+}
+
+inline JsonObject::const_iterator
+JsonObject::find(const std::string_view& key) const noexcept {
+  const ConstPropertyIterator it = this->lowerBound(key);
+  return it != this->_properties.end() && it->first == key
+             ? const_iterator(it)
+             : this->end();
+}
+
+inline JsonObject::size_type
+JsonObject::count(const std::string_view& key) const noexcept {
+  return this->contains(key) ? 1 : 0;
+}
+
+inline bool JsonObject::contains(const std::string_view& key) const noexcept {
+  return this->find(key) != this->end();
+}
+
+inline JsonValue& JsonObject::at(const std::string_view& key) {
+  const iterator it = this->find(key);
+  if (it == this->end()) {
+    throw std::out_of_range(std::string(key) + " is not present in Object");
+  }
+  return it->second;
+}
+
+inline const JsonValue& JsonObject::at(const std::string_view& key) const {
+  const const_iterator it = this->find(key);
+  if (it == this->end()) {
+    throw std::out_of_range(std::string(key) + " is not present in Object");
+  }
+  return it->second;
+}
+
+inline JsonValue& JsonObject::operator[](const std::string_view& key) {
+  return this->emplace(key).first->second;
+}
+
+template <typename... TArgs>
+std::pair<JsonObject::iterator, bool>
+JsonObject::emplace(const std::string_view& key, TArgs&&... args) {
+  // Properties are usually added in the order they appear in a JSON document
+  // or in code, which is often sorted already, so check the end first.
+  if (this->_properties.empty() || this->_properties.back().first < key) {
+    this->_properties.emplace_back(
+        std::piecewise_construct,
+        std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<TArgs>(args)...));
+    return {iterator(this->_properties.end() - 1), true};
+  }
+
+  const PropertyIterator it = this->lowerBound(key);
+  if (it != this->_properties.end() && it->first == key) {
+    return {iterator(it), false};
+  }
+
+  return {
+      iterator(this->_properties.emplace(
+          it,
+          std::piecewise_construct,
+          std::forward_as_tuple(key),
+          std::forward_as_tuple(std::forward<TArgs>(args)...))),
+      true};
+}
+
+inline std::pair<JsonObject::iterator, bool>
+JsonObject::insert(value_type&& property) {
+  return this->emplace(property.first, std::move(property.second));
+}
+
+inline std::pair<JsonObject::iterator, bool>
+JsonObject::insert(const value_type& property) {
+  return this->emplace(property.first, property.second);
+}
+
+inline JsonObject::iterator JsonObject::erase(const_iterator position) {
+  return iterator(this->_properties.erase(position._it));
+}
+
+inline JsonObject::size_type JsonObject::erase(const std::string_view& key) {
+  const iterator it = this->find(key);
+  if (it == this->end()) {
+    return 0;
+  }
+  this->erase(it);
+  return 1;
+}
+
+inline JsonObject::PropertyIterator
+JsonObject::lowerBound(const std::string_view& key) noexcept {
+  return std::lower_bound(
+      this->_properties.begin(),
+      this->_properties.end(),
+      key,
+      [](const value_type& property, const std::string_view& k) {
+        return property.first < k;
+      });
+}
+
+inline JsonObject::ConstPropertyIterator
+JsonObject::lowerBound(const std::string_view& key) const noexcept {
+  return std::lower_bound(
+      this->_properties.begin(),
+      this->_properties.end(),
+      key,
+      [](const value_type& property, const std::string_view& k) {
+        return property.first < k;
+      });
+}
+
 } // namespace CesiumUtility
@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Library.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace CesiumUtility {
+
+namespace Impl {
+/**
+ * @brief Reserves up to `count` helper threads for {@link parallelFor}.
+ *
+ * The helper threads of all concurrent calls share one budget, about the
+ * number of hardware threads, so that calls made from many worker threads at
+ * once do not start many more threads than the machine can run.
+ *
+ * @return The number of threads reserved, which may be 0.
+ */
+CESIUMUTILITY_API size_t reserveHelperThreads(size_t count) noexcept;
+
+/**
+ * @brief Returns helper threads reserved with {@link reserveHelperThreads}.
+ */
+CESIUMUTILITY_API void releaseHelperThreads(size_t count) noexcept;
+
+/**
+ * @brief The helper threads of one call to {@link parallelFor}, which are
+ * always joined and returned to the budget, even if starting one fails.
+ */
+class HelperThreads {
+public:
+  explicit HelperThreads(size_t count) noexcept
+      : _reserved(reserveHelperThreads(count)), _threads() {}
+
+  HelperThreads(const HelperThreads&) = delete;
+  HelperThreads& operator=(const HelperThreads&) = delete;
+
+  ~HelperThreads() noexcept {
+    this->join();
+    releaseHelperThreads(this->_reserved);
+  }
+
+  template <typename Work> void start(const Work& work) noexcept {
+    try {
+      this->_threads.reserve(this->_reserved);
+      for (size_t i = 0; i < this->_reserved; ++i) {
+        this->_threads.emplace_back(work);
+      }
+    } catch (...) {
+      // A thread could not be created, for example because the process has
+      // too many. The threads that did start and the calling thread do all of
+      // the work instead.
+    }
+  }
+
+  void join() noexcept {
+    for (std::thread& thread : this->_threads) {
+      thread.join();
+    }
+    this->_threads.clear();
+  }
+
+private:
+  size_t _reserved;
+  std::vector<std::thread> _threads;
+};
+} // namespace Impl
+
+/**
+ * @brief Calls a function with each index in `[0, count)`, spreading the calls
+ * over up to `maxThreads` threads.
+ *
+ * The calling thread takes part, and the indices are handed out one at a time
+ * so that a few large items do not leave the other threads idle. The function
+ * returns when all calls have completed. The calls may happen in any order, so
+ * the function must be safe to call concurrently for different indices.
+ *
+ * Fewer threads are used when other calls are already using most of the
+ * hardware threads, or when a thread cannot be started. If the function
+ * throws, the remaining indices are skipped, and the first exception is
+ * rethrown in the calling thread once all threads have finished.
+ *
+ * @tparam Func The type of the function.
+ * @param count The number of indices.
+ * @param maxThreads The maximum number of threads to use, including the
+ * calling thread. If this is 0 or 1, all calls happen in the calling thread.
+ * @param f The function to call with each index.
+ */
+template <typename Func>
+void parallelFor(size_t count, size_t maxThreads, Func&& f) {
+  std::atomic<size_t> next{0};
+  std::atomic<bool> failed{false};
+  std::exception_ptr pException;
+  const auto work = [&next, &failed, &pException, count, &f]() noexcept {
+    for (size_t i = next++; i < count; i = next++) {
+      try {
+        f(i);
+      } catch (...) {
+        if (!failed.exchange(true)) {
+          pException = std::current_exception();
+        }
+        next = count;
+      }
+    }
+  };
+
+  const size_t threadCount = std::min(count, maxThreads);
+  Impl::HelperThreads helperThreads(threadCount > 1 ? threadCount - 1 : 0);
+  helperThreads.start(work);
+
+  work();
+
+  helperThreads.join();
+  if (pException) {
+    std::rethrow_exception(pException);
+  }
+}
+} // namespace CesiumUtility
@@ -0,0 +1,45 @@
+#include "CesiumUtility/parallelFor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+namespace CesiumUtility {
+namespace Impl {
+
+namespace {
+std::atomic<size_t> helperThreadsInUse{0};
+
+size_t getMaximumHelperThreads() noexcept {
+  // Each call also runs in its calling thread, so the helpers only need to
+  // make up the rest of the hardware threads.
+  static const size_t maximum =
+      std::max<size_t>(std::thread::hardware_concurrency(), 2) - 1;
+  return maximum;
+}
+} // namespace
+
+size_t reserveHelperThreads(size_t count) noexcept {
+  if (count == 0) {
+    return 0;
+  }
+
+  const size_t maximum = getMaximumHelperThreads();
+  size_t inUse = helperThreadsInUse.load();
+  size_t reserved;
+  do {
+    reserved = inUse >= maximum ? 0 : std::min(count, maximum - inUse);
+    if (reserved == 0) {
+      return 0;
+    }
+  } while (!helperThreadsInUse.compare_exchange_weak(inUse, inUse + reserved));
+
+  return reserved;
+}
+
+void releaseHelperThreads(size_t count) noexcept {
+  helperThreadsInUse -= count;
+}
+
+} // namespace Impl
+} // namespace CesiumUtility
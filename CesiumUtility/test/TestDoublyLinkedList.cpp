@@ -157,4 +157,15 @@ TEST_CASE("DoublyLinkedList") {
     linkedList.insertAfter(three, four);
     assertOrder(linkedList, {1, 2, 3, 4});
   }
+
+  SECTION("contains") {
+    TestNode newNode(5);
+    CHECK(linkedList.contains(one));
+    CHECK(linkedList.contains(four));
+    CHECK(!linkedList.contains(newNode));
+
+    linkedList.remove(one);
+    CHECK(!linkedList.contains(one));
+    CHECK(linkedList.contains(two));
+  }
 }
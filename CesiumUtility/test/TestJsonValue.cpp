@@ -0,0 +1,101 @@
+#include "CesiumUtility/JsonValue.h"
+
+#include <catch2/catch.hpp>
+
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace CesiumUtility;
+
+namespace {
+std::vector<std::string> getKeys(const JsonValue::Object& object) {
+  std::vector<std::string> keys;
+  for (const auto& [key, value] : object) {
+    keys.push_back(key);
+  }
+  return keys;
+}
+} // namespace
+
+TEST_CASE("JsonValue::Object keeps its properties sorted by key") {
+  JsonValue::Object object{{"b", 2}, {"a", 1}, {"c", 3}, {"a", 4}};
+  CHECK(object.size() == 3);
+  CHECK(getKeys(object) == std::vector<std::string>{"a", "b", "c"});
+  CHECK(object.at("a").getInt64() == 1);
+
+  CHECK(object.emplace("d", 5).second);
+  CHECK(object.emplace("aa", 6).second);
+  CHECK(!object.emplace("b", 7).second);
+  CHECK(object.at("b").getInt64() == 2);
+  CHECK(
+      getKeys(object) == std::vector<std::string>{"a", "aa", "b", "c", "d"});
+
+  object["ab"] = "text";
+  CHECK(object.find("ab")->second.getString() == "text");
+  CHECK(object["missing"].isNull());
+  CHECK(object.size() == 7);
+
+  CHECK(object.erase("missing") == 1);
+  CHECK(object.erase("missing") == 0);
+  CHECK(object.erase(object.find("a"))->first == "aa");
+  CHECK(getKeys(object) == std::vector<std::string>{"aa", "ab", "b", "c", "d"});
+}
+
+TEST_CASE("JsonValue::Object finds properties") {
+  const JsonValue::Object object{{"x", 1.0}, {"y", true}};
+
+  CHECK(object.find("x") != object.end());
+  CHECK(object.find("z") == object.end());
+  CHECK(object.find("") == object.end());
+  CHECK(object.count("y") == 1);
+  CHECK(object.contains("y"));
+  CHECK(!object.contains("w"));
+  CHECK_THROWS_AS(object.at("w"), std::out_of_range);
+
+  CHECK(JsonValue::Object().find("x") == JsonValue::Object().end());
+}
+
+TEST_CASE("JsonValue holds objects") {
+  const std::map<std::string, JsonValue> map{{"b", 2}, {"a", "one"}};
+  const JsonValue value(JsonValue::Object(map.begin(), map.end()));
+  REQUIRE(value.isObject());
+  CHECK(value.getObject().size() == 2);
+  CHECK(value.hasKey("a"));
+  CHECK(!value.hasKey("c"));
+  CHECK(*value.getValuePtrForKey<std::string>("a") == "one");
+  CHECK(value.getSafeNumericalValueForKey<int>("b") == 2);
+
+  const JsonValue nested(
+      JsonValue::Object{{"outer", JsonValue::Object{{"inner", 1}}}});
+  const JsonValue* pOuter = nested.getValuePtrForKey("outer");
+  REQUIRE(pOuter);
+  CHECK(pOuter->getValuePtrForKey("inner")->getInt64() == 1);
+}
+
+TEST_CASE("JsonValue::Object does not allow keys to be changed") {
+  JsonValue::Object object{{"a", 1}, {"b", 2}};
+
+  static_assert(
+      std::is_same_v<decltype(object.begin()->first), const std::string&>);
+  static_assert(
+      !std::is_assignable_v<decltype((object.begin()->first)), std::string>);
+
+  for (const auto& [key, value] : object) {
+    value = JsonValue(key);
+  }
+  CHECK(object.at("a").getString() == "a");
+  CHECK(object.at("b").getString() == "b");
+
+  JsonValue::Object::iterator it = object.begin();
+  JsonValue::Object::const_iterator constIt = it;
+  CHECK(constIt == object.begin());
+  CHECK(it + 2 == object.end());
+  CHECK(object.end() - object.cbegin() == 2);
+  CHECK(it[1].first == "b");
+  it->second = 3;
+  CHECK(std::as_const(object).begin()->second.getInt64() == 3);
+}
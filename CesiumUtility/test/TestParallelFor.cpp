@@ -0,0 +1,78 @@
+#include "CesiumUtility/parallelFor.h"
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace CesiumUtility;
+
+TEST_CASE("parallelFor") {
+  SECTION("calls the function once for each index") {
+    std::vector<std::atomic<int>> calls(1000);
+    parallelFor(calls.size(), 4, [&calls](size_t i) { ++calls[i]; });
+    for (const std::atomic<int>& count : calls) {
+      CHECK(count == 1);
+    }
+  }
+
+  SECTION("uses the calling thread when only one thread is allowed") {
+    const std::thread::id callingThread = std::this_thread::get_id();
+    bool allOnCallingThread = true;
+    parallelFor(10, 1, [&allOnCallingThread, callingThread](size_t) {
+      allOnCallingThread &= std::this_thread::get_id() == callingThread;
+    });
+    CHECK(allOnCallingThread);
+  }
+
+  SECTION("rethrows an exception in the calling thread") {
+    std::atomic<int> calls{0};
+    CHECK_THROWS_AS(
+        parallelFor(
+            1000,
+            4,
+            [&calls](size_t i) {
+              ++calls;
+              if (i == 10) {
+                throw std::runtime_error("failed");
+              }
+            }),
+        std::runtime_error);
+    CHECK(calls >= 11);
+    CHECK(calls < 1000);
+  }
+
+  SECTION("shares a limited number of threads between calls") {
+    const size_t hardwareThreads =
+        std::max<size_t>(std::thread::hardware_concurrency(), 2);
+
+    std::set<std::thread::id> threads;
+    std::mutex threadsMutex;
+    parallelFor(hardwareThreads, hardwareThreads, [&](size_t) {
+      std::vector<std::thread::id> nestedThreads(hardwareThreads * 4);
+      parallelFor(nestedThreads.size(), hardwareThreads, [&](size_t j) {
+        nestedThreads[j] = std::this_thread::get_id();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      });
+
+      std::lock_guard<std::mutex> lock(threadsMutex);
+      threads.insert(nestedThreads.begin(), nestedThreads.end());
+    });
+
+    // The outer call takes all of the helper threads, so the nested calls run
+    // only in their calling threads instead of starting more.
+    CHECK(threads.size() <= hardwareThreads);
+  }
+
+  SECTION("does nothing when there are no indices") {
+    int calls = 0;
+    parallelFor(0, 4, [&calls](size_t) { ++calls; });
+    CHECK(calls == 0);
+  }
+}